@@ -47,12 +47,6 @@
 
 - (id) initWithBoardPosition:(int)boardPosition;
 
-@property(nonatomic, assign) float stepIncrease;
-@property(nonatomic, assign) float progress;
-@property(nonatomic, assign) float boardPositionChangesPerStep;
-@property(nonatomic, assign) float nextProgressUpdate;
-@property(nonatomic, assign) int numberOfBoardPositionChanges;
-
 @end
 
 
@@ -227,11 +221,6 @@
   self = [super initWithBoardPosition:aBoardPosition isAsynchronous:true];
   if (! self)
     return nil;
-  self.stepIncrease = 0.0;
-  self.progress = 0.0;
-  self.boardPositionChangesPerStep = 0.0;
-  self.nextProgressUpdate = 0.0;
-  self.numberOfBoardPositionChanges = 0;
   return self;
 }
 
@@ -243,7 +232,6 @@
   [self.asynchronousCommandDelegate asynchronousCommand:self
                                             didProgress:0.0
                                         nextStepMessage:@"Changing board position..."];
-  [self setupProgressParameters];
   NSNotificationCenter* center = [NSNotificationCenter defaultCenter];
   [center addObserver:self selector:@selector(boardPositionChangeProgress:) name:boardPositionChangeProgress object:nil];
   bool result = [super doIt];
@@ -251,37 +239,15 @@
   return result;
 }
 
-// -----------------------------------------------------------------------------
-/// @brief Private helper for doIt().
-// -----------------------------------------------------------------------------
-- (void) setupProgressParameters
-{
-  GoBoardPosition* boardPosition = [GoGame sharedGame].boardPosition;
-  int numberOfBoardPositions = abs(self.newBoardPosition - boardPosition.currentBoardPosition);
-  static const int maximumNumberOfSteps = 5;
-  int numberOfSteps;
-  if (numberOfBoardPositions <= maximumNumberOfSteps)
-    numberOfSteps = numberOfBoardPositions;
-  else
-    numberOfSteps = maximumNumberOfSteps;
-  self.stepIncrease = 1.0 / numberOfSteps;
-  self.boardPositionChangesPerStep = numberOfBoardPositions / numberOfSteps;
-  self.nextProgressUpdate = self.boardPositionChangesPerStep;
-  self.numberOfBoardPositionChanges = 0;
-}
-
 // -----------------------------------------------------------------------------
 /// @brief Responds to the #boardPositionChangeProgress notification.
 // -----------------------------------------------------------------------------
 - (void) boardPositionChangeProgress:(NSNotification*)notification
 {
-  self.numberOfBoardPositionChanges++;
-  if (self.numberOfBoardPositionChanges >= self.nextProgressUpdate)
-  {
-    self.nextProgressUpdate += self.boardPositionChangesPerStep;
-    self.progress += self.stepIncrease;
-    [self.asynchronousCommandDelegate asynchronousCommand:self didProgress:self.progress nextStepMessage:nil];
-  }
+  // GoBoardPosition already limits the rate at which it sends the notification,
+  // so we can forward the progress unchanged
+  float progress = [[notification object] floatValue];
+  [self.asynchronousCommandDelegate asynchronousCommand:self didProgress:progress nextStepMessage:nil];
 }
 
 @end
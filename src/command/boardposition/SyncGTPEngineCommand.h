@@ -27,6 +27,16 @@ enum SyncMoveType
   SyncMovesOfEntireGame
 };
 
+/// @brief The SyncGTPEngineStatistics struct contains counters that describe
+/// how GTP engines were synchronized by SyncGTPEngineCommand since the
+/// application was launched. Every engine that is synchronized counts once.
+struct SyncGTPEngineStatistics
+{
+  unsigned long numberOfSkippedSyncs;      ///< @brief The engine already had the target position.
+  unsigned long numberOfIncrementalSyncs;  ///< @brief Only moves were taken back and/or played.
+  unsigned long numberOfFullSyncs;         ///< @brief The position was rebuilt from scratch.
+};
+
 
 // -----------------------------------------------------------------------------
 /// @brief The SyncGTPEngineCommand class is responsible for synchronizing the
@@ -39,6 +49,27 @@ enum SyncMoveType
 /// Optionally SyncGTPEngineCommand may be configured so that it synchronizes
 /// the GTP engine with all moves of the entire game.
 ///
+/// SyncGTPEngineCommand compares the position that the GTP engine currently
+/// holds (as tracked by GtpClient, see GtpEngineState) with the target
+/// position. If only the moves differ, SyncGTPEngineCommand takes back the
+/// moves after the longest common prefix with "undo" and plays the remaining
+/// target moves. Navigating one move back in a long game therefore costs a
+/// single "undo" instead of a replay of the entire game. If the engine's
+/// position is unknown, or if board size, komi, handicap or setup differ,
+/// SyncGTPEngineCommand rebuilds the position from scratch with
+/// "clear_board". The same happens if the incremental synchronization fails.
+///
+/// Before it does any of this, SyncGTPEngineCommand checks whether the engine
+/// still holds the position of the previous synchronization. For this check
+/// SyncGTPEngineCommand computes a fingerprint of the target position from
+/// the Zobrist hash of the last synchronized move, the number of moves, komi,
+/// board size and setup. After each successful synchronization the
+/// fingerprint is attached to the engine's position via GtpClient, which
+/// forgets it as soon as any GTP command changes the position. If the
+/// fingerprint still matches, the synchronization is skipped entirely. This
+/// makes defensive synchronizations cheap. statistics() counts how many
+/// synchronizations were skipped.
+///
 /// If execution of SyncGTPEngineCommand fails, the GTP engine is left in an
 /// unknown state.
 // -----------------------------------------------------------------------------
@@ -46,6 +77,8 @@ enum SyncMoveType
 {
 }
 
++ (struct SyncGTPEngineStatistics) statistics;
+
 @property(nonatomic, assign) enum SyncMoveType syncMoveType;
 
 @end
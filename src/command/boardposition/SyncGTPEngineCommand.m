@@ -17,6 +17,7 @@
 
 // Project includes
 #import "SyncGTPEngineCommand.h"
+#import "../../go/GoBoard.h"
 #import "../../go/GoBoardPosition.h"
 #import "../../go/GoGame.h"
 #import "../../go/GoMove.h"
@@ -25,12 +26,56 @@
 #import "../../go/GoPoint.h"
 #import "../../go/GoUtilities.h"
 #import "../../go/GoVertex.h"
+#import "../../gtp/GtpClient.h"
 #import "../../gtp/GtpCommand.h"
+#import "../../gtp/GtpEnginePool.h"
+#import "../../gtp/GtpEngineState.h"
 #import "../../gtp/GtpResponse.h"
+#import "../../main/ApplicationDelegate.h"
+
+// Counters that are returned by statistics(). Are guarded by the
+// SyncGTPEngineCommand class object.
+static struct SyncGTPEngineStatistics syncStatistics = { 0, 0, 0 };
+
+
+// -----------------------------------------------------------------------------
+/// @brief Mixes @a value into @a fingerprint and returns the result.
+// -----------------------------------------------------------------------------
+static long long combineFingerprint(long long fingerprint, long long value)
+{
+  // Same mixing step as boost::hash_combine, with the 64-bit golden ratio
+  unsigned long long result = (unsigned long long)fingerprint;
+  result ^= (unsigned long long)value + 0x9e3779b97f4a7c15ULL + (result << 6) + (result >> 2);
+  return (long long)result;
+}
 
 
 @implementation SyncGTPEngineCommand
 
+// -----------------------------------------------------------------------------
+/// @brief Returns the counters that describe how GTP engines were synchronized
+/// since the application was launched.
+// -----------------------------------------------------------------------------
++ (struct SyncGTPEngineStatistics) statistics
+{
+  @synchronized([SyncGTPEngineCommand class])
+  {
+    return syncStatistics;
+  }
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Private helper. Increments the statistics counter @a counter, which
+/// must be a member of the static statistics struct.
+// -----------------------------------------------------------------------------
++ (void) incrementStatisticsCounter:(unsigned long*)counter
+{
+  @synchronized([SyncGTPEngineCommand class])
+  {
+    (*counter)++;
+  }
+}
+
 
 // -----------------------------------------------------------------------------
 /// @brief Initializes a SyncGTPEngineCommand object.
@@ -49,205 +94,420 @@
 
 // -----------------------------------------------------------------------------
 /// @brief Executes this command. See the class documentation for details.
+///
+/// The GTP commands that are required for synchronization do not depend on
+/// each other's outcome, so they are submitted as a single pipelined batch.
+///
+/// Each engine is synchronized incrementally if possible, i.e. only the moves
+/// that differ between the engine's current position and the target position
+/// are taken back and played. See the class documentation for details.
+///
+/// If the application's GtpEnginePool uses more than one engine, every engine
+/// that serves a role is synchronized, one after the other.
 // -----------------------------------------------------------------------------
 - (bool) doIt
 {
-  // This clears all board state related parameters (handicap, komi, setup
-  // stones, setup player, moves) but leaves board size, game rules and player
-  // configuration (e.g. UCT parameters) untouched
-  if (! [self syncGTPEngineClearBoard])
+  long long positionFingerprint = [self targetPositionFingerprint];
+  GtpEnginePool* pool = [ApplicationDelegate sharedDelegate].gtpEnginePool;
+  int playEngineIndex = [pool engineIndexForRole:GtpEngineRolePlay];
+  NSMutableIndexSet* synchronizedEngineIndexes = [NSMutableIndexSet indexSet];
+  for (int role = 0; role < GtpEngineRoleMax; ++role)
   {
-    DDLogError(@"%@: Aborting because syncGTPEngineClearBoard failed", [self shortDescription]);
-    return false;
-  }
+    int engineIndex = [pool engineIndexForRole:role];
+    if ([synchronizedEngineIndexes containsIndex:engineIndex])
+      continue;
+    [synchronizedEngineIndexes addIndex:engineIndex];
 
-  if (! [self syncGTPEngineHandicap])
-  {
-    DDLogError(@"%@: Aborting because syncGTPEngineHandicap failed", [self shortDescription]);
-    return false;
+    // The engine that serves the play role receives the board size when a
+    // new game is started. The other engines don't.
+    bool synchronizeBoardSize = (engineIndex != playEngineIndex);
+    if (! [self synchronizeEngineWithRole:role
+                     synchronizeBoardSize:synchronizeBoardSize
+                      positionFingerprint:positionFingerprint])
+    {
+      return false;
+    }
   }
+  return true;
+}
 
-  if (! [self syncGTPEngineKomi])
+// -----------------------------------------------------------------------------
+/// @brief Private helper for doIt(). Synchronizes the GTP engine that serves
+/// @a role with the target position, whose fingerprint is
+/// @a positionFingerprint. Returns true on success, false on failure.
+// -----------------------------------------------------------------------------
+- (bool) synchronizeEngineWithRole:(enum GtpEngineRole)role
+              synchronizeBoardSize:(bool)synchronizeBoardSize
+               positionFingerprint:(long long)positionFingerprint
+{
+  GtpEnginePool* pool = [ApplicationDelegate sharedDelegate].gtpEnginePool;
+  GtpClient* client = [pool clientForRole:role];
+  if ([client engineHasPositionWithFingerprint:positionFingerprint])
   {
-    DDLogError(@"%@: Aborting because syncGTPEngineKomi failed", [self shortDescription]);
-    return false;
+    [SyncGTPEngineCommand incrementStatisticsCounter:&syncStatistics.numberOfSkippedSyncs];
+    DDLogVerbose(@"%@: Engine with role %d already has the target position, skipping synchronization", [self shortDescription], role);
+    return true;
   }
 
-  if (! [self syncGTPEngineSetupStones])
+  GtpEngineState* targetState = [self targetEngineState];
+  if (! targetState)
   {
-    DDLogError(@"%@: Aborting because syncGTPEngineSetupStones failed", [self shortDescription]);
+    DDLogError(@"%@: Aborting because targetEngineState failed", [self shortDescription]);
     return false;
   }
 
-  if (! [self syncGTPEngineSetupPlayer])
+  GtpEngineState* currentState = client.engineState;
+  CFTimeInterval startTime = CACurrentMediaTime();
+
+  NSUInteger numberOfUndos = 0;
+  NSUInteger indexOfFirstMoveToPlay = 0;
+  if ([targetState planSyncFromState:currentState numberOfUndos:&numberOfUndos indexOfFirstMoveToPlay:&indexOfFirstMoveToPlay])
   {
-    DDLogError(@"%@: Aborting because syncGTPEngineSetupPlayer failed", [self shortDescription]);
-    return false;
+    NSMutableArray* commands = [NSMutableArray array];
+    [self addUndoCommands:numberOfUndos toArray:commands];
+    [self addMovesCommandForMoves:targetState.moves fromIndex:indexOfFirstMoveToPlay toArray:commands];
+    if ([self submitCommands:commands toEngineWithRole:role])
+    {
+      [SyncGTPEngineCommand incrementStatisticsCounter:&syncStatistics.numberOfIncrementalSyncs];
+      [self assignPositionFingerprint:positionFingerprint toClient:client withTargetState:targetState];
+      DDLogVerbose(@"%@: Synchronized engine with role %d incrementally, %lu moves taken back, %lu moves played, %.3f ms",
+                   [self shortDescription],
+                   role,
+                   (unsigned long)numberOfUndos,
+                   (unsigned long)(targetState.moves.count - indexOfFirstMoveToPlay),
+                   (CACurrentMediaTime() - startTime) * 1000.0);
+      return true;
+    }
+    // The engine was busy with other commands between the moment the snapshot
+    // of its state was taken and the moment our commands were processed
+    DDLogWarn(@"%@: Incremental synchronization of engine with role %d failed, rebuilding position from scratch", [self shortDescription], role);
   }
 
-  if (! [self syncGTPEngineMoves])
+  // The engine may have received the board size outside of our view, in
+  // which case we don't know the board size and have to trust the caller
+  if (0 != currentState.boardSize && currentState.boardSize != targetState.boardSize)
+    synchronizeBoardSize = true;
+
+  NSMutableArray* commands = [NSMutableArray array];
+  if (synchronizeBoardSize)
+    [self addBoardSizeCommandForState:targetState toArray:commands];
+  // This clears all board state related parameters (handicap, komi, setup
+  // stones, setup player, moves) but leaves board size, game rules and player
+  // configuration (e.g. UCT parameters) untouched
+  [self addClearBoardCommandToArray:commands];
+  [self addHandicapCommandForState:targetState toArray:commands];
+  [self addKomiCommandForState:targetState toArray:commands];
+  [self addSetupStonesCommandForState:targetState toArray:commands];
+  [self addSetupPlayerCommandForState:targetState toArray:commands];
+  [self addMovesCommandForMoves:targetState.moves fromIndex:0 toArray:commands];
+  if (! [self submitCommands:commands toEngineWithRole:role])
   {
-    DDLogError(@"%@: Aborting because syncGTPEngineMoves failed", [self shortDescription]);
+    // The commands after the failed one were still processed, so the engine
+    // now holds some mixture of its previous and the target position. This
+    // must not be mistaken for a known position by a later synchronization.
+    [client invalidateEngineState];
+    assert(0);
     return false;
   }
+  [SyncGTPEngineCommand incrementStatisticsCounter:&syncStatistics.numberOfFullSyncs];
+  [self assignPositionFingerprint:positionFingerprint toClient:client withTargetState:targetState];
+  DDLogVerbose(@"%@: Synchronized engine with role %d from scratch, %lu moves played, %.3f ms",
+               [self shortDescription],
+               role,
+               (unsigned long)targetState.moves.count,
+               (CACurrentMediaTime() - startTime) * 1000.0);
   return true;
 }
 
 // -----------------------------------------------------------------------------
-/// @brief Private helper for doIt(). Returns true on success, false on failure.
+/// @brief Private helper for
+/// synchronizeEngineWithRole:synchronizeBoardSize:positionFingerprint:().
+/// Attaches @a positionFingerprint to the position of the GTP engine behind
+/// @a client, but only if the engine's position is @a targetState.
+///
+/// The engine's position may differ from @a targetState if some other GTP
+/// command was processed after the synchronization commands.
 // -----------------------------------------------------------------------------
-- (bool) syncGTPEngineClearBoard
+- (void) assignPositionFingerprint:(long long)positionFingerprint toClient:(GtpClient*)client withTargetState:(GtpEngineState*)targetState
 {
-  GtpCommand* commandClearBoard = [GtpCommand command:@"clear_board"];
-  [commandClearBoard submit];
-  assert(commandClearBoard.response.status);
-  return commandClearBoard.response.status;
+  GtpEngineState* engineState = client.engineState;
+  if (! [engineState isSamePositionAsState:targetState])
+    return;
+  [client assignPositionFingerprint:positionFingerprint toEngineStateWithGeneration:engineState.generation];
 }
 
 // -----------------------------------------------------------------------------
-/// @brief Private helper for doIt(). Returns true on success, false on failure.
+/// @brief Private helper for
+/// synchronizeEngineWithRole:synchronizeBoardSize:positionFingerprint:().
+/// Submits @a commands as a single pipelined batch to the GTP engine that
+/// serves @a role and waits for the responses. Returns true if all commands
+/// succeeded, false if at least one command failed.
+///
+/// The engine processes all commands of the batch even if one of them fails,
+/// therefore every response is checked and logged.
 // -----------------------------------------------------------------------------
-- (bool) syncGTPEngineHandicap
+- (bool) submitCommands:(NSArray*)commands toEngineWithRole:(enum GtpEngineRole)role
 {
-  GoGame* game = [GoGame sharedGame];
-
-  // The previously sent GTP command "clear_board" has left Fuego without a
-  // handicap, so we need to setup handicap only if there is one. The GTP
-  NSUInteger handicap = game.handicapPoints.count;
-  if (0 == handicap)
+  if (0 == commands.count)
     return true;
 
-  NSString* verticesString = [GoUtilities verticesStringForPoints:game.handicapPoints];
-  NSString* commandString = [@"set_free_handicap " stringByAppendingString:verticesString];
-  GtpCommand* command = [GtpCommand command:commandString];
-  [command submit];
-  assert(command.response.status);
-  return command.response.status;
-}
-
-// -----------------------------------------------------------------------------
-/// @brief Private helper for doIt(). Returns true on success, false on failure.
-// -----------------------------------------------------------------------------
-- (bool) syncGTPEngineKomi
-{
-  GoGame* game = [GoGame sharedGame];
+  for (GtpCommand* command in commands)
+    command.role = role;
+  [GtpCommand submitPipelined:commands];
 
-  // The previously sent GTP command "clear_board" has caused Fuego to reset
-  // komi to the last value that was explicitly set with the GTP command "komi"
-  // (or to the built-in default komi value, in case no "komi" command was ever
-  // sent). Therefore, unlike handicap we always have to setup komi.
-  GtpCommand* command = [GtpCommand command:[NSString stringWithFormat:@"komi %.1f", game.komi]];
-  [command submit];
-  assert(command.response.status);
-  return command.response.status;
+  bool success = true;
+  for (GtpCommand* command in commands)
+  {
+    if (! command.response.status)
+    {
+      DDLogError(@"%@: Synchronization failed, command %@ returned response %@", [self shortDescription], command, command.response);
+      success = false;
+    }
+  }
+  return success;
 }
 
 // -----------------------------------------------------------------------------
-/// @brief Private helper for doIt(). Returns true on success, false on failure.
+/// @brief Private helper for doIt(). Returns the fingerprint of the position
+/// that the GTP engine should have after synchronization. Does not iterate
+/// the moves of the game.
+///
+/// The fingerprint is made up of the Zobrist hash of the last move that is
+/// synchronized, the number of moves, board size, komi, the handicap stones,
+/// the setup stones and the setup player. The Zobrist hash alone does not
+/// distinguish handicap stones from black setup stones on the same
+/// intersections, which the engine treats differently.
 // -----------------------------------------------------------------------------
-- (bool) syncGTPEngineSetupStones
+- (long long) targetPositionFingerprint
 {
   GoGame* game = [GoGame sharedGame];
-  if (game.blackSetupPoints.count == 0 && game.whiteSetupPoints.count == 0)
-    return true;
-
-  NSString* commandString = @"gogui-setup";
-
-  for (NSNumber* stoneColorAsNumber in @[[NSNumber numberWithInt:GoColorBlack], [NSNumber numberWithInt:GoColorWhite]])
+  long long zobristHash;
+  int numberOfMoves;
+  GoMove* syncUpToThisMove = [self syncUpToThisMove];
+  if (! syncUpToThisMove)
   {
-    enum GoColor stoneColor = [stoneColorAsNumber intValue];
-
-    NSArray* setupPoints;
-    NSString* colorString;
-    if (stoneColor == GoColorBlack)
-    {
-      setupPoints = game.blackSetupPoints;
-      colorString = @"B";
-    }
+    zobristHash = game.zobristHashBeforeFirstMove;
+    numberOfMoves = 0;
+  }
+  else
+  {
+    zobristHash = syncUpToThisMove.zobristHash;
+    if (SyncMovesUpToCurrentBoardPosition == self.syncMoveType)
+      numberOfMoves = game.boardPosition.currentBoardPosition;
     else
-    {
-      setupPoints = game.whiteSetupPoints;
-      colorString = @"W";
-    }
-
-    for (GoPoint* setupPoint in setupPoints)
-    {
-      NSString* setupStoneString = [NSString stringWithFormat:@" %@ %@", colorString, setupPoint.vertex.string];
-      commandString = [commandString stringByAppendingString:setupStoneString];
-    }
+      numberOfMoves = game.moveModel.numberOfMoves;
   }
 
-  GtpCommand* command = [GtpCommand command:commandString];
-  [command submit];
-  assert(command.response.status);
-  return command.response.status;
+  long long fingerprint = zobristHash;
+  fingerprint = combineFingerprint(fingerprint, numberOfMoves);
+  fingerprint = combineFingerprint(fingerprint, game.board.size);
+  fingerprint = combineFingerprint(fingerprint, (long long)[[GtpEngineState komiStringWithKomi:game.komi] hash]);
+  fingerprint = combineFingerprint(fingerprint, (long long)[[self handicapString] hash]);
+  fingerprint = combineFingerprint(fingerprint, (long long)[[self setupStonesString] hash]);
+  fingerprint = combineFingerprint(fingerprint, game.setupFirstMoveColor);
+  return fingerprint;
 }
 
 // -----------------------------------------------------------------------------
-/// @brief Private helper for doIt(). Returns true on success, false on failure.
+/// @brief Private helper. Returns the last move that is synchronized, or nil
+/// if no moves are synchronized.
 // -----------------------------------------------------------------------------
-- (bool) syncGTPEngineSetupPlayer
+- (GoMove*) syncUpToThisMove
 {
   GoGame* game = [GoGame sharedGame];
-  if (game.setupFirstMoveColor == GoColorNone)
-    return true;
-
-  NSString* colorString;
-  if (game.setupFirstMoveColor == GoColorBlack)
-    colorString = @"B";
+  if (SyncMovesUpToCurrentBoardPosition == self.syncMoveType)
+    return game.boardPosition.currentMove;
   else
-    colorString = @"W";
+    return game.lastMove;
+}
 
-  NSString* commandString = [NSString stringWithFormat:@"gogui-setup_player %@", colorString];
+// -----------------------------------------------------------------------------
+/// @brief Private helper. Returns the handicap stones of the game in the
+/// format of GtpEngineState's @e handicap property, or nil if there is no
+/// handicap.
+// -----------------------------------------------------------------------------
+- (NSString*) handicapString
+{
+  GoGame* game = [GoGame sharedGame];
+  if (0 == game.handicapPoints.count)
+    return nil;
+  return [GoUtilities verticesStringForPoints:game.handicapPoints];
+}
 
-  GtpCommand* command = [GtpCommand command:commandString];
-  [command submit];
-  assert(command.response.status);
-  return command.response.status;
+// -----------------------------------------------------------------------------
+/// @brief Private helper. Returns the setup stones of the game in the format
+/// of GtpEngineState's @e setupStones property, or nil if there are no setup
+/// stones.
+// -----------------------------------------------------------------------------
+- (NSString*) setupStonesString
+{
+  GoGame* game = [GoGame sharedGame];
+  if (0 == game.blackSetupPoints.count && 0 == game.whiteSetupPoints.count)
+    return nil;
+  NSMutableString* setupStones = [NSMutableString string];
+  for (GoPoint* setupPoint in game.blackSetupPoints)
+    [setupStones appendFormat:@" B %@", setupPoint.vertex.string];
+  for (GoPoint* setupPoint in game.whiteSetupPoints)
+    [setupStones appendFormat:@" W %@", setupPoint.vertex.string];
+  return [setupStones substringFromIndex:1];
 }
 
 // -----------------------------------------------------------------------------
-/// @brief Private helper for doIt(). Returns true on success, false on failure.
+/// @brief Private helper for
+/// synchronizeEngineWithRole:synchronizeBoardSize:positionFingerprint:().
+/// Returns a GtpEngineState object that describes the position that the GTP
+/// engine should have after synchronization. Returns nil on failure.
 // -----------------------------------------------------------------------------
-- (bool) syncGTPEngineMoves
+- (GtpEngineState*) targetEngineState
 {
   GoGame* game = [GoGame sharedGame];
-  GoMove* syncUpToThisMove = nil;
-  if (SyncMovesUpToCurrentBoardPosition == self.syncMoveType)
-    syncUpToThisMove = game.boardPosition.currentMove;
-  else
-    syncUpToThisMove = game.lastMove;
+  GtpEngineState* targetState = [[[GtpEngineState alloc] init] autorelease];
+  targetState.known = true;
+  targetState.boardSize = game.board.size;
+  targetState.komi = [GtpEngineState komiStringWithKomi:game.komi];
+
+  targetState.handicap = [self handicapString];
+  targetState.setupStones = [self setupStonesString];
+
+  if (game.setupFirstMoveColor == GoColorBlack)
+    targetState.setupPlayer = @"B";
+  else if (game.setupFirstMoveColor == GoColorWhite)
+    targetState.setupPlayer = @"W";
+
+  GoMove* syncUpToThisMove = [self syncUpToThisMove];
   if (! syncUpToThisMove)
-    return true;
-  NSString* commandString = @"gogui-play_sequence";
+    return targetState;
   GoMove* move = game.moveModel.firstMove;
   while (true)
   {
-    if (move.player.black)
-      commandString = [commandString stringByAppendingString:@" B "];
-    else
-      commandString = [commandString stringByAppendingString:@" W "];
+    NSString* colorString = move.player.black ? @"B" : @"W";
     switch (move.type)
     {
       case GoMoveTypePlay:
-        commandString = [commandString stringByAppendingString:move.point.vertex.string];
+        [targetState.moves addObject:[GtpEngineState moveWithColor:colorString vertex:move.point.vertex.string]];
         break;
       case GoMoveTypePass:
-        commandString = [commandString stringByAppendingString:@" PASS"];
+        [targetState.moves addObject:[GtpEngineState moveWithColor:colorString vertex:@"PASS"]];
         break;
       default:
         DDLogError(@"%@: Unexpected move type %d", [self shortDescription], move.type);
         assert(0);
-        return false;
+        return nil;
     }
     if (move == syncUpToThisMove)
       break;
     move = move.next;
   }
-  GtpCommand* commandSetup = [GtpCommand command:commandString];
-  [commandSetup submit];
-  assert(commandSetup.response.status);
-  return commandSetup.response.status;
+  return targetState;
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Private helper for
+/// synchronizeEngineWithRole:synchronizeBoardSize:positionFingerprint:().
+// -----------------------------------------------------------------------------
+- (void) addBoardSizeCommandForState:(GtpEngineState*)targetState toArray:(NSMutableArray*)commands
+{
+  NSString* commandString = [NSString stringWithFormat:@"boardsize %d", targetState.boardSize];
+  [commands addObject:[GtpCommand command:commandString]];
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Private helper for
+/// synchronizeEngineWithRole:synchronizeBoardSize:positionFingerprint:().
+// -----------------------------------------------------------------------------
+- (void) addClearBoardCommandToArray:(NSMutableArray*)commands
+{
+  [commands addObject:[GtpCommand command:@"clear_board"]];
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Private helper for
+/// synchronizeEngineWithRole:synchronizeBoardSize:positionFingerprint:().
+// -----------------------------------------------------------------------------
+- (void) addHandicapCommandForState:(GtpEngineState*)targetState toArray:(NSMutableArray*)commands
+{
+  // The previously sent GTP command "clear_board" has left Fuego without a
+  // handicap, so we need to setup handicap only if there is one
+  if (! targetState.handicap)
+    return;
+
+  NSString* commandString = [@"set_free_handicap " stringByAppendingString:targetState.handicap];
+  [commands addObject:[GtpCommand command:commandString]];
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Private helper for
+/// synchronizeEngineWithRole:synchronizeBoardSize:positionFingerprint:().
+// -----------------------------------------------------------------------------
+- (void) addKomiCommandForState:(GtpEngineState*)targetState toArray:(NSMutableArray*)commands
+{
+  // The previously sent GTP command "clear_board" has caused Fuego to reset
+  // komi to the last value that was explicitly set with the GTP command "komi"
+  // (or to the built-in default komi value, in case no "komi" command was ever
+  // sent). Therefore, unlike handicap we always have to setup komi.
+  NSString* commandString = [@"komi " stringByAppendingString:targetState.komi];
+  [commands addObject:[GtpCommand command:commandString]];
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Private helper for
+/// synchronizeEngineWithRole:synchronizeBoardSize:positionFingerprint:().
+// -----------------------------------------------------------------------------
+- (void) addSetupStonesCommandForState:(GtpEngineState*)targetState toArray:(NSMutableArray*)commands
+{
+  if (! targetState.setupStones)
+    return;
+
+  NSString* commandString = [@"gogui-setup " stringByAppendingString:targetState.setupStones];
+  [commands addObject:[GtpCommand command:commandString]];
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Private helper for
+/// synchronizeEngineWithRole:synchronizeBoardSize:positionFingerprint:().
+// -----------------------------------------------------------------------------
+- (void) addSetupPlayerCommandForState:(GtpEngineState*)targetState toArray:(NSMutableArray*)commands
+{
+  if (! targetState.setupPlayer)
+    return;
+
+  NSString* commandString = [@"gogui-setup_player " stringByAppendingString:targetState.setupPlayer];
+  [commands addObject:[GtpCommand command:commandString]];
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Private helper for
+/// synchronizeEngineWithRole:synchronizeBoardSize:positionFingerprint:().
+/// Adds one "undo" command per move that must be taken back.
+// -----------------------------------------------------------------------------
+- (void) addUndoCommands:(NSUInteger)numberOfUndos toArray:(NSMutableArray*)commands
+{
+  for (NSUInteger undoIndex = 0; undoIndex < numberOfUndos; ++undoIndex)
+    [commands addObject:[GtpCommand command:@"undo"]];
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Private helper for
+/// synchronizeEngineWithRole:synchronizeBoardSize:positionFingerprint:().
+/// Adds a single command that plays the moves in @a moves, starting with the
+/// move at index position @a indexOfFirstMove. Does nothing if there are no
+/// moves to play.
+// -----------------------------------------------------------------------------
+- (void) addMovesCommandForMoves:(NSArray*)moves fromIndex:(NSUInteger)indexOfFirstMove toArray:(NSMutableArray*)commands
+{
+  NSUInteger numberOfMoves = moves.count;
+  if (indexOfFirstMove >= numberOfMoves)
+    return;
+
+  // Each move is at most 6 characters long ("W PASS"), plus separator
+  NSMutableString* commandString = [NSMutableString stringWithCapacity:20 + (numberOfMoves - indexOfFirstMove) * 7];
+  [commandString appendString:@"gogui-play_sequence"];
+  for (NSUInteger moveIndex = indexOfFirstMove; moveIndex < numberOfMoves; ++moveIndex)
+  {
+    [commandString appendString:@" "];
+    [commandString appendString:[moves objectAtIndex:moveIndex]];
+  }
+  [commands addObject:[GtpCommand command:commandString]];
 }
 
 @end
@@ -19,10 +19,13 @@
 #import "GenerateDiagnosticsInformationFileCommand.h"
 #import "../boardposition/SyncGTPEngineCommand.h"
 #import "../../diagnostics/BugReportUtilities.h"
+#import "../../diagnostics/GtpLatencyModel.h"
 #import "../../go/GoBoardPosition.h"
 #import "../../go/GoGame.h"
 #import "../../go/GoScore.h"
+#import "../../gtp/GtpClient.h"
 #import "../../gtp/GtpCommand.h"
+#import "../../gtp/GtpEnginePool.h"
 #import "../../gtp/GtpResponse.h"
 #import "../../main/ApplicationDelegate.h"
 #import "../../main/MainUtility.h"
@@ -111,6 +114,7 @@
     [self saveCurrentGameAsSgf];
     [self saveBoardScreenshot];
     [self saveBoardAsSeenByGtpEngine];
+    [self saveGtpLatencyStatistics];
     [self zipLogFiles];
 
     [self zipDiagnosticsInformationFolder];
@@ -247,6 +251,8 @@
 
   NSString* commandString = [NSString stringWithFormat:@"savesgf %@", bugReportCurrentGameFileName];
   GtpCommand* gtpCommand = [GtpCommand command:commandString];
+  // The user waits for the diagnostics information to be generated
+  gtpCommand.priority = GtpCommandPriorityInteractive;
   [gtpCommand submit];
   bool success = gtpCommand.response.status;
 
@@ -322,6 +328,73 @@
                              toFile:[self.diagnosticsInformationFolderPath stringByAppendingPathComponent:bugReportBoardAsSeenByGtpEngineFileName]];
 }
 
+// -----------------------------------------------------------------------------
+/// @brief Saves the GTP latency statistics collected by GtpLatencyModel, the
+/// lane statistics of every GtpClient in the GtpEnginePool, and the engine
+/// synchronization statistics of SyncGTPEngineCommand, to a JSON file.
+///
+/// The JSON object has three members: "commands" contains the latency
+/// histograms per command name and phase (see
+/// GtpLatencyModel::dictionaryRepresentation()), "engines" contains one
+/// object per engine in the GtpEnginePool with the statistics of each lane of
+/// the engine's GtpClient, "engineSyncs" contains the counters of
+/// SyncGTPEngineCommand::statistics(). All durations are measured in seconds.
+// -----------------------------------------------------------------------------
+- (void) saveGtpLatencyStatistics
+{
+  DDLogVerbose(@"%@: Writing GTP latency statistics to file", [self shortDescription]);
+
+  ApplicationDelegate* applicationDelegate = [ApplicationDelegate sharedDelegate];
+  NSMutableDictionary* statisticsDictionary = [NSMutableDictionary dictionary];
+  [statisticsDictionary setObject:[applicationDelegate.gtpLatencyModel dictionaryRepresentation] forKey:@"commands"];
+
+  NSArray* laneNames = @[@"interactive", @"normal", @"background", @"bulk"];
+  NSMutableArray* engines = [NSMutableArray array];
+  GtpEnginePool* gtpEnginePool = applicationDelegate.gtpEnginePool;
+  for (int engineIndex = 0; engineIndex < gtpEnginePool.numberOfEngines; ++engineIndex)
+  {
+    GtpClient* client = [gtpEnginePool clientAtIndex:engineIndex];
+    NSMutableDictionary* lanes = [NSMutableDictionary dictionary];
+    for (int lane = 0; lane < GtpCommandPriorityMax; ++lane)
+    {
+      struct GtpCommandLaneStatistics statistics = [client statisticsForLane:(enum GtpCommandPriority)lane];
+      NSMutableDictionary* laneDictionary = [NSMutableDictionary dictionary];
+      [laneDictionary setValue:[NSNumber numberWithUnsignedLong:statistics.queueDepth] forKey:@"queueDepth"];
+      [laneDictionary setValue:[NSNumber numberWithUnsignedLong:statistics.maximumQueueDepth] forKey:@"maximumQueueDepth"];
+      [laneDictionary setValue:[NSNumber numberWithUnsignedLong:statistics.numberOfProcessedBatches] forKey:@"numberOfProcessedBatches"];
+      [laneDictionary setValue:[NSNumber numberWithUnsignedLong:statistics.numberOfPreemptions] forKey:@"numberOfPreemptions"];
+      [laneDictionary setValue:[NSNumber numberWithDouble:statistics.totalWaitTime] forKey:@"totalWaitTime"];
+      [laneDictionary setValue:[NSNumber numberWithDouble:statistics.maximumWaitTime] forKey:@"maximumWaitTime"];
+      [lanes setObject:laneDictionary forKey:[laneNames objectAtIndex:lane]];
+    }
+    [engines addObject:@{@"engineIndex": [NSNumber numberWithInt:engineIndex], @"lanes": lanes}];
+  }
+  [statisticsDictionary setObject:engines forKey:@"engines"];
+
+  struct SyncGTPEngineStatistics syncStatistics = [SyncGTPEngineCommand statistics];
+  NSMutableDictionary* syncDictionary = [NSMutableDictionary dictionary];
+  [syncDictionary setValue:[NSNumber numberWithUnsignedLong:syncStatistics.numberOfSkippedSyncs] forKey:@"numberOfSkippedSyncs"];
+  [syncDictionary setValue:[NSNumber numberWithUnsignedLong:syncStatistics.numberOfIncrementalSyncs] forKey:@"numberOfIncrementalSyncs"];
+  [syncDictionary setValue:[NSNumber numberWithUnsignedLong:syncStatistics.numberOfFullSyncs] forKey:@"numberOfFullSyncs"];
+  [statisticsDictionary setObject:syncDictionary forKey:@"engineSyncs"];
+
+  NSError* error = nil;
+  NSData* data = [NSJSONSerialization dataWithJSONObject:statisticsDictionary
+                                                 options:NSJSONWritingPrettyPrinted
+                                                   error:&error];
+  NSString* statisticsPath = [self.diagnosticsInformationFolderPath stringByAppendingPathComponent:bugReportGtpLatencyStatisticsFileName];
+  BOOL success = (data && [data writeToFile:statisticsPath atomically:YES]);
+  if (! success)
+  {
+    NSString* errorMessage = [NSString stringWithFormat:@"Failed to write GTP latency statistics to file %@, error: %@", statisticsPath, error];
+    DDLogError(@"%@: %@", [self shortDescription], errorMessage);
+    NSException* exception = [NSException exceptionWithName:NSGenericException
+                                                     reason:errorMessage
+                                                   userInfo:nil];
+    @throw exception;
+  }
+}
+
 // -----------------------------------------------------------------------------
 /// @brief Creates a .zip archive in the diagnostics information folder that
 /// contains the application log files. The .zip archive is not created if no
@@ -420,6 +493,8 @@
 - (NSString*) boardAsSeenByGtpEngine
 {
   GtpCommand* gtpCommand = [GtpCommand command:@"showboard"];
+  // The user waits for the diagnostics information to be generated
+  gtpCommand.priority = GtpCommandPriorityInteractive;
   [gtpCommand submit];
   bool success = gtpCommand.response.status;
   if (! success)
@@ -67,11 +67,14 @@
 {
 @private
   enum GoBoardSize m_boardSize;
-  NSString* m_handicap;
-  NSString* m_setup;
+  /// @brief Board indexes, see GtpResponse::boardIndexesWithBoardSize:().
+  NSData* m_handicap;
+  /// @brief GtpResponseMove structs, see GtpResponse::movesWithBoardSize:().
+  NSData* m_setup;
   NSString* m_setupPlayer;
   NSString* m_komi;
-  NSString* m_moves;
+  /// @brief GtpResponseMove structs, see GtpResponse::movesWithBoardSize:().
+  NSData* m_moves;
   NSString* m_oldCurrentDirectory;
 }
 
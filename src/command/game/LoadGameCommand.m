@@ -42,16 +42,6 @@
 // Constants
 static const int maxStepsForReplayMoves = 10;
 
-/// @brief Enumerates possible results of parsing a move string provided by
-/// Fuego.
-enum ParseMoveStringResult
-{
-  ParseMoveStringResultSuccess,
-  ParseMoveStringResultInvalidFormat,
-  ParseMoveStringResultInvalidColor,
-  ParseMoveStringResultInvalidVertex
-};
-
 
 // -----------------------------------------------------------------------------
 /// @brief Class extension with private properties for LoadGameCommand.
@@ -314,10 +304,9 @@ enum ParseMoveStringResult
   // So what we do here is simply count the lines to get the size of the board.
   // Not terribly sophisticated, but I have not found a better, or more
   // reliable way to query for board size.
-  NSArray* responseLines = [command.response.parsedResponse componentsSeparatedByString:@"\n"];
   // Cast is required because NSUInteger and int (the underlying type of enums)
   // differ in size in 64-bit.
-  m_boardSize = (enum GoBoardSize)responseLines.count;
+  m_boardSize = (enum GoBoardSize)[command.response numberOfLines];
   return true;
 }
 
@@ -349,7 +338,13 @@ enum ParseMoveStringResult
     *errorMessage = @"Internal error: Failed to detect handicap of the game to be loaded";
     return false;
   }
-  m_handicap = [command.response.parsedResponse copy];
+  // Expected format: "vertex vertex vertex[...]"
+  m_handicap = [[command.response boardIndexesWithBoardSize:m_boardSize] retain];
+  if (! m_handicap)
+  {
+    *errorMessage = [NSString stringWithFormat:@"Internal error: Handicap of the game to be loaded has an invalid format: %@", command.response.parsedResponse];
+    return false;
+  }
   return true;
 }
 
@@ -365,7 +360,38 @@ enum ParseMoveStringResult
     *errorMessage = @"Internal error: Failed to detect setup of the game to be loaded";
     return false;
   }
-  m_setup = [command.response.parsedResponse copy];
+  // Expected format: "color vertex, color vertex, color vertex[...]"
+  enum GtpResponseMoveListError error;
+  NSString* colorString;
+  NSString* vertexString;
+  m_setup = [[command.response movesWithBoardSize:m_boardSize
+                                            error:&error
+                                 invalidMoveColor:&colorString
+                                invalidMoveVertex:&vertexString] retain];
+  if (! m_setup)
+  {
+    switch (error)
+    {
+      case GtpResponseMoveListErrorInvalidColor:
+      {
+        NSString* errorMessageFormat = @"Game contains an invalid board setup prior to the first move.\n\nThe stone at intersection %@ has an invalid color. Invalid color designation: %@. Supported are 'B' for black and 'W' for white.";
+        *errorMessage = [NSString stringWithFormat:errorMessageFormat, vertexString, colorString];
+        break;
+      }
+      case GtpResponseMoveListErrorInvalidVertex:
+      {
+        NSString* errorMessageFormat = @"Game contains an invalid board setup prior to the first move.\n\nThe intersection %@ is invalid.";
+        *errorMessage = [NSString stringWithFormat:errorMessageFormat, vertexString];
+        break;
+      }
+      default:
+      {
+        *errorMessage = [NSString stringWithFormat:@"Internal error: Setup of the game to be loaded has an invalid format: %@", command.response.parsedResponse];
+        break;
+      }
+    }
+    return false;
+  }
   return true;
 }
 
@@ -397,7 +423,38 @@ enum ParseMoveStringResult
     *errorMessage = @"Internal error: Failed to detect moves of the game to be loaded";
     return false;
   }
-  m_moves = [command.response.parsedResponse copy];
+  // Expected format: "color vertex, color vertex, color vertex[...]"
+  enum GtpResponseMoveListError error;
+  NSString* colorString;
+  NSString* vertexString;
+  m_moves = [[command.response movesWithBoardSize:m_boardSize
+                                            error:&error
+                                 invalidMoveColor:&colorString
+                                invalidMoveVertex:&vertexString] retain];
+  if (! m_moves)
+  {
+    NSString* reason;
+    switch (error)
+    {
+      case GtpResponseMoveListErrorInvalidColor:
+      {
+        reason = @"Move string contains unsupported player color";
+        break;
+      }
+      case GtpResponseMoveListErrorInvalidVertex:
+      {
+        reason = @"Move string contains invalid intersection";
+        break;
+      }
+      default:
+      {
+        reason = @"Move string has invalid format";
+        break;
+      }
+    }
+    *errorMessage = [NSString stringWithFormat:@"Internal error: %@. Move string = %@ %@", reason, colorString, vertexString];
+    return false;
+  }
   return true;
 }
 
@@ -503,30 +560,23 @@ enum ParseMoveStringResult
 /// @brief Sets up handicap for the new game, using the information in
 /// @a handicapFromGtp.
 ///
-/// Expected format for @a handicapFromGtp is: "vertex vertex vertex[...]"
+/// @a handicapFromGtp is expected to contain the board indexes of the
+/// handicap stones, as returned by GtpResponse::boardIndexesWithBoardSize:().
 ///
 /// @a handicapFromGtp may be empty to indicate that there is no handicap.
 // -----------------------------------------------------------------------------
-- (void) setupHandicap:(NSString*)handicapFromGtp
+- (void) setupHandicap:(NSData*)handicapFromGtp
 {
+  // If there is no handicap, the empty array must still be applied to the
+  // GoGame instance; this is important because the GoGame instance might have
+  // been set up by NewGameCommand with a different default handicap
   GoGame* game = [GoGame sharedGame];
-  NSMutableArray* handicapPoints = [NSMutableArray arrayWithCapacity:0];
-  if (0 == handicapFromGtp.length)
-  {
-    // do nothing, just leave the empty array to be applied to the GoGame
-    // instance; this is important because the GoGame instance might have been
-    // set up by NewGameCommand with a different default handicap
-  }
-  else
-  {
-    GoBoard* board = game.board;
-    NSArray* handicapVertices = [handicapFromGtp componentsSeparatedByString:@" "];
-    for (NSString* vertex in handicapVertices)
-    {
-      GoPoint* point = [board pointAtVertex:vertex];
-      [handicapPoints addObject:point];
-    }
-  }
+  GoBoard* board = game.board;
+  const int* boardIndexes = (const int*)handicapFromGtp.bytes;
+  NSUInteger numberOfHandicapStones = handicapFromGtp.length / sizeof(int);
+  NSMutableArray* handicapPoints = [NSMutableArray arrayWithCapacity:numberOfHandicapStones];
+  for (NSUInteger index = 0; index < numberOfHandicapStones; ++index)
+    [handicapPoints addObject:[board pointAtIndex:boardIndexes[index]]];
   // GoGame takes care to place black stones on the points
   game.handicapPoints = handicapPoints;
 }
@@ -535,15 +585,15 @@ enum ParseMoveStringResult
 /// @brief Sets up the setup stones prior to the first move of the game, using
 /// the information in @a setupFromGtp.
 ///
-/// Expected format for @a setupFromGtp:
-///   "color vertex, color vertex, color vertex[...]"
+/// @a setupFromGtp is expected to contain one GtpResponseMove struct per setup
+/// stone, as returned by GtpResponse::movesWithBoardSize:().
 ///
 /// @a setupFromGtp may be empty to indicate that there are no stones to set up.
 ///
 /// @note If an error occurs while this method runs, handleCommandFailed:() is
 /// invoked with an appropriate error message.
 // -----------------------------------------------------------------------------
-- (void) setupSetup:(NSString*)setupFromGtp
+- (void) setupSetup:(NSData*)setupFromGtp
 {
   if (setupFromGtp.length == 0)
     return;
@@ -554,61 +604,41 @@ enum ParseMoveStringResult
 
   NSMutableArray* blackSetupPoints = [NSMutableArray arrayWithCapacity:0];
   NSMutableArray* whiteSetupPoints = [NSMutableArray arrayWithCapacity:0];
-  NSMutableArray* setupVertexes = [NSMutableArray arrayWithCapacity:0];
-  NSArray* setupStoneStrings = [setupFromGtp componentsSeparatedByString:@", "];
+  NSMutableIndexSet* setupBoardIndexes = [NSMutableIndexSet indexSet];
+  const struct GtpResponseMove* setupStones = (const struct GtpResponseMove*)setupFromGtp.bytes;
+  NSUInteger numberOfSetupStones = setupFromGtp.length / sizeof(struct GtpResponseMove);
 
-  for (NSString* setupStoneString in setupStoneStrings)
+  for (NSUInteger index = 0; index < numberOfSetupStones; ++index)
   {
-    NSArray* setupStoneStringComponents = [setupStoneString componentsSeparatedByString:@" "];
-
-    NSString* colorString = [setupStoneStringComponents objectAtIndex:0];
-    NSString* vertexString = [setupStoneStringComponents objectAtIndex:1];
-
-    enum GoColor stoneColor;
-    bool success = [self parseColorString:colorString
-                                    color:&stoneColor];
-    if (! success)
+    enum GoColor stoneColor = setupStones[index].color;
+    int boardIndex = setupStones[index].boardIndex;
+    if (boardIndex < 0)
     {
-      NSString* errorMessageFormat = @"Game contains an invalid board setup prior to the first move.\n\nThe stone at intersection %@ has an invalid color. Invalid color designation: %@. Supported are 'B' for black and 'W' for white.";
-      NSString* errorMessage = [NSString stringWithFormat:errorMessageFormat, vertexString, colorString];
-      [self handleCommandFailed:errorMessage];
-      return;
-    }
-
-    GoPoint* point;
-    @try
-    {
-      point = [board pointAtVertex:vertexString];
-    }
-    @catch (NSException* exception)
-    {
-      // If the vertex is not legal an exception is raised:
-      // - NSInvalidArgumentException if vertex is malformed
-      // - NSRangeException if vertex compounds are out of range
-      // For our purposes, both exception types are the same.
+      NSString* vertexString = (GtpResponseBoardIndexPass == boardIndex) ? @"pass" : @"resign";
       NSString* errorMessageFormat = @"Game contains an invalid board setup prior to the first move.\n\nThe intersection %@ is invalid.";
       NSString* errorMessage = [NSString stringWithFormat:errorMessageFormat, vertexString];
       [self handleCommandFailed:errorMessage];
       return;
     }
+    GoPoint* point = [board pointAtIndex:boardIndex];
 
     // Fuego should not list stones twice - if two different SGF setup
     // properties set up the same intersection Fuego should only list the
     // last setup. We perform the check anyway, to be on the safe side.
-    if ([setupVertexes containsObject:point.vertex.string])
+    if ([setupBoardIndexes containsIndex:boardIndex])
     {
       NSString* errorMessageFormat = @"Game contains an invalid board setup prior to the first move.\n\nAn intersection must be set up with a stone only once, but intersection %@ is set up with a stone at least twice.";
-      NSString* errorMessage = [NSString stringWithFormat:errorMessageFormat, vertexString];
+      NSString* errorMessage = [NSString stringWithFormat:errorMessageFormat, point.vertex.string];
       [self handleCommandFailed:errorMessage];
       return;
     }
-    [setupVertexes addObject:point.vertex.string];
+    [setupBoardIndexes addIndex:boardIndex];
 
     if ([handicapPoints containsObject:point])
     {
       NSString* colorName = [[NSString stringWithGoColor:stoneColor] lowercaseString];
       NSString* errorMessageFormat = @"Game contains an invalid board setup prior to the first move.\n\nThe intersection %@ is set up with a %@ stone although it is already occupied by a black handicap stone.";
-      NSString* errorMessage = [NSString stringWithFormat:errorMessageFormat, vertexString, colorName];
+      NSString* errorMessage = [NSString stringWithFormat:errorMessageFormat, point.vertex.string, colorName];
       [self handleCommandFailed:errorMessage];
       return;
     }
@@ -698,29 +728,22 @@ enum ParseMoveStringResult
 /// @brief Sets up the moves for the new game, using the information in
 /// @a movesFromGtp.
 ///
-/// Expected format for @a movesFromGtp:
-///   "color vertex, color vertex, color vertex[...]"
+/// @a movesFromGtp is expected to contain one GtpResponseMove struct per move,
+/// as returned by GtpResponse::movesWithBoardSize:().
 ///
 /// @a movesFromGtp may be empty to indicate that there are no moves.
 ///
 /// @note If an error occurs while this method runs, handleCommandFailed:() is
 /// invoked with an appropriate error message.
 // -----------------------------------------------------------------------------
-- (void) setupMoves:(NSString*)movesFromGtp
+- (void) setupMoves:(NSData*)movesFromGtp
 {
-  NSArray* moveList;
-  if (0 == movesFromGtp.length)
-    moveList = [NSArray array];
-  else
-    moveList = [movesFromGtp componentsSeparatedByString:@", "];
-  [self replayMoves:moveList];
+  [self replayMoves:(const struct GtpResponseMove*)movesFromGtp.bytes
+      numberOfMoves:movesFromGtp.length / sizeof(struct GtpResponseMove)];
 }
 
 // -----------------------------------------------------------------------------
-/// @brief Replays the moves in @a moveList.
-///
-/// @a moveList is expected to contain NSString objects, each having the format
-/// "color vertex" (e.g. "W C13").
+/// @brief Replays the @a numberOfMoves moves in @a moves.
 ///
 /// The asynchronous command delegate is updated continuously with progress
 /// information as the moves are replayed. In an ideal world we would have
@@ -734,20 +757,20 @@ enum ParseMoveStringResult
 /// @note If an error occurs while this method runs, handleCommandFailed:() is
 /// invoked with an appropriate error message.
 // -----------------------------------------------------------------------------
-- (void) replayMoves:(NSArray*)moveList
+- (void) replayMoves:(const struct GtpResponseMove*)moves numberOfMoves:(NSUInteger)numberOfMoves
 {
   GoGame* game = [GoGame sharedGame];
 
   float movesPerStep;
   NSUInteger remainingNumberOfSteps;
-  if (moveList.count <= maxStepsForReplayMoves)
+  if (numberOfMoves <= maxStepsForReplayMoves)
   {
     movesPerStep = 1;
-    remainingNumberOfSteps = moveList.count;
+    remainingNumberOfSteps = numberOfMoves;
   }
   else
   {
-    movesPerStep = moveList.count / maxStepsForReplayMoves;
+    movesPerStep = numberOfMoves / maxStepsForReplayMoves;
     remainingNumberOfSteps = maxStepsForReplayMoves;
   }
   float remainingProgress = 1.0 - self.progress;
@@ -758,22 +781,14 @@ enum ParseMoveStringResult
   {
     int movesReplayed = 0;
     float nextProgressUpdate = movesPerStep;  // use float in case movesPerStep has fractions
-    for (NSString* moveString in moveList)
+    GoBoard* board = game.board;
+    for (NSUInteger moveIndex = 0; moveIndex < numberOfMoves; ++moveIndex)
     {
-      enum GoColor moveColor;
-      bool isResignMove;
-      enum GoMoveType moveType;
-      GoPoint* point;
-      enum ParseMoveStringResult result = [self parseMoveString:moveString
-                                                      moveColor:&moveColor
-                                           isResignMove:&isResignMove
-                                                       moveType:&moveType
-                                                          point:&point];
-      if (ParseMoveStringResultSuccess != result)
-      {
-        [self handleInvalidMoveString:moveString parseMoveStringResult:result];
-        return;
-      }
+      enum GoColor moveColor = moves[moveIndex].color;
+      int boardIndex = moves[moveIndex].boardIndex;
+      bool isResignMove = (GtpResponseBoardIndexResign == boardIndex);
+      enum GoMoveType moveType = (GtpResponseBoardIndexPass == boardIndex) ? GoMoveTypePass : GoMoveTypePlay;
+      GoPoint* point = (boardIndex >= 0) ? [board pointAtIndex:boardIndex] : nil;
 
       // Here we support if the .sgf contains moves by non-alternating colors,
       // anywhere in the game. Thus the user can ***VIEW*** almost any .sgf
@@ -851,112 +866,11 @@ enum ParseMoveStringResult
   }
 }
 
-// -----------------------------------------------------------------------------
-/// @brief Attempts to parse @a moveString. If the parse attempt succeeds,
-/// returns #ParseMoveStringResultSuccess and fills the out parameters with the
-/// result. If the parse attempt fails, returns one of the remaining values from
-/// the #ParseMoveStringResult enumeration. The content of the out parameters is
-/// undefined in this case.
-///
-/// If parsing is successful, the out parameters are filled as follows:
-/// - @a moveColor is always filled
-/// - If @a isResignMove is true, the content of the remaining parameters is
-///   undefined
-/// - If @a isResignMove is false, @a moveType is either #GoMoveTypePass or
-///   #GoMoveTypePlay
-/// - If @a moveType is #GoMoveTypePass, the content of @a point is undefined
-///
-/// This is a private helper for replayMoves:().
-// -----------------------------------------------------------------------------
-- (enum ParseMoveStringResult) parseMoveString:(NSString*)moveString
-                                     moveColor:(enum GoColor*)moveColor
-                                  isResignMove:(bool*)isResignMove
-                                      moveType:(enum GoMoveType*)moveType
-                                         point:(GoPoint**)point
-{
-  NSArray* moveStringComponents = [moveString componentsSeparatedByString:@" "];
-  if (moveStringComponents.count != 2)
-    return ParseMoveStringResultInvalidFormat;
-
-  bool success = [self parseColorString:[moveStringComponents objectAtIndex:0]
-                                  color:moveColor];
-  if (! success)
-    return ParseMoveStringResultInvalidColor;
-
-  NSString* vertexString = [[moveStringComponents objectAtIndex:1] lowercaseString];
-  if ([vertexString isEqualToString:@"resign"])  // not sure if this is ever sent
-  {
-    *isResignMove = true;
-    return ParseMoveStringResultSuccess;
-  }
-  else if ([vertexString isEqualToString:@"pass"])
-  {
-    *isResignMove = false;
-    *moveType = GoMoveTypePass;
-    return ParseMoveStringResultSuccess;
-  }
-  else
-  {
-    *isResignMove = false;
-    *moveType = GoMoveTypePlay;
-    @try
-    {
-      *point = [[GoGame sharedGame].board pointAtVertex:vertexString];
-      return ParseMoveStringResultSuccess;
-    }
-    @catch (NSException* exception)
-    {
-      // If the vertex is not legal an exception is raised:
-      // - NSInvalidArgumentException if vertex is malformed
-      // - NSRangeException if vertex compounds are out of range
-      // For our purposes, both exception types are the same.
-      return ParseMoveStringResultInvalidVertex;
-    }
-  }
-}
-
-// -----------------------------------------------------------------------------
-/// @brief Performs all steps required to handle the case that a move string
-/// provided by Fuego could not be parsed.
-///
-/// This is a private helper for replayMoves:().
-// -----------------------------------------------------------------------------
-- (void) handleInvalidMoveString:(NSString*)moveString parseMoveStringResult:(enum ParseMoveStringResult)parseMoveStringResult
-{
-  NSString* errorMessage;
-  switch (parseMoveStringResult)
-  {
-    case ParseMoveStringResultInvalidFormat:
-    {
-      errorMessage = @"Move string has invalid format";
-      break;
-    }
-    case ParseMoveStringResultInvalidColor:
-    {
-      errorMessage = @"Move string contains unsupported player color";
-      break;
-    }
-    case ParseMoveStringResultInvalidVertex:
-    {
-      errorMessage = @"Move string contains invalid intersection";
-      break;
-    }
-    default:
-    {
-      errorMessage = @"Unknown error";
-      assert(0);
-      break;
-    }
-  }
-  errorMessage = [NSString stringWithFormat:@"Internal error: %@. Move string = %@", errorMessage, moveString];
-  [self handleCommandFailed:errorMessage];
-}
-
 // -----------------------------------------------------------------------------
 /// @brief Returns a description for @a gameHasEndedReason that can be
 /// incorporated into an error message.
 ///
-/// This is a private helper for replayMoves:().
+/// This is a private helper for replayMoves:numberOfMoves:().
 // -----------------------------------------------------------------------------
 - (NSString*) gameHasEndedReasonDescription:(enum GoGameHasEndedReason)gameHasEndedReason
 {
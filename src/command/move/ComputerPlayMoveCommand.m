@@ -19,6 +19,7 @@
 #import "ComputerPlayMoveCommand.h"
 #import "../backup/BackupGameToSgfCommand.h"
 #import "../backup/CleanBackupSgfCommand.h"
+#import "../boardposition/SyncGTPEngineCommand.h"
 #import "../game/NewGameCommand.h"
 #import "../game/SaveGameCommand.h"
 #import "../playerinfluence/UpdateTerritoryStatisticsCommand.h"
@@ -30,6 +31,7 @@
 #import "../../go/GoPoint.h"
 #import "../../go/GoVertex.h"
 #import "../../gtp/GtpCommand.h"
+#import "../../gtp/GtpFuture.h"
 #import "../../gtp/GtpResponse.h"
 #import "../../main/ApplicationDelegate.h"
 #import "../../main/WindowRootViewController.h"
@@ -109,10 +111,23 @@ enum AlertType
   // gives the UI the time to update (e.g. status view, activity indicator).
   NSString* commandString = @"genmove ";
   commandString = [commandString stringByAppendingString:self.game.nextMovePlayer.colorString];
-  GtpCommand* command = [GtpCommand asynchronousCommand:commandString
-                                         responseTarget:self
-                                               selector:@selector(gtpResponseReceived:)];
-  [command submit];
+  GtpCommand* command = [GtpCommand command:commandString];
+  // Thinking may take a long time. If the user does something that requires
+  // the GTP engine in the meantime, the user must not have to wait until the
+  // computer has made up its mind. An interrupted "genmove" still plays the
+  // best move found so far, therefore the move must be undone before the
+  // command is re-submitted.
+  command.priority = GtpCommandPriorityBackground;
+  command.preemptible = true;
+  command.preemptionRollbackCommand = @"undo";
+  // The continuation block retains self until the response has been received
+  [[command submitAsynchronously] then:^(GtpFuture* future)
+   {
+     if (future.isCancelled)
+       [self gtpCommandWasCancelled];
+     else
+       [self gtpResponseReceived:future.response];
+   }];
   self.game.reasonForComputerIsThinking = GoGameComputerIsThinkingReasonComputerPlay;
   return true;
 }
@@ -154,6 +169,25 @@ enum AlertType
   }
 }
 
+// -----------------------------------------------------------------------------
+/// @brief Is triggered when GtpClient has cancelled the command submitted in
+/// doIt() because the GTP engine's position changed while the command was
+/// preempted. The GTP engine is brought back into the position of the game,
+/// then the computer starts thinking anew if it is still its turn.
+// -----------------------------------------------------------------------------
+- (void) gtpCommandWasCancelled
+{
+  DDLogInfo(@"%@: GTP command was cancelled because the GTP engine's position has changed", [self shortDescription]);
+  bool syncSuccess = [[[[SyncGTPEngineCommand alloc] init] autorelease] submit];
+  if (! syncSuccess)
+  {
+    DDLogError(@"%@: Failed to synchronize the GTP engine after the GTP command was cancelled", [self shortDescription]);
+    self.game.reasonForComputerIsThinking = GoGameComputerIsThinkingReasonIsNotThinking;
+    return;
+  }
+  [self continuePlayingIfNecessary];
+}
+
 // -----------------------------------------------------------------------------
 /// @brief Instructs GoGame to play the move that is inside @a response. Returns
 /// true on success, false on failure (e.g. if move was illegal).
@@ -18,9 +18,11 @@
 // Project includes
 #import "GenerateTerritoryStatisticsCommand.h"
 #import "UpdateTerritoryStatisticsCommand.h"
+#import "../boardposition/SyncGTPEngineCommand.h"
 #import "../../go/GoGame.h"
 #import "../../go/GoPlayer.h"
 #import "../../gtp/GtpCommand.h"
+#import "../../gtp/GtpFuture.h"
 #import "../../gtp/GtpResponse.h"
 
 
@@ -36,10 +38,20 @@
     return false;
   NSString* commandString = @"reg_genmove ";
   commandString = [commandString stringByAppendingString:game.nextMovePlayer.colorString];
-  GtpCommand* command = [GtpCommand asynchronousCommand:commandString
-                                         responseTarget:self
-                                               selector:@selector(gtpResponseReceived:)];
-  [command submit];
+  GtpCommand* command = [GtpCommand command:commandString];
+  // "reg_genmove" does not change the board, so no rollback is necessary
+  // when it is preempted
+  command.priority = GtpCommandPriorityBackground;
+  command.preemptible = true;
+  command.role = GtpEngineRoleAnalysis;
+  // The continuation block retains self until the response has been received
+  [[command submitAsynchronously] then:^(GtpFuture* future)
+   {
+     if (future.isCancelled)
+       [self gtpCommandWasCancelled];
+     else
+       [self gtpResponseReceived:future.response];
+   }];
   game.reasonForComputerIsThinking = GoGameComputerIsThinkingReasonPlayerInfluence;
   return true;
 }
@@ -60,4 +72,24 @@
   [GoGame sharedGame].reasonForComputerIsThinking = GoGameComputerIsThinkingReasonIsNotThinking;
 }
 
+// -----------------------------------------------------------------------------
+/// @brief Is triggered when GtpClient has cancelled the command submitted in
+/// doIt() because the GTP engine's position changed while the command was
+/// preempted. The statistics would describe the wrong position, so the GTP
+/// engine is brought back into the position of the game and the statistics
+/// are generated anew.
+// -----------------------------------------------------------------------------
+- (void) gtpCommandWasCancelled
+{
+  DDLogInfo(@"%@: GTP command was cancelled because the GTP engine's position has changed", [self shortDescription]);
+  [GoGame sharedGame].reasonForComputerIsThinking = GoGameComputerIsThinkingReasonIsNotThinking;
+  bool syncSuccess = [[[[SyncGTPEngineCommand alloc] init] autorelease] submit];
+  if (! syncSuccess)
+  {
+    DDLogError(@"%@: Failed to synchronize the GTP engine after the GTP command was cancelled", [self shortDescription]);
+    return;
+  }
+  [[[[GenerateTerritoryStatisticsCommand alloc] init] autorelease] submit];
+}
+
 @end
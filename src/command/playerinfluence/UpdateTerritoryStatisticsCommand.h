@@ -21,11 +21,18 @@
 
 // -----------------------------------------------------------------------------
 /// @brief The UpdateTerritoryStatisticsCommand class is responsible for
-/// updating the territory statistics property in all GoPoint objects with
-/// values obtained from the GTP engine. Command execution occurs synchronously.
+/// updating the territory statistics of the GoBoard object with values
+/// obtained from the GTP engine. Command execution occurs asynchronously.
 ///
+/// UpdateTerritoryStatisticsCommand submits the GTP command and returns
+/// immediately. GtpClient decodes the GTP response into a flat array of float
+/// values while the response is still in its receive buffer. If that fails the
+/// response text is parsed in a secondary thread. The GoBoard object is then
+/// updated in the main thread with a single copy of the array, after which
 /// UpdateTerritoryStatisticsCommand posts the notification
-/// #territoryStatisticsChanged after all GoPoint objects have been updated.
+/// #territoryStatisticsChanged. If the board position or the number of moves
+/// has changed in the meantime, the values are discarded because they
+/// describe a position that is no longer displayed.
 ///
 /// UpdateTerritoryStatisticsCommand executes successfully but does nothing if
 /// the user preference to display player influence is turned off.
@@ -19,16 +19,71 @@
 #import "UpdateTerritoryStatisticsCommand.h"
 #import "../../main/ApplicationDelegate.h"
 #import "../../go/GoBoard.h"
+#import "../../go/GoBoardPosition.h"
 #import "../../go/GoGame.h"
-#import "../../go/GoPoint.h"
-#import "../../go/GoVertex.h"
+#import "../../go/GoMoveModel.h"
 #import "../../gtp/GtpCommand.h"
+#import "../../gtp/GtpFuture.h"
 #import "../../gtp/GtpResponse.h"
 #import "../../play/model/BoardViewModel.h"
 
 
+// -----------------------------------------------------------------------------
+/// @brief Class extension with private properties for
+/// UpdateTerritoryStatisticsCommand.
+// -----------------------------------------------------------------------------
+@interface UpdateTerritoryStatisticsCommand()
+/// @name Privately declared properties
+//@{
+/// @brief The board for which the territory statistics were requested.
+@property(nonatomic, retain) GoBoard* board;
+/// @brief The board position that was current when the territory statistics
+/// were requested.
+@property(nonatomic, assign) int boardPosition;
+/// @brief The move of the board position that was current when the territory
+/// statistics were requested. Is nil for board position 0.
+@property(nonatomic, retain) GoMove* currentMove;
+/// @brief The number of moves that the game had when the territory
+/// statistics were requested.
+@property(nonatomic, assign) int numberOfMoves;
+//@}
+@end
+
+
 @implementation UpdateTerritoryStatisticsCommand
 
+// -----------------------------------------------------------------------------
+/// @brief Initializes an UpdateTerritoryStatisticsCommand object.
+///
+/// @note This is the designated initializer of
+/// UpdateTerritoryStatisticsCommand.
+// -----------------------------------------------------------------------------
+- (id) init
+{
+  // Call designated initializer of superclass (CommandBase)
+  self = [super init];
+  if (! self)
+    return nil;
+
+  self.board = nil;
+  self.boardPosition = 0;
+  self.currentMove = nil;
+  self.numberOfMoves = 0;
+
+  return self;
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Deallocates memory allocated by this UpdateTerritoryStatisticsCommand
+/// object.
+// -----------------------------------------------------------------------------
+- (void) dealloc
+{
+  self.board = nil;
+  self.currentMove = nil;
+  [super dealloc];
+}
+
 // -----------------------------------------------------------------------------
 /// @brief Executes this command. See the class documentation for details.
 // -----------------------------------------------------------------------------
@@ -40,68 +95,88 @@
     DDLogVerbose(@"%@: Display of player influence is turned off, nothing to do.", [self shortDescription]);
     return true;
   }
+
+  // Remember the position for which the territory statistics are requested,
+  // so that the result can be discarded if the position changes while the GTP
+  // command is being processed
+  GoGame* game = [GoGame sharedGame];
+  self.board = game.board;
+  self.boardPosition = game.boardPosition.currentBoardPosition;
+  self.currentMove = game.boardPosition.currentMove;
+  self.numberOfMoves = game.moveModel.numberOfMoves;
+
+  int boardSize = self.board.size;
   GtpCommand* command = [GtpCommand command:@"uct_stat_territory"];
-  [command submit];
-  if (! command.response.status)
-    return false;
-  bool success = [self updateBoardWithGtpResponse:command.response.parsedResponse];
-  if (! success)
-    return false;
-  [[NSNotificationCenter defaultCenter] postNotificationName:territoryStatisticsChanged object:nil];
+  // The user looks at the current position and waits for the territory
+  // statistics. The command is cheap and does not change the position, so it
+  // may preempt a long-running search.
+  command.priority = GtpCommandPriorityInteractive;
+  // Territory statistics are collected by the engine that ran "reg_genmove"
+  command.role = GtpEngineRoleAnalysis;
+  // Let GtpClient decode the response while it is still in the receive buffer
+  command.floatGridSize = boardSize;
+  GtpFuture* future = [command submitAsynchronously];
+
+  // Parsing the response does not require access to the Go model, so it is
+  // done in a secondary thread. Only the final update of the Go model is
+  // done in the main thread. The continuation blocks retain self.
+  [future then:^(GtpFuture* completedFuture)
+   {
+     GtpResponse* response = completedFuture.response;
+     if (! response.status)
+     {
+       DDLogError(@"%@: GTP command failed, response = %@", [self shortDescription], response);
+       return;
+     }
+     // Usually GtpClient has already decoded the response while it was still
+     // in the receive buffer
+     NSData* territoryStatisticsScores = [response floatGridWithSize:boardSize];
+     if (! territoryStatisticsScores)
+     {
+       DDLogError(@"%@: Failed to decode GTP response, response = %@", [self shortDescription], response);
+       return;
+     }
+     dispatch_async(dispatch_get_main_queue(), ^
+     {
+       [self updateBoardWithTerritoryStatisticsScores:territoryStatisticsScores];
+     });
+   }
+       onQueue:dispatch_get_global_queue(DISPATCH_QUEUE_PRIORITY_DEFAULT, 0)];
+
   return true;
 }
 
 // -----------------------------------------------------------------------------
-/// @brief Private helper
+/// @brief Private helper for doIt(). Updates the territory statistics of the
+/// board for which they were requested with the values in
+/// @a territoryStatisticsScores, then posts #territoryStatisticsChanged.
+///
+/// Does nothing if the position has changed while the GTP command was being
+/// processed, i.e. if a new game was started, if the user has navigated to a
+/// different board position, or if moves were played or discarded. The
+/// territory statistics would describe the wrong position in that case.
+///
+/// This method is executed in the main thread.
 // -----------------------------------------------------------------------------
-- (bool) updateBoardWithGtpResponse:(NSString*)gtpResponse
+- (void) updateBoardWithTerritoryStatisticsScores:(NSData*)territoryStatisticsScores
 {
-  GoBoard* board = [GoGame sharedGame].board;
-  struct GoVertexNumeric vertexNumeric;
-  vertexNumeric.x = 1;
-  vertexNumeric.y = board.size;  // start at the top of the board
-  NSArray* responseLines = [gtpResponse componentsSeparatedByString:@"\n"];
-  for (NSString* responseLine in responseLines)
+  GoGame* game = [GoGame sharedGame];
+  if (self.board != game.board)
   {
-    if (0 == vertexNumeric.y)
-    {
-      assert(false);
-      DDLogError(@"%@: GTP response has too many lines", [self shortDescription]);
-      return false;
-    }
-    NSMutableArray* territoryStatisticScores = [NSMutableArray arrayWithArray:[responseLine componentsSeparatedByString:@" "]];
-    [territoryStatisticScores removeObject:@""];
-    if (territoryStatisticScores.count != board.size)
-      continue;  // skip the first line which is empty
-    // Start at the left edge of the board
-    NSString* vertexLeftEdge = [GoVertex vertexFromNumeric:vertexNumeric].string;
-    GoPoint* point = [board pointAtVertex:vertexLeftEdge];
-    for (NSString* territoryStatisticScore in territoryStatisticScores)
-    {
-      if (! point)
-      {
-        assert(false);
-        DDLogError(@"%@: Line in GTP response has too many elements", [self shortDescription]);
-        return false;
-      }
-      point.territoryStatisticsScore = [territoryStatisticScore floatValue];
-      point = point.right;  // continue on the same line to the right
-    }
-    if (point)
-    {
-      assert(false);
-      DDLogError(@"%@: Line in GTP response has not enough elements", [self shortDescription]);
-      return false;
-    }
-    vertexNumeric.y--;  // move down one line
+    DDLogInfo(@"%@: Discarding territory statistics, board has changed", [self shortDescription]);
+    return;
   }
-  if (0 != vertexNumeric.y)
+  if (self.boardPosition != game.boardPosition.currentBoardPosition
+      || self.currentMove != game.boardPosition.currentMove
+      || self.numberOfMoves != game.moveModel.numberOfMoves)
   {
-    assert(false);
-    DDLogError(@"%@: GTP response has not enough lines", [self shortDescription]);
-    return false;
+    DDLogInfo(@"%@: Discarding territory statistics, position has changed", [self shortDescription]);
+    return;
   }
-  return true;
+
+  [self.board updateTerritoryStatisticsScores:(const float*)territoryStatisticsScores.bytes];
+
+  [[NSNotificationCenter defaultCenter] postNotificationName:territoryStatisticsChanged object:nil];
 }
 
 @end
@@ -18,6 +18,7 @@
 // Project includes
 #import "DiagnosticsViewController.h"
 #import "CrashReportingSettingsController.h"
+#import "GtpLatencyViewController.h"
 #import "GtpLogViewController.h"
 #import "GtpLogSettingsController.h"
 #import "GtpCommandViewController.h"
@@ -48,6 +49,7 @@ enum DiagnosticsTableViewSection
 enum GtpSectionItem
 {
   GtpLogItem,
+  GtpLatencyItem,
   GtpCommandsItem,
   GtpSettingsItem,
   MaxGtpSectionItem
@@ -263,6 +265,9 @@ enum BugReportSectionItem
         case GtpLogItem:
           cell.textLabel.text = @"GTP log";
           break;
+        case GtpLatencyItem:
+          cell.textLabel.text = @"GTP latency";
+          break;
         case GtpCommandsItem:
           cell.textLabel.text = @"GTP commands";
           break;
@@ -362,6 +367,9 @@ enum BugReportSectionItem
         case GtpLogItem:
           [self viewGtpLog];
           break;
+        case GtpLatencyItem:
+          [self viewGtpLatency];
+          break;
         case GtpCommandsItem:
           [self viewCannedGtpCommands];
           break;
@@ -429,6 +437,16 @@ enum BugReportSectionItem
   [self.navigationController pushViewController:controller animated:YES];
 }
 
+// -----------------------------------------------------------------------------
+/// @brief Displays GtpLatencyViewController to allow the user to view latency
+/// statistics of GTP commands.
+// -----------------------------------------------------------------------------
+- (void) viewGtpLatency
+{
+  GtpLatencyViewController* controller = [GtpLatencyViewController controller];
+  [self.navigationController pushViewController:controller animated:YES];
+}
+
 // -----------------------------------------------------------------------------
 /// @brief Displays GtpCommandViewController to allow the user to manage canned
 /// GTP commands.
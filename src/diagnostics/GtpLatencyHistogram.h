@@ -0,0 +1,59 @@
+// -----------------------------------------------------------------------------
+// Copyright 2026 Patrick Näf (herzbube@herzbube.ch)
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// -----------------------------------------------------------------------------
+
+
+// -----------------------------------------------------------------------------
+/// @brief The GtpLatencyHistogram class records latency values and provides
+/// statistics about them, such as percentiles.
+///
+/// GtpLatencyHistogram follows the design of HdrHistogram: Values are sorted
+/// into buckets whose width grows with the magnitude of the values, so that
+/// the relative error of a reported value is constant (about 3%), while the
+/// memory footprint is small and fixed. Recording a value is an O(1)
+/// operation that does not allocate memory.
+///
+/// Values are stored with a resolution of one microsecond. The highest value
+/// that can be distinguished is about 18 hours; higher values are counted in
+/// the highest bucket.
+///
+/// All latency values that are passed to or returned by GtpLatencyHistogram
+/// are measured in seconds.
+///
+/// GtpLatencyHistogram is not thread-safe.
+// -----------------------------------------------------------------------------
+@interface GtpLatencyHistogram : NSObject <NSCopying>
+{
+}
+
+- (id) init;
+- (void) recordLatency:(double)latency;
+- (double) latencyAtPercentile:(double)percentile;
+- (void) reset;
+- (NSDictionary*) dictionaryRepresentation;
+
+/// @brief The number of latency values that were recorded.
+@property(nonatomic, assign, readonly) unsigned long count;
+/// @brief The smallest latency value that was recorded. Is 0 if no values
+/// were recorded.
+@property(nonatomic, assign, readonly) double minimumLatency;
+/// @brief The largest latency value that was recorded. Is 0 if no values were
+/// recorded.
+@property(nonatomic, assign, readonly) double maximumLatency;
+/// @brief The arithmetic mean of all latency values that were recorded. Is 0
+/// if no values were recorded.
+@property(nonatomic, assign, readonly) double meanLatency;
+
+@end
@@ -0,0 +1,259 @@
+// -----------------------------------------------------------------------------
+// Copyright 2026 Patrick Näf (herzbube@herzbube.ch)
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// -----------------------------------------------------------------------------
+
+
+// Project includes
+#import "GtpLatencyHistogram.h"
+
+
+// Values below this limit are counted with a resolution of 1 microsecond. The
+// buckets for higher values each have this many sub-buckets, of which the
+// lower half overlaps with the previous bucket and is therefore omitted.
+static const int subBucketCount = 64;
+// log2(subBucketCount / 2)
+static const int subBucketHalfCountMagnitude = 5;
+static const int numberOfBuckets = 1024;
+
+
+// -----------------------------------------------------------------------------
+/// @brief Returns the index of the bucket that counts @a value, which is
+/// measured in microseconds.
+// -----------------------------------------------------------------------------
+static int bucketIndexForValue(uint64_t value)
+{
+  if (value < subBucketCount)
+    return (int)value;
+  int magnitude = 63 - __builtin_clzll(value);
+  int shift = magnitude - subBucketHalfCountMagnitude;
+  int bucketIndex = shift * (subBucketCount / 2) + (int)(value >> shift);
+  return MIN(bucketIndex, numberOfBuckets - 1);
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Returns the lowest value, measured in microseconds, that is counted
+/// in the bucket with index @a bucketIndex.
+// -----------------------------------------------------------------------------
+static uint64_t lowestValueForBucketIndex(int bucketIndex)
+{
+  if (bucketIndex < subBucketCount)
+    return bucketIndex;
+  int shift = bucketIndex / (subBucketCount / 2) - 1;
+  int subBucketIndex = bucketIndex - shift * (subBucketCount / 2);
+  return (uint64_t)subBucketIndex << shift;
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Returns the highest value, measured in microseconds, that is counted
+/// in the bucket with index @a bucketIndex.
+// -----------------------------------------------------------------------------
+static uint64_t highestValueForBucketIndex(int bucketIndex)
+{
+  if (bucketIndex < subBucketCount)
+    return bucketIndex;
+  int shift = bucketIndex / (subBucketCount / 2) - 1;
+  return lowestValueForBucketIndex(bucketIndex) + ((uint64_t)1 << shift) - 1;
+}
+
+
+// -----------------------------------------------------------------------------
+/// @brief Class extension with private properties for GtpLatencyHistogram.
+// -----------------------------------------------------------------------------
+@interface GtpLatencyHistogram()
+{
+  uint32_t _bucketCounts[numberOfBuckets];
+  uint64_t _minimumValue;
+  uint64_t _maximumValue;
+  double _totalLatency;
+}
+/// @name Re-declaration of properties to make them readwrite privately
+//@{
+@property(nonatomic, assign, readwrite) unsigned long count;
+//@}
+@end
+
+
+@implementation GtpLatencyHistogram
+
+// -----------------------------------------------------------------------------
+/// @brief Initializes a GtpLatencyHistogram object that contains no values.
+///
+/// @note This is the designated initializer of GtpLatencyHistogram.
+// -----------------------------------------------------------------------------
+- (id) init
+{
+  // Call designated initializer of superclass (NSObject)
+  self = [super init];
+  if (! self)
+    return nil;
+
+  [self reset];
+
+  return self;
+}
+
+// -----------------------------------------------------------------------------
+/// @brief NSCopying protocol method.
+// -----------------------------------------------------------------------------
+- (id) copyWithZone:(NSZone*)zone
+{
+  GtpLatencyHistogram* copy = [[GtpLatencyHistogram allocWithZone:zone] init];
+  if (copy)
+  {
+    memcpy(copy->_bucketCounts, _bucketCounts, sizeof(_bucketCounts));
+    copy->_minimumValue = _minimumValue;
+    copy->_maximumValue = _maximumValue;
+    copy->_totalLatency = _totalLatency;
+    copy.count = self.count;
+  }
+  return copy;
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Returns a description for this GtpLatencyHistogram object.
+///
+/// This method is invoked when GtpLatencyHistogram needs to be represented as a
+/// string, i.e. by NSLog, or when the debugger command "po" is used on the
+/// object.
+// -----------------------------------------------------------------------------
+- (NSString*) description
+{
+  return [NSString stringWithFormat:@"GtpLatencyHistogram(%p): count = %lu, p50 = %f, p99 = %f, max = %f",
+          self, self.count, [self latencyAtPercentile:50.0], [self latencyAtPercentile:99.0], self.maximumLatency];
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Records the latency value @a latency. Negative values are recorded
+/// as 0.
+// -----------------------------------------------------------------------------
+- (void) recordLatency:(double)latency
+{
+  if (latency < 0.0)
+    latency = 0.0;
+  uint64_t value = (uint64_t)(latency * 1000000.0 + 0.5);
+
+  _bucketCounts[bucketIndexForValue(value)]++;
+  if (0 == self.count || value < _minimumValue)
+    _minimumValue = value;
+  if (value > _maximumValue)
+    _maximumValue = value;
+  _totalLatency += latency;
+  self.count++;
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Returns the latency value below which @a percentile percent of all
+/// recorded latency values fall. @a percentile must be between 0.0 and 100.0.
+/// Returns 0 if no values were recorded.
+///
+/// The returned value is the highest value that is counted in the same bucket
+/// as the value at the requested percentile, but never more than the largest
+/// value that was recorded.
+// -----------------------------------------------------------------------------
+- (double) latencyAtPercentile:(double)percentile
+{
+  if (0 == self.count)
+    return 0.0;
+
+  percentile = MAX(0.0, MIN(100.0, percentile));
+  unsigned long countAtPercentile = (unsigned long)ceil(percentile / 100.0 * self.count);
+  countAtPercentile = MAX(countAtPercentile, 1ul);
+
+  unsigned long cumulativeCount = 0;
+  for (int bucketIndex = 0; bucketIndex < numberOfBuckets; ++bucketIndex)
+  {
+    cumulativeCount += _bucketCounts[bucketIndex];
+    if (cumulativeCount >= countAtPercentile)
+    {
+      uint64_t value = MIN(highestValueForBucketIndex(bucketIndex), _maximumValue);
+      return value / 1000000.0;
+    }
+  }
+  return self.maximumLatency;
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Discards all recorded values.
+// -----------------------------------------------------------------------------
+- (void) reset
+{
+  memset(_bucketCounts, 0, sizeof(_bucketCounts));
+  _minimumValue = 0;
+  _maximumValue = 0;
+  _totalLatency = 0.0;
+  self.count = 0;
+}
+
+// -----------------------------------------------------------------------------
+// Property is documented in the header file.
+// -----------------------------------------------------------------------------
+- (double) minimumLatency
+{
+  return _minimumValue / 1000000.0;
+}
+
+// -----------------------------------------------------------------------------
+// Property is documented in the header file.
+// -----------------------------------------------------------------------------
+- (double) maximumLatency
+{
+  return _maximumValue / 1000000.0;
+}
+
+// -----------------------------------------------------------------------------
+// Property is documented in the header file.
+// -----------------------------------------------------------------------------
+- (double) meanLatency
+{
+  if (0 == self.count)
+    return 0.0;
+  return _totalLatency / self.count;
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Returns a dictionary with the statistics of this GtpLatencyHistogram
+/// that can be serialized with NSJSONSerialization. Latency values are
+/// measured in seconds.
+///
+/// Besides summary statistics the dictionary contains the non-empty buckets,
+/// so that any other statistics can be computed later on. Each bucket is
+/// represented by an array with the lowest value of the bucket (measured in
+/// microseconds) and the number of values in the bucket.
+// -----------------------------------------------------------------------------
+- (NSDictionary*) dictionaryRepresentation
+{
+  NSMutableArray* buckets = [NSMutableArray array];
+  for (int bucketIndex = 0; bucketIndex < numberOfBuckets; ++bucketIndex)
+  {
+    if (0 == _bucketCounts[bucketIndex])
+      continue;
+    [buckets addObject:@[[NSNumber numberWithUnsignedLongLong:lowestValueForBucketIndex(bucketIndex)],
+                         [NSNumber numberWithUnsignedInt:_bucketCounts[bucketIndex]]]];
+  }
+
+  NSMutableDictionary* dictionary = [NSMutableDictionary dictionary];
+  [dictionary setValue:[NSNumber numberWithUnsignedLong:self.count] forKey:@"count"];
+  [dictionary setValue:[NSNumber numberWithDouble:self.minimumLatency] forKey:@"minimum"];
+  [dictionary setValue:[NSNumber numberWithDouble:self.maximumLatency] forKey:@"maximum"];
+  [dictionary setValue:[NSNumber numberWithDouble:self.meanLatency] forKey:@"mean"];
+  [dictionary setValue:[NSNumber numberWithDouble:[self latencyAtPercentile:50.0]] forKey:@"p50"];
+  [dictionary setValue:[NSNumber numberWithDouble:[self latencyAtPercentile:90.0]] forKey:@"p90"];
+  [dictionary setValue:[NSNumber numberWithDouble:[self latencyAtPercentile:99.0]] forKey:@"p99"];
+  [dictionary setValue:[NSNumber numberWithDouble:[self latencyAtPercentile:99.9]] forKey:@"p999"];
+  [dictionary setValue:buckets forKey:@"bucketsMicroseconds"];
+  return dictionary;
+}
+
+@end
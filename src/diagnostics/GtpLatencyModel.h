@@ -0,0 +1,52 @@
+// -----------------------------------------------------------------------------
+// Copyright 2026 Patrick Näf (herzbube@herzbube.ch)
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// -----------------------------------------------------------------------------
+
+
+// Forward declarations
+@class GtpLatencyHistogram;
+
+
+// -----------------------------------------------------------------------------
+/// @brief The GtpLatencyModel class collects latency statistics about the GTP
+/// commands that the application submits to the GTP engine.
+///
+/// GtpLatencyModel observes the application default notification centre for
+/// the #gtpResponseWasReceived notification. The GtpCommand that belongs to
+/// the response carries timestamps that GtpClient recorded while it
+/// processed the command. GtpLatencyModel breaks the command's latency down
+/// into the phases enumerated by #GtpLatencyPhase and records each phase in a
+/// GtpLatencyHistogram. There is one set of histograms per command name (e.g.
+/// "genmove"), so that the latency of long-running commands does not hide the
+/// latency of short commands.
+///
+/// The notification is delivered in the context of a secondary thread.
+/// Unlike GtpLogModel, GtpLatencyModel does not delegate processing to the
+/// main thread, because recording a latency is very cheap. Instead all access
+/// to the histograms is synchronized. Clients receive copies of the
+/// histograms.
+// -----------------------------------------------------------------------------
+@interface GtpLatencyModel : NSObject
+{
+}
+
+- (id) init;
+- (NSArray*) commandNames;
+- (GtpLatencyHistogram*) histogramForCommandName:(NSString*)commandName phase:(enum GtpLatencyPhase)phase;
+- (void) clearStatistics;
+- (NSDictionary*) dictionaryRepresentation;
++ (NSString*) nameOfPhase:(enum GtpLatencyPhase)phase;
+
+@end
@@ -0,0 +1,216 @@
+// -----------------------------------------------------------------------------
+// Copyright 2026 Patrick Näf (herzbube@herzbube.ch)
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// -----------------------------------------------------------------------------
+
+
+// Project includes
+#import "GtpLatencyModel.h"
+#import "GtpLatencyHistogram.h"
+#import "../gtp/GtpCommand.h"
+#import "../gtp/GtpResponse.h"
+
+
+// -----------------------------------------------------------------------------
+/// @brief Class extension with private properties for GtpLatencyModel.
+// -----------------------------------------------------------------------------
+@interface GtpLatencyModel()
+/// @brief Dictionary with command names as keys. Values are arrays with one
+/// GtpLatencyHistogram object per #GtpLatencyPhase. Is protected by
+/// @synchronized(self).
+@property(nonatomic, retain) NSMutableDictionary* histograms;
+@end
+
+
+@implementation GtpLatencyModel
+
+// -----------------------------------------------------------------------------
+/// @brief Initializes a GtpLatencyModel object.
+///
+/// @note This is the designated initializer of GtpLatencyModel.
+// -----------------------------------------------------------------------------
+- (id) init
+{
+  // Call designated initializer of superclass (NSObject)
+  self = [super init];
+  if (! self)
+    return nil;
+
+  self.histograms = [NSMutableDictionary dictionary];
+
+  [[NSNotificationCenter defaultCenter] addObserver:self
+                                           selector:@selector(gtpResponseWasReceived:)
+                                               name:gtpResponseWasReceivedNotification
+                                             object:nil];
+
+  return self;
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Deallocates memory allocated by this GtpLatencyModel object.
+// -----------------------------------------------------------------------------
+- (void) dealloc
+{
+  [[NSNotificationCenter defaultCenter] removeObserver:self];
+  self.histograms = nil;
+  [super dealloc];
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Responds to the #gtpResponseWasReceived notification. Records the
+/// latencies of the command that the response belongs to.
+///
+/// This method is executed in a secondary thread.
+// -----------------------------------------------------------------------------
+- (void) gtpResponseWasReceived:(NSNotification*)notification
+{
+  GtpResponse* response = (GtpResponse*)[notification object];
+  GtpCommand* command = response.command;
+  if (! command || 0 == command.submitTime || 0 == command.completionTime)
+    return;
+
+  double latencies[GtpLatencyPhaseMax];
+  latencies[GtpLatencyPhaseQueueing] = command.dequeueTime - command.submitTime;
+  latencies[GtpLatencyPhaseSending] = command.writeTime - command.dequeueTime;
+  latencies[GtpLatencyPhaseEngine] = command.firstByteTime - command.writeTime;
+  latencies[GtpLatencyPhaseReceiving] = command.completionTime - command.firstByteTime;
+  latencies[GtpLatencyPhaseTotal] = command.completionTime - command.submitTime;
+
+  NSString* commandName = [self commandNameOfCommand:command];
+  @synchronized(self)
+  {
+    NSArray* histogramsOfCommand = [self.histograms objectForKey:commandName];
+    if (! histogramsOfCommand)
+    {
+      NSMutableArray* newHistograms = [NSMutableArray arrayWithCapacity:GtpLatencyPhaseMax];
+      for (int phase = 0; phase < GtpLatencyPhaseMax; ++phase)
+        [newHistograms addObject:[[[GtpLatencyHistogram alloc] init] autorelease]];
+      [self.histograms setObject:newHistograms forKey:commandName];
+      histogramsOfCommand = newHistograms;
+    }
+    for (int phase = 0; phase < GtpLatencyPhaseMax; ++phase)
+      [[histogramsOfCommand objectAtIndex:phase] recordLatency:latencies[phase]];
+  }
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Private helper for gtpResponseWasReceived:(). Returns the name of
+/// @a command, i.e. the first word of the command string.
+// -----------------------------------------------------------------------------
+- (NSString*) commandNameOfCommand:(GtpCommand*)command
+{
+  NSString* commandString = command.command;
+  NSRange rangeOfSpace = [commandString rangeOfString:@" "];
+  if (NSNotFound == rangeOfSpace.location)
+    return commandString;
+  return [commandString substringToIndex:rangeOfSpace.location];
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Returns the names of all commands for which latencies were
+/// recorded, sorted alphabetically.
+// -----------------------------------------------------------------------------
+- (NSArray*) commandNames
+{
+  @synchronized(self)
+  {
+    return [[self.histograms allKeys] sortedArrayUsingSelector:@selector(compare:)];
+  }
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Returns a copy of the histogram that records the latencies of phase
+/// @a phase of commands named @a commandName. Returns nil if no latencies were
+/// recorded for @a commandName.
+// -----------------------------------------------------------------------------
+- (GtpLatencyHistogram*) histogramForCommandName:(NSString*)commandName phase:(enum GtpLatencyPhase)phase
+{
+  @synchronized(self)
+  {
+    NSArray* histogramsOfCommand = [self.histograms objectForKey:commandName];
+    if (! histogramsOfCommand)
+      return nil;
+    return [[[histogramsOfCommand objectAtIndex:phase] copy] autorelease];
+  }
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Discards all latencies recorded so far.
+// -----------------------------------------------------------------------------
+- (void) clearStatistics
+{
+  @synchronized(self)
+  {
+    [self.histograms removeAllObjects];
+  }
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Returns a dictionary with the statistics of all commands that can be
+/// serialized with NSJSONSerialization. The keys of the dictionary are command
+/// names, the values are dictionaries whose keys are phase names and whose
+/// values are the dictionary representations of the histograms.
+// -----------------------------------------------------------------------------
+- (NSDictionary*) dictionaryRepresentation
+{
+  NSMutableDictionary* dictionary = [NSMutableDictionary dictionary];
+  @synchronized(self)
+  {
+    for (NSString* commandName in self.histograms)
+    {
+      NSArray* histogramsOfCommand = [self.histograms objectForKey:commandName];
+      NSMutableDictionary* dictionaryOfCommand = [NSMutableDictionary dictionary];
+      for (int phase = 0; phase < GtpLatencyPhaseMax; ++phase)
+      {
+        GtpLatencyHistogram* histogram = [histogramsOfCommand objectAtIndex:phase];
+        [dictionaryOfCommand setObject:[histogram dictionaryRepresentation]
+                                forKey:[GtpLatencyModel nameOfPhase:(enum GtpLatencyPhase)phase]];
+      }
+      [dictionary setObject:dictionaryOfCommand forKey:commandName];
+    }
+  }
+  return dictionary;
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Returns a short name for @a phase that is suitable for display and
+/// for use as a key in machine-readable output.
+// -----------------------------------------------------------------------------
++ (NSString*) nameOfPhase:(enum GtpLatencyPhase)phase
+{
+  switch (phase)
+  {
+    case GtpLatencyPhaseQueueing:
+      return @"queueing";
+    case GtpLatencyPhaseSending:
+      return @"sending";
+    case GtpLatencyPhaseEngine:
+      return @"engine";
+    case GtpLatencyPhaseReceiving:
+      return @"receiving";
+    case GtpLatencyPhaseTotal:
+      return @"total";
+    default:
+    {
+      NSString* errorMessage = [NSString stringWithFormat:@"Invalid latency phase %d", phase];
+      DDLogError(@"%@: %@", self, errorMessage);
+      NSException* exception = [NSException exceptionWithName:NSInvalidArgumentException
+                                                       reason:errorMessage
+                                                     userInfo:nil];
+      @throw exception;
+    }
+  }
+}
+
+@end
@@ -0,0 +1,32 @@
+// -----------------------------------------------------------------------------
+// Copyright 2026 Patrick Näf (herzbube@herzbube.ch)
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// -----------------------------------------------------------------------------
+
+
+// -----------------------------------------------------------------------------
+/// @brief The GtpLatencyViewController class is responsible for displaying the
+/// "GTP latency" view, which shows the latency statistics collected by
+/// GtpLatencyModel.
+///
+/// The view has one section per GTP command name, and one row per
+/// #GtpLatencyPhase within each section.
+// -----------------------------------------------------------------------------
+@interface GtpLatencyViewController : UITableViewController
+{
+}
+
++ (GtpLatencyViewController*) controller;
+
+@end
@@ -0,0 +1,216 @@
+// -----------------------------------------------------------------------------
+// Copyright 2026 Patrick Näf (herzbube@herzbube.ch)
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// -----------------------------------------------------------------------------
+
+
+// Project includes
+#import "GtpLatencyViewController.h"
+#import "GtpLatencyHistogram.h"
+#import "GtpLatencyModel.h"
+#import "../main/ApplicationDelegate.h"
+#import "../ui/TableViewCellFactory.h"
+
+
+// -----------------------------------------------------------------------------
+/// @brief Class extension with private properties for GtpLatencyViewController.
+// -----------------------------------------------------------------------------
+@interface GtpLatencyViewController()
+@property(nonatomic, retain) GtpLatencyModel* model;
+/// @brief Snapshot of the command names in the model, taken when the view was
+/// last reloaded. Determines the sections of the table view.
+@property(nonatomic, retain) NSArray* commandNames;
+@end
+
+
+@implementation GtpLatencyViewController
+
+#pragma mark - Initialization and deallocation
+
+// -----------------------------------------------------------------------------
+/// @brief Convenience constructor. Creates a GtpLatencyViewController instance
+/// of grouped style.
+// -----------------------------------------------------------------------------
++ (GtpLatencyViewController*) controller
+{
+  GtpLatencyViewController* controller = [[GtpLatencyViewController alloc] initWithStyle:UITableViewStyleGrouped];
+  if (controller)
+  {
+    [controller autorelease];
+    controller.model = [ApplicationDelegate sharedDelegate].gtpLatencyModel;
+    controller.commandNames = [NSArray array];
+  }
+  return controller;
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Deallocates memory allocated by this GtpLatencyViewController object.
+// -----------------------------------------------------------------------------
+- (void) dealloc
+{
+  self.model = nil;
+  self.commandNames = nil;
+  [super dealloc];
+}
+
+#pragma mark - UIViewController overrides
+
+// -----------------------------------------------------------------------------
+/// @brief UIViewController method.
+// -----------------------------------------------------------------------------
+- (void) viewDidLoad
+{
+  [super viewDidLoad];
+  [self setupNavigationItem];
+}
+
+// -----------------------------------------------------------------------------
+/// @brief UIViewController method.
+// -----------------------------------------------------------------------------
+- (void) viewWillAppear:(BOOL)animated
+{
+  [super viewWillAppear:animated];
+  [self reloadStatistics];
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Sets up the navigation item of this view controller.
+// -----------------------------------------------------------------------------
+- (void) setupNavigationItem
+{
+  UIBarButtonItem* refreshButton = [[[UIBarButtonItem alloc] initWithBarButtonSystemItem:UIBarButtonSystemItemRefresh
+                                                                                  target:self
+                                                                                  action:@selector(refresh:)] autorelease];
+  UIBarButtonItem* trashButton = [[[UIBarButtonItem alloc] initWithBarButtonSystemItem:UIBarButtonSystemItemTrash
+                                                                                target:self
+                                                                                action:@selector(clearStatistics:)] autorelease];
+  refreshButton.style = UIBarButtonItemStylePlain;
+  trashButton.style = UIBarButtonItemStylePlain;
+  self.navigationItem.rightBarButtonItems = @[refreshButton, trashButton];
+  self.navigationItem.title = @"GTP latency";
+}
+
+#pragma mark - UITableViewDataSource overrides
+
+// -----------------------------------------------------------------------------
+/// @brief UITableViewDataSource protocol method.
+// -----------------------------------------------------------------------------
+- (NSInteger) numberOfSectionsInTableView:(UITableView*)tableView
+{
+  return self.commandNames.count;
+}
+
+// -----------------------------------------------------------------------------
+/// @brief UITableViewDataSource protocol method.
+// -----------------------------------------------------------------------------
+- (NSInteger) tableView:(UITableView*)tableView numberOfRowsInSection:(NSInteger)section
+{
+  return GtpLatencyPhaseMax;
+}
+
+// -----------------------------------------------------------------------------
+/// @brief UITableViewDataSource protocol method.
+// -----------------------------------------------------------------------------
+- (NSString*) tableView:(UITableView*)tableView titleForHeaderInSection:(NSInteger)section
+{
+  NSString* commandName = [self.commandNames objectAtIndex:section];
+  GtpLatencyHistogram* histogram = [self.model histogramForCommandName:commandName phase:GtpLatencyPhaseTotal];
+  return [NSString stringWithFormat:@"%@ (%lu)", commandName, histogram.count];
+}
+
+// -----------------------------------------------------------------------------
+/// @brief UITableViewDataSource protocol method.
+// -----------------------------------------------------------------------------
+- (UITableViewCell*) tableView:(UITableView*)tableView cellForRowAtIndexPath:(NSIndexPath*)indexPath
+{
+  UITableViewCell* cell = [TableViewCellFactory cellWithType:Value1CellType tableView:tableView];
+  cell.selectionStyle = UITableViewCellSelectionStyleNone;
+
+  enum GtpLatencyPhase phase = (enum GtpLatencyPhase)indexPath.row;
+  NSString* commandName = [self.commandNames objectAtIndex:indexPath.section];
+  GtpLatencyHistogram* histogram = [self.model histogramForCommandName:commandName phase:phase];
+  cell.textLabel.text = [GtpLatencyModel nameOfPhase:phase];
+  if (histogram)
+  {
+    cell.detailTextLabel.text = [NSString stringWithFormat:@"p50 %@, p99 %@, max %@",
+                                 [self stringForLatency:[histogram latencyAtPercentile:50.0]],
+                                 [self stringForLatency:[histogram latencyAtPercentile:99.0]],
+                                 [self stringForLatency:histogram.maximumLatency]];
+  }
+  else
+  {
+    // The statistics were cleared after the table view was reloaded
+    cell.detailTextLabel.text = @"-";
+  }
+  return cell;
+}
+
+// -----------------------------------------------------------------------------
+/// @brief UITableViewDataSource protocol method.
+// -----------------------------------------------------------------------------
+- (NSString*) tableView:(UITableView*)tableView titleForFooterInSection:(NSInteger)section
+{
+  if ((NSUInteger)section + 1 == self.commandNames.count)
+    return @"Latencies are broken down into the time a command waits in the GTP client's queue, the time until it is passed to the GTP engine, the time the engine takes until it starts to respond, and the time until the response is complete.";
+  else
+    return nil;
+}
+
+#pragma mark - Action handlers
+
+// -----------------------------------------------------------------------------
+/// @brief Reacts to a tap gesture on the "Refresh" button.
+// -----------------------------------------------------------------------------
+- (void) refresh:(id)sender
+{
+  [self reloadStatistics];
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Reacts to a tap gesture on the "Trash" button. Discards all latency
+/// statistics.
+// -----------------------------------------------------------------------------
+- (void) clearStatistics:(id)sender
+{
+  [self.model clearStatistics];
+  [self reloadStatistics];
+}
+
+#pragma mark - Private helpers
+
+// -----------------------------------------------------------------------------
+/// @brief Takes a new snapshot of the command names in the model and reloads
+/// the table view.
+// -----------------------------------------------------------------------------
+- (void) reloadStatistics
+{
+  self.commandNames = [self.model commandNames];
+  [self.tableView reloadData];
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Returns a human-readable string for @a latency, which is measured
+/// in seconds.
+// -----------------------------------------------------------------------------
+- (NSString*) stringForLatency:(double)latency
+{
+  if (latency < 0.001)
+    return [NSString stringWithFormat:@"%.0fµs", latency * 1000000.0];
+  else if (latency < 1.0)
+    return [NSString stringWithFormat:@"%.1fms", latency * 1000.0];
+  else
+    return [NSString stringWithFormat:@"%.2fs", latency];
+}
+
+@end
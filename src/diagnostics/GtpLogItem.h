@@ -26,6 +26,10 @@
 - (id) init;
 - (UIImage*) imageRepresentingResponseStatus;
 
+/// @brief The sequence number under which GtpLogModel stores the item. Items
+/// with the same sequence number represent the same command. This property is
+/// not archived.
+@property(nonatomic, assign) unsigned long long sequenceNumber;
 /// @brief The command that was submitted.
 @property(nonatomic, retain) NSString* commandString;
 /// @brief String representation of the timestamp when the command was
@@ -35,6 +35,7 @@
   if (! self)
     return nil;
 
+  self.sequenceNumber = 0;
   self.commandString = nil;
   self.timeStamp = nil;
   self.hasResponse = false;
@@ -43,6 +43,18 @@
 /// activities that occur around GTP client and engine. There is a guarantee,
 /// though, that items will pop up in the log in the same order that commands
 /// were submitted to the GTP engine.
+///
+/// GtpLogModel does not keep GtpLogItem objects around. The log is stored in
+/// a GtpLogRingBuffer, i.e. in a ring of compact records with an arena for
+/// the command and response strings, and with compression for long
+/// responses. itemAtIndex:() creates a new GtpLogItem object on every
+/// invocation. As a consequence the memory used by the log is bounded, and
+/// discarding the oldest item when a new item is added costs O(1).
+///
+/// If the property @e gtpLogSpillFileEnabled is true, the log in addition
+/// writes all items to a spill file in the temporary folder. Items whose
+/// strings no longer fit into memory are then read back from the spill file,
+/// which allows the log size to be much larger.
 // -----------------------------------------------------------------------------
 @interface GtpLogModel : NSObject
 {
@@ -52,22 +64,28 @@
 - (void) readUserDefaults;
 - (void) writeUserDefaults;
 - (GtpLogItem*) itemAtIndex:(int)index;
+- (int) indexOfItem:(GtpLogItem*)logItem;
 - (void) clearLog;
 
-/// @brief Number of objects in @e itemList.
-///
-/// This property exists purely as a convenience to clients, since the object
-/// count is also available from the itemList array.
+/// @brief Number of items in the log. Items are ordered in the order that
+/// their corresponding commands were submitted.
 @property(nonatomic, assign, readonly) int itemCount;
-/// @brief Array stores objects of type GtpLogItem. Items appear in the array
-/// in the order that their corresponding commands were submitted.
-@property(nonatomic, retain, readonly) NSArray* itemList;
-/// @brief The size of the GTP log, i.e. the maximum number of objects that can
-/// be in @e itemList.
+/// @brief The size of the GTP log, i.e. the maximum number of items that can
+/// be in the log.
 ///
-/// If a new item is about to be added to @e itemList that would exceed the
-/// limit, the oldest item is discarded first.
+/// If a new item is about to be added to the log that would exceed the limit,
+/// the oldest item is discarded first. Without spill file the log may also
+/// discard the oldest items if their strings no longer fit into memory. With
+/// spill file the log may discard the oldest items to keep the spill file
+/// below #gtpLogSpillFileSizeMaximum.
 @property(nonatomic, assign) int gtpLogSize;
+/// @brief True if the GTP log writes its items to a spill file so that items
+/// whose strings no longer fit into memory are not discarded.
+///
+/// Setting this property to false deletes the spill file, which discards the
+/// items that are only in the spill file. If @e gtpLogSize is greater than
+/// #gtpLogSizeMaximum, @e gtpLogSize is reduced to #gtpLogSizeMaximum.
+@property(nonatomic, assign) bool gtpLogSpillFileEnabled;
 /// @brief True if the "GTP Log" view currently displays the frontside view,
 /// false if it displays the backside view.
 @property(nonatomic, assign) bool gtpLogViewFrontSideIsVisible;
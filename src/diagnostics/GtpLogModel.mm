@@ -18,36 +18,40 @@
 // Project includes
 #import "GtpLogModel.h"
 #import "GtpLogItem.h"
+#import "GtpLogRingBuffer.h"
 #import "../gtp/GtpCommand.h"
 #import "../gtp/GtpResponse.h"
 
+// C++ standard library
+#include <deque>
+#include <string>
+
 
 // -----------------------------------------------------------------------------
 /// @brief Class extension with private properties for GtpLogModel.
 // -----------------------------------------------------------------------------
 @interface GtpLogModel()
-/// @name Re-declaration of properties to make them readwrite privately
-//@{
-@property(nonatomic, retain, readwrite) NSArray* itemList;
-//@}
+{
+  // The ring buffer is a C++ object, it can be a member of the GtpLogModel
+  // class only because it is declared in the class extension. GtpLogModel.h is
+  // also #import'ed by pure Objective-C implementations.
+  GtpLogRingBuffer* _ringBuffer;
+  // Sequence numbers of log entries for which a GTP response is still
+  // outstanding.
+  //
+  // The deque acts as a fifo queue. The assumption behind this is that the GTP
+  // engine also works as a queue: It processes GTP commands in the order that
+  // they are submitted, and does not start processing a new command before it
+  // has sent the response to the preceding command.
+  //
+  // Based on this assumption, sequence numbers can simply be added to the
+  // queue as the GTP command submissions are pouring in. Whenever a GTP
+  // response is received, the sequence number at the front of the queue must
+  // be the one of the entry with the command that the response belongs to.
+  std::deque<unsigned long long> _sequenceNumbersWithNoResponse;
+}
 /// @name Private properties
 //@{
-/// @brief Stores GtpLogItem objects for which a GTP response is still
-/// outstanding.
-///
-/// The array acts as a fifo queue. enqueueItemWithNoResponse() and
-/// dequeueItemWithNoResponse() are used to modify the queue.
-///
-/// The assumption behind this is that the GTP engine also works as a queue: It
-/// processes GTP commands in the order that they are submitted, and does not
-/// start processing a new command before it has sent the response to the
-/// preceding command.
-///
-/// Based on this assumption, GtpLogItem objects can simply be added to the
-/// queue as the GTP command submissions are pouring in. Whenever a GTP response
-/// is received, the GtpLogItem object at the front of the queue must be the
-/// one with the command that the response belongs to.
-@property(nonatomic, retain) NSMutableArray* itemQueueNoResponses;
 @property(nonatomic, retain) NSDateFormatter* dateFormatter;
 //@}
 @end
@@ -76,10 +80,10 @@
                                                name:gtpResponseWasReceivedNotification
                                              object:nil];
 
-  self.itemList = [NSMutableArray arrayWithCapacity:0];
+  _ringBuffer = new GtpLogRingBuffer(100, gtpLogStringArenaSize, gtpLogResponseCompressionThreshold);
   self.gtpLogSize = 100;
+  self.gtpLogSpillFileEnabled = false;
   self.gtpLogViewFrontSideIsVisible = true;
-  self.itemQueueNoResponses = [NSMutableArray arrayWithCapacity:0];
 
   self.dateFormatter = [[[NSDateFormatter alloc] init] autorelease];
   [self.dateFormatter setLocale:[NSLocale currentLocale]];
@@ -97,8 +101,9 @@
 - (void) dealloc
 {
   [[NSNotificationCenter defaultCenter] removeObserver:self];
-  self.itemList = nil;
-  self.itemQueueNoResponses = nil;
+  // Also deletes the spill file
+  delete _ringBuffer;
+  _ringBuffer = 0;
   self.dateFormatter = nil;
   [super dealloc];
 }
@@ -110,7 +115,12 @@
 {
   NSUserDefaults* userDefaults = [NSUserDefaults standardUserDefaults];
   NSDictionary* dictionary = [userDefaults dictionaryForKey:gtpLogViewKey];
-  self.gtpLogSize = [[dictionary valueForKey:gtpLogSizeKey] intValue];
+  // Must be set before the log size because the maximum log size depends on it
+  self.gtpLogSpillFileEnabled = [[dictionary valueForKey:gtpLogSpillFileEnabledKey] boolValue];
+  int logSize = [[dictionary valueForKey:gtpLogSizeKey] intValue];
+  if (! self.gtpLogSpillFileEnabled && logSize > gtpLogSizeMaximum)
+    logSize = gtpLogSizeMaximum;
+  self.gtpLogSize = logSize;
   self.gtpLogViewFrontSideIsVisible = [[dictionary valueForKey:gtpLogViewFrontSideIsVisibleKey] boolValue];
 }
 
@@ -123,6 +133,7 @@
   NSMutableDictionary* dictionary = [NSMutableDictionary dictionary];
   [dictionary setValue:[NSNumber numberWithInt:self.gtpLogSize] forKey:gtpLogSizeKey];
   [dictionary setValue:[NSNumber numberWithBool:self.gtpLogViewFrontSideIsVisible] forKey:gtpLogViewFrontSideIsVisibleKey];
+  [dictionary setValue:[NSNumber numberWithBool:self.gtpLogSpillFileEnabled] forKey:gtpLogSpillFileEnabledKey];
   NSUserDefaults* userDefaults = [NSUserDefaults standardUserDefaults];
   [userDefaults setObject:dictionary forKey:gtpLogViewKey];
 }
@@ -157,7 +168,6 @@
   [command autorelease];
 
   [self addItemToLog:command];
-  [self trimLog];
   [[NSNotificationCenter defaultCenter] postNotificationName:gtpLogContentChanged
                                                       object:nil];
 }
@@ -187,25 +197,30 @@
   // gtpResponseWasReceived:()
   [response autorelease];
 
-  GtpLogItem* logItem = [self dequeueItemWithNoResponse];
-  assert(logItem != nil);
-  if (! logItem)
-    DDLogError(@"%@: GtpLogItem object is nil", self);
+  assert(! _sequenceNumbersWithNoResponse.empty());
+  if (_sequenceNumbersWithNoResponse.empty())
+  {
+    DDLogError(@"%@: No log item is waiting for a response", self);
+    return;
+  }
+  unsigned long long sequenceNumber = _sequenceNumbersWithNoResponse.front();
+  _sequenceNumbersWithNoResponse.pop_front();
 
-  // Check if the item was kicked out of the log while the response was still
+  // The item may have been kicked out of the log while the response was still
   // outstanding. Stuff like clearing the log, or a massive amount of trimming,
   // might have happened.
-  if (! [_itemList containsObject:logItem])
+  const char* rawResponse = [response.rawResponse UTF8String];
+  size_t rawResponseLength = rawResponse ? strlen(rawResponse) : 0;
+  if (! _ringBuffer->addResponse(sequenceNumber, response.status, rawResponse, rawResponseLength))
   {
     DDLogInfo(@"Discarding GTP response");
     return;
   }
 
-  logItem.hasResponse = true;
-  logItem.responseStatus = response.status;
-  logItem.parsedResponseString = [response parsedResponse];
-  logItem.rawResponseString = response.rawResponse;
-
+  size_t index;
+  if (! _ringBuffer->indexOfSequenceNumber(sequenceNumber, index))
+    return;
+  GtpLogItem* logItem = [self itemAtIndex:(int)index];
   [[NSNotificationCenter defaultCenter] postNotificationName:gtpLogItemChanged
                                                       object:logItem];
 }
@@ -215,10 +230,8 @@
 // -----------------------------------------------------------------------------
 - (int) itemCount
 {
-  // Cast is required because NSUInteger and int differ in size in 64-bit. Cast
-  // is safe because this app was not made to handle more than pow(2, 31) log
-  // items.
-  return (int)_itemList.count;
+  // Cast is safe because the log size is an int
+  return (int)_ringBuffer->size();
 }
 
 // -----------------------------------------------------------------------------
@@ -235,92 +248,120 @@
 
   int oldSize = _gtpLogSize;
   _gtpLogSize = newSize;
+  _ringBuffer->setCapacity(newSize);
 
   if (newSize < oldSize)
   {
-    [self trimLog];
     [[NSNotificationCenter defaultCenter] postNotificationName:gtpLogContentChanged
                                                         object:nil];
   }
 }
 
 // -----------------------------------------------------------------------------
-/// @brief Returns the log item object located at position @a index in the
-/// itemList array.
-// -----------------------------------------------------------------------------
-- (GtpLogItem*) itemAtIndex:(int)index
-{
-  return [_itemList objectAtIndex:index];
-}
-
-// -----------------------------------------------------------------------------
-/// @brief Adds an item that represents @a command to the log.
+// Property is documented in the header file.
 // -----------------------------------------------------------------------------
-- (void) addItemToLog:(GtpCommand*)command
+- (void) setGtpLogSpillFileEnabled:(bool)newValue
 {
-  GtpLogItem* logItem = [[GtpLogItem alloc] init];
-  [(NSMutableArray*)_itemList addObject:logItem];  // _itemList has ownership
-  [logItem release];
-
-  [self enqueueItemWithNoResponse:logItem];
+  if (_gtpLogSpillFileEnabled == newValue)
+    return;
 
-  logItem.commandString = command.command;
-  logItem.timeStamp = [self.dateFormatter stringFromDate:[NSDate date]];
+  if (newValue)
+  {
+    NSString* spillFilePath = [NSTemporaryDirectory() stringByAppendingPathComponent:gtpLogSpillFileName];
+    if (! _ringBuffer->openSpillFile([spillFilePath fileSystemRepresentation], gtpLogSpillFileSizeMaximum))
+    {
+      DDLogError(@"%@: Failed to create GTP log spill file %@", self, spillFilePath);
+      return;
+    }
+    _gtpLogSpillFileEnabled = true;
+  }
+  else
+  {
+    _ringBuffer->closeSpillFile();
+    _gtpLogSpillFileEnabled = false;
+    if (self.gtpLogSize > gtpLogSizeMaximum)
+      self.gtpLogSize = gtpLogSizeMaximum;
+    // Items that were only in the spill file are gone
+    [[NSNotificationCenter defaultCenter] postNotificationName:gtpLogContentChanged
+                                                        object:nil];
+  }
 }
 
 // -----------------------------------------------------------------------------
-/// @brief Removes as many of the oldest items from the log as are needed to
-/// bring the log size down to its maximum allowed size (property
-/// @e gtpLogSize).
+/// @brief Returns a newly created log item object that represents the item
+/// located at position @a index in the log. Position 0 refers to the oldest
+/// item.
 ///
-/// Does nothing if the log size currently does not exceed the limit.
+/// Raises an @e NSRangeException if @a index is out of range.
 // -----------------------------------------------------------------------------
-- (void) trimLog
+- (GtpLogItem*) itemAtIndex:(int)index
 {
-  // Cast is required because NSUInteger and int differ in size in 64-bit. Cast
-  // is safe because this app was not made to handle more than pow(2, 31) log
-  // items.
-  int numberOfItemsToDiscard = (int)_itemList.count - self.gtpLogSize;
-  if (numberOfItemsToDiscard <= 0)
-    return;
+  if (index < 0 || index >= self.itemCount)
+  {
+    NSString* errorMessage = [NSString stringWithFormat:@"Log item index %d is out of range, log has %d items", index, self.itemCount];
+    DDLogError(@"%@: %@", self, errorMessage);
+    NSException* exception = [NSException exceptionWithName:NSRangeException
+                                                     reason:errorMessage
+                                                   userInfo:nil];
+    @throw exception;
+  }
 
-  NSRange rangeToRemove;
-  rangeToRemove.location = 0;  // oldest items are at the front of the array
-  rangeToRemove.length = numberOfItemsToDiscard;
-  [(NSMutableArray*)_itemList removeObjectsInRange:rangeToRemove];
-}
+  GtpLogItem* logItem = [[[GtpLogItem alloc] init] autorelease];
+  GtpLogRingBuffer::Entry entry;
+  if (! _ringBuffer->entryAtIndex(index, entry))
+  {
+    DDLogError(@"%@: Failed to read log item at index %d", self, index);
+    logItem.commandString = @"";
+    logItem.timeStamp = @"";
+    return logItem;
+  }
 
-// -----------------------------------------------------------------------------
-/// @brief Adds @a item to the end of the queue with log items for which the
-/// response is still outstanding.
-// -----------------------------------------------------------------------------
-- (void) enqueueItemWithNoResponse:(GtpLogItem*)logItem
-{
-  [_itemQueueNoResponses addObject:logItem];
+  logItem.sequenceNumber = entry.sequenceNumber;
+  logItem.commandString = [GtpLogModel stringWithStdString:entry.command];
+  // Make it obvious that the user does not see the entire string
+  if (entry.commandTruncated)
+    logItem.commandString = [logItem.commandString stringByAppendingString:gtpLogTruncationMarker];
+  logItem.timeStamp = [self.dateFormatter stringFromDate:[NSDate dateWithTimeIntervalSinceReferenceDate:entry.timeStamp]];
+  logItem.hasResponse = entry.hasResponse;
+  if (entry.hasResponse)
+  {
+    NSString* rawResponseString = [GtpLogModel stringWithStdString:entry.rawResponse];
+    if (entry.responseTruncated)
+      rawResponseString = [rawResponseString stringByAppendingString:gtpLogTruncationMarker];
+    logItem.responseStatus = entry.responseStatus;
+    logItem.rawResponseString = rawResponseString;
+    // Remove status, the same as GtpResponse does
+    if (rawResponseString.length >= 2)
+      logItem.parsedResponseString = [rawResponseString substringFromIndex:2];
+    else
+      logItem.parsedResponseString = @"";
+  }
+  return logItem;
 }
 
 // -----------------------------------------------------------------------------
-/// @brief Removes an item from the front of the queue with log items for which
-/// the response is still outstanding, then returns that item.
-///
-/// Returns nil if the queue is currently empty.
+/// @brief Returns the position in the log of the item that is represented by
+/// @a logItem. Returns -1 if the item is no longer in the log.
 // -----------------------------------------------------------------------------
-- (GtpLogItem*) dequeueItemWithNoResponse
+- (int) indexOfItem:(GtpLogItem*)logItem
 {
-  if (_itemQueueNoResponses.count == 0)
-    return nil;
-  GtpLogItem* logItem = [_itemQueueNoResponses objectAtIndex:0];
-  [_itemQueueNoResponses removeObjectAtIndex:0];
-  return logItem;
+  size_t index;
+  if (! _ringBuffer->indexOfSequenceNumber(logItem.sequenceNumber, index))
+    return -1;
+  return (int)index;
 }
 
 // -----------------------------------------------------------------------------
-/// @brief Removes all items from the queue with items for which the GTP
-/// response is still outstanding.
+/// @brief Adds an item that represents @a command to the log.
 // -----------------------------------------------------------------------------
-- (void) clearItemQueueWithNoResponse
+- (void) addItemToLog:(GtpCommand*)command
 {
-  [_itemQueueNoResponses removeAllObjects];
+  const char* commandString = [command.command UTF8String];
+  size_t commandStringLength = commandString ? strlen(commandString) : 0;
+  unsigned long long sequenceNumber = _ringBuffer->addCommand(commandString,
+                                                              commandStringLength,
+                                                              [NSDate timeIntervalSinceReferenceDate]);
+  _sequenceNumbersWithNoResponse.push_back(sequenceNumber);
 }
 
 // -----------------------------------------------------------------------------
@@ -328,13 +369,35 @@
 // -----------------------------------------------------------------------------
 - (void) clearLog
 {
-  [(NSMutableArray*)_itemList removeAllObjects];
-  // Note: _itemQueueNoResponses is not modified by design! If we were removing
-  // items from that queue, outstanding responses might become associated with
-  // the wrong GtpLogItem objects when they come in.
+  _ringBuffer->clear();
+  // Note: _sequenceNumbersWithNoResponse is not modified by design! If we were
+  // removing sequence numbers from that queue, outstanding responses might
+  // become associated with the wrong log items when they come in.
 
   [[NSNotificationCenter defaultCenter] postNotificationName:gtpLogContentChanged
                                                       object:nil];
 }
 
+// -----------------------------------------------------------------------------
+/// @brief Private helper for itemAtIndex:(). Returns an NSString with the
+/// UTF-8 bytes in @a stdString.
+///
+/// Strings that the log had to truncate may end in the middle of a UTF-8
+/// sequence. Such strings are interpreted as Latin-1 so that they are not
+/// lost.
+// -----------------------------------------------------------------------------
++ (NSString*) stringWithStdString:(const std::string&)stdString
+{
+  NSString* string = [[[NSString alloc] initWithBytes:stdString.data()
+                                               length:stdString.length()
+                                             encoding:NSUTF8StringEncoding] autorelease];
+  if (! string)
+  {
+    string = [[[NSString alloc] initWithBytes:stdString.data()
+                                       length:stdString.length()
+                                     encoding:NSISOLatin1StringEncoding] autorelease];
+  }
+  return string;
+}
+
 @end
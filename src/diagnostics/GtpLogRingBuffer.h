@@ -0,0 +1,180 @@
+// -----------------------------------------------------------------------------
+// Copyright 2026 Patrick Näf (herzbube@herzbube.ch)
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// -----------------------------------------------------------------------------
+
+
+#pragma once
+
+// System includes
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// -----------------------------------------------------------------------------
+/// @brief The GtpLogRingBuffer class stores the entries of the GTP log in a
+/// bounded amount of memory. GtpLogRingBuffer is the storage backend of
+/// GtpLogModel.
+///
+/// An entry consists of a GTP command, the time when the command was
+/// submitted, and the raw GTP response to the command. Entries are identified
+/// by a sequence number that increases with every entry that is added.
+/// Entries are kept in a ring of compact fixed-size records, so adding an
+/// entry or discarding the oldest entry costs O(1), regardless of the number
+/// of entries in the log.
+///
+/// Records do not contain the command and response strings themselves. The
+/// strings are stored in a string arena, a fixed-size byte buffer that is
+/// filled from front to back and then wraps around. A string always occupies
+/// a contiguous region of the arena. When the arena wraps around, the strings
+/// of the oldest entries are overwritten.
+///
+/// Responses that are longer than a threshold are compressed with LZ4 before
+/// they are stored in the arena. Commands and responses that are so long that
+/// they would occupy more than a quarter of the arena (after compression) are
+/// truncated. Truncated entries are marked as such.
+///
+/// Optionally GtpLogRingBuffer writes every entry, as soon as it is complete,
+/// to an append-only spill file. An entry whose strings are overwritten in the
+/// arena is then not discarded, instead its strings are read back from the
+/// spill file when the entry is requested. An entry that is still waiting for
+/// its response when its command is overwritten in the arena is also written
+/// to the spill file, and is written again when the response arrives. This
+/// allows the log to hold many more entries than fit into the arena, while the
+/// resident memory remains bounded by the arena size plus the size of the
+/// records. The spill file is truncated when the log is cleared.
+///
+/// The size of the spill file is limited to a maximum that is specified when
+/// the spill file is opened. When the next entry would make the spill file
+/// grow beyond the maximum, the oldest entries are discarded until the
+/// remaining entries occupy at most half of the maximum, then the spill file
+/// is compacted, i.e. the remaining entries are moved to the front of the
+/// file and the file is truncated.
+///
+/// Without spill file the number of entries in the log may be smaller than
+/// the capacity, because entries whose strings are overwritten in the arena
+/// are discarded.
+///
+/// GtpLogRingBuffer is not thread-safe.
+// -----------------------------------------------------------------------------
+class GtpLogRingBuffer
+{
+public:
+  // ---------------------------------------------------------------------------
+  /// @brief The Entry struct is the expanded form of an entry in the log.
+  // ---------------------------------------------------------------------------
+  struct Entry
+  {
+    uint64_t sequenceNumber;
+    /// @brief Time when the command was submitted, in seconds since an
+    /// arbitrary reference date chosen by the client.
+    double timeStamp;
+    std::string command;
+    bool hasResponse;
+    bool responseStatus;
+    std::string rawResponse;
+    /// @brief True if the command was truncated because it was too long to
+    /// be stored.
+    bool commandTruncated;
+    /// @brief True if the response was truncated because it was too long to
+    /// be stored.
+    bool responseTruncated;
+  };
+
+  GtpLogRingBuffer(size_t capacity, size_t arenaSize, size_t compressionThreshold);
+  ~GtpLogRingBuffer();
+
+  uint64_t addCommand(const char* command, size_t commandLength, double timeStamp);
+  bool addResponse(uint64_t sequenceNumber, bool responseStatus, const char* rawResponse, size_t rawResponseLength);
+  bool entryAtIndex(size_t index, Entry& entry) const;
+  bool indexOfSequenceNumber(uint64_t sequenceNumber, size_t& index) const;
+  void clear();
+
+  size_t size() const;
+  size_t capacity() const;
+  void setCapacity(size_t capacity);
+  size_t numberOfResidentEntries() const;
+
+  bool openSpillFile(const std::string& path, int64_t maximumSpillFileSize);
+  void closeSpillFile();
+  bool hasSpillFile() const;
+
+private:
+  GtpLogRingBuffer(const GtpLogRingBuffer&) = delete;
+  GtpLogRingBuffer& operator=(const GtpLogRingBuffer&) = delete;
+
+  // ---------------------------------------------------------------------------
+  /// @brief The Record struct is the compact form of an entry in the log.
+  /// Positions are arena positions (see allocateArenaSpace()).
+  // ---------------------------------------------------------------------------
+  struct Record
+  {
+    uint64_t sequenceNumber;
+    double timeStamp;
+    uint64_t commandPosition;
+    uint64_t responsePosition;
+    int64_t spillFileOffset;
+    uint32_t commandLength;
+    uint32_t responseStoredLength;
+    uint32_t responseLength;
+    uint8_t flags;
+  };
+
+  enum RecordFlag
+  {
+    RecordFlagHasResponse = 0x01,
+    RecordFlagResponseStatus = 0x02,
+    RecordFlagResponseCompressed = 0x04,
+    RecordFlagSpilled = 0x08,
+    RecordFlagCommandTruncated = 0x10,
+    RecordFlagResponseTruncated = 0x20
+  };
+
+  size_t maximumStoredLength() const;
+  Record& recordAtIndex(size_t index);
+  const Record& recordAtIndex(size_t index) const;
+  void removeOldestRecords(size_t numberOfRecords);
+  uint64_t allocateArenaSpace(size_t length);
+  void reclaimArenaSpace(uint64_t arenaPosition);
+  char* arenaPointer(uint64_t arenaPosition);
+  const char* arenaPointer(uint64_t arenaPosition) const;
+  size_t compressResponse(const char* rawResponse, size_t rawResponseLength);
+  bool decompressResponse(const char* storedResponse, const Record& record, std::string& rawResponse) const;
+  void spillRecord(Record& record);
+  void spillRecord(Record& record, const char* command, const char* storedResponse);
+  void compactSpillFile(uint64_t sequenceNumberToKeep, int64_t reservedSize);
+  bool readSpilledRecord(const Record& record, std::string& command, std::string& storedResponse) const;
+
+  std::vector<Record> records;
+  size_t firstRecordIndex;
+  size_t numberOfRecords;
+  // Records [0, numberOfNonResidentRecords) no longer have their strings in
+  // the arena. They are always spilled records.
+  size_t numberOfNonResidentRecords;
+  uint64_t nextSequenceNumber;
+
+  std::vector<char> arena;
+  // Arena positions increase monotonically. The position modulo the arena
+  // size is the offset into the arena.
+  uint64_t arenaWritePosition;
+
+  size_t compressionThreshold;
+  std::vector<char> compressionBuffer;
+  mutable std::vector<char> compressionScratchBuffer;
+
+  std::string spillFilePath;
+  int spillFileDescriptor;
+  int64_t spillFileSize;
+  int64_t maximumSpillFileSize;
+};
@@ -0,0 +1,732 @@
+// -----------------------------------------------------------------------------
+// Copyright 2026 Patrick Näf (herzbube@herzbube.ch)
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// -----------------------------------------------------------------------------
+
+
+// Project includes
+#include "GtpLogRingBuffer.h"
+
+// System includes
+#include <algorithm>
+#include <cassert>
+#include <cerrno>
+#include <cstring>
+// This file is compiled as Objective-C++ only so that the Compression module
+// is linked automatically
+#include <compression.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+// -----------------------------------------------------------------------------
+/// @brief The SpillFileRecordHeader struct precedes the command and response
+/// bytes of every entry in the spill file. The header makes the spill file
+/// self-describing, GtpLogRingBuffer itself does not read it.
+// -----------------------------------------------------------------------------
+struct SpillFileRecordHeader
+{
+  uint64_t sequenceNumber;
+  double timeStamp;
+  uint32_t commandLength;
+  uint32_t responseStoredLength;
+  uint32_t responseLength;
+  uint32_t flags;
+};
+
+// -----------------------------------------------------------------------------
+/// @brief Writes @a length bytes from @a data to @a fileDescriptor, starting
+/// at @a offset. Returns true on success, false on failure.
+// -----------------------------------------------------------------------------
+static bool writeFully(int fileDescriptor, const char* data, size_t length, int64_t offset)
+{
+  while (length > 0)
+  {
+    ssize_t numberOfBytesWritten = pwrite(fileDescriptor, data, length, offset);
+    if (numberOfBytesWritten < 0)
+    {
+      if (EINTR == errno)
+        continue;
+      return false;
+    }
+    data += numberOfBytesWritten;
+    length -= numberOfBytesWritten;
+    offset += numberOfBytesWritten;
+  }
+  return true;
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Reads @a length bytes from @a fileDescriptor into @a data, starting
+/// at @a offset. Returns true on success, false on failure.
+// -----------------------------------------------------------------------------
+static bool readFully(int fileDescriptor, char* data, size_t length, int64_t offset)
+{
+  while (length > 0)
+  {
+    ssize_t numberOfBytesRead = pread(fileDescriptor, data, length, offset);
+    if (numberOfBytesRead < 0)
+    {
+      if (EINTR == errno)
+        continue;
+      return false;
+    }
+    if (0 == numberOfBytesRead)
+      return false;
+    data += numberOfBytesRead;
+    length -= numberOfBytesRead;
+    offset += numberOfBytesRead;
+  }
+  return true;
+}
+
+
+// -----------------------------------------------------------------------------
+/// @brief Initializes a GtpLogRingBuffer object that holds at most
+/// @a capacity entries and stores strings in an arena of @a arenaSize bytes.
+/// Responses that are at least @a compressionThreshold bytes long are
+/// compressed.
+// -----------------------------------------------------------------------------
+GtpLogRingBuffer::GtpLogRingBuffer(size_t capacity, size_t arenaSize, size_t compressionThreshold) :
+  records(std::max(capacity, static_cast<size_t>(1))),
+  firstRecordIndex(0),
+  numberOfRecords(0),
+  numberOfNonResidentRecords(0),
+  nextSequenceNumber(1),
+  arena(std::max(arenaSize, static_cast<size_t>(4))),
+  arenaWritePosition(0),
+  compressionThreshold(compressionThreshold),
+  compressionBuffer(maximumStoredLength()),
+  compressionScratchBuffer(std::max(compression_encode_scratch_buffer_size(COMPRESSION_LZ4),
+                                    compression_decode_scratch_buffer_size(COMPRESSION_LZ4))),
+  spillFileDescriptor(-1),
+  spillFileSize(0),
+  maximumSpillFileSize(0)
+{
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Destroys the GtpLogRingBuffer object. Closes and deletes the spill
+/// file, if there is one.
+// -----------------------------------------------------------------------------
+GtpLogRingBuffer::~GtpLogRingBuffer()
+{
+  closeSpillFile();
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Adds a new entry with @a command, which was submitted at
+/// @a timeStamp, to the log. Returns the sequence number of the new entry.
+///
+/// If the log is full, the oldest entry is discarded. If @a command is too long
+/// to be stored it is truncated.
+// -----------------------------------------------------------------------------
+uint64_t GtpLogRingBuffer::addCommand(const char* command, size_t commandLength, double timeStamp)
+{
+  size_t storedLength = std::min(commandLength, maximumStoredLength());
+  uint64_t commandPosition = allocateArenaSpace(storedLength);
+  memcpy(arenaPointer(commandPosition), command, storedLength);
+
+  if (this->numberOfRecords == this->records.size())
+    removeOldestRecords(1);
+
+  Record& record = recordAtIndex(this->numberOfRecords);
+  this->numberOfRecords++;
+  record.sequenceNumber = this->nextSequenceNumber++;
+  record.timeStamp = timeStamp;
+  record.commandPosition = commandPosition;
+  record.responsePosition = 0;
+  record.spillFileOffset = -1;
+  record.commandLength = static_cast<uint32_t>(storedLength);
+  record.responseStoredLength = 0;
+  record.responseLength = 0;
+  record.flags = (storedLength < commandLength) ? RecordFlagCommandTruncated : 0;
+  return record.sequenceNumber;
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Adds the response to the entry with sequence number
+/// @a sequenceNumber. Returns true if the response was added. Returns false if
+/// the entry is no longer in the log.
+///
+/// If there is a spill file, the complete entry is written to the spill file.
+/// If the command of the entry is no longer in the arena, the response is not
+/// stored in the arena either, it is written to the spill file together with
+/// the command.
+///
+/// If @a rawResponse is too long to be stored, even after compression, it is
+/// truncated.
+// -----------------------------------------------------------------------------
+bool GtpLogRingBuffer::addResponse(uint64_t sequenceNumber, bool responseStatus, const char* rawResponse, size_t rawResponseLength)
+{
+  size_t index;
+  if (! indexOfSequenceNumber(sequenceNumber, index))
+    return false;
+
+  const char* storedResponse = rawResponse;
+  size_t storedLength = rawResponseLength;
+  bool isCompressed = false;
+  if (rawResponseLength >= this->compressionThreshold)
+  {
+    size_t compressedLength = compressResponse(rawResponse, rawResponseLength);
+    if (compressedLength > 0 && compressedLength < rawResponseLength)
+    {
+      storedResponse = &this->compressionBuffer[0];
+      storedLength = compressedLength;
+      isCompressed = true;
+    }
+  }
+  bool isTruncated = false;
+  if (! isCompressed && storedLength > maximumStoredLength())
+  {
+    storedLength = maximumStoredLength();
+    isTruncated = true;
+  }
+
+  uint64_t responsePosition = 0;
+  if (index >= this->numberOfNonResidentRecords)
+  {
+    responsePosition = allocateArenaSpace(storedLength);
+    // Allocating may have discarded the entry, or may have moved its command
+    // to the spill file
+    if (! indexOfSequenceNumber(sequenceNumber, index))
+      return false;
+  }
+  bool isResident = (index >= this->numberOfNonResidentRecords);
+
+  std::string spilledCommand;
+  if (isResident)
+  {
+    memcpy(arenaPointer(responsePosition), storedResponse, storedLength);
+  }
+  else
+  {
+    std::string spilledResponse;
+    if (! readSpilledRecord(recordAtIndex(index), spilledCommand, spilledResponse))
+      return false;
+  }
+
+  Record& record = recordAtIndex(index);
+  record.responsePosition = responsePosition;
+  record.responseStoredLength = static_cast<uint32_t>(storedLength);
+  record.responseLength = static_cast<uint32_t>(isCompressed ? rawResponseLength : storedLength);
+  record.flags |= RecordFlagHasResponse;
+  if (responseStatus)
+    record.flags |= RecordFlagResponseStatus;
+  if (isCompressed)
+    record.flags |= RecordFlagResponseCompressed;
+  if (isTruncated)
+    record.flags |= RecordFlagResponseTruncated;
+
+  if (! isResident)
+    spillRecord(record, spilledCommand.data(), storedResponse);
+  else if (this->spillFileDescriptor >= 0)
+    spillRecord(record);
+  // Making room in the spill file may have discarded the entry
+  return indexOfSequenceNumber(sequenceNumber, index);
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Fills @a entry with the data of the entry at position @a index.
+/// Index position 0 refers to the oldest entry. Returns true on success.
+/// Returns false if @a index is out of range, or if the entry could not be
+/// read back from the spill file.
+// -----------------------------------------------------------------------------
+bool GtpLogRingBuffer::entryAtIndex(size_t index, Entry& entry) const
+{
+  if (index >= this->numberOfRecords)
+    return false;
+
+  const Record& record = recordAtIndex(index);
+  entry.sequenceNumber = record.sequenceNumber;
+  entry.timeStamp = record.timeStamp;
+  entry.hasResponse = (record.flags & RecordFlagHasResponse) != 0;
+  entry.responseStatus = (record.flags & RecordFlagResponseStatus) != 0;
+  entry.commandTruncated = (record.flags & RecordFlagCommandTruncated) != 0;
+  entry.responseTruncated = (record.flags & RecordFlagResponseTruncated) != 0;
+
+  const char* storedResponse = 0;
+  std::string spilledResponse;
+  if (index < this->numberOfNonResidentRecords)
+  {
+    if (! readSpilledRecord(record, entry.command, spilledResponse))
+      return false;
+    storedResponse = spilledResponse.data();
+  }
+  else
+  {
+    entry.command.assign(arenaPointer(record.commandPosition), record.commandLength);
+    storedResponse = arenaPointer(record.responsePosition);
+  }
+
+  if (! entry.hasResponse)
+    entry.rawResponse.clear();
+  else if (record.flags & RecordFlagResponseCompressed)
+    return decompressResponse(storedResponse, record, entry.rawResponse);
+  else
+    entry.rawResponse.assign(storedResponse, record.responseStoredLength);
+  return true;
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Stores the index position of the entry with sequence number
+/// @a sequenceNumber in @a index. Returns true on success. Returns false if
+/// the entry is not in the log.
+// -----------------------------------------------------------------------------
+bool GtpLogRingBuffer::indexOfSequenceNumber(uint64_t sequenceNumber, size_t& index) const
+{
+  if (0 == this->numberOfRecords)
+    return false;
+  // Sequence numbers in the ring have no gaps
+  uint64_t oldestSequenceNumber = recordAtIndex(0).sequenceNumber;
+  if (sequenceNumber < oldestSequenceNumber || sequenceNumber - oldestSequenceNumber >= this->numberOfRecords)
+    return false;
+  index = static_cast<size_t>(sequenceNumber - oldestSequenceNumber);
+  return true;
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Discards all entries. Truncates the spill file, if there is one.
+///
+/// Sequence numbers are not reused, an entry that is added after clear()
+/// gets a sequence number that is higher than those of the discarded entries.
+// -----------------------------------------------------------------------------
+void GtpLogRingBuffer::clear()
+{
+  this->firstRecordIndex = 0;
+  this->numberOfRecords = 0;
+  this->numberOfNonResidentRecords = 0;
+  if (this->spillFileDescriptor >= 0)
+  {
+    if (0 == ftruncate(this->spillFileDescriptor, 0))
+      this->spillFileSize = 0;
+  }
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Returns the number of entries in the log.
+// -----------------------------------------------------------------------------
+size_t GtpLogRingBuffer::size() const
+{
+  return this->numberOfRecords;
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Returns the maximum number of entries in the log.
+// -----------------------------------------------------------------------------
+size_t GtpLogRingBuffer::capacity() const
+{
+  return this->records.size();
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Changes the maximum number of entries in the log to @a capacity.
+/// If the log currently holds more entries, the oldest entries are discarded.
+// -----------------------------------------------------------------------------
+void GtpLogRingBuffer::setCapacity(size_t capacity)
+{
+  capacity = std::max(capacity, static_cast<size_t>(1));
+  if (capacity == this->records.size())
+    return;
+
+  if (this->numberOfRecords > capacity)
+    removeOldestRecords(this->numberOfRecords - capacity);
+
+  std::vector<Record> newRecords(capacity);
+  for (size_t index = 0; index < this->numberOfRecords; ++index)
+    newRecords[index] = recordAtIndex(index);
+  this->records.swap(newRecords);
+  this->firstRecordIndex = 0;
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Returns the number of entries whose strings are still in the arena.
+// -----------------------------------------------------------------------------
+size_t GtpLogRingBuffer::numberOfResidentEntries() const
+{
+  return this->numberOfRecords - this->numberOfNonResidentRecords;
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Creates a new spill file at @a path and writes all complete entries
+/// to it. An existing file at @a path is overwritten. Returns true on success,
+/// false on failure.
+///
+/// The spill file does not grow beyond @a maximumSpillFileSize bytes. Old
+/// entries are discarded to make room for new entries (see
+/// compactSpillFile()). @a maximumSpillFileSize should be a multiple of the
+/// arena size, otherwise long entries may not fit at all.
+///
+/// If there already is a spill file, it is closed first (see
+/// closeSpillFile()).
+// -----------------------------------------------------------------------------
+bool GtpLogRingBuffer::openSpillFile(const std::string& path, int64_t maximumSpillFileSize)
+{
+  closeSpillFile();
+
+  int fileDescriptor = open(path.c_str(), O_RDWR | O_CREAT | O_TRUNC | O_CLOEXEC, 0600);
+  if (fileDescriptor < 0)
+    return false;
+  this->spillFilePath = path;
+  this->spillFileDescriptor = fileDescriptor;
+  this->spillFileSize = 0;
+  this->maximumSpillFileSize = maximumSpillFileSize;
+
+  // Iterate by sequence number because spilling may discard the oldest
+  // records, which changes the index positions
+  uint64_t nextSequenceNumberToSpill = (this->numberOfRecords > 0) ? recordAtIndex(0).sequenceNumber : 0;
+  size_t index;
+  while (this->spillFileDescriptor >= 0 && indexOfSequenceNumber(nextSequenceNumberToSpill++, index))
+  {
+    Record& record = recordAtIndex(index);
+    if (record.flags & RecordFlagHasResponse)
+      spillRecord(record);
+  }
+  return hasSpillFile();
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Closes and deletes the spill file. Entries whose strings are only
+/// in the spill file are discarded. Does nothing if there is no spill file.
+// -----------------------------------------------------------------------------
+void GtpLogRingBuffer::closeSpillFile()
+{
+  if (this->spillFileDescriptor < 0)
+    return;
+
+  removeOldestRecords(this->numberOfNonResidentRecords);
+  for (size_t index = 0; index < this->numberOfRecords; ++index)
+  {
+    Record& record = recordAtIndex(index);
+    record.flags &= ~RecordFlagSpilled;
+    record.spillFileOffset = -1;
+  }
+
+  close(this->spillFileDescriptor);
+  unlink(this->spillFilePath.c_str());
+  this->spillFileDescriptor = -1;
+  this->spillFilePath.clear();
+  this->spillFileSize = 0;
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Returns true if there is a spill file.
+// -----------------------------------------------------------------------------
+bool GtpLogRingBuffer::hasSpillFile() const
+{
+  return (this->spillFileDescriptor >= 0);
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Returns the maximum number of bytes that a single string may occupy
+/// in the arena.
+// -----------------------------------------------------------------------------
+size_t GtpLogRingBuffer::maximumStoredLength() const
+{
+  return this->arena.size() / 4;
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Returns the record at position @a index. Index position 0 refers to
+/// the oldest record.
+// -----------------------------------------------------------------------------
+GtpLogRingBuffer::Record& GtpLogRingBuffer::recordAtIndex(size_t index)
+{
+  return this->records[(this->firstRecordIndex + index) % this->records.size()];
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Returns the record at position @a index. Index position 0 refers to
+/// the oldest record.
+// -----------------------------------------------------------------------------
+const GtpLogRingBuffer::Record& GtpLogRingBuffer::recordAtIndex(size_t index) const
+{
+  return this->records[(this->firstRecordIndex + index) % this->records.size()];
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Discards the @a numberOfRecordsToRemove oldest records.
+// -----------------------------------------------------------------------------
+void GtpLogRingBuffer::removeOldestRecords(size_t numberOfRecordsToRemove)
+{
+  assert(numberOfRecordsToRemove <= this->numberOfRecords);
+  this->firstRecordIndex = (this->firstRecordIndex + numberOfRecordsToRemove) % this->records.size();
+  this->numberOfRecords -= numberOfRecordsToRemove;
+  if (numberOfRecordsToRemove >= this->numberOfNonResidentRecords)
+    this->numberOfNonResidentRecords = 0;
+  else
+    this->numberOfNonResidentRecords -= numberOfRecordsToRemove;
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Allocates a contiguous region of @a length bytes in the arena and
+/// returns the arena position where the region starts.
+///
+/// Arena positions increase monotonically, the offset into the arena is the
+/// position modulo the arena size. If the region does not fit into the space
+/// that remains until the end of the arena, the region starts at the
+/// beginning of the arena and the remaining space is wasted. Records whose
+/// strings are overwritten by the new region are reclaimed (see
+/// reclaimArenaSpace()).
+// -----------------------------------------------------------------------------
+uint64_t GtpLogRingBuffer::allocateArenaSpace(size_t length)
+{
+  assert(length <= maximumStoredLength());
+  uint64_t arenaSize = this->arena.size();
+  uint64_t startPosition = this->arenaWritePosition;
+  uint64_t offset = startPosition % arenaSize;
+  if (offset + length > arenaSize)
+    startPosition += arenaSize - offset;
+  uint64_t endPosition = startPosition + length;
+  if (endPosition > arenaSize)
+    reclaimArenaSpace(endPosition - arenaSize);
+  this->arenaWritePosition = endPosition;
+  return startPosition;
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Makes sure that no resident record has strings that start before
+/// @a arenaPosition.
+///
+/// Records are processed from oldest to newest. A record that has been
+/// spilled loses its residency but remains in the log. If there is a spill
+/// file, a record that is still waiting for its response is spilled now, so
+/// that it, too, remains in the log. Any other record is discarded together
+/// with all older records. Without spill file there are no older records
+/// that could be kept, because all older records are resident.
+///
+/// Processing can stop at the first record whose command starts at or after
+/// @a arenaPosition, because the command of a newer record is always
+/// allocated after the command of an older record, and the response of a
+/// record is always allocated after its command.
+// -----------------------------------------------------------------------------
+void GtpLogRingBuffer::reclaimArenaSpace(uint64_t arenaPosition)
+{
+  while (this->numberOfNonResidentRecords < this->numberOfRecords)
+  {
+    const Record& record = recordAtIndex(this->numberOfNonResidentRecords);
+    if (record.commandPosition >= arenaPosition)
+      break;
+    if (record.flags & RecordFlagSpilled)
+      this->numberOfNonResidentRecords++;
+    else if (this->spillFileDescriptor >= 0 && ! (record.flags & RecordFlagHasResponse))
+      spillRecord(recordAtIndex(this->numberOfNonResidentRecords));  // the next iteration sees the result
+    else
+      removeOldestRecords(this->numberOfNonResidentRecords + 1);
+  }
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Returns a pointer to the byte in the arena at @a arenaPosition.
+// -----------------------------------------------------------------------------
+char* GtpLogRingBuffer::arenaPointer(uint64_t arenaPosition)
+{
+  return &this->arena[arenaPosition % this->arena.size()];
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Returns a pointer to the byte in the arena at @a arenaPosition.
+// -----------------------------------------------------------------------------
+const char* GtpLogRingBuffer::arenaPointer(uint64_t arenaPosition) const
+{
+  return &this->arena[arenaPosition % this->arena.size()];
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Compresses @a rawResponse into the compression buffer. Returns the
+/// compressed length, or 0 if the compressed data does not fit into the
+/// compression buffer.
+// -----------------------------------------------------------------------------
+size_t GtpLogRingBuffer::compressResponse(const char* rawResponse, size_t rawResponseLength)
+{
+  return compression_encode_buffer(reinterpret_cast<uint8_t*>(&this->compressionBuffer[0]),
+                                   this->compressionBuffer.size(),
+                                   reinterpret_cast<const uint8_t*>(rawResponse),
+                                   rawResponseLength,
+                                   &this->compressionScratchBuffer[0],
+                                   COMPRESSION_LZ4);
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Decompresses the response of @a record, whose compressed bytes are
+/// located at @a storedResponse, into @a rawResponse. Returns true on success,
+/// false on failure.
+// -----------------------------------------------------------------------------
+bool GtpLogRingBuffer::decompressResponse(const char* storedResponse, const Record& record, std::string& rawResponse) const
+{
+  rawResponse.resize(record.responseLength);
+  if (0 == record.responseLength)
+    return true;
+  size_t decompressedLength = compression_decode_buffer(reinterpret_cast<uint8_t*>(&rawResponse[0]),
+                                                        record.responseLength,
+                                                        reinterpret_cast<const uint8_t*>(storedResponse),
+                                                        record.responseStoredLength,
+                                                        &this->compressionScratchBuffer[0],
+                                                        COMPRESSION_LZ4);
+  return (decompressedLength == record.responseLength);
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Appends @a record and its strings, which must be resident, to the
+/// spill file. Closes the spill file if writing fails.
+// -----------------------------------------------------------------------------
+void GtpLogRingBuffer::spillRecord(Record& record)
+{
+  spillRecord(record, arenaPointer(record.commandPosition), arenaPointer(record.responsePosition));
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Appends @a record, @a command and @a storedResponse to the spill
+/// file. Compacts the spill file first if it would otherwise grow beyond its
+/// maximum size, this may discard @a record. Closes the spill file if writing
+/// fails.
+// -----------------------------------------------------------------------------
+void GtpLogRingBuffer::spillRecord(Record& record, const char* command, const char* storedResponse)
+{
+  int64_t spillLength = sizeof(SpillFileRecordHeader) + record.commandLength + record.responseStoredLength;
+  if (this->spillFileSize + spillLength > this->maximumSpillFileSize)
+  {
+    compactSpillFile(record.sequenceNumber, spillLength);
+    size_t index;
+    if (this->spillFileDescriptor < 0 || ! indexOfSequenceNumber(record.sequenceNumber, index))
+      return;
+  }
+
+  SpillFileRecordHeader header;
+  header.sequenceNumber = record.sequenceNumber;
+  header.timeStamp = record.timeStamp;
+  header.commandLength = record.commandLength;
+  header.responseStoredLength = record.responseStoredLength;
+  header.responseLength = record.responseLength;
+  header.flags = record.flags;
+
+  int64_t offset = this->spillFileSize;
+  int64_t commandOffset = offset + sizeof(header);
+  int64_t responseOffset = commandOffset + record.commandLength;
+  bool success =
+    writeFully(this->spillFileDescriptor, reinterpret_cast<const char*>(&header), sizeof(header), offset) &&
+    writeFully(this->spillFileDescriptor, command, record.commandLength, commandOffset) &&
+    writeFully(this->spillFileDescriptor, storedResponse, record.responseStoredLength, responseOffset);
+  if (! success)
+  {
+    closeSpillFile();
+    return;
+  }
+
+  this->spillFileSize = responseOffset + record.responseStoredLength;
+  record.spillFileOffset = commandOffset;
+  record.flags |= RecordFlagSpilled;
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Private helper for spillRecord(). Makes room in the spill file for
+/// @a reservedSize bytes that are about to be written for the record with
+/// sequence number @a sequenceNumberToKeep. Closes the spill file if reading
+/// or writing fails.
+///
+/// Discards the oldest entries until the remaining spilled entries plus
+/// @a reservedSize occupy at most half of the maximum spill file size.
+/// Leaving the other half free means that compacting happens only once in a
+/// while. Then moves the data of the remaining spilled entries to the front of
+/// the spill file, and truncates the spill file.
+///
+/// Data that the spill file contains for the record with
+/// @a sequenceNumberToKeep is not kept, because the record is about to be
+/// written again. The record itself is discarded only if this is necessary to
+/// discard newer entries, or if the record alone does not fit. The caller must
+/// check whether the record is still in the log.
+// -----------------------------------------------------------------------------
+void GtpLogRingBuffer::compactSpillFile(uint64_t sequenceNumberToKeep, int64_t reservedSize)
+{
+  auto spillLength = [](const Record& record) -> int64_t
+  {
+    return sizeof(SpillFileRecordHeader) + record.commandLength + record.responseStoredLength;
+  };
+  auto isMovable = [sequenceNumberToKeep](const Record& record) -> bool
+  {
+    return (record.flags & RecordFlagSpilled) && record.sequenceNumber != sequenceNumberToKeep;
+  };
+
+  int64_t spilledSize = 0;
+  for (size_t index = 0; index < this->numberOfRecords; ++index)
+  {
+    const Record& record = recordAtIndex(index);
+    if (isMovable(record))
+      spilledSize += spillLength(record);
+  }
+  while (this->numberOfRecords > 0 && spilledSize + reservedSize > this->maximumSpillFileSize / 2)
+  {
+    const Record& oldestRecord = recordAtIndex(0);
+    if (oldestRecord.sequenceNumber == sequenceNumberToKeep)
+      reservedSize = 0;
+    else if (isMovable(oldestRecord))
+      spilledSize -= spillLength(oldestRecord);
+    removeOldestRecords(1);
+  }
+
+  // Records are spilled when they are complete, which is not necessarily in
+  // the order of their sequence numbers. Processing records in the order of
+  // their spill file offsets guarantees that moving a record never
+  // overwrites data of a record that has not been moved yet.
+  std::vector<Record*> movableRecords;
+  for (size_t index = 0; index < this->numberOfRecords; ++index)
+  {
+    Record& record = recordAtIndex(index);
+    if (isMovable(record))
+      movableRecords.push_back(&record);
+  }
+  std::sort(movableRecords.begin(), movableRecords.end(),
+            [](const Record* record1, const Record* record2) { return record1->spillFileOffset < record2->spillFileOffset; });
+
+  int64_t writeOffset = 0;
+  std::vector<char> buffer;
+  for (Record* record : movableRecords)
+  {
+    int64_t length = spillLength(*record);
+    int64_t readOffset = record->spillFileOffset - sizeof(SpillFileRecordHeader);
+    if (readOffset != writeOffset)
+    {
+      buffer.resize(length);
+      if (! readFully(this->spillFileDescriptor, &buffer[0], length, readOffset) ||
+          ! writeFully(this->spillFileDescriptor, &buffer[0], length, writeOffset))
+      {
+        closeSpillFile();
+        return;
+      }
+      record->spillFileOffset = writeOffset + sizeof(SpillFileRecordHeader);
+    }
+    writeOffset += length;
+  }
+
+  // If truncating fails the file keeps its size, but the space is reused
+  ftruncate(this->spillFileDescriptor, writeOffset);
+  this->spillFileSize = writeOffset;
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Reads the command and the stored response of @a record from the
+/// spill file. Returns true on success, false on failure.
+// -----------------------------------------------------------------------------
+bool GtpLogRingBuffer::readSpilledRecord(const Record& record, std::string& command, std::string& storedResponse) const
+{
+  if (this->spillFileDescriptor < 0 || record.spillFileOffset < 0)
+    return false;
+
+  command.resize(record.commandLength);
+  storedResponse.resize(record.responseStoredLength);
+  if (record.commandLength > 0 && ! readFully(this->spillFileDescriptor, &command[0], record.commandLength, record.spillFileOffset))
+    return false;
+  if (record.responseStoredLength > 0 && ! readFully(this->spillFileDescriptor, &storedResponse[0], record.responseStoredLength, record.spillFileOffset + record.commandLength))
+    return false;
+  return true;
+}
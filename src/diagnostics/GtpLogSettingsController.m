@@ -43,6 +43,7 @@ enum GtpLogSettingsTableViewSection
 enum SettingsSectionItem
 {
   LogSizeItem,
+  SpillFileItem,
   MaxSettingsSectionItem
 };
 
@@ -154,7 +155,9 @@ enum ResetCannedCommandsSectionItem
 // -----------------------------------------------------------------------------
 - (NSString*) tableView:(UITableView*)tableView titleForFooterInSection:(NSInteger)section
 {
-  if (ResetCannedCommandsSection == section)
+  if (SettingsSection == section)
+    return @"If spilling to disk is enabled, the GTP log keeps only recent items in memory and writes all items to a temporary file. This allows a much larger log size.";
+  else if (ResetCannedCommandsSection == section)
     return @"Discards the current list of predefined commands and restores the factory default list that is shipped with the app.";
   else
     return nil;
@@ -173,14 +176,28 @@ enum ResetCannedCommandsSectionItem
       switch (indexPath.row)
       {
         case LogSizeItem:
+        {
           cell = [TableViewCellFactory cellWithType:SliderWithValueLabelCellType tableView:tableView];
           TableViewSliderCell* sliderCell = (TableViewSliderCell*)cell;
           [sliderCell setDelegate:self actionValueDidChange:nil actionSliderValueDidChange:@selector(logSizeDidChange:)];
           sliderCell.descriptionLabel.text = @"GTP log size";
           sliderCell.slider.minimumValue = gtpLogSizeMinimum;
-          sliderCell.slider.maximumValue = gtpLogSizeMaximum;
+          if (self.logModel.gtpLogSpillFileEnabled)
+            sliderCell.slider.maximumValue = gtpLogSizeMaximumWithSpillFile;
+          else
+            sliderCell.slider.maximumValue = gtpLogSizeMaximum;
           sliderCell.value = self.logModel.gtpLogSize;
           break;
+        }
+        case SpillFileItem:
+        {
+          cell = [TableViewCellFactory cellWithType:SwitchCellType tableView:tableView];
+          UISwitch* accessoryView = (UISwitch*)cell.accessoryView;
+          cell.textLabel.text = @"Spill to disk";
+          accessoryView.on = self.logModel.gtpLogSpillFileEnabled;
+          [accessoryView addTarget:self action:@selector(toggleSpillFile:) forControlEvents:UIControlEventValueChanged];
+          break;
+        }
         default:
           assert(0);
           @throw [NSException exceptionWithName:NSInternalInconsistencyException reason:[NSString stringWithFormat:@"invalid index path %@", indexPath] userInfo:nil];
@@ -266,4 +283,23 @@ enum ResetCannedCommandsSectionItem
   self.logModel.gtpLogSize = sliderCell.value;
 }
 
+// -----------------------------------------------------------------------------
+/// @brief Reacts to a tap gesture on the "Spill to disk" switch. Writes the
+/// new value to the appropriate model.
+// -----------------------------------------------------------------------------
+- (void) toggleSpillFile:(id)sender
+{
+  UISwitch* accessoryView = (UISwitch*)sender;
+  self.logModel.gtpLogSpillFileEnabled = accessoryView.on;
+  // The model may have failed to create the spill file
+  accessoryView.on = self.logModel.gtpLogSpillFileEnabled;
+
+  // The maximum value of the log size slider depends on the switch, and the
+  // model may have reduced the log size
+  NSIndexPath* indexPath = [NSIndexPath indexPathForRow:LogSizeItem inSection:SettingsSection];
+  NSArray* indexPaths = [NSArray arrayWithObject:indexPath];
+  [self.tableView reloadRowsAtIndexPaths:indexPaths
+                        withRowAnimation:UITableViewRowAnimationNone];
+}
+
 @end
@@ -212,8 +212,10 @@
 - (void) reloadBackSideView
 {
   NSString* contentString = @"";
-  for (GtpLogItem* logItem in self.model.itemList)
+  int itemCount = self.model.itemCount;
+  for (int index = 0; index < itemCount; ++index)
   {
+    GtpLogItem* logItem = [self.model itemAtIndex:index];
     // Ignore items with outstanding responses. This should happen only for the
     // last item in the list. Information for that item will be appended to the
     // backside view when the response comes in.
@@ -402,12 +404,16 @@
   if (self.updateScheduledByGtpLogContentChanged)
     return;
 
+  // The item may have been discarded from the log in the meantime
+  int indexOfItem = [self.model indexOfItem:logItem];
+  if (indexOfItem < 0)
+    return;
+
   // Inform tableView:cellForRowAtIndexPath:() that the update is only for a
   // single item (not for scrolling).
   self.updateScheduledByGtpLogItemChanged = true;
 
   NSUInteger sectionIndex = 0;
-  NSUInteger indexOfItem = [self.model.itemList indexOfObject:logItem];
   NSIndexPath* indexPath = [NSIndexPath indexPathForRow:indexOfItem inSection:sectionIndex];
   NSArray* indexPaths = [NSArray arrayWithObject:indexPath];
   [self.frontSideView reloadRowsAtIndexPaths:indexPaths
@@ -19,6 +19,7 @@
 #import "SubmitGtpCommandViewController.h"
 #import "GtpCommandModel.h"
 #import "../gtp/GtpCommand.h"
+#import "../gtp/GtpEngineState.h"
 #import "../main/ApplicationDelegate.h"
 #import "../ui/AutoLayoutUtility.h"
 #import "../ui/EditTextController.h"
@@ -271,11 +272,17 @@
 // -----------------------------------------------------------------------------
 /// @brief Submits a GTP command using the text entered by the user as the
 /// command text.
+///
+/// The user waits for the response, so the command is interactive. A command
+/// that may change the position, however, keeps the normal priority so that
+/// it does not preempt the computer player in the middle of its move.
 // -----------------------------------------------------------------------------
 - (void) submitCommand:(id)sender
 {
   GtpCommand* command = [GtpCommand command:self.textField.text];
   command.waitUntilDone = false;
+  if (! [GtpEngineState commandMayChangePosition:command.command])
+    command.priority = GtpCommandPriorityInteractive;
   [command submit];
   [self.navigationController popViewControllerAnimated:YES];
 }
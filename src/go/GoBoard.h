@@ -33,12 +33,21 @@
 /// these objects. A GoPoint object is identified by the coordinates of the
 /// intersection it is located on, or by its association with its neighbouring
 /// GoPoint objects in one of several directions (see #GoBoardDirection).
+///
+/// The stone states of all intersections are stored in a GoBoardCore object
+/// that is private to GoBoard. GoPoint objects are views that read and write
+/// their stone state through GoBoard. Queries that involve many intersections,
+/// such as counting the liberties of a stone group, are answered by
+/// GoBoardCore without going through GoPoint objects.
 // -----------------------------------------------------------------------------
 @interface GoBoard : NSObject <NSCoding>
 {
 @private
   /// @brief Keys = Vertices as NSString objects, values = GoPoint objects
   NSMutableDictionary* m_vertexDict;
+  /// @brief One territory statistics score per intersection, see property
+  /// @e territoryStatisticsScores.
+  float* m_territoryStatisticsScores;
 }
 
 + (GoBoard*) boardWithDefaultSize;
@@ -48,6 +57,23 @@
 - (GoPoint*) pointAtVertex:(NSString*)vertex;
 - (GoPoint*) neighbourOf:(GoPoint*)point inDirection:(enum GoBoardDirection)direction;
 - (GoPoint*) pointAtCorner:(enum GoBoardCorner)corner;
+- (int) indexOfPoint:(GoPoint*)point;
+- (GoPoint*) pointAtIndex:(int)index;
+- (enum GoColor) stoneStateAtIndex:(int)index;
+- (void) setStoneState:(enum GoColor)stoneState atIndex:(int)index;
+- (int) libertiesAtIndex:(int)index;
+- (bool) isInAtariAtIndex:(int)index;
+- (bool) isCaptureAtIndex:(int)index byColor:(enum GoColor)color;
+- (bool) isSuicideAtIndex:(int)index byColor:(enum GoColor)color;
+- (void) analyzeMovesByColor:(enum GoColor)color
+                   isSuicide:(bool*)isSuicide
+          zobristHashChanges:(long long*)zobristHashChanges;
+- (void) analyzeTerritoryWithStoneGroupStates:(const enum GoStoneGroupState*)stoneGroupStates
+                                scoringSystem:(enum GoScoringSystem)scoringSystem
+                              territoryColors:(enum GoColor*)territoryColors
+                     territoryInconsistencies:(bool*)territoryInconsistencies;
+- (void) estimateStoneGroupStates:(enum GoStoneGroupState*)stoneGroupStates;
+- (void) updateTerritoryStatisticsScores:(const float*)scores;
 
 /// @brief The board size, specifying the horizontal and vertical board
 /// dimensions.
@@ -61,5 +87,25 @@
 /// @brief Zobrist table used for calculating Zobrist hashes. Zobrist hashes
 /// are used to detect superko.
 @property(nonatomic, retain, readonly) GoZobristTable* zobristTable;
+/// @brief The scores assigned to the intersections of this board by the most
+/// recent territory statistics evaluation. The array has one element per
+/// intersection, in the order defined by indexOfPoint:().
+///
+/// The array is owned by GoBoard and lives as long as the GoBoard object.
+/// The content of the array changes when updateTerritoryStatisticsScores:() is
+/// invoked.
+@property(nonatomic, assign, readonly) const float* territoryStatisticsScores;
+/// @brief True if the scores in @e territoryStatisticsScores were computed for
+/// the stones that are currently on the board. False if no scores were stored
+/// with updateTerritoryStatisticsScores:(), or if the stone state of an
+/// intersection has changed since the scores were stored.
+@property(nonatomic, assign, readonly) bool territoryStatisticsScoresAreCurrent;
+/// @brief Counts how often the stone state of an intersection has been changed
+/// since this GoBoard was created.
+///
+/// Clients that cache information derived from the stones on the board can
+/// compare this counter with the value they saw when they filled their cache
+/// to find out whether the cache is stale.
+@property(nonatomic, assign, readonly) unsigned long long stoneStateChangeCount;
 
 @end
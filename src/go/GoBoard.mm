@@ -0,0 +1,851 @@
+// -----------------------------------------------------------------------------
+// Copyright 2011-2015 Patrick Näf (herzbube@herzbube.ch)
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// -----------------------------------------------------------------------------
+
+
+// -----------------------------------------------------------------------------
+/// @defgroup go Go module
+///
+/// Classes in this module directly relate to an aspect of the actual Go game
+/// (e.g. GoBoard represents the Go board).
+// -----------------------------------------------------------------------------
+
+
+// Project includes
+#import "GoBoard.h"
+#import "GoBoardCore.h"
+#import "GoDeadStoneEstimator.h"
+#import "GoBoardRegion.h"
+#import "GoPoint.h"
+#import "GoTerritoryEngine.h"
+#import "GoVertex.h"
+#import "GoZobristTable.h"
+#import "../main/ApplicationDelegate.h"
+#import "../newgame/NewGameModel.h"
+
+
+static_assert(GoColorNone == static_cast<int>(GoBoardCore::ColorNone), "GoColorNone must match GoBoardCore");
+static_assert(GoColorBlack == static_cast<int>(GoBoardCore::ColorBlack), "GoColorBlack must match GoBoardCore");
+static_assert(GoColorWhite == static_cast<int>(GoBoardCore::ColorWhite), "GoColorWhite must match GoBoardCore");
+static_assert(GoScoringSystemAreaScoring == static_cast<int>(GoTerritoryEngine::AreaScoring), "GoScoringSystemAreaScoring must match GoTerritoryEngine");
+static_assert(GoScoringSystemTerritoryScoring == static_cast<int>(GoTerritoryEngine::TerritoryScoring), "GoScoringSystemTerritoryScoring must match GoTerritoryEngine");
+
+// -----------------------------------------------------------------------------
+/// @brief Class extension with private properties for GoBoard.
+// -----------------------------------------------------------------------------
+@interface GoBoard()
+{
+@private
+  /// @brief Stores the stone states of all intersections. GoPoint objects read
+  /// and write their stone state through GoBoard.
+  GoBoardCore* _core;
+  /// @brief One GoPoint object per intersection, in the order defined by
+  /// indexOfPoint:(). The GoPoint objects are retained by m_vertexDict.
+  GoPoint** _points;
+}
+/// @name Re-declaration of properties to make them readwrite privately
+//@{
+@property(nonatomic, assign, readwrite) enum GoBoardSize size;
+@property(nonatomic, retain, readwrite) NSArray* starPoints;
+@property(nonatomic, retain, readwrite) GoZobristTable* zobristTable;
+@property(nonatomic, assign, readwrite) unsigned long long stoneStateChangeCount;
+//@}
+/// @name Privately declared properties
+//@{
+/// @brief True if updateTerritoryStatisticsScores:() has stored territory
+/// statistics scores that were computed for a board position.
+@property(nonatomic, assign) bool hasTerritoryStatisticsScores;
+/// @brief The value of @e stoneStateChangeCount when the territory statistics
+/// scores were stored.
+@property(nonatomic, assign) unsigned long long territoryStatisticsStoneStateChangeCount;
+//@}
+@end
+
+
+@implementation GoBoard
+
+// -----------------------------------------------------------------------------
+/// @brief Convenience constructor. Creates a GoBoard instance which uses the
+/// "New Game" default board size.
+// -----------------------------------------------------------------------------
++ (GoBoard*) boardWithDefaultSize
+{
+  NewGameModel* model = [ApplicationDelegate sharedDelegate].theNewGameModel;
+  return [GoBoard boardWithSize:model.boardSize];
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Convenience constructor. Creates a GoBoard instance of size @a size.
+///
+/// Raises an @e NSInvalidArgumentException if @a size is #GoBoardSizeUndefined
+/// or otherwise invalid.
+// -----------------------------------------------------------------------------
++ (GoBoard*) boardWithSize:(enum GoBoardSize)size;
+{
+  switch (size)
+  {
+    case GoBoardSize7:
+    case GoBoardSize9:
+    case GoBoardSize11:
+    case GoBoardSize13:
+    case GoBoardSize15:
+    case GoBoardSize17:
+    case GoBoardSize19:
+    {
+      break;
+    }
+    case GoBoardSizeUndefined:
+    default:
+    {
+      NSString* errorMessage = [NSString stringWithFormat:@"Board size %d is invalid", size];
+      DDLogError(@"%@: %@", self, errorMessage);
+      NSException* exception = [NSException exceptionWithName:NSInvalidArgumentException
+                                                       reason:errorMessage
+                                                     userInfo:nil];
+      @throw exception;
+    }
+  }
+
+  GoBoard* board = [[GoBoard alloc] initWithSize:size];
+  if (board)
+    [board autorelease];
+  return board;
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Returns a string representation of @a size that is suitable
+/// for displaying in the UI.
+///
+/// Returns the string "Undefined" if @a size is #GoBoardSizeUndefined.
+/// 
+/// Raises an @e NSInvalidArgumentException if @a size is otherwise invalid.
+// -----------------------------------------------------------------------------
++ (NSString*) stringForSize:(enum GoBoardSize)size
+{
+  switch (size)
+  {
+    case GoBoardSize7:
+    case GoBoardSize9:
+    case GoBoardSize11:
+    case GoBoardSize13:
+    case GoBoardSize15:
+    case GoBoardSize17:
+    case GoBoardSize19:
+    {
+      return [NSString stringWithFormat:@"%d", size];
+    }
+    case GoBoardSizeUndefined:
+    {
+      return @"Undefined";
+    }
+    default:
+    {
+      NSString* errorMessage = [NSString stringWithFormat:@"Board size %d is invalid", size];
+      DDLogError(@"%@: %@", self, errorMessage);
+      NSException* exception = [NSException exceptionWithName:NSInvalidArgumentException
+                                                       reason:errorMessage
+                                                     userInfo:nil];
+      @throw exception;
+    }
+  }
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Initializes a GoBoard object with size @a boardSize.
+///
+/// @note This is the designated initializer of GoBoard.
+// -----------------------------------------------------------------------------
+- (id) initWithSize:(enum GoBoardSize)boardSize
+{
+  // Call designated initializer of superclass (NSObject)
+  self = [super init];
+  if (! self)
+    return nil;
+
+  self.size = boardSize;
+  _core = new GoBoardCore(boardSize);
+  _points = new GoPoint*[boardSize * boardSize];
+  m_vertexDict = [[NSMutableDictionary dictionary] retain];
+  m_territoryStatisticsScores = (float*)calloc(boardSize * boardSize, sizeof(float));
+  self.hasTerritoryStatisticsScores = false;
+  self.territoryStatisticsStoneStateChangeCount = 0;
+  self.starPoints = nil;
+  self.zobristTable = [[[GoZobristTable alloc] initWithBoardSize:self.size] autorelease];
+
+  [self setupBoard];
+
+  return self;
+}
+
+// -----------------------------------------------------------------------------
+/// @brief NSCoding protocol method.
+// -----------------------------------------------------------------------------
+- (id) initWithCoder:(NSCoder*)decoder
+{
+  self = [super init];
+  if (! self)
+    return nil;
+
+  if ([decoder decodeIntForKey:nscodingVersionKey] != nscodingVersion)
+    return nil;
+  self.size = [decoder decodeIntForKey:goBoardSizeKey];
+  // The board core must exist before the GoPoint objects are decoded, because
+  // each GoPoint restores its stone state into the board core
+  _core = new GoBoardCore(self.size);
+  _points = new GoPoint*[self.size * self.size];
+  m_territoryStatisticsScores = (float*)calloc(self.size * self.size, sizeof(float));
+  NSUInteger length = 0;
+  const uint8_t* territoryStatisticsScores = [decoder decodeBytesForKey:goBoardTerritoryStatisticsScoresKey
+                                                         returnedLength:&length];
+  if (territoryStatisticsScores && length == self.size * self.size * sizeof(float))
+    memcpy(m_territoryStatisticsScores, territoryStatisticsScores, length);
+  // The decoded scores can still be displayed, but it cannot be verified that
+  // they were computed for the decoded board position
+  self.hasTerritoryStatisticsScores = false;
+  self.territoryStatisticsStoneStateChangeCount = 0;
+  m_vertexDict = [[decoder decodeObjectForKey:goBoardVertexDictKey] retain];
+  // Some GoPoint objects may not yet be fully decoded at this point (this
+  // happens if decoding of this GoBoard was triggered by a GoPoint), so we
+  // must take the index from the dictionary key instead of from the GoPoint
+  for (NSString* vertexString in m_vertexDict)
+  {
+    struct GoVertexNumeric numericVertex = [GoVertex vertexFromString:vertexString].numeric;
+    _points[(numericVertex.y - 1) * _size + (numericVertex.x - 1)] = [m_vertexDict objectForKey:vertexString];
+  }
+  self.starPoints = [decoder decodeObjectForKey:goBoardStarPointsKey];
+  self.zobristTable = [[[GoZobristTable alloc] initWithBoardSize:self.size] autorelease];
+
+  return self;
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Deallocates memory allocated by this GoBoard object.
+// -----------------------------------------------------------------------------
+- (void) dealloc
+{
+  // Trigger the breaking of retain cycles in all GoPoint objects
+  // TODO: Obviously, it would be nicer if we didn't have any retain cycles to
+  // worry about...
+  for (GoPoint* point in [m_vertexDict allValues])
+    [point prepareForDealloc];
+  [m_vertexDict release];
+  delete[] _points;
+  delete _core;
+  free(m_territoryStatisticsScores);
+  self.starPoints = nil;
+  self.zobristTable = nil;
+  [super dealloc];
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Sets up this GoBoard.
+///
+/// This is an internal helper invoked during initialization.
+// -----------------------------------------------------------------------------
+- (void) setupBoard
+{
+  // Order of invocation is important
+  [self setupGoPoints];
+  [self setupStarPoints];
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Creates all GoPoint objects that belong to a single GoBoardRegion.
+///
+/// This is an internal helper invoked during initialization.
+// -----------------------------------------------------------------------------
+- (void) setupGoPoints
+{
+  // All GoPoint objects are created up front, in the order defined by
+  // indexOfPoint:(). This makes pointAtIndex:() and the directional lookups
+  // in neighbourOf:inDirection:() simple array accesses. Creating GoPoint
+  // objects lazily would also make the handling of the initial GoBoardRegion
+  // a lot more complicated, because a GoPoint could be created at a time when
+  // the initial region has already become fragmented into smaller regions.
+  GoBoardRegion* region = [GoBoardRegion region];
+  int numberOfIntersections = _size * _size;
+  for (int index = 0; index < numberOfIntersections; ++index)
+  {
+    struct GoVertexNumeric numericVertex;
+    numericVertex.x = index % _size + 1;
+    numericVertex.y = index / _size + 1;
+    GoVertex* vertex = [GoVertex vertexFromNumeric:numericVertex];
+    GoPoint* point = [GoPoint pointAtVertex:vertex onBoard:self];
+    [m_vertexDict setObject:point forKey:vertex.string];
+    _points[index] = point;
+    // On a clear board, the initial region contains all GoPoint objects
+    [region addPoint:point];
+  }
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Determines all GoPoint objects that are star points.
+///
+/// This is an internal helper invoked during initialization.
+// -----------------------------------------------------------------------------
+- (void) setupStarPoints
+{
+  NSMutableArray* starPointsLocal = [NSMutableArray arrayWithCapacity:0];
+  for (NSString* starPointVertex in [self starPointVertexes])
+  {
+    GoPoint* starPoint = [self pointAtVertex:starPointVertex];
+    starPoint.starPoint = true;
+    [starPointsLocal addObject:starPoint];
+  }
+  // Make a copy that is immutable because we hand out references to the
+  // array, and we don't want clients to be able to change the array
+  self.starPoints = [NSArray arrayWithArray:starPointsLocal];
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Returns a description for this GoBoard object.
+///
+/// This method is invoked when GoBoard needs to be represented as a string,
+/// i.e. by NSLog, or when the debugger command "po" is used on the object.
+// -----------------------------------------------------------------------------
+- (NSString*) description
+{
+  // Don't use self to access properties to avoid unnecessary overhead during
+  // debugging
+  return [NSString stringWithFormat:@"GoBoard(%p): size = %d", self, _size];
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Returns an enumerator that can be used to iterate over all existing
+/// GoPoint objects
+///
+/// @todo Remove this method, clients should instead use GoPoint::next() or
+/// GoPoint::previous() for iteration.
+// -----------------------------------------------------------------------------
+- (NSEnumerator*) pointEnumerator
+{
+  // The array including the enumerator will be destroyed as soon as the
+  // current execution path finishes
+  NSArray* points = [NSArray arrayWithObjects:_points count:_size * _size];
+  return [points objectEnumerator];
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Returns the GoPoint object located at @a vertex.
+///
+/// See the GoVertex class documentation for a discussion of what a vertex is.
+///
+/// Raises an @e NSRangeException if one of the vertex compounds stored in
+/// @a stringValue are outside the supported range of values. Raises an
+/// @e NSInvalidArgumentException if @a stringValue is nil or otherwise
+/// fundamentally malformed.
+// -----------------------------------------------------------------------------
+- (GoPoint*) pointAtVertex:(NSString*)vertex
+{
+  int index = [self indexOfVertex:vertex];
+  if (index < 0)
+  {
+    // GoVertex raises the appropriate exception if the vertex is malformed or
+    // out of range
+    struct GoVertexNumeric numericVertex = [GoVertex vertexFromString:vertex].numeric;
+    if (numericVertex.x > _size || numericVertex.y > _size)
+    {
+      NSString* errorMessage = [NSString stringWithFormat:@"Vertex %@ is out of range for board size %d", vertex, _size];
+      DDLogError(@"%@: %@", self, errorMessage);
+      NSException* exception = [NSException exceptionWithName:NSRangeException
+                                                       reason:errorMessage
+                                                     userInfo:nil];
+      @throw exception;
+    }
+    index = (numericVertex.y - 1) * _size + (numericVertex.x - 1);
+  }
+  return _points[index];
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Returns the index position of the intersection identified by
+/// @a vertex, in the order defined by indexOfPoint:(). Returns -1 if @a vertex
+/// is not a well-formed vertex that is located on this board.
+///
+/// This is a private helper for pointAtVertex:(). It parses the vertex
+/// characters directly, without creating any objects, and does not report any
+/// errors. pointAtVertex:() lets GoVertex report errors.
+// -----------------------------------------------------------------------------
+- (int) indexOfVertex:(NSString*)vertex
+{
+  NSUInteger length = vertex.length;
+  if (length < 2 || length > 3)
+    return -1;
+
+  unichar letter = [vertex characterAtIndex:0];
+  if (letter >= 'a' && letter <= 'z')
+    letter -= ('a' - 'A');
+  if (letter < 'A' || letter > 'Z' || 'I' == letter)
+    return -1;
+  int x = letter - 'A' + (letter < 'I' ? 1 : 0);
+
+  int y = 0;
+  for (NSUInteger characterIndex = 1; characterIndex < length; ++characterIndex)
+  {
+    unichar digit = [vertex characterAtIndex:characterIndex];
+    if (digit < '0' || digit > '9')
+      return -1;
+    y = y * 10 + (digit - '0');
+  }
+
+  if (x < 1 || x > _size || y < 1 || y > _size)
+    return -1;
+  return (y - 1) * _size + (x - 1);
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Returns the GoPoint object that is a direct neighbour of @a point
+/// located in direction @a direction.
+///
+/// Returns nil if no neighbour exists in the specified direction. For instance,
+/// if @a point is at the left edge of the board, it has no left neighbour,
+/// which will cause a nil value to be returned.
+///
+/// @note #GoBoardDirectionNext and #GoBoardDirectionPrevious are intended to
+/// iterate over all existing GoPoint objects.
+///
+/// @internal This is the backend for the GoPoint directional properties (e.g.
+/// GoPoint::left()).
+// -----------------------------------------------------------------------------
+- (GoPoint*) neighbourOf:(GoPoint*)point inDirection:(enum GoBoardDirection)direction
+{
+  int index = point.index;
+  int x = index % _size;
+  switch (direction)
+  {
+    case GoBoardDirectionLeft:
+      if (0 == x)
+        return nil;
+      index--;
+      break;
+    case GoBoardDirectionRight:
+      if (_size - 1 == x)
+        return nil;
+      index++;
+      break;
+    case GoBoardDirectionUp:
+      index += _size;
+      if (index >= _size * _size)
+        return nil;
+      break;
+    case GoBoardDirectionDown:
+      index -= _size;
+      if (index < 0)
+        return nil;
+      break;
+    case GoBoardDirectionNext:
+      index++;
+      if (index >= _size * _size)
+        return nil;
+      break;
+    case GoBoardDirectionPrevious:
+      index--;
+      if (index < 0)
+        return nil;
+      break;
+    default:
+      return nil;
+  }
+  return _points[index];
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Returns the GoPoint object located at the corner of the board
+/// defined by @a corner.
+// -----------------------------------------------------------------------------
+- (GoPoint*) pointAtCorner:(enum GoBoardCorner)corner
+{
+  struct GoVertexNumeric numericVertex;
+  switch (corner)
+  {
+    case GoBoardCornerBottomLeft:
+      numericVertex.x = 1;
+      numericVertex.y = 1;
+      break;
+    case GoBoardCornerBottomRight:
+      numericVertex.x = _size;
+      numericVertex.y = 1;
+      break;
+    case GoBoardCornerTopLeft:
+      numericVertex.x = 1;
+      numericVertex.y = _size;
+      break;
+    case GoBoardCornerTopRight:
+      numericVertex.x = _size;
+      numericVertex.y = _size;
+      break;
+    default:
+    {
+      NSString* errorMessage = [NSString stringWithFormat:@"Invalid board cornder %d", corner];
+      DDLogError(@"%@: %@", self, errorMessage);
+      NSException* exception = [NSException exceptionWithName:NSInvalidArgumentException
+                                                       reason:errorMessage
+                                                     userInfo:nil];
+      @throw exception;
+    }
+  }
+  return _points[(numericVertex.y - 1) * _size + (numericVertex.x - 1)];
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Returns a list of NSString vertexes that define the star points for
+/// the current board size.
+///
+/// Returns an empty list if the current board size does not have any star
+/// points.
+///
+/// Star point definitions are read from the user defaults system. The
+/// definitions are immutable and are available only through the application
+/// defaults registered at application startup.
+///
+/// @note Star point definitions vary depending on which information source is
+/// queried. Fuego and Goban.app, for instance, do not have the same definitions
+/// for some board sizes. Sensei's Library only has definitions for 9x9, 13x13
+/// and 19x19. The current star point definitions in Little Go match those
+/// provided by Fuego.
+// -----------------------------------------------------------------------------
+- (NSArray*) starPointVertexes
+{
+  NSUserDefaults* userDefaults = [NSUserDefaults standardUserDefaults];
+  NSDictionary* dictionary = [userDefaults dictionaryForKey:starPointsKey];
+  NSString* boardSizeKey = [NSString stringWithFormat:@"%d", self.size];
+  NSString* starPointVertexListAsString = [dictionary valueForKey:boardSizeKey];
+  if (starPointVertexListAsString == nil || [starPointVertexListAsString length] == 0)
+    return [NSArray array];
+  return [starPointVertexListAsString componentsSeparatedByString:@","];
+}
+
+// -----------------------------------------------------------------------------
+// Property is documented in the header file.
+// -----------------------------------------------------------------------------
+- (NSArray*) regions
+{
+  NSMutableArray* regionList = [NSMutableArray arrayWithCapacity:0];
+  NSMutableSet* regionSet = [NSMutableSet setWithCapacity:0];
+  int numberOfIntersections = _size * _size;
+  for (int index = 0; index < numberOfIntersections; ++index)
+  {
+    GoBoardRegion* region = _points[index].region;
+    if ([regionSet containsObject:region])
+      continue;
+    [regionSet addObject:region];
+    [regionList addObject:region];
+  }
+  return regionList;
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Returns the index position of @a point in flat per-intersection
+/// arrays such as @e territoryStatisticsScores. The intersections are laid
+/// out in row-major order, starting with A1, i.e. A1 has index 0, B1 has
+/// index 1, and A2 has an index equal to the board size.
+// -----------------------------------------------------------------------------
+- (int) indexOfPoint:(GoPoint*)point
+{
+  return point.index;
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Returns the GoPoint object located at index position @a index in
+/// the order defined by indexOfPoint:(). This is the inverse of
+/// indexOfPoint:().
+///
+/// Raises an @e NSRangeException if @a index is not a valid index position
+/// for the size of this board.
+// -----------------------------------------------------------------------------
+- (GoPoint*) pointAtIndex:(int)index
+{
+  if (index < 0 || index >= _size * _size)
+  {
+    NSString* errorMessage = [NSString stringWithFormat:@"Index %d is out of range for board size %d", index, _size];
+    DDLogError(@"%@: %@", self, errorMessage);
+    NSException* exception = [NSException exceptionWithName:NSRangeException
+                                                     reason:errorMessage
+                                                   userInfo:nil];
+    @throw exception;
+  }
+  return _points[index];
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Returns the stone state of the intersection at index position
+/// @a index, in the order defined by indexOfPoint:().
+///
+/// @internal This is the backend for GoPoint::stoneState().
+// -----------------------------------------------------------------------------
+- (enum GoColor) stoneStateAtIndex:(int)index
+{
+  return static_cast<enum GoColor>(_core->colorAt(index));
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Changes the stone state of the intersection at index position
+/// @a index, in the order defined by indexOfPoint:(), to @a stoneState.
+///
+/// @internal This is the backend for GoPoint::setStoneState:().
+// -----------------------------------------------------------------------------
+- (void) setStoneState:(enum GoColor)stoneState atIndex:(int)index
+{
+  _core->setColorAt(index, static_cast<GoBoardCore::Color>(stoneState));
+  ++_stoneStateChangeCount;
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Returns the number of liberties of the stone group that the stone on
+/// the intersection at index position @a index belongs to. If the
+/// intersection is not occupied by a stone, returns the number of adjacent
+/// intersections that are not occupied by a stone.
+///
+/// The liberties of stone groups are tracked incrementally as stones are
+/// placed and removed, so this is a constant-time lookup.
+///
+/// @internal This is the backend for GoPoint::liberties() and
+/// GoBoardRegion::liberties().
+// -----------------------------------------------------------------------------
+- (int) libertiesAtIndex:(int)index
+{
+  return _core->numberOfLibertiesOfGroupAt(index);
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Returns true if the intersection at index position @a index is
+/// occupied by a stone whose stone group has exactly one liberty.
+// -----------------------------------------------------------------------------
+- (bool) isInAtariAtIndex:(int)index
+{
+  return _core->isInAtari(index);
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Returns true if playing a stone of color @a color on the empty
+/// intersection at index position @a index would capture at least one stone
+/// group of the opposing color.
+// -----------------------------------------------------------------------------
+- (bool) isCaptureAtIndex:(int)index byColor:(enum GoColor)color
+{
+  return _core->isCapture(index, static_cast<GoBoardCore::Color>(color));
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Returns true if playing a stone of color @a color on the empty
+/// intersection at index position @a index would be suicide. Does not check
+/// for ko.
+// -----------------------------------------------------------------------------
+- (bool) isSuicideAtIndex:(int)index byColor:(enum GoColor)color
+{
+  return _core->isSuicide(index, static_cast<GoBoardCore::Color>(color));
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Analyzes in a single pass what would happen if a stone of color
+/// @a color were played on each empty intersection of the board. Ko is not
+/// taken into account.
+///
+/// @a isSuicide and @a zobristHashChanges must have one element per
+/// intersection, in the order defined by indexOfPoint:(). For each empty
+/// intersection this method sets the element of @a isSuicide to true if
+/// playing there would be suicide, and the element of @a zobristHashChanges to
+/// the value that must be XOR'ed to the Zobrist hash of the current board
+/// position to obtain the Zobrist hash of the board position after the move.
+/// The change includes the stones that the move would capture. For occupied
+/// intersections the elements of both arrays are set to false and 0.
+// -----------------------------------------------------------------------------
+- (void) analyzeMovesByColor:(enum GoColor)color
+                   isSuicide:(bool*)isSuicide
+          zobristHashChanges:(long long*)zobristHashChanges
+{
+  GoBoardCore::Color coreColor = static_cast<GoBoardCore::Color>(color);
+  enum GoColor opponentColor = (GoColorBlack == color ? GoColorWhite : GoColorBlack);
+  GoBoardCore::Bitboard suicidePositions;
+  GoBoardCore::Bitboard capturePositions;
+  _core->analyzeMoves(coreColor, suicidePositions, capturePositions);
+
+  GoZobristTable* zobristTable = self.zobristTable;
+  int numberOfIntersections = _core->numberOfIntersections();
+  for (int index = 0; index < numberOfIntersections; ++index)
+  {
+    if (GoBoardCore::ColorNone != _core->colorAt(index))
+    {
+      isSuicide[index] = false;
+      zobristHashChanges[index] = 0;
+      continue;
+    }
+
+    int position = _core->positionOfBoardIndex(index);
+    isSuicide[index] = suicidePositions.test(position);
+    long long zobristHashChange = [zobristTable hashForStoneWithColor:color atIndex:index];
+    if (capturePositions.test(position))
+    {
+      GoBoardCore::Bitboard capturedStones = _core->capturedStones(index, coreColor);
+      while (capturedStones.any())
+      {
+        int capturedStoneIndex = _core->boardIndexOfPosition(capturedStones.removeFirstPosition());
+        zobristHashChange ^= [zobristTable hashForStoneWithColor:opponentColor atIndex:capturedStoneIndex];
+      }
+    }
+    zobristHashChanges[index] = zobristHashChange;
+  }
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Determines in a single pass the territory color of each empty
+/// intersection of the board, using the scoring system @a scoringSystem. See
+/// the GoTerritoryEngine class documentation for details.
+///
+/// @a stoneGroupStates, @a territoryColors and @a territoryInconsistencies
+/// must have one element per intersection, in the order defined by
+/// indexOfPoint:(). @a stoneGroupStates must contain the state of the stone
+/// group for each intersection that is occupied by a stone, elements for empty
+/// intersections are ignored. For each empty intersection this method sets
+/// the element of @a territoryColors to the territory color of the area of
+/// empty intersections that the intersection belongs to, and the element of
+/// @a territoryInconsistencies to true if an inconsistency was found in that
+/// area. For occupied intersections the elements of both arrays are set to
+/// #GoColorNone and false.
+// -----------------------------------------------------------------------------
+- (void) analyzeTerritoryWithStoneGroupStates:(const enum GoStoneGroupState*)stoneGroupStates
+                                scoringSystem:(enum GoScoringSystem)scoringSystem
+                              territoryColors:(enum GoColor*)territoryColors
+                     territoryInconsistencies:(bool*)territoryInconsistencies
+{
+  GoBoardCore::Bitboard deadStones;
+  GoBoardCore::Bitboard sekiStones;
+  int numberOfIntersections = _core->numberOfIntersections();
+  for (int index = 0; index < numberOfIntersections; ++index)
+  {
+    territoryColors[index] = GoColorNone;
+    territoryInconsistencies[index] = false;
+    if (GoBoardCore::ColorNone == _core->colorAt(index))
+      continue;
+    if (GoStoneGroupStateDead == stoneGroupStates[index])
+      deadStones.set(_core->positionOfBoardIndex(index));
+    else if (GoStoneGroupStateSeki == stoneGroupStates[index])
+      sekiStones.set(_core->positionOfBoardIndex(index));
+  }
+
+  GoTerritoryEngine territoryEngine(*_core);
+  territoryEngine.setDeadStones(deadStones);
+  territoryEngine.setSekiStones(sekiStones);
+  std::vector<GoTerritoryEngine::EmptyArea> emptyAreas = territoryEngine.analyzeTerritory(static_cast<GoTerritoryEngine::ScoringSystem>(scoringSystem));
+  for (const GoTerritoryEngine::EmptyArea& emptyArea : emptyAreas)
+  {
+    GoBoardCore::Bitboard positions = emptyArea.positions;
+    while (positions.any())
+    {
+      int index = _core->boardIndexOfPosition(positions.removeFirstPosition());
+      territoryColors[index] = static_cast<enum GoColor>(emptyArea.territoryColor);
+      territoryInconsistencies[index] = emptyArea.territoryInconsistencyFound;
+    }
+  }
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Estimates without the help of a GTP engine which stone groups on the
+/// board are alive and which are dead. Uses the territory statistics scores in
+/// property @e territoryStatisticsScores if they are available and were
+/// computed for the current board position (see property
+/// @e territoryStatisticsScoresAreCurrent). See the GoDeadStoneEstimator class
+/// documentation for details.
+///
+/// @a stoneGroupStates must have one element per intersection, in the order
+/// defined by indexOfPoint:(). For each intersection that is occupied by a
+/// stone this method sets the element to #GoStoneGroupStateAlive or
+/// #GoStoneGroupStateDead if the estimate for the stone's group is certain
+/// enough, or to #GoStoneGroupStateUndefined if the estimate is ambiguous.
+/// For empty intersections the element is set to #GoStoneGroupStateUndefined.
+// -----------------------------------------------------------------------------
+- (void) estimateStoneGroupStates:(enum GoStoneGroupState*)stoneGroupStates
+{
+  int numberOfIntersections = _core->numberOfIntersections();
+  for (int index = 0; index < numberOfIntersections; ++index)
+    stoneGroupStates[index] = GoStoneGroupStateUndefined;
+
+  GoDeadStoneEstimator deadStoneEstimator(*_core);
+  if (self.territoryStatisticsScoresAreCurrent)
+    deadStoneEstimator.setTerritoryStatisticsScores(m_territoryStatisticsScores);
+  std::vector<GoDeadStoneEstimator::StoneGroup> stoneGroups = deadStoneEstimator.estimateDeadStones();
+  for (const GoDeadStoneEstimator::StoneGroup& stoneGroup : stoneGroups)
+  {
+    enum GoStoneGroupState stoneGroupState;
+    switch (stoneGroup.verdict)
+    {
+      case GoDeadStoneEstimator::VerdictAlive:
+        stoneGroupState = GoStoneGroupStateAlive;
+        break;
+      case GoDeadStoneEstimator::VerdictDead:
+        stoneGroupState = GoStoneGroupStateDead;
+        break;
+      default:
+        continue;
+    }
+    GoBoardCore::Bitboard stones = stoneGroup.stones;
+    while (stones.any())
+      stoneGroupStates[_core->boardIndexOfPosition(stones.removeFirstPosition())] = stoneGroupState;
+  }
+}
+
+// -----------------------------------------------------------------------------
+// Property is documented in the header file.
+// -----------------------------------------------------------------------------
+- (const float*) territoryStatisticsScores
+{
+  return m_territoryStatisticsScores;
+}
+
+// -----------------------------------------------------------------------------
+// Property is documented in the header file.
+// -----------------------------------------------------------------------------
+- (bool) territoryStatisticsScoresAreCurrent
+{
+  return (self.hasTerritoryStatisticsScores
+          && self.territoryStatisticsStoneStateChangeCount == self.stoneStateChangeCount);
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Copies the territory statistics scores in @a scores into the
+/// property @e territoryStatisticsScores. @a scores must have one element per
+/// intersection, in the order defined by indexOfPoint:(). If @a scores is
+/// NULL, all scores are set to zero.
+///
+/// The caller must make sure that @a scores were computed for the stones that
+/// are currently on the board. The scores are considered to be current until
+/// the stone state of an intersection changes.
+// -----------------------------------------------------------------------------
+- (void) updateTerritoryStatisticsScores:(const float*)scores
+{
+  size_t length = _size * _size * sizeof(float);
+  if (scores)
+    memcpy(m_territoryStatisticsScores, scores, length);
+  else
+    memset(m_territoryStatisticsScores, 0, length);
+  self.hasTerritoryStatisticsScores = (NULL != scores);
+  self.territoryStatisticsStoneStateChangeCount = self.stoneStateChangeCount;
+}
+
+// -----------------------------------------------------------------------------
+/// @brief NSCoding protocol method.
+// -----------------------------------------------------------------------------
+- (void) encodeWithCoder:(NSCoder*)encoder
+{
+  [encoder encodeInt:nscodingVersion forKey:nscodingVersionKey];
+  [encoder encodeInt:self.size forKey:goBoardSizeKey];
+  [encoder encodeObject:m_vertexDict forKey:goBoardVertexDictKey];
+  [encoder encodeObject:self.starPoints forKey:goBoardStarPointsKey];
+  [encoder encodeBytes:(const uint8_t*)m_territoryStatisticsScores
+                length:self.size * self.size * sizeof(float)
+                forKey:goBoardTerritoryStatisticsScoresKey];
+}
+
+@end
@@ -0,0 +1,666 @@
+// -----------------------------------------------------------------------------
+// Copyright 2026 Patrick Näf (herzbube@herzbube.ch)
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// -----------------------------------------------------------------------------
+
+
+// Project includes
+#include "GoBoardCore.h"
+
+// System includes
+#include <cstring>
+#include <stdexcept>
+
+
+// -----------------------------------------------------------------------------
+/// @brief Initializes an empty Bitboard.
+// -----------------------------------------------------------------------------
+GoBoardCore::Bitboard::Bitboard()
+{
+  for (int index = 0; index < numberOfWords; ++index)
+    words[index] = 0;
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Returns true if at least one position is in the set.
+// -----------------------------------------------------------------------------
+bool GoBoardCore::Bitboard::any() const
+{
+  for (int index = 0; index < numberOfWords; ++index)
+  {
+    if (words[index])
+      return true;
+  }
+  return false;
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Returns the number of positions in the set.
+// -----------------------------------------------------------------------------
+int GoBoardCore::Bitboard::count() const
+{
+  int count = 0;
+  for (int index = 0; index < numberOfWords; ++index)
+    count += __builtin_popcountll(words[index]);
+  return count;
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Returns the lowest position in the set. Returns -1 if the set is
+/// empty.
+// -----------------------------------------------------------------------------
+int GoBoardCore::Bitboard::firstPosition() const
+{
+  for (int index = 0; index < numberOfWords; ++index)
+  {
+    if (words[index])
+      return (index << 6) + __builtin_ctzll(words[index]);
+  }
+  return -1;
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Removes the lowest position from the set and returns it. Returns -1
+/// if the set is empty.
+// -----------------------------------------------------------------------------
+int GoBoardCore::Bitboard::removeFirstPosition()
+{
+  for (int index = 0; index < numberOfWords; ++index)
+  {
+    if (words[index])
+    {
+      int position = (index << 6) + __builtin_ctzll(words[index]);
+      words[index] &= (words[index] - 1);
+      return position;
+    }
+  }
+  return -1;
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Returns a Bitboard in which every position of this Bitboard is moved
+/// up by @a distance positions. @a distance must be between 1 and 63.
+// -----------------------------------------------------------------------------
+GoBoardCore::Bitboard GoBoardCore::Bitboard::shiftedUp(int distance) const
+{
+  Bitboard result;
+  result.words[0] = words[0] << distance;
+  for (int index = 1; index < numberOfWords; ++index)
+    result.words[index] = (words[index] << distance) | (words[index - 1] >> (64 - distance));
+  return result;
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Returns a Bitboard in which every position of this Bitboard is moved
+/// down by @a distance positions. @a distance must be between 1 and 63.
+// -----------------------------------------------------------------------------
+GoBoardCore::Bitboard GoBoardCore::Bitboard::shiftedDown(int distance) const
+{
+  Bitboard result;
+  for (int index = 0; index < numberOfWords - 1; ++index)
+    result.words[index] = (words[index] >> distance) | (words[index + 1] << (64 - distance));
+  result.words[numberOfWords - 1] = words[numberOfWords - 1] >> distance;
+  return result;
+}
+
+// -----------------------------------------------------------------------------
+/// @brief The bitwise operators of Bitboard work on all words of the Bitboard,
+/// with the usual meaning: @e | is the union, @e & is the intersection, and
+/// @e ~ is the complement of a set of positions.
+// -----------------------------------------------------------------------------
+GoBoardCore::Bitboard& GoBoardCore::Bitboard::operator|=(const Bitboard& other)
+{
+  for (int index = 0; index < numberOfWords; ++index)
+    words[index] |= other.words[index];
+  return *this;
+}
+
+GoBoardCore::Bitboard& GoBoardCore::Bitboard::operator&=(const Bitboard& other)
+{
+  for (int index = 0; index < numberOfWords; ++index)
+    words[index] &= other.words[index];
+  return *this;
+}
+
+GoBoardCore::Bitboard GoBoardCore::Bitboard::operator|(const Bitboard& other) const
+{
+  Bitboard result(*this);
+  result |= other;
+  return result;
+}
+
+GoBoardCore::Bitboard GoBoardCore::Bitboard::operator&(const Bitboard& other) const
+{
+  Bitboard result(*this);
+  result &= other;
+  return result;
+}
+
+GoBoardCore::Bitboard GoBoardCore::Bitboard::operator~() const
+{
+  Bitboard result;
+  for (int index = 0; index < numberOfWords; ++index)
+    result.words[index] = ~words[index];
+  return result;
+}
+
+bool GoBoardCore::Bitboard::operator==(const Bitboard& other) const
+{
+  for (int index = 0; index < numberOfWords; ++index)
+  {
+    if (words[index] != other.words[index])
+      return false;
+  }
+  return true;
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Initializes a GoBoardCore object with size @a boardSize. The board
+/// is initially empty.
+///
+/// Throws std::invalid_argument if @a boardSize is not between
+/// #minimumBoardSize and #maximumBoardSize.
+// -----------------------------------------------------------------------------
+GoBoardCore::GoBoardCore(int boardSize)
+: size(boardSize),
+  positionStride(boardSize + 2)
+{
+  if (boardSize < minimumBoardSize || boardSize > maximumBoardSize)
+    throw std::invalid_argument("GoBoardCore: Board size is out of range");
+  setupTables();
+  clear();
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Private helper for the constructor. Fills the tables that map board
+/// indexes to positions and vice versa, the neighbour table and the Bitboard
+/// with the positions that are on the board.
+// -----------------------------------------------------------------------------
+void GoBoardCore::setupTables()
+{
+  for (int position = 0; position < maximumNumberOfPositions; ++position)
+    boardIndexOfPositionTable[position] = -1;
+
+  for (int boardIndex = 0; boardIndex < size * size; ++boardIndex)
+  {
+    int x = boardIndex % size;
+    int y = boardIndex / size;
+    int position = (y + 1) * positionStride + (x + 1);
+    positionOfBoardIndexTable[boardIndex] = static_cast<int16_t>(position);
+    boardIndexOfPositionTable[position] = static_cast<int16_t>(boardIndex);
+    onBoard.set(position);
+
+    // Same order as GoPoint::neighbours(): left, right, above, below
+    int numberOfNeighbours = 0;
+    if (x > 0)
+      neighbourTable[boardIndex][numberOfNeighbours++] = static_cast<int16_t>(boardIndex - 1);
+    if (x < size - 1)
+      neighbourTable[boardIndex][numberOfNeighbours++] = static_cast<int16_t>(boardIndex + 1);
+    if (y < size - 1)
+      neighbourTable[boardIndex][numberOfNeighbours++] = static_cast<int16_t>(boardIndex + size);
+    if (y > 0)
+      neighbourTable[boardIndex][numberOfNeighbours++] = static_cast<int16_t>(boardIndex - size);
+    numberOfNeighboursTable[boardIndex] = static_cast<uint8_t>(numberOfNeighbours);
+  }
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Removes all stones from the board.
+// -----------------------------------------------------------------------------
+void GoBoardCore::clear()
+{
+  std::memset(colors, ColorBorder, sizeof(colors));
+  for (int boardIndex = 0; boardIndex < size * size; ++boardIndex)
+    colors[positionOfBoardIndexTable[boardIndex]] = ColorNone;
+  for (int position = 0; position < maximumNumberOfPositions; ++position)
+    groupIdOfPosition[position] = -1;
+  blackStones = Bitboard();
+  whiteStones = Bitboard();
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Places a stone of color @a color on the intersection @a boardIndex,
+/// or removes the stone if @a color is #ColorNone. Updates the stone groups
+/// that are affected by the change.
+///
+/// Replacing a stone with a stone of the other color is the same as removing
+/// the stone and then placing the new stone.
+// -----------------------------------------------------------------------------
+void GoBoardCore::setColorAt(int boardIndex, Color color)
+{
+  int position = positionOfBoardIndexTable[boardIndex];
+  if (colors[position] == color)
+    return;
+  if (ColorNone != colors[position])
+    removeStone(position);
+  if (ColorNone != color)
+    placeStone(position, color);
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Private helper for setColorAt(). Places a stone of color @a color on
+/// the empty position @a position.
+// -----------------------------------------------------------------------------
+void GoBoardCore::placeStone(int position, Color color)
+{
+  colors[position] = static_cast<uint8_t>(color);
+  if (ColorBlack == color)
+    blackStones.set(position);
+  else
+    whiteStones.set(position);
+
+  int16_t groupIds[maximumNumberOfNeighbours];
+  int numberOfGroups = neighbourGroups(position, groupIds);
+
+  // Join the largest adjacent friendly group so that as few stones as possible
+  // have to be assigned to a different group
+  int targetGroupId = -1;
+  int targetGroupSize = 0;
+  for (int index = 0; index < numberOfGroups; ++index)
+  {
+    int groupId = groupIds[index];
+    if (colors[positionOfBoardIndexTable[groupId]] != color)
+      continue;
+    int groupSize = groups[groupId].stones.count();
+    if (groupSize > targetGroupSize)
+    {
+      targetGroupId = groupId;
+      targetGroupSize = groupSize;
+    }
+  }
+  if (-1 == targetGroupId)
+  {
+    targetGroupId = boardIndexOfPositionTable[position];
+    groups[targetGroupId].stones = Bitboard();
+    groups[targetGroupId].liberties = Bitboard();
+  }
+  Group& targetGroup = groups[targetGroupId];
+  targetGroup.stones.set(position);
+  groupIdOfPosition[position] = static_cast<int16_t>(targetGroupId);
+
+  for (int index = 0; index < numberOfGroups; ++index)
+  {
+    int groupId = groupIds[index];
+    Group& group = groups[groupId];
+    if (colors[positionOfBoardIndexTable[groupId]] == color)
+    {
+      if (groupId == targetGroupId)
+        continue;
+      targetGroup.stones |= group.stones;
+      targetGroup.liberties |= group.liberties;
+      assignGroup(group.stones, targetGroupId);
+    }
+    else
+    {
+      group.liberties.reset(position);
+      group.numberOfLiberties = group.liberties.count();
+    }
+  }
+
+  int neighbourPositions[maximumNumberOfNeighbours] = { position - 1, position + 1, position - positionStride, position + positionStride };
+  for (int neighbourPosition : neighbourPositions)
+  {
+    if (ColorNone == colors[neighbourPosition])
+      targetGroup.liberties.set(neighbourPosition);
+  }
+  targetGroup.liberties.reset(position);
+  targetGroup.numberOfLiberties = targetGroup.liberties.count();
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Private helper for setColorAt(). Removes the stone on position
+/// @a position.
+// -----------------------------------------------------------------------------
+void GoBoardCore::removeStone(int position)
+{
+  Bitboard remainingStones = groups[groupIdOfPosition[position]].stones;
+  remainingStones.reset(position);
+
+  colors[position] = ColorNone;
+  blackStones.reset(position);
+  whiteStones.reset(position);
+  groupIdOfPosition[position] = -1;
+
+  // The remaining stones may have been split into several groups. The new
+  // groups are identified by the board index of their lowest position.
+  Bitboard empty = emptyPositions();
+  while (remainingStones.any())
+  {
+    int firstPosition = remainingStones.firstPosition();
+    Bitboard subGroupStones = floodFill(firstPosition, remainingStones);
+    int subGroupId = boardIndexOfPositionTable[firstPosition];
+    Group& subGroup = groups[subGroupId];
+    subGroup.stones = subGroupStones;
+    subGroup.liberties = neighbourPositions(subGroupStones) & empty;
+    subGroup.numberOfLiberties = subGroup.liberties.count();
+    assignGroup(subGroupStones, subGroupId);
+    remainingStones &= ~subGroupStones;
+  }
+
+  // The now empty position is a liberty of all adjacent groups. This includes
+  // the sub-groups that were just rebuilt, for these this is a no-op.
+  int16_t groupIds[maximumNumberOfNeighbours];
+  int numberOfGroups = neighbourGroups(position, groupIds);
+  for (int index = 0; index < numberOfGroups; ++index)
+  {
+    Group& group = groups[groupIds[index]];
+    group.liberties.set(position);
+    group.numberOfLiberties = group.liberties.count();
+  }
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Private helper. Fills @a groupIds with the distinct IDs of the
+/// stone groups that are adjacent to position @a position, and returns the
+/// number of IDs.
+// -----------------------------------------------------------------------------
+int GoBoardCore::neighbourGroups(int position, int16_t* groupIds) const
+{
+  int numberOfGroups = 0;
+  int neighbourPositions[maximumNumberOfNeighbours] = { position - 1, position + 1, position - positionStride, position + positionStride };
+  for (int neighbourPosition : neighbourPositions)
+  {
+    int16_t groupId = groupIdOfPosition[neighbourPosition];
+    if (-1 == groupId)
+      continue;
+    bool isDuplicate = false;
+    for (int index = 0; index < numberOfGroups; ++index)
+      isDuplicate = isDuplicate || (groupIds[index] == groupId);
+    if (! isDuplicate)
+      groupIds[numberOfGroups++] = groupId;
+  }
+  return numberOfGroups;
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Private helper. Assigns all positions in @a stones to the group with
+/// ID @a groupId.
+// -----------------------------------------------------------------------------
+void GoBoardCore::assignGroup(const Bitboard& stones, int groupId)
+{
+  Bitboard positions = stones;
+  for (int position = positions.removeFirstPosition(); position != -1; position = positions.removeFirstPosition())
+    groupIdOfPosition[position] = static_cast<int16_t>(groupId);
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Private helper. Returns the positions in @a area that are connected
+/// to position @a position, which must be in @a area.
+// -----------------------------------------------------------------------------
+GoBoardCore::Bitboard GoBoardCore::floodFill(int position, const Bitboard& area) const
+{
+  Bitboard filled;
+  filled.set(position);
+  while (true)
+  {
+    Bitboard grown = neighbourPositions(filled) & area;
+    if (grown == filled)
+      return filled;
+    filled = grown;
+  }
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Returns the number of neighbours of the intersection @a boardIndex
+/// that are not occupied by a stone.
+// -----------------------------------------------------------------------------
+int GoBoardCore::numberOfEmptyNeighbours(int boardIndex) const
+{
+  int position = positionOfBoardIndexTable[boardIndex];
+  return ((ColorNone == colors[position - 1]) +
+          (ColorNone == colors[position + 1]) +
+          (ColorNone == colors[position - positionStride]) +
+          (ColorNone == colors[position + positionStride]));
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Returns the positions occupied by stones of color @a color. @a color
+/// must be either #ColorBlack or #ColorWhite.
+// -----------------------------------------------------------------------------
+const GoBoardCore::Bitboard& GoBoardCore::stones(Color color) const
+{
+  return (ColorBlack == color) ? blackStones : whiteStones;
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Returns the positions on the board that are not occupied by a stone.
+// -----------------------------------------------------------------------------
+GoBoardCore::Bitboard GoBoardCore::emptyPositions() const
+{
+  return onBoard & ~(blackStones | whiteStones);
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Returns the positions on the board that are either in @a positions,
+/// or that are neighbours of a position in @a positions.
+// -----------------------------------------------------------------------------
+GoBoardCore::Bitboard GoBoardCore::neighbourPositions(const Bitboard& positions) const
+{
+  Bitboard result = positions;
+  result |= positions.shiftedUp(1);
+  result |= positions.shiftedDown(1);
+  result |= positions.shiftedUp(positionStride);
+  result |= positions.shiftedDown(positionStride);
+  result &= onBoard;
+  return result;
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Returns the positions of the intersections that are connected to the
+/// intersection @a boardIndex and that have the same color. If the
+/// intersection is occupied by a stone, the result is a stone group. If the
+/// intersection is empty, the result is an area of empty intersections.
+// -----------------------------------------------------------------------------
+GoBoardCore::Bitboard GoBoardCore::groupAt(int boardIndex) const
+{
+  int position = positionOfBoardIndexTable[boardIndex];
+  if (ColorNone == colors[position])
+    return floodFill(position, emptyPositions());
+  return groups[groupIdOfPosition[position]].stones;
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Returns the liberties of the stone group that the stone on the
+/// intersection @a boardIndex belongs to. Returns an empty Bitboard if the
+/// intersection is empty.
+// -----------------------------------------------------------------------------
+GoBoardCore::Bitboard GoBoardCore::libertiesOfGroupAt(int boardIndex) const
+{
+  int position = positionOfBoardIndexTable[boardIndex];
+  if (ColorNone == colors[position])
+    return Bitboard();
+  return groups[groupIdOfPosition[position]].liberties;
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Returns the number of liberties of the stones in @a group, i.e. the
+/// number of distinct empty intersections adjacent to the stones.
+// -----------------------------------------------------------------------------
+int GoBoardCore::numberOfLiberties(const Bitboard& group) const
+{
+  return (neighbourPositions(group) & emptyPositions()).count();
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Returns the number of liberties of the stone group that the stone on
+/// the intersection @a boardIndex belongs to. Returns the number of empty
+/// neighbours if the intersection is empty.
+// -----------------------------------------------------------------------------
+int GoBoardCore::numberOfLibertiesOfGroupAt(int boardIndex) const
+{
+  int position = positionOfBoardIndexTable[boardIndex];
+  if (ColorNone == colors[position])
+    return numberOfEmptyNeighbours(boardIndex);
+  return groups[groupIdOfPosition[position]].numberOfLiberties;
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Returns true if the intersection @a boardIndex is occupied by a
+/// stone whose stone group has exactly one liberty.
+// -----------------------------------------------------------------------------
+bool GoBoardCore::isInAtari(int boardIndex) const
+{
+  int position = positionOfBoardIndexTable[boardIndex];
+  if (ColorNone == colors[position])
+    return false;
+  return (1 == groups[groupIdOfPosition[position]].numberOfLiberties);
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Returns true if placing a stone of color @a color on the empty
+/// intersection @a boardIndex would capture at least one stone group of the
+/// opposing color.
+// -----------------------------------------------------------------------------
+bool GoBoardCore::isCapture(int boardIndex, Color color) const
+{
+  Color opponentColor = (ColorBlack == color) ? ColorWhite : ColorBlack;
+  const int16_t* neighbourIndexes = neighbourTable[boardIndex];
+  for (int index = 0; index < numberOfNeighboursTable[boardIndex]; ++index)
+  {
+    int neighbourIndex = neighbourIndexes[index];
+    if (colorAt(neighbourIndex) != opponentColor)
+      continue;
+    // The intersection on which the stone is placed is still empty, so it is
+    // one of the liberties that we count
+    if (1 == numberOfLibertiesOfGroupAt(neighbourIndex))
+      return true;
+  }
+  return false;
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Returns true if placing a stone of color @a color on the empty
+/// intersection @a boardIndex would be suicide, i.e. if the stone group that
+/// the new stone becomes part of would have no liberties, and the new stone
+/// would not capture any stones. Does not check for ko.
+// -----------------------------------------------------------------------------
+bool GoBoardCore::isSuicide(int boardIndex, Color color) const
+{
+  if (numberOfEmptyNeighbours(boardIndex) > 0)
+    return false;
+
+  const int16_t* neighbourIndexes = neighbourTable[boardIndex];
+  for (int index = 0; index < numberOfNeighboursTable[boardIndex]; ++index)
+  {
+    int neighbourIndex = neighbourIndexes[index];
+    // A friendly group that has a liberty in addition to the intersection on
+    // which the stone is placed survives the connection
+    if (colorAt(neighbourIndex) == color && numberOfLibertiesOfGroupAt(neighbourIndex) > 1)
+      return false;
+  }
+  return ! isCapture(boardIndex, color);
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Classifies the moves of color @a color on all empty intersections at
+/// once. Fills @a suicidePositions with the positions on which a stone would
+/// be suicide, and @a capturePositions with the positions on which a stone
+/// would capture at least one stone group of the opposing color. Does not
+/// check for ko.
+///
+/// The result is the same as invoking isSuicide() and isCapture() for every
+/// empty intersection, but each stone group is visited only once:
+/// - A move captures if it fills the last liberty of an opposing group.
+/// - A move is not suicide if the intersection has an empty neighbour, if the
+///   move captures, or if it fills a liberty of a friendly group that has
+///   other liberties.
+// -----------------------------------------------------------------------------
+void GoBoardCore::analyzeMoves(Color color, Bitboard& suicidePositions, Bitboard& capturePositions) const
+{
+  Color opponentColor = (ColorBlack == color) ? ColorWhite : ColorBlack;
+
+  capturePositions = Bitboard();
+  Bitboard remainingStones = stones(opponentColor);
+  while (remainingStones.any())
+  {
+    const Group& group = groups[groupIdOfPosition[remainingStones.firstPosition()]];
+    if (1 == group.numberOfLiberties)
+      capturePositions |= group.liberties;
+    remainingStones &= ~group.stones;
+  }
+
+  Bitboard connectingPositions;
+  remainingStones = stones(color);
+  while (remainingStones.any())
+  {
+    const Group& group = groups[groupIdOfPosition[remainingStones.firstPosition()]];
+    if (group.numberOfLiberties > 1)
+      connectingPositions |= group.liberties;
+    remainingStones &= ~group.stones;
+  }
+
+  // neighbourPositions() would include the empty positions themselves, so we
+  // shift on our own
+  Bitboard empty = emptyPositions();
+  Bitboard safePositions = capturePositions | connectingPositions;
+  safePositions |= empty.shiftedUp(1);
+  safePositions |= empty.shiftedDown(1);
+  safePositions |= empty.shiftedUp(positionStride);
+  safePositions |= empty.shiftedDown(positionStride);
+  suicidePositions = empty & ~safePositions;
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Returns the stones that placing a stone of color @a color on the
+/// empty intersection @a boardIndex would capture. Returns an empty bitboard
+/// if the move would not capture anything.
+// -----------------------------------------------------------------------------
+GoBoardCore::Bitboard GoBoardCore::capturedStones(int boardIndex, Color color) const
+{
+  Color opponentColor = (ColorBlack == color) ? ColorWhite : ColorBlack;
+  Bitboard captured;
+  const int16_t* neighbourIndexes = neighbourTable[boardIndex];
+  for (int index = 0; index < numberOfNeighboursTable[boardIndex]; ++index)
+  {
+    int neighbourPosition = positionOfBoardIndexTable[neighbourIndexes[index]];
+    if (colors[neighbourPosition] != opponentColor)
+      continue;
+    const Group& group = groups[groupIdOfPosition[neighbourPosition]];
+    if (1 == group.numberOfLiberties)
+      captured |= group.stones;
+  }
+  return captured;
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Returns true if the incrementally maintained stone groups match the
+/// stone groups that a flood fill of the current stones yields. This is
+/// expensive and intended for tests.
+// -----------------------------------------------------------------------------
+bool GoBoardCore::hasConsistentGroups() const
+{
+  Bitboard empty = emptyPositions();
+  Bitboard allStones = blackStones | whiteStones;
+  for (int boardIndex = 0; boardIndex < size * size; ++boardIndex)
+  {
+    int position = positionOfBoardIndexTable[boardIndex];
+    int groupId = groupIdOfPosition[position];
+    if (! allStones.test(position))
+    {
+      if (-1 != groupId)
+        return false;
+      continue;
+    }
+    if (-1 == groupId)
+      return false;
+    const Group& group = groups[groupId];
+    Bitboard expectedStones = floodFill(position, stones(static_cast<Color>(colors[position])));
+    if (group.stones != expectedStones)
+      return false;
+    Bitboard expectedLiberties = neighbourPositions(expectedStones) & empty;
+    if (group.liberties != expectedLiberties || group.numberOfLiberties != expectedLiberties.count())
+      return false;
+  }
+  return true;
+}
@@ -0,0 +1,192 @@
+// -----------------------------------------------------------------------------
+// Copyright 2026 Patrick Näf (herzbube@herzbube.ch)
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// -----------------------------------------------------------------------------
+
+
+#pragma once
+
+// System includes
+#include <cstdint>
+
+// -----------------------------------------------------------------------------
+/// @brief The GoBoardCore class stores the stones on a Go board in a compact,
+/// cache-friendly layout and answers queries about stones, neighbours, stone
+/// groups and liberties.
+///
+/// @ingroup go
+///
+/// GoBoardCore is the storage behind GoBoard and GoPoint. GoPoint objects do
+/// not store their stone state themselves, they read it from and write it to
+/// the GoBoardCore object that belongs to their GoBoard. GoBoardCore is plain
+/// C++ and does not depend on Foundation.
+///
+/// Intersections are identified by a board index. The board index uses the
+/// order that GoBoard::indexOfPoint:() defines: The intersection A1 has index
+/// 0, the index increases from left to right, then from bottom to top.
+///
+/// Internally GoBoardCore uses a padded layout: The board is surrounded by a
+/// border that is one intersection wide, and the rows of the padded board are
+/// stored one after the other in a 1-dimensional array. A location in this
+/// array is called a position. Positions on the border hold the sentinel color
+/// #ColorBorder. Because of the border, the 4 neighbours of an intersection
+/// are always at the positions +1, -1, +stride and -stride, without range
+/// checks.
+///
+/// In addition to the array with one color per position, GoBoardCore keeps
+/// one Bitboard per stone color. Flood fills, i.e. the determination of stone
+/// groups, and liberty counts operate on these bitboards one 64-bit word at a
+/// time instead of one intersection at a time.
+///
+/// GoBoardCore also keeps track of stone groups incrementally. Every stone
+/// group has a Bitboard with its stones and a Bitboard with its liberties, and
+/// every position that is occupied by a stone knows the group it belongs to.
+/// setColorAt() updates this information for the groups that are affected by
+/// the change:
+/// - Placing a stone merges the stone with the adjacent friendly groups, and
+///   removes a liberty from the adjacent opposing groups.
+/// - Removing a stone adds a liberty to the adjacent groups, and rebuilds the
+///   remaining stones of the stone's group, which may have been split into
+///   several groups.
+/// As a result, liberty and atari queries for stone groups are O(1), and only
+/// the removal of stones, which is much rarer than the placing of stones,
+/// requires a flood fill.
+///
+/// Finally, GoBoardCore precomputes a neighbour table that lists for each
+/// board index the board indexes of its neighbours.
+// -----------------------------------------------------------------------------
+class GoBoardCore
+{
+public:
+  /// @brief Enumerates the values that a position can have. The values of
+  /// #ColorNone, #ColorBlack and #ColorWhite match the values of the
+  /// corresponding #GoColor enumeration values.
+  enum Color
+  {
+    ColorNone = 0,
+    ColorBlack = 1,
+    ColorWhite = 2,
+    ColorBorder = 3  ///< @brief Sentinel for positions outside the board.
+  };
+
+  static const int minimumBoardSize = 7;
+  static const int maximumBoardSize = 19;
+  static const int maximumStride = maximumBoardSize + 2;
+  static const int maximumNumberOfPositions = maximumStride * maximumStride;
+  static const int maximumNumberOfIntersections = maximumBoardSize * maximumBoardSize;
+  static const int maximumNumberOfNeighbours = 4;
+
+  // ---------------------------------------------------------------------------
+  /// @brief The Bitboard class is a set of positions with one bit per
+  /// position. It is large enough for the padded layout of the largest
+  /// supported board.
+  // ---------------------------------------------------------------------------
+  class Bitboard
+  {
+  public:
+    static const int numberOfWords = (maximumNumberOfPositions + 63) / 64;
+
+    Bitboard();
+
+    void set(int position) { words[position >> 6] |= (uint64_t(1) << (position & 63)); }
+    void reset(int position) { words[position >> 6] &= ~(uint64_t(1) << (position & 63)); }
+    bool test(int position) const { return 0 != (words[position >> 6] & (uint64_t(1) << (position & 63))); }
+
+    bool any() const;
+    int count() const;
+    int firstPosition() const;
+    int removeFirstPosition();
+
+    Bitboard shiftedUp(int distance) const;
+    Bitboard shiftedDown(int distance) const;
+
+    Bitboard& operator|=(const Bitboard& other);
+    Bitboard& operator&=(const Bitboard& other);
+    Bitboard operator|(const Bitboard& other) const;
+    Bitboard operator&(const Bitboard& other) const;
+    Bitboard operator~() const;
+    bool operator==(const Bitboard& other) const;
+    bool operator!=(const Bitboard& other) const { return ! (*this == other); }
+
+  private:
+    uint64_t words[numberOfWords];
+  };
+
+  explicit GoBoardCore(int boardSize);
+
+  int boardSize() const { return size; }
+  int numberOfIntersections() const { return size * size; }
+  int stride() const { return positionStride; }
+
+  int positionOfBoardIndex(int boardIndex) const { return positionOfBoardIndexTable[boardIndex]; }
+  int boardIndexOfPosition(int position) const { return boardIndexOfPositionTable[position]; }
+
+  Color colorAt(int boardIndex) const { return static_cast<Color>(colors[positionOfBoardIndexTable[boardIndex]]); }
+  void setColorAt(int boardIndex, Color color);
+  void clear();
+
+  int numberOfNeighbours(int boardIndex) const { return numberOfNeighboursTable[boardIndex]; }
+  const int16_t* neighbours(int boardIndex) const { return neighbourTable[boardIndex]; }
+  int numberOfEmptyNeighbours(int boardIndex) const;
+
+  const Bitboard& onBoardPositions() const { return onBoard; }
+  const Bitboard& stones(Color color) const;
+  Bitboard emptyPositions() const;
+  Bitboard neighbourPositions(const Bitboard& positions) const;
+
+  Bitboard groupAt(int boardIndex) const;
+  Bitboard libertiesOfGroupAt(int boardIndex) const;
+  int numberOfLiberties(const Bitboard& group) const;
+  int numberOfLibertiesOfGroupAt(int boardIndex) const;
+  bool isInAtari(int boardIndex) const;
+  bool isCapture(int boardIndex, Color color) const;
+  bool isSuicide(int boardIndex, Color color) const;
+  void analyzeMoves(Color color, Bitboard& suicidePositions, Bitboard& capturePositions) const;
+  Bitboard capturedStones(int boardIndex, Color color) const;
+  bool hasConsistentGroups() const;
+
+private:
+  /// @brief A stone group. The group is identified by the board index of one
+  /// of its stones.
+  struct Group
+  {
+    Bitboard stones;
+    Bitboard liberties;
+    int numberOfLiberties;
+  };
+
+  void setupTables();
+  void placeStone(int position, Color color);
+  void removeStone(int position);
+  int neighbourGroups(int position, int16_t* groupIds) const;
+  void assignGroup(const Bitboard& stones, int groupId);
+  Bitboard floodFill(int position, const Bitboard& area) const;
+
+  int size;
+  int positionStride;
+  uint8_t colors[maximumNumberOfPositions];
+  Bitboard onBoard;
+  Bitboard blackStones;
+  Bitboard whiteStones;
+  int16_t positionOfBoardIndexTable[maximumNumberOfIntersections];
+  int16_t boardIndexOfPositionTable[maximumNumberOfPositions];
+  int16_t neighbourTable[maximumNumberOfIntersections][maximumNumberOfNeighbours];
+  uint8_t numberOfNeighboursTable[maximumNumberOfIntersections];
+  /// @brief The group ID for each position that is occupied by a stone, -1 for
+  /// all other positions.
+  int16_t groupIdOfPosition[maximumNumberOfPositions];
+  /// @brief Indexed by group ID. Only the elements whose ID is in use by
+  /// groupIdOfPosition are valid.
+  Group groups[maximumNumberOfIntersections];
+};
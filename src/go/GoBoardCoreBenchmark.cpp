@@ -0,0 +1,92 @@
+// -----------------------------------------------------------------------------
+// Copyright 2026 Patrick Näf (herzbube@herzbube.ch)
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// -----------------------------------------------------------------------------
+
+
+// Project includes
+#include "GoBoardCore.h"
+
+// System includes
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+
+// Global constants
+static const int DEFAULTNUMBEROFITERATIONS = 1000000;
+static const int NUMBEROFRUNS = 5;
+
+
+// -----------------------------------------------------------------------------
+/// @brief Places and removes random stones on a 19x19 GoBoardCore and counts
+/// the liberties of the affected stone groups. Performs the same work as
+/// GoBoardCoreTest::testPerformanceGoBoardCoreLiberties(). Returns the sum of
+/// the liberties, so that the compiler cannot optimize the work away.
+// -----------------------------------------------------------------------------
+static long long placeStonesAndCountLiberties(GoBoardCore& core, int numberOfIterations)
+{
+  std::mt19937 randomNumberGenerator(42);
+  long long sumOfLiberties = 0;
+  for (int iteration = 0; iteration < numberOfIterations; ++iteration)
+  {
+    int index = randomNumberGenerator() % core.numberOfIntersections();
+    core.setColorAt(index, static_cast<GoBoardCore::Color>(randomNumberGenerator() % 3));
+    sumOfLiberties += core.numberOfLibertiesOfGroupAt(index);
+  }
+  return sumOfLiberties;
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Standalone benchmark driver for GoBoardCore. Does not depend on
+/// Foundation or XCTest, so it can be built and run on any platform with a
+/// C++ compiler, e.g. to profile GoBoardCore on Linux. See the Makefile in
+/// this folder for build instructions.
+///
+/// Usage: GoBoardCoreBenchmark [number of iterations]
+///
+/// Runs the benchmark several times and prints the time per iteration of each
+/// run. Exits with a non-zero status if the incremental group tracking of
+/// GoBoardCore is inconsistent at the end of a run.
+// -----------------------------------------------------------------------------
+int main(int argc, char** argv)
+{
+  int numberOfIterations = DEFAULTNUMBEROFITERATIONS;
+  if (argc > 1)
+    numberOfIterations = std::atoi(argv[1]);
+  if (numberOfIterations <= 0)
+  {
+    std::fprintf(stderr, "Usage: %s [number of iterations]\n", argv[0]);
+    return 1;
+  }
+
+  for (int run = 1; run <= NUMBEROFRUNS; ++run)
+  {
+    GoBoardCore core(19);
+    auto startTime = std::chrono::steady_clock::now();
+    long long sumOfLiberties = placeStonesAndCountLiberties(core, numberOfIterations);
+    auto endTime = std::chrono::steady_clock::now();
+
+    double nanosecondsPerIteration = std::chrono::duration<double, std::nano>(endTime - startTime).count() / numberOfIterations;
+    std::printf("Run %d: %d iterations, %.1f ns/iteration (sum of liberties %lld)\n",
+                run, numberOfIterations, nanosecondsPerIteration, sumOfLiberties);
+
+    if (! core.hasConsistentGroups())
+    {
+      std::fprintf(stderr, "GoBoardCore has inconsistent stone groups after run %d\n", run);
+      return 1;
+    }
+  }
+  return 0;
+}
@@ -16,6 +16,7 @@
 
 
 // Forward declarations
+@class GoBoardPositionChange;
 @class GoGame;
 @class GoMove;
 @class GoPlayer;
@@ -79,9 +80,35 @@
 /// the client that triggers the change may wish to display a progress meter to
 /// indicate to the user that the operation is still running. The client in this
 /// case can observe the default notification center for the notification
-/// #boardPositionChangeProgress. The notification is sent (B-A) times for a
-/// board position change from A to B. Note that KVO observers of
+/// #boardPositionChangeProgress. The notification is not sent for each move
+/// that is replayed or undone, instead it is sent at most every 100
+/// milliseconds while the change is running. A short change may therefore
+/// not send the notification at all. Note that KVO observers of
 /// @e currentBoardPosition will still be notified just once.
+///
+/// Before KVO observers of @e currentBoardPosition are notified, the
+/// @e lastChange property is updated with a GoBoardPositionChange object that
+/// summarizes how the stones on the board have changed. Observers that display
+/// the board can use this to update only the intersections that have actually
+/// changed, instead of processing each intermediate board position or redrawing
+/// the entire board.
+///
+///
+/// @par Checkpoints
+///
+/// Changing the board position normally replays or undoes every move between
+/// the old and the new board position. To make jumps over long distances
+/// cheaper, GoBoardPosition takes a GoBoardSnapshot every K moves when the
+/// board reaches such a board position, either by navigation or by regular
+/// play. When the board position changes, GoBoardPosition restores the
+/// checkpoint nearest to the new board position if this is expected to be
+/// cheaper than replaying all moves from the current board position, and then
+/// replays at most K moves.
+///
+/// The number of checkpoints is bounded. If a game grows so long that the
+/// bound would be exceeded, K is doubled and every other checkpoint is
+/// discarded. Checkpoints after the last move are discarded when moves are
+/// discarded. Checkpoints are not archived.
 // -----------------------------------------------------------------------------
 @interface GoBoardPosition : NSObject
 {
@@ -114,5 +141,13 @@
 /// @brief The number of board positions in the GoGame associated with this
 /// GoBoardPosition.
 @property(nonatomic, assign, readonly) int numberOfBoardPositions;
+/// @brief Describes how the stones on the board have changed during the most
+/// recent change of @e currentBoardPosition. Is nil if no change has happened
+/// yet, or if the most recent change could not be described (e.g. because the
+/// board position was adjusted after moves were discarded).
+///
+/// This property is updated before KVO observers of @e currentBoardPosition
+/// are notified. It is not observable itself.
+@property(nonatomic, retain, readonly) GoBoardPositionChange* lastChange;
 
 @end
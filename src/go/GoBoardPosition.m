@@ -17,13 +17,29 @@
 
 // Project includes
 #import "GoBoardPosition.h"
+#import "../go/GoBoard.h"
+#import "../go/GoBoardPositionChange.h"
+#import "../go/GoBoardSnapshot.h"
 #import "../go/GoGame.h"
 #import "../go/GoMove.h"
 #import "../go/GoMoveModel.h"
 #import "../go/GoPlayer.h"
+#import "../go/GoPoint.h"
 #import "../go/GoUtilities.h"
 #import "../player/Player.h"
 
+/// @brief The initial distance in moves between two checkpoints.
+static const int initialCheckpointInterval = 20;
+/// @brief The maximum number of checkpoints that GoBoardPosition keeps. This
+/// bounds the memory used by checkpoints.
+static const int maximumNumberOfCheckpoints = 32;
+/// @brief The estimated cost of restoring a checkpoint, expressed as the number
+/// of moves that could be played in the same time.
+static const int checkpointRestoreCost = 20;
+/// @brief The minimum time in seconds that must elapse between two
+/// #boardPositionChangeProgress notifications.
+static const CFTimeInterval progressNotificationInterval = 0.1;
+
 
 // -----------------------------------------------------------------------------
 /// @brief Class extension with private properties for GoBoardPosition.
@@ -32,10 +48,26 @@
 /// @name Private properties
 //@{
 @property(nonatomic, assign) GoGame* game;
+/// @brief GoBoardSnapshot objects taken in regular intervals, see the section
+/// "Checkpoints" in the class documentation. Keys are board positions (NSNumber
+/// objects), values are GoBoardSnapshot objects.
+@property(nonatomic, retain) NSMutableDictionary* checkpoints;
+/// @brief The distance in moves between two checkpoints.
+@property(nonatomic, assign) int checkpointInterval;
+/// @brief The number of moves that the board position change in progress has
+/// to replay or undo.
+@property(nonatomic, assign) int numberOfMovesInProgress;
+/// @brief The number of moves that the board position change in progress has
+/// already replayed or undone.
+@property(nonatomic, assign) int numberOfMovesDone;
+/// @brief The time when the last #boardPositionChangeProgress notification
+/// was posted, or when the board position change started.
+@property(nonatomic, assign) CFTimeInterval lastProgressNotificationTime;
 //@}
 /// @name Re-declaration of properties to make them readwrite privately
 //@{
 @property(nonatomic, assign, readwrite) int numberOfBoardPositions;
+@property(nonatomic, retain, readwrite) GoBoardPositionChange* lastChange;
 //@}
 @end
 
@@ -57,6 +89,7 @@
   self.game = aGame;
   _currentBoardPosition = 0;  // don't use self to avoid the setter
   _numberOfBoardPositions = self.game.moveModel.numberOfMoves + 1;
+  [self setupCheckpoints];
   [self setupKVOObserving];
   return self;
 }
@@ -75,6 +108,7 @@
   // Don't use self, otherwise we trigger the setter!
   _currentBoardPosition = [decoder decodeIntForKey:goBoardPositionCurrentBoardPositionKey];
   self.numberOfBoardPositions = [decoder decodeIntForKey:goBoardPositionNumberOfBoardPositionsKey];
+  [self setupCheckpoints];
   [self setupKVOObserving];
   return self;
 }
@@ -86,9 +120,23 @@
 {
   [self.game.moveModel removeObserver:self forKeyPath:@"numberOfMoves"];
   self.game = nil;
+  self.checkpoints = nil;
+  self.lastChange = nil;
   [super dealloc];
 }
 
+// -----------------------------------------------------------------------------
+/// @brief Private helper for the initializer.
+///
+/// Checkpoints are not archived, they are taken again as the board position
+/// changes.
+// -----------------------------------------------------------------------------
+- (void) setupCheckpoints
+{
+  self.checkpoints = [NSMutableDictionary dictionaryWithCapacity:0];
+  self.checkpointInterval = initialCheckpointInterval;
+}
+
 // -----------------------------------------------------------------------------
 /// @brief Private helper for the initializer.
 // -----------------------------------------------------------------------------
@@ -119,8 +167,19 @@
     @throw exception;
   }
 
+  GoBoard* board = self.game.board;
+  int numberOfIntersections = board.size * board.size;
+  enum GoColor* oldStoneStates = (enum GoColor*)malloc(numberOfIntersections * sizeof(enum GoColor));
+  for (int index = 0; index < numberOfIntersections; ++index)
+    oldStoneStates[index] = [board stoneStateAtIndex:index];
+
+  int oldBoardPosition = _currentBoardPosition;
   [self updateGoObjectsToNewPosition:newBoardPosition];
   _currentBoardPosition = newBoardPosition;
+  self.lastChange = [self changeFromBoardPosition:oldBoardPosition
+                                  toBoardPosition:newBoardPosition
+                                   oldStoneStates:oldStoneStates];
+  free(oldStoneStates);
   if (self.game.alternatingPlay)
     self.game.nextMoveColor = [GoUtilities playerAfter:self.currentMove inGame:self.game].color;
 }
@@ -130,27 +189,217 @@
 // -----------------------------------------------------------------------------
 - (void) updateGoObjectsToNewPosition:(int)newBoardPosition
 {
-  NSNotificationCenter* center = [NSNotificationCenter defaultCenter];
+  int startBoardPosition = [self restoreCheckpointNearBoardPosition:newBoardPosition];
+  self.numberOfMovesInProgress = abs(newBoardPosition - startBoardPosition);
+  self.numberOfMovesDone = 0;
+  self.lastProgressNotificationTime = CACurrentMediaTime();
+  if (newBoardPosition > startBoardPosition)
+    [self redoMovesFromBoardPosition:startBoardPosition toBoardPosition:newBoardPosition];
+  else
+    [self undoMovesFromBoardPosition:startBoardPosition toBoardPosition:newBoardPosition];
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Invokes GoMove::doIt() for all moves after board position
+/// @a fromBoardPosition up to and including the move of board position
+/// @a toBoardPosition. Takes a checkpoint whenever a board position is reached
+/// on which a checkpoint is due.
+///
+/// This is a private helper for updateGoObjectsToNewPosition:().
+// -----------------------------------------------------------------------------
+- (void) redoMovesFromBoardPosition:(int)fromBoardPosition toBoardPosition:(int)toBoardPosition
+{
   GoMoveModel* moveModel = self.game.moveModel;
-  int indexOfTargetMove = newBoardPosition - 1;
-  int indexOfCurrentMove = self.currentBoardPosition - 1;
-  if (newBoardPosition > self.currentBoardPosition)
+  for (int boardPosition = fromBoardPosition + 1; boardPosition <= toBoardPosition; ++boardPosition)
+  {
+    GoMove* move = [moveModel moveAtIndex:boardPosition - 1];
+    [move doIt];
+    [self takeCheckpointIfDueAtBoardPosition:boardPosition];
+    [self postProgressNotificationIfDue];
+  }
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Invokes GoMove::undo() for all moves from the move of board position
+/// @a fromBoardPosition down to, but excluding, the move of board position
+/// @a toBoardPosition.
+///
+/// This is a private helper for updateGoObjectsToNewPosition:().
+// -----------------------------------------------------------------------------
+- (void) undoMovesFromBoardPosition:(int)fromBoardPosition toBoardPosition:(int)toBoardPosition
+{
+  GoMoveModel* moveModel = self.game.moveModel;
+  for (int boardPosition = fromBoardPosition; boardPosition > toBoardPosition; --boardPosition)
+  {
+    GoMove* move = [moveModel moveAtIndex:boardPosition - 1];
+    [move undo];
+    [self postProgressNotificationIfDue];
+  }
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Counts one more move as done and posts the
+/// #boardPositionChangeProgress notification if enough time has elapsed since
+/// the last notification was posted.
+///
+/// Posting the notification for every move would make observers update their
+/// progress meter far more often than the user can see, and would cost more
+/// time than replaying the move itself on a board with checkpoints.
+///
+/// This is a private helper for redoMovesFromBoardPosition:toBoardPosition:()
+/// and undoMovesFromBoardPosition:toBoardPosition:().
+// -----------------------------------------------------------------------------
+- (void) postProgressNotificationIfDue
+{
+  self.numberOfMovesDone++;
+  CFTimeInterval now = CACurrentMediaTime();
+  if (now - self.lastProgressNotificationTime < progressNotificationInterval)
+    return;
+  self.lastProgressNotificationTime = now;
+  float progress = (float)self.numberOfMovesDone / self.numberOfMovesInProgress;
+  [[NSNotificationCenter defaultCenter] postNotificationName:boardPositionChangeProgress
+                                                      object:[NSNumber numberWithFloat:progress]];
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Returns a change record that describes how the stones on the board
+/// changed when the board position changed from @a oldBoardPosition to
+/// @a newBoardPosition. @a oldStoneStates contains the stone states of all
+/// intersections before the change, in the order defined by
+/// GoBoard::indexOfPoint:().
+///
+/// This is a private helper for setCurrentBoardPosition:().
+// -----------------------------------------------------------------------------
+- (GoBoardPositionChange*) changeFromBoardPosition:(int)oldBoardPosition
+                                   toBoardPosition:(int)newBoardPosition
+                                    oldStoneStates:(const enum GoColor*)oldStoneStates
+{
+  NSMutableArray* placedStones = [NSMutableArray arrayWithCapacity:0];
+  NSMutableArray* removedStones = [NSMutableArray arrayWithCapacity:0];
+  NSMutableArray* recoloredStones = [NSMutableArray arrayWithCapacity:0];
+  GoBoard* board = self.game.board;
+  int numberOfIntersections = board.size * board.size;
+  for (int index = 0; index < numberOfIntersections; ++index)
+  {
+    enum GoColor oldStoneState = oldStoneStates[index];
+    enum GoColor newStoneState = [board stoneStateAtIndex:index];
+    if (oldStoneState == newStoneState)
+      continue;
+    GoPoint* point = [board pointAtIndex:index];
+    if (GoColorNone == oldStoneState)
+      [placedStones addObject:point];
+    else if (GoColorNone == newStoneState)
+      [removedStones addObject:point];
+    else
+      [recoloredStones addObject:point];
+  }
+  return [[[GoBoardPositionChange alloc] initWithOldBoardPosition:oldBoardPosition
+                                                 newBoardPosition:newBoardPosition
+                                                     placedStones:placedStones
+                                                    removedStones:removedStones
+                                                  recoloredStones:recoloredStones] autorelease];
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Restores the checkpoint that is closest to @a newBoardPosition, if
+/// doing so and replaying the moves between the checkpoint and
+/// @a newBoardPosition is expected to be cheaper than replaying the moves
+/// between the current board position and @a newBoardPosition. Returns the
+/// board position that the Go objects are in after this method returns, i.e.
+/// either the board position of the restored checkpoint, or the current board
+/// position if no checkpoint was restored.
+///
+/// The cost of replaying is estimated from the number of moves to replay.
+/// Undoing moves after a checkpoint was restored is estimated to cost twice as
+/// much as redoing moves, because GoMove::undo() can no longer use the region
+/// journal that GoMove::doIt() recorded.
+///
+/// This is a private helper for updateGoObjectsToNewPosition:().
+// -----------------------------------------------------------------------------
+- (int) restoreCheckpointNearBoardPosition:(int)newBoardPosition
+{
+  int currentBoardPosition = self.currentBoardPosition;
+  int bestBoardPosition = currentBoardPosition;
+  int bestCost = abs(newBoardPosition - currentBoardPosition);
+
+  int checkpointInterval = self.checkpointInterval;
+  int checkpointBefore = (newBoardPosition / checkpointInterval) * checkpointInterval;
+  int checkpointAfter = checkpointBefore + checkpointInterval;
+  if ([self.checkpoints objectForKey:[NSNumber numberWithInt:checkpointBefore]])
   {
-    for (int indexOfMove = indexOfCurrentMove + 1; indexOfMove <= indexOfTargetMove; ++indexOfMove)
+    int cost = checkpointRestoreCost + (newBoardPosition - checkpointBefore);
+    if (cost < bestCost)
     {
-      GoMove* move = [moveModel moveAtIndex:indexOfMove];
-      [move doIt];
-      [center postNotificationName:boardPositionChangeProgress object:nil];
+      bestBoardPosition = checkpointBefore;
+      bestCost = cost;
     }
   }
-  else
+  if ([self.checkpoints objectForKey:[NSNumber numberWithInt:checkpointAfter]])
+  {
+    int cost = checkpointRestoreCost + 2 * (checkpointAfter - newBoardPosition);
+    if (cost < bestCost)
+    {
+      bestBoardPosition = checkpointAfter;
+      bestCost = cost;
+    }
+  }
+
+  if (bestBoardPosition != currentBoardPosition)
+  {
+    GoBoardSnapshot* checkpoint = [self.checkpoints objectForKey:[NSNumber numberWithInt:bestBoardPosition]];
+    [checkpoint restoreBoard:self.game.board];
+  }
+  return bestBoardPosition;
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Takes a checkpoint of the board in its current state, which must
+/// correspond to @a boardPosition, if @a boardPosition is a checkpoint
+/// position and no checkpoint exists yet for it.
+///
+/// If taking the checkpoint would exceed the maximum number of checkpoints,
+/// the checkpoint interval is doubled and the checkpoints that are no longer
+/// on a checkpoint position are discarded.
+///
+/// No checkpoint is ever taken for board position 0 because handicap and setup
+/// stones can change while the game has no moves.
+// -----------------------------------------------------------------------------
+- (void) takeCheckpointIfDueAtBoardPosition:(int)boardPosition
+{
+  if (boardPosition <= 0 || 0 != boardPosition % self.checkpointInterval)
+    return;
+  NSNumber* key = [NSNumber numberWithInt:boardPosition];
+  if ([self.checkpoints objectForKey:key])
+    return;
+
+  if (self.checkpoints.count >= maximumNumberOfCheckpoints)
   {
-    for (int indexOfMove = indexOfCurrentMove; indexOfMove > indexOfTargetMove; --indexOfMove)
+    self.checkpointInterval *= 2;
+    for (NSNumber* checkpointBoardPosition in [self.checkpoints allKeys])
     {
-      GoMove* move = [moveModel moveAtIndex:indexOfMove];
-      [move undo];
-      [center postNotificationName:boardPositionChangeProgress object:nil];
+      if (0 != checkpointBoardPosition.intValue % self.checkpointInterval)
+        [self.checkpoints removeObjectForKey:checkpointBoardPosition];
     }
+    if (0 != boardPosition % self.checkpointInterval)
+      return;
+  }
+
+  GoBoardSnapshot* checkpoint = [[GoBoardSnapshot alloc] initWithBoard:self.game.board];
+  [self.checkpoints setObject:checkpoint forKey:key];
+  [checkpoint release];
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Discards all checkpoints whose board position is greater than
+/// @a boardPosition. This is necessary when moves are discarded, because a new
+/// move can later take the place of a discarded move.
+// -----------------------------------------------------------------------------
+- (void) discardCheckpointsAfterBoardPosition:(int)boardPosition
+{
+  for (NSNumber* checkpointBoardPosition in [self.checkpoints allKeys])
+  {
+    if (checkpointBoardPosition.intValue > boardPosition)
+      [self.checkpoints removeObjectForKey:checkpointBoardPosition];
   }
 }
 
@@ -215,6 +464,7 @@
 {
   GoMoveModel* moveModel = object;
   int numberOfMoves = moveModel.numberOfMoves;
+  [self discardCheckpointsAfterBoardPosition:numberOfMoves];
 
   // Trigger KVO notification for numberOfBoardPositions before notification
   // for currentBoardPosition. This order is defined in the class docs; it is
@@ -241,12 +491,46 @@
   // of Go objects. The drawback is that we have to perform some additional
   // bookkeeping and generate KVO notifications ourselves.
   [self willChangeValueForKey:@"currentBoardPosition"];
+  int oldBoardPosition = _currentBoardPosition;
   _currentBoardPosition = numberOfMoves;
+  [self takeCheckpointIfDueAtBoardPosition:numberOfMoves];
+  self.lastChange = [self changeForNewMoveFromBoardPosition:oldBoardPosition];
   if (self.game.alternatingPlay)
     self.game.nextMoveColor = [GoUtilities playerAfter:self.currentMove inGame:self.game].color;
   [self didChangeValueForKey:@"currentBoardPosition"];
 }
 
+// -----------------------------------------------------------------------------
+/// @brief Returns a change record that describes how the stones on the board
+/// changed when the board position advanced from @a oldBoardPosition to the
+/// board position of the move that was just made. Returns nil if
+/// @a oldBoardPosition is not the board position immediately before the new
+/// move, because in that case the board was not changed by the move alone.
+///
+/// The move itself knows which stones it placed and captured, so unlike
+/// changeFromBoardPosition:toBoardPosition:oldStoneStates:() this method does
+/// not have to compare the whole board.
+///
+/// This is a private helper for
+/// observeValueForKeyPath:ofObject:change:context:().
+// -----------------------------------------------------------------------------
+- (GoBoardPositionChange*) changeForNewMoveFromBoardPosition:(int)oldBoardPosition
+{
+  GoMove* move = self.currentMove;
+  if (! move || oldBoardPosition != _currentBoardPosition - 1)
+    return nil;
+  NSArray* placedStones;
+  if (GoMoveTypePlay == move.type)
+    placedStones = [NSArray arrayWithObject:move.point];
+  else
+    placedStones = [NSArray array];
+  return [[[GoBoardPositionChange alloc] initWithOldBoardPosition:oldBoardPosition
+                                                 newBoardPosition:_currentBoardPosition
+                                                     placedStones:placedStones
+                                                    removedStones:move.capturedStones
+                                                  recoloredStones:[NSArray array]] autorelease];
+}
+
 // -----------------------------------------------------------------------------
 /// @brief NSCoding protocol method.
 // -----------------------------------------------------------------------------
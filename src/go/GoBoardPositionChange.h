@@ -0,0 +1,67 @@
+// -----------------------------------------------------------------------------
+// Copyright 2026 Patrick Näf (herzbube@herzbube.ch)
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// -----------------------------------------------------------------------------
+
+
+// -----------------------------------------------------------------------------
+/// @brief The GoBoardPositionChange class describes the net effect that a
+/// change of the current board position had on the Go board.
+///
+/// @ingroup go
+///
+/// GoBoardPosition creates a GoBoardPositionChange object every time that its
+/// @e currentBoardPosition property changes, regardless of how many moves had
+/// to be replayed or undone, and makes it available via its @e lastChange
+/// property. Clients that observe @e currentBoardPosition can use the change
+/// record to update themselves incrementally, instead of re-examining the
+/// entire board.
+///
+/// A GoBoardPositionChange object only describes the difference between the
+/// old and the new board position. It does not describe the intermediate board
+/// positions. For instance, a stone that is captured and later replaced by a
+/// stone of the same color on the same intersection does not appear in the
+/// change record.
+// -----------------------------------------------------------------------------
+@interface GoBoardPositionChange : NSObject
+{
+}
+
+- (id) initWithOldBoardPosition:(int)oldBoardPosition
+               newBoardPosition:(int)newBoardPosition
+                   placedStones:(NSArray*)placedStones
+                  removedStones:(NSArray*)removedStones
+                recoloredStones:(NSArray*)recoloredStones;
+
+/// @brief The board position before the change.
+@property(nonatomic, assign, readonly) int oldBoardPosition;
+/// @brief The board position after the change.
+@property(nonatomic, assign, readonly) int newBoardPosition;
+/// @brief GoPoint objects that had no stone before the change and have a
+/// stone after the change. When navigating backwards these are the stones
+/// that are restored because the moves that captured them were undone.
+@property(nonatomic, retain, readonly) NSArray* placedStones;
+/// @brief GoPoint objects that had a stone before the change and have no stone
+/// after the change. When navigating forward these are the stones that were
+/// captured.
+@property(nonatomic, retain, readonly) NSArray* removedStones;
+/// @brief GoPoint objects that have a stone both before and after the change,
+/// but of a different color.
+@property(nonatomic, retain, readonly) NSArray* recoloredStones;
+/// @brief All GoPoint objects whose stone state differs between the old and
+/// the new board position, i.e. the union of @e placedStones,
+/// @e removedStones and @e recoloredStones.
+@property(nonatomic, retain, readonly) NSArray* changedPoints;
+
+@end
@@ -0,0 +1,84 @@
+// -----------------------------------------------------------------------------
+// Copyright 2026 Patrick Näf (herzbube@herzbube.ch)
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// -----------------------------------------------------------------------------
+
+
+// Project includes
+#import "GoBoardPositionChange.h"
+
+
+// -----------------------------------------------------------------------------
+/// @brief Class extension with private properties for GoBoardPositionChange.
+// -----------------------------------------------------------------------------
+@interface GoBoardPositionChange()
+/// @name Re-declaration of properties to make them readwrite privately
+//@{
+@property(nonatomic, assign, readwrite) int oldBoardPosition;
+@property(nonatomic, assign, readwrite) int newBoardPosition;
+@property(nonatomic, retain, readwrite) NSArray* placedStones;
+@property(nonatomic, retain, readwrite) NSArray* removedStones;
+@property(nonatomic, retain, readwrite) NSArray* recoloredStones;
+@property(nonatomic, retain, readwrite) NSArray* changedPoints;
+//@}
+@end
+
+
+@implementation GoBoardPositionChange
+
+// -----------------------------------------------------------------------------
+/// @brief Initializes a GoBoardPositionChange object that describes a change
+/// from @a oldBoardPosition to @a newBoardPosition. The arrays contain GoPoint
+/// objects, see the property documentation for details.
+///
+/// @note This is the designated initializer of GoBoardPositionChange.
+// -----------------------------------------------------------------------------
+- (id) initWithOldBoardPosition:(int)oldBoardPosition
+               newBoardPosition:(int)newBoardPosition
+                   placedStones:(NSArray*)placedStones
+                  removedStones:(NSArray*)removedStones
+                recoloredStones:(NSArray*)recoloredStones
+{
+  // Call designated initializer of superclass (NSObject)
+  self = [super init];
+  if (! self)
+    return nil;
+
+  self.oldBoardPosition = oldBoardPosition;
+  self.newBoardPosition = newBoardPosition;
+  self.placedStones = placedStones;
+  self.removedStones = removedStones;
+  self.recoloredStones = recoloredStones;
+  NSMutableArray* changedPoints = [NSMutableArray arrayWithCapacity:placedStones.count + removedStones.count + recoloredStones.count];
+  [changedPoints addObjectsFromArray:placedStones];
+  [changedPoints addObjectsFromArray:removedStones];
+  [changedPoints addObjectsFromArray:recoloredStones];
+  self.changedPoints = changedPoints;
+
+  return self;
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Deallocates memory allocated by this GoBoardPositionChange object.
+// -----------------------------------------------------------------------------
+- (void) dealloc
+{
+  self.placedStones = nil;
+  self.removedStones = nil;
+  self.recoloredStones = nil;
+  self.changedPoints = nil;
+  [super dealloc];
+}
+
+@end
@@ -58,10 +58,12 @@
 
 + (GoBoardRegion*) region;
 + (GoBoardRegion*) regionWithPoint:(GoPoint*)point;
++ (GoBoardRegion*) regionTakingOverPoints:(NSArray*)points;
 - (int) size;
 - (void) addPoint:(GoPoint*)point;
 - (void) removePoint:(GoPoint*)point;
 - (void) joinRegion:(GoBoardRegion*)region;
+- (void) moveSubRegion:(NSArray*)subRegion fromMainRegion:(GoBoardRegion*)mainRegion;
 - (bool) isStoneGroup;
 - (enum GoColor) color;
 - (int) liberties;
@@ -17,6 +17,7 @@
 
 // Project includes
 #import "GoBoardRegion.h"
+#import "GoBoard.h"
 #import "GoPoint.h"
 #import "../utility/UIColorAdditions.h"
 
@@ -85,6 +86,43 @@
   return region;
 }
 
+// -----------------------------------------------------------------------------
+/// @brief Convenience constructor. Creates a GoBoardRegion instance that
+/// contains the GoPoint objects in @a points.
+///
+/// Unlike regionWithPoint:() and addPoint:(), this method does not remove the
+/// GoPoint objects from the GoBoardRegion objects that they previously
+/// referenced, it merely updates the GoBoardRegion reference of each GoPoint.
+/// This avoids fragmenting the previous GoBoardRegion objects, but leaves them
+/// in an inconsistent state. This method is therefore intended only for clients
+/// that replace all GoBoardRegion objects of a board at once, so that the
+/// previous GoBoardRegion objects are no longer referenced by any GoPoint and
+/// are discarded. GoBoardSnapshot does this.
+///
+/// The caller is responsible for passing a set of neighbouring GoPoint objects
+/// that all have the same stone state.
+///
+/// Raises an @e NSInvalidArgumentException if @a points is nil or empty.
+// -----------------------------------------------------------------------------
++ (GoBoardRegion*) regionTakingOverPoints:(NSArray*)points
+{
+  if (0 == points.count)
+  {
+    NSString* errorMessage = @"Points argument is nil or empty";
+    DDLogError(@"%@: %@", self, errorMessage);
+    NSException* exception = [NSException exceptionWithName:NSInvalidArgumentException
+                                                     reason:errorMessage
+                                                   userInfo:nil];
+    @throw exception;
+  }
+
+  GoBoardRegion* region = [[[GoBoardRegion alloc] init] autorelease];
+  [(NSMutableArray*)region.points addObjectsFromArray:points];
+  for (GoPoint* point in points)
+    point.region = region;
+  return region;
+}
+
 // -----------------------------------------------------------------------------
 /// @brief Initializes a GoBoardRegion object.
 ///
@@ -301,7 +339,11 @@
 ///
 /// The GoBoardRegion reference of all GoPoint objects will be updated to this
 /// GoBoardRegion. As a result, @a region will be deallocated and should not be
-/// used after this method returns.
+/// used after this method returns, unless the caller holds a reference to it.
+///
+/// The cost of this method is proportional to the size of @a region. Callers
+/// that can choose should therefore join the smaller region with the larger
+/// region.
 ///
 /// Raises an @e NSInvalidArgumentException if @a region is nil, if it is the
 /// same as this GoBoardRegion, or if the @e stoneState property of its GoPoint
@@ -329,18 +371,40 @@
     @throw exception;
   }
 
-  // Iterate over a copy of the array to be safe from modifications of the
-  // array. Such modifications occur because addPoint:() below causes the point
-  // to be removed from the other region.
-  // Note: The copy, by the way, also solves the problem that the array is
-  // deallocated when the last point is removed from the other region. If we
-  // were using the original array, the loop would access the deallocated array
-  // in its final iteration (the one where it would normally find out that the
-  // loop condition has been reached), causing the application to crash.
-  NSArray* pointsCopy = [region.points copy];
-  for (GoPoint* point in pointsCopy)
-    [self addPoint:point];
-  [pointsCopy release];
+  NSArray* pointsOfRegion = region->_points;
+  if (0 == pointsOfRegion.count)
+    return;
+  // We only check the first point of each region, assuming that it is
+  // representative for the other points in the region
+  if (_points.count > 0)
+  {
+    GoPoint* otherPoint = [_points objectAtIndex:0];
+    GoPoint* firstPointOfRegion = [pointsOfRegion objectAtIndex:0];
+    if (otherPoint.stoneState != firstPointOfRegion.stoneState)
+    {
+      NSString* errorMessage = [NSString stringWithFormat:@"Region argument's stoneState (%d) does not match stoneState of points already in this GoBoardRegion (%d)", firstPointOfRegion.stoneState, otherPoint.stoneState];
+      DDLogError(@"%@: %@", self, errorMessage);
+      NSException* exception = [NSException exceptionWithName:NSInvalidArgumentException
+                                                       reason:errorMessage
+                                                     userInfo:nil];
+      @throw exception;
+    }
+  }
+
+  // The points are bulk-moved instead of being added one by one via
+  // addPoint:(). addPoint:() would remove each point from region via
+  // removePoint:(), which in turn would apply the expensive
+  // region-fragmentation logic to region once for every point. This is
+  // pointless because all points of region end up in the same place.
+  //
+  // We must retain/autorelease region because it is deallocated when the
+  // GoBoardRegion reference of its last point is updated. The retain also
+  // keeps the points array alive while we iterate it.
+  [[region retain] autorelease];
+  [(NSMutableArray*)_points addObjectsFromArray:pointsOfRegion];
+  for (GoPoint* point in pointsOfRegion)
+    point.region = self;
+  [(NSMutableArray*)pointsOfRegion removeAllObjects];
 }
 
 // -----------------------------------------------------------------------------
@@ -394,22 +458,11 @@
     @throw exception;
   }
 
-  NSMutableArray* libertyPoints = [NSMutableArray arrayWithCapacity:0];
-  for (GoPoint* point in _points)
-  {
-    for (GoPoint* neighbour in point.neighbours)
-    {
-      // Is it a liberty?
-      if ([neighbour hasStone])
-        continue;  // no
-      // Count the liberty if it hasn't been counted already
-      if (! [libertyPoints containsObject:neighbour])
-        [libertyPoints addObject:neighbour];
-    }
-  }
-  // Cast is required because NSUInteger and int differ in size in 64-bit. Cast
-  // is safe because a region's liberties can never exceed pow(2, 32).
-  return (int)[libertyPoints count];
+  // GoBoard tracks the liberties of all stone groups as stones are placed and
+  // removed. The stone group that GoBoard knows for the first stone is the
+  // same as this GoBoardRegion.
+  GoPoint* point = [_points objectAtIndex:0];
+  return [point.board libertiesAtIndex:point.index];
 }
 
 // -----------------------------------------------------------------------------
@@ -466,6 +519,20 @@
   if (_points.count < 2)
     return;
 
+  // Split also not possible if less than 2 neighbours of the removed point are
+  // in this region: All remaining points were connected before, and the
+  // removed point did not connect anything. Checking this up front avoids a
+  // flood fill of the entire region whenever the removed point has at most one
+  // neighbour in this region.
+  int numberOfNeighboursInRegion = 0;
+  for (GoPoint* neighbourOfRemovedPoint in removedPoint.neighbours)
+  {
+    if (neighbourOfRemovedPoint.region == self)
+      ++numberOfNeighboursInRegion;
+  }
+  if (numberOfNeighboursInRegion < 2)
+    return;
+
   // Because the point that has been removed is the splitting point, we iterate
   // the point's neighbours to see if they are still connected
   NSMutableArray* subRegions = [NSMutableArray arrayWithCapacity:0];
@@ -577,8 +644,8 @@
 /// or if their @e stoneState property does not match the @e stoneState
 /// properties of other GoPoint objects already in this region.
 ///
-/// @note This is a private backend helper method for
-/// splitRegionAfterRemovingPoint:().
+/// @note This method is used by splitRegionAfterRemovingPoint:(), and by
+/// GoBoardRegionJournal to revert changes without re-examining the board.
 // -----------------------------------------------------------------------------
 - (void) moveSubRegion:(NSArray*)subRegion fromMainRegion:(GoBoardRegion*)mainRegion
 {
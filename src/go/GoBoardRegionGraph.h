@@ -0,0 +1,61 @@
+// -----------------------------------------------------------------------------
+// Copyright 2026 Patrick Näf (herzbube@herzbube.ch)
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// -----------------------------------------------------------------------------
+
+
+// Forward declarations
+@class GoBoard;
+@class GoBoardRegion;
+
+
+// -----------------------------------------------------------------------------
+/// @brief The GoBoardRegionGraph class stores which GoBoardRegion objects of a
+/// Go board are adjacent to each other.
+///
+/// @ingroup go
+///
+/// GoBoardRegionGraph is a snapshot of the GoBoardRegion objects that exist
+/// on a board at the time the graph is created. Each GoBoardRegion is
+/// identified by an integer region ID, which is the index of the region in
+/// the property @e regions. Adjacency is stored in compressed sparse row
+/// format: The IDs of all adjacent regions of all regions are stored in a
+/// single array, one region after the other, and a second array stores for
+/// each region ID where its adjacent region IDs begin. Looking up the
+/// adjacent regions of a region is therefore a constant-time operation that
+/// does not allocate memory. This is useful for clients that traverse the
+/// graph many times while the board remains static, e.g. GoScore while
+/// scoring mode is enabled.
+///
+/// GoBoardRegionGraph does not observe the board. It is the responsibility of
+/// the client to discard the graph when stones are placed or removed.
+// -----------------------------------------------------------------------------
+@interface GoBoardRegionGraph : NSObject
+{
+}
+
+- (id) initWithBoard:(GoBoard*)board;
+- (int) regionIdOfRegion:(GoBoardRegion*)region;
+- (GoBoardRegion*) regionWithId:(int)regionId;
+- (enum GoColor) colorOfRegionWithId:(int)regionId;
+- (int) numberOfAdjacentRegionsOfRegionWithId:(int)regionId;
+- (const int*) adjacentRegionIdsOfRegionWithId:(int)regionId;
+
+/// @brief The GoBoardRegion objects in the graph. The index of a
+/// GoBoardRegion in this list is its region ID.
+@property(nonatomic, retain, readonly) NSArray* regions;
+/// @brief The number of GoBoardRegion objects in the graph.
+@property(nonatomic, assign, readonly) int numberOfRegions;
+
+@end
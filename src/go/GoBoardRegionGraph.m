@@ -0,0 +1,223 @@
+// -----------------------------------------------------------------------------
+// Copyright 2026 Patrick Näf (herzbube@herzbube.ch)
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// -----------------------------------------------------------------------------
+
+
+// Project includes
+#import "GoBoardRegionGraph.h"
+#import "GoBoard.h"
+#import "GoBoardRegion.h"
+#import "GoPoint.h"
+
+
+// -----------------------------------------------------------------------------
+/// @brief Class extension with private properties for GoBoardRegionGraph.
+// -----------------------------------------------------------------------------
+@interface GoBoardRegionGraph()
+{
+@private
+  /// @brief One element per intersection, in the order defined by
+  /// GoBoard::indexOfPoint:(). The element holds the ID of the region that the
+  /// intersection belongs to.
+  int* m_regionIdOfIntersection;
+  /// @brief One element per region. The element holds the color of the
+  /// region.
+  enum GoColor* m_regionColors;
+  /// @brief One element per region, plus one. The adjacent region IDs of the
+  /// region with ID n are stored in @e m_adjacentRegionIds starting at index
+  /// m_adjacencyOffsets[n] and ending before index m_adjacencyOffsets[n + 1].
+  int* m_adjacencyOffsets;
+  /// @brief The IDs of the adjacent regions of all regions, see
+  /// @e m_adjacencyOffsets.
+  int* m_adjacentRegionIds;
+}
+/// @name Re-declaration of properties to make them readwrite privately
+//@{
+@property(nonatomic, retain, readwrite) NSArray* regions;
+@property(nonatomic, assign, readwrite) int numberOfRegions;
+//@}
+@end
+
+
+@implementation GoBoardRegionGraph
+
+// -----------------------------------------------------------------------------
+/// @brief Initializes a GoBoardRegionGraph object with the GoBoardRegion
+/// objects that currently exist on @a board.
+///
+/// @note This is the designated initializer of GoBoardRegionGraph.
+// -----------------------------------------------------------------------------
+- (id) initWithBoard:(GoBoard*)board
+{
+  // Call designated initializer of superclass (NSObject)
+  self = [super init];
+  if (! self)
+    return nil;
+
+  self.regions = board.regions;
+  int numberOfRegions = (int)self.regions.count;
+  self.numberOfRegions = numberOfRegions;
+  int numberOfIntersections = board.size * board.size;
+  m_regionIdOfIntersection = (int*)malloc(numberOfIntersections * sizeof(int));
+  m_regionColors = (enum GoColor*)malloc(numberOfRegions * sizeof(enum GoColor));
+  m_adjacencyOffsets = (int*)malloc((numberOfRegions + 1) * sizeof(int));
+  // Each pair of neighbouring intersections that belong to different regions
+  // contributes at most one adjacency per direction. An intersection has at
+  // most 4 neighbours.
+  m_adjacentRegionIds = (int*)malloc(4 * numberOfIntersections * sizeof(int));
+
+  int regionId = 0;
+  for (GoBoardRegion* region in self.regions)
+  {
+    for (GoPoint* point in region.points)
+      m_regionIdOfIntersection[point.index] = regionId;
+    m_regionColors[regionId] = [region color];
+    ++regionId;
+  }
+
+  // Remembers for each region ID the ID of the region for which it was most
+  // recently added as an adjacent region. This prevents duplicates without a
+  // search.
+  int* lastRegionIdAddedTo = (int*)malloc(numberOfRegions * sizeof(int));
+  for (regionId = 0; regionId < numberOfRegions; ++regionId)
+    lastRegionIdAddedTo[regionId] = -1;
+  int numberOfAdjacencies = 0;
+  regionId = 0;
+  for (GoBoardRegion* region in self.regions)
+  {
+    m_adjacencyOffsets[regionId] = numberOfAdjacencies;
+    for (GoPoint* point in region.points)
+    {
+      for (GoPoint* neighbour in point.neighbours)
+      {
+        int adjacentRegionId = m_regionIdOfIntersection[neighbour.index];
+        if (adjacentRegionId == regionId || lastRegionIdAddedTo[adjacentRegionId] == regionId)
+          continue;
+        lastRegionIdAddedTo[adjacentRegionId] = regionId;
+        m_adjacentRegionIds[numberOfAdjacencies++] = adjacentRegionId;
+      }
+    }
+    ++regionId;
+  }
+  m_adjacencyOffsets[numberOfRegions] = numberOfAdjacencies;
+  free(lastRegionIdAddedTo);
+
+  return self;
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Deallocates memory allocated by this GoBoardRegionGraph object.
+// -----------------------------------------------------------------------------
+- (void) dealloc
+{
+  self.regions = nil;
+  free(m_regionIdOfIntersection);
+  free(m_regionColors);
+  free(m_adjacencyOffsets);
+  free(m_adjacentRegionIds);
+  [super dealloc];
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Returns the region ID of @a region.
+///
+/// Raises @e NSInvalidArgumentException if @a region is not part of the graph.
+// -----------------------------------------------------------------------------
+- (int) regionIdOfRegion:(GoBoardRegion*)region
+{
+  GoPoint* point = region.points.firstObject;
+  if (point)
+  {
+    int regionId = m_regionIdOfIntersection[point.index];
+    if ([_regions objectAtIndex:regionId] == region)
+      return regionId;
+  }
+
+  NSString* errorMessage = [NSString stringWithFormat:@"Region %@ is not part of the graph", region];
+  DDLogError(@"%@: %@", self, errorMessage);
+  NSException* exception = [NSException exceptionWithName:NSInvalidArgumentException
+                                                   reason:errorMessage
+                                                 userInfo:nil];
+  @throw exception;
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Returns the GoBoardRegion whose region ID is @a regionId.
+///
+/// Raises @e NSRangeException if @a regionId is out of range.
+// -----------------------------------------------------------------------------
+- (GoBoardRegion*) regionWithId:(int)regionId
+{
+  [self throwIfRegionIdIsOutOfRange:regionId];
+  return [_regions objectAtIndex:regionId];
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Returns the color of the GoBoardRegion whose region ID is
+/// @a regionId.
+///
+/// Raises @e NSRangeException if @a regionId is out of range.
+// -----------------------------------------------------------------------------
+- (enum GoColor) colorOfRegionWithId:(int)regionId
+{
+  [self throwIfRegionIdIsOutOfRange:regionId];
+  return m_regionColors[regionId];
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Returns the number of regions that are adjacent to the GoBoardRegion
+/// whose region ID is @a regionId.
+///
+/// Raises @e NSRangeException if @a regionId is out of range.
+// -----------------------------------------------------------------------------
+- (int) numberOfAdjacentRegionsOfRegionWithId:(int)regionId
+{
+  [self throwIfRegionIdIsOutOfRange:regionId];
+  return m_adjacencyOffsets[regionId + 1] - m_adjacencyOffsets[regionId];
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Returns the region IDs of the regions that are adjacent to the
+/// GoBoardRegion whose region ID is @a regionId. The array has
+/// numberOfAdjacentRegionsOfRegionWithId:() elements, in no particular order.
+///
+/// The array is owned by GoBoardRegionGraph and lives as long as the
+/// GoBoardRegionGraph object.
+///
+/// Raises @e NSRangeException if @a regionId is out of range.
+// -----------------------------------------------------------------------------
+- (const int*) adjacentRegionIdsOfRegionWithId:(int)regionId
+{
+  [self throwIfRegionIdIsOutOfRange:regionId];
+  return m_adjacentRegionIds + m_adjacencyOffsets[regionId];
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Private helper. Raises @e NSRangeException if @a regionId is out of
+/// range.
+// -----------------------------------------------------------------------------
+- (void) throwIfRegionIdIsOutOfRange:(int)regionId
+{
+  if (regionId >= 0 && regionId < _numberOfRegions)
+    return;
+  NSString* errorMessage = [NSString stringWithFormat:@"Region ID %d is out of range", regionId];
+  DDLogError(@"%@: %@", self, errorMessage);
+  NSException* exception = [NSException exceptionWithName:NSRangeException
+                                                   reason:errorMessage
+                                                 userInfo:nil];
+  @throw exception;
+}
+
+@end
@@ -0,0 +1,72 @@
+// -----------------------------------------------------------------------------
+// Copyright 2026 Patrick Näf (herzbube@herzbube.ch)
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// -----------------------------------------------------------------------------
+
+
+// Forward declarations
+@class GoBoardRegion;
+@class GoPoint;
+
+
+// -----------------------------------------------------------------------------
+/// @brief The GoBoardRegionJournal class records the changes that
+/// GoUtilities::movePointToNewRegion:journal:() makes to the GoBoardRegion
+/// objects of a Go board, so that the changes can later be reverted without
+/// having to re-examine the board.
+///
+/// @ingroup go
+///
+/// Moving a GoPoint to a new GoBoardRegion consists of these steps:
+/// - The GoPoint is removed from its old GoBoardRegion. This may split the old
+///   GoBoardRegion into several GoBoardRegion objects, which is expensive
+///   because it requires a flood fill.
+/// - The GoPoint is added to a neighbouring GoBoardRegion, or to a new
+///   GoBoardRegion if no neighbour has the same stone state. Other neighbouring
+///   GoBoardRegion objects with the same stone state are joined with the
+///   GoBoardRegion that receives the GoPoint.
+///
+/// GoBoardRegionJournal remembers the old GoBoardRegion, the GoBoardRegion
+/// objects split off from it, the GoBoardRegion that received the GoPoint, and
+/// every GoBoardRegion that was joined together with the GoPoint objects it
+/// contained at the time. undo() uses this information to put every GoPoint
+/// back into the very GoBoardRegion object it belonged to before. No flood fill
+/// is required because the journal already knows how the regions were
+/// connected.
+///
+/// GoMove uses GoBoardRegionJournal so that GoMove::undo() does not have to
+/// split the stone group that contains the move's stone.
+///
+/// @note A journal can only be undone if the GoBoardRegion objects are still in
+/// the state in which the journal left them. This is the case if all changes
+/// that were made after the journal was recorded have been reverted. undo()
+/// checks this to a reasonable degree and refuses to do anything if the check
+/// fails. The caller must then fall back to
+/// GoUtilities::movePointToNewRegion:().
+// -----------------------------------------------------------------------------
+@interface GoBoardRegionJournal : NSObject
+{
+}
+
+- (id) initWithPoint:(GoPoint*)point;
+- (void) recordRemovalFromRegion:(GoBoardRegion*)oldRegion
+                    splitRegions:(NSArray*)splitRegions;
+- (void) recordJoinOfRegion:(GoBoardRegion*)region;
+- (void) recordTargetRegion:(GoBoardRegion*)targetRegion;
+- (bool) undo;
+
+/// @brief The GoPoint that was moved to a new GoBoardRegion.
+@property(nonatomic, retain, readonly) GoPoint* point;
+
+@end
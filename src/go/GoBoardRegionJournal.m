@@ -0,0 +1,194 @@
+// -----------------------------------------------------------------------------
+// Copyright 2026 Patrick Näf (herzbube@herzbube.ch)
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// -----------------------------------------------------------------------------
+
+
+// Project includes
+#import "GoBoardRegionJournal.h"
+#import "GoBoardRegion.h"
+#import "GoPoint.h"
+
+
+// -----------------------------------------------------------------------------
+/// @brief Class extension with private properties for GoBoardRegionJournal.
+// -----------------------------------------------------------------------------
+@interface GoBoardRegionJournal()
+/// @name Re-declaration of properties to make them readwrite privately
+//@{
+@property(nonatomic, retain, readwrite) GoPoint* point;
+//@}
+/// @name Privately declared properties
+//@{
+/// @brief The GoBoardRegion that contained @e point before it was moved.
+@property(nonatomic, retain) GoBoardRegion* oldRegion;
+/// @brief The GoBoardRegion objects that were split off from @e oldRegion when
+/// @e point was removed from it.
+@property(nonatomic, retain) NSArray* splitRegions;
+/// @brief The GoBoardRegion objects that were joined with @e targetRegion, in the
+/// order in which they were joined.
+@property(nonatomic, retain) NSMutableArray* joinedRegions;
+/// @brief For each GoBoardRegion in @e joinedRegions, the GoPoint objects that
+/// the GoBoardRegion contained before it was joined.
+@property(nonatomic, retain) NSMutableArray* joinedRegionPoints;
+/// @brief The GoBoardRegion that contains @e point after it was moved.
+@property(nonatomic, retain) GoBoardRegion* targetRegion;
+//@}
+@end
+
+
+@implementation GoBoardRegionJournal
+
+// -----------------------------------------------------------------------------
+/// @brief Initializes a GoBoardRegionJournal object that records the changes
+/// made while @a point is moved to a new GoBoardRegion.
+///
+/// @note This is the designated initializer of GoBoardRegionJournal.
+// -----------------------------------------------------------------------------
+- (id) initWithPoint:(GoPoint*)point
+{
+  // Call designated initializer of superclass (NSObject)
+  self = [super init];
+  if (! self)
+    return nil;
+
+  self.point = point;
+  self.oldRegion = nil;
+  self.splitRegions = nil;
+  self.joinedRegions = [NSMutableArray arrayWithCapacity:0];
+  self.joinedRegionPoints = [NSMutableArray arrayWithCapacity:0];
+  self.targetRegion = nil;
+
+  return self;
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Deallocates memory allocated by this GoBoardRegionJournal object.
+// -----------------------------------------------------------------------------
+- (void) dealloc
+{
+  self.point = nil;
+  self.oldRegion = nil;
+  self.splitRegions = nil;
+  self.joinedRegions = nil;
+  self.joinedRegionPoints = nil;
+  self.targetRegion = nil;
+  [super dealloc];
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Records that @e point has been removed from @a oldRegion, and that
+/// as a result the GoBoardRegion objects in @a splitRegions have been split
+/// off from @a oldRegion.
+///
+/// @a oldRegion may be empty if @e point was its last GoPoint. The journal
+/// keeps @a oldRegion alive so that undo() can restore it.
+// -----------------------------------------------------------------------------
+- (void) recordRemovalFromRegion:(GoBoardRegion*)oldRegion
+                    splitRegions:(NSArray*)splitRegions
+{
+  self.oldRegion = oldRegion;
+  self.splitRegions = splitRegions;
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Records that @a region is about to be joined with the GoBoardRegion
+/// that receives @e point.
+///
+/// This must be invoked @b before the regions are joined, because the journal
+/// takes a copy of the GoPoint objects that are currently in @a region.
+// -----------------------------------------------------------------------------
+- (void) recordJoinOfRegion:(GoBoardRegion*)region
+{
+  [self.joinedRegions addObject:region];
+  NSArray* points = [region.points copy];
+  [self.joinedRegionPoints addObject:points];
+  [points release];
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Records that @e point has been added to @a targetRegion. This is
+/// either a neighbouring GoBoardRegion, or a GoBoardRegion that was newly
+/// created for @e point.
+// -----------------------------------------------------------------------------
+- (void) recordTargetRegion:(GoBoardRegion*)targetRegion
+{
+  self.targetRegion = targetRegion;
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Reverts the changes recorded by this GoBoardRegionJournal. Returns
+/// true if the changes were reverted, returns false if the GoBoardRegion
+/// objects are no longer in the state in which the journal left them.
+///
+/// If this method returns false nothing has been changed. If this method
+/// returns true, @e point and all GoPoint objects that were in the same
+/// GoBoardRegion objects as @e point are back in the GoBoardRegion objects
+/// that they belonged to before @e point was moved. The journal is then spent
+/// and must not be undone a second time.
+///
+/// The caller must reset the stone state of @e point to its old value before
+/// invoking this method.
+// -----------------------------------------------------------------------------
+- (bool) undo
+{
+  if (! _targetRegion || ! _oldRegion)
+    return false;
+  if (_point.region != _targetRegion)
+    return false;
+  NSUInteger numberOfJoinedRegions = _joinedRegions.count;
+  for (NSUInteger indexOfJoinedRegion = 0; indexOfJoinedRegion < numberOfJoinedRegions; ++indexOfJoinedRegion)
+  {
+    GoBoardRegion* joinedRegion = [_joinedRegions objectAtIndex:indexOfJoinedRegion];
+    if (joinedRegion.points.count > 0)
+      return false;
+    NSArray* joinedPoints = [_joinedRegionPoints objectAtIndex:indexOfJoinedRegion];
+    GoPoint* firstJoinedPoint = [joinedPoints objectAtIndex:0];
+    if (firstJoinedPoint.region != _targetRegion)
+      return false;
+  }
+  for (GoBoardRegion* splitRegion in _splitRegions)
+  {
+    if (0 == splitRegion.points.count)
+      return false;
+  }
+
+  // Step 1: Hand back the points of the joined regions, most recently joined
+  // region first. This leaves targetRegion in the state it was before the point
+  // was added, except for the point itself.
+  for (NSUInteger indexOfJoinedRegion = numberOfJoinedRegions; indexOfJoinedRegion > 0; --indexOfJoinedRegion)
+  {
+    GoBoardRegion* joinedRegion = [_joinedRegions objectAtIndex:indexOfJoinedRegion - 1];
+    NSArray* joinedPoints = [_joinedRegionPoints objectAtIndex:indexOfJoinedRegion - 1];
+    [joinedRegion moveSubRegion:joinedPoints fromMainRegion:_targetRegion];
+  }
+
+  // Step 2: Move the point back into its old region. If the point was the only
+  // point in targetRegion, targetRegion is deallocated as soon as we release it.
+  [_oldRegion moveSubRegion:[NSArray arrayWithObject:_point] fromMainRegion:_targetRegion];
+
+  // Step 3: Reconnect the regions that were split off from the old region
+  for (GoBoardRegion* splitRegion in _splitRegions)
+    [_oldRegion joinRegion:splitRegion];
+
+  self.oldRegion = nil;
+  self.splitRegions = nil;
+  [self.joinedRegions removeAllObjects];
+  [self.joinedRegionPoints removeAllObjects];
+  self.targetRegion = nil;
+
+  return true;
+}
+
+@end
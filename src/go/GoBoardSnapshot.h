@@ -0,0 +1,49 @@
+// -----------------------------------------------------------------------------
+// Copyright 2026 Patrick Näf (herzbube@herzbube.ch)
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// -----------------------------------------------------------------------------
+
+
+// Forward declarations
+@class GoBoard;
+
+
+// -----------------------------------------------------------------------------
+/// @brief The GoBoardSnapshot class stores the stone states and the
+/// GoBoardRegion layout of a Go board in compact form, so that the board can
+/// later be restored to that state.
+///
+/// @ingroup go
+///
+/// GoBoardSnapshot stores one byte per intersection for the stone state, and
+/// one region number per intersection. Intersections with the same region
+/// number belong to the same GoBoardRegion. A snapshot of a 19x19 board
+/// therefore requires roughly 1 KB of memory.
+///
+/// restoreBoard:() changes the stone state of only those intersections whose
+/// stone state differs from the snapshot, then replaces all GoBoardRegion
+/// objects of the board with new GoBoardRegion objects. The cost of restoring
+/// is proportional to the size of the board, regardless of how many moves lie
+/// between the board's current state and the snapshot.
+///
+/// GoBoardPosition uses GoBoardSnapshot to store checkpoints.
+// -----------------------------------------------------------------------------
+@interface GoBoardSnapshot : NSObject
+{
+}
+
+- (id) initWithBoard:(GoBoard*)board;
+- (void) restoreBoard:(GoBoard*)board;
+
+@end
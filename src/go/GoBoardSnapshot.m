@@ -0,0 +1,128 @@
+// -----------------------------------------------------------------------------
+// Copyright 2026 Patrick Näf (herzbube@herzbube.ch)
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// -----------------------------------------------------------------------------
+
+
+// Project includes
+#import "GoBoardSnapshot.h"
+#import "GoBoard.h"
+#import "GoBoardRegion.h"
+#import "GoPoint.h"
+
+
+// -----------------------------------------------------------------------------
+/// @brief Class extension with private properties for GoBoardSnapshot.
+// -----------------------------------------------------------------------------
+@interface GoBoardSnapshot()
+{
+@private
+  /// @brief One stone state per intersection, in the order defined by
+  /// GoBoard::indexOfPoint:().
+  uint8_t* m_stoneStates;
+  /// @brief One region number per intersection, in the order defined by
+  /// GoBoard::indexOfPoint:(). Region numbers start with 0.
+  int16_t* m_regionNumbers;
+}
+/// @name Privately declared properties
+//@{
+/// @brief The number of intersections of the board.
+@property(nonatomic, assign) int numberOfIntersections;
+/// @brief The number of distinct region numbers in m_regionNumbers.
+@property(nonatomic, assign) int numberOfRegions;
+//@}
+@end
+
+
+@implementation GoBoardSnapshot
+
+// -----------------------------------------------------------------------------
+/// @brief Initializes a GoBoardSnapshot object with the current stone states
+/// and GoBoardRegion layout of @a board.
+///
+/// @note This is the designated initializer of GoBoardSnapshot.
+// -----------------------------------------------------------------------------
+- (id) initWithBoard:(GoBoard*)board
+{
+  // Call designated initializer of superclass (NSObject)
+  self = [super init];
+  if (! self)
+    return nil;
+
+  int numberOfIntersections = board.size * board.size;
+  self.numberOfIntersections = numberOfIntersections;
+  m_stoneStates = (uint8_t*)malloc(numberOfIntersections * sizeof(uint8_t));
+  m_regionNumbers = (int16_t*)malloc(numberOfIntersections * sizeof(int16_t));
+  for (int index = 0; index < numberOfIntersections; ++index)
+  {
+    m_stoneStates[index] = (uint8_t)[board stoneStateAtIndex:index];
+    m_regionNumbers[index] = -1;
+  }
+
+  // Number the regions in the order in which we first encounter one of their
+  // points. Each region is visited only once.
+  int numberOfRegions = 0;
+  for (int index = 0; index < numberOfIntersections; ++index)
+  {
+    if (m_regionNumbers[index] >= 0)
+      continue;
+    GoBoardRegion* region = [board pointAtIndex:index].region;
+    for (GoPoint* point in region.points)
+      m_regionNumbers[point.index] = (int16_t)numberOfRegions;
+    ++numberOfRegions;
+  }
+  self.numberOfRegions = numberOfRegions;
+
+  return self;
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Deallocates memory allocated by this GoBoardSnapshot object.
+// -----------------------------------------------------------------------------
+- (void) dealloc
+{
+  free(m_stoneStates);
+  free(m_regionNumbers);
+  [super dealloc];
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Restores the stone states and the GoBoardRegion layout stored in this
+/// snapshot to @a board.
+///
+/// @a board must have the same size as the board that the snapshot was taken
+/// from. All GoBoardRegion objects that existed on @a board before this method
+/// was invoked are discarded.
+// -----------------------------------------------------------------------------
+- (void) restoreBoard:(GoBoard*)board
+{
+  int numberOfIntersections = self.numberOfIntersections;
+  for (int index = 0; index < numberOfIntersections; ++index)
+  {
+    enum GoColor stoneState = (enum GoColor)m_stoneStates[index];
+    if ([board stoneStateAtIndex:index] != stoneState)
+      [board setStoneState:stoneState atIndex:index];
+  }
+
+  int numberOfRegions = self.numberOfRegions;
+  NSMutableArray* regionPoints = [NSMutableArray arrayWithCapacity:numberOfRegions];
+  for (int regionNumber = 0; regionNumber < numberOfRegions; ++regionNumber)
+    [regionPoints addObject:[NSMutableArray arrayWithCapacity:0]];
+  for (int index = 0; index < numberOfIntersections; ++index)
+    [[regionPoints objectAtIndex:m_regionNumbers[index]] addObject:[board pointAtIndex:index]];
+  for (NSArray* points in regionPoints)
+    [GoBoardRegion regionTakingOverPoints:points];
+}
+
+@end
@@ -0,0 +1,317 @@
+// -----------------------------------------------------------------------------
+// Copyright 2026 Patrick Näf (herzbube@herzbube.ch)
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// -----------------------------------------------------------------------------
+
+
+// Project includes
+#include "GoDeadStoneEstimator.h"
+
+// System includes
+#include <cstddef>
+
+
+// -----------------------------------------------------------------------------
+/// @brief Initializes a GoDeadStoneEstimator object that examines the stones
+/// in @a core. Initially no territory statistics are available.
+///
+/// @a core must outlive the GoDeadStoneEstimator object.
+// -----------------------------------------------------------------------------
+GoDeadStoneEstimator::GoDeadStoneEstimator(const GoBoardCore& core)
+  : core(core),
+    territoryStatisticsScores(nullptr)
+{
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Sets the territory statistics scores to use. @a territoryStatisticsScores
+/// must have one element per board index, a positive value means that the
+/// intersection belongs to black, a negative value that it belongs to white.
+/// If @a territoryStatisticsScores is NULL, or if all scores are zero, no
+/// territory statistics are used.
+///
+/// The scores are not copied, the array must outlive the
+/// GoDeadStoneEstimator object.
+// -----------------------------------------------------------------------------
+void GoDeadStoneEstimator::setTerritoryStatisticsScores(const float* territoryStatisticsScores)
+{
+  this->territoryStatisticsScores = nullptr;
+  if (! territoryStatisticsScores)
+    return;
+  // All scores are zero if the GTP engine has not yet collected territory
+  // statistics
+  for (int boardIndex = 0; boardIndex < core.numberOfIntersections(); ++boardIndex)
+  {
+    if (0.0f != territoryStatisticsScores[boardIndex])
+    {
+      this->territoryStatisticsScores = territoryStatisticsScores;
+      return;
+    }
+  }
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Estimates for every stone group on the board whether it is alive or
+/// dead. See the class documentation for details.
+// -----------------------------------------------------------------------------
+std::vector<GoDeadStoneEstimator::StoneGroup> GoDeadStoneEstimator::estimateDeadStones() const
+{
+  // Benson's algorithm for one color finds the unconditionally alive stones of
+  // that color and the unconditionally dead stones of the other color
+  GoBoardCore::Bitboard unconditionallyAliveStones;
+  GoBoardCore::Bitboard unconditionallyDeadStones;
+  for (GoBoardCore::Color color : { GoBoardCore::ColorBlack, GoBoardCore::ColorWhite })
+  {
+    GoBoardCore::Bitboard aliveStones;
+    GoBoardCore::Bitboard deadStones;
+    findUnconditionalStatus(color, aliveStones, deadStones);
+    unconditionallyAliveStones |= aliveStones;
+    unconditionallyDeadStones |= deadStones;
+  }
+
+  std::vector<StoneGroup> stoneGroups;
+  for (GoBoardCore::Color color : { GoBoardCore::ColorBlack, GoBoardCore::ColorWhite })
+  {
+    GoBoardCore::Bitboard remainingStones = core.stones(color);
+    while (remainingStones.any())
+    {
+      StoneGroup stoneGroup;
+      stoneGroup.stones = core.groupAt(core.boardIndexOfPosition(remainingStones.firstPosition()));
+      stoneGroup.color = color;
+      stoneGroup.isUnconditional = true;
+      remainingStones &= ~stoneGroup.stones;
+
+      if ((stoneGroup.stones & unconditionallyAliveStones).any())
+      {
+        stoneGroup.verdict = VerdictAlive;
+      }
+      else if ((stoneGroup.stones & unconditionallyDeadStones).any())
+      {
+        stoneGroup.verdict = VerdictDead;
+      }
+      else
+      {
+        stoneGroup.isUnconditional = false;
+        Verdict eyeSpace = eyeSpaceVerdict(stoneGroup.stones, color);
+        Verdict territoryStatistics = territoryStatisticsVerdict(stoneGroup.stones, color);
+        if (VerdictAlive == eyeSpace && VerdictAlive == territoryStatistics)
+          stoneGroup.verdict = VerdictAlive;
+        else if (VerdictDead == eyeSpace && VerdictDead == territoryStatistics)
+          stoneGroup.verdict = VerdictDead;
+        else
+          stoneGroup.verdict = VerdictAmbiguous;
+      }
+      stoneGroups.push_back(stoneGroup);
+    }
+  }
+  return stoneGroups;
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Runs Benson's algorithm for the stones of color @a color. Fills
+/// @a aliveStones with the stones of color @a color that are unconditionally
+/// alive, and @a deadStones with the stones of the other color that are
+/// unconditionally dead because they are enclosed by the alive stones in an
+/// area where they can never make an eye.
+///
+/// The algorithm works with the stone groups of color @a color and the
+/// regions, i.e. the connected areas of intersections that are not occupied
+/// by a stone of color @a color. A region is vital to a stone group if all
+/// empty intersections in the region are liberties of the group. The
+/// algorithm repeatedly removes stone groups that have fewer than two vital
+/// regions, and regions that border a removed stone group, until nothing
+/// changes anymore. The remaining stone groups are unconditionally alive.
+// -----------------------------------------------------------------------------
+void GoDeadStoneEstimator::findUnconditionalStatus(GoBoardCore::Color color, GoBoardCore::Bitboard& aliveStones, GoBoardCore::Bitboard& deadStones) const
+{
+  aliveStones = GoBoardCore::Bitboard();
+  deadStones = GoBoardCore::Bitboard();
+
+  GoBoardCore::Bitboard empty = core.emptyPositions();
+  std::vector<GoBoardCore::Bitboard> stoneGroups = connectedAreas(core.stones(color));
+  std::vector<GoBoardCore::Bitboard> liberties;
+  for (const GoBoardCore::Bitboard& stoneGroup : stoneGroups)
+    liberties.push_back(core.neighbourPositions(stoneGroup) & empty);
+  std::vector<GoBoardCore::Bitboard> regions = connectedAreas(core.onBoardPositions() & ~core.stones(color));
+
+  // isVital[regionIndex][stoneGroupIndex], isBordering likewise
+  size_t numberOfStoneGroups = stoneGroups.size();
+  size_t numberOfRegions = regions.size();
+  std::vector<std::vector<bool>> isVital(numberOfRegions, std::vector<bool>(numberOfStoneGroups));
+  std::vector<std::vector<bool>> isBordering(numberOfRegions, std::vector<bool>(numberOfStoneGroups));
+  for (size_t regionIndex = 0; regionIndex < numberOfRegions; ++regionIndex)
+  {
+    GoBoardCore::Bitboard regionEmpty = regions[regionIndex] & empty;
+    GoBoardCore::Bitboard regionBorder = core.neighbourPositions(regions[regionIndex]);
+    for (size_t stoneGroupIndex = 0; stoneGroupIndex < numberOfStoneGroups; ++stoneGroupIndex)
+    {
+      isBordering[regionIndex][stoneGroupIndex] = (regionBorder & stoneGroups[stoneGroupIndex]).any();
+      isVital[regionIndex][stoneGroupIndex] = (isBordering[regionIndex][stoneGroupIndex]
+                                               && regionEmpty.any()
+                                               && ! (regionEmpty & ~liberties[stoneGroupIndex]).any());
+    }
+  }
+
+  std::vector<bool> isStoneGroupRemoved(numberOfStoneGroups, false);
+  std::vector<bool> isRegionRemoved(numberOfRegions, false);
+  bool changed = true;
+  while (changed)
+  {
+    changed = false;
+    for (size_t stoneGroupIndex = 0; stoneGroupIndex < numberOfStoneGroups; ++stoneGroupIndex)
+    {
+      if (isStoneGroupRemoved[stoneGroupIndex])
+        continue;
+      int numberOfVitalRegions = 0;
+      for (size_t regionIndex = 0; regionIndex < numberOfRegions; ++regionIndex)
+      {
+        if (! isRegionRemoved[regionIndex] && isVital[regionIndex][stoneGroupIndex])
+          ++numberOfVitalRegions;
+      }
+      if (numberOfVitalRegions < 2)
+      {
+        isStoneGroupRemoved[stoneGroupIndex] = true;
+        changed = true;
+      }
+    }
+    for (size_t regionIndex = 0; regionIndex < numberOfRegions; ++regionIndex)
+    {
+      if (isRegionRemoved[regionIndex])
+        continue;
+      for (size_t stoneGroupIndex = 0; stoneGroupIndex < numberOfStoneGroups; ++stoneGroupIndex)
+      {
+        if (isStoneGroupRemoved[stoneGroupIndex] && isBordering[regionIndex][stoneGroupIndex])
+        {
+          isRegionRemoved[regionIndex] = true;
+          changed = true;
+          break;
+        }
+      }
+    }
+  }
+
+  GoBoardCore::Bitboard aliveLiberties;
+  for (size_t stoneGroupIndex = 0; stoneGroupIndex < numberOfStoneGroups; ++stoneGroupIndex)
+  {
+    if (isStoneGroupRemoved[stoneGroupIndex])
+      continue;
+    aliveStones |= stoneGroups[stoneGroupIndex];
+    aliveLiberties |= liberties[stoneGroupIndex];
+  }
+
+  // The stones of the other color in a region that is enclosed by alive stone
+  // groups can never make an eye if every empty intersection of the region is
+  // a liberty of an alive stone group. Since the alive stone groups can never
+  // be captured, the stones of the other color cannot live.
+  for (size_t regionIndex = 0; regionIndex < numberOfRegions; ++regionIndex)
+  {
+    if (isRegionRemoved[regionIndex])
+      continue;
+    GoBoardCore::Bitboard regionEmpty = regions[regionIndex] & empty;
+    if ((regionEmpty & ~aliveLiberties).any())
+      continue;
+    deadStones |= regions[regionIndex] & ~empty;
+  }
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Private helper. Splits @a area into its connected parts.
+// -----------------------------------------------------------------------------
+std::vector<GoBoardCore::Bitboard> GoDeadStoneEstimator::connectedAreas(const GoBoardCore::Bitboard& area) const
+{
+  std::vector<GoBoardCore::Bitboard> connectedAreas;
+  GoBoardCore::Bitboard remainingArea = area;
+  while (remainingArea.any())
+  {
+    GoBoardCore::Bitboard connectedArea;
+    connectedArea.set(remainingArea.firstPosition());
+    while (true)
+    {
+      GoBoardCore::Bitboard grown = core.neighbourPositions(connectedArea) & area;
+      if (grown == connectedArea)
+        break;
+      connectedArea = grown;
+    }
+    connectedAreas.push_back(connectedArea);
+    remainingArea &= ~connectedArea;
+  }
+  return connectedAreas;
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Private helper for estimateDeadStones(). Returns the verdict of the
+/// eye space heuristics for the stone group @a stones of color @a color.
+// -----------------------------------------------------------------------------
+GoDeadStoneEstimator::Verdict GoDeadStoneEstimator::eyeSpaceVerdict(const GoBoardCore::Bitboard& stones, GoBoardCore::Color color) const
+{
+  // The regions enclosed by stones of the group's color that border the group
+  GoBoardCore::Bitboard notOwnStones = core.onBoardPositions() & ~core.stones(color);
+  GoBoardCore::Bitboard remainingNeighbours = core.neighbourPositions(stones) & notOwnStones;
+  int numberOfEyes = 0;
+  while (remainingNeighbours.any() && numberOfEyes < 2)
+  {
+    GoBoardCore::Bitboard region;
+    region.set(remainingNeighbours.firstPosition());
+    while (true)
+    {
+      GoBoardCore::Bitboard grown = core.neighbourPositions(region) & notOwnStones;
+      if (grown == region)
+        break;
+      region = grown;
+    }
+    remainingNeighbours &= ~region;
+
+    int regionSize = region.count();
+    int numberOfEmptyIntersections = (region & core.emptyPositions()).count();
+    int numberOfOtherStones = regionSize - numberOfEmptyIntersections;
+    if (0 == numberOfEmptyIntersections || 3 * numberOfOtherStones > regionSize)
+      continue;
+    numberOfEyes += (numberOfEmptyIntersections >= minimumSizeOfLargeEyeSpace) ? 2 : 1;
+  }
+
+  if (numberOfEyes >= 2)
+    return VerdictAlive;
+  else if (0 == numberOfEyes)
+    return VerdictDead;
+  else
+    return VerdictAmbiguous;
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Private helper for estimateDeadStones(). Returns the verdict of the
+/// territory statistics for the stone group @a stones of color @a color.
+// -----------------------------------------------------------------------------
+GoDeadStoneEstimator::Verdict GoDeadStoneEstimator::territoryStatisticsVerdict(const GoBoardCore::Bitboard& stones, GoBoardCore::Color color) const
+{
+  if (! territoryStatisticsScores)
+    return VerdictAmbiguous;
+
+  float sign = (GoBoardCore::ColorBlack == color) ? 1.0f : -1.0f;
+  float sumOfScores = 0.0f;
+  int numberOfStones = 0;
+  GoBoardCore::Bitboard remainingStones = stones;
+  while (remainingStones.any())
+  {
+    int boardIndex = core.boardIndexOfPosition(remainingStones.removeFirstPosition());
+    sumOfScores += sign * territoryStatisticsScores[boardIndex];
+    ++numberOfStones;
+  }
+  float averageScore = sumOfScores / numberOfStones;
+  if (averageScore >= territoryStatisticsThreshold)
+    return VerdictAlive;
+  else if (averageScore <= -territoryStatisticsThreshold)
+    return VerdictDead;
+  else
+    return VerdictAmbiguous;
+}
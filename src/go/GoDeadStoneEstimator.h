@@ -0,0 +1,107 @@
+// -----------------------------------------------------------------------------
+// Copyright 2026 Patrick Näf (herzbube@herzbube.ch)
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// -----------------------------------------------------------------------------
+
+
+#pragma once
+
+// Project includes
+#include "GoBoardCore.h"
+
+// System includes
+#include <vector>
+
+// -----------------------------------------------------------------------------
+/// @brief The GoDeadStoneEstimator class estimates which stone groups on a
+/// finished Go board are dead, without asking a GTP engine.
+///
+/// @ingroup go
+///
+/// GoDeadStoneEstimator combines three sources of information, in this order
+/// of precedence:
+/// - Benson's algorithm finds the stone groups that are unconditionally alive,
+///   i.e. that cannot be captured even if their owner always passes. Stones of
+///   the other color that are enclosed by unconditionally alive groups in an
+///   area where they can never make an eye are unconditionally dead. The
+///   verdicts of Benson's algorithm are certain.
+/// - Eye space heuristics look at the areas enclosed by a stone group. An area
+///   is an eye space of a stone group if it is adjacent to the group, and if
+///   the stones of the other color in the area make up no more than a third of
+///   the area. A group with two or more eye spaces (a large eye space counts
+///   twice) is probably alive. A group without eye space is probably dead.
+/// - Territory statistics, as collected by the GTP engine during its most
+///   recent search, tell for each intersection how likely it is to belong to
+///   black or white. A group whose stones mostly belong to the other color is
+///   probably dead.
+///
+/// Neither the eye space heuristics nor the territory statistics are reliable
+/// on their own, so a verdict that is not certain requires both to agree: A
+/// group is estimated to be alive if both the heuristics and the territory
+/// statistics say so, and dead if both say so. All other groups, including
+/// all groups that are not judged by Benson's algorithm when no territory
+/// statistics are available, are ambiguous and should be judged by the GTP
+/// engine.
+///
+/// GoDeadStoneEstimator is plain C++ and does not depend on Foundation.
+// -----------------------------------------------------------------------------
+class GoDeadStoneEstimator
+{
+public:
+  /// @brief Enumerates the possible outcomes of the estimation for a stone
+  /// group.
+  enum Verdict
+  {
+    VerdictAmbiguous,  ///< @brief The estimator cannot tell.
+    VerdictAlive,      ///< @brief The stone group is alive.
+    VerdictDead        ///< @brief The stone group is dead.
+  };
+
+  /// @brief The result of estimating one stone group.
+  struct StoneGroup
+  {
+    /// @brief The positions of the stones in the group.
+    GoBoardCore::Bitboard stones;
+    /// @brief The color of the stones in the group.
+    GoBoardCore::Color color;
+    /// @brief The outcome of the estimation.
+    Verdict verdict;
+    /// @brief True if the verdict was found by Benson's algorithm and is
+    /// therefore certain.
+    bool isUnconditional;
+  };
+
+  /// @brief The size from which an eye space counts as two eyes.
+  static const int minimumSizeOfLargeEyeSpace = 7;
+  /// @brief The average territory statistics score, from the point of view of
+  /// the owner of a stone group, from which the territory statistics consider
+  /// the stone group to be alive (positive value) or dead (negative value).
+  static constexpr float territoryStatisticsThreshold = 0.5f;
+
+  explicit GoDeadStoneEstimator(const GoBoardCore& core);
+
+  void setTerritoryStatisticsScores(const float* territoryStatisticsScores);
+  std::vector<StoneGroup> estimateDeadStones() const;
+  void findUnconditionalStatus(GoBoardCore::Color color, GoBoardCore::Bitboard& aliveStones, GoBoardCore::Bitboard& deadStones) const;
+
+private:
+  std::vector<GoBoardCore::Bitboard> connectedAreas(const GoBoardCore::Bitboard& area) const;
+  Verdict eyeSpaceVerdict(const GoBoardCore::Bitboard& stones, GoBoardCore::Color color) const;
+  Verdict territoryStatisticsVerdict(const GoBoardCore::Bitboard& stones, GoBoardCore::Color color) const;
+
+  const GoBoardCore& core;
+  /// @brief The territory statistics scores, one per board index. Is NULL if
+  /// no territory statistics are available.
+  const float* territoryStatisticsScores;
+};
@@ -20,6 +20,7 @@
 @class GoBoardPosition;
 @class GoGameDocument;
 @class GoGameRules;
+@class GoLegalMoveMap;
 @class GoMove;
 @class GoMoveModel;
 @class GoPlayer;
@@ -72,6 +73,7 @@
   createsIllegalStoneOrGroup:(GoPoint**)illegalStoneOrGroupPoint;
 - (bool) isLegalMove:(GoPoint*)point isIllegalReason:(enum GoMoveIsIllegalReason*)reason;
 - (bool) isLegalMove:(GoPoint*)point byColor:(enum GoColor)color isIllegalReason:(enum GoMoveIsIllegalReason*)reason;
+- (GoLegalMoveMap*) legalMoveMapForColor:(enum GoColor)color;
 - (void) revertStateFromEndedToInProgress;
 - (void) switchNextMoveColor;
 - (void) toggleHandicapPoint:(GoPoint*)point;
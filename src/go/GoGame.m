@@ -22,6 +22,7 @@
 #import "GoBoardRegion.h"
 #import "GoGameDocument.h"
 #import "GoGameRules.h"
+#import "GoLegalMoveMap.h"
 #import "GoMove.h"
 #import "GoMoveModel.h"
 #import "GoPlayer.h"
@@ -34,6 +35,30 @@
 #import "../player/Player.h"
 
 
+// -----------------------------------------------------------------------------
+/// @brief Class extension with private properties for GoGame.
+// -----------------------------------------------------------------------------
+@interface GoGame()
+/// @name Privately declared properties
+//@{
+/// @brief The legal move map for black that was last generated by
+/// legalMoveMapForColor:(). Is nil if no map was generated for the current
+/// board position.
+@property(nonatomic, retain) GoLegalMoveMap* legalMoveMapBlack;
+/// @brief The legal move map for white that was last generated by
+/// legalMoveMapForColor:(). Is nil if no map was generated for the current
+/// board position.
+@property(nonatomic, retain) GoLegalMoveMap* legalMoveMapWhite;
+/// @brief The value of GoBoard::stoneStateChangeCount when the legal move maps
+/// were generated.
+@property(nonatomic, assign) unsigned long long legalMoveMapsStoneStateChangeCount;
+/// @brief The value of GoBoardPosition::currentMove when the legal move maps
+/// were generated. This is not retained, it is only used for comparison.
+@property(nonatomic, assign) GoMove* legalMoveMapsCurrentMove;
+//@}
+@end
+
+
 @implementation GoGame
 
 // -----------------------------------------------------------------------------
@@ -147,6 +172,8 @@
   self.rules = nil;
   self.document = nil;
   self.score = nil;
+  self.legalMoveMapBlack = nil;
+  self.legalMoveMapWhite = nil;
   // Don't use self.blackSetupPoints - same reason as for _handicapPoints above
   if (_blackSetupPoints)
   {
@@ -698,50 +725,159 @@
   // Point is an empty intersection that is surrounded by stones
   else
   {
-    // Pass 1: Check if we can connect to a friendly colored stone group
-    // without killing it
-    NSArray* neighbourRegionsFriendly = [point neighbourRegionsWithColor:color];
-    for (GoBoardRegion* neighbourRegion in neighbourRegionsFriendly)
+    // The move is a suicide if it neither connects to a friendly colored stone
+    // group without killing it, nor captures an opposing stone group. GoBoard
+    // answers this on its bitboards.
+    if ([point.board isSuicideAtIndex:point.index byColor:color])
     {
-      // If the friendly stone group has more than one liberty, we are sure that
-      // we are not killing it. The only thing that can still make the move
-      // illegal is a ko (but since we are connecting, a simple ko is not
-      // possible here).
-      if ([neighbourRegion liberties] > 1)
-      {
-        bool isSuperko;
-        bool isKoMove = [self isKoMove:point moveColor:color simpleKoIsPossible:false isSuperko:&isSuperko];
-        if (isKoMove)
-          *reason = isSuperko ? GoMoveIsIllegalReasonSuperko : GoMoveIsIllegalReasonSimpleKo;
-        return !isKoMove;
-      }
+      *reason = GoMoveIsIllegalReasonSuicide;
+      return false;
     }
 
-    // Pass 2: Check if we can capture opposing stone groups
-    enum GoColor opponentColor = (color == GoColorBlack ? GoColorWhite : GoColorBlack);
-    NSArray* neighbourRegionsOpponent = [point neighbourRegionsWithColor:opponentColor];
-    for (GoBoardRegion* neighbourRegion in neighbourRegionsOpponent)
+    // The only thing that can still make the move illegal is a ko. A simple
+    // ko is possible only if we are NOT connecting to a friendly colored stone
+    // group.
+    bool isSimpleKoStillPossible = true;
+    for (GoPoint* neighbour in point.neighbours)
     {
-      // If the opposing stone group has only one liberty left we can capture
-      // it. The only thing that can still make the move illegal is a ko.
-      if ([neighbourRegion liberties] == 1)
+      if (neighbour.stoneState == color)
       {
-        // A simple Ko situation is possible only if we are NOT connecting
-        bool isSimpleKoStillPossible = (0 == neighbourRegionsFriendly.count);
-        bool isSuperko;
-        bool isKoMove = [self isKoMove:point moveColor:color simpleKoIsPossible:isSimpleKoStillPossible isSuperko:&isSuperko];
-        if (isKoMove)
-          *reason = isSuperko ? GoMoveIsIllegalReasonSuperko : GoMoveIsIllegalReasonSimpleKo;
-        return !isKoMove;
+        isSimpleKoStillPossible = false;
+        break;
       }
     }
+    bool isSuperko;
+    bool isKoMove = [self isKoMove:point moveColor:color simpleKoIsPossible:isSimpleKoStillPossible isSuperko:&isSuperko];
+    if (isKoMove)
+      *reason = isSuperko ? GoMoveIsIllegalReasonSuperko : GoMoveIsIllegalReasonSimpleKo;
+    return !isKoMove;
+  }
+}
 
-    // If we arrive here, no opposing stones can be captured and there are no
-    // friendly groups with sufficient liberties to connect to
-    // -> the move is a suicide and therefore illegal
-    *reason = GoMoveIsIllegalReasonSuicide;
-    return false;
+// -----------------------------------------------------------------------------
+/// @brief Returns a GoLegalMoveMap that tells for every intersection whether
+/// playing a stone there would be legal for the player who plays @a color in
+/// the current board position. The map gives the same answers as
+/// isLegalMove:byColor:isIllegalReason:().
+///
+/// The map is generated on the first invocation for a board position and then
+/// cached until the board position changes, so clients that query many
+/// intersections in the same board position pay for the generation only once.
+/// Clients must not hold on to the map after the board position changed.
+///
+/// Raises @e NSInvalidArgumentException if @a color is neither GoColorBlack
+/// nor GoColorWhite.
+// -----------------------------------------------------------------------------
+- (GoLegalMoveMap*) legalMoveMapForColor:(enum GoColor)color
+{
+  if (color != GoColorBlack && color != GoColorWhite)
+  {
+    NSString* errorMessage = [NSString stringWithFormat:@"Invalid color argument %d", color];
+    DDLogError(@"%@: %@", self, errorMessage);
+    NSException* exception = [NSException exceptionWithName:NSInvalidArgumentException
+                                                     reason:errorMessage
+                                                   userInfo:nil];
+    @throw exception;
+  }
+
+  // The Zobrist hashes that the ko check depends on are a function of the
+  // stones on the board and the current move, so if neither has changed the
+  // cached maps are still valid. The change counter also covers changes that
+  // do not involve a move, such as setup stones and handicap stones.
+  GoBoard* board = self.board;
+  GoMove* currentMove = self.boardPosition.currentMove;
+  if (self.legalMoveMapsStoneStateChangeCount != board.stoneStateChangeCount ||
+      self.legalMoveMapsCurrentMove != currentMove)
+  {
+    self.legalMoveMapBlack = nil;
+    self.legalMoveMapWhite = nil;
+    self.legalMoveMapsStoneStateChangeCount = board.stoneStateChangeCount;
+    self.legalMoveMapsCurrentMove = currentMove;
+  }
+
+  if (GoColorBlack == color)
+  {
+    if (! self.legalMoveMapBlack)
+      self.legalMoveMapBlack = [self generateLegalMoveMapForColor:color];
+    return self.legalMoveMapBlack;
+  }
+  else
+  {
+    if (! self.legalMoveMapWhite)
+      self.legalMoveMapWhite = [self generateLegalMoveMapForColor:color];
+    return self.legalMoveMapWhite;
+  }
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Generates a GoLegalMoveMap for the player who plays @a color in the
+/// current board position.
+///
+/// GoBoard analyzes suicide and captures for all intersections in one pass over
+/// its bitboards, and also supplies the Zobrist hash change of every move. The
+/// ko check of an intersection is then a few hash comparisons, which makes
+/// generating the map much cheaper than invoking
+/// isLegalMove:byColor:isIllegalReason:() for every intersection.
+///
+/// @note isKoMove:moveColor:simpleKoIsPossible:isSuperko:() can skip the ko
+/// check under #GoKoRuleSimple if a move cannot possibly be a simple ko. This
+/// method always performs the check. The result is the same because a move
+/// that recreates the previous-to-last board position is always a simple ko.
+///
+/// This is a private helper for legalMoveMapForColor:().
+// -----------------------------------------------------------------------------
+- (GoLegalMoveMap*) generateLegalMoveMapForColor:(enum GoColor)color
+{
+  GoBoard* board = self.board;
+  int numberOfIntersections = board.size * board.size;
+  bool* isSuicide = (bool*)malloc(numberOfIntersections * sizeof(bool));
+  long long* zobristHashChanges = (long long*)malloc(numberOfIntersections * sizeof(long long));
+  bool* isLegal = (bool*)malloc(numberOfIntersections * sizeof(bool));
+  enum GoMoveIsIllegalReason* illegalReasons = (enum GoMoveIsIllegalReason*)malloc(numberOfIntersections * sizeof(enum GoMoveIsIllegalReason));
+
+  [board analyzeMovesByColor:color isSuicide:isSuicide zobristHashChanges:zobristHashChanges];
+
+  GoMove* lastMove = self.boardPosition.currentMove;
+  long long zobristHashOfCurrentBoardPosition = (lastMove ? lastMove.zobristHash : self.zobristHashBeforeFirstMove);
+  for (int index = 0; index < numberOfIntersections; ++index)
+  {
+    isLegal[index] = false;
+    if (GoColorNone != [board stoneStateAtIndex:index])
+    {
+      illegalReasons[index] = GoMoveIsIllegalReasonIntersectionOccupied;
+    }
+    else if (isSuicide[index])
+    {
+      illegalReasons[index] = GoMoveIsIllegalReasonSuicide;
+    }
+    else if (! lastMove)
+    {
+      // Same as in isKoMove:moveColor:simpleKoIsPossible:isSuperko:(), ko is
+      // not possible without a move
+      isLegal[index] = true;
+    }
+    else
+    {
+      bool isSuperko;
+      bool isKoMove = [self isKoMoveWithZobristHash:zobristHashOfCurrentBoardPosition ^ zobristHashChanges[index]
+                                          moveColor:color
+                                          isSuperko:&isSuperko];
+      if (isKoMove)
+        illegalReasons[index] = isSuperko ? GoMoveIsIllegalReasonSuperko : GoMoveIsIllegalReasonSimpleKo;
+      else
+        isLegal[index] = true;
+    }
   }
+
+  GoLegalMoveMap* legalMoveMap = [[[GoLegalMoveMap alloc] initWithColor:color
+                                                    numberOfIntersections:numberOfIntersections
+                                                                  isLegal:isLegal
+                                                           illegalReasons:illegalReasons] autorelease];
+  free(isSuicide);
+  free(zobristHashChanges);
+  free(isLegal);
+  free(illegalReasons);
+  return legalMoveMap;
 }
 
 // -----------------------------------------------------------------------------
@@ -788,11 +924,41 @@ simpleKoIsPossible:(bool)simpleKoIsPossible
   GoMove* lastMove = self.boardPosition.currentMove;
   if (! lastMove)
     return false;
-  GoMove* previousToLastMove = lastMove.previous;
 
   long long zobristHashOfHypotheticalMove = [self zobristHashOfHypotheticalMoveAtPoint:point
                                                                                byColor:moveColor
                                                                              afterMove:lastMove];
+  return [self isKoMoveWithZobristHash:zobristHashOfHypotheticalMove
+                             moveColor:moveColor
+                             isSuperko:isSuperko];
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Returns true if a hypothetical move by player @a moveColor that
+/// results in a board position with Zobrist hash
+/// @a zobristHashOfHypotheticalMove would violate the current ko rule of the
+/// game. Returns false if the move would not violate the current ko rule of
+/// the game.
+///
+/// This ko detection routine is based on the current board position! The
+/// current board position must have a move, i.e. it must not be the board
+/// position before the first move.
+///
+/// If this method returns true, it also fills the out parameter @a isSuperko
+/// with true or false to distinguish ko from superko. If this method returns
+/// false, the value of the out parameter @a isSuperko is undefined.
+///
+/// This is a private helper for
+/// isKoMove:moveColor:simpleKoIsPossible:isSuperko:() and
+/// generateLegalMoveMapForColor:().
+// -----------------------------------------------------------------------------
+- (bool) isKoMoveWithZobristHash:(long long)zobristHashOfHypotheticalMove
+                       moveColor:(enum GoColor)moveColor
+                       isSuperko:(bool*)isSuperko
+{
+  enum GoKoRule koRule = self.rules.koRule;
+  GoMove* lastMove = self.boardPosition.currentMove;
+  GoMove* previousToLastMove = lastMove.previous;
 
   long long zobristHashOfPreviousToLastBoardPosition;
   if (previousToLastMove)
@@ -826,17 +992,28 @@ simpleKoIsPossible:(bool)simpleKoIsPossible
       if (! previousToLastMove)
         return false;
 
-      for (GoMove* move = previousToLastMove.previous; move != nil; move = move.previous)
+      // Examine all board positions before the previous-to-last board
+      // position. GoMoveModel has indexed the Zobrist hashes of all moves, so
+      // this is a lookup instead of an iteration over the entire game.
+      // Situational superko only examines board positions that resulted from
+      // moves made by the same color.
+      int indexOfPreviousToLastMove = previousToLastMove.moveNumber - 1;
+      bool isRepeatedBoardPosition;
+      if (GoKoRuleSuperkoSituational == koRule)
       {
-        // Situational superko only examines board positions that resulted from
-        // moves made by the same color
-        if (GoKoRuleSuperkoSituational == koRule && move.player.color != moveColor)
-            continue;
-        if (zobristHashOfHypotheticalMove == move.zobristHash)
-        {
-          *isSuperko = true;
-          return true;
-        }
+        isRepeatedBoardPosition = [self.moveModel hasMoveBeforeIndex:indexOfPreviousToLastMove
+                                                      withZobristHash:zobristHashOfHypotheticalMove
+                                                        playedByColor:moveColor];
+      }
+      else
+      {
+        isRepeatedBoardPosition = [self.moveModel hasMoveBeforeIndex:indexOfPreviousToLastMove
+                                                      withZobristHash:zobristHashOfHypotheticalMove];
+      }
+      if (isRepeatedBoardPosition)
+      {
+        *isSuperko = true;
+        return true;
       }
 
       // Situational superko only examines board positions that resulted from
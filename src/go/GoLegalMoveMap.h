@@ -0,0 +1,65 @@
+// -----------------------------------------------------------------------------
+// Copyright 2026 Patrick Näf (herzbube@herzbube.ch)
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// -----------------------------------------------------------------------------
+
+
+// -----------------------------------------------------------------------------
+/// @brief The GoLegalMoveMap class stores for every intersection of a Go board
+/// whether it would be legal for one color to play a stone there, and if not,
+/// why not.
+///
+/// @ingroup go
+///
+/// GoLegalMoveMap is a snapshot of one board position. GoGame generates it for
+/// all intersections in one pass over the board, see
+/// GoGame::legalMoveMapForColor:(). Once the map exists, looking up the
+/// legality of a move is a constant-time operation. This is useful for clients
+/// that need to know the legality of many moves in the same board position,
+/// e.g. to shade the board or to validate moves while the user drags a stone
+/// across the board.
+///
+/// The legality of all intersections is stored in a bitmap with one bit per
+/// intersection, the reasons why moves are illegal in an array with one byte
+/// per intersection. Both are indexed in the order defined by
+/// GoBoard::indexOfPoint:().
+///
+/// GoLegalMoveMap does not observe the board. It is the responsibility of
+/// GoGame to discard the map when the board position changes.
+// -----------------------------------------------------------------------------
+@interface GoLegalMoveMap : NSObject
+{
+}
+
+- (id) initWithColor:(enum GoColor)color
+numberOfIntersections:(int)numberOfIntersections
+             isLegal:(const bool*)isLegal
+      illegalReasons:(const enum GoMoveIsIllegalReason*)illegalReasons;
+- (bool) isLegalMoveAtIndex:(int)index isIllegalReason:(enum GoMoveIsIllegalReason*)reason;
+
+/// @brief The color of the player for whom the move legality is stored.
+@property(nonatomic, assign, readonly) enum GoColor color;
+/// @brief The number of intersections for which the move legality is stored.
+@property(nonatomic, assign, readonly) int numberOfIntersections;
+/// @brief The number of intersections on which a move is legal.
+@property(nonatomic, assign, readonly) int numberOfLegalMoves;
+/// @brief The bitmap with one bit per intersection. The bit is set if a move
+/// on the intersection is legal. Intersection n is represented by bit (n % 64)
+/// of element (n / 64).
+///
+/// The bitmap is owned by GoLegalMoveMap and lives as long as the
+/// GoLegalMoveMap object.
+@property(nonatomic, assign, readonly) const uint64_t* legalMoveBitmap;
+
+@end
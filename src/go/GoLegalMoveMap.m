@@ -0,0 +1,137 @@
+// -----------------------------------------------------------------------------
+// Copyright 2026 Patrick Näf (herzbube@herzbube.ch)
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// -----------------------------------------------------------------------------
+
+
+// Project includes
+#import "GoLegalMoveMap.h"
+
+
+// -----------------------------------------------------------------------------
+/// @brief Class extension with private properties for GoLegalMoveMap.
+// -----------------------------------------------------------------------------
+@interface GoLegalMoveMap()
+{
+@private
+  /// @brief One bit per intersection, see property @e legalMoveBitmap.
+  uint64_t* m_legalMoveBitmap;
+  /// @brief One element per intersection. The element of an intersection on
+  /// which a move is not legal holds a value from the enumeration
+  /// #GoMoveIsIllegalReason.
+  uint8_t* m_illegalReasons;
+}
+/// @name Re-declaration of properties to make them readwrite privately
+//@{
+@property(nonatomic, assign, readwrite) enum GoColor color;
+@property(nonatomic, assign, readwrite) int numberOfIntersections;
+@property(nonatomic, assign, readwrite) int numberOfLegalMoves;
+//@}
+@end
+
+
+@implementation GoLegalMoveMap
+
+// -----------------------------------------------------------------------------
+/// @brief Initializes a GoLegalMoveMap object that stores the move legality
+/// for the player who plays @a color.
+///
+/// @a isLegal and @a illegalReasons must have @a numberOfIntersections
+/// elements, in the order defined by GoBoard::indexOfPoint:(). The element in
+/// @a illegalReasons is ignored if the corresponding element in @a isLegal is
+/// true. GoLegalMoveMap copies the content of both arrays.
+///
+/// @note This is the designated initializer of GoLegalMoveMap.
+// -----------------------------------------------------------------------------
+- (id) initWithColor:(enum GoColor)color
+numberOfIntersections:(int)numberOfIntersections
+             isLegal:(const bool*)isLegal
+      illegalReasons:(const enum GoMoveIsIllegalReason*)illegalReasons
+{
+  // Call designated initializer of superclass (NSObject)
+  self = [super init];
+  if (! self)
+    return nil;
+
+  self.color = color;
+  self.numberOfIntersections = numberOfIntersections;
+  m_legalMoveBitmap = (uint64_t*)calloc((numberOfIntersections + 63) / 64, sizeof(uint64_t));
+  m_illegalReasons = (uint8_t*)calloc(numberOfIntersections, sizeof(uint8_t));
+
+  int numberOfLegalMoves = 0;
+  for (int index = 0; index < numberOfIntersections; ++index)
+  {
+    if (isLegal[index])
+    {
+      m_legalMoveBitmap[index / 64] |= ((uint64_t)1 << (index % 64));
+      ++numberOfLegalMoves;
+    }
+    else
+    {
+      m_illegalReasons[index] = (uint8_t)illegalReasons[index];
+    }
+  }
+  self.numberOfLegalMoves = numberOfLegalMoves;
+
+  return self;
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Deallocates memory allocated by this GoLegalMoveMap object.
+// -----------------------------------------------------------------------------
+- (void) dealloc
+{
+  free(m_legalMoveBitmap);
+  free(m_illegalReasons);
+  [super dealloc];
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Returns true if playing a stone on the intersection at index position
+/// @a index, in the order defined by GoBoard::indexOfPoint:(), is legal for
+/// the player who plays @e color.
+///
+/// If this method returns false, the out parameter @a reason is filled with
+/// the reason why the move is not legal. If this method returns true, the
+/// value of @a reason is undefined.
+///
+/// Raises @e NSRangeException if @a index is out of range.
+// -----------------------------------------------------------------------------
+- (bool) isLegalMoveAtIndex:(int)index isIllegalReason:(enum GoMoveIsIllegalReason*)reason
+{
+  if (index < 0 || index >= _numberOfIntersections)
+  {
+    NSString* errorMessage = [NSString stringWithFormat:@"Index %d is out of range", index];
+    DDLogError(@"%@: %@", self, errorMessage);
+    NSException* exception = [NSException exceptionWithName:NSRangeException
+                                                     reason:errorMessage
+                                                   userInfo:nil];
+    @throw exception;
+  }
+
+  if (m_legalMoveBitmap[index / 64] & ((uint64_t)1 << (index % 64)))
+    return true;
+  *reason = (enum GoMoveIsIllegalReason)m_illegalReasons[index];
+  return false;
+}
+
+// -----------------------------------------------------------------------------
+// Property is documented in the header file.
+// -----------------------------------------------------------------------------
+- (const uint64_t*) legalMoveBitmap
+{
+  return m_legalMoveBitmap;
+}
+
+@end
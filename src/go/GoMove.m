@@ -22,6 +22,7 @@
 #import "GoPlayer.h"
 #import "GoPoint.h"
 #import "GoBoardRegion.h"
+#import "GoBoardRegionJournal.h"
 #import "GoUtilities.h"
 #import "GoZobristTable.h"
 
@@ -39,6 +40,12 @@
 @property(nonatomic, retain, readwrite) NSArray* capturedStones;
 @property(nonatomic, assign, readwrite) int moveNumber;
 //@}
+/// @name Privately declared properties
+//@{
+/// @brief Records the GoBoardRegion changes made by doIt(). Is nil if doIt()
+/// has not been invoked, or if undo() has already used the journal.
+@property(nonatomic, retain) GoBoardRegionJournal* regionJournal;
+//@}
 @end
 
 
@@ -119,6 +126,7 @@
   self.capturedStones = [NSMutableArray arrayWithCapacity:0];
   self.moveNumber = 1;
   self.zobristHash = 0;
+  self.regionJournal = nil;
 
   return self;
 }
@@ -144,6 +152,7 @@
   // The hash was not archived. Whoever is unarchiving this GoMove is
   // responsible for re-calculating the hash.
   self.zobristHash = 0;
+  self.regionJournal = nil;
 
   return self;
 }
@@ -166,6 +175,7 @@
     self.next = nil;  // not strictly necessary since we don't retain it
   }
   self.capturedStones = nil;
+  self.regionJournal = nil;
   [super dealloc];
 }
 
@@ -266,7 +276,10 @@
     self.point.stoneState = GoColorBlack;
   else
     self.point.stoneState = GoColorWhite;
-  [GoUtilities movePointToNewRegion:self.point];
+  GoBoardRegionJournal* regionJournal = [[GoBoardRegionJournal alloc] initWithPoint:self.point];
+  [GoUtilities movePointToNewRegion:self.point journal:regionJournal];
+  self.regionJournal = regionJournal;
+  [regionJournal release];
 
   // If the captured stones array already contains entries we assume that this
   // invocation of doIt() is actually a "redo", i.e. undo() has previously been
@@ -316,7 +329,9 @@
 /// @brief Reverts the board to the state it had before this GoMove was played.
 ///
 /// As a side-effect of this method, GoBoardRegions may become fragmented
-/// and/or multiple GoBoardRegions may merge with other regions.
+/// and/or multiple GoBoardRegions may merge with other regions. If doIt() was
+/// invoked previously, the GoBoardRegion objects are restored from the journal
+/// that doIt() recorded, which is much cheaper than re-examining the board.
 ///
 /// Raises an @e NSInternalInconsistencyException if this GoMove is of type
 /// #GoMoveTypePlay and one of the following conditions is true:
@@ -371,7 +386,12 @@
   // Update the point's stone state *BEFORE* moving it to a new region
   GoPoint* thePoint = self.point;
   thePoint.stoneState = GoColorNone;
-  [GoUtilities movePointToNewRegion:thePoint];
+  // The journal puts the point back into its old region without having to
+  // split the stone group that the point is currently part of. The journal is
+  // not available if this GoMove was unarchived.
+  if (! [self.regionJournal undo])
+    [GoUtilities movePointToNewRegion:thePoint];
+  self.regionJournal = nil;
 }
 
 // -----------------------------------------------------------------------------
@@ -19,6 +19,18 @@
 @class GoGame;
 @class GoMove;
 
+/// @brief The GoMoveStatistics struct contains counters that describe a
+/// sequence of moves that starts with the first move of the game.
+struct GoMoveStatistics
+{
+  int stonesPlayedByBlack;  ///< @brief The number of play moves made by black.
+  int stonesPlayedByWhite;  ///< @brief The number of play moves made by white.
+  int passesPlayedByBlack;  ///< @brief The number of pass moves made by black.
+  int passesPlayedByWhite;  ///< @brief The number of pass moves made by white.
+  int capturedByBlack;      ///< @brief The number of stones captured by black.
+  int capturedByWhite;      ///< @brief The number of stones captured by white.
+};
+
 
 // -----------------------------------------------------------------------------
 /// @brief The GoMoveModel class provides data related to the moves of the
@@ -26,6 +38,19 @@
 ///
 /// All indexes in GoMoveModel are zero-based.
 ///
+/// GoMoveModel indexes the Zobrist hashes of its moves so that superko
+/// detection does not have to iterate over the entire game. The index is
+/// updated whenever moves are added or discarded. The index refers to move
+/// list positions, not to the current board position, so it remains valid
+/// while the user navigates through the game.
+///
+/// GoMoveModel also keeps running totals of the move statistics in
+/// GoMoveStatistics, one entry per move. The statistics of the first N moves
+/// can therefore be looked up in O(1), regardless of how many moves the game
+/// has. The captured stones of a move are counted when the move is added to
+/// GoMoveModel, so a move must have been played before it is added. GoGame
+/// adheres to this rule.
+///
 /// Invoking GoMoveModel methods that add or discard moves generally sets the
 /// GoGameDocument dirty flag.
 // -----------------------------------------------------------------------------
@@ -40,6 +65,10 @@
 - (void) discardMovesFromIndex:(int)index;
 - (void) discardAllMoves;
 - (GoMove*) moveAtIndex:(int)index;
+- (bool) hasMoveBeforeIndex:(int)index withZobristHash:(long long)zobristHash;
+- (bool) hasMoveBeforeIndex:(int)index withZobristHash:(long long)zobristHash playedByColor:(enum GoColor)color;
+- (void) rebuildZobristHashIndex;
+- (struct GoMoveStatistics) statisticsOfFirstMoves:(int)numberOfMoves;
 
 /// @brief Returns the number of moves in the current game. Returns 0 if there
 /// are no moves.
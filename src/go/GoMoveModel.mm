@@ -0,0 +1,486 @@
+// -----------------------------------------------------------------------------
+// Copyright 2012-2015 Patrick Näf (herzbube@herzbube.ch)
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// -----------------------------------------------------------------------------
+
+
+// Project includes
+#import "GoMoveModel.h"
+#import "GoGame.h"
+#import "GoGameDocument.h"
+#import "GoMove.h"
+#import "GoPlayer.h"
+
+// C++ standard library
+#include <unordered_map>
+#include <vector>
+
+
+/// @brief Maps the Zobrist hash of a board position to the index of the first
+/// move in the move list that resulted in that board position.
+typedef std::unordered_map<long long, int> ZobristHashIndex;
+
+/// @brief Stores the statistics of the first N moves in the move list at
+/// position N. The first element is always present and contains the
+/// statistics of zero moves.
+typedef std::vector<GoMoveStatistics> MoveStatisticsList;
+
+
+// -----------------------------------------------------------------------------
+/// @brief Class extension with private properties for GoMoveModel.
+// -----------------------------------------------------------------------------
+@interface GoMoveModel()
+{
+@private
+  /// @brief Indexes the Zobrist hashes of all moves in the move list.
+  ZobristHashIndex* _zobristHashIndex;
+  /// @brief Indexes the Zobrist hashes of the moves in the move list that were
+  /// made by the black player.
+  ZobristHashIndex* _blackZobristHashIndex;
+  /// @brief Indexes the Zobrist hashes of the moves in the move list that were
+  /// made by the white player.
+  ZobristHashIndex* _whiteZobristHashIndex;
+  /// @brief The running totals of the move statistics. Is empty if the running
+  /// totals are not known yet, e.g. after the move list was unarchived.
+  MoveStatisticsList* _moveStatisticsList;
+}
+/// @name Private properties
+//@{
+@property(nonatomic, assign) GoGame* game;
+@property(nonatomic, retain) NSMutableArray* moveList;
+//@}
+/// @name Re-declaration of properties to make them readwrite privately
+//@{
+@property(nonatomic, assign, readwrite) int numberOfMoves;
+//@}
+@end
+
+
+@implementation GoMoveModel
+
+// -----------------------------------------------------------------------------
+/// @brief Initializes a GoMoveModel object that is associated with @a game.
+///
+/// @note This is the designated initializer of GoMoveModel.
+// -----------------------------------------------------------------------------
+- (id) initWithGame:(GoGame*)game
+{
+  // Call designated initializer of superclass (NSObject)
+  self = [super init];
+  if (! self)
+    return nil;
+  self.game = game;
+  self.moveList = [NSMutableArray arrayWithCapacity:0];
+  self.numberOfMoves = 0;
+  [self setupZobristHashIndexes];
+  [self setupMoveStatisticsList];
+  // The running totals of an empty move list are known
+  _moveStatisticsList->push_back(GoMoveStatistics());
+  return self;
+}
+
+// -----------------------------------------------------------------------------
+/// @brief NSCoding protocol method.
+// -----------------------------------------------------------------------------
+- (id) initWithCoder:(NSCoder*)decoder
+{
+  self = [super init];
+  if (! self)
+    return nil;
+
+  if ([decoder decodeIntForKey:nscodingVersionKey] != nscodingVersion)
+    return nil;
+  self.game = [decoder decodeObjectForKey:goMoveModelGameKey];
+  self.moveList = [decoder decodeObjectForKey:goMoveModelMoveListKey];
+  self.numberOfMoves = [decoder decodeIntForKey:goMoveModelNumberOfMovesKey];
+  // Zobrist hashes are not archived, so there is nothing useful to index at
+  // this point. Whoever unarchives the game must invoke
+  // rebuildZobristHashIndex() after re-calculating the hashes.
+  [self setupZobristHashIndexes];
+  // The moves in the list are not necessarily fully decoded at this point, so
+  // the running totals are calculated only when they are needed for the first
+  // time
+  [self setupMoveStatisticsList];
+
+  return self;
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Deallocates memory allocated by this GoMoveModel object.
+// -----------------------------------------------------------------------------
+- (void) dealloc
+{
+  self.game = nil;
+  self.moveList = nil;
+  delete _zobristHashIndex;
+  delete _blackZobristHashIndex;
+  delete _whiteZobristHashIndex;
+  delete _moveStatisticsList;
+  [super dealloc];
+}
+
+// -----------------------------------------------------------------------------
+/// @brief This is an internal helper invoked during initialization.
+// -----------------------------------------------------------------------------
+- (void) setupZobristHashIndexes
+{
+  _zobristHashIndex = new ZobristHashIndex();
+  _blackZobristHashIndex = new ZobristHashIndex();
+  _whiteZobristHashIndex = new ZobristHashIndex();
+}
+
+// -----------------------------------------------------------------------------
+/// @brief This is an internal helper invoked during initialization.
+// -----------------------------------------------------------------------------
+- (void) setupMoveStatisticsList
+{
+  _moveStatisticsList = new MoveStatisticsList();
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Adds the GoMove object @a move to this model.
+///
+/// Raises @e NSInvalidArgumentException if @a move is nil.
+///
+/// Invoking this method sets the GoGameDocument dirty flag.
+// -----------------------------------------------------------------------------
+- (void) appendMove:(GoMove*)move
+{
+  [_moveList addObject:move];
+  // Cast is required because NSUInteger and int differ in size in 64-bit. Cast
+  // is safe because this app was not made to handle more than pow(2, 31) moves.
+  [self addMove:move atIndexToZobristHashIndexes:(int)_moveList.count - 1];
+  [self addMoveToMoveStatisticsList:move];
+  self.game.document.dirty = true;
+  // Cast is required because NSUInteger and int differ in size in 64-bit. Cast
+  // is safe because this app was not made to handle more than pow(2, 31) moves.
+  self.numberOfMoves = (int)_moveList.count;  // triggers KVO observers
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Discards the last GoMove object in this model.
+///
+/// Raises @e NSRangeException if there are no GoMove objects in this model.
+///
+/// Invoking this method sets the GoGameDocument dirty flag.
+// -----------------------------------------------------------------------------
+- (void) discardLastMove
+{
+  // Cast is required because NSUInteger and int differ in size in 64-bit. Cast
+  // is safe because this app was not made to handle more than pow(2, 31) moves.
+  [self discardMovesFromIndex:((int)_moveList.count - 1)];  // raises exception and posts notification for us
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Discards all GoMove objects in this model starting with the object
+/// at position @a index.
+///
+/// Raises @e NSRangeException if @a index is <0 or exceeds the number of
+/// GoMove objects in this model.
+///
+/// Invoking this method sets the GoGameDocument dirty flag.
+// -----------------------------------------------------------------------------
+- (void) discardMovesFromIndex:(int)index
+{
+  if (index < 0)
+  {
+    NSString* errorMessage = [NSString stringWithFormat:@"Index %d must not be <0", index];
+    DDLogError(@"%@: %@", self, errorMessage);
+    NSException* exception = [NSException exceptionWithName:NSRangeException
+                                                     reason:errorMessage
+                                                   userInfo:nil];
+    @throw exception;
+  }
+  if (index >= _moveList.count)
+  {
+    NSString* errorMessage = [NSString stringWithFormat:@"Index %d must not exceed number of moves %lu", index, (unsigned long)_moveList.count];
+    DDLogError(@"%@: %@", self, errorMessage);
+    NSException* exception = [NSException exceptionWithName:NSRangeException
+                                                     reason:errorMessage
+                                                   userInfo:nil];
+    @throw exception;
+  }
+
+  NSUInteger numberOfMovesToDiscard = _moveList.count - index;
+  while (numberOfMovesToDiscard > 0)
+  {
+    // Cast is required because NSUInteger and int differ in size in 64-bit.
+    // Cast is safe because this app was not made to handle more than
+    // pow(2, 31) moves.
+    [self removeMove:[_moveList lastObject] atIndexFromZobristHashIndexes:(int)_moveList.count - 1];
+    [_moveList removeLastObject];
+    --numberOfMovesToDiscard;
+  }
+  if (! _moveStatisticsList->empty())
+    _moveStatisticsList->resize(_moveList.count + 1);
+
+  self.game.document.dirty = true;
+  // Cast is required because NSUInteger and int differ in size in 64-bit. Cast
+  // is safe because this app was not made to handle more than pow(2, 31) moves.
+  self.numberOfMoves = (int)_moveList.count;  // triggers KVO observers
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Discards all GoMove objects in this model.
+///
+/// Raises @e NSRangeException if there are no GoMove objects in this model.
+///
+/// Invoking this method sets the GoGameDocument dirty flag.
+// -----------------------------------------------------------------------------
+- (void) discardAllMoves
+{
+  [self discardMovesFromIndex:0];  // raises exception and posts notification for us
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Returns the GoMove object located at index position @a index.
+///
+/// Raises @e NSRangeException if @a index is <0 or exceeds the number of
+/// GoMove objects in this model.
+// -----------------------------------------------------------------------------
+- (GoMove*) moveAtIndex:(int)index
+{
+  return [_moveList objectAtIndex:index];
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Returns true if a move located before index position @a index
+/// resulted in a board position with the Zobrist hash @a zobristHash. Returns
+/// false if no such move exists.
+///
+/// This is an O(1) lookup that can be used for positional superko detection.
+// -----------------------------------------------------------------------------
+- (bool) hasMoveBeforeIndex:(int)index withZobristHash:(long long)zobristHash
+{
+  return [self zobristHashIndex:_zobristHashIndex hasMoveBeforeIndex:index withZobristHash:zobristHash];
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Returns true if a move located before index position @a index was
+/// made by the player with color @a color and resulted in a board position
+/// with the Zobrist hash @a zobristHash. Returns false if no such move exists.
+///
+/// This is an O(1) lookup that can be used for situational superko detection.
+// -----------------------------------------------------------------------------
+- (bool) hasMoveBeforeIndex:(int)index withZobristHash:(long long)zobristHash playedByColor:(enum GoColor)color
+{
+  ZobristHashIndex* zobristHashIndex = [self zobristHashIndexForColor:color];
+  if (! zobristHashIndex)
+    return false;
+  return [self zobristHashIndex:zobristHashIndex hasMoveBeforeIndex:index withZobristHash:zobristHash];
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Re-indexes the Zobrist hashes of all moves in this model.
+///
+/// This must be invoked after the Zobrist hashes of moves that are already in
+/// this model have changed, e.g. after a game has been unarchived.
+// -----------------------------------------------------------------------------
+- (void) rebuildZobristHashIndex
+{
+  _zobristHashIndex->clear();
+  _blackZobristHashIndex->clear();
+  _whiteZobristHashIndex->clear();
+  int index = 0;
+  for (GoMove* move in _moveList)
+    [self addMove:move atIndexToZobristHashIndexes:index++];
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Returns the statistics of the first @a numberOfMoves moves in this
+/// model. For instance, the statistics of the moves up to the current board
+/// position are obtained by passing the current board position as the
+/// argument.
+///
+/// This is an O(1) lookup, except for the first lookup after this model was
+/// unarchived.
+///
+/// Raises @e NSRangeException if @a numberOfMoves is <0 or exceeds the number
+/// of GoMove objects in this model.
+// -----------------------------------------------------------------------------
+- (struct GoMoveStatistics) statisticsOfFirstMoves:(int)numberOfMoves
+{
+  if (numberOfMoves < 0 || numberOfMoves > _moveList.count)
+  {
+    NSString* errorMessage = [NSString stringWithFormat:@"Number of moves %d must not be <0 or exceed number of moves %lu", numberOfMoves, (unsigned long)_moveList.count];
+    DDLogError(@"%@: %@", self, errorMessage);
+    NSException* exception = [NSException exceptionWithName:NSRangeException
+                                                     reason:errorMessage
+                                                   userInfo:nil];
+    @throw exception;
+  }
+  if (_moveStatisticsList->empty())
+    [self rebuildMoveStatisticsList];
+  return (*_moveStatisticsList)[numberOfMoves];
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Adds the statistics of @a move, which has just been appended to the
+/// move list, to the running totals. Does nothing if the running totals are
+/// not known yet, they will be calculated from scratch when they are needed.
+// -----------------------------------------------------------------------------
+- (void) addMoveToMoveStatisticsList:(GoMove*)move
+{
+  if (_moveStatisticsList->empty())
+    return;
+  GoMoveStatistics moveStatistics = _moveStatisticsList->back();
+  bool moveByBlack = move.player.black;
+  switch (move.type)
+  {
+    case GoMoveTypePlay:
+    {
+      // Cast is required because NSUInteger and int differ in size in 64-bit.
+      // Cast is safe because the number of captured stones can never exceed
+      // pow(2, 32).
+      int numberOfCapturedStones = (int)move.capturedStones.count;
+      if (moveByBlack)
+      {
+        moveStatistics.stonesPlayedByBlack++;
+        moveStatistics.capturedByBlack += numberOfCapturedStones;
+      }
+      else
+      {
+        moveStatistics.stonesPlayedByWhite++;
+        moveStatistics.capturedByWhite += numberOfCapturedStones;
+      }
+      break;
+    }
+    case GoMoveTypePass:
+    {
+      if (moveByBlack)
+        moveStatistics.passesPlayedByBlack++;
+      else
+        moveStatistics.passesPlayedByWhite++;
+      break;
+    }
+    default:
+      break;
+  }
+  _moveStatisticsList->push_back(moveStatistics);
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Calculates the running totals of the move statistics from scratch.
+// -----------------------------------------------------------------------------
+- (void) rebuildMoveStatisticsList
+{
+  _moveStatisticsList->clear();
+  _moveStatisticsList->reserve(_moveList.count + 1);
+  _moveStatisticsList->push_back(GoMoveStatistics());
+  for (GoMove* move in _moveList)
+    [self addMoveToMoveStatisticsList:move];
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Private helper for hasMoveBeforeIndex:withZobristHash:() and
+/// hasMoveBeforeIndex:withZobristHash:playedByColor:().
+// -----------------------------------------------------------------------------
+- (bool) zobristHashIndex:(ZobristHashIndex*)zobristHashIndex hasMoveBeforeIndex:(int)index withZobristHash:(long long)zobristHash
+{
+  ZobristHashIndex::const_iterator it = zobristHashIndex->find(zobristHash);
+  if (it == zobristHashIndex->end())
+    return false;
+  // The index stores the first move with the hash. If the first move is not
+  // before index, no other move with the same hash can be.
+  return it->second < index;
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Returns the Zobrist hash index for moves made by the player with
+/// color @a color. Returns NULL if @a color is neither black nor white.
+// -----------------------------------------------------------------------------
+- (ZobristHashIndex*) zobristHashIndexForColor:(enum GoColor)color
+{
+  switch (color)
+  {
+    case GoColorBlack:
+      return _blackZobristHashIndex;
+    case GoColorWhite:
+      return _whiteZobristHashIndex;
+    default:
+      return NULL;
+  }
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Adds the Zobrist hash of @a move, which is located at index position
+/// @a index, to the Zobrist hash indexes.
+///
+/// Moves are always appended, so if another move already has the same hash it
+/// is located before @a move and its entry remains in place.
+// -----------------------------------------------------------------------------
+- (void) addMove:(GoMove*)move atIndexToZobristHashIndexes:(int)index
+{
+  long long zobristHash = move.zobristHash;
+  _zobristHashIndex->emplace(zobristHash, index);
+  ZobristHashIndex* zobristHashIndex = [self zobristHashIndexForColor:move.player.color];
+  if (zobristHashIndex)
+    zobristHashIndex->emplace(zobristHash, index);
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Removes the Zobrist hash of @a move, which is located at index
+/// position @a index, from the Zobrist hash indexes.
+///
+/// Moves are always discarded from the end of the move list, so an entry that
+/// refers to @a move can be erased without looking for other moves with the
+/// same hash: Such moves are located after @a move and have already been
+/// discarded.
+// -----------------------------------------------------------------------------
+- (void) removeMove:(GoMove*)move atIndexFromZobristHashIndexes:(int)index
+{
+  long long zobristHash = move.zobristHash;
+  ZobristHashIndex* zobristHashIndexes[] = { _zobristHashIndex, [self zobristHashIndexForColor:move.player.color] };
+  for (ZobristHashIndex* zobristHashIndex : zobristHashIndexes)
+  {
+    if (! zobristHashIndex)
+      continue;
+    ZobristHashIndex::iterator it = zobristHashIndex->find(zobristHash);
+    if (it != zobristHashIndex->end() && it->second == index)
+      zobristHashIndex->erase(it);
+  }
+}
+
+// -----------------------------------------------------------------------------
+// Property is documented in the header file.
+// -----------------------------------------------------------------------------
+- (GoMove*) firstMove
+{
+  if (0 == _moveList.count)
+    return nil;
+  return [_moveList objectAtIndex:0];
+}
+          
+// -----------------------------------------------------------------------------
+// Property is documented in the header file.
+// -----------------------------------------------------------------------------
+- (GoMove*) lastMove
+{
+  if (0 == _moveList.count)
+    return nil;
+  return [_moveList lastObject];
+}
+
+// -----------------------------------------------------------------------------
+/// @brief NSCoding protocol method.
+// -----------------------------------------------------------------------------
+- (void) encodeWithCoder:(NSCoder*)encoder
+{
+  [encoder encodeInt:nscodingVersion forKey:nscodingVersionKey];
+  [encoder encodeObject:self.game forKey:goMoveModelGameKey];
+  [encoder encodeObject:self.moveList forKey:goMoveModelMoveListKey];
+  [encoder encodeInt:self.numberOfMoves forKey:goMoveModelNumberOfMovesKey];
+}
+
+@end
@@ -32,7 +32,8 @@
 /// the intersection, and which color the stone has. Instead of accessing the
 /// technical stoneState() property, one might prefer to query a GoPoint object
 /// for the same information using the more intuitive hasStone() and
-/// blackStone() methods.
+/// blackStone() methods. The stone state itself is stored by GoBoard, i.e.
+/// GoPoint is a view of one intersection of the board.
 ///
 /// The liberties() method behaves differently depending on whether GoPoint is
 /// occupied by a stone: If it is occupied by a stone, the method returns the
@@ -61,6 +62,9 @@
 @property(nonatomic, retain) GoVertex* vertex;
 /// @brief The GoBoard object that the GoPoint is associated with.
 @property(nonatomic, assign) GoBoard* board;
+/// @brief The index position of the intersection that the GoPoint represents,
+/// in the order defined by GoBoard::indexOfPoint:().
+@property(nonatomic, assign, readonly) int index;
 @property(nonatomic, assign, readonly) GoPoint* left;
 @property(nonatomic, assign, readonly) GoPoint* right;
 @property(nonatomic, assign, readonly) GoPoint* above;
@@ -72,10 +76,17 @@
 @property(nonatomic, assign, getter=isStarPoint) bool starPoint;
 /// @brief Denotes whether a stone has been placed on the intersection that the
 /// GoPoint represents, and which color the stone has.
+///
+/// The stone state is not stored in the GoPoint object, it is stored by the
+/// GoBoard object that the GoPoint is associated with.
 @property(nonatomic, assign) enum GoColor stoneState;
 /// @brief The score assigned to this point by the most recent territory
 /// statistics evaluation.
-@property(nonatomic, assign) float territoryStatisticsScore;
+///
+/// This is a convenience accessor for the element of
+/// GoBoard::territoryStatisticsScores that belongs to this point. Clients that
+/// process all points should access the array directly.
+@property(nonatomic, assign, readonly) float territoryStatisticsScore;
 /// @brief The region that the GoPoint belongs to. Is never nil.
 ///
 /// You should never need to change this property by yourself. Instead invoke
@@ -89,9 +89,8 @@
 
   self.vertex = aVertex;
   self.board = aBoard;
+  _index = [GoPoint indexOfVertex:aVertex onBoard:aBoard];
   self.starPoint = false;
-  self.stoneState = GoColorNone;
-  self.territoryStatisticsScore = 0.0f;
   _left = nil;
   _right = nil;
   _above = nil;
@@ -124,6 +123,7 @@
   // GoVertex
   self.vertex = [GoVertex vertexFromString:[decoder decodeObjectForKey:goPointVertexKey]];
   self.board = [decoder decodeObjectForKey:goPointBoardKey];
+  _index = [GoPoint indexOfVertex:self.vertex onBoard:self.board];
   if ([decoder containsValueForKey:goPointIsStarPointKey])
     self.starPoint = true;
   else
@@ -132,10 +132,6 @@
     self.stoneState = [decoder decodeIntForKey:goPointStoneStateKey];
   else
     self.stoneState = GoColorNone;
-  if ([decoder containsValueForKey:goPointTerritoryStatisticsScoreKey])
-    self.territoryStatisticsScore = [decoder decodeFloatForKey:goPointTerritoryStatisticsScoreKey];
-  else
-    self.territoryStatisticsScore = 0.0f;
   self.region = [decoder decodeObjectForKey:goPointRegionKey];
 
   _left = nil;
@@ -182,6 +178,21 @@
   // Unfortunately it is not possible to tell NSArray/NSMutableArray not to
   // retain their objects.
   [(NSMutableArray*)_neighbours removeAllObjects];
+  // The stone state is stored by GoBoard, which is about to be deallocated.
+  // Without a board the GoPoint reports that it has no stone.
+  self.board = nil;
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Returns the index position of the intersection identified by
+/// @a vertex on @a board, in the order defined by GoBoard::indexOfPoint:().
+///
+/// This is a private helper invoked during initialization.
+// -----------------------------------------------------------------------------
++ (int) indexOfVertex:(GoVertex*)vertex onBoard:(GoBoard*)board
+{
+  struct GoVertexNumeric numericVertex = vertex.numeric;
+  return (numericVertex.y - 1) * board.size + (numericVertex.x - 1);
 }
 
 // -----------------------------------------------------------------------------
@@ -194,7 +205,7 @@
 {
   // Don't use self to access properties to avoid unnecessary overhead during
   // debugging
-  return [NSString stringWithFormat:@"GoPoint(%p): vertex = %@, stone state = %d", self, _vertex.string, _stoneState];
+  return [NSString stringWithFormat:@"GoPoint(%p): vertex = %@, stone state = %d", self, _vertex.string, [_board stoneStateAtIndex:_index]];
 }
 
 // -----------------------------------------------------------------------------
@@ -310,6 +321,23 @@
   return _previous;
 }
 
+// -----------------------------------------------------------------------------
+// Property is documented in the header file.
+// -----------------------------------------------------------------------------
+- (enum GoColor) stoneState
+{
+  // Evaluates to GoColorNone if the board has been deallocated
+  return [_board stoneStateAtIndex:_index];
+}
+
+// -----------------------------------------------------------------------------
+// Property is documented in the header file.
+// -----------------------------------------------------------------------------
+- (void) setStoneState:(enum GoColor)stoneState
+{
+  [_board setStoneState:stoneState atIndex:_index];
+}
+
 // -----------------------------------------------------------------------------
 /// @brief Returns true if the intersection represented by this GoPoint is
 /// occupied by a stone.
@@ -329,6 +357,14 @@
   return (GoColorBlack == self.stoneState);
 }
 
+// -----------------------------------------------------------------------------
+// Property is documented in the header file.
+// -----------------------------------------------------------------------------
+- (float) territoryStatisticsScore
+{
+  return self.board.territoryStatisticsScores[_index];
+}
+
 // -----------------------------------------------------------------------------
 /// @brief Returns the number of liberties that the intersection represented by
 /// this GoPoint has. The way how liberties are counted depends on whether the
@@ -343,15 +379,7 @@
   if ([self hasStone])
     return [self.region liberties];
   else
-  {
-    int liberties = 0;
-    for (GoPoint* neighbour in self.neighbours)
-    {
-      if (! [neighbour hasStone])
-        liberties++;
-    }
-    return liberties;
-  }
+    return [self.board libertiesAtIndex:_index];
 }
 
 // -----------------------------------------------------------------------------
@@ -405,8 +433,6 @@
     [encoder encodeBool:self.isStarPoint forKey:goPointIsStarPointKey];
   if (self.stoneState != GoColorNone)
     [encoder encodeInt:self.stoneState forKey:goPointStoneStateKey];
-  if (self.territoryStatisticsScore != 0.0f)
-    [encoder encodeFloat:self.territoryStatisticsScore forKey:goPointTerritoryStatisticsScoreKey];
   [encoder encodeObject:self.region forKey:goPointRegionKey];
 }
 
@@ -99,10 +99,13 @@
 ///   stores the values in GoScore's publicly accessible scoring and statistics
 ///   properties
 ///
-/// @note When GoScore calculates a score for the first time, it asks the GTP
-/// engine for an initial list of dead stones. It is expected that the GTP
-/// engine at least detects dead stones surrounded by unconditionally alive
-/// groups. This query can be suppressed by the user in the user preferences.
+/// @note When GoScore calculates a score for the first time, it determines an
+/// initial list of dead stones. GoScore first estimates locally which stone
+/// groups are dead; the local estimate reliably detects dead stones surrounded
+/// by unconditionally alive groups. Only if the estimate is ambiguous for some
+/// stone groups does GoScore ask the GTP engine, and the GTP engine's answer is
+/// then used for these stone groups only. This step can be suppressed by the
+/// user in the user preferences.
 ///
 ///
 /// @par Mark dead stones intelligently
@@ -20,10 +20,10 @@
 #import "GoBoard.h"
 #import "GoBoardPosition.h"
 #import "GoBoardRegion.h"
+#import "GoBoardRegionGraph.h"
 #import "GoGame.h"
 #import "GoGameRules.h"
-#import "GoMove.h"
-#import "GoPlayer.h"
+#import "GoMoveModel.h"
 #import "GoPoint.h"
 #import "../main/ApplicationDelegate.h"
 #import "../gtp/GtpCommand.h"
@@ -41,6 +41,7 @@
 @property(nonatomic, retain) NSOperationQueue* operationQueue;
 @property(nonatomic, assign) bool didAskGtpEngineForDeadStones;
 @property(nonatomic, assign) bool lastCalculationHadError;
+@property(nonatomic, retain) GoBoardRegionGraph* regionGraph;
 @end
 
 
@@ -122,6 +123,7 @@
 {
   [[NSNotificationCenter defaultCenter] removeObserver:self];
   self.operationQueue = nil;
+  self.regionGraph = nil;
   [super dealloc];
 }
 
@@ -231,10 +233,17 @@
 // -----------------------------------------------------------------------------
 /// @brief Private helper for enableScoring(), enableScoringOnAppLaunch() and
 /// didChangeBoardPosition().
+///
+/// Also builds the region adjacency graph that toggleDeadStateOfStoneGroup:()
+/// traverses. The graph remains valid as long as scoring mode is enabled
+/// because the board does not change while scoring.
 // -----------------------------------------------------------------------------
 - (void) initializeRegionsRetainTerritory:(bool)retainTerritory
 {
-  NSArray* allRegions = self.game.board.regions;
+  GoBoardRegionGraph* regionGraph = [[GoBoardRegionGraph alloc] initWithBoard:self.game.board];
+  self.regionGraph = regionGraph;
+  [regionGraph release];
+  NSArray* allRegions = regionGraph.regions;
   DDLogVerbose(@"%@: initializing GoBoardRegion objects, number of regions = %lu", self, (unsigned long)allRegions.count);
   for (GoBoardRegion* region in allRegions)
   {
@@ -251,6 +260,7 @@
 // -----------------------------------------------------------------------------
 - (void) uninitializeRegions
 {
+  self.regionGraph = nil;
   NSArray* allRegions = self.game.board.regions;
   DDLogVerbose(@"%@: uninitializing GoBoardRegion objects, number of regions = %lu", self, (unsigned long)allRegions.count);
   for (GoBoardRegion* region in allRegions)
@@ -449,8 +459,19 @@
 }
 
 // -----------------------------------------------------------------------------
-/// @brief Queries the GTP engine for an initial set of dead stones. Updates
-/// GoBoardRegion objects with the result of the query.
+/// @brief Determines an initial set of dead stones. Updates GoBoardRegion
+/// objects with the result.
+///
+/// First estimates locally which stone groups are dead, using Benson's
+/// algorithm, eye space heuristics and the territory statistics of the GTP
+/// engine (see GoBoard::estimateStoneGroupStates:()). The GTP engine is
+/// queried only if the estimate is ambiguous for at least one stone group,
+/// and the engine's answer is used only for the ambiguous stone groups.
+///
+/// The notifications #askGtpEngineForDeadStonesStarts and
+/// #askGtpEngineForDeadStonesEnds are posted even if the GTP engine is not
+/// queried, so that observers receive the pair every time the initial set of
+/// dead stones is determined.
 // -----------------------------------------------------------------------------
 - (void) askGtpEngineForDeadStones
 {
@@ -460,6 +481,63 @@
     return;
   self.didAskGtpEngineForDeadStones = true;
 
+  GoBoard* board = self.game.board;
+  int numberOfIntersections = board.size * board.size;
+  enum GoStoneGroupState* estimatedStoneGroupStates = (enum GoStoneGroupState*)malloc(numberOfIntersections * sizeof(enum GoStoneGroupState));
+  @try
+  {
+    CFTimeInterval estimateStartTime = CACurrentMediaTime();
+    [board estimateStoneGroupStates:estimatedStoneGroupStates];
+    CFTimeInterval estimateDuration = CACurrentMediaTime() - estimateStartTime;
+
+    int numberOfAmbiguousStoneGroups = 0;
+    for (GoBoardRegion* region in board.regions)
+    {
+      if (! [region isStoneGroup])
+        continue;
+      GoPoint* point = region.points.firstObject;
+      enum GoStoneGroupState estimatedStoneGroupState = estimatedStoneGroupStates[point.index];
+      if (GoStoneGroupStateDead == estimatedStoneGroupState)
+        region.stoneGroupState = GoStoneGroupStateDead;
+      else if (GoStoneGroupStateUndefined == estimatedStoneGroupState)
+        ++numberOfAmbiguousStoneGroups;
+    }
+
+    if (0 == numberOfAmbiguousStoneGroups)
+    {
+      DDLogInfo(@"%@: Dead stones estimated in %.3f ms, GTP engine not queried", self, estimateDuration * 1000);
+      [self performSelector:@selector(postNotificationOnMainThread:)
+                   onThread:[NSThread mainThread]
+                 withObject:askGtpEngineForDeadStonesStarts
+              waitUntilDone:YES];
+      [self performSelector:@selector(postNotificationOnMainThread:)
+                   onThread:[NSThread mainThread]
+                 withObject:askGtpEngineForDeadStonesEnds
+              waitUntilDone:YES];
+      return;
+    }
+    [self askGtpEngineForDeadStonesWithEstimatedStoneGroupStates:estimatedStoneGroupStates
+                                                estimateDuration:estimateDuration];
+  }
+  @finally
+  {
+    free(estimatedStoneGroupStates);
+  }
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Private helper for askGtpEngineForDeadStones(). Queries the GTP
+/// engine for dead stones. Updates those GoBoardRegion objects with the result
+/// of the query whose state could not be estimated locally, i.e. whose element
+/// in @a estimatedStoneGroupStates is #GoStoneGroupStateUndefined.
+///
+/// Also logs how long the local estimate (@a estimateDuration) and the query
+/// took, and for how many of the stones with an unambiguous local estimate
+/// the GTP engine agrees with the estimate.
+// -----------------------------------------------------------------------------
+- (void) askGtpEngineForDeadStonesWithEstimatedStoneGroupStates:(const enum GoStoneGroupState*)estimatedStoneGroupStates
+                                               estimateDuration:(CFTimeInterval)estimateDuration
+{
   @try
   {
     self.askGtpEngineForDeadStonesInProgress = true;
@@ -467,20 +545,37 @@
                  onThread:[NSThread mainThread]
                withObject:askGtpEngineForDeadStonesStarts
             waitUntilDone:YES];
+    CFTimeInterval queryStartTime = CACurrentMediaTime();
     GtpCommand* command = [GtpCommand command:@"final_status_list dead"];
+    command.role = GtpEngineRoleScoring;
+    // The user waits for the result, and the query does not change the GTP
+    // engine's position, so it may preempt a long-running command
+    command.priority = GtpCommandPriorityInteractive;
     [command submit];
+    GoBoard* board = self.game.board;
+    NSData* deadStoneBoardIndexes = nil;
     if (command.response.status)
+      deadStoneBoardIndexes = [command.response boardIndexesWithBoardSize:board.size];
+    CFTimeInterval queryDuration = CACurrentMediaTime() - queryStartTime;
+    if (deadStoneBoardIndexes)
     {
-      NSArray* deadStoneVertexList = [self parseDeadStoneGtpResponse:command.response.parsedResponse];
-      for (NSString* vertex in deadStoneVertexList)
+      int numberOfIntersections = board.size * board.size;
+      NSMutableData* isDeadStoneData = [NSMutableData dataWithLength:numberOfIntersections * sizeof(bool)];
+      bool* isDeadStone = (bool*)isDeadStoneData.mutableBytes;
+      const int* boardIndexes = (const int*)deadStoneBoardIndexes.bytes;
+      NSUInteger numberOfDeadStones = deadStoneBoardIndexes.length / sizeof(int);
+      for (NSUInteger index = 0; index < numberOfDeadStones; ++index)
       {
-        GoPoint* point = [self.game.board pointAtVertex:vertex];
+        GoPoint* point = [board pointAtIndex:boardIndexes[index]];
         if (! [point hasStone])
         {
-          DDLogError(@"%@: GTP engine reports vertex %@ is dead stone, but point %@ has no stone", self, vertex, point);
+          DDLogError(@"%@: GTP engine reports point %@ is dead stone, but point has no stone", self, point);
           assert(0);
           continue;
         }
+        isDeadStone[boardIndexes[index]] = true;
+        if (GoStoneGroupStateUndefined != estimatedStoneGroupStates[boardIndexes[index]])
+          continue;
         // TODO The next statement is problematic in two respects: 1) If the
         // region has more than one point, we repeatedly set it to be dead,
         // once for each vertex reported by the GTP engine. 2) We don't perform
@@ -488,6 +583,19 @@
         // matches our regions.
         point.region.stoneGroupState = GoStoneGroupStateDead;
       }
+
+      int numberOfEstimatedStones = 0;
+      int numberOfAgreements = 0;
+      for (int index = 0; index < numberOfIntersections; ++index)
+      {
+        if (GoStoneGroupStateUndefined == estimatedStoneGroupStates[index])
+          continue;
+        ++numberOfEstimatedStones;
+        if (isDeadStone[index] == (GoStoneGroupStateDead == estimatedStoneGroupStates[index]))
+          ++numberOfAgreements;
+      }
+      DDLogInfo(@"%@: Dead stones estimated in %.3f ms, GTP engine queried in %.3f ms, GTP engine agrees with estimate for %d of %d stones",
+                self, estimateDuration * 1000, queryDuration * 1000, numberOfAgreements, numberOfEstimatedStones);
     }
     else
     {
@@ -562,32 +670,6 @@
   [[NSNotificationCenter defaultCenter] postNotificationName:notificationName object:nil];
 }
 
-// -----------------------------------------------------------------------------
-/// @brief Parses @a gtpResponse, which is expected to be the response to the
-/// command "final_status_list dead", for strings that denote vertexes. Returns
-/// a list with all vertexes found.
-// -----------------------------------------------------------------------------
-- (NSArray*) parseDeadStoneGtpResponse:(NSString*)gtpResponse
-{
-  NSMutableArray* deadStoneVertexList = [NSMutableArray arrayWithCapacity:0];
-  if (0 == gtpResponse.length)
-    return deadStoneVertexList;
-  NSArray* responseLines = [gtpResponse componentsSeparatedByString:@"\n"];
-  for (NSString* responseLine in responseLines)
-  {
-    if (0 == responseLine.length)
-      continue;
-    NSArray* vertexList = [responseLine componentsSeparatedByString:@" "];
-    for (NSString* vertex in vertexList)
-    {
-      if (0 == vertex.length)
-        continue;
-      [deadStoneVertexList addObject:vertex];
-    }
-  }
-  return deadStoneVertexList;
-}
-
 // -----------------------------------------------------------------------------
 /// @brief Toggles the status of the stone group @a stoneGroup from alive to
 /// dead, or vice versa. If @a stoneGroup is in seki, its status is changed to
@@ -618,24 +700,37 @@
 
   bool markDeadStonesIntelligently = [ApplicationDelegate sharedDelegate].scoringModel.markDeadStonesIntelligently;
 
-  // We use this array like a queue: We add GoBoardRegion objects to it that
+  // The traversal works with the region IDs of the graph that was built when
+  // scoring mode was enabled, not with the GoBoardRegion objects themselves
+  if (! self.regionGraph)
+    self.regionGraph = [[[GoBoardRegionGraph alloc] initWithBoard:self.game.board] autorelease];
+  GoBoardRegionGraph* regionGraph = self.regionGraph;
+  int numberOfRegions = regionGraph.numberOfRegions;
+
+  // We use this array like a queue: We add the IDs of stone groups to it that
   // need to be toggled, and we loop until the queue is empty. In each iteration
-  // new GoBoardRegion objects may be added to the queue which will cause the
-  // loop to run longer.
-  NSMutableArray* stoneGroupsToToggle = [NSMutableArray arrayWithCapacity:0];
+  // new stone groups may be added to the queue which will cause the loop to
+  // run longer. Because a region is never added twice (see below), the queue
+  // cannot hold more elements than there are regions.
+  NSMutableData* stoneGroupsToToggleData = [NSMutableData dataWithLength:numberOfRegions * sizeof(int)];
+  int* stoneGroupsToToggle = (int*)stoneGroupsToToggleData.mutableBytes;
+  int indexOfNextStoneGroupToToggle = 0;
+  int numberOfStoneGroupsToToggle = 0;
   // And this array is the guard that prevents an infinite loop: Whenever a
-  // GoBoardRegion object is processed by the loop, it puts the processed object
-  // into this array. Before the loop starts processing a GoBoardRegion object,
-  // though, it looks into the array to see if the object has already been
-  // processed in an earlier iteration.
-  NSMutableArray* regionsAlreadyProcessed = [NSMutableArray arrayWithCapacity:0];
-
-  [stoneGroupsToToggle addObject:stoneGroup];
-  [regionsAlreadyProcessed addObject:stoneGroup];
-  while (stoneGroupsToToggle.count > 0)
+  // region is processed by the loop, it is marked as processed in this array.
+  // Before the loop starts processing a region, though, it looks into the
+  // array to see if the region has already been processed in an earlier
+  // iteration.
+  NSMutableData* isRegionAlreadyProcessedData = [NSMutableData dataWithLength:numberOfRegions * sizeof(bool)];
+  bool* isRegionAlreadyProcessed = (bool*)isRegionAlreadyProcessedData.mutableBytes;
+
+  int stoneGroupId = [regionGraph regionIdOfRegion:stoneGroup];
+  stoneGroupsToToggle[numberOfStoneGroupsToToggle++] = stoneGroupId;
+  isRegionAlreadyProcessed[stoneGroupId] = true;
+  while (indexOfNextStoneGroupToToggle < numberOfStoneGroupsToToggle)
   {
-    GoBoardRegion* stoneGroupToToggle = [stoneGroupsToToggle objectAtIndex:0];
-    [stoneGroupsToToggle removeObjectAtIndex:0];
+    int stoneGroupToToggleId = stoneGroupsToToggle[indexOfNextStoneGroupToToggle++];
+    GoBoardRegion* stoneGroupToToggle = [regionGraph regionWithId:stoneGroupToToggleId];
 
     enum GoStoneGroupState newStoneGroupState;
     switch (stoneGroupToToggle.stoneGroupState)
@@ -655,63 +750,62 @@
         continue;
     }
     stoneGroupToToggle.stoneGroupState = newStoneGroupState;
-    enum GoColor colorOfStoneGroupToToggle = [stoneGroupToToggle color];
+    enum GoColor colorOfStoneGroupToToggle = [regionGraph colorOfRegionWithId:stoneGroupToToggleId];
 
     // If the user has decided that he does not need any help with toggling,
     // we can abort the whole process now
     if (! markDeadStonesIntelligently)
       break;
 
-    // Collect stone groups that are either directly adjacent to the stone
+    // Examine stone groups that are either directly adjacent to the stone
     // group we just toggled ("once removed"), or separated from it by an
-    // intermediate empty region ("twice removed").
-    NSMutableArray* adjacentStoneGroupsToExamine = [NSMutableArray arrayWithCapacity:0];
-    for (GoBoardRegion* adjacentRegionOnceRemoved in [stoneGroupToToggle adjacentRegions])
-    {
-      if ([regionsAlreadyProcessed containsObject:adjacentRegionOnceRemoved])
-        continue;
-      [regionsAlreadyProcessed addObject:adjacentRegionOnceRemoved];
-      if ([adjacentRegionOnceRemoved color] != GoColorNone)
-        [adjacentStoneGroupsToExamine addObject:adjacentRegionOnceRemoved];
-      else
-      {
-        for (GoBoardRegion* adjacentRegionTwiceRemoved in [adjacentRegionOnceRemoved adjacentRegions])
-        {
-          if ([regionsAlreadyProcessed containsObject:adjacentRegionTwiceRemoved])
-            continue;
-          [regionsAlreadyProcessed addObject:adjacentRegionTwiceRemoved];
-          if ([adjacentRegionTwiceRemoved color] == GoColorNone)
-          {
-            DDLogError(@"%@: Inconsistency - regions adjacent to an empty region cannot be empty, too, adjacent empty region = %@", self, adjacentRegionTwiceRemoved);
-            assert(0);
-          }
-          else
-            [adjacentStoneGroupsToExamine addObject:adjacentRegionTwiceRemoved];
-        }
-      }
-    }
-
-    // Now examine the collected stone groups and, if necessary, toggle their
-    // dead/alive state:
+    // intermediate empty region ("twice removed"), and if necessary, toggle
+    // their dead/alive state:
     // - Stone groups of the same color need to get into the same state
     // - In theory, stone groups of the opposing color need to get into the
     //   opposite state, but doing this has too much effect, so for the moment
     //   we ignore the opposing color
     // See the "Mark dead stones intelligently" section in the class
     // documentation for details.
-    for (GoBoardRegion* adjacentStoneGroupToExamine in adjacentStoneGroupsToExamine)
+    int numberOfRegionsOnceRemoved = [regionGraph numberOfAdjacentRegionsOfRegionWithId:stoneGroupToToggleId];
+    const int* regionsOnceRemoved = [regionGraph adjacentRegionIdsOfRegionWithId:stoneGroupToToggleId];
+    for (int indexOnceRemoved = 0; indexOnceRemoved < numberOfRegionsOnceRemoved; ++indexOnceRemoved)
     {
-      if (! [adjacentStoneGroupToExamine isStoneGroup])
+      int regionOnceRemovedId = regionsOnceRemoved[indexOnceRemoved];
+      if (isRegionAlreadyProcessed[regionOnceRemovedId])
+        continue;
+      isRegionAlreadyProcessed[regionOnceRemovedId] = true;
+      enum GoColor colorOfRegionOnceRemoved = [regionGraph colorOfRegionWithId:regionOnceRemovedId];
+      if (colorOfRegionOnceRemoved != GoColorNone)
       {
-        DDLogError(@"%@: Error in previous loop, we should have collected only stone groups, adjacent empty region = %@", self, adjacentStoneGroupToExamine);
-        assert(0);
+        if (colorOfRegionOnceRemoved == colorOfStoneGroupToToggle
+            && [regionGraph regionWithId:regionOnceRemovedId].stoneGroupState != newStoneGroupState)
+        {
+          stoneGroupsToToggle[numberOfStoneGroupsToToggle++] = regionOnceRemovedId;
+        }
         continue;
       }
-      enum GoColor colorOfAdjacentStoneGroupToExamine = [adjacentStoneGroupToExamine color];
-      if (colorOfAdjacentStoneGroupToExamine == colorOfStoneGroupToToggle)
+
+      int numberOfRegionsTwiceRemoved = [regionGraph numberOfAdjacentRegionsOfRegionWithId:regionOnceRemovedId];
+      const int* regionsTwiceRemoved = [regionGraph adjacentRegionIdsOfRegionWithId:regionOnceRemovedId];
+      for (int indexTwiceRemoved = 0; indexTwiceRemoved < numberOfRegionsTwiceRemoved; ++indexTwiceRemoved)
       {
-        if (adjacentStoneGroupToExamine.stoneGroupState != newStoneGroupState)
-          [stoneGroupsToToggle addObject:adjacentStoneGroupToExamine];
+        int regionTwiceRemovedId = regionsTwiceRemoved[indexTwiceRemoved];
+        if (isRegionAlreadyProcessed[regionTwiceRemovedId])
+          continue;
+        isRegionAlreadyProcessed[regionTwiceRemovedId] = true;
+        enum GoColor colorOfRegionTwiceRemoved = [regionGraph colorOfRegionWithId:regionTwiceRemovedId];
+        if (colorOfRegionTwiceRemoved == GoColorNone)
+        {
+          DDLogError(@"%@: Inconsistency - regions adjacent to an empty region cannot be empty, too, adjacent empty region = %@", self, [regionGraph regionWithId:regionTwiceRemovedId]);
+          assert(0);
+          continue;
+        }
+        if (colorOfRegionTwiceRemoved == colorOfStoneGroupToToggle
+            && [regionGraph regionWithId:regionTwiceRemovedId].stoneGroupState != newStoneGroupState)
+        {
+          stoneGroupsToToggle[numberOfStoneGroupsToToggle++] = regionTwiceRemovedId;
+        }
       }
     }
   }
@@ -776,11 +870,15 @@
 
   // Regions that are truly empty, i.e. that do not have dead stones
   NSMutableArray* emptyRegions = [NSMutableArray arrayWithCapacity:0];
+  // The state of the stone group on each intersection, as input for pass 2
+  GoBoard* board = self.game.board;
+  int numberOfIntersections = board.size * board.size;
+  enum GoStoneGroupState* stoneGroupStates = (enum GoStoneGroupState*)calloc(numberOfIntersections, sizeof(enum GoStoneGroupState));
 
   // Pass 1: Set territory colors for stone groups. This is easy and can be
   // done both for groups that are alive and dead. While we are at it, we can
   // also collect empty regions, which will be processed in pass 2.
-  NSArray* allRegions = self.game.board.regions;
+  NSArray* allRegions = board.regions;
   for (GoBoardRegion* region in allRegions)
   {
     if (! [region isStoneGroup])
@@ -817,6 +915,7 @@
               break;
             default:
               DDLogError(@"%@: Stone groups must be either black or white, region %@ has color %d", self, region, [region color]);
+              free(stoneGroupStates);
               return false;
           }
           break;
@@ -834,170 +933,36 @@
         default:
         {
           DDLogError(@"%@: Unknown stone group state = %d", self, region.stoneGroupState);
+          free(stoneGroupStates);
           return false;
         }
       }
+      for (GoPoint* point in region.points)
+        stoneGroupStates[point.index] = region.stoneGroupState;
     }
   }
 
   // Pass 2: Process empty regions. Here we examine the stone groups adjacent
   // to each empty region to determine the empty region's final territory color.
+  // GoBoard does this for all empty regions at once with bitboard flood
+  // fills, so we don't have to collect the adjacent regions of each empty
+  // region. All points of an empty region get the same result, so we can look
+  // at an arbitrary point of the region.
+  enum GoColor* territoryColors = (enum GoColor*)malloc(numberOfIntersections * sizeof(enum GoColor));
+  bool* territoryInconsistencies = (bool*)malloc(numberOfIntersections * sizeof(bool));
+  [board analyzeTerritoryWithStoneGroupStates:stoneGroupStates
+                                scoringSystem:scoringSystem
+                              territoryColors:territoryColors
+                     territoryInconsistencies:territoryInconsistencies];
   for (GoBoardRegion* emptyRegion in emptyRegions)
   {
-    bool aliveSeen = false;
-    bool blackAliveSeen = false;
-    bool whiteAliveSeen = false;
-    bool deadSeen = false;
-    bool blackDeadSeen = false;
-    bool whiteDeadSeen = false;
-    bool sekiSeen = false;
-    bool blackSekiSeen = false;
-    bool whiteSekiSeen = false;
-    for (GoBoardRegion* adjacentRegion in [emptyRegion adjacentRegions])
-    {
-      if (! [adjacentRegion isStoneGroup])
-      {
-        DDLogError(@"%@: Regions adjacent to an empty region can only be stone groups, adjacent region = %@", self, adjacentRegion);
-        return false;
-      }
-
-      // Preliminary sanity check. The fact that only two colors can occur makes
-      // the subsequent logic simpler.
-      enum GoColor adjacentRegionColor = [adjacentRegion color];
-      if (GoColorBlack != adjacentRegionColor && GoColorWhite != adjacentRegionColor)
-      {
-        DDLogError(@"%@: Stone groups must be either black or white, adjacent stone group region %@ has color %d", self, adjacentRegion, adjacentRegionColor);
-        return false;
-      }
-
-      switch (adjacentRegion.stoneGroupState)
-      {
-        case GoStoneGroupStateAlive:
-        {
-          aliveSeen = true;
-          if (GoColorBlack == adjacentRegionColor)
-            blackAliveSeen = true;
-          else
-            whiteAliveSeen = true;
-          break;
-        }
-        case GoStoneGroupStateDead:
-        {
-          deadSeen = true;
-          if (GoColorBlack == adjacentRegionColor)
-            blackDeadSeen = true;
-          else
-            whiteDeadSeen = true;
-          break;
-        }
-        case GoStoneGroupStateSeki:
-        {
-          sekiSeen = true;
-          if (GoColorBlack == adjacentRegionColor)
-            blackSekiSeen = true;
-          else
-            whiteSekiSeen = true;
-          break;
-        }
-        default:
-        {
-          DDLogError(@"%@: Unknown stone group state = %d", self, adjacentRegion.stoneGroupState);
-          return false;
-        }
-      }
-    }
-
-    bool territoryInconsistencyFound = false;
-    enum GoColor territoryColor = GoColorNone;
-    if (! deadSeen)
-    {
-      if (! aliveSeen && ! sekiSeen)
-      {
-        // Ok, empty board, neutral territory
-        territoryColor = GoColorNone;
-      }
-      else if ((blackSekiSeen && blackAliveSeen) || (whiteSekiSeen && whiteAliveSeen))
-      {
-        // Rules violation! Cannot see alive and seki stones of the same
-        // color. In such a position, the seki stones could, theoretically,
-        // be connected to the alive stones. The opposing player therefore
-        // MUST play so that no connection is possible and this position
-        // cannot occur.
-        territoryInconsistencyFound = true;
-      }
-      else if ((blackSekiSeen && whiteAliveSeen) || (whiteSekiSeen && blackAliveSeen))
-      {
-        // Rules violation! Cannot see alive and seki stones of different
-        // colors. In all seki positions and examples that I could find,
-        // seki stones are always completely surrounded, the only liberties
-        // being their own eyes, or liberties shared with seki stones of
-        // the other color. The opposing player therefore MUST play and fill
-        // in all liberties around the seki stones.
-        territoryInconsistencyFound = true;
-      }
-      else if ((blackSekiSeen && whiteSekiSeen) || (blackAliveSeen && whiteAliveSeen))
-      {
-        // Ok, dame, neutral territory
-        territoryColor = GoColorNone;
-      }
-      else if (sekiSeen)
-      {
-        // Ok, only one color has been seen, and all groups were in seki
-        if (GoScoringSystemAreaScoring == scoringSystem)
-        {
-          // Area scoring counts this as territory
-          if (blackSekiSeen)
-            territoryColor = GoColorBlack;
-          else
-            territoryColor = GoColorWhite;
-        }
-        else
-        {
-          // Territory scoring counts this as neutral territory
-          territoryColor = GoColorNone;
-        }
-      }
-      else
-      {
-        // Ok, only one color has been seen, and all groups were alive
-        if (blackAliveSeen)
-          territoryColor = GoColorBlack;
-        else
-          territoryColor = GoColorWhite;
-      }
-    }
-    else
-    {
-      if (sekiSeen)
-      {
-        // Rules violation! Cannot see dead and seki stones at the same time
-        territoryInconsistencyFound = true;
-      }
-      else if (blackDeadSeen && whiteDeadSeen)
-      {
-        // Rules violation! Cannot see dead stones of both colors
-        territoryInconsistencyFound = true;
-      }
-      else if ((blackDeadSeen && blackAliveSeen) || (whiteDeadSeen && whiteAliveSeen))
-      {
-        // Rules violation! Cannot see both dead and alive stones of the same
-        // color
-        territoryInconsistencyFound = true;
-      }
-      else
-      {
-        // Ok, only dead stones of one color seen (we don't care whether the
-        // opposing color has alive stones)
-        if (blackDeadSeen)
-          territoryColor = GoColorWhite;
-        else
-          territoryColor = GoColorBlack;
-      }
-    }
-
-    emptyRegion.territoryColor = territoryColor;
-    emptyRegion.territoryInconsistencyFound = territoryInconsistencyFound;
+    GoPoint* point = emptyRegion.points.firstObject;
+    emptyRegion.territoryColor = territoryColors[point.index];
+    emptyRegion.territoryInconsistencyFound = territoryInconsistencies[point.index];
   }
+  free(territoryInconsistencies);
+  free(territoryColors);
+  free(stoneGroupStates);
 
   return true;
 }
@@ -1016,62 +981,18 @@
   self.komi = self.game.komi;
 
   // Captured stones (up to the current board position) and move statistics (for
-  // the entire game)
-  self.numberOfMoves = 0;
-  GoMove* currentBoardPositionMove = self.game.boardPosition.currentMove;
-  bool loopHasPassedCurrentBoardPosition = false;
-  GoMove* move = self.game.lastMove;
-  while (move != nil)
-  {
-    if (! loopHasPassedCurrentBoardPosition)
-    {
-      if (move == currentBoardPositionMove)
-        loopHasPassedCurrentBoardPosition = true;
-    }
-
-    self.numberOfMoves++;
-    bool moveByBlack = move.player.black;
-    switch (move.type)
-    {
-      case GoMoveTypePlay:
-      {
-        if (moveByBlack)
-        {
-          if (loopHasPassedCurrentBoardPosition)
-          {
-            // Cast is required because NSUInteger and int differ in size in
-            // 64-bit. Cast is safe because the number of captured stones can
-            // never exceed pow(2, 32).
-            self.capturedByBlack += (int)move.capturedStones.count;
-          }
-          self.stonesPlayedByBlack++;
-        }
-        else
-        {
-          if (loopHasPassedCurrentBoardPosition)
-          {
-            // Cast is required because NSUInteger and int differ in size in
-            // 64-bit. Cast is safe because the number of captured stones can
-            // never exceed pow(2, 32).
-            self.capturedByWhite += (int)move.capturedStones.count;
-          }
-          self.stonesPlayedByWhite++;
-        }
-        break;
-      }
-      case GoMoveTypePass:
-      {
-        if (moveByBlack)
-          self.passesPlayedByBlack++;
-        else
-          self.passesPlayedByWhite++;
-        break;
-      }
-      default:
-        break;
-    }
-    move = move.previous;
-  }
+  // the entire game). GoMoveModel keeps running totals, so we don't have to
+  // iterate over the moves.
+  GoMoveModel* moveModel = self.game.moveModel;
+  struct GoMoveStatistics gameStatistics = [moveModel statisticsOfFirstMoves:moveModel.numberOfMoves];
+  struct GoMoveStatistics boardPositionStatistics = [moveModel statisticsOfFirstMoves:self.game.boardPosition.currentBoardPosition];
+  self.numberOfMoves = moveModel.numberOfMoves;
+  self.stonesPlayedByBlack = gameStatistics.stonesPlayedByBlack;
+  self.stonesPlayedByWhite = gameStatistics.stonesPlayedByWhite;
+  self.passesPlayedByBlack = gameStatistics.passesPlayedByBlack;
+  self.passesPlayedByWhite = gameStatistics.passesPlayedByWhite;
+  self.capturedByBlack = boardPositionStatistics.capturedByBlack;
+  self.capturedByWhite = boardPositionStatistics.capturedByWhite;
 
   // Area, territory & dead stones (for current board position)
   if ([ApplicationDelegate sharedDelegate].uiSettingsModel.uiAreaPlayMode == UIAreaPlayModeScoring)
@@ -0,0 +1,187 @@
+// -----------------------------------------------------------------------------
+// Copyright 2026 Patrick Näf (herzbube@herzbube.ch)
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// -----------------------------------------------------------------------------
+
+
+// Project includes
+#include "GoTerritoryEngine.h"
+
+
+// -----------------------------------------------------------------------------
+/// @brief Initializes a GoTerritoryEngine object that analyzes the stones in
+/// @a core. Initially no stones are dead and no stones are in seki.
+///
+/// @a core must outlive the GoTerritoryEngine object.
+// -----------------------------------------------------------------------------
+GoTerritoryEngine::GoTerritoryEngine(const GoBoardCore& core)
+  : core(core)
+{
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Sets the positions of the stones that are dead.
+// -----------------------------------------------------------------------------
+void GoTerritoryEngine::setDeadStones(const GoBoardCore::Bitboard& deadStones)
+{
+  this->deadStones = deadStones;
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Sets the positions of the stones that are in seki.
+// -----------------------------------------------------------------------------
+void GoTerritoryEngine::setSekiStones(const GoBoardCore::Bitboard& sekiStones)
+{
+  this->sekiStones = sekiStones;
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Finds all areas of empty intersections and returns for each area
+/// the territory color and whether an inconsistency was found. The scoring
+/// system @a scoringSystem decides whether areas that are surrounded by stones
+/// in seki count as territory.
+// -----------------------------------------------------------------------------
+std::vector<GoTerritoryEngine::EmptyArea> GoTerritoryEngine::analyzeTerritory(ScoringSystem scoringSystem) const
+{
+  std::vector<EmptyArea> emptyAreas;
+  GoBoardCore::Bitboard remainingEmptyPositions = core.emptyPositions();
+  while (remainingEmptyPositions.any())
+  {
+    int boardIndex = core.boardIndexOfPosition(remainingEmptyPositions.firstPosition());
+    EmptyArea emptyArea;
+    emptyArea.positions = core.groupAt(boardIndex);
+    evaluateBorderFlags(borderFlagsOfArea(emptyArea.positions), scoringSystem, emptyArea);
+    emptyAreas.push_back(emptyArea);
+    remainingEmptyPositions &= ~emptyArea.positions;
+  }
+  return emptyAreas;
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Private helper for analyzeTerritory(). Returns a combination of
+/// BorderFlag values that describes which stones border the area of empty
+/// intersections @a area.
+// -----------------------------------------------------------------------------
+int GoTerritoryEngine::borderFlagsOfArea(const GoBoardCore::Bitboard& area) const
+{
+  // The area is a maximal set of connected empty intersections, so all of its
+  // neighbours that are not in the area itself are stones
+  GoBoardCore::Bitboard border = core.neighbourPositions(area) & ~area;
+  GoBoardCore::Bitboard aliveStones = ~(deadStones | sekiStones);
+  GoBoardCore::Bitboard blackBorder = border & core.stones(GoBoardCore::ColorBlack);
+  GoBoardCore::Bitboard whiteBorder = border & core.stones(GoBoardCore::ColorWhite);
+
+  int borderFlags = 0;
+  if ((blackBorder & aliveStones).any())
+    borderFlags |= BlackAliveSeen;
+  if ((whiteBorder & aliveStones).any())
+    borderFlags |= WhiteAliveSeen;
+  if ((blackBorder & deadStones).any())
+    borderFlags |= BlackDeadSeen;
+  if ((whiteBorder & deadStones).any())
+    borderFlags |= WhiteDeadSeen;
+  if ((blackBorder & sekiStones).any())
+    borderFlags |= BlackSekiSeen;
+  if ((whiteBorder & sekiStones).any())
+    borderFlags |= WhiteSekiSeen;
+  return borderFlags;
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Private helper for analyzeTerritory(). Determines the territory
+/// color of @a emptyArea, and whether an inconsistency was found, from the
+/// stones that border the area, which are described by @a borderFlags.
+// -----------------------------------------------------------------------------
+void GoTerritoryEngine::evaluateBorderFlags(int borderFlags, ScoringSystem scoringSystem, EmptyArea& emptyArea)
+{
+  bool blackAliveSeen = (borderFlags & BlackAliveSeen);
+  bool whiteAliveSeen = (borderFlags & WhiteAliveSeen);
+  bool blackDeadSeen = (borderFlags & BlackDeadSeen);
+  bool whiteDeadSeen = (borderFlags & WhiteDeadSeen);
+  bool blackSekiSeen = (borderFlags & BlackSekiSeen);
+  bool whiteSekiSeen = (borderFlags & WhiteSekiSeen);
+  bool aliveSeen = blackAliveSeen || whiteAliveSeen;
+  bool deadSeen = blackDeadSeen || whiteDeadSeen;
+  bool sekiSeen = blackSekiSeen || whiteSekiSeen;
+
+  emptyArea.territoryColor = GoBoardCore::ColorNone;
+  emptyArea.territoryInconsistencyFound = false;
+  if (! deadSeen)
+  {
+    if (! aliveSeen && ! sekiSeen)
+    {
+      // Ok, empty board, neutral territory
+    }
+    else if ((blackSekiSeen && blackAliveSeen) || (whiteSekiSeen && whiteAliveSeen))
+    {
+      // Rules violation! Cannot see alive and seki stones of the same color.
+      // In such a position, the seki stones could, theoretically, be connected
+      // to the alive stones. The opposing player therefore MUST play so that
+      // no connection is possible and this position cannot occur.
+      emptyArea.territoryInconsistencyFound = true;
+    }
+    else if ((blackSekiSeen && whiteAliveSeen) || (whiteSekiSeen && blackAliveSeen))
+    {
+      // Rules violation! Cannot see alive and seki stones of different
+      // colors. In all seki positions and examples that I could find, seki
+      // stones are always completely surrounded, the only liberties being
+      // their own eyes, or liberties shared with seki stones of the other
+      // color. The opposing player therefore MUST play and fill in all
+      // liberties around the seki stones.
+      emptyArea.territoryInconsistencyFound = true;
+    }
+    else if ((blackSekiSeen && whiteSekiSeen) || (blackAliveSeen && whiteAliveSeen))
+    {
+      // Ok, dame, neutral territory
+    }
+    else if (sekiSeen)
+    {
+      // Ok, only one color has been seen, and all groups were in seki. Area
+      // scoring counts this as territory, territory scoring counts this as
+      // neutral territory.
+      if (AreaScoring == scoringSystem)
+        emptyArea.territoryColor = blackSekiSeen ? GoBoardCore::ColorBlack : GoBoardCore::ColorWhite;
+    }
+    else
+    {
+      // Ok, only one color has been seen, and all groups were alive
+      emptyArea.territoryColor = blackAliveSeen ? GoBoardCore::ColorBlack : GoBoardCore::ColorWhite;
+    }
+  }
+  else
+  {
+    if (sekiSeen)
+    {
+      // Rules violation! Cannot see dead and seki stones at the same time
+      emptyArea.territoryInconsistencyFound = true;
+    }
+    else if (blackDeadSeen && whiteDeadSeen)
+    {
+      // Rules violation! Cannot see dead stones of both colors
+      emptyArea.territoryInconsistencyFound = true;
+    }
+    else if ((blackDeadSeen && blackAliveSeen) || (whiteDeadSeen && whiteAliveSeen))
+    {
+      // Rules violation! Cannot see both dead and alive stones of the same
+      // color
+      emptyArea.territoryInconsistencyFound = true;
+    }
+    else
+    {
+      // Ok, only dead stones of one color seen (we don't care whether the
+      // opposing color has alive stones)
+      emptyArea.territoryColor = blackDeadSeen ? GoBoardCore::ColorWhite : GoBoardCore::ColorBlack;
+    }
+  }
+}
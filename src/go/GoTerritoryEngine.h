@@ -0,0 +1,99 @@
+// -----------------------------------------------------------------------------
+// Copyright 2026 Patrick Näf (herzbube@herzbube.ch)
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// -----------------------------------------------------------------------------
+
+
+#pragma once
+
+// Project includes
+#include "GoBoardCore.h"
+
+// System includes
+#include <vector>
+
+// -----------------------------------------------------------------------------
+/// @brief The GoTerritoryEngine class determines during scoring which
+/// territory each area of empty intersections belongs to.
+///
+/// @ingroup go
+///
+/// GoTerritoryEngine operates on the stones in a GoBoardCore object. The
+/// client tells GoTerritoryEngine which stones are dead and which stones are
+/// in seki, all other stones are considered to be alive. analyzeTerritory()
+/// then finds all areas of empty intersections and, for each area, determines
+/// the territory color and whether the stones that border the area are
+/// consistent with each other. An area is dame if it has no territory color
+/// and no inconsistency was found.
+///
+/// The work is done with bitboards: Each area of empty intersections is found
+/// with a flood fill that grows the area one 64-bit word at a time, and the
+/// stones that border the area are found by intersecting the neighbours of
+/// the area with one bitboard for each combination of stone color and stone
+/// group state. No stone groups have to be enumerated, and no adjacency lists
+/// have to be built.
+///
+/// GoTerritoryEngine is plain C++ and does not depend on Foundation.
+// -----------------------------------------------------------------------------
+class GoTerritoryEngine
+{
+public:
+  /// @brief Enumerates the scoring systems. The values match the values of the
+  /// corresponding #GoScoringSystem enumeration values.
+  enum ScoringSystem
+  {
+    AreaScoring = 0,
+    TerritoryScoring = 1
+  };
+
+  /// @brief The result of analyzing one area of empty intersections.
+  struct EmptyArea
+  {
+    /// @brief The positions of the intersections in the area.
+    GoBoardCore::Bitboard positions;
+    /// @brief The territory that the area belongs to. Is
+    /// GoBoardCore::ColorNone if the area is neutral, or if an inconsistency
+    /// was found.
+    GoBoardCore::Color territoryColor;
+    /// @brief True if the stones that border the area are in states that
+    /// contradict each other.
+    bool territoryInconsistencyFound;
+  };
+
+  explicit GoTerritoryEngine(const GoBoardCore& core);
+
+  void setDeadStones(const GoBoardCore::Bitboard& deadStones);
+  void setSekiStones(const GoBoardCore::Bitboard& sekiStones);
+  std::vector<EmptyArea> analyzeTerritory(ScoringSystem scoringSystem) const;
+
+private:
+  /// @brief Enumerates the flags that describe which stones border an area of
+  /// empty intersections.
+  enum BorderFlag
+  {
+    BlackAliveSeen = 0x01,
+    WhiteAliveSeen = 0x02,
+    BlackDeadSeen = 0x04,
+    WhiteDeadSeen = 0x08,
+    BlackSekiSeen = 0x10,
+    WhiteSekiSeen = 0x20
+  };
+
+  int borderFlagsOfArea(const GoBoardCore::Bitboard& area) const;
+  static void evaluateBorderFlags(int borderFlags, ScoringSystem scoringSystem, EmptyArea& emptyArea);
+
+  const GoBoardCore& core;
+  GoBoardCore::Bitboard deadStones;
+  GoBoardCore::Bitboard sekiStones;
+};
@@ -16,6 +16,7 @@
 
 
 // Forward declarations
+@class GoBoardRegionJournal;
 @class GoGame;
 @class GoGameRules;
 @class GoMove;
@@ -37,6 +38,7 @@
 }
 
 + (void) movePointToNewRegion:(GoPoint*)thePoint;
++ (void) movePointToNewRegion:(GoPoint*)thePoint journal:(GoBoardRegionJournal*)journal;
 + (NSArray*) verticesForHandicap:(int)handicap boardSize:(enum GoBoardSize)boardSize;
 + (NSArray*) pointsForHandicap:(int)handicap inGame:(GoGame*)game;
 + (int) maximumHandicapForBoardSize:(enum GoBoardSize)boardSize;
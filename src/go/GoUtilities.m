@@ -20,9 +20,11 @@
 #import "GoBoard.h"
 #import "GoBoardPosition.h"
 #import "GoBoardRegion.h"
+#import "GoBoardRegionJournal.h"
 #import "GoGame.h"
 #import "GoGameRules.h"
 #import "GoMove.h"
+#import "GoMoveModel.h"
 #import "GoPoint.h"
 #import "GoVertex.h"
 #import "GoZobristTable.h"
@@ -34,8 +36,22 @@
 /// @brief Moves @a thePoint to a new GoBoardRegion in response to a change of
 /// GoPoint.stoneState.
 ///
+/// This is a convenience method that invokes
+/// movePointToNewRegion:journal:() without a journal.
+// -----------------------------------------------------------------------------
++ (void) movePointToNewRegion:(GoPoint*)thePoint
+{
+  [GoUtilities movePointToNewRegion:thePoint journal:nil];
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Moves @a thePoint to a new GoBoardRegion in response to a change of
+/// GoPoint.stoneState. Records the changes in @a journal so that they can be
+/// reverted later on.
+///
 /// @a thePoint's stone state already must have its new value at the time this
-/// method is invoked.
+/// method is invoked. @a journal may be nil, in which case no changes are
+/// recorded.
 ///
 /// Effects of this method are:
 /// - @a thePoint is removed from its old GoBoardRegion
@@ -46,9 +62,16 @@
 ///   has been the only link between two or more sub-regions
 /// - @a thePoint's new GoBoardRegion may merge with other regions if
 ///   @a thePoint joins them together
+///
+/// If several neighbouring regions are merged, @a thePoint is added to the
+/// largest of them and the smaller regions are joined with it. Because the
+/// cost of joining is proportional to the size of the joined region, this
+/// keeps the cost of building up large groups stone by stone low.
 // -----------------------------------------------------------------------------
-+ (void) movePointToNewRegion:(GoPoint*)thePoint
++ (void) movePointToNewRegion:(GoPoint*)thePoint journal:(GoBoardRegionJournal*)journal
 {
+  NSArray* neighbours = thePoint.neighbours;
+
   // Step 1: Remove point from old region
   // Note: We must retain/autorelease to make sure that oldRegion survives
   // invocation of removePoint:() one line further down. If we don't retain
@@ -56,37 +79,67 @@
   // cause thePoint's reference to oldRegion to be removed, which in turn will
   // cause oldRegion's retain count to drop to zero, deallocating it.
   GoBoardRegion* oldRegion = [[thePoint.region retain] autorelease];
+  // Remember which neighbours were in the old region so that afterwards we can
+  // find out which regions were split off
+  GoPoint* neighboursInOldRegion[4];
+  int numberOfNeighboursInOldRegion = 0;
+  if (journal)
+  {
+    for (GoPoint* neighbour in neighbours)
+    {
+      if (neighbour.region == oldRegion)
+        neighboursInOldRegion[numberOfNeighboursInOldRegion++] = neighbour;
+    }
+  }
   [oldRegion removePoint:thePoint];  // possible side-effect: oldRegion might be
                                      // split into multiple GoBoardRegion objects
+  if (journal)
+  {
+    NSMutableArray* splitRegions = [NSMutableArray arrayWithCapacity:0];
+    for (int indexOfNeighbour = 0; indexOfNeighbour < numberOfNeighboursInOldRegion; ++indexOfNeighbour)
+    {
+      GoBoardRegion* neighbourRegion = neighboursInOldRegion[indexOfNeighbour].region;
+      if (neighbourRegion != oldRegion && ! [splitRegions containsObject:neighbourRegion])
+        [splitRegions addObject:neighbourRegion];
+    }
+    [journal recordRemovalFromRegion:oldRegion splitRegions:splitRegions];
+  }
 
-  // Step 2: Attempt to add the point to the same region as one of its
-  // neighbours. At the same time, merge regions if they can be joined.
+  // Step 2: Attempt to add the point to the largest region of its neighbours
+  // that have the same stone state (stone state also includes stone color)
   GoBoardRegion* newRegion = nil;
-  for (GoPoint* neighbour in thePoint.neighbours)
+  for (GoPoint* neighbour in neighbours)
   {
-    // Do not consider the neighbour if the stone states do not match (stone
-    // state also includes stone color)
     if (neighbour.stoneState != thePoint.stoneState)
       continue;
-    if (! newRegion)
-    {
-      // Join the region of one of the neighbours
-      newRegion = neighbour.region;
-      [newRegion addPoint:thePoint];
-    }
-    else
+    GoBoardRegion* neighbourRegion = neighbour.region;
+    if (! newRegion || neighbourRegion.size > newRegion.size)
+      newRegion = neighbourRegion;
+  }
+
+  if (newRegion)
+  {
+    [newRegion addPoint:thePoint];
+    // Step 3: Merge the other neighbouring regions with the same stone state
+    // into the region that the point has joined
+    for (GoPoint* neighbour in neighbours)
     {
-      // The stone has already joined a neighbouring region
-      // -> now check if entire regions can be merged
+      if (neighbour.stoneState != thePoint.stoneState)
+        continue;
       GoBoardRegion* neighbourRegion = neighbour.region;
-      if (neighbourRegion != newRegion)
-        [newRegion joinRegion:neighbourRegion];
+      if (neighbourRegion == newRegion)
+        continue;
+      [journal recordJoinOfRegion:neighbourRegion];
+      [newRegion joinRegion:neighbourRegion];
     }
   }
+  else
+  {
+    // Step 4: Still no region? The point forms its own new region!
+    newRegion = [GoBoardRegion regionWithPoint:thePoint];
+  }
 
-  // Step 3: Still no region? The point forms its own new region!
-  if (! newRegion)
-    [GoBoardRegion regionWithPoint:thePoint];
+  [journal recordTargetRegion:newRegion];
 }
 
 // -----------------------------------------------------------------------------
@@ -656,6 +709,7 @@
 
   for (GoMove* move = game.firstMove; move != nil; move = move.next)
     move.zobristHash = [zobristTable hashForMove:move inGame:game];
+  [game.moveModel rebuildZobristHashIndex];
 }
 
 @end
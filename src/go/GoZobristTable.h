@@ -61,5 +61,7 @@
                         capturingStones:(NSArray*)capturedStones
                               afterMove:(GoMove*)move
                                  inGame:(GoGame*)game;
+- (long long) hashForStoneWithColor:(enum GoColor)stoneColor
+                            atIndex:(int)index;
 
 @end
@@ -330,6 +330,22 @@
   return hash;
 }
 
+// -----------------------------------------------------------------------------
+/// @brief Returns the table value that a stone of color @a stoneColor on the
+/// intersection at index position @a index, in the order defined by
+/// GoBoard::indexOfPoint:(), contributes to a Zobrist hash.
+///
+/// Because hashes are combined with XOR, a client can use the value both to add
+/// the stone to, and to remove the stone from, a hash. This method does not
+/// check its arguments because it is intended to be invoked in tight loops.
+// -----------------------------------------------------------------------------
+- (long long) hashForStoneWithColor:(enum GoColor)stoneColor
+                            atIndex:(int)index
+{
+  int color = (GoColorBlack == stoneColor ? 0 : 1);
+  return _zobristTable[(color * _boardSize * _boardSize) + index];
+}
+
 // -----------------------------------------------------------------------------
 /// Private helper
 // -----------------------------------------------------------------------------
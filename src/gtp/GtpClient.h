@@ -20,6 +20,29 @@
 
 // Forward declarations
 @class GtpCommand;
+@class GtpEngineState;
+
+
+// -----------------------------------------------------------------------------
+/// @brief The GtpCommandLaneStatistics struct contains counters that describe
+/// the current state and the history of one of GtpClient's priority lanes.
+///
+/// @ingroup gtp
+///
+/// A "batch" is either a single command submitted via submit:(), or a group
+/// of commands submitted via submitPipelined:(). Wait times are measured in
+/// seconds, from the moment a batch is submitted until GtpClient starts to
+/// process it.
+// -----------------------------------------------------------------------------
+struct GtpCommandLaneStatistics
+{
+  unsigned long queueDepth;                ///< @brief Number of batches currently waiting in the lane.
+  unsigned long maximumQueueDepth;         ///< @brief Highest value that @e queueDepth has ever had.
+  unsigned long numberOfProcessedBatches;  ///< @brief Number of batches that were processed to completion.
+  unsigned long numberOfPreemptions;       ///< @brief Number of times that a batch from the lane was preempted.
+  double totalWaitTime;                    ///< @brief Sum of the wait times of all batches taken from the lane.
+  double maximumWaitTime;                  ///< @brief Longest wait time of any batch taken from the lane.
+};
 
 
 // -----------------------------------------------------------------------------
@@ -38,6 +61,61 @@
 /// property is true, submit:() blocks and waits until after the command has
 /// been processed and its answer was received.
 ///
+/// Commands can also be submitted as a batch via submitPipelined:(). GtpClient
+/// tags each command with a GTP numeric command ID and passes several commands
+/// to the GtpEngine before it starts to read responses, which it then matches
+/// back to their commands by command ID. Commands that are submitted
+/// individually are tagged with a command ID, too. The command ID is not part
+/// of GtpCommand's @e command property, and GtpClient removes the command ID
+/// from the response before it creates the GtpResponse object.
+///
+///
+/// @par Scheduling
+///
+/// GtpClient maintains one queue ("lane") per value of the enumeration
+/// #GtpCommandPriority. A submitted batch goes into the lane that matches the
+/// highest priority of any of its commands. Whenever the secondary thread is
+/// ready to process the next batch, it takes the oldest batch from the lane
+/// with the highest priority that is not empty. Batches in the same lane are
+/// processed in FIFO order, but batches in different lanes may overtake each
+/// other. Most commands use #GtpCommandPriorityNormal, which is also
+/// GtpCommand's default priority.
+///
+/// Overtaking is subject to an ordering barrier so that every batch is
+/// processed on the position for which it was submitted: A batch never
+/// overtakes an earlier batch that changes the GtpEngine's position, and a
+/// batch that changes the position never overtakes an earlier batch. Whether
+/// a batch changes the position is determined with GtpEngineState's
+/// commandMayChangePosition:(). For instance, an interactive query that is
+/// submitted after a "play" command with normal priority waits until "play"
+/// has been processed, and a "play" command does not overtake an earlier
+/// background query. Only queries that are submitted after the latest
+/// position change can therefore overtake each other.
+///
+/// If a batch with priority #GtpCommandPriorityInteractive is submitted while
+/// the GtpEngine is processing a preemptible command (see GtpCommand's
+/// @e preemptible property), GtpClient sends an interrupt to the GtpEngine.
+/// The response to the interrupted command is not delivered to the command's
+/// response target or future, instead GtpClient submits the command's
+/// rollback command (if the command has one and has added a move to the
+/// position), processes the interactive batch, then re-submits the
+/// interrupted command at the front of its lane. The rollback command and
+/// the re-submitted command are exempt from the ordering barrier. The
+/// notifications #gtpCommandWillBeSubmitted and #gtpResponseWasReceived are
+/// posted as usual for every round trip, including the interrupted one.
+///
+/// If the response to the interrupted command shows that the command
+/// completed normally (because it finished just before the interrupt, or
+/// because the GtpEngine lost the interrupt), the response is delivered as
+/// usual and the command is not re-submitted. If the GtpEngine's position has
+/// changed by the time the interrupted command would be re-submitted, the
+/// command is abandoned instead: Its future is cancelled, or if it has no
+/// future its response target receives a failure response. The owner of the
+/// command is then expected to re-plan.
+///
+/// GtpClient keeps statistics for each lane. They can be queried with
+/// statisticsForLane:().
+///
 /// @note As a convenience, GtpCommand is capable of submitting itself so that
 /// clients do not have to concern themselves with where to obtain an instance
 /// of GtpClient.
@@ -72,6 +150,27 @@
 ///
 /// Specification of a response target is optional. If no response target is
 /// specified for a GtpCommand, no private notification is sent.
+///
+///
+/// @par Engine state tracking
+///
+/// GtpClient feeds every response it receives into a GtpEngineState object,
+/// which thus always reflects the position that the GtpEngine holds (or knows
+/// that the position is unknown). Clients that need to bring the GtpEngine
+/// into a certain position can use the @e engineState property to find out
+/// which commands are actually needed, instead of rebuilding the position
+/// from scratch.
+///
+/// Fuego cannot be asked cheaply which position it holds, so GtpClient
+/// answers that question on the engine's behalf. After a client has brought
+/// the GtpEngine into a position, it attaches a fingerprint of that position
+/// with assignPositionFingerprint:toEngineStateWithGeneration:(). Later the
+/// client invokes engineHasPositionWithFingerprint:() to find out whether the
+/// GtpEngine still holds that position, in which case synchronization can be
+/// skipped. Both operations are cheap because they do not copy the engine
+/// state. A client that could bring the GtpEngine only partially into a
+/// position invokes invalidateEngineState() so that nobody relies on the
+/// partial position.
 // -----------------------------------------------------------------------------
 @interface GtpClient : NSObject
 {
@@ -79,10 +178,21 @@
 
 + (GtpClient*) clientWithStreamBuffers:(NSArray*)streamBuffers;
 - (void) submit:(GtpCommand*)command;
+- (void) submitPipelined:(NSArray*)commands;
 - (void) interrupt;
+- (struct GtpCommandLaneStatistics) statisticsForLane:(enum GtpCommandPriority)lane;
+- (bool) engineHasPositionWithFingerprint:(long long)positionFingerprint;
+- (bool) assignPositionFingerprint:(long long)positionFingerprint toEngineStateWithGeneration:(unsigned long long)generation;
+- (void) invalidateEngineState;
 
 /// @brief Set this property to true to trigger termination of the secondary
 /// thread.
 @property(assign, getter=shouldExit, setter=exit:) bool shouldExit;
+/// @brief A snapshot of the position that the GtpEngine currently holds. Each
+/// access returns a new copy that does not change anymore.
+///
+/// The snapshot does not reflect commands that are still waiting in a lane or
+/// that are currently being processed.
+@property(retain, readonly) GtpEngineState* engineState;
 
 @end
@@ -25,24 +25,176 @@
 // Project includes
 #import "GtpClient.h"
 #import "GtpCommand.h"
+#import "GtpEngineState.h"
+#import "GtpFloatGridDecoder.h"
+#import "GtpFuture.h"
 #import "GtpResponse.h"
+#import "GtpResponseFramer.h"
 
 // System includes
-#include <istream>
+#include <climits>
+#include <cstring>
 #include <ostream>
 #include <streambuf>
 
-// It would be much nicer to make these variables members of the GtpClient
-// class, but they are C++ and GtpClient.h is also #import'ed by pure
-// Objective-C implementations.
-static std::ostream* commandStream = nullptr;
-static std::istream* responseStream = nullptr;
+// The maximum number of commands that are passed to the GtpEngine before
+// GtpClient starts to read responses. The limit exists to prevent the
+// GtpEngine from blocking on a full response stream while GtpClient is still
+// blocked on a full command stream.
+static const NSUInteger maximumNumberOfCommandsInFlight = 16;
+// The maximum time in seconds that may pass between sending an interrupt and
+// receiving the response to the interrupted command. If the response takes
+// longer, the GtpEngine has evidently not seen the interrupt and processed the
+// command to completion. This happens, for instance, if the interrupt arrives
+// just before Fuego starts to process the command, because Fuego resets its
+// abort flag whenever it starts to process a command.
+static const CFTimeInterval maximumInterruptResponseTime = 1.0;
+
+// -----------------------------------------------------------------------------
+/// @brief Helper class used by GtpClient to schedule a group of GtpCommand
+/// objects that were submitted together.
+///
+/// The batch's priority is the highest priority of any of its commands. The
+/// batch is preemptible only if it consists of a single preemptible command
+/// whose priority is lower than #GtpCommandPriorityInteractive. The batch
+/// changes the position if at least one of its commands may change the
+/// position (see GtpEngineState's commandMayChangePosition:()).
+// -----------------------------------------------------------------------------
+@interface GtpCommandBatch : NSObject
+{
+}
+- (id) initWithCommands:(NSArray*)commands;
+- (void) dealloc;
+@property(nonatomic, retain) NSArray* commands;
+@property(nonatomic, assign) enum GtpCommandPriority priority;
+@property(nonatomic, assign) bool preemptible;
+@property(nonatomic, assign) bool waitUntilDone;
+/// @brief Is set to true when GtpClient has finished processing the batch.
+/// Is guarded by GtpClient's scheduler condition.
+@property(nonatomic, assign) bool finished;
+/// @brief The time when the batch was added to its lane, as returned by
+/// CACurrentMediaTime().
+@property(nonatomic, assign) CFTimeInterval enqueueTime;
+/// @brief True if at least one of the batch's commands may change the
+/// GtpEngine's position.
+@property(nonatomic, assign) bool changesPosition;
+/// @brief The position of the batch in the order in which batches were
+/// submitted. Is 0 for batches that GtpClient adds to the front of a lane.
+/// Is guarded by GtpClient's scheduler condition.
+@property(nonatomic, assign) unsigned long long sequenceNumber;
+/// @brief Is true if the batch was preempted and waits to be processed again.
+/// Is accessed only by the secondary thread.
+@property(nonatomic, assign) bool wasPreempted;
+/// @brief The generation that the tracked engine state must have when the
+/// preempted batch is processed again. If the generation is different, the
+/// position has changed since the batch was preempted. Is accessed only by the
+/// secondary thread.
+@property(nonatomic, assign) unsigned long long resumptionGeneration;
+/// @brief The preempted batch whose command is rolled back by the command of
+/// this batch. Is nil if this is not a rollback batch.
+@property(nonatomic, retain) GtpCommandBatch* preemptedBatch;
+@end
+
+
+@implementation GtpCommandBatch
+
+// -----------------------------------------------------------------------------
+/// @brief Initializes a GtpCommandBatch object with a copy of @a commands.
+///
+/// @note This is the designated initializer of GtpCommandBatch.
+// -----------------------------------------------------------------------------
+- (id) initWithCommands:(NSArray*)commands
+{
+  // Call designated initializer of superclass (NSObject)
+  self = [super init];
+  if (! self)
+    return nil;
+
+  // Make a copy so that the caller cannot modify the batch after submission
+  self.commands = [[commands copy] autorelease];
+  self.priority = GtpCommandPriorityBulk;
+  self.waitUntilDone = false;
+  self.changesPosition = false;
+  for (GtpCommand* command in commands)
+  {
+    if (command.priority < self.priority)
+      self.priority = command.priority;
+    if (command.waitUntilDone)
+      self.waitUntilDone = true;
+    if ([GtpEngineState commandMayChangePosition:command.command])
+      self.changesPosition = true;
+  }
+  self.preemptible = (1 == commands.count
+                      && [[commands objectAtIndex:0] preemptible]
+                      && GtpCommandPriorityInteractive != self.priority);
+  self.finished = false;
+  self.enqueueTime = 0;
+  self.sequenceNumber = 0;
+  self.wasPreempted = false;
+  self.resumptionGeneration = 0;
+  self.preemptedBatch = nil;
+
+  return self;
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Deallocates memory allocated by this GtpCommandBatch object.
+// -----------------------------------------------------------------------------
+- (void) dealloc
+{
+  self.commands = nil;
+  self.preemptedBatch = nil;
+  [super dealloc];
+}
+
+@end
+
 
 // -----------------------------------------------------------------------------
 /// @brief Class extension with private properties for GtpClient.
 // -----------------------------------------------------------------------------
 @interface GtpClient()
+{
+  bool _shouldExit;
+  struct GtpCommandLaneStatistics _laneStatistics[GtpCommandPriorityMax];
+  // The command stream and the response framer are C++ objects, they can be
+  // members of the GtpClient class only because they are declared in the
+  // class extension. GtpClient.h is also #import'ed by pure Objective-C
+  // implementations.
+  std::ostream* _commandStream;
+  GtpResponseFramer* _responseFramer;
+  // The next command ID to use. Is accessed only by the secondary thread.
+  unsigned int _nextCommandID;
+  // The sequence number of the next batch that is submitted. Is guarded by
+  // the scheduler condition.
+  unsigned long long _nextBatchSequenceNumber;
+}
 @property(retain) NSThread* thread;
+/// @brief Guards the lanes, the lane statistics, the @e finished property of
+/// all batches, and the properties related to preemption. Is signalled
+/// whenever a batch is added to a lane or is finished.
+@property(retain) NSCondition* schedulerCondition;
+/// @brief Array with one NSMutableArray of GtpCommandBatch objects per value
+/// of the enumeration #GtpCommandPriority.
+@property(retain) NSArray* lanes;
+/// @brief Serializes writing to the command stream. Is required because
+/// interrupts are written by threads other than the secondary thread.
+@property(retain) NSLock* commandStreamLock;
+/// @brief The preemptible batch whose command the GtpEngine is currently
+/// processing. Is nil if the GtpEngine is not processing a preemptible
+/// command.
+@property(retain) GtpCommandBatch* preemptibleBatchInFlight;
+/// @brief Is true if an interrupt was sent to the GtpEngine to preempt
+/// @e preemptibleBatchInFlight.
+@property(assign) bool preemptionWasRequested;
+/// @brief The time when the interrupt was sent to preempt
+/// @e preemptibleBatchInFlight, as returned by CACurrentMediaTime().
+@property(assign) CFTimeInterval interruptTime;
+/// @brief The position that the GtpEngine currently holds. Is updated only by
+/// the secondary thread. Is guarded by @e engineStateLock.
+@property(retain) GtpEngineState* trackedEngineState;
+/// @brief Guards @e trackedEngineState.
+@property(retain) NSLock* engineStateLock;
 @end
 
 
@@ -71,7 +223,26 @@ static std::istream* responseStream = nullptr;
   if (! self)
     return nil;
 
+  // The condition must exist before the shouldExit property is accessed
+  self.schedulerCondition = [[[NSCondition alloc] init] autorelease];
   self.shouldExit = false;
+  NSMutableArray* lanes = [NSMutableArray arrayWithCapacity:GtpCommandPriorityMax];
+  for (int lane = 0; lane < GtpCommandPriorityMax; ++lane)
+  {
+    [lanes addObject:[NSMutableArray array]];
+    memset(&_laneStatistics[lane], 0, sizeof(_laneStatistics[lane]));
+  }
+  self.lanes = lanes;
+  self.commandStreamLock = [[[NSLock alloc] init] autorelease];
+  _commandStream = nullptr;
+  _responseFramer = nullptr;
+  _nextCommandID = 1;
+  _nextBatchSequenceNumber = 1;
+  self.preemptibleBatchInFlight = nil;
+  self.preemptionWasRequested = false;
+  self.interruptTime = 0;
+  self.trackedEngineState = [[[GtpEngineState alloc] init] autorelease];
+  self.engineStateLock = [[[NSLock alloc] init] autorelease];
 
   // Create and start the thread
   self.thread = [[[NSThread alloc] initWithTarget:self selector:@selector(mainLoop:) object:streamBuffers] autorelease];
@@ -91,12 +262,125 @@ static std::istream* responseStream = nullptr;
 {
   // TODO implement stuff
   self.thread = nil;
+  self.schedulerCondition = nil;
+  self.lanes = nil;
+  self.commandStreamLock = nil;
+  self.preemptibleBatchInFlight = nil;
+  self.trackedEngineState = nil;
+  self.engineStateLock = nil;
   [super dealloc];
 }
 
+// -----------------------------------------------------------------------------
+// Property is documented in the header file.
+// -----------------------------------------------------------------------------
+- (bool) shouldExit
+{
+  [self.schedulerCondition lock];
+  bool shouldExit = _shouldExit;
+  [self.schedulerCondition unlock];
+  return shouldExit;
+}
+
+// -----------------------------------------------------------------------------
+// Property is documented in the header file.
+// -----------------------------------------------------------------------------
+- (void) exit:(bool)shouldExit
+{
+  [self.schedulerCondition lock];
+  _shouldExit = shouldExit;
+  // Wake up the secondary thread if it is waiting for a batch
+  [self.schedulerCondition broadcast];
+  [self.schedulerCondition unlock];
+}
+
+// -----------------------------------------------------------------------------
+// Property is documented in the header file.
+// -----------------------------------------------------------------------------
+- (GtpEngineState*) engineState
+{
+  [self.engineStateLock lock];
+  GtpEngineState* engineState = [[self.trackedEngineState copy] autorelease];
+  [self.engineStateLock unlock];
+  return engineState;
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Returns true if the GtpEngine's position is known and has the
+/// fingerprint @a positionFingerprint. Returns false if not.
+///
+/// The answer does not take into account commands that are still waiting in a
+/// lane or that are currently being processed.
+// -----------------------------------------------------------------------------
+- (bool) engineHasPositionWithFingerprint:(long long)positionFingerprint
+{
+  [self.engineStateLock lock];
+  bool engineHasPosition = [self.trackedEngineState matchesPositionFingerprint:positionFingerprint];
+  [self.engineStateLock unlock];
+  return engineHasPosition;
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Associates the position fingerprint @a positionFingerprint with the
+/// GtpEngine's current position, but only if the position has not changed
+/// since the snapshot with generation @a generation was taken. Returns true if
+/// the fingerprint was assigned, false if not.
+///
+/// The intended usage is that a client takes a snapshot via the
+/// @e engineState property, verifies that the snapshot is the position that
+/// @a positionFingerprint identifies, then invokes this method with the
+/// snapshot's generation.
+// -----------------------------------------------------------------------------
+- (bool) assignPositionFingerprint:(long long)positionFingerprint toEngineStateWithGeneration:(unsigned long long)generation
+{
+  [self.engineStateLock lock];
+  bool positionIsUnchanged = (self.trackedEngineState.generation == generation);
+  if (positionIsUnchanged)
+    [self.trackedEngineState assignPositionFingerprint:positionFingerprint];
+  [self.engineStateLock unlock];
+  return positionIsUnchanged;
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Marks the GtpEngine's position as unknown. Clients invoke this if
+/// they know that the GtpEngine does not hold the position that its responses
+/// suggest, e.g. because only some of the commands that were supposed to
+/// build up a position have succeeded.
+// -----------------------------------------------------------------------------
+- (void) invalidateEngineState
+{
+  [self.engineStateLock lock];
+  [self.trackedEngineState invalidate];
+  [self.engineStateLock unlock];
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Private helper for processBatch:(). Updates the tracked engine state
+/// with the effect of the command of @a response. If @a responseWasFramed is
+/// false the GtpEngine has stopped responding, which makes the engine state
+/// unknown. This method is executed in the secondary thread's context.
+// -----------------------------------------------------------------------------
+- (void) updateEngineStateWithResponse:(GtpResponse*)response responseWasFramed:(bool)responseWasFramed
+{
+  [self.engineStateLock lock];
+  if (responseWasFramed)
+  {
+    [self.trackedEngineState updateWithResponse:response];
+  }
+  else
+  {
+    [self.trackedEngineState invalidate];
+    [self.trackedEngineState forgetParameters];
+  }
+  [self.engineStateLock unlock];
+}
+
 // -----------------------------------------------------------------------------
 /// @brief The secondary thread's main loop method. Returns only after the
 /// @e shouldExit property has been set to true.
+///
+/// The main loop repeatedly takes the next batch from the lanes (blocking if
+/// all lanes are empty) and processes it.
 // -----------------------------------------------------------------------------
 - (void) mainLoop:(NSArray*)streamBuffers
 {
@@ -107,92 +391,725 @@ static std::istream* responseStream = nullptr;
   NSValue* inputStreamBufferAsNSValue = [streamBuffers objectAtIndex:0];
   std::streambuf* inputStreamBuffer = reinterpret_cast<std::streambuf*>([inputStreamBufferAsNSValue pointerValue]);
   std::ostream inputStream(inputStreamBuffer);
-  commandStream = &inputStream;
+  // interrupt() may access the stream from a different thread
+  [self.commandStreamLock lock];
+  _commandStream = &inputStream;
+  [self.commandStreamLock unlock];
 
-  // Stream to read responses from the GTP engine
+  // Framer to read responses from the GTP engine
   NSValue* outputStreamBufferAsNSValue = [streamBuffers objectAtIndex:1];
   std::streambuf* outputStreamBuffer = reinterpret_cast<std::streambuf*>([outputStreamBufferAsNSValue pointerValue]);
-  std::istream outputStream(outputStreamBuffer);
-  responseStream = &outputStream;
-
-  // The timer is required because otherwise the run loop has no input source
-  NSDate* distantFuture = [NSDate distantFuture];
-  NSTimer* distantFutureTimer = [[NSTimer alloc] initWithFireDate:distantFuture
-                                                         interval:1.0
-                                                           target:self
-                                                         selector:@selector(dealloc)   // pseudo selector
-                                                         userInfo:nil
-                                                          repeats:NO];
-  [[NSRunLoop currentRunLoop] addTimer:distantFutureTimer forMode:NSDefaultRunLoopMode];
-  [distantFutureTimer autorelease];
+  GtpResponseFramer responseFramer(outputStreamBuffer);
+  _responseFramer = &responseFramer;
 
   while (true)
   {
     NSAutoreleasePool* loopPool = [[NSAutoreleasePool alloc] init];
-    bool hasInputSources = [[NSRunLoop currentRunLoop] runMode:NSDefaultRunLoopMode
-                                                    beforeDate:distantFuture];
+    GtpCommandBatch* batch = [self dequeueBatch];
+    if (batch)
+    {
+      bool batchWasPreempted = [self processBatch:batch];
+      if (! batchWasPreempted)
+      {
+        if (batch.preemptedBatch)
+          [self rollbackBatchWasProcessed:batch];
+        [self finishBatch:batch];
+      }
+    }
     [loopPool drain];
-    if (! hasInputSources)  // always true, see timer input source above
-      break;
-    if (self.shouldExit)
+    if (! batch)  // shouldExit is true
       break;
   }
 
+  [self finishAbandonedBatches];
+
   // The local objects are auto-destroyed when they go out of scope. Here we
   // forget the global references to these local objects
-  commandStream = nullptr;
-  responseStream = nullptr;
+  [self.commandStreamLock lock];
+  _commandStream = nullptr;
+  _responseFramer = nullptr;
+  [self.commandStreamLock unlock];
 
   // Deallocate the autorelease pool as the very last thing in this thread
   [mainPool drain];
 }
 
 // -----------------------------------------------------------------------------
-/// @brief Processes the GTP command @a command. This method is executed in the
+/// @brief Private helper for mainLoop:(). Removes the next batch to process
+/// from its lane and returns the batch. Blocks while all lanes are empty.
+/// Returns nil if the @e shouldExit property is true. This method is executed
+/// in the secondary thread's context.
+///
+/// See laneOfNextBatch() for how the next batch is selected.
+// -----------------------------------------------------------------------------
+- (GtpCommandBatch*) dequeueBatch
+{
+  GtpCommandBatch* batch = nil;
+  [self.schedulerCondition lock];
+  while (! _shouldExit)
+  {
+    int lane = [self laneOfNextBatch];
+    if (lane >= 0)
+    {
+      NSMutableArray* queue = [self.lanes objectAtIndex:lane];
+      // Keep the batch alive after it was removed from the queue
+      batch = [[[queue objectAtIndex:0] retain] autorelease];
+      [queue removeObjectAtIndex:0];
+
+      CFTimeInterval dequeueTime = CACurrentMediaTime();
+      for (GtpCommand* command in batch.commands)
+        command.dequeueTime = dequeueTime;
+
+      struct GtpCommandLaneStatistics& statistics = _laneStatistics[lane];
+      statistics.queueDepth--;
+      double waitTime = dequeueTime - batch.enqueueTime;
+      statistics.totalWaitTime += waitTime;
+      if (waitTime > statistics.maximumWaitTime)
+        statistics.maximumWaitTime = waitTime;
+      break;
+    }
+    [self.schedulerCondition wait];
+  }
+  [self.schedulerCondition unlock];
+  return batch;
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Private helper for dequeueBatch(). Returns the lane whose oldest
+/// batch is to be processed next, or -1 if all lanes are empty.
+///
+/// Usually this is the lane with the highest priority that is not empty.
+/// However, a batch must not overtake an earlier batch that changes the
+/// GtpEngine's position, otherwise the batch would be processed on a position
+/// other than the one for which it was submitted. For the same reason a batch
+/// that changes the position must not overtake any earlier batch. The oldest
+/// batch of a lane is therefore skipped if it would violate one of these
+/// rules, in which case a lane with lower priority is selected.
+///
+/// Batches that GtpClient adds to the front of a lane as part of a preemption
+/// (the rollback batch and the preempted batch itself) are exempt from the
+/// submission order. The rollback batch restores the position on which the
+/// preempted command was started, and a preempted batch that finds that the
+/// position has changed is abandoned anyway (see abandonPreemptedBatch:()).
+///
+/// The caller must hold the lock of the scheduler condition.
+// -----------------------------------------------------------------------------
+- (int) laneOfNextBatch
+{
+  unsigned long long oldestSequenceNumber = ULLONG_MAX;
+  unsigned long long oldestPositionChangingSequenceNumber = ULLONG_MAX;
+  for (NSArray* queue in self.lanes)
+  {
+    for (GtpCommandBatch* batch in queue)
+    {
+      if ([self isBatchExemptFromSubmissionOrder:batch])
+        continue;
+      if (batch.sequenceNumber < oldestSequenceNumber)
+        oldestSequenceNumber = batch.sequenceNumber;
+      if (batch.changesPosition && batch.sequenceNumber < oldestPositionChangingSequenceNumber)
+        oldestPositionChangingSequenceNumber = batch.sequenceNumber;
+    }
+  }
+
+  for (int lane = 0; lane < GtpCommandPriorityMax; ++lane)
+  {
+    NSArray* queue = [self.lanes objectAtIndex:lane];
+    if (0 == queue.count)
+      continue;
+    // Batches in the same lane are in submission order, so only the oldest
+    // batch of the lane can be eligible
+    GtpCommandBatch* batch = [queue objectAtIndex:0];
+    if ([self isBatchExemptFromSubmissionOrder:batch])
+      return lane;
+    if (batch.changesPosition)
+    {
+      if (batch.sequenceNumber == oldestSequenceNumber)
+        return lane;
+    }
+    else
+    {
+      if (batch.sequenceNumber < oldestPositionChangingSequenceNumber)
+        return lane;
+    }
+  }
+
+  // The oldest batch of all lanes is always eligible, so we get here only if
+  // all lanes are empty
+  return -1;
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Private helper for laneOfNextBatch(). Returns true if @a batch was
+/// added to its lane as part of a preemption, false if @a batch was
+/// submitted by a client.
+// -----------------------------------------------------------------------------
+- (bool) isBatchExemptFromSubmissionOrder:(GtpCommandBatch*)batch
+{
+  return (batch.wasPreempted || nil != batch.preemptedBatch);
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Adds @a batch to the lane that matches the batch's priority. If
+/// @a toFront is true the batch is added to the front of the lane, otherwise
+/// to the back. Wakes up the secondary thread if it is waiting for a batch.
+///
+/// The caller must hold the lock of the scheduler condition.
+// -----------------------------------------------------------------------------
+- (void) addBatch:(GtpCommandBatch*)batch toFrontOfLane:(bool)toFront
+{
+  batch.enqueueTime = CACurrentMediaTime();
+  // A batch that is added to the front of its lane takes part in a
+  // preemption and keeps the sequence number that it already has
+  if (! toFront)
+    batch.sequenceNumber = _nextBatchSequenceNumber++;
+  NSMutableArray* queue = [self.lanes objectAtIndex:batch.priority];
+  if (toFront)
+    [queue insertObject:batch atIndex:0];
+  else
+    [queue addObject:batch];
+
+  struct GtpCommandLaneStatistics& statistics = _laneStatistics[batch.priority];
+  statistics.queueDepth++;
+  if (statistics.queueDepth > statistics.maximumQueueDepth)
+    statistics.maximumQueueDepth = statistics.queueDepth;
+
+  [self.schedulerCondition broadcast];
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Private helper for mainLoop:(). Marks @a batch as finished and wakes
+/// up the thread that waits for the batch, if there is one. This method is
+/// executed in the secondary thread's context.
+// -----------------------------------------------------------------------------
+- (void) finishBatch:(GtpCommandBatch*)batch
+{
+  [self.schedulerCondition lock];
+  batch.finished = true;
+  _laneStatistics[batch.priority].numberOfProcessedBatches++;
+  [self.schedulerCondition broadcast];
+  [self.schedulerCondition unlock];
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Private helper for mainLoop:(). Discards all batches that are still
+/// waiting in the lanes when the secondary thread exits, and wakes up the
+/// threads that wait for these batches. This method is executed in the
 /// secondary thread's context.
+// -----------------------------------------------------------------------------
+- (void) finishAbandonedBatches
+{
+  [self.schedulerCondition lock];
+  for (int lane = 0; lane < GtpCommandPriorityMax; ++lane)
+  {
+    NSMutableArray* queue = [self.lanes objectAtIndex:lane];
+    if (queue.count > 0)
+      DDLogWarn(@"Discarding %lu batches with priority %d because the GTP client is exiting", (unsigned long)queue.count, lane);
+    for (GtpCommandBatch* batch in queue)
+      batch.finished = true;
+    [queue removeAllObjects];
+    _laneStatistics[lane].queueDepth = 0;
+  }
+  [self.schedulerCondition broadcast];
+  [self.schedulerCondition unlock];
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Private helper for mainLoop:(). Processes the GTP commands in
+/// @a batch. Returns true if the batch was preempted, false if the batch was
+/// processed to completion. This method is executed in the secondary thread's
+/// context.
 ///
 /// Performs the following operations:
-/// - Pass @a command to the GtpEngine
-/// - Wait for the response from the GtpEngine (blocks)
-/// - Creates a GtpResponse object using the response received from the
-///   GtpEngine
-/// - If requested, invokes notifyResponseTarget:() to notify an observer
-///   object that the response has been received; the notification occurs in
-///   the context of the thread that submitted the command
+/// - Tag each command with a numeric command ID, then pass up to
+///   #maximumNumberOfCommandsInFlight commands to the GtpEngine in one go.
+///   The command stream is flushed only once per group of commands, i.e. the
+///   GtpEngine is woken up only once.
+/// - Wait for the responses from the GtpEngine (blocks). The GtpEngine
+///   processes commands sequentially, but the responses are nevertheless
+///   matched to their commands by command ID.
+/// - If the command requests it, decode the response into a float grid
+///   while the response is still in the receive buffer
+/// - For each response, invoke processResponse:lineOffsets:floatGrid:toCommand:()
+/// - Repeat until all commands have been processed
+///
+/// If a "quit" command is encountered, commands that follow it are not sent to
+/// the GtpEngine because the GtpEngine will not respond anymore after it has
+/// processed "quit".
+///
+/// If the batch is preemptible, a preemption can occur while the GtpEngine is
+/// processing the batch's command. In that case the response is passed to
+/// processResponse:lineOffsets:toPreemptedCommand:inBatch:() instead of
+/// processResponse:lineOffsets:floatGrid:toCommand:().
+///
+/// A batch that was preempted earlier is processed again only if the
+/// GtpEngine's position has not changed since the preemption. Otherwise the
+/// batch is abandoned, see abandonPreemptedBatch:().
 // -----------------------------------------------------------------------------
-- (void) processCommand:(GtpCommand*)command
+- (bool) processBatch:(GtpCommandBatch*)batch
 {
-  // Undo retain message sent to the command object by submit:()
-  [command autorelease];
+  if (batch.wasPreempted)
+  {
+    batch.wasPreempted = false;
+    if (! [self canResumePreemptedBatch:batch])
+    {
+      [self abandonPreemptedBatch:batch];
+      return false;
+    }
+  }
 
-  // Notify observers in the secondary thread context
-  [[NSNotificationCenter defaultCenter] postNotificationName:gtpCommandWillBeSubmittedNotification
-                                                      object:command];
+  NSArray* commands = batch.commands;
+  NSUInteger numberOfCommands = commands.count;
+  NSUInteger indexOfNextCommandToSend = 0;
+  NSMutableArray* commandsInFlight = [NSMutableArray arrayWithCapacity:maximumNumberOfCommandsInFlight];
+  bool quitCommandWasSent = false;
 
-  // Send the command to the engine
-  if (nil == command.command || 0 == [command.command length])
-    return;
-  const char* pchCommand = [command.command cStringUsingEncoding:[NSString defaultCStringEncoding]];
-  (*commandStream) << pchCommand << std::endl;  // this wakes up the engine
-  
-  // Read the engine's response (blocking if necessary)
-  std::string fullResponse;
-  std::string singleLineResponse;
   while (true)
   {
-    getline(*responseStream, singleLineResponse);
-    if (singleLineResponse.empty())
+    NSUInteger indexOfFirstCommandSentInThisRound = commandsInFlight.count;
+    bool commandWasSent = false;
+    while (! quitCommandWasSent
+           && indexOfNextCommandToSend < numberOfCommands
+           && commandsInFlight.count < maximumNumberOfCommandsInFlight)
+    {
+      GtpCommand* command = [commands objectAtIndex:indexOfNextCommandToSend];
+      indexOfNextCommandToSend++;
+
+      if (command.future.isCancelled)
+      {
+        DDLogInfo(@"Skipping %@ because it was cancelled", command);
+        command.future = nil;
+        continue;
+      }
+
+      // Notify observers in the secondary thread context
+      [[NSNotificationCenter defaultCenter] postNotificationName:gtpCommandWillBeSubmittedNotification
+                                                          object:command];
+
+      if (nil == command.command || 0 == [command.command length])
+        continue;
+
+      command.commandID = _nextCommandID++;
+      // Command ID 0 is reserved to mean "no command ID"
+      if (0 == _nextCommandID)
+        _nextCommandID = 1;
+
+      const char* pchCommand = [command.command cStringUsingEncoding:[NSString defaultCStringEncoding]];
+      [self.commandStreamLock lock];
+      (*_commandStream) << command.commandID << ' ' << pchCommand << '\n';
+      [self.commandStreamLock unlock];
+      [commandsInFlight addObject:command];
+      commandWasSent = true;
+
+      if (NSOrderedSame == [command.command compare:@"quit"])
+        quitCommandWasSent = true;
+    }
+
+    if (commandWasSent)
+    {
+      [self.commandStreamLock lock];
+      _commandStream->flush();  // this wakes up the engine
+      [self.commandStreamLock unlock];
+      CFTimeInterval writeTime = CACurrentMediaTime();
+      for (NSUInteger indexOfCommand = indexOfFirstCommandSentInThisRound; indexOfCommand < commandsInFlight.count; ++indexOfCommand)
+        [[commandsInFlight objectAtIndex:indexOfCommand] setWriteTime:writeTime];
+      if (batch.preemptible)
+        [self beginPreemptibleSectionForBatch:batch];
+    }
+
+    if (0 == commandsInFlight.count)
       break;
-    if (! fullResponse.empty())
-      fullResponse += "\n";
-    fullResponse += singleLineResponse;
+
+    CFTimeInterval firstByteTime = 0;
+    unsigned int responseCommandID = 0;
+    NSData* lineOffsets = nil;
+    NSString* nsResponse = [self readResponseWithFirstByteTime:&firstByteTime
+                                                      commandID:&responseCommandID
+                                                    lineOffsets:&lineOffsets];
+
+    GtpCommand* command = nil;
+    for (GtpCommand* commandInFlight in commandsInFlight)
+    {
+      if (commandInFlight.commandID == responseCommandID)
+      {
+        command = commandInFlight;
+        break;
+      }
+    }
+    if (! command)
+    {
+      // The GtpEngine processes commands in the order in which it receives
+      // them, so if it fails to echo the command ID we can still fall back to
+      // the oldest command
+      command = [commandsInFlight objectAtIndex:0];
+      DDLogWarn(@"Response has unexpected command ID %u, assuming response is to %@", responseCommandID, command);
+    }
+    // Keep the command alive while we process the response
+    [[command retain] autorelease];
+    [commandsInFlight removeObject:command];
+    command.firstByteTime = firstByteTime;
+    command.completionTime = CACurrentMediaTime();
+
+    if (batch.preemptible && [self endPreemptibleSectionWithFirstByteTime:firstByteTime])
+    {
+      [self processResponse:nsResponse lineOffsets:lineOffsets toPreemptedCommand:command inBatch:batch];
+      return true;
+    }
+
+    // A response that was not framed (lineOffsets is nil) is a placeholder
+    // that is not located in the framer's buffer
+    NSData* floatGrid = nil;
+    if (command.floatGridSize > 0 && lineOffsets)
+      floatGrid = [self floatGridFromCurrentResponseWithSize:command.floatGridSize];
+
+    [self processResponse:nsResponse lineOffsets:lineOffsets floatGrid:floatGrid toCommand:command];
+  }
+
+  if (quitCommandWasSent)
+  {
+    if (indexOfNextCommandToSend < numberOfCommands)
+      DDLogWarn(@"Not sending %lu commands that follow the quit command", (unsigned long)(numberOfCommands - indexOfNextCommandToSend));
+
+    // After the current method is executed, the main loop will find that the
+    // flag is true and stop running
+    self.shouldExit = true;
+  }
+
+  return false;
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Private helper for processBatch:(). Is invoked after the command
+/// of the preemptible batch @a batch has been passed to the GtpEngine. From
+/// now on until endPreemptibleSection() is invoked, submitting an interactive
+/// batch causes a preemption. If an interactive batch is already waiting, the
+/// preemption occurs immediately. This method is executed in the secondary
+/// thread's context.
+// -----------------------------------------------------------------------------
+- (void) beginPreemptibleSectionForBatch:(GtpCommandBatch*)batch
+{
+  [self.schedulerCondition lock];
+  self.preemptibleBatchInFlight = batch;
+  NSArray* interactiveLane = [self.lanes objectAtIndex:GtpCommandPriorityInteractive];
+  bool interruptIsRequired = (interactiveLane.count > 0 && [self requestPreemptionIfNecessary]);
+  [self.schedulerCondition unlock];
+  if (interruptIsRequired)
+    [self interrupt];
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Private helper for processBatch:(). Is invoked after the response
+/// to the command of a preemptible batch has been received. @a firstByteTime
+/// is the time when the first byte of the response was available. Returns
+/// true if the command was preempted, false if not. This method is executed
+/// in the secondary thread's context.
+///
+/// A command for which an interrupt was sent is nevertheless treated as not
+/// preempted if its response completed normally. This is the case if the
+/// response was available before the interrupt was sent, i.e. the GtpEngine
+/// finished processing the command just before the interrupt. It is also the
+/// case if the response arrived more than #maximumInterruptResponseTime
+/// seconds after the interrupt was sent, i.e. the GtpEngine has lost the
+/// interrupt. In both cases the response is the result of a full search and
+/// can be delivered as usual.
+// -----------------------------------------------------------------------------
+- (bool) endPreemptibleSectionWithFirstByteTime:(CFTimeInterval)firstByteTime
+{
+  [self.schedulerCondition lock];
+  GtpCommand* command = [self.preemptibleBatchInFlight.commands objectAtIndex:0];
+  self.preemptibleBatchInFlight = nil;
+  bool commandWasPreempted = false;
+  if (self.preemptionWasRequested)
+  {
+    CFTimeInterval interruptResponseTime = firstByteTime - self.interruptTime;
+    if (interruptResponseTime <= 0)
+      DDLogInfo(@"%@ completed before it could be preempted", command);
+    else if (interruptResponseTime > maximumInterruptResponseTime)
+      DDLogWarn(@"%@ completed %.3f seconds after the interrupt, assuming that the interrupt was lost", command, interruptResponseTime);
+    else
+      commandWasPreempted = true;
+  }
+  self.preemptionWasRequested = false;
+  [self.schedulerCondition unlock];
+  return commandWasPreempted;
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Decides whether the GtpEngine must be interrupted to preempt the
+/// command that it is currently processing. Returns true if the GtpEngine is
+/// processing a preemptible command and no interrupt has been requested yet
+/// for that command, false otherwise. If this method returns true, the
+/// preemption is recorded as requested and the caller must invoke interrupt().
+///
+/// The caller must hold the lock of the scheduler condition, but must release
+/// the lock before it invokes interrupt(): Writing the interrupt may block on
+/// a full command stream, and the secondary thread must be able to continue
+/// processing responses in the meantime. If the preemptible command completes
+/// before the interrupt reaches the GtpEngine, the interrupt is usually lost
+/// because Fuego resets its abort flag whenever it starts to process a
+/// command. endPreemptibleSectionWithFirstByteTime:() recognizes this case.
+// -----------------------------------------------------------------------------
+- (bool) requestPreemptionIfNecessary
+{
+  GtpCommandBatch* batch = self.preemptibleBatchInFlight;
+  if (! batch || self.preemptionWasRequested)
+    return false;
+  self.preemptionWasRequested = true;
+  self.interruptTime = CACurrentMediaTime();
+  DDLogInfo(@"Preempting %@", [batch.commands objectAtIndex:0]);
+  return true;
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Private helper for processBatch:(). Processes the response
+/// @a nsResponse to the GTP command @a command, which was preempted.
+/// @a lineOffsets are the line offsets of @a nsResponse. This method is
+/// executed in the secondary thread's context.
+///
+/// Performs the following operations:
+/// - Updates the tracked engine state, because the command may have changed
+///   the position despite the interruption
+/// - Posts #gtpResponseWasReceived so that observers see a response for every
+///   #gtpCommandWillBeSubmitted. The response is not delivered to the
+///   command's response target or future.
+/// - Adds @a batch to the front of its lane so that it is processed again as
+///   soon as no more interactive batches are waiting. The batch remembers the
+///   generation of the tracked engine state so that it can later be found out
+///   whether the position has changed in the meantime.
+/// - If the command has added a move to the position despite the
+///   interruption, and the command has a rollback command, adds a batch with
+///   the rollback command to the front of the interactive lane so that it is
+///   processed next. Whether a move was added is determined by comparing the
+///   number of moves in the tracked engine state before and after the
+///   response was processed. Notably a "genmove" whose answer is "resign" does
+///   not add a move and is therefore not rolled back.
+// -----------------------------------------------------------------------------
+- (void) processResponse:(NSString*)nsResponse lineOffsets:(NSData*)lineOffsets toPreemptedCommand:(GtpCommand*)command inBatch:(GtpCommandBatch*)batch
+{
+  GtpResponse* response = [GtpResponse response:nsResponse lineOffsets:lineOffsets toCommand:command];
+  DDLogInfo(@"%@ was preempted, discarding response %@", command, nsResponse);
+
+  // The tracked engine state is updated only by the secondary thread, so it
+  // cannot change between the two critical sections
+  [self.engineStateLock lock];
+  NSUInteger numberOfMovesBeforeResponse = self.trackedEngineState.moves.count;
+  [self.engineStateLock unlock];
+  [self updateEngineStateWithResponse:response responseWasFramed:(nil != lineOffsets)];
+  [self.engineStateLock lock];
+  bool commandHasAddedMove = (self.trackedEngineState.moves.count > numberOfMovesBeforeResponse);
+  batch.resumptionGeneration = self.trackedEngineState.generation;
+  [self.engineStateLock unlock];
+  batch.wasPreempted = true;
+
+  // Notify observers in the secondary thread context
+  [[NSNotificationCenter defaultCenter] postNotificationName:gtpResponseWasReceivedNotification
+                                                      object:response];
+
+  [self.schedulerCondition lock];
+  _laneStatistics[batch.priority].numberOfPreemptions++;
+  [self addBatch:batch toFrontOfLane:true];
+  if (commandHasAddedMove && command.preemptionRollbackCommand)
+  {
+    GtpCommand* rollbackCommand = [GtpCommand command:command.preemptionRollbackCommand];
+    rollbackCommand.waitUntilDone = false;
+    rollbackCommand.priority = GtpCommandPriorityInteractive;
+    rollbackCommand.submittingThread = command.submittingThread;
+    NSArray* rollbackCommands = [NSArray arrayWithObject:rollbackCommand];
+    GtpCommandBatch* rollbackBatch = [[[GtpCommandBatch alloc] initWithCommands:rollbackCommands] autorelease];
+    rollbackBatch.preemptedBatch = batch;
+    [self addBatch:rollbackBatch toFrontOfLane:true];
+  }
+  [self.schedulerCondition unlock];
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Private helper for mainLoop:(). Is invoked after the rollback batch
+/// @a rollbackBatch has been processed. This method is executed in the
+/// secondary thread's context.
+///
+/// If the rollback command succeeded, the position that the preempted batch
+/// expects is the position after the rollback, so the preempted batch now
+/// remembers the generation of that position. If the rollback command failed,
+/// the preempted batch keeps the generation that it remembered when it was
+/// preempted. Because a failed rollback command has changed the generation,
+/// the preempted batch is then abandoned instead of processed again.
+// -----------------------------------------------------------------------------
+- (void) rollbackBatchWasProcessed:(GtpCommandBatch*)rollbackBatch
+{
+  GtpCommand* rollbackCommand = [rollbackBatch.commands objectAtIndex:0];
+  if (! rollbackCommand.response.status)
+  {
+    DDLogWarn(@"%@ failed, the preempted command will not be resumed", rollbackCommand);
+    return;
+  }
+  [self.engineStateLock lock];
+  rollbackBatch.preemptedBatch.resumptionGeneration = self.trackedEngineState.generation;
+  [self.engineStateLock unlock];
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Private helper for processBatch:(). Returns true if the preempted
+/// batch @a batch can be processed again because the GtpEngine's position has
+/// not changed since the batch was preempted (or since its command was rolled
+/// back). Returns false if the position has changed. This method is executed
+/// in the secondary thread's context.
+// -----------------------------------------------------------------------------
+- (bool) canResumePreemptedBatch:(GtpCommandBatch*)batch
+{
+  [self.engineStateLock lock];
+  bool positionIsUnchanged = (self.trackedEngineState.generation == batch.resumptionGeneration);
+  [self.engineStateLock unlock];
+  return positionIsUnchanged;
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Private helper for processBatch:(). Abandons the preempted batch
+/// @a batch because the GtpEngine's position has changed since the batch was
+/// preempted. The command of the batch is not sent to the GtpEngine again,
+/// because its result would refer to a position other than the one for which
+/// the command was submitted. This method is executed in the secondary
+/// thread's context.
+///
+/// If the command was submitted with a GtpFuture, the future is cancelled so
+/// that the owner of the command can re-plan. Otherwise the command's
+/// response target (if there is one) is notified with a failure response. The
+/// tracked engine state is not affected.
+// -----------------------------------------------------------------------------
+- (void) abandonPreemptedBatch:(GtpCommandBatch*)batch
+{
+  for (GtpCommand* command in batch.commands)
+  {
+    DDLogInfo(@"Abandoning %@ because the GTP engine's position has changed since it was preempted", command);
+    if (command.future)
+    {
+      [command.future cancel];
+      // Breaks the retain cycle between command and future
+      command.future = nil;
+    }
+    else
+    {
+      command.response = [GtpResponse response:@"? position has changed since the command was preempted" toCommand:command];
+      if (command.responseTarget)
+      {
+        // See processResponse:lineOffsets:floatGrid:toCommand:() for why the
+        // command is retained and why the notification must be asynchronous
+        [command retain];
+        [self performSelector:@selector(notifyResponseTarget:)
+                     onThread:command.submittingThread
+                   withObject:command
+                waitUntilDone:NO];
+      }
+    }
   }
+}
 
-  // Create the response object
-  NSString* nsResponse = [NSString stringWithCString:fullResponse.c_str()
-                                            encoding:[NSString defaultCStringEncoding]];
-  GtpResponse* response = [GtpResponse response:nsResponse toCommand:command];
+// -----------------------------------------------------------------------------
+/// @brief Private helper for processBatch:(). Reads the next response from
+/// the GtpEngine (blocking if necessary) and returns it. This method is
+/// executed in the secondary thread's context.
+///
+/// The command ID that the GtpEngine echoes in the response is removed from
+/// the response and stored in the out variable @a commandID. The returned
+/// response therefore looks the same as a response to a command without ID,
+/// i.e. it starts with the status character, followed by a space character.
+/// If the response has no command ID, @a commandID is set to 0.
+///
+/// The offsets at which the lines of the response start are stored in the out
+/// variable @a lineOffsets, as an array of NSUInteger values. The time when
+/// the first byte of the response was available is stored in the out variable
+/// @a firstByteTime.
+///
+/// The response is framed by GtpResponseFramer in place. The only copy of the
+/// response data is made when the NSString object is created.
+///
+/// If the response stream has reached end-of-file (e.g. because a GtpEngine
+/// that runs in a child process has terminated), this method returns a
+/// failure response instead of an empty response.
+// -----------------------------------------------------------------------------
+- (NSString*) readResponseWithFirstByteTime:(CFTimeInterval*)firstByteTime
+                                   commandID:(unsigned int*)commandID
+                                 lineOffsets:(NSData**)lineOffsets
+{
+  bool responseDataIsAvailable = _responseFramer->waitForResponseData();
+  *firstByteTime = CACurrentMediaTime();
+  if (! responseDataIsAvailable || ! _responseFramer->readNextResponse())
+  {
+    *commandID = 0;
+    *lineOffsets = nil;
+    return @"? GTP engine has closed the response stream";
+  }
+
+  *commandID = _responseFramer->commandID();
+
+  const std::vector<size_t>& framerLineOffsets = _responseFramer->lineOffsets();
+  NSMutableData* lineOffsetsData = [NSMutableData dataWithLength:framerLineOffsets.size() * sizeof(NSUInteger)];
+  NSUInteger* lineOffsetsBuffer = static_cast<NSUInteger*>(lineOffsetsData.mutableBytes);
+  for (size_t lineIndex = 0; lineIndex < framerLineOffsets.size(); ++lineIndex)
+    lineOffsetsBuffer[lineIndex] = framerLineOffsets[lineIndex];
+  *lineOffsets = lineOffsetsData;
+
+  // The default C string encoding maps every byte to exactly one character,
+  // so the byte offsets determined by the framer are also character offsets
+  NSString* response = [[NSString alloc] initWithBytes:_responseFramer->responseData()
+                                                length:_responseFramer->responseLength()
+                                              encoding:[NSString defaultCStringEncoding]];
+  return [response autorelease];
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Private helper for processBatch:(). Decodes the response that
+/// GtpResponseFramer has framed last into an array of
+/// @a gridSize * @a gridSize float values. Returns nil if decoding fails.
+/// This method is executed in the secondary thread's context.
+///
+/// The values are decoded straight from the framer's buffer into the returned
+/// NSData object, without an intermediate string object per line or per
+/// number.
+// -----------------------------------------------------------------------------
+- (NSData*) floatGridFromCurrentResponseWithSize:(int)gridSize
+{
+  NSMutableData* floatGrid = [NSMutableData dataWithLength:gridSize * gridSize * sizeof(float)];
+  if (! GtpFloatGridDecoder::decode(_responseFramer->responseData(),
+                                    _responseFramer->responseLength(),
+                                    gridSize,
+                                    static_cast<float*>(floatGrid.mutableBytes)))
+  {
+    DDLogWarn(@"Failed to decode response as float grid of size %d", gridSize);
+    return nil;
+  }
+  return floatGrid;
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Private helper for processBatch:(). Processes the response
+/// @a nsResponse to the GTP command @a command. @a lineOffsets are the line
+/// offsets of @a nsResponse. @a floatGrid is the decoded float grid, or nil.
+/// This method is executed in the secondary thread's context.
+///
+/// Performs the following operations:
+/// - Creates a GtpResponse object using the response received from the
+///   GtpEngine
+/// - Updates the tracked engine state
+/// - If the command was submitted with a GtpFuture, fulfills the future
+/// - If requested, invokes notifyResponseTarget:() to notify an observer
+///   object that the response has been received; the notification occurs in
+///   the context of the thread that submitted the command
+// -----------------------------------------------------------------------------
+- (void) processResponse:(NSString*)nsResponse lineOffsets:(NSData*)lineOffsets floatGrid:(NSData*)floatGrid toCommand:(GtpCommand*)command
+{
+  GtpResponse* response = [GtpResponse response:nsResponse lineOffsets:lineOffsets toCommand:command];
+  response.floatGrid = floatGrid;
   command.response = response;
+  // Update the engine state before anyone is notified so that a client that
+  // waits for the response sees an up-to-date state
+  [self updateEngineStateWithResponse:response responseWasFramed:(nil != lineOffsets)];
+
+  if (command.future)
+  {
+    // Continuations are dispatched asynchronously, so this does not block
+    [command.future fulfillWithResponse:response];
+    // Breaks the retain cycle between command and future
+    command.future = nil;
+  }
 
   if (response.command.responseTarget)
   {
@@ -211,13 +1128,6 @@ static std::istream* responseStream = nullptr;
   // Notify observers in the secondary thread context
   [[NSNotificationCenter defaultCenter] postNotificationName:gtpResponseWasReceivedNotification
                                                       object:response];
-
-  if (NSOrderedSame == [command.command compare:@"quit"])
-  {
-    // After the current method is executed, the thread's run loop will wake
-    // up, the main loop will find that the flag is true and stop running
-    self.shouldExit = true;
-  }
 }
 
 // -----------------------------------------------------------------------------
@@ -232,14 +1142,90 @@ static std::istream* responseStream = nullptr;
 // -----------------------------------------------------------------------------
 - (void) submit:(GtpCommand*)command
 {
-  command.submittingThread = [NSThread currentThread];
-  // Retain to make sure that object is still alive when it "arrives" in
-  // the secondary thread
-  [command retain];
-  [self performSelector:@selector(processCommand:)
-               onThread:self.thread
-             withObject:command
-          waitUntilDone:command.waitUntilDone];
+  [self submitPipelined:[NSArray arrayWithObject:command]];
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Submits the GtpCommand objects in @a commands to the GtpEngine as a
+/// single batch. The commands are pipelined, i.e. several commands are passed
+/// to the GtpEngine without waiting for the response to the previous command.
+///
+/// Pipelining is useful for a sequence of commands where each command can be
+/// sent regardless of the outcome of the previous command. The sequence costs
+/// one thread wakeup instead of one wakeup per command.
+///
+/// The GtpEngine processes the commands in the order in which they appear in
+/// @a commands. Notifications are posted and response targets are notified
+/// in the same way as for commands that are submitted individually.
+///
+/// If at least one of the commands has its @e waitUntilDone property set to
+/// true, this method blocks and waits until responses to all commands have
+/// been received. Otherwise this method returns immediately.
+///
+/// The batch is scheduled according to the highest priority of any of its
+/// commands. If that priority is #GtpCommandPriorityInteractive and the
+/// GtpEngine is currently processing a preemptible command, that command is
+/// preempted.
+// -----------------------------------------------------------------------------
+- (void) submitPipelined:(NSArray*)commands
+{
+  if (0 == commands.count)
+    return;
+
+  NSThread* submittingThread = [NSThread currentThread];
+  CFTimeInterval submitTime = CACurrentMediaTime();
+  for (GtpCommand* command in commands)
+  {
+    command.submittingThread = submittingThread;
+    command.submitTime = submitTime;
+  }
+
+  GtpCommandBatch* batch = [[[GtpCommandBatch alloc] initWithCommands:commands] autorelease];
+
+  [self.schedulerCondition lock];
+  if (_shouldExit)
+  {
+    [self.schedulerCondition unlock];
+    DDLogWarn(@"Not submitting batch of %lu commands because the GTP client is exiting", (unsigned long)commands.count);
+    return;
+  }
+  [self addBatch:batch toFrontOfLane:false];
+  if (GtpCommandPriorityInteractive == batch.priority && [self requestPreemptionIfNecessary])
+  {
+    [self.schedulerCondition unlock];
+    [self interrupt];
+    [self.schedulerCondition lock];
+  }
+  if (batch.waitUntilDone)
+  {
+    while (! batch.finished)
+      [self.schedulerCondition wait];
+  }
+  [self.schedulerCondition unlock];
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Returns the statistics of the lane that holds batches with priority
+/// @a lane.
+///
+/// Raises an @e NSInvalidArgumentException if @a lane is not a valid priority.
+// -----------------------------------------------------------------------------
+- (struct GtpCommandLaneStatistics) statisticsForLane:(enum GtpCommandPriority)lane
+{
+  if (lane < 0 || lane >= GtpCommandPriorityMax)
+  {
+    NSString* errorMessage = [NSString stringWithFormat:@"Lane %d is invalid", lane];
+    DDLogError(@"%@: %@", self, errorMessage);
+    NSException* exception = [NSException exceptionWithName:NSInvalidArgumentException
+                                                     reason:errorMessage
+                                                   userInfo:nil];
+    @throw exception;
+  }
+
+  [self.schedulerCondition lock];
+  struct GtpCommandLaneStatistics statistics = _laneStatistics[lane];
+  [self.schedulerCondition unlock];
+  return statistics;
 }
 
 // -----------------------------------------------------------------------------
@@ -275,7 +1261,13 @@ static std::istream* responseStream = nullptr;
 /// @note The current thread architecture does not allow the interrupt to be
 /// sent in the context of the secondary thread, because the secondary thread
 /// currently blocks and waits for the response to the GTP command that is
-/// currently being processed.
+/// currently being processed. This method is also invoked internally to
+/// preempt a command, in the context of the thread that submits the
+/// interactive batch (or in the secondary thread's context, if the
+/// interactive batch was already waiting when the preemptible command was
+/// passed to the GtpEngine). It is never invoked while the lock of the
+/// scheduler condition is held, because writing to the command stream may
+/// block.
 ///
 /// When the GtpEngine is interrupted, it immediately stops processing the
 /// current GTP command and returns a result on the GTP response stream.
@@ -291,7 +1283,10 @@ static std::istream* responseStream = nullptr;
 - (void) interrupt
 {
   const char* pchCommand = "# interrupt";
-  (*commandStream) << pchCommand << std::endl;
+  [self.commandStreamLock lock];
+  if (_commandStream)
+    (*_commandStream) << pchCommand << std::endl;
+  [self.commandStreamLock unlock];
 }
 
 @end
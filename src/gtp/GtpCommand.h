@@ -16,6 +16,7 @@
 
 
 // Forward declarations
+@class GtpFuture;
 @class GtpResponse;
 
 
@@ -36,6 +37,26 @@
 /// are invoked when the response to the command has been received. This
 /// callback always occurs in the context of the thread that the command was
 /// submitted in.
+///
+/// Alternatively, submitAsynchronously() executes the command asynchronously
+/// and returns a GtpFuture object. The future can be used to attach
+/// continuations, to cancel the command, to impose a time limit, or to join
+/// several commands that run concurrently. See the GtpFuture class
+/// documentation for details.
+///
+/// Several GtpCommand objects can be submitted together as a batch with
+/// submitPipelined:(). The batch is pipelined, i.e. the commands are passed
+/// to the GTP engine without waiting for the response to the previous
+/// command.
+///
+/// GtpCommand submits itself to the GtpClient that communicates with the
+/// GtpEnginePool engine that serves the command's @e role.
+///
+/// GtpClient schedules commands according to their @e priority property. A
+/// command that is marked as @e preemptible may be interrupted by GtpClient
+/// when a command with higher priority is submitted, and is then re-submitted
+/// after the command with higher priority has been processed. See the
+/// GtpClient class documentation for details.
 // -----------------------------------------------------------------------------
 @interface GtpCommand : NSObject
 {
@@ -43,10 +64,16 @@
 
 + (GtpCommand*) command:(NSString*)command;
 + (GtpCommand*) asynchronousCommand:(NSString*)command responseTarget:(id)target selector:(SEL)selector;
++ (void) submitPipelined:(NSArray*)commands;
 - (void) submit;
+- (GtpFuture*) submitAsynchronously;
 
 /// @brief The GTP command string, including arguments.
 @property(nonatomic, retain) NSString* command;
+/// @brief The GTP numeric command ID with which the command was passed to the
+/// GTP engine. The command ID is assigned by GtpClient. The value 0 indicates
+/// that the command has not yet been passed to the GTP engine.
+@property(nonatomic, assign) unsigned int commandID;
 /// @brief Thread in whose context the GTP command was submitted.
 @property(nonatomic, retain) NSThread* submittingThread;
 /// @brief True if execution should wait for the GTP response (i.e. command
@@ -72,5 +99,72 @@
 /// for this command is received. The selector must take a single GtpResponse*
 /// argument.
 @property(nonatomic, assign) SEL responseTargetSelector;
+/// @brief The GtpFuture that represents the outcome of this command. Is nil
+/// unless the command was submitted with submitAsynchronously().
+///
+/// GtpClient sets this property to nil after it has fulfilled the future, or
+/// after it has skipped the command because the future was cancelled.
+@property(nonatomic, retain) GtpFuture* future;
+/// @brief The priority with which GtpClient schedules the command.
+///
+/// The default for this property is #GtpCommandPriorityNormal. Only commands
+/// that the user is actively waiting for, and that do not change the GtpEngine's
+/// position, should use #GtpCommandPriorityInteractive, because an interactive
+/// command preempts a preemptible command that is currently being processed.
+/// Examples are the territory statistics for the current position, the dead
+/// stones that are requested when scoring starts, the board and game that are
+/// captured for diagnostics, and queries entered in the GTP console.
+@property(nonatomic, assign) enum GtpCommandPriority priority;
+/// @brief True if GtpClient is allowed to interrupt the command in favour of
+/// a command with higher priority. The interrupted command is re-submitted
+/// later on.
+///
+/// The default for this property is false.
+///
+/// Only a command that is not part of a pipelined batch, and whose priority
+/// is lower than #GtpCommandPriorityInteractive, can be preempted.
+@property(nonatomic, assign) bool preemptible;
+/// @brief The GTP command string that GtpClient submits to undo the effects of
+/// the command after it was preempted, but before it is re-submitted. Is
+/// submitted only if the interrupted command nevertheless added a move to the
+/// GtpEngine's position (as tracked by GtpEngineState).
+///
+/// The default for this property is nil, i.e. no rollback is necessary.
+///
+/// Example: An interrupted "genmove" command still plays the best move found
+/// so far, so its rollback command is "undo".
+@property(nonatomic, retain) NSString* preemptionRollbackCommand;
+/// @brief The role of the command. Determines the engine in the application's
+/// GtpEnginePool to which the command is submitted.
+///
+/// The default for this property is #GtpEngineRolePlay.
+@property(nonatomic, assign) enum GtpEngineRole role;
+/// @brief If greater than 0, the response is expected to contain one
+/// floating point number per intersection of a board with this size.
+/// GtpClient then decodes the numbers while the response is still in its
+/// receive buffer, and makes them available as GtpResponse::floatGrid.
+///
+/// The default for this property is 0, i.e. no decoding takes place.
+@property(nonatomic, assign) int floatGridSize;
+/// @name Latency timestamps
+///
+/// GtpClient records these timestamps while it processes the command. The
+/// timestamps are obtained with CACurrentMediaTime(), i.e. they are measured
+/// in seconds on a monotonic clock. A timestamp is 0 while the event that it
+/// records has not yet occurred. See #GtpLatencyPhase for the phases that the
+/// timestamps delimit.
+//@{
+/// @brief Time when the command was submitted to GtpClient.
+@property(nonatomic, assign) CFTimeInterval submitTime;
+/// @brief Time when GtpClient took the command from its lane.
+@property(nonatomic, assign) CFTimeInterval dequeueTime;
+/// @brief Time when GtpClient wrote the command to the GTP engine.
+@property(nonatomic, assign) CFTimeInterval writeTime;
+/// @brief Time when the first byte of the response was available to
+/// GtpClient.
+@property(nonatomic, assign) CFTimeInterval firstByteTime;
+/// @brief Time when GtpClient had received and framed the complete response.
+@property(nonatomic, assign) CFTimeInterval completionTime;
+//@}
 
 @end
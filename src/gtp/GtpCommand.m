@@ -18,6 +18,8 @@
 // Project includes
 #import "GtpCommand.h"
 #import "GtpClient.h"
+#import "GtpEnginePool.h"
+#import "GtpFuture.h"
 #import "../main/ApplicationDelegate.h"
 
 
@@ -70,11 +72,23 @@
     return nil;
 
   self.command = nil;
+  self.commandID = 0;
   self.submittingThread = nil;
   self.waitUntilDone = true;
   self.response = nil;
   self.responseTarget = nil;
   self.responseTargetSelector = nil;
+  self.future = nil;
+  self.priority = GtpCommandPriorityNormal;
+  self.preemptible = false;
+  self.preemptionRollbackCommand = nil;
+  self.role = GtpEngineRolePlay;
+  self.floatGridSize = 0;
+  self.submitTime = 0;
+  self.dequeueTime = 0;
+  self.writeTime = 0;
+  self.firstByteTime = 0;
+  self.completionTime = 0;
 
   return self;
 }
@@ -89,6 +103,8 @@
   self.response = nil;
   self.responseTarget = nil;
   self.responseTargetSelector = nil;
+  self.future = nil;
+  self.preemptionRollbackCommand = nil;
   [super dealloc];
 }
 
@@ -106,7 +122,8 @@
 }
 
 // -----------------------------------------------------------------------------
-/// @brief Submits this GtpCommand instance to the application's GtpClient.
+/// @brief Submits this GtpCommand instance to the application's GtpClient that
+/// is responsible for the command's role.
 ///
 /// This is a convenience method so that clients do not need to know GtpClient,
 /// or how to obtain an instance of GtpClient.
@@ -114,8 +131,46 @@
 - (void) submit
 {
   DDLogInfo(@"Submitting %@", self);
-  GtpClient* client = [ApplicationDelegate sharedDelegate].gtpClient;
+  GtpClient* client = [[ApplicationDelegate sharedDelegate].gtpEnginePool clientForRole:self.role];
   [client submit:self];
 }
 
+// -----------------------------------------------------------------------------
+/// @brief Submits this GtpCommand instance to the application's GtpClient for
+/// asynchronous execution. Returns a GtpFuture object that represents the
+/// outcome of the command.
+///
+/// The @e waitUntilDone property is set to false. The @e responseTarget and
+/// @e responseTargetSelector properties continue to work as usual, but there
+/// is usually no point in using them together with the returned GtpFuture.
+// -----------------------------------------------------------------------------
+- (GtpFuture*) submitAsynchronously
+{
+  self.waitUntilDone = false;
+  GtpFuture* future = [GtpFuture futureWithCommand:self];
+  self.future = future;
+  [self submit];
+  return future;
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Submits the GtpCommand instances in @a commands as a single pipelined
+/// batch to the application's GtpClient that is responsible for the role of
+/// the first command in @a commands. All commands in the batch should have
+/// the same role.
+///
+/// This is a convenience method so that clients do not need to know GtpClient,
+/// or how to obtain an instance of GtpClient. See the documentation of
+/// GtpClient::submitPipelined:() for details.
+// -----------------------------------------------------------------------------
++ (void) submitPipelined:(NSArray*)commands
+{
+  if (0 == commands.count)
+    return;
+  DDLogInfo(@"Submitting pipelined batch of %lu commands", (unsigned long)commands.count);
+  GtpCommand* firstCommand = [commands objectAtIndex:0];
+  GtpClient* client = [[ApplicationDelegate sharedDelegate].gtpEnginePool clientForRole:firstCommand.role];
+  [client submitPipelined:commands];
+}
+
 @end
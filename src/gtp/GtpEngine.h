@@ -16,6 +16,23 @@
 
 
 
+// This file is #import'ed only from Objective-C++ implementations, therefore it
+// may contain C++ syntax.
+
+// System includes
+#include <istream>
+#include <ostream>
+
+
+// -----------------------------------------------------------------------------
+/// @brief Signature of a function that implements the main method of a GTP
+/// engine. The function reads GTP commands from @a commandStream and writes
+/// GTP responses to @a responseStream. The function is expected to return
+/// after it has processed the "quit" command.
+// -----------------------------------------------------------------------------
+typedef void (*GtpEngineMainFunction)(std::istream& commandStream, std::ostream& responseStream);
+
+
 // -----------------------------------------------------------------------------
 /// @brief The GtpEngine class represents a Go Text Protocol (GTP) engine.
 ///
@@ -27,14 +44,27 @@
 /// the engine's main method, and finally blocks and waits for the engine's
 /// main method to return. It is expected that this happens when the engine
 /// receives a "quit" command.
+///
+/// The engine's main method is Fuego's main method, unless GtpEngine is
+/// instantiated using engineWithStreamBuffers:mainFunction:(). This is useful
+/// for testing and benchmarking, where a stand-in engine can take the place
+/// of Fuego.
 // -----------------------------------------------------------------------------
 @interface GtpEngine : NSObject
 {
 @private
   /// @brief Secondary thread used to communicate with GtpEngine.
   NSThread* m_thread;
+  /// @brief The engine's main method.
+  GtpEngineMainFunction m_mainFunction;
+  /// @brief Is signalled when the engine's main method has returned.
+  NSCondition* m_finishedCondition;
+  /// @brief Is true when the engine's main method has returned.
+  bool m_finished;
 }
 
 + (GtpEngine*) engineWithStreamBuffers:(NSArray*)streamBuffers;
++ (GtpEngine*) engineWithStreamBuffers:(NSArray*)streamBuffers mainFunction:(GtpEngineMainFunction)mainFunction;
+- (void) waitUntilFinished;
 
 @end
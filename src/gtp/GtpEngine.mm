@@ -29,17 +29,53 @@
 #include <ostream>
 #include <streambuf>
 
+// -----------------------------------------------------------------------------
+/// @brief The default main method of GtpEngine. Runs Fuego.
+// -----------------------------------------------------------------------------
+static void fuegoMain(std::istream& commandStream, std::ostream& responseStream)
+{
+  char programName[255];
+  char nobookParameterName[255];
+  char quietParameterName[255];
+  sprintf(programName, "fuego");
+  sprintf(nobookParameterName, "--nobook");  // opening book is loaded separately from a project resource
+  sprintf(quietParameterName, "--quiet");  // don't print debug messages, otherwise the project's debugging console becomes overloaded
+  int argc = 3;
+  char* argv[argc];
+  argv[0] = programName;
+  argv[1] = nobookParameterName;
+  argv[2] = quietParameterName;
+
+#ifndef LITTLEGO_UNITTESTS
+  // No need to create an autorelease pool, no Objective-C stuff is happening
+  // in here...
+  FuegoMainUtil::FuegoMain(argc, argv, &commandStream, &responseStream);
+#endif
+}
+
+
 @implementation GtpEngine
 
 // -----------------------------------------------------------------------------
 /// @brief Convenience constructor. Creates a GtpEngine instance which will use
 /// C++ Standard Library I/O streams to communicate with its counterpart
 /// GtpClient. The I/O streams are constructed with the stream buffers in the
-/// specified array.
+/// specified array. The engine runs Fuego.
 // -----------------------------------------------------------------------------
 + (GtpEngine*) engineWithStreamBuffers:(NSArray*)streamBuffers
 {
-  return [[[GtpEngine alloc] initWithStreamBuffers:streamBuffers] autorelease];
+  return [[[GtpEngine alloc] initWithStreamBuffers:streamBuffers mainFunction:fuegoMain] autorelease];
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Convenience constructor. Creates a GtpEngine instance which will use
+/// C++ Standard Library I/O streams to communicate with its counterpart
+/// GtpClient. The I/O streams are constructed with the stream buffers in the
+/// specified array. The engine runs @a mainFunction instead of Fuego.
+// -----------------------------------------------------------------------------
++ (GtpEngine*) engineWithStreamBuffers:(NSArray*)streamBuffers mainFunction:(GtpEngineMainFunction)mainFunction
+{
+  return [[[GtpEngine alloc] initWithStreamBuffers:streamBuffers mainFunction:mainFunction] autorelease];
 }
 
 // -----------------------------------------------------------------------------
@@ -47,13 +83,17 @@
 ///
 /// @note This is the designated initializer of GtpEngine.
 // -----------------------------------------------------------------------------
-- (id) initWithStreamBuffers:(NSArray*)streamBuffers
+- (id) initWithStreamBuffers:(NSArray*)streamBuffers mainFunction:(GtpEngineMainFunction)mainFunction
 {
   // Call designated initializer of superclass (NSObject)
   self = [super init];
   if (! self)
     return nil;
 
+  m_mainFunction = mainFunction;
+  m_finishedCondition = [[NSCondition alloc] init];
+  m_finished = false;
+
   // Create and start the thread
   m_thread = [[NSThread alloc] initWithTarget:self selector:@selector(mainLoop:) object:streamBuffers];
   [m_thread start];
@@ -72,9 +112,25 @@
 {
   // TODO implement stuff
   [m_thread release];
+  [m_finishedCondition release];
   [super dealloc];
 }
 
+// -----------------------------------------------------------------------------
+/// @brief Blocks the calling thread until the engine's main method has
+/// returned. Returns immediately if the main method has already returned.
+///
+/// This is useful to find out when the stream buffers used by the engine can
+/// be safely deleted.
+// -----------------------------------------------------------------------------
+- (void) waitUntilFinished
+{
+  [m_finishedCondition lock];
+  while (! m_finished)
+    [m_finishedCondition wait];
+  [m_finishedCondition unlock];
+}
+
 // -----------------------------------------------------------------------------
 /// @brief The secondary thread's main loop method. Returns only after the
 /// GTP engine's main method returns.
@@ -84,43 +140,36 @@
   // Create an autorelease pool as the very first thing in this thread
   NSAutoreleasePool* mainPool = [[NSAutoreleasePool alloc] init];
 
-  // Stream to read commands from the GTP client
-  NSValue* inputStreamBufferAsNSValue = [streamBuffers objectAtIndex:0];
-  std::streambuf* inputStreamBuffer = reinterpret_cast<std::streambuf*>([inputStreamBufferAsNSValue pointerValue]);
-  std::istream inputStream(inputStreamBuffer);
-
-  // Stream to write responses to the GTP client
-  NSValue* outputStreamBufferAsNSValue = [streamBuffers objectAtIndex:1];
-  std::streambuf* outputStreamBuffer = reinterpret_cast<std::streambuf*>([outputStreamBufferAsNSValue pointerValue]);
-  std::ostream outputStream(outputStreamBuffer);
-
-  char programName[255];
-  char nobookParameterName[255];
-  char quietParameterName[255];
-  sprintf(programName, "fuego");
-  sprintf(nobookParameterName, "--nobook");  // opening book is loaded separately from a project resource
-  sprintf(quietParameterName, "--quiet");  // don't print debug messages, otherwise the project's debugging console becomes overloaded
-  int argc = 3;
-  char* argv[argc];
-  argv[0] = programName;
-  argv[1] = nobookParameterName;
-  argv[2] = quietParameterName;
-
-  try
-  {
-#ifndef LITTLEGO_UNITTESTS
-    // No need to create an autorelease pool, no Objective-C stuff is happening
-    // in here...
-    FuegoMainUtil::FuegoMain(argc, argv, &inputStream, &outputStream);
-#endif
-  }
-  catch(std::exception& e)
-  {
-  }
-  catch(...)
+  // The stream objects are destroyed before this thread signals that the
+  // engine has finished
   {
+    // Stream to read commands from the GTP client
+    NSValue* inputStreamBufferAsNSValue = [streamBuffers objectAtIndex:0];
+    std::streambuf* inputStreamBuffer = reinterpret_cast<std::streambuf*>([inputStreamBufferAsNSValue pointerValue]);
+    std::istream inputStream(inputStreamBuffer);
+
+    // Stream to write responses to the GTP client
+    NSValue* outputStreamBufferAsNSValue = [streamBuffers objectAtIndex:1];
+    std::streambuf* outputStreamBuffer = reinterpret_cast<std::streambuf*>([outputStreamBufferAsNSValue pointerValue]);
+    std::ostream outputStream(outputStreamBuffer);
+
+    try
+    {
+      m_mainFunction(inputStream, outputStream);
+    }
+    catch(std::exception& e)
+    {
+    }
+    catch(...)
+    {
+    }
   }
 
+  [m_finishedCondition lock];
+  m_finished = true;
+  [m_finishedCondition broadcast];
+  [m_finishedCondition unlock];
+
   // Deallocate the autorelease pool as the very last thing in this thread
   [mainPool release];
 }
@@ -0,0 +1,74 @@
+// -----------------------------------------------------------------------------
+// Copyright 2026 Patrick Näf (herzbube@herzbube.ch)
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// -----------------------------------------------------------------------------
+
+
+// This file is #import'ed from pure Objective-C implementations, therefore it
+// must not contain any C++ syntax.
+
+// Forward declarations
+@class GtpClient;
+@class GtpEngine;
+
+/// @brief Block that creates a GtpEngine object which uses the stream buffers
+/// in @a streamBuffers. The array has the same layout as the array that is
+/// passed to GtpClient::clientWithStreamBuffers:().
+typedef GtpEngine* (^GtpEngineFactory)(NSArray* streamBuffers);
+
+
+// -----------------------------------------------------------------------------
+/// @brief The GtpEnginePool class manages a fixed number of GtpEngine objects,
+/// each of which is paired with its own GtpClient object. GtpEnginePool routes
+/// work to the engines according to the role that the work has.
+///
+/// @ingroup gtp
+///
+/// Each engine runs in its own secondary thread and has its own search tree
+/// and memory budget. Each engine/client pair communicates via its own pair of
+/// LockFreePipeStreamBuffer objects, which are owned by GtpEnginePool.
+///
+/// Every role (see enumeration #GtpEngineRole) is served by exactly one
+/// engine, but one engine may serve several roles. By default role @e r is
+/// served by engine @e r modulo the number of engines, i.e. a pool with only
+/// one engine uses that engine for all roles. The default assignment can be
+/// changed with assignEngineAtIndex:toRole:().
+///
+/// GtpEnginePool does not configure the engines. To give each engine its own
+/// settings, use GtpEngineProfile::applyProfileToEngineWithRole:().
+///
+/// @note Fuego keeps some state in global variables (notably the flag that is
+/// set when a search is interrupted). Running several Fuego engines in the
+/// same process is therefore possible, but an interrupt sent to one engine
+/// also interrupts searches that are running in other engines. The
+/// application uses only one engine.
+// -----------------------------------------------------------------------------
+@interface GtpEnginePool : NSObject
+{
+}
+
++ (GtpEnginePool*) poolWithNumberOfEngines:(int)numberOfEngines;
+- (id) initWithNumberOfEngines:(int)numberOfEngines engineFactory:(GtpEngineFactory)engineFactory;
+- (GtpClient*) clientForRole:(enum GtpEngineRole)role;
+- (GtpEngine*) engineForRole:(enum GtpEngineRole)role;
+- (GtpClient*) clientAtIndex:(int)index;
+- (GtpEngine*) engineAtIndex:(int)index;
+- (int) engineIndexForRole:(enum GtpEngineRole)role;
+- (void) assignEngineAtIndex:(int)index toRole:(enum GtpEngineRole)role;
+- (void) shutdown;
+
+/// @brief The number of engines in the pool.
+@property(nonatomic, assign, readonly) int numberOfEngines;
+
+@end
@@ -0,0 +1,230 @@
+// -----------------------------------------------------------------------------
+// Copyright 2026 Patrick Näf (herzbube@herzbube.ch)
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// -----------------------------------------------------------------------------
+
+
+// Project includes
+#import "GtpEnginePool.h"
+#import "GtpClient.h"
+#import "GtpCommand.h"
+#import "GtpEngine.h"
+#import "LockFreePipeStreamBuffer.h"
+
+// System includes
+#include <vector>
+
+
+// -----------------------------------------------------------------------------
+/// @brief Class extension with private properties for GtpEnginePool.
+// -----------------------------------------------------------------------------
+@interface GtpEnginePool()
+{
+  // The stream buffers are C++ objects, they can be members of the
+  // GtpEnginePool class only because they are declared in the class
+  // extension. GtpEnginePool.h is also #import'ed by pure Objective-C
+  // implementations.
+  std::vector<std::streambuf*> _streamBuffers;
+  int _engineIndexForRole[GtpEngineRoleMax];
+}
+@property(nonatomic, assign, readwrite) int numberOfEngines;
+@property(nonatomic, retain) NSArray* clients;
+@property(nonatomic, retain) NSArray* engines;
+@property(nonatomic, assign) bool isShutDown;
+@end
+
+
+@implementation GtpEnginePool
+
+// -----------------------------------------------------------------------------
+/// @brief Convenience constructor. Creates a GtpEnginePool instance with
+/// @a numberOfEngines engines that run Fuego.
+// -----------------------------------------------------------------------------
++ (GtpEnginePool*) poolWithNumberOfEngines:(int)numberOfEngines
+{
+  GtpEngineFactory engineFactory = ^(NSArray* streamBuffers)
+  {
+    return [GtpEngine engineWithStreamBuffers:streamBuffers];
+  };
+  return [[[GtpEnginePool alloc] initWithNumberOfEngines:numberOfEngines
+                                           engineFactory:engineFactory] autorelease];
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Initializes a GtpEnginePool object with @a numberOfEngines engines.
+/// The engines are created by invoking @a engineFactory once per engine.
+///
+/// @note This is the designated initializer of GtpEnginePool.
+///
+/// Raises an @e NSInvalidArgumentException if @a numberOfEngines is less
+/// than 1.
+// -----------------------------------------------------------------------------
+- (id) initWithNumberOfEngines:(int)numberOfEngines engineFactory:(GtpEngineFactory)engineFactory
+{
+  // Call designated initializer of superclass (NSObject)
+  self = [super init];
+  if (! self)
+    return nil;
+
+  if (numberOfEngines < 1)
+  {
+    NSString* errorMessage = [NSString stringWithFormat:@"Number of engines %d is invalid", numberOfEngines];
+    DDLogError(@"%@: %@", self, errorMessage);
+    NSException* exception = [NSException exceptionWithName:NSInvalidArgumentException
+                                                     reason:errorMessage
+                                                   userInfo:nil];
+    @throw exception;
+  }
+
+  self.numberOfEngines = numberOfEngines;
+  self.isShutDown = false;
+
+  NSMutableArray* clients = [NSMutableArray arrayWithCapacity:numberOfEngines];
+  NSMutableArray* engines = [NSMutableArray arrayWithCapacity:numberOfEngines];
+  for (int engineIndex = 0; engineIndex < numberOfEngines; ++engineIndex)
+  {
+    std::streambuf* inputPipeStreamBuffer = new LockFreePipeStreamBuffer();
+    std::streambuf* outputPipeStreamBuffer = new LockFreePipeStreamBuffer();
+    _streamBuffers.push_back(inputPipeStreamBuffer);
+    _streamBuffers.push_back(outputPipeStreamBuffer);
+
+    NSArray* streamBuffers = [NSArray arrayWithObjects:
+                              [NSValue valueWithPointer:inputPipeStreamBuffer],
+                              [NSValue valueWithPointer:outputPipeStreamBuffer],
+                              nil];
+    [clients addObject:[GtpClient clientWithStreamBuffers:streamBuffers]];
+    [engines addObject:engineFactory(streamBuffers)];
+  }
+  self.clients = clients;
+  self.engines = engines;
+
+  for (int role = 0; role < GtpEngineRoleMax; ++role)
+    _engineIndexForRole[role] = role % numberOfEngines;
+
+  return self;
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Deallocates memory allocated by this GtpEnginePool object.
+// -----------------------------------------------------------------------------
+- (void) dealloc
+{
+  self.clients = nil;
+  self.engines = nil;
+  for (std::streambuf* streamBuffer : _streamBuffers)
+    delete streamBuffer;
+  _streamBuffers.clear();
+  [super dealloc];
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Returns the GtpClient object that communicates with the engine that
+/// serves @a role.
+// -----------------------------------------------------------------------------
+- (GtpClient*) clientForRole:(enum GtpEngineRole)role
+{
+  return [self clientAtIndex:[self engineIndexForRole:role]];
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Returns the GtpEngine object that serves @a role.
+// -----------------------------------------------------------------------------
+- (GtpEngine*) engineForRole:(enum GtpEngineRole)role
+{
+  return [self engineAtIndex:[self engineIndexForRole:role]];
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Returns the GtpClient object that communicates with the engine at
+/// index position @a index.
+// -----------------------------------------------------------------------------
+- (GtpClient*) clientAtIndex:(int)index
+{
+  return [self.clients objectAtIndex:index];
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Returns the GtpEngine object at index position @a index.
+// -----------------------------------------------------------------------------
+- (GtpEngine*) engineAtIndex:(int)index
+{
+  return [self.engines objectAtIndex:index];
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Returns the index position of the engine that serves @a role.
+///
+/// Raises an @e NSInvalidArgumentException if @a role is invalid.
+// -----------------------------------------------------------------------------
+- (int) engineIndexForRole:(enum GtpEngineRole)role
+{
+  if (role < 0 || role >= GtpEngineRoleMax)
+  {
+    NSString* errorMessage = [NSString stringWithFormat:@"Role %d is invalid", role];
+    DDLogError(@"%@: %@", self, errorMessage);
+    NSException* exception = [NSException exceptionWithName:NSInvalidArgumentException
+                                                     reason:errorMessage
+                                                   userInfo:nil];
+    @throw exception;
+  }
+  return _engineIndexForRole[role];
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Assigns the engine at index position @a index to serve @a role.
+/// Commands with that role that are submitted from now on are routed to the
+/// engine.
+///
+/// This method must not be invoked while commands are submitted in other
+/// threads.
+///
+/// Raises an @e NSInvalidArgumentException if @a index or @a role is invalid.
+// -----------------------------------------------------------------------------
+- (void) assignEngineAtIndex:(int)index toRole:(enum GtpEngineRole)role
+{
+  // Validates role
+  [self engineIndexForRole:role];
+  if (index < 0 || index >= self.numberOfEngines)
+  {
+    NSString* errorMessage = [NSString stringWithFormat:@"Engine index %d is invalid", index];
+    DDLogError(@"%@: %@", self, errorMessage);
+    NSException* exception = [NSException exceptionWithName:NSInvalidArgumentException
+                                                     reason:errorMessage
+                                                   userInfo:nil];
+    @throw exception;
+  }
+  _engineIndexForRole[role] = index;
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Submits the "quit" command to every engine in the pool, then blocks
+/// until all engines have finished. Does nothing if the pool has already been
+/// shut down.
+///
+/// After this method returns, no more commands can be processed by the pool's
+/// engines.
+// -----------------------------------------------------------------------------
+- (void) shutdown
+{
+  if (self.isShutDown)
+    return;
+  self.isShutDown = true;
+
+  for (GtpClient* client in self.clients)
+    [client submit:[GtpCommand command:@"quit"]];
+  for (GtpEngine* engine in self.engines)
+    [engine waitUntilFinished];
+}
+
+@end
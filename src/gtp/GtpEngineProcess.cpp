@@ -0,0 +1,326 @@
+// -----------------------------------------------------------------------------
+// Copyright 2026 Patrick Näf (herzbube@herzbube.ch)
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// -----------------------------------------------------------------------------
+
+
+// Project includes
+#include "GtpEngineProcess.h"
+
+// System includes
+#include <cerrno>
+#include <chrono>
+#include <system_error>
+#include <fcntl.h>
+#include <poll.h>
+#include <signal.h>
+#include <spawn.h>
+#include <sys/socket.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#if defined(__linux__)
+#include <sys/epoll.h>
+#endif
+
+// Global variables
+extern char** environ;
+
+// Global constants
+// Size of the chunks in which the reader thread reads from the socket
+static const size_t READCHUNKSIZE = 16384;
+// How long the destructor waits for the child process to exit on its own
+// after the socket was closed, before the child process is killed
+static const std::chrono::milliseconds CHILDPROCESSEXITTIMEOUT(1000);
+
+
+// -----------------------------------------------------------------------------
+/// @brief Private helper. Adds @a flags to the file status flags of
+/// @a fileDescriptor, and sets the close-on-exec flag.
+// -----------------------------------------------------------------------------
+static void configureFileDescriptor(int fileDescriptor, int flags)
+{
+  fcntl(fileDescriptor, F_SETFD, fcntl(fileDescriptor, F_GETFD) | FD_CLOEXEC);
+  if (flags)
+    fcntl(fileDescriptor, F_SETFL, fcntl(fileDescriptor, F_GETFL) | flags);
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Starts the executable @a executablePath as a child process, with
+/// the command line arguments @a arguments. The executable is searched in
+/// the PATH if @a executablePath does not contain a slash character.
+///
+/// Throws std::system_error if the child process cannot be started.
+// -----------------------------------------------------------------------------
+GtpEngineProcess::GtpEngineProcess(const std::string& executablePath, const std::vector<std::string>& arguments) :
+  socketFileDescriptor(-1),
+  childProcessID(-1),
+  childProcessHasExited(false),
+  childProcessExitStatus(-1),
+  socketStreamBuffer(nullptr)
+{
+  this->wakeupPipeFileDescriptors[0] = -1;
+  this->wakeupPipeFileDescriptors[1] = -1;
+
+  spawnChildProcess(executablePath, arguments);
+
+  this->socketStreamBuffer = new SocketStreamBuffer(this->socketFileDescriptor);
+  this->readerThread = std::thread(&GtpEngineProcess::readerThreadMain, this);
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Stops the reader thread and closes the connection to the child
+/// process. If the child process does not exit on its own within a short
+/// time, it is killed.
+///
+/// A well-behaved client submits the "quit" command and invokes waitForExit()
+/// before it destroys the GtpEngineProcess object.
+// -----------------------------------------------------------------------------
+GtpEngineProcess::~GtpEngineProcess()
+{
+  char wakeupCharacter = 0;
+  while (write(this->wakeupPipeFileDescriptors[1], &wakeupCharacter, 1) < 0 && EINTR == errno)
+    ;
+  // The reader thread does not see the wakeup character if it is blocked
+  // because the response pipe is full and nobody reads the responses anymore.
+  // Closing the read end unblocks the reader thread and makes it discard
+  // any further response data.
+  this->responsePipeStreamBuffer.closeReadEnd();
+  this->readerThread.join();
+
+  delete this->socketStreamBuffer;
+  close(this->socketFileDescriptor);
+  close(this->wakeupPipeFileDescriptors[0]);
+  close(this->wakeupPipeFileDescriptors[1]);
+
+  if (this->childProcessHasExited)
+    return;
+
+  // Most GTP engines exit when they see end-of-file on stdin
+  auto deadline = std::chrono::steady_clock::now() + CHILDPROCESSEXITTIMEOUT;
+  while (std::chrono::steady_clock::now() < deadline)
+  {
+    if (waitpid(this->childProcessID, nullptr, WNOHANG) == this->childProcessID)
+      return;
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+  }
+  kill(this->childProcessID, SIGKILL);
+  while (waitpid(this->childProcessID, nullptr, 0) < 0 && EINTR == errno)
+    ;
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Returns the stream buffer to which GTP commands for the child
+/// process must be written.
+// -----------------------------------------------------------------------------
+std::streambuf* GtpEngineProcess::commandStreamBuffer()
+{
+  return this->socketStreamBuffer;
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Returns the stream buffer from which GTP responses of the child
+/// process can be read.
+// -----------------------------------------------------------------------------
+std::streambuf* GtpEngineProcess::responseStreamBuffer()
+{
+  return &this->responsePipeStreamBuffer;
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Returns the process ID of the child process.
+// -----------------------------------------------------------------------------
+pid_t GtpEngineProcess::processID() const
+{
+  return this->childProcessID;
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Blocks until the child process has exited, then returns its exit
+/// status. If the child process was terminated by a signal, the return value
+/// is 128 plus the signal number, like a shell would report it.
+// -----------------------------------------------------------------------------
+int GtpEngineProcess::waitForExit()
+{
+  if (this->childProcessHasExited)
+    return this->childProcessExitStatus;
+
+  int status = 0;
+  while (waitpid(this->childProcessID, &status, 0) < 0)
+  {
+    if (EINTR != errno)
+      return -1;
+  }
+
+  this->childProcessHasExited = true;
+  if (WIFEXITED(status))
+    this->childProcessExitStatus = WEXITSTATUS(status);
+  else if (WIFSIGNALED(status))
+    this->childProcessExitStatus = 128 + WTERMSIG(status);
+  return this->childProcessExitStatus;
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Private helper for the constructor. Creates the socket pair and the
+/// wakeup pipe, then starts the child process.
+// -----------------------------------------------------------------------------
+void GtpEngineProcess::spawnChildProcess(const std::string& executablePath, const std::vector<std::string>& arguments)
+{
+  int socketFileDescriptors[2];
+  if (socketpair(AF_UNIX, SOCK_STREAM, 0, socketFileDescriptors) != 0)
+    throw std::system_error(errno, std::generic_category(), "socketpair");
+  int parentSocketFileDescriptor = socketFileDescriptors[0];
+  int childSocketFileDescriptor = socketFileDescriptors[1];
+  configureFileDescriptor(parentSocketFileDescriptor, O_NONBLOCK);
+#if defined(SO_NOSIGPIPE)
+  int noSigPipe = 1;
+  setsockopt(parentSocketFileDescriptor, SOL_SOCKET, SO_NOSIGPIPE, &noSigPipe, sizeof(noSigPipe));
+#endif
+
+  if (pipe(this->wakeupPipeFileDescriptors) != 0)
+  {
+    int pipeErrorNumber = errno;
+    close(parentSocketFileDescriptor);
+    close(childSocketFileDescriptor);
+    throw std::system_error(pipeErrorNumber, std::generic_category(), "pipe");
+  }
+  configureFileDescriptor(this->wakeupPipeFileDescriptors[0], O_NONBLOCK);
+  configureFileDescriptor(this->wakeupPipeFileDescriptors[1], 0);
+
+  std::vector<char*> argv;
+  argv.push_back(const_cast<char*>(executablePath.c_str()));
+  for (const std::string& argument : arguments)
+    argv.push_back(const_cast<char*>(argument.c_str()));
+  argv.push_back(nullptr);
+
+  posix_spawn_file_actions_t fileActions;
+  posix_spawn_file_actions_init(&fileActions);
+  posix_spawn_file_actions_adddup2(&fileActions, childSocketFileDescriptor, STDIN_FILENO);
+  posix_spawn_file_actions_adddup2(&fileActions, childSocketFileDescriptor, STDOUT_FILENO);
+  posix_spawn_file_actions_addclose(&fileActions, childSocketFileDescriptor);
+
+  int spawnResult = posix_spawnp(&this->childProcessID, executablePath.c_str(), &fileActions, nullptr, argv.data(), environ);
+  posix_spawn_file_actions_destroy(&fileActions);
+  // The child process has its own copy of the child end
+  close(childSocketFileDescriptor);
+
+  if (spawnResult != 0)
+  {
+    close(parentSocketFileDescriptor);
+    close(this->wakeupPipeFileDescriptors[0]);
+    close(this->wakeupPipeFileDescriptors[1]);
+    throw std::system_error(spawnResult, std::generic_category(), "posix_spawnp " + executablePath);
+  }
+
+  this->socketFileDescriptor = parentSocketFileDescriptor;
+}
+
+// -----------------------------------------------------------------------------
+/// @brief The reader thread's main method. Waits until the socket becomes
+/// readable, then relays all available data into the response pipe. Returns
+/// when the child process closes its end of the socket, or when the
+/// destructor wakes up the thread.
+// -----------------------------------------------------------------------------
+void GtpEngineProcess::readerThreadMain()
+{
+  int wakeupFileDescriptor = this->wakeupPipeFileDescriptors[0];
+  bool keepRunning = true;
+
+#if defined(__linux__)
+  int epollFileDescriptor = epoll_create1(EPOLL_CLOEXEC);
+  struct epoll_event event;
+  event.events = EPOLLIN | EPOLLRDHUP;
+  event.data.fd = this->socketFileDescriptor;
+  epoll_ctl(epollFileDescriptor, EPOLL_CTL_ADD, this->socketFileDescriptor, &event);
+  event.events = EPOLLIN;
+  event.data.fd = wakeupFileDescriptor;
+  epoll_ctl(epollFileDescriptor, EPOLL_CTL_ADD, wakeupFileDescriptor, &event);
+
+  while (keepRunning)
+  {
+    struct epoll_event readyEvents[2];
+    int numberOfReadyEvents = epoll_wait(epollFileDescriptor, readyEvents, 2, -1);
+    if (numberOfReadyEvents < 0)
+    {
+      if (EINTR == errno)
+        continue;
+      break;
+    }
+    for (int eventIndex = 0; eventIndex < numberOfReadyEvents; ++eventIndex)
+    {
+      if (readyEvents[eventIndex].data.fd == wakeupFileDescriptor)
+        keepRunning = false;
+      else if (! relayAvailableResponseData())
+        keepRunning = false;
+    }
+  }
+
+  close(epollFileDescriptor);
+#else
+  while (keepRunning)
+  {
+    struct pollfd pollFileDescriptors[2];
+    pollFileDescriptors[0].fd = this->socketFileDescriptor;
+    pollFileDescriptors[0].events = POLLIN;
+    pollFileDescriptors[0].revents = 0;
+    pollFileDescriptors[1].fd = wakeupFileDescriptor;
+    pollFileDescriptors[1].events = POLLIN;
+    pollFileDescriptors[1].revents = 0;
+    int numberOfReadyFileDescriptors = poll(pollFileDescriptors, 2, -1);
+    if (numberOfReadyFileDescriptors < 0)
+    {
+      if (EINTR == errno)
+        continue;
+      break;
+    }
+    if (pollFileDescriptors[1].revents)
+      keepRunning = false;
+    else if (pollFileDescriptors[0].revents && ! relayAvailableResponseData())
+      keepRunning = false;
+  }
+#endif
+
+  this->responsePipeStreamBuffer.closeWriteEnd();
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Private helper for readerThreadMain(). Reads from the socket until
+/// no more data is available, and relays the data into the response pipe.
+/// Returns true if the socket is still open, false if the child process has
+/// closed its end of the socket, if the read end of the response pipe was
+/// closed, or if an error occurred.
+// -----------------------------------------------------------------------------
+bool GtpEngineProcess::relayAvailableResponseData()
+{
+  char chunk[READCHUNKSIZE];
+  while (true)
+  {
+    ssize_t numberOfCharactersRead = read(this->socketFileDescriptor, chunk, sizeof(chunk));
+    if (numberOfCharactersRead > 0)
+    {
+      // A short write means that the read end of the response pipe was closed
+      if (this->responsePipeStreamBuffer.sputn(chunk, numberOfCharactersRead) < numberOfCharactersRead)
+        return false;
+      continue;
+    }
+    if (numberOfCharactersRead < 0 && EINTR == errno)
+      continue;
+
+    // Make the data available to the reading thread in one go
+    this->responsePipeStreamBuffer.pubsync();
+    if (numberOfCharactersRead < 0 && (EAGAIN == errno || EWOULDBLOCK == errno))
+      return true;
+    // End-of-file or error
+    return false;
+  }
+}
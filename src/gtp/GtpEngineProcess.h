@@ -0,0 +1,99 @@
+// -----------------------------------------------------------------------------
+// Copyright 2026 Patrick Näf (herzbube@herzbube.ch)
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// -----------------------------------------------------------------------------
+
+
+#pragma once
+
+// Project includes
+#include "LockFreePipeStreamBuffer.h"
+#include "SocketStreamBuffer.h"
+
+// System includes
+#include <string>
+#include <thread>
+#include <vector>
+#include <sys/types.h>
+
+// -----------------------------------------------------------------------------
+/// @brief The GtpEngineProcess class runs a GTP engine executable as a child
+/// process and provides the stream buffers that GtpClient needs to talk to
+/// the child process. GtpEngineProcess is an alternative to running GtpEngine
+/// in a thread of the current process.
+///
+/// @ingroup gtp
+///
+/// The child process is connected to the current process via a socket pair.
+/// The child's stdin and stdout are both attached to the child end of the
+/// socket pair, the child's stderr is inherited. The parent end is
+/// non-blocking.
+/// - Commands flow through a SocketStreamBuffer, which writes directly to the
+///   parent end of the socket pair.
+/// - Responses are read from the socket by a reader thread that is owned by
+///   GtpEngineProcess. The reader thread waits for data with epoll (on Linux)
+///   or poll (elsewhere), drains the socket and relays the data into a
+///   LockFreePipeStreamBuffer. When the child process closes its end of the
+///   socket (e.g. because it terminated), the reader thread closes the write
+///   end of the LockFreePipeStreamBuffer, so that the reading side of
+///   GtpClient receives end-of-file instead of blocking forever.
+///
+/// Usage with GtpClient:
+/// @verbatim
+/// GtpEngineProcess* engineProcess = new GtpEngineProcess("/path/to/fuego", {"--quiet"});
+/// NSArray* streamBuffers = [NSArray arrayWithObjects:
+///                           [NSValue valueWithPointer:engineProcess->commandStreamBuffer()],
+///                           [NSValue valueWithPointer:engineProcess->responseStreamBuffer()],
+///                           nil];
+/// GtpClient* client = [GtpClient clientWithStreamBuffers:streamBuffers];
+/// @endverbatim
+///
+/// The constructor throws std::system_error if the child process cannot be
+/// started.
+///
+/// @note iOS does not allow an app to start child processes. GtpEngineProcess
+/// is meant for benchmarking and for running other GTP engines on platforms
+/// that do.
+// -----------------------------------------------------------------------------
+class GtpEngineProcess
+{
+public:
+  GtpEngineProcess(const std::string& executablePath, const std::vector<std::string>& arguments);
+  ~GtpEngineProcess();
+
+  std::streambuf* commandStreamBuffer();
+  std::streambuf* responseStreamBuffer();
+  pid_t processID() const;
+  int waitForExit();
+
+private:
+  GtpEngineProcess(const GtpEngineProcess&) = delete;
+  GtpEngineProcess& operator=(const GtpEngineProcess&) = delete;
+
+  void spawnChildProcess(const std::string& executablePath, const std::vector<std::string>& arguments);
+  void readerThreadMain();
+  bool relayAvailableResponseData();
+
+  int socketFileDescriptor;
+  // Writing a byte to the write end wakes up the reader thread and tells it
+  // to stop
+  int wakeupPipeFileDescriptors[2];
+  pid_t childProcessID;
+  bool childProcessHasExited;
+  int childProcessExitStatus;
+
+  SocketStreamBuffer* socketStreamBuffer;
+  LockFreePipeStreamBuffer responsePipeStreamBuffer;
+  std::thread readerThread;
+};
@@ -0,0 +1,124 @@
+// -----------------------------------------------------------------------------
+// Copyright 2026 Patrick Näf (herzbube@herzbube.ch)
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// -----------------------------------------------------------------------------
+
+
+// Forward declarations
+@class GtpResponse;
+
+
+// -----------------------------------------------------------------------------
+/// @brief The GtpEngineState class models the position that a GTP engine
+/// currently holds, as far as it can be deduced from the GTP commands that
+/// were sent to the engine and the responses that the engine returned.
+///
+/// @ingroup gtp
+///
+/// GtpClient keeps one GtpEngineState object per engine and updates it with
+/// updateWithResponse:() every time it receives a response. Clients obtain a
+/// snapshot of the state via GtpClient's @e engineState property.
+///
+/// The state is either known or unknown. It becomes known when the engine
+/// processes "boardsize" or "clear_board", because after that the engine's
+/// position is fully determined by the commands that follow. It becomes
+/// unknown when the engine processes a command whose effect cannot be
+/// tracked (e.g. "loadsgf", or any command that GtpEngineState does not know),
+/// when a command that changes the position fails, and when the engine stops
+/// responding. Commands that are known to leave the position unchanged (e.g.
+/// "showboard" or "uct_param_player") are ignored.
+///
+/// A GtpEngineState object can also describe the position that a client
+/// wants the engine to have. planSyncFromState:numberOfUndos:indexOfFirstMoveToPlay:()
+/// compares such a target state with the engine's current state and
+/// determines the cheapest way how the engine can be brought from the
+/// current state to the target state.
+///
+/// In addition, a client can associate a fingerprint of its own with the
+/// current position (see assignPositionFingerprint:()). The fingerprint
+/// survives until the position changes. A client that wants to bring the
+/// engine into a position whose fingerprint it already knows can therefore
+/// find out with matchesPositionFingerprint:() whether it has to do anything
+/// at all, without comparing move lists. Every change of the position also
+/// increments @e generation, which lets clients detect whether the position
+/// has changed between two snapshots.
+///
+/// Besides the position, GtpEngineState also tracks the values of the engine
+/// parameters that were set with commands such as "uct_param_player" or
+/// "uct_max_memory" (see @e parameters). Parameters are not affected by
+/// changes of the position. A client that wants to configure the engine can
+/// use isParameterSetByCommand:() to skip commands that would set a parameter
+/// to the value that it already has.
+///
+/// Moves are stored as strings of the form "B D4" or "W PASS", i.e. color and
+/// vertex in uppercase, separated by a single space. Use
+/// moveWithColor:vertex:() to create such strings.
+///
+/// GtpEngineState is not thread-safe.
+// -----------------------------------------------------------------------------
+@interface GtpEngineState : NSObject <NSCopying>
+{
+}
+
++ (NSString*) moveWithColor:(NSString*)color vertex:(NSString*)vertex;
++ (NSString*) komiStringWithKomi:(double)komi;
++ (NSString*) parameterNameOfCommand:(NSString*)command value:(NSString**)value;
++ (bool) commandMayChangePosition:(NSString*)command;
+
+- (void) updateWithResponse:(GtpResponse*)response;
+- (void) invalidate;
+- (void) assignPositionFingerprint:(long long)positionFingerprint;
+- (bool) matchesPositionFingerprint:(long long)positionFingerprint;
+- (bool) isSamePositionAsState:(GtpEngineState*)otherState;
+- (void) forgetParameters;
+- (bool) isParameterSetByCommand:(NSString*)command;
+- (bool) planSyncFromState:(GtpEngineState*)currentState
+             numberOfUndos:(NSUInteger*)numberOfUndos
+    indexOfFirstMoveToPlay:(NSUInteger*)indexOfFirstMoveToPlay;
+
+/// @brief True if the engine's position is known, false if not.
+@property(nonatomic, assign, getter=isKnown) bool known;
+/// @brief The board size. Is 0 if the board size is not known, e.g. because
+/// the engine was configured before tracking started.
+@property(nonatomic, assign) int boardSize;
+/// @brief The komi, formatted with komiStringWithKomi:(). Is nil if komi was
+/// never set explicitly, i.e. the engine uses its built-in default.
+@property(nonatomic, retain) NSString* komi;
+/// @brief The handicap stones as a space-separated list of vertices. Is nil
+/// if there is no handicap.
+@property(nonatomic, retain) NSString* handicap;
+/// @brief The setup stones as a space-separated list of color/vertex pairs,
+/// in the format that "gogui-setup" expects. Is nil if there are no setup
+/// stones.
+@property(nonatomic, retain) NSString* setupStones;
+/// @brief The color of the player who plays first after setup ("B" or "W").
+/// Is nil if the setup does not specify the first player.
+@property(nonatomic, retain) NSString* setupPlayer;
+/// @brief Array of NSString objects, one per move, in the order in which the
+/// moves were played.
+@property(nonatomic, retain) NSMutableArray* moves;
+/// @brief Dictionary with the engine parameters whose values are known. Keys
+/// are parameter names as returned by parameterNameOfCommand:value:(), values
+/// are the parameter values as NSString objects.
+@property(nonatomic, retain) NSMutableDictionary* parameters;
+/// @brief Is incremented every time the position changes or becomes unknown.
+@property(nonatomic, assign, readonly) unsigned long long generation;
+/// @brief True if a position fingerprint has been assigned to the current
+/// position.
+@property(nonatomic, assign, readonly) bool hasPositionFingerprint;
+/// @brief The position fingerprint assigned to the current position. Is
+/// undefined if @e hasPositionFingerprint is false.
+@property(nonatomic, assign, readonly) long long positionFingerprint;
+
+@end
@@ -0,0 +1,634 @@
+// -----------------------------------------------------------------------------
+// Copyright 2026 Patrick Näf (herzbube@herzbube.ch)
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// -----------------------------------------------------------------------------
+
+
+// Project includes
+#import "GtpEngineState.h"
+#import "GtpCommand.h"
+#import "GtpResponse.h"
+
+// Names of the GTP commands that change the engine's position
+static NSString* positionChangingCommandNames[] =
+{
+  @"boardsize",
+  @"clear_board",
+  @"komi",
+  @"set_free_handicap",
+  @"fixed_handicap",
+  @"place_free_handicap",
+  @"gogui-setup",
+  @"gogui-setup_player",
+  @"play",
+  @"gogui-play_sequence",
+  @"genmove",
+  @"kgs-genmove_cleanup",
+  @"undo",
+  @"gg-undo",
+  @"loadsgf",
+  @"quit",
+};
+
+// Names of the GTP commands that are known to leave the engine's position
+// unchanged. Commands that set or query an engine parameter are recognized
+// by isParameterCommand() and are not listed here.
+static NSString* positionPreservingCommandNames[] =
+{
+  @"protocol_version",
+  @"name",
+  @"version",
+  @"known_command",
+  @"list_commands",
+  @"showboard",
+  @"final_score",
+  @"final_status_list",
+  @"get_komi",
+  @"go_point_numbers",
+  @"list_handicap",
+  @"list_setup",
+  @"list_setup_player",
+  @"list_moves",
+  @"savesgf",
+  @"book_load",
+  @"reg_genmove",
+  @"uct_stat_territory",
+};
+
+
+// -----------------------------------------------------------------------------
+/// @brief Returns true if @a string1 and @a string2 are equal, or if both are
+/// nil.
+// -----------------------------------------------------------------------------
+static bool stringsAreEqual(NSString* string1, NSString* string2)
+{
+  if (string1 == string2)
+    return true;
+  return [string1 isEqualToString:string2];
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Returns true if @a commandName appears in the array @a commandNames,
+/// which has @a numberOfCommandNames elements. @a commandName must be in
+/// lowercase.
+// -----------------------------------------------------------------------------
+static bool isCommandNameInArray(NSString* commandName, NSString** commandNames, size_t numberOfCommandNames)
+{
+  for (size_t index = 0; index < numberOfCommandNames; ++index)
+  {
+    if ([commandName isEqualToString:commandNames[index]])
+      return true;
+  }
+  return false;
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Returns true if the GTP command with name @a commandName changes the
+/// engine's position. @a commandName must be in lowercase.
+// -----------------------------------------------------------------------------
+static bool isPositionChangingCommand(NSString* commandName)
+{
+  size_t numberOfCommandNames = sizeof(positionChangingCommandNames) / sizeof(positionChangingCommandNames[0]);
+  return isCommandNameInArray(commandName, positionChangingCommandNames, numberOfCommandNames);
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Returns true if the GTP command with name @a commandName sets or
+/// queries an engine parameter. @a commandName must be in lowercase.
+// -----------------------------------------------------------------------------
+static bool isParameterCommand(NSString* commandName)
+{
+  return ([commandName isEqualToString:@"uct_max_memory"]
+          || [commandName hasPrefix:@"uct_param_"]
+          || [commandName hasPrefix:@"go_param"]);
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Returns true if the GTP command with name @a commandName is known to
+/// leave the engine's position unchanged. @a commandName must be in
+/// lowercase.
+// -----------------------------------------------------------------------------
+static bool isPositionPreservingCommand(NSString* commandName)
+{
+  if (isParameterCommand(commandName))
+    return true;
+  size_t numberOfCommandNames = sizeof(positionPreservingCommandNames) / sizeof(positionPreservingCommandNames[0]);
+  return isCommandNameInArray(commandName, positionPreservingCommandNames, numberOfCommandNames);
+}
+
+
+// -----------------------------------------------------------------------------
+/// @brief Class extension with private properties for GtpEngineState.
+// -----------------------------------------------------------------------------
+@interface GtpEngineState()
+/// @name Re-declaration of properties to make them readwrite privately
+//@{
+@property(nonatomic, assign, readwrite) unsigned long long generation;
+@property(nonatomic, assign, readwrite) bool hasPositionFingerprint;
+@property(nonatomic, assign, readwrite) long long positionFingerprint;
+//@}
+@end
+
+
+@implementation GtpEngineState
+
+// -----------------------------------------------------------------------------
+/// @brief Returns a string that represents a move by the player with color
+/// @a color on the intersection @a vertex, in the format that GtpEngineState
+/// uses to store moves. @a vertex may also be "pass".
+// -----------------------------------------------------------------------------
++ (NSString*) moveWithColor:(NSString*)color vertex:(NSString*)vertex
+{
+  NSString* colorString;
+  if ([color caseInsensitiveCompare:@"b"] == NSOrderedSame || [color caseInsensitiveCompare:@"black"] == NSOrderedSame)
+    colorString = @"B";
+  else
+    colorString = @"W";
+  return [NSString stringWithFormat:@"%@ %@", colorString, [vertex uppercaseString]];
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Returns @a komi formatted in the way that GtpEngineState uses to
+/// store komi.
+// -----------------------------------------------------------------------------
++ (NSString*) komiStringWithKomi:(double)komi
+{
+  return [NSString stringWithFormat:@"%.1f", komi];
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Returns true if the GTP command @a command may change the engine's
+/// position. Returns false only if @a command is known to leave the position
+/// unchanged (e.g. "showboard" or "uct_param_player").
+///
+/// Commands that are not known to GtpEngineState (e.g. commands that the user
+/// enters in the GTP console) are treated as changing the position.
+// -----------------------------------------------------------------------------
++ (bool) commandMayChangePosition:(NSString*)command
+{
+  NSString* trimmedCommand = [command stringByTrimmingCharactersInSet:[NSCharacterSet whitespaceCharacterSet]];
+  if (0 == trimmedCommand.length)
+    return false;
+  NSString* commandName = [[[trimmedCommand componentsSeparatedByCharactersInSet:[NSCharacterSet whitespaceCharacterSet]] objectAtIndex:0] lowercaseString];
+  return ! isPositionPreservingCommand(commandName);
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Returns the name of the engine parameter that the GTP command
+/// @a command sets, and stores the new value of the parameter in the out
+/// parameter @a value. Returns nil if @a command does not set a parameter.
+///
+/// Parameters are set either by a command that takes a single value (e.g.
+/// "uct_max_memory 1000000"), or by a command that takes a parameter name and
+/// a value (e.g. "uct_param_player max_games 500"). The parameter name in the
+/// first case is the command name, in the second case it is the command name
+/// followed by the parameter name (e.g. "uct_param_player max_games").
+// -----------------------------------------------------------------------------
++ (NSString*) parameterNameOfCommand:(NSString*)command value:(NSString**)value
+{
+  NSMutableArray* tokens = [NSMutableArray arrayWithArray:[command componentsSeparatedByCharactersInSet:[NSCharacterSet whitespaceCharacterSet]]];
+  [tokens removeObject:@""];
+  if (tokens.count < 2)
+    return nil;
+  NSString* commandName = [[tokens objectAtIndex:0] lowercaseString];
+
+  if (! isParameterCommand(commandName))
+    return nil;
+  NSUInteger numberOfNameTokens;
+  if ([commandName isEqualToString:@"uct_max_memory"])
+    numberOfNameTokens = 1;
+  else
+    numberOfNameTokens = 2;
+  if (tokens.count != numberOfNameTokens + 1)
+    return nil;
+
+  *value = [tokens lastObject];
+  [tokens removeLastObject];
+  [tokens replaceObjectAtIndex:0 withObject:commandName];
+  return [tokens componentsJoinedByString:@" "];
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Initializes a GtpEngineState object whose state is unknown.
+///
+/// @note This is the designated initializer of GtpEngineState.
+// -----------------------------------------------------------------------------
+- (id) init
+{
+  // Call designated initializer of superclass (NSObject)
+  self = [super init];
+  if (! self)
+    return nil;
+
+  self.known = false;
+  self.boardSize = 0;
+  self.komi = nil;
+  self.handicap = nil;
+  self.setupStones = nil;
+  self.setupPlayer = nil;
+  self.moves = [NSMutableArray array];
+  self.parameters = [NSMutableDictionary dictionary];
+  self.generation = 0;
+  self.hasPositionFingerprint = false;
+  self.positionFingerprint = 0;
+
+  return self;
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Deallocates memory allocated by this GtpEngineState object.
+// -----------------------------------------------------------------------------
+- (void) dealloc
+{
+  self.komi = nil;
+  self.handicap = nil;
+  self.setupStones = nil;
+  self.setupPlayer = nil;
+  self.moves = nil;
+  self.parameters = nil;
+  [super dealloc];
+}
+
+// -----------------------------------------------------------------------------
+/// @brief NSCopying protocol method.
+// -----------------------------------------------------------------------------
+- (id) copyWithZone:(NSZone*)zone
+{
+  GtpEngineState* copy = [[GtpEngineState allocWithZone:zone] init];
+  if (copy)
+  {
+    copy.known = self.known;
+    copy.boardSize = self.boardSize;
+    copy.komi = self.komi;
+    copy.handicap = self.handicap;
+    copy.setupStones = self.setupStones;
+    copy.setupPlayer = self.setupPlayer;
+    copy.moves = [[self.moves mutableCopy] autorelease];
+    copy.parameters = [[self.parameters mutableCopy] autorelease];
+    copy.generation = self.generation;
+    copy.hasPositionFingerprint = self.hasPositionFingerprint;
+    copy.positionFingerprint = self.positionFingerprint;
+  }
+  return copy;
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Returns a description for this GtpEngineState object.
+///
+/// This method is invoked when GtpEngineState needs to be represented as a
+/// string, i.e. by NSLog, or when the debugger command "po" is used on the
+/// object.
+// -----------------------------------------------------------------------------
+- (NSString*) description
+{
+  return [NSString stringWithFormat:@"GtpEngineState(%p): known = %d, board size = %d, komi = %@, handicap = %@, setup stones = %@, setup player = %@, number of moves = %lu",
+          self, self.known, self.boardSize, self.komi, self.handicap, self.setupStones, self.setupPlayer, (unsigned long)self.moves.count];
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Marks the state as unknown.
+// -----------------------------------------------------------------------------
+- (void) invalidate
+{
+  [self positionWillChange];
+  self.known = false;
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Forgets the values of all engine parameters. Clients invoke this if
+/// the engine may have lost its configuration, e.g. because it has stopped
+/// responding.
+// -----------------------------------------------------------------------------
+- (void) forgetParameters
+{
+  [self.parameters removeAllObjects];
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Returns true if the GTP command @a command sets an engine parameter
+/// to the value that the parameter already has. Returns false if @a command
+/// does not set a parameter, if the parameter's value is not known, or if the
+/// value is different.
+// -----------------------------------------------------------------------------
+- (bool) isParameterSetByCommand:(NSString*)command
+{
+  NSString* value = nil;
+  NSString* parameterName = [GtpEngineState parameterNameOfCommand:command value:&value];
+  if (! parameterName)
+    return false;
+  return stringsAreEqual([self.parameters objectForKey:parameterName], value);
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Private helper. Is invoked before the position changes. Starts a
+/// new generation and forgets the position fingerprint.
+// -----------------------------------------------------------------------------
+- (void) positionWillChange
+{
+  self.generation++;
+  self.hasPositionFingerprint = false;
+  self.positionFingerprint = 0;
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Associates the position fingerprint @a positionFingerprint with the
+/// current position. The fingerprint is forgotten as soon as the position
+/// changes.
+///
+/// The fingerprint is opaque to GtpEngineState. It is up to the client to
+/// compute a fingerprint that identifies the position, and to assign the
+/// fingerprint only if the current position actually is the position that the
+/// fingerprint identifies.
+// -----------------------------------------------------------------------------
+- (void) assignPositionFingerprint:(long long)positionFingerprint
+{
+  self.hasPositionFingerprint = true;
+  self.positionFingerprint = positionFingerprint;
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Returns true if the position is known and has the fingerprint
+/// @a positionFingerprint. Returns false if the position is unknown, if the
+/// position has no fingerprint, or if the fingerprint is different.
+// -----------------------------------------------------------------------------
+- (bool) matchesPositionFingerprint:(long long)positionFingerprint
+{
+  return (self.known && self.hasPositionFingerprint && self.positionFingerprint == positionFingerprint);
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Returns true if the receiver and @a otherState describe the same
+/// known position. A board size of 0 is treated as matching any board size.
+// -----------------------------------------------------------------------------
+- (bool) isSamePositionAsState:(GtpEngineState*)otherState
+{
+  if (! self.known || ! otherState.known)
+    return false;
+  if (0 != self.boardSize && 0 != otherState.boardSize && self.boardSize != otherState.boardSize)
+    return false;
+  return (stringsAreEqual(self.komi, otherState.komi)
+          && stringsAreEqual(self.handicap, otherState.handicap)
+          && stringsAreEqual(self.setupStones, otherState.setupStones)
+          && stringsAreEqual(self.setupPlayer, otherState.setupPlayer)
+          && [self.moves isEqualToArray:otherState.moves]);
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Updates the state with the effect that the GTP command of
+/// @a response had on the engine.
+///
+/// Commands that set an engine parameter update @e parameters. Commands that
+/// change the position are recognized by name. Every such
+/// command starts a new generation and makes the state forget its position
+/// fingerprint, even if the command fails. A failed
+/// command that changes the position makes the state unknown, because it is
+/// not always clear whether the engine has partially executed the command
+/// (e.g. "gogui-play_sequence").
+///
+/// A command that is neither known to change the position nor known to leave
+/// it unchanged (e.g. a command that the user entered in the GTP console)
+/// also makes the state unknown, because its effect cannot be tracked.
+// -----------------------------------------------------------------------------
+- (void) updateWithResponse:(GtpResponse*)response
+{
+  NSMutableArray* tokens = [NSMutableArray arrayWithArray:[response.command.command componentsSeparatedByCharactersInSet:[NSCharacterSet whitespaceCharacterSet]]];
+  [tokens removeObject:@""];
+  if (0 == tokens.count)
+    return;
+  NSString* commandName = [[tokens objectAtIndex:0] lowercaseString];
+
+  NSString* parameterValue = nil;
+  NSString* parameterName = [GtpEngineState parameterNameOfCommand:response.command.command value:&parameterValue];
+  if (parameterName)
+  {
+    // The value of a parameter that could not be set is no longer known,
+    // e.g. because the engine may have clamped it
+    if (response.status)
+      [self.parameters setObject:parameterValue forKey:parameterName];
+    else
+      [self.parameters removeObjectForKey:parameterName];
+    return;
+  }
+
+  if (isPositionPreservingCommand(commandName))
+    return;
+  if (! isPositionChangingCommand(commandName))
+  {
+    [self invalidate];
+    return;
+  }
+  [self positionWillChange];
+
+  if ([commandName isEqualToString:@"boardsize"])
+  {
+    if (! response.status || tokens.count < 2)
+    {
+      [self invalidate];
+      return;
+    }
+    self.boardSize = [[tokens objectAtIndex:1] intValue];
+    [self resetToEmptyBoard];
+  }
+  else if ([commandName isEqualToString:@"clear_board"])
+  {
+    if (! response.status)
+    {
+      [self invalidate];
+      return;
+    }
+    [self resetToEmptyBoard];
+  }
+  else if ([commandName isEqualToString:@"komi"])
+  {
+    if (! response.status || tokens.count < 2)
+    {
+      [self invalidate];
+      return;
+    }
+    self.komi = [GtpEngineState komiStringWithKomi:[[tokens objectAtIndex:1] doubleValue]];
+  }
+  else if ([commandName isEqualToString:@"set_free_handicap"])
+  {
+    if (! response.status)
+    {
+      [self invalidate];
+      return;
+    }
+    self.handicap = [self argumentsStringWithTokens:tokens];
+  }
+  else if ([commandName isEqualToString:@"fixed_handicap"] || [commandName isEqualToString:@"place_free_handicap"])
+  {
+    if (! response.status)
+    {
+      [self invalidate];
+      return;
+    }
+    NSMutableArray* vertices = [NSMutableArray arrayWithArray:[response.parsedResponse componentsSeparatedByCharactersInSet:[NSCharacterSet whitespaceAndNewlineCharacterSet]]];
+    [vertices removeObject:@""];
+    if (0 == vertices.count)
+      self.handicap = nil;
+    else
+      self.handicap = [[vertices componentsJoinedByString:@" "] uppercaseString];
+  }
+  else if ([commandName isEqualToString:@"gogui-setup"])
+  {
+    if (! response.status)
+    {
+      [self invalidate];
+      return;
+    }
+    self.setupStones = [self argumentsStringWithTokens:tokens];
+  }
+  else if ([commandName isEqualToString:@"gogui-setup_player"])
+  {
+    if (! response.status || tokens.count < 2)
+    {
+      [self invalidate];
+      return;
+    }
+    self.setupPlayer = [[tokens objectAtIndex:1] uppercaseString];
+  }
+  else if ([commandName isEqualToString:@"play"])
+  {
+    if (! response.status || tokens.count < 3)
+    {
+      [self invalidate];
+      return;
+    }
+    [self.moves addObject:[GtpEngineState moveWithColor:[tokens objectAtIndex:1] vertex:[tokens objectAtIndex:2]]];
+  }
+  else if ([commandName isEqualToString:@"gogui-play_sequence"])
+  {
+    if (! response.status || 0 == (tokens.count % 2))
+    {
+      [self invalidate];
+      return;
+    }
+    for (NSUInteger index = 1; index + 1 < tokens.count; index += 2)
+      [self.moves addObject:[GtpEngineState moveWithColor:[tokens objectAtIndex:index] vertex:[tokens objectAtIndex:index + 1]]];
+  }
+  else if ([commandName isEqualToString:@"genmove"] || [commandName isEqualToString:@"kgs-genmove_cleanup"])
+  {
+    if (! response.status || tokens.count < 2)
+    {
+      [self invalidate];
+      return;
+    }
+    NSString* vertex = [response.parsedResponse stringByTrimmingCharactersInSet:[NSCharacterSet whitespaceAndNewlineCharacterSet]];
+    // A resignation does not change the position
+    if (NSOrderedSame != [vertex caseInsensitiveCompare:@"resign"])
+      [self.moves addObject:[GtpEngineState moveWithColor:[tokens objectAtIndex:1] vertex:vertex]];
+  }
+  else if ([commandName isEqualToString:@"undo"] || [commandName isEqualToString:@"gg-undo"])
+  {
+    NSUInteger numberOfUndos = 1;
+    if (tokens.count >= 2)
+      numberOfUndos = [[tokens objectAtIndex:1] integerValue];
+    if (! response.status || numberOfUndos > self.moves.count)
+    {
+      [self invalidate];
+      return;
+    }
+    [self.moves removeObjectsInRange:NSMakeRange(self.moves.count - numberOfUndos, numberOfUndos)];
+  }
+  else if ([commandName isEqualToString:@"loadsgf"] || [commandName isEqualToString:@"quit"])
+  {
+    [self invalidate];
+  }
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Private helper for updateWithResponse:(). Resets the state to an
+/// empty board, which is the state after "boardsize" or "clear_board". Komi
+/// is not changed, because the engine remembers the komi value that was last
+/// set explicitly.
+// -----------------------------------------------------------------------------
+- (void) resetToEmptyBoard
+{
+  self.known = true;
+  self.handicap = nil;
+  self.setupStones = nil;
+  self.setupPlayer = nil;
+  [self.moves removeAllObjects];
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Private helper for updateWithResponse:(). Returns the tokens in
+/// @a tokens, except the first one, in uppercase and joined by single space
+/// characters. Returns nil if there are no arguments.
+// -----------------------------------------------------------------------------
+- (NSString*) argumentsStringWithTokens:(NSArray*)tokens
+{
+  if (tokens.count < 2)
+    return nil;
+  NSArray* arguments = [tokens subarrayWithRange:NSMakeRange(1, tokens.count - 1)];
+  return [[arguments componentsJoinedByString:@" "] uppercaseString];
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Determines how the engine can be brought from @a currentState to
+/// the state described by the receiver. Returns true if the engine can be
+/// synchronized incrementally, false if the engine must be rebuilt from
+/// scratch.
+///
+/// If this method returns true, the out parameter @a numberOfUndos is set to
+/// the number of moves that must be taken back from @a currentState, and the
+/// out parameter @a indexOfFirstMoveToPlay is set to the index of the first
+/// move in the receiver's @e moves property that must then be played. The
+/// moves up to that index are the longest common prefix of both move lists.
+///
+/// This method returns false if @a currentState is unknown, or if the board
+/// size, komi, handicap or setup differ. A board size of 0 in
+/// @a currentState is treated as matching any board size. This method also
+/// returns false if taking back moves would be more work than replaying the
+/// receiver's moves from scratch.
+// -----------------------------------------------------------------------------
+- (bool) planSyncFromState:(GtpEngineState*)currentState
+             numberOfUndos:(NSUInteger*)numberOfUndos
+    indexOfFirstMoveToPlay:(NSUInteger*)indexOfFirstMoveToPlay
+{
+  if (! currentState.known)
+    return false;
+  if (0 != currentState.boardSize && currentState.boardSize != self.boardSize)
+    return false;
+  if (! stringsAreEqual(currentState.komi, self.komi)
+      || ! stringsAreEqual(currentState.handicap, self.handicap)
+      || ! stringsAreEqual(currentState.setupStones, self.setupStones)
+      || ! stringsAreEqual(currentState.setupPlayer, self.setupPlayer))
+  {
+    return false;
+  }
+
+  NSArray* currentMoves = currentState.moves;
+  NSArray* targetMoves = self.moves;
+  NSUInteger numberOfCurrentMoves = currentMoves.count;
+  NSUInteger numberOfTargetMoves = targetMoves.count;
+  NSUInteger lengthOfCommonPrefix = 0;
+  while (lengthOfCommonPrefix < numberOfCurrentMoves
+         && lengthOfCommonPrefix < numberOfTargetMoves
+         && [[currentMoves objectAtIndex:lengthOfCommonPrefix] isEqualToString:[targetMoves objectAtIndex:lengthOfCommonPrefix]])
+  {
+    lengthOfCommonPrefix++;
+  }
+
+  NSUInteger numberOfMovesToTakeBack = numberOfCurrentMoves - lengthOfCommonPrefix;
+  if (numberOfMovesToTakeBack > numberOfTargetMoves)
+    return false;
+
+  *numberOfUndos = numberOfMovesToTakeBack;
+  *indexOfFirstMoveToPlay = lengthOfCommonPrefix;
+  return true;
+}
+
+@end
@@ -0,0 +1,173 @@
+// -----------------------------------------------------------------------------
+// Copyright 2026 Patrick Näf (herzbube@herzbube.ch)
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// -----------------------------------------------------------------------------
+
+
+// Project includes
+#include "GtpFloatGridDecoder.h"
+
+// System includes
+#include <cmath>
+
+// Global constants
+static const double POWERSOFTEN[] = { 1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11, 1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18 };
+static const int MAXIMUMNUMBEROFSIGNIFICANTDIGITS = 18;
+
+
+// -----------------------------------------------------------------------------
+/// @brief Returns true if @a character separates two numbers on the same
+/// line.
+// -----------------------------------------------------------------------------
+static inline bool isBlank(char character)
+{
+  return (' ' == character || '\t' == character || '\r' == character);
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Decodes the GTP response @a response, which is @a responseLength
+/// bytes long, into @a values. The response must contain @a gridSize lines
+/// with @a gridSize numbers each. @a values must have room for
+/// @a gridSize * @a gridSize elements. Returns true on success. Returns false
+/// if the response does not indicate success, or if the response has too
+/// many or too few lines or numbers.
+///
+/// @a response must start with the status character. Leading empty lines
+/// (e.g. the empty first line of the response to "uct_stat_territory") are
+/// skipped.
+///
+/// If decoding fails, the content of @a values is undefined.
+// -----------------------------------------------------------------------------
+bool GtpFloatGridDecoder::decode(const char* response, size_t responseLength, int gridSize, float* values)
+{
+  if (0 == responseLength || '=' != response[0] || gridSize <= 0)
+    return false;
+
+  const char* position = response + 1;
+  const char* end = response + responseLength;
+  for (int y = gridSize - 1; y >= 0; --y)
+  {
+    // Skip the remainder of the previous line and any empty lines
+    while (position < end && (isBlank(*position) || '\n' == *position))
+      ++position;
+
+    float* rowValues = values + y * gridSize;
+    for (int x = 0; x < gridSize; ++x)
+    {
+      while (position < end && isBlank(*position))
+        ++position;
+      if (! decodeNumber(position, end, rowValues[x]))
+        return false;  // line has not enough numbers, or response has not enough lines
+    }
+
+    while (position < end && isBlank(*position))
+      ++position;
+    if (position < end && '\n' != *position)
+      return false;  // line has too many numbers
+  }
+
+  while (position < end && (isBlank(*position) || '\n' == *position))
+    ++position;
+  return (position == end);  // response has too many lines if there is more
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Decodes the number that starts at @a position and stores it in
+/// @a value. Advances @a position to the first character after the number.
+/// Returns true on success. Returns false if there is no number at
+/// @a position.
+///
+/// Accepts an optional sign, digits with an optional decimal point, and an
+/// optional exponent. Digits beyond the 18th significant digit are ignored,
+/// which is far more precision than a float can represent.
+// -----------------------------------------------------------------------------
+bool GtpFloatGridDecoder::decodeNumber(const char*& position, const char* end, float& value)
+{
+  const char* current = position;
+  bool isNegative = false;
+  if (current < end && ('-' == *current || '+' == *current))
+  {
+    isNegative = ('-' == *current);
+    ++current;
+  }
+
+  unsigned long long mantissa = 0;
+  int numberOfSignificantDigits = 0;
+  int decimalExponent = 0;
+  bool hasDigits = false;
+  bool isFraction = false;
+  for (; current < end; ++current)
+  {
+    char character = *current;
+    if (character >= '0' && character <= '9')
+    {
+      hasDigits = true;
+      if (numberOfSignificantDigits < MAXIMUMNUMBEROFSIGNIFICANTDIGITS)
+      {
+        mantissa = mantissa * 10 + (character - '0');
+        if (mantissa > 0)
+          ++numberOfSignificantDigits;
+        if (isFraction)
+          --decimalExponent;
+      }
+      else if (! isFraction)
+      {
+        ++decimalExponent;
+      }
+    }
+    else if ('.' == character && ! isFraction)
+    {
+      isFraction = true;
+    }
+    else
+    {
+      break;
+    }
+  }
+  if (! hasDigits)
+    return false;
+
+  if (current < end && ('e' == *current || 'E' == *current))
+  {
+    const char* exponentPosition = current + 1;
+    bool exponentIsNegative = false;
+    if (exponentPosition < end && ('-' == *exponentPosition || '+' == *exponentPosition))
+    {
+      exponentIsNegative = ('-' == *exponentPosition);
+      ++exponentPosition;
+    }
+    if (exponentPosition < end && *exponentPosition >= '0' && *exponentPosition <= '9')
+    {
+      int exponent = 0;
+      for (; exponentPosition < end && *exponentPosition >= '0' && *exponentPosition <= '9'; ++exponentPosition)
+      {
+        if (exponent < 1000)
+          exponent = exponent * 10 + (*exponentPosition - '0');
+      }
+      decimalExponent += exponentIsNegative ? -exponent : exponent;
+      current = exponentPosition;
+    }
+  }
+
+  double result = static_cast<double>(mantissa);
+  if (decimalExponent < 0 && decimalExponent >= -MAXIMUMNUMBEROFSIGNIFICANTDIGITS)
+    result /= POWERSOFTEN[-decimalExponent];
+  else if (decimalExponent > 0 && decimalExponent <= MAXIMUMNUMBEROFSIGNIFICANTDIGITS)
+    result *= POWERSOFTEN[decimalExponent];
+  else if (decimalExponent != 0)
+    result *= std::pow(10.0, decimalExponent);
+  value = static_cast<float>(isNegative ? -result : result);
+  position = current;
+  return true;
+}
@@ -0,0 +1,50 @@
+// -----------------------------------------------------------------------------
+// Copyright 2026 Patrick Näf (herzbube@herzbube.ch)
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// -----------------------------------------------------------------------------
+
+
+#pragma once
+
+// System includes
+#include <cstddef>
+
+// -----------------------------------------------------------------------------
+/// @brief The GtpFloatGridDecoder class decodes a GTP response that contains
+/// one floating point number per intersection of the board (e.g. the
+/// response to "uct_stat_territory") into a contiguous array of float values.
+///
+/// @ingroup gtp
+///
+/// The response is expected in the layout that GTP engines use to print
+/// boards: One line per board row, starting with the top row, and one
+/// whitespace-separated number per intersection in each line. The decoded
+/// values are stored in row-major order, starting with the intersection A1,
+/// i.e. the bottom row is stored first. This is the order that
+/// GoBoard::indexOfPoint:() defines.
+///
+/// GtpFloatGridDecoder works directly on the bytes of the response in a
+/// single pass and does not allocate memory. Unlike the C library functions
+/// for converting strings to numbers, GtpFloatGridDecoder does not require
+/// the response to be null-terminated, so it can decode a response while the
+/// response is still located in the receive buffer of GtpResponseFramer.
+// -----------------------------------------------------------------------------
+class GtpFloatGridDecoder
+{
+public:
+  static bool decode(const char* response, size_t responseLength, int gridSize, float* values);
+
+private:
+  static bool decodeNumber(const char*& position, const char* end, float& value);
+};
@@ -0,0 +1,102 @@
+// -----------------------------------------------------------------------------
+// Copyright 2026 Patrick Näf (herzbube@herzbube.ch)
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// -----------------------------------------------------------------------------
+
+
+// Forward declarations
+@class GtpCommand;
+@class GtpFuture;
+@class GtpResponse;
+
+
+/// @brief Enumerates the states that a GtpFuture can be in.
+enum GtpFutureState
+{
+  GtpFutureStatePending,     ///< @brief The outcome is not yet known.
+  GtpFutureStateFulfilled,   ///< @brief The GTP response has been received.
+  GtpFutureStateCancelled,   ///< @brief The future was cancelled before the GTP response was received.
+  GtpFutureStateTimedOut     ///< @brief The GTP response was not received within the time limit.
+};
+
+/// @brief The type of block that is invoked when a GtpFuture completes.
+typedef void (^GtpFutureContinuation)(GtpFuture* future);
+
+
+// -----------------------------------------------------------------------------
+/// @brief The GtpFuture class represents the eventual outcome of an
+/// asynchronously executed GtpCommand.
+///
+/// @ingroup gtp
+///
+/// A GtpFuture is obtained by invoking GtpCommand::submitAsynchronously(). The
+/// future starts out in state #GtpFutureStatePending and completes exactly
+/// once, when one of the following events occurs:
+/// - The GTP response is received (#GtpFutureStateFulfilled). The response
+///   is available from the @e response property.
+/// - Somebody invokes cancel() (#GtpFutureStateCancelled). If the command has
+///   not yet been passed to the GTP engine, GtpClient skips the command. If
+///   the command is already being processed by the GTP engine, the command
+///   runs to completion but the response is ignored.
+/// - The time limit set with timeoutAfter:() expires
+///   (#GtpFutureStateTimedOut). The command runs to completion but the
+///   response is ignored.
+///
+/// Clients react to completion by registering continuation blocks with
+/// then:() or then:onQueue:(). A continuation is never invoked synchronously
+/// by then:(), not even if the future has already completed. Instead it is
+/// dispatched asynchronously to the specified dispatch queue (the main queue
+/// if no queue is specified). No thread is blocked while a future is pending.
+///
+/// Several futures can be combined with whenAll:(), which returns a new future
+/// that completes after all of the combined futures have completed. This
+/// allows a client to issue several GTP commands and join them in a single
+/// continuation.
+///
+/// Clients that run in a secondary thread may also block and wait for a
+/// future to complete with waitWithTimeout:(). This must never be done in the
+/// context of the GtpClient secondary thread.
+///
+/// GtpFuture is thread-safe.
+// -----------------------------------------------------------------------------
+@interface GtpFuture : NSObject
+{
+}
+
++ (GtpFuture*) futureWithCommand:(GtpCommand*)command;
++ (GtpFuture*) whenAll:(NSArray*)futures;
+
+- (GtpFuture*) then:(GtpFutureContinuation)continuation;
+- (GtpFuture*) then:(GtpFutureContinuation)continuation onQueue:(dispatch_queue_t)queue;
+- (GtpFuture*) timeoutAfter:(NSTimeInterval)timeInterval;
+- (void) cancel;
+- (enum GtpFutureState) waitWithTimeout:(NSTimeInterval)timeInterval;
+- (void) fulfillWithResponse:(GtpResponse*)response;
+
+/// @brief The current state of the future.
+@property(nonatomic, assign, readonly) enum GtpFutureState state;
+/// @brief True if the future is cancelled. This is a convenience property
+/// that is equivalent to checking @e state for #GtpFutureStateCancelled.
+@property(nonatomic, assign, readonly, getter=isCancelled) bool cancelled;
+/// @brief The GtpCommand whose outcome this future represents. Is nil for a
+/// future created by whenAll:().
+@property(nonatomic, retain, readonly) GtpCommand* command;
+/// @brief The GTP response. Is nil unless the future is in state
+/// #GtpFutureStateFulfilled. Is always nil for a future created by whenAll:().
+@property(nonatomic, retain, readonly) GtpResponse* response;
+/// @brief The futures that were combined by whenAll:(). Is nil for a future
+/// that represents a single GtpCommand.
+@property(nonatomic, retain, readonly) NSArray* futures;
+
+@end
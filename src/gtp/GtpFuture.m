@@ -0,0 +1,307 @@
+// -----------------------------------------------------------------------------
+// Copyright 2026 Patrick Näf (herzbube@herzbube.ch)
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// -----------------------------------------------------------------------------
+
+
+// Project includes
+#import "GtpFuture.h"
+#import "GtpCommand.h"
+#import "GtpResponse.h"
+
+
+// -----------------------------------------------------------------------------
+/// @brief Class extension with private properties for GtpFuture.
+// -----------------------------------------------------------------------------
+@interface GtpFuture()
+/// @name Re-declaration of properties to make them readwrite privately
+//@{
+@property(nonatomic, assign, readwrite) enum GtpFutureState state;
+@property(nonatomic, retain, readwrite) GtpCommand* command;
+@property(nonatomic, retain, readwrite) GtpResponse* response;
+@property(nonatomic, retain, readwrite) NSArray* futures;
+//@}
+/// @brief Protects @e state, @e response and @e continuations. Is also used
+/// to wake up threads blocked in waitWithTimeout:().
+@property(nonatomic, retain) NSCondition* condition;
+/// @brief Blocks that dispatch the continuations registered while the future
+/// is pending. Is nil after the future has completed.
+@property(nonatomic, retain) NSMutableArray* continuations;
+/// @brief For a future created by whenAll:(), the number of combined futures
+/// that have not yet completed.
+@property(nonatomic, assign) NSUInteger numberOfPendingFutures;
+@end
+
+
+@implementation GtpFuture
+
+// -----------------------------------------------------------------------------
+/// @brief Convenience constructor. Creates a GtpFuture instance that
+/// represents the outcome of @a command.
+///
+/// This is invoked by GtpCommand::submitAsynchronously(), clients normally do
+/// not need to invoke this.
+// -----------------------------------------------------------------------------
++ (GtpFuture*) futureWithCommand:(GtpCommand*)command
+{
+  return [[[GtpFuture alloc] initWithCommand:command futures:nil] autorelease];
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Convenience constructor. Creates a GtpFuture instance that completes
+/// with state #GtpFutureStateFulfilled after all GtpFuture objects in
+/// @a futures have completed, regardless of the state in which they complete.
+/// Clients examine the @e futures property of the returned GtpFuture to find
+/// out about the outcome of the individual futures.
+///
+/// If @a futures is empty the returned GtpFuture is already fulfilled.
+///
+/// Cancelling the returned GtpFuture, or letting it time out, does not affect
+/// the combined futures.
+// -----------------------------------------------------------------------------
++ (GtpFuture*) whenAll:(NSArray*)futures
+{
+  GtpFuture* combinedFuture = [[[GtpFuture alloc] initWithCommand:nil futures:futures] autorelease];
+  if (0 == futures.count)
+  {
+    [combinedFuture completeWithState:GtpFutureStateFulfilled response:nil];
+    return combinedFuture;
+  }
+
+  combinedFuture.numberOfPendingFutures = futures.count;
+  dispatch_queue_t queue = dispatch_get_global_queue(DISPATCH_QUEUE_PRIORITY_DEFAULT, 0);
+  for (GtpFuture* future in futures)
+  {
+    [future then:^(GtpFuture* completedFuture)
+     {
+       [combinedFuture combinedFutureDidComplete];
+     }
+         onQueue:queue];
+  }
+  return combinedFuture;
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Initializes a GtpFuture object.
+///
+/// @note This is the designated initializer of GtpFuture.
+// -----------------------------------------------------------------------------
+- (id) initWithCommand:(GtpCommand*)command futures:(NSArray*)futures
+{
+  // Call designated initializer of superclass (NSObject)
+  self = [super init];
+  if (! self)
+    return nil;
+
+  self.state = GtpFutureStatePending;
+  self.command = command;
+  self.response = nil;
+  self.futures = futures;
+  self.condition = [[[NSCondition alloc] init] autorelease];
+  self.continuations = [NSMutableArray array];
+  self.numberOfPendingFutures = 0;
+
+  return self;
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Deallocates memory allocated by this GtpFuture object.
+// -----------------------------------------------------------------------------
+- (void) dealloc
+{
+  self.command = nil;
+  self.response = nil;
+  self.futures = nil;
+  self.condition = nil;
+  self.continuations = nil;
+  [super dealloc];
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Returns a description for this GtpFuture object.
+///
+/// This method is invoked when GtpFuture needs to be represented as a string,
+/// i.e. by NSLog, or when the debugger command "po" is used on the object.
+// -----------------------------------------------------------------------------
+- (NSString*) description
+{
+  // Don't use self to access properties to avoid unnecessary overhead during
+  // debugging
+  return [NSString stringWithFormat:@"GtpFuture(%p): state = %d, command = %@", self, _state, _command];
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Registers @a continuation to be invoked on the main queue when this
+/// GtpFuture completes. Returns self so that invocations can be chained.
+// -----------------------------------------------------------------------------
+- (GtpFuture*) then:(GtpFutureContinuation)continuation
+{
+  return [self then:continuation onQueue:dispatch_get_main_queue()];
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Registers @a continuation to be invoked on @a queue when this
+/// GtpFuture completes. Returns self so that invocations can be chained.
+///
+/// If this GtpFuture has already completed, @a continuation is dispatched
+/// immediately.
+// -----------------------------------------------------------------------------
+- (GtpFuture*) then:(GtpFutureContinuation)continuation onQueue:(dispatch_queue_t)queue
+{
+  GtpFutureContinuation continuationCopy = [[continuation copy] autorelease];
+  dispatch_block_t dispatchContinuation = ^
+  {
+    dispatch_async(queue, ^
+    {
+      continuationCopy(self);
+    });
+  };
+
+  [self.condition lock];
+  bool isPending = (GtpFutureStatePending == _state);
+  if (isPending)
+    [self.continuations addObject:[[dispatchContinuation copy] autorelease]];
+  [self.condition unlock];
+
+  if (! isPending)
+    dispatchContinuation();
+  return self;
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Lets this GtpFuture complete with state #GtpFutureStateTimedOut if
+/// it is still pending after @a timeInterval seconds. Returns self so that
+/// invocations can be chained.
+// -----------------------------------------------------------------------------
+- (GtpFuture*) timeoutAfter:(NSTimeInterval)timeInterval
+{
+  dispatch_time_t deadline = dispatch_time(DISPATCH_TIME_NOW, (int64_t)(timeInterval * NSEC_PER_SEC));
+  dispatch_after(deadline, dispatch_get_global_queue(DISPATCH_QUEUE_PRIORITY_DEFAULT, 0), ^
+  {
+    if ([self completeWithState:GtpFutureStateTimedOut response:nil])
+      DDLogWarn(@"%@ timed out after %.1f seconds", self, timeInterval);
+  });
+  return self;
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Lets this GtpFuture complete with state #GtpFutureStateCancelled if
+/// it is still pending. Does nothing if the future has already completed.
+// -----------------------------------------------------------------------------
+- (void) cancel
+{
+  [self completeWithState:GtpFutureStateCancelled response:nil];
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Blocks the calling thread until this GtpFuture completes, or until
+/// @a timeInterval seconds have passed. Returns the state of the future at the
+/// time this method returns. The state is #GtpFutureStatePending if the wait
+/// timed out.
+///
+/// Waiting does not cause the future to time out.
+///
+/// @attention Must not be invoked in the context of the main thread if the
+/// future's completion depends on the main thread, nor in the context of the
+/// GtpClient secondary thread.
+// -----------------------------------------------------------------------------
+- (enum GtpFutureState) waitWithTimeout:(NSTimeInterval)timeInterval
+{
+  NSDate* limitDate = [NSDate dateWithTimeIntervalSinceNow:timeInterval];
+  [self.condition lock];
+  while (GtpFutureStatePending == _state)
+  {
+    if (! [self.condition waitUntilDate:limitDate])
+      break;
+  }
+  enum GtpFutureState state = _state;
+  [self.condition unlock];
+  return state;
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Lets this GtpFuture complete with state #GtpFutureStateFulfilled and
+/// the GTP response @a response. Does nothing if the future has already
+/// completed, e.g. because it was cancelled or timed out.
+///
+/// This is invoked by GtpClient, clients normally do not need to invoke this.
+// -----------------------------------------------------------------------------
+- (void) fulfillWithResponse:(GtpResponse*)response
+{
+  [self completeWithState:GtpFutureStateFulfilled response:response];
+}
+
+// -----------------------------------------------------------------------------
+// Property is documented in the header file.
+// -----------------------------------------------------------------------------
+- (enum GtpFutureState) state
+{
+  [self.condition lock];
+  enum GtpFutureState state = _state;
+  [self.condition unlock];
+  return state;
+}
+
+// -----------------------------------------------------------------------------
+// Property is documented in the header file.
+// -----------------------------------------------------------------------------
+- (bool) isCancelled
+{
+  return (GtpFutureStateCancelled == self.state);
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Private helper. Changes the state of this GtpFuture from
+/// #GtpFutureStatePending to @a state, stores @a response, wakes up all
+/// threads blocked in waitWithTimeout:() and dispatches all continuations.
+/// Returns true if the state was changed, false if this GtpFuture had already
+/// completed.
+// -----------------------------------------------------------------------------
+- (bool) completeWithState:(enum GtpFutureState)state response:(GtpResponse*)response
+{
+  [self.condition lock];
+  if (GtpFutureStatePending != _state)
+  {
+    [self.condition unlock];
+    return false;
+  }
+  self.response = response;
+  _state = state;
+  // Breaks the retain cycle between this GtpFuture and the blocks
+  NSArray* continuations = [[self.continuations retain] autorelease];
+  self.continuations = nil;
+  [self.condition broadcast];
+  [self.condition unlock];
+
+  for (dispatch_block_t dispatchContinuation in continuations)
+    dispatchContinuation();
+  return true;
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Private helper for whenAll:(). Is invoked when one of the combined
+/// futures has completed.
+// -----------------------------------------------------------------------------
+- (void) combinedFutureDidComplete
+{
+  [self.condition lock];
+  self.numberOfPendingFutures--;
+  bool allFuturesHaveCompleted = (0 == self.numberOfPendingFutures);
+  [self.condition unlock];
+
+  if (allFuturesHaveCompleted)
+    [self completeWithState:GtpFutureStateFulfilled response:nil];
+}
+
+@end
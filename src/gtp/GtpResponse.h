@@ -19,6 +19,45 @@
 @class GtpCommand;
 
 
+// -----------------------------------------------------------------------------
+/// @brief Enumerates special board index values that GtpResponse uses for
+/// moves that are not played on an intersection.
+// -----------------------------------------------------------------------------
+enum GtpResponseBoardIndex
+{
+  GtpResponseBoardIndexPass = -2,   ///< @brief The move is a pass move.
+  GtpResponseBoardIndexResign = -3  ///< @brief The move is a resignation.
+};
+
+// -----------------------------------------------------------------------------
+/// @brief A move in the result of GtpResponse::movesWithBoardSize:().
+// -----------------------------------------------------------------------------
+struct GtpResponseMove
+{
+  /// @brief The color of the player who made the move. Is either #GoColorBlack
+  /// or #GoColorWhite.
+  enum GoColor color;
+  /// @brief The board index of the intersection on which the move was played,
+  /// in the order defined by GoBoard::indexOfPoint:(). Is one of the values
+  /// of #GtpResponseBoardIndex if the move was not played on an intersection.
+  int boardIndex;
+};
+
+// -----------------------------------------------------------------------------
+/// @brief Enumerates the reasons why
+/// GtpResponse::movesWithBoardSize:error:invalidMoveColor:invalidMoveVertex:()
+/// can fail.
+// -----------------------------------------------------------------------------
+enum GtpResponseMoveListError
+{
+  GtpResponseMoveListErrorNone,          ///< @brief The move list was parsed successfully.
+  GtpResponseMoveListErrorStatus,        ///< @brief The response does not indicate success.
+  GtpResponseMoveListErrorFormat,        ///< @brief A move does not consist of a color and a vertex.
+  GtpResponseMoveListErrorInvalidColor,  ///< @brief The color of a move is not a valid color.
+  GtpResponseMoveListErrorInvalidVertex  ///< @brief The vertex of a move is not a valid vertex.
+};
+
+
 // -----------------------------------------------------------------------------
 /// @brief The GtpResponse class represents a Go Text Protocol (GTP) response.
 ///
@@ -27,13 +66,36 @@
 /// GtpResponse is mainly a wrapper around a string that forms the actual GTP
 /// response. The raw response includes the status prefix, while the parsed
 /// response does not.
+///
+/// GtpResponse also provides access to the individual lines of the parsed
+/// response. Clients should prefer numberOfLines() and lineAtIndex:() over
+/// splitting the parsed response themselves: GtpClient already knows where
+/// the lines start because it has framed the response, so GtpResponse does
+/// not have to scan the response again.
+///
+/// Clients that need the content of the response in a structured form use the
+/// typed accessors boardIndexesWithBoardSize:(), movesWithBoardSize:(),
+/// keyValuePairs() and floatGridWithSize:(). These tokenize the response once
+/// with GtpResponseParser and map vertices directly to board indexes, without
+/// creating intermediate string objects.
 // -----------------------------------------------------------------------------
 @interface GtpResponse : NSObject
 {
 }
 
 + (GtpResponse*) response:(NSString*)response toCommand:(GtpCommand*)command;
++ (GtpResponse*) response:(NSString*)response lineOffsets:(NSData*)lineOffsets toCommand:(GtpCommand*)command;
 - (NSString*) parsedResponse;
+- (NSUInteger) numberOfLines;
+- (NSString*) lineAtIndex:(NSUInteger)index;
+- (NSData*) boardIndexesWithBoardSize:(int)boardSize;
+- (NSData*) movesWithBoardSize:(int)boardSize;
+- (NSData*) movesWithBoardSize:(int)boardSize
+                         error:(enum GtpResponseMoveListError*)error
+              invalidMoveColor:(NSString**)invalidMoveColor
+             invalidMoveVertex:(NSString**)invalidMoveVertex;
+- (NSDictionary*) keyValuePairs;
+- (NSData*) floatGridWithSize:(int)gridSize;
 
 /// @brief The raw response string, which includes the status prefix.
 @property(nonatomic, retain, readonly) NSString* rawResponse;
@@ -45,5 +107,13 @@
 /// @brief The response status, i.e. whether command execution was successful
 /// (status is true) or not (status is false).
 @property(nonatomic, assign, readonly) bool status;
+/// @brief The response decoded into an array of float values, one value per
+/// intersection of the board, in the order defined by
+/// GoBoard::indexOfPoint:().
+///
+/// Is nil unless the command's GtpCommand::floatGridSize property requested
+/// decoding and decoding was successful. GtpClient sets this property when it
+/// creates the GtpResponse object. See GtpFloatGridDecoder for details.
+@property(nonatomic, retain) NSData* floatGrid;
 
 @end
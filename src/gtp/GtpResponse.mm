@@ -0,0 +1,377 @@
+// -----------------------------------------------------------------------------
+// Copyright 2011-2013 Patrick Näf (herzbube@herzbube.ch)
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// -----------------------------------------------------------------------------
+
+
+// Project includes
+#import "GtpResponse.h"
+#import "GtpResponseParser.h"
+
+// C++ standard library
+#include <vector>
+
+
+static_assert(GtpResponseBoardIndexPass == GtpResponseParser::passBoardIndex, "GtpResponseBoardIndexPass must match GtpResponseParser");
+static_assert(GtpResponseBoardIndexResign == GtpResponseParser::resignBoardIndex, "GtpResponseBoardIndexResign must match GtpResponseParser");
+static_assert(GtpResponseMoveListErrorNone == (int)GtpResponseParser::MoveListErrorNone &&
+              GtpResponseMoveListErrorStatus == (int)GtpResponseParser::MoveListErrorStatus &&
+              GtpResponseMoveListErrorFormat == (int)GtpResponseParser::MoveListErrorFormat &&
+              GtpResponseMoveListErrorInvalidColor == (int)GtpResponseParser::MoveListErrorInvalidColor &&
+              GtpResponseMoveListErrorInvalidVertex == (int)GtpResponseParser::MoveListErrorInvalidVertex,
+              "GtpResponseMoveListError must match GtpResponseParser");
+
+
+// -----------------------------------------------------------------------------
+/// @brief Class extension with private properties for GtpResponse.
+// -----------------------------------------------------------------------------
+@interface GtpResponse()
+/// @name Re-declaration of properties to make them readwrite privately
+//@{
+@property(nonatomic, retain, readwrite) NSString* rawResponse;
+@property(nonatomic, assign, readwrite) GtpCommand* command;
+//@}
+/// @brief Array of NSUInteger values. Each value is the offset into
+/// @e rawResponse at which a line of the response starts. Is nil until the
+/// line offsets are needed, unless the creator of the GtpResponse object
+/// provided them.
+@property(nonatomic, retain) NSData* lineOffsets;
+@end
+
+
+@implementation GtpResponse
+
+// -----------------------------------------------------------------------------
+/// @brief Convenience constructor. Creates a GtpResponse instance that wraps
+/// the response string @a response, and is a response to @a command.
+// -----------------------------------------------------------------------------
++ (GtpResponse*) response:(NSString*)response toCommand:(GtpCommand*)command
+{
+  return [GtpResponse response:response lineOffsets:nil toCommand:command];
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Convenience constructor. Creates a GtpResponse instance that wraps
+/// the response string @a response, and is a response to @a command.
+///
+/// @a lineOffsets is an array of NSUInteger values. Each value is the offset
+/// into @a response at which a line of the response starts. If
+/// @a lineOffsets is nil, the line offsets are determined when they are
+/// needed for the first time.
+// -----------------------------------------------------------------------------
++ (GtpResponse*) response:(NSString*)response lineOffsets:(NSData*)lineOffsets toCommand:(GtpCommand*)command
+{
+  GtpResponse* resp = [[GtpResponse alloc] init];
+  if (resp)
+  {
+    resp.rawResponse = response;
+    resp.lineOffsets = lineOffsets;
+    resp.command = command;
+    [resp autorelease];
+    DDLogInfo(@"Received %@ (to %@)", resp, command);
+  }
+  return resp;
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Initializes a GtpResponse object.
+///
+/// @note This is the designated initializer of GtpResponse.
+// -----------------------------------------------------------------------------
+- (id) init
+{
+  // Call designated initializer of superclass (NSObject)
+  self = [super init];
+  if (! self)
+    return nil;
+
+  self.rawResponse = nil;
+  self.command = nil;
+  self.lineOffsets = nil;
+  self.floatGrid = nil;
+
+  return self;
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Deallocates memory allocated by this GtpResponse object.
+// -----------------------------------------------------------------------------
+- (void) dealloc
+{
+  self.rawResponse = nil;
+  self.command = nil;
+  self.lineOffsets = nil;
+  self.floatGrid = nil;
+  [super dealloc];
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Returns a description for this GtpResponse object.
+///
+/// This method is invoked when GtpResponse needs to be represented as a string,
+/// i.e. by NSLog, or when the debugger command "po" is used on the object.
+// -----------------------------------------------------------------------------
+- (NSString*) description
+{
+  // Don't use self to access properties to avoid unnecessary overhead during
+  // debugging
+  return [NSString stringWithFormat:@"GtpResponse(%p): %@", self, _rawResponse];
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Returns the parsed response string, which is the raw response without
+/// the status prefix.
+// -----------------------------------------------------------------------------
+- (NSString*) parsedResponse
+{
+  if (! self.rawResponse)
+    return nil;
+  // Remove status
+  NSString* parsedResponse = [self.rawResponse substringFromIndex:2];
+  return [[parsedResponse retain] autorelease];
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Returns the number of lines in the parsed response. A response that
+/// consists only of the status prefix has one (empty) line.
+// -----------------------------------------------------------------------------
+- (NSUInteger) numberOfLines
+{
+  return [self lineOffsetsData].length / sizeof(NSUInteger);
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Returns the line at index position @a index of the parsed response,
+/// without the newline character. The first line does not include the status
+/// prefix.
+///
+/// Raises an @e NSRangeException if @a index is not smaller than the value
+/// returned by numberOfLines().
+// -----------------------------------------------------------------------------
+- (NSString*) lineAtIndex:(NSUInteger)index
+{
+  NSData* lineOffsetsData = [self lineOffsetsData];
+  NSUInteger numberOfLines = lineOffsetsData.length / sizeof(NSUInteger);
+  if (index >= numberOfLines)
+  {
+    NSString* errorMessage = [NSString stringWithFormat:@"Line index %lu is out of range, response has %lu lines", (unsigned long)index, (unsigned long)numberOfLines];
+    DDLogError(@"%@: %@", self, errorMessage);
+    NSException* exception = [NSException exceptionWithName:NSRangeException
+                                                     reason:errorMessage
+                                                   userInfo:nil];
+    @throw exception;
+  }
+
+  const NSUInteger* lineOffsets = (const NSUInteger*)lineOffsetsData.bytes;
+  NSString* rawResponse = self.rawResponse;
+  // The first line starts after the status prefix
+  NSUInteger lineStart = (0 == index) ? MIN(2, rawResponse.length) : lineOffsets[index];
+  // Subtract 1 for the newline character that separates the lines
+  NSUInteger lineEnd = (index + 1 < numberOfLines) ? lineOffsets[index + 1] - 1 : rawResponse.length;
+  return [rawResponse substringWithRange:NSMakeRange(lineStart, lineEnd - lineStart)];
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Private helper for numberOfLines() and lineAtIndex:(). Returns the
+/// line offsets, determining them first if they are not known yet.
+// -----------------------------------------------------------------------------
+- (NSData*) lineOffsetsData
+{
+  if (self.lineOffsets)
+    return self.lineOffsets;
+
+  NSMutableData* lineOffsets = [NSMutableData data];
+  NSString* rawResponse = self.rawResponse;
+  NSUInteger rawResponseLength = rawResponse.length;
+  if (rawResponseLength > 0)
+  {
+    NSUInteger lineStart = 0;
+    while (true)
+    {
+      [lineOffsets appendBytes:&lineStart length:sizeof(lineStart)];
+      NSRange newlineRange = [rawResponse rangeOfString:@"\n"
+                                                options:NSLiteralSearch
+                                                  range:NSMakeRange(lineStart, rawResponseLength - lineStart)];
+      if (NSNotFound == newlineRange.location)
+        break;
+      lineStart = newlineRange.location + 1;
+    }
+  }
+  self.lineOffsets = lineOffsets;
+  return lineOffsets;
+}
+
+// -----------------------------------------------------------------------------
+// Property is documented in the header file.
+// -----------------------------------------------------------------------------
+- (bool) status
+{
+  if (! self.rawResponse)
+    return false;
+  NSString* statusString = [self.rawResponse substringWithRange:NSMakeRange(0, 1)];
+  if (NSOrderedSame == [statusString compare:@"="])
+    return true;
+  else
+    return false;
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Interprets the response as a list of vertices on a board of size
+/// @a boardSize, e.g. the response to "final_status_list dead". Returns an
+/// array of int values, one board index per vertex, in the order defined by
+/// GoBoard::indexOfPoint:(). Returns nil if the response does not indicate
+/// success, or if it contains a token that is not a valid vertex.
+// -----------------------------------------------------------------------------
+- (NSData*) boardIndexesWithBoardSize:(int)boardSize
+{
+  const char* response = [self.rawResponse UTF8String];
+  if (! response)
+    return nil;
+  GtpResponseParser parser(response, strlen(response));
+  std::vector<int> boardIndexes;
+  if (! parser.parseVertexList(boardSize, boardIndexes))
+    return nil;
+  return [NSData dataWithBytes:boardIndexes.data() length:boardIndexes.size() * sizeof(int)];
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Interprets the response as a list of moves on a board of size
+/// @a boardSize, e.g. "B D4, W PASS". Returns an array of GtpResponseMove
+/// structs, one per move. Returns nil if the response does not indicate
+/// success, or if the move list is malformed. See
+/// GtpResponseParser::parseMoveList() for details about the format.
+// -----------------------------------------------------------------------------
+- (NSData*) movesWithBoardSize:(int)boardSize
+{
+  return [self movesWithBoardSize:boardSize error:NULL invalidMoveColor:nil invalidMoveVertex:nil];
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Same as movesWithBoardSize:(), but in addition reports why the move
+/// list could not be parsed. Any of the out parameters may be NULL.
+///
+/// On success, @a error is set to #GtpResponseMoveListErrorNone. On failure,
+/// @a error is set to one of the other values of #GtpResponseMoveListError,
+/// and @a invalidMoveColor and @a invalidMoveVertex are set to the color and
+/// the vertex of the move that could not be parsed, exactly as they appear
+/// in the response. They are set to empty strings if the move does not have
+/// a color or a vertex, or if the failure is not related to a specific move.
+// -----------------------------------------------------------------------------
+- (NSData*) movesWithBoardSize:(int)boardSize
+                         error:(enum GtpResponseMoveListError*)error
+              invalidMoveColor:(NSString**)invalidMoveColor
+             invalidMoveVertex:(NSString**)invalidMoveVertex
+{
+  if (error)
+    *error = GtpResponseMoveListErrorStatus;
+  if (invalidMoveColor)
+    *invalidMoveColor = @"";
+  if (invalidMoveVertex)
+    *invalidMoveVertex = @"";
+
+  const char* response = [self.rawResponse UTF8String];
+  if (! response)
+    return nil;
+  GtpResponseParser parser(response, strlen(response));
+  std::vector<GtpResponseParser::Move> parsedMoves;
+  GtpResponseParser::MoveListFailure failure;
+  bool success = parser.parseMoveList(boardSize, parsedMoves, failure);
+  if (error)
+    *error = (enum GtpResponseMoveListError)failure.error;
+  if (! success)
+  {
+    // If a token is not valid UTF-8 the empty string remains
+    NSString* colorString = [[[NSString alloc] initWithBytes:failure.colorToken.begin
+                                                      length:failure.colorToken.length
+                                                    encoding:NSUTF8StringEncoding] autorelease];
+    NSString* vertexString = [[[NSString alloc] initWithBytes:failure.vertexToken.begin
+                                                       length:failure.vertexToken.length
+                                                     encoding:NSUTF8StringEncoding] autorelease];
+    if (invalidMoveColor && colorString)
+      *invalidMoveColor = colorString;
+    if (invalidMoveVertex && vertexString)
+      *invalidMoveVertex = vertexString;
+    return nil;
+  }
+
+  NSMutableData* moves = [NSMutableData dataWithLength:parsedMoves.size() * sizeof(struct GtpResponseMove)];
+  struct GtpResponseMove* move = (struct GtpResponseMove*)moves.mutableBytes;
+  for (const GtpResponseParser::Move& parsedMove : parsedMoves)
+  {
+    move->color = (GtpResponseParser::MoveColorBlack == parsedMove.color) ? GoColorBlack : GoColorWhite;
+    move->boardIndex = parsedMove.boardIndex;
+    ++move;
+  }
+  return moves;
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Interprets each line of the response as a key/value pair. Returns a
+/// dictionary whose keys and values are NSString objects. Returns nil if the
+/// response does not indicate success. If a key appears more than once, the
+/// last value wins. See GtpResponseParser::parseKeyValuePairs() for details
+/// about the format.
+// -----------------------------------------------------------------------------
+- (NSDictionary*) keyValuePairs
+{
+  const char* response = [self.rawResponse UTF8String];
+  if (! response)
+    return nil;
+  GtpResponseParser parser(response, strlen(response));
+  std::vector<GtpResponseParser::KeyValuePair> parsedKeyValuePairs;
+  if (! parser.parseKeyValuePairs(parsedKeyValuePairs))
+    return nil;
+
+  NSMutableDictionary* keyValuePairs = [NSMutableDictionary dictionaryWithCapacity:parsedKeyValuePairs.size()];
+  for (const GtpResponseParser::KeyValuePair& parsedKeyValuePair : parsedKeyValuePairs)
+  {
+    NSString* key = [[[NSString alloc] initWithBytes:parsedKeyValuePair.key.begin
+                                              length:parsedKeyValuePair.key.length
+                                            encoding:NSUTF8StringEncoding] autorelease];
+    NSString* value = [[[NSString alloc] initWithBytes:parsedKeyValuePair.value.begin
+                                                length:parsedKeyValuePair.value.length
+                                              encoding:NSUTF8StringEncoding] autorelease];
+    if (key && value)
+      [keyValuePairs setObject:value forKey:key];
+  }
+  return keyValuePairs;
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Returns the response decoded into an array of float values, one
+/// value per intersection of a board of size @a gridSize, in the order
+/// defined by GoBoard::indexOfPoint:(). Returns nil if the response cannot be
+/// decoded.
+///
+/// Returns the value of the @e floatGrid property if GtpClient has already
+/// decoded the response. Otherwise decodes the response with
+/// GtpResponseParser.
+// -----------------------------------------------------------------------------
+- (NSData*) floatGridWithSize:(int)gridSize
+{
+  NSUInteger floatGridLength = gridSize * gridSize * sizeof(float);
+  if (self.floatGrid && self.floatGrid.length == floatGridLength)
+    return self.floatGrid;
+
+  const char* response = [self.rawResponse UTF8String];
+  if (! response)
+    return nil;
+  GtpResponseParser parser(response, strlen(response));
+  NSMutableData* floatGrid = [NSMutableData dataWithLength:floatGridLength];
+  if (! parser.parseFloatGrid(gridSize, (float*)floatGrid.mutableBytes))
+    return nil;
+  return floatGrid;
+}
+
+@end
@@ -0,0 +1,256 @@
+// -----------------------------------------------------------------------------
+// Copyright 2026 Patrick Näf (herzbube@herzbube.ch)
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// -----------------------------------------------------------------------------
+
+
+// Project includes
+#include "GtpResponseFramer.h"
+
+// System includes
+#include <algorithm>
+#include <cctype>
+#include <cstring>
+
+// Global constants
+static const size_t INITIALBUFFERSIZE = 16384;
+
+
+// -----------------------------------------------------------------------------
+/// @brief Initializes a GtpResponseFramer object that reads from
+/// @a streamBuffer.
+// -----------------------------------------------------------------------------
+GtpResponseFramer::GtpResponseFramer(std::streambuf* streamBuffer) :
+  streamBuffer(streamBuffer),
+  buffer(INITIALBUFFERSIZE),
+  bufferStart(0),
+  bufferEnd(0),
+  endOfFileWasReached(false),
+  responseStart(0),
+  responseEnd(0),
+  responseCommandID(0)
+{
+  this->responseLineOffsets.reserve(64);
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Destroys the GtpResponseFramer object.
+// -----------------------------------------------------------------------------
+GtpResponseFramer::~GtpResponseFramer()
+{
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Blocks until at least the first character of the next response is
+/// available. Returns true if data is available. Returns false if the stream
+/// buffer has reached end-of-file and no more data is available.
+// -----------------------------------------------------------------------------
+bool GtpResponseFramer::waitForResponseData()
+{
+  if (this->bufferStart < this->bufferEnd)
+    return true;
+  discardConsumedData();
+  return fillBuffer();
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Reads the next response, blocking if the stream buffer does not yet
+/// contain the complete response. Returns true if a response was read. Returns
+/// false if the stream buffer has reached end-of-file and no more data is
+/// available.
+///
+/// If end-of-file is reached in the middle of a response, the incomplete
+/// response is returned as if it were complete.
+// -----------------------------------------------------------------------------
+bool GtpResponseFramer::readNextResponse()
+{
+  discardConsumedData();
+
+  this->responseStart = this->bufferStart;
+  this->responseLineOffsets.clear();
+  size_t lineStart = this->bufferStart;
+  size_t scanPosition = this->bufferStart;
+
+  while (true)
+  {
+    const char* newline = static_cast<const char*>(memchr(&this->buffer[scanPosition], '\n', this->bufferEnd - scanPosition));
+    if (newline)
+    {
+      size_t newlinePosition = newline - &this->buffer[0];
+      if (newlinePosition == lineStart)
+      {
+        // Empty line terminates the response. The newline character of the
+        // previous line is not part of the response.
+        this->responseEnd = (lineStart > this->responseStart) ? lineStart - 1 : lineStart;
+        this->bufferStart = newlinePosition + 1;
+        break;
+      }
+      this->responseLineOffsets.push_back(lineStart - this->responseStart);
+      lineStart = newlinePosition + 1;
+      scanPosition = lineStart;
+      continue;
+    }
+
+    scanPosition = this->bufferEnd;
+    if (fillBuffer())
+      continue;
+
+    // End-of-file
+    if (this->bufferEnd == this->responseStart)
+      return false;
+    if (lineStart < this->bufferEnd)
+    {
+      this->responseLineOffsets.push_back(lineStart - this->responseStart);
+      this->responseEnd = this->bufferEnd;
+    }
+    else
+    {
+      this->responseEnd = lineStart - 1;
+    }
+    this->bufferStart = this->bufferEnd;
+    break;
+  }
+
+  removeCommandID();
+
+  if (1 == this->responseEnd - this->responseStart)
+  {
+    // The character after the response is the terminator or, at end-of-file,
+    // spare capacity that fillBuffer() always leaves
+    this->buffer[this->responseEnd] = ' ';
+    this->responseEnd++;
+  }
+
+  return true;
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Returns a pointer to the first character of the response that was
+/// read by the last invocation of readNextResponse(). The response is not
+/// zero-terminated.
+// -----------------------------------------------------------------------------
+const char* GtpResponseFramer::responseData() const
+{
+  return &this->buffer[this->responseStart];
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Returns the number of characters in the response that was read by
+/// the last invocation of readNextResponse().
+// -----------------------------------------------------------------------------
+size_t GtpResponseFramer::responseLength() const
+{
+  return this->responseEnd - this->responseStart;
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Returns the command ID of the response that was read by the last
+/// invocation of readNextResponse(). Returns 0 if the response has no command
+/// ID.
+// -----------------------------------------------------------------------------
+unsigned int GtpResponseFramer::commandID() const
+{
+  return this->responseCommandID;
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Returns the offsets at which the lines of the response that was read
+/// by the last invocation of readNextResponse() start. The offsets are
+/// relative to responseData(). The first line always starts at offset 0.
+/// Lines are separated by a single newline character.
+///
+/// An empty response has no lines.
+// -----------------------------------------------------------------------------
+const std::vector<size_t>& GtpResponseFramer::lineOffsets() const
+{
+  return this->responseLineOffsets;
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Private helper for readNextResponse(). Moves unconsumed data to the
+/// start of the buffer, so that the buffer has as much free space as possible.
+// -----------------------------------------------------------------------------
+void GtpResponseFramer::discardConsumedData()
+{
+  if (0 == this->bufferStart)
+    return;
+  size_t numberOfUnconsumedCharacters = this->bufferEnd - this->bufferStart;
+  if (numberOfUnconsumedCharacters > 0)
+    memmove(&this->buffer[0], &this->buffer[this->bufferStart], numberOfUnconsumedCharacters);
+  this->bufferStart = 0;
+  this->bufferEnd = numberOfUnconsumedCharacters;
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Private helper for readNextResponse(). Appends the data that is
+/// available in the stream buffer to the internal buffer, blocking if no data
+/// is available. Returns true if data was appended, false if the stream
+/// buffer has reached end-of-file.
+///
+/// Always leaves at least one character of spare capacity at the end of the
+/// internal buffer.
+// -----------------------------------------------------------------------------
+bool GtpResponseFramer::fillBuffer()
+{
+  if (this->endOfFileWasReached)
+    return false;
+
+  if (this->bufferEnd + 1 >= this->buffer.size())
+    this->buffer.resize(this->buffer.size() * 2);
+
+  std::streamsize numberOfAvailableCharacters = this->streamBuffer->in_avail();
+  if (numberOfAvailableCharacters <= 0)
+  {
+    // Blocks until the writing side has published data
+    if (std::streambuf::traits_type::eq_int_type(this->streamBuffer->sgetc(), std::streambuf::traits_type::eof()))
+    {
+      this->endOfFileWasReached = true;
+      return false;
+    }
+    numberOfAvailableCharacters = std::max(this->streamBuffer->in_avail(), static_cast<std::streamsize>(1));
+  }
+
+  std::streamsize freeCapacity = this->buffer.size() - this->bufferEnd - 1;
+  std::streamsize numberOfCharactersRead = this->streamBuffer->sgetn(&this->buffer[this->bufferEnd],
+                                                                     std::min(numberOfAvailableCharacters, freeCapacity));
+  this->bufferEnd += numberOfCharactersRead;
+  return numberOfCharactersRead > 0;
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Private helper for readNextResponse(). Parses the command ID that
+/// follows the status character of the response and removes it in place by
+/// moving the status character forward. Adjusts the line offsets.
+// -----------------------------------------------------------------------------
+void GtpResponseFramer::removeCommandID()
+{
+  this->responseCommandID = 0;
+
+  size_t indexOfFirstDigit = this->responseStart + 1;
+  size_t indexAfterLastDigit = indexOfFirstDigit;
+  while (indexAfterLastDigit < this->responseEnd && isdigit(static_cast<unsigned char>(this->buffer[indexAfterLastDigit])))
+  {
+    this->responseCommandID = this->responseCommandID * 10 + (this->buffer[indexAfterLastDigit] - '0');
+    indexAfterLastDigit++;
+  }
+  if (indexAfterLastDigit == indexOfFirstDigit)
+    return;
+
+  size_t numberOfDigits = indexAfterLastDigit - indexOfFirstDigit;
+  this->buffer[indexAfterLastDigit - 1] = this->buffer[this->responseStart];
+  this->responseStart += numberOfDigits;
+  // The first line still starts at offset 0
+  for (size_t lineIndex = 1; lineIndex < this->responseLineOffsets.size(); ++lineIndex)
+    this->responseLineOffsets[lineIndex] -= numberOfDigits;
+}
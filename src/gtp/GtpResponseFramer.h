@@ -0,0 +1,96 @@
+// -----------------------------------------------------------------------------
+// Copyright 2026 Patrick Näf (herzbube@herzbube.ch)
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// -----------------------------------------------------------------------------
+
+
+#pragma once
+
+// System includes
+#include <streambuf>
+#include <vector>
+
+// -----------------------------------------------------------------------------
+/// @brief The GtpResponseFramer class reads GTP responses from a stream buffer
+/// and hands them out as slices of an internal buffer, together with the
+/// offsets at which the lines of the response start.
+///
+/// @ingroup gtp
+///
+/// A GTP response is terminated by an empty line, i.e. by two consecutive
+/// newline characters. GtpResponseFramer moves the data that is available in
+/// the stream buffer into its internal buffer in bulk, then scans the buffer
+/// for newline characters with memchr(). While it scans, GtpResponseFramer
+/// records the line offsets. Data that follows the terminator of a response
+/// (i.e. the beginning of the next response in a pipeline) remains in the
+/// internal buffer and is framed on the next invocation of
+/// readNextResponse().
+///
+/// The internal buffer grows as needed but never shrinks, so in a steady
+/// state framing a response allocates no memory. Compared to assembling the
+/// response line by line with std::getline(), this saves a temporary
+/// std::string per line and a second std::string for the entire response.
+/// The only copy that remains is the copy that the caller makes when it
+/// converts the slice into an object of its own (e.g. an NSString).
+///
+/// If a response starts with a command ID (e.g. "=42 foo"), the command ID is
+/// removed in place, so that the slice looks like a response to a command
+/// without ID (e.g. "= foo"). A response that consists only of the status
+/// character is extended with a space character, again in place. The
+/// command ID is available via commandID().
+///
+/// GtpResponseFramer must be the only reader of the stream buffer, because
+/// it reads ahead.
+///
+/// The slice and the line offsets remain valid until the next invocation of
+/// readNextResponse().
+///
+/// A client that wants to know when the first byte of a response became
+/// available invokes waitForResponseData() before it invokes
+/// readNextResponse().
+// -----------------------------------------------------------------------------
+class GtpResponseFramer
+{
+public:
+  GtpResponseFramer(std::streambuf* streamBuffer);
+  ~GtpResponseFramer();
+
+  bool waitForResponseData();
+  bool readNextResponse();
+  const char* responseData() const;
+  size_t responseLength() const;
+  unsigned int commandID() const;
+  const std::vector<size_t>& lineOffsets() const;
+
+private:
+  GtpResponseFramer(const GtpResponseFramer&) = delete;
+  GtpResponseFramer& operator=(const GtpResponseFramer&) = delete;
+
+  void discardConsumedData();
+  bool fillBuffer();
+  void removeCommandID();
+
+  std::streambuf* streamBuffer;
+  std::vector<char> buffer;
+  // The buffer contains unconsumed data in the range [bufferStart, bufferEnd)
+  size_t bufferStart;
+  size_t bufferEnd;
+  bool endOfFileWasReached;
+
+  size_t responseStart;
+  size_t responseEnd;
+  unsigned int responseCommandID;
+  // Offsets relative to responseStart
+  std::vector<size_t> responseLineOffsets;
+};
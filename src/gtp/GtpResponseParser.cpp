@@ -0,0 +1,322 @@
+// -----------------------------------------------------------------------------
+// Copyright 2026 Patrick Näf (herzbube@herzbube.ch)
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// -----------------------------------------------------------------------------
+
+
+// Project includes
+#include "GtpResponseParser.h"
+#include "GtpFloatGridDecoder.h"
+
+// System includes
+#include <cctype>
+
+
+// -----------------------------------------------------------------------------
+/// @brief Returns true if @a character separates two tokens on the same line.
+// -----------------------------------------------------------------------------
+static inline bool isBlank(char character)
+{
+  return (' ' == character || '\t' == character || '\r' == character);
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Returns true if the token has the same characters as the
+/// null-terminated string @a string, ignoring case. @a string must be in
+/// lowercase.
+// -----------------------------------------------------------------------------
+bool GtpResponseParser::Token::equalsIgnoringCase(const char* string) const
+{
+  for (size_t index = 0; index < length; ++index, ++string)
+  {
+    if ('\0' == *string || std::tolower(static_cast<unsigned char>(begin[index])) != *string)
+      return false;
+  }
+  return ('\0' == *string);
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Initializes a GtpResponseParser object with the GTP response
+/// @a response, which is @a responseLength bytes long, and tokenizes the
+/// response. The response must start with the status character.
+// -----------------------------------------------------------------------------
+GtpResponseParser::GtpResponseParser(const char* response, size_t responseLength)
+: response(response),
+  responseLength(responseLength)
+{
+  tokenize();
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Private helper for the constructor. Splits the response into tokens
+/// in a single pass.
+// -----------------------------------------------------------------------------
+void GtpResponseParser::tokenize()
+{
+  if (0 == responseLength)
+    return;
+
+  // Skip the status character
+  const char* position = response + 1;
+  const char* end = response + responseLength;
+  while (position < end)
+  {
+    char character = *position;
+    if (isBlank(character) || ',' == character || '\n' == character)
+    {
+      // A separator without preceding token (e.g. an empty line) is only
+      // relevant if it is stronger than the separator of the previous token
+      if (! responseTokens.empty())
+      {
+        Token& previousToken = responseTokens.back();
+        if (',' == character && SeparatorBlank == previousToken.separator)
+          previousToken.separator = SeparatorComma;
+        else if ('\n' == character)
+          previousToken.separator = SeparatorNewline;
+      }
+      ++position;
+      continue;
+    }
+
+    const char* tokenBegin = position;
+    while (position < end && ! isBlank(*position) && ',' != *position && '\n' != *position)
+      ++position;
+    Token token = { tokenBegin, static_cast<size_t>(position - tokenBegin), SeparatorBlank };
+    responseTokens.push_back(token);
+  }
+
+  if (! responseTokens.empty())
+    responseTokens.back().separator = SeparatorEnd;
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Returns true if the response indicates success.
+// -----------------------------------------------------------------------------
+bool GtpResponseParser::status() const
+{
+  return (responseLength > 0 && '=' == response[0]);
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Returns the tokens of the response, in the order in which they
+/// appear in the response.
+// -----------------------------------------------------------------------------
+const std::vector<GtpResponseParser::Token>& GtpResponseParser::tokens() const
+{
+  return responseTokens;
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Interprets all tokens of the response as vertices on a board of
+/// size @a boardSize and stores the corresponding board indexes in
+/// @a boardIndexes, replacing its previous content. Returns true on success.
+/// Returns false if the response does not indicate success, or if a token is
+/// not a valid vertex. "pass" and "resign" are not valid vertices in a vertex
+/// list.
+///
+/// If parsing fails, the content of @a boardIndexes is undefined.
+// -----------------------------------------------------------------------------
+bool GtpResponseParser::parseVertexList(int boardSize, std::vector<int>& boardIndexes) const
+{
+  boardIndexes.clear();
+  if (! status())
+    return false;
+
+  boardIndexes.reserve(responseTokens.size());
+  for (const Token& token : responseTokens)
+  {
+    int boardIndex = boardIndexOfVertex(token.begin, token.length, boardSize);
+    if (boardIndex < 0)
+      return false;
+    boardIndexes.push_back(boardIndex);
+  }
+  return true;
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Interprets the tokens of the response as a list of moves on a board
+/// of size @a boardSize and stores the moves in @a moves, replacing its
+/// previous content. Returns true on success. Returns false if the response
+/// does not indicate success, or if the move list is malformed.
+///
+/// Each move consists of a color token ("B", "W", "black" or "white") and a
+/// vertex token, which may also be "pass" or "resign". Moves are separated by
+/// commas or newlines. The response "B D4, W PASS" is an example of a move
+/// list with two moves.
+///
+/// If parsing fails, the content of @a moves is undefined.
+// -----------------------------------------------------------------------------
+bool GtpResponseParser::parseMoveList(int boardSize, std::vector<Move>& moves) const
+{
+  MoveListFailure failure;
+  return parseMoveList(boardSize, moves, failure);
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Same as parseMoveList(int, std::vector<Move>&), but in addition
+/// describes in @a failure why parsing failed. On success, the @e error
+/// member of @a failure is #MoveListErrorNone.
+///
+/// If both the color and the vertex of a move are invalid, @a failure reports
+/// the color.
+// -----------------------------------------------------------------------------
+bool GtpResponseParser::parseMoveList(int boardSize, std::vector<Move>& moves, MoveListFailure& failure) const
+{
+  moves.clear();
+  failure.error = MoveListErrorNone;
+  failure.colorToken.begin = response;
+  failure.colorToken.length = 0;
+  failure.colorToken.separator = SeparatorEnd;
+  failure.vertexToken = failure.colorToken;
+  if (! status())
+  {
+    failure.error = MoveListErrorStatus;
+    return false;
+  }
+
+  size_t numberOfTokens = responseTokens.size();
+  moves.reserve(numberOfTokens / 2);
+  for (size_t index = 0; index < numberOfTokens; index += 2)
+  {
+    const Token& colorToken = responseTokens[index];
+    failure.colorToken = colorToken;
+    if (index + 1 == numberOfTokens)
+    {
+      failure.error = MoveListErrorFormat;
+      failure.vertexToken.begin = colorToken.begin + colorToken.length;
+      failure.vertexToken.length = 0;
+      failure.vertexToken.separator = SeparatorEnd;
+      return false;
+    }
+    const Token& vertexToken = responseTokens[index + 1];
+    failure.vertexToken = vertexToken;
+    if (SeparatorBlank != colorToken.separator || SeparatorBlank == vertexToken.separator)
+    {
+      failure.error = MoveListErrorFormat;
+      return false;
+    }
+
+    Move move;
+    if (colorToken.equalsIgnoringCase("b") || colorToken.equalsIgnoringCase("black"))
+      move.color = MoveColorBlack;
+    else if (colorToken.equalsIgnoringCase("w") || colorToken.equalsIgnoringCase("white"))
+      move.color = MoveColorWhite;
+    else
+    {
+      failure.error = MoveListErrorInvalidColor;
+      return false;
+    }
+    move.boardIndex = boardIndexOfVertex(vertexToken.begin, vertexToken.length, boardSize);
+    if (invalidBoardIndex == move.boardIndex)
+    {
+      failure.error = MoveListErrorInvalidVertex;
+      return false;
+    }
+    moves.push_back(move);
+  }
+  return true;
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Interprets each line of the response as a key/value pair and stores
+/// the pairs in @a keyValuePairs, replacing its previous content. Returns true
+/// on success. Returns false if the response does not indicate success.
+///
+/// The first token on a line is the key. The value starts with the second
+/// token and extends to the end of the last token on the line, i.e. the value
+/// may contain blanks and commas. Empty lines are skipped.
+// -----------------------------------------------------------------------------
+bool GtpResponseParser::parseKeyValuePairs(std::vector<KeyValuePair>& keyValuePairs) const
+{
+  keyValuePairs.clear();
+  if (! status())
+    return false;
+
+  size_t numberOfTokens = responseTokens.size();
+  size_t index = 0;
+  while (index < numberOfTokens)
+  {
+    KeyValuePair keyValuePair;
+    keyValuePair.key = responseTokens[index];
+    keyValuePair.value.begin = keyValuePair.key.begin + keyValuePair.key.length;
+    keyValuePair.value.length = 0;
+    keyValuePair.value.separator = keyValuePair.key.separator;
+    bool keyIsLastTokenOnLine = (SeparatorNewline == keyValuePair.key.separator || SeparatorEnd == keyValuePair.key.separator);
+    ++index;
+    if (! keyIsLastTokenOnLine)
+    {
+      const Token& firstValueToken = responseTokens[index];
+      while (SeparatorNewline != responseTokens[index].separator && SeparatorEnd != responseTokens[index].separator)
+        ++index;
+      const Token& lastValueToken = responseTokens[index];
+      keyValuePair.value.begin = firstValueToken.begin;
+      keyValuePair.value.length = (lastValueToken.begin + lastValueToken.length) - firstValueToken.begin;
+      keyValuePair.value.separator = lastValueToken.separator;
+      ++index;
+    }
+    keyValuePair.key.separator = SeparatorBlank;
+    keyValuePairs.push_back(keyValuePair);
+  }
+  return true;
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Decodes the response into @a values, which must have room for
+/// @a gridSize * @a gridSize elements. Returns true on success. See
+/// GtpFloatGridDecoder::decode() for details.
+// -----------------------------------------------------------------------------
+bool GtpResponseParser::parseFloatGrid(int gridSize, float* values) const
+{
+  return GtpFloatGridDecoder::decode(response, responseLength, gridSize, values);
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Returns the board index of the vertex @a vertex, which is
+/// @a vertexLength characters long, on a board of size @a boardSize. Returns
+/// #passBoardIndex or #resignBoardIndex if @a vertex is "pass" or "resign".
+/// Returns #invalidBoardIndex if @a vertex is not a valid vertex on the board.
+///
+/// @a vertex is interpreted ignoring case. The letter "I" is not used for
+/// vertices, i.e. the column after "H" is "J".
+// -----------------------------------------------------------------------------
+int GtpResponseParser::boardIndexOfVertex(const char* vertex, size_t vertexLength, int boardSize)
+{
+  if (vertexLength < 2 || vertexLength > 3)
+  {
+    Token token = { vertex, vertexLength, SeparatorEnd };
+    if (token.equalsIgnoringCase("pass"))
+      return passBoardIndex;
+    else if (token.equalsIgnoringCase("resign"))
+      return resignBoardIndex;
+    return invalidBoardIndex;
+  }
+
+  char letter = static_cast<char>(std::toupper(static_cast<unsigned char>(vertex[0])));
+  if (letter < 'A' || letter > 'Z' || 'I' == letter)
+    return invalidBoardIndex;
+  int x = letter - 'A' + ((letter > 'I') ? 0 : 1);
+
+  int y = 0;
+  for (size_t index = 1; index < vertexLength; ++index)
+  {
+    char digit = vertex[index];
+    if (digit < '0' || digit > '9')
+      return invalidBoardIndex;
+    y = y * 10 + (digit - '0');
+  }
+
+  if (x > boardSize || y < 1 || y > boardSize)
+    return invalidBoardIndex;
+  return (y - 1) * boardSize + (x - 1);
+}
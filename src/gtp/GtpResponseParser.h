@@ -0,0 +1,147 @@
+// -----------------------------------------------------------------------------
+// Copyright 2026 Patrick Näf (herzbube@herzbube.ch)
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// -----------------------------------------------------------------------------
+
+
+#pragma once
+
+// System includes
+#include <cstddef>
+#include <vector>
+
+// -----------------------------------------------------------------------------
+/// @brief The GtpResponseParser class tokenizes a GTP response once and
+/// provides typed views of the tokens, e.g. as a list of board indexes or as a
+/// list of moves.
+///
+/// @ingroup gtp
+///
+/// GtpResponseParser works directly on the bytes of the response. It does not
+/// copy the response, and the tokens it hands out (see Token) point into the
+/// response. The response therefore must remain valid for as long as the
+/// GtpResponseParser object and its tokens are in use. The response does not
+/// have to be null-terminated.
+///
+/// The response is expected to start with the status character, as in
+/// "= D4 Q16". Tokens are separated by blanks, commas and newlines. The
+/// constructor records for each token which separator follows it, which lets
+/// the typed views recognize the structure of the response without
+/// scanning it again:
+/// - parseVertexList() interprets all tokens as vertices, e.g. the response to
+///   "final_status_list dead"
+/// - parseMoveList() interprets the tokens as a list of "color vertex" items
+///   that are separated by commas or newlines, e.g. "B D4, W PASS"
+/// - parseKeyValuePairs() interprets each line as a key, followed by a value
+///   that extends to the end of the line
+/// - parseFloatGrid() delegates to GtpFloatGridDecoder, which does not need
+///   the tokens
+///
+/// Vertices are mapped directly to board indexes, using the order that
+/// GoBoard::indexOfPoint:() defines: The intersection A1 has index 0, the
+/// index increases from left to right, then from bottom to top.
+// -----------------------------------------------------------------------------
+class GtpResponseParser
+{
+public:
+  /// @brief Enumerates the characters that can follow a token.
+  enum Separator
+  {
+    SeparatorBlank,    ///< @brief The token is followed by a blank.
+    SeparatorComma,    ///< @brief The token is followed by a comma.
+    SeparatorNewline,  ///< @brief The token is the last token on its line.
+    SeparatorEnd       ///< @brief The token is the last token in the response.
+  };
+
+  /// @brief A view of a token in the response.
+  struct Token
+  {
+    const char* begin;
+    size_t length;
+    Separator separator;
+
+    bool equalsIgnoringCase(const char* string) const;
+  };
+
+  /// @brief Enumerates the colors that a move can have.
+  enum MoveColor
+  {
+    MoveColorBlack,
+    MoveColorWhite
+  };
+
+  /// @brief A move in a move list. @e boardIndex is either a board index, or
+  /// one of the values #passBoardIndex and #resignBoardIndex.
+  struct Move
+  {
+    MoveColor color;
+    int boardIndex;
+  };
+
+  /// @brief Enumerates the reasons why parseMoveList() can fail.
+  enum MoveListError
+  {
+    MoveListErrorNone,           ///< @brief The move list was parsed successfully.
+    MoveListErrorStatus,         ///< @brief The response does not indicate success.
+    MoveListErrorFormat,         ///< @brief A move does not consist of a color token and a vertex token.
+    MoveListErrorInvalidColor,   ///< @brief The color token of a move is not a color.
+    MoveListErrorInvalidVertex   ///< @brief The vertex token of a move is not a vertex.
+  };
+
+  /// @brief Describes why parseMoveList() failed. @e colorToken and
+  /// @e vertexToken are the tokens of the move that could not be parsed. The
+  /// @e length of a token is 0 if the move does not have that token, or if
+  /// the failure is not related to a specific move.
+  struct MoveListFailure
+  {
+    MoveListError error;
+    Token colorToken;
+    Token vertexToken;
+  };
+
+  /// @brief A key/value pair in a response that lists one pair per line. The
+  /// @e length of @e value is 0 if the line consists only of the key.
+  struct KeyValuePair
+  {
+    Token key;
+    Token value;
+  };
+
+  /// @brief Is returned by boardIndexOfVertex() if the vertex is invalid.
+  static const int invalidBoardIndex = -1;
+  /// @brief Is returned by boardIndexOfVertex() for the vertex "pass".
+  static const int passBoardIndex = -2;
+  /// @brief Is returned by boardIndexOfVertex() for the vertex "resign".
+  static const int resignBoardIndex = -3;
+
+  GtpResponseParser(const char* response, size_t responseLength);
+
+  bool status() const;
+  const std::vector<Token>& tokens() const;
+
+  bool parseVertexList(int boardSize, std::vector<int>& boardIndexes) const;
+  bool parseMoveList(int boardSize, std::vector<Move>& moves) const;
+  bool parseMoveList(int boardSize, std::vector<Move>& moves, MoveListFailure& failure) const;
+  bool parseKeyValuePairs(std::vector<KeyValuePair>& keyValuePairs) const;
+  bool parseFloatGrid(int gridSize, float* values) const;
+
+  static int boardIndexOfVertex(const char* vertex, size_t vertexLength, int boardSize);
+
+private:
+  void tokenize();
+
+  const char* response;
+  size_t responseLength;
+  std::vector<Token> responseTokens;
+};
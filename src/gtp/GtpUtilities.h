@@ -16,6 +16,7 @@
 
 
 // Forward classes
+@class GtpCommand;
 @class Player;
 
 
@@ -36,6 +37,8 @@
 + (void) setupComputerPlayer;
 + (void) startPondering;
 + (void) stopPondering;
++ (GtpCommand*) ponderingCommand:(bool)pondering;
 + (void) restorePondering;
++ (void) applyParameterSet:(NSArray*)parameterCommands toEngineWithRole:(enum GtpEngineRole)role;
 
 @end
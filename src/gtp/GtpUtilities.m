@@ -17,7 +17,11 @@
 
 // Project includes
 #import "GtpUtilities.h"
+#import "GtpClient.h"
 #import "GtpCommand.h"
+#import "GtpEnginePool.h"
+#import "GtpEngineState.h"
+#import "GtpFuture.h"
 #import "../go/GoGame.h"
 #import "../go/GoPlayer.h"
 #import "../main/ApplicationDelegate.h"
@@ -90,9 +94,7 @@
 // -----------------------------------------------------------------------------
 + (void) startPondering
 {
-  GtpCommand* command = [GtpCommand command:@"uct_param_player ponder 1"];
-  command.waitUntilDone = false;
-  [command submit];
+  [[GtpUtilities ponderingCommand:true] submit];
 }
 
 // -----------------------------------------------------------------------------
@@ -100,9 +102,21 @@
 // -----------------------------------------------------------------------------
 + (void) stopPondering
 {
-  GtpCommand* command = [GtpCommand command:@"uct_param_player ponder 0"];
+  [[GtpUtilities ponderingCommand:false] submit];
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Returns a new GtpCommand object that tells the GTP engine to start
+/// (if @a pondering is true) or stop (if @a pondering is false) pondering. The
+/// command is set up to be executed asynchronously, but it is not yet
+/// submitted.
+// -----------------------------------------------------------------------------
++ (GtpCommand*) ponderingCommand:(bool)pondering
+{
+  NSString* commandString = [NSString stringWithFormat:@"uct_param_player ponder %d", (pondering ? 1 : 0)];
+  GtpCommand* command = [GtpCommand command:commandString];
   command.waitUntilDone = false;
-  [command submit];
+  return command;
 }
 
 // -----------------------------------------------------------------------------
@@ -121,4 +135,69 @@
 }
 
 
+// -----------------------------------------------------------------------------
+/// @brief Applies the engine parameters in @a parameterCommands to the GTP
+/// engine that serves @a role. @a parameterCommands is an array of GTP command
+/// strings, each of which sets one parameter (e.g. "uct_max_memory 1000000" or
+/// "uct_param_player max_games 500"). The caller is responsible for
+/// validating the parameter values.
+///
+/// The parameter set is applied as a single unit:
+/// - Commands that set a parameter to the value that the engine already has
+///   are dropped. The engine reconfigures its search every time that a search
+///   parameter is set, so dropping unchanged parameters avoids unnecessary
+///   reconfigurations (e.g. re-allocating the search tree for
+///   "uct_max_memory").
+/// - The remaining commands are submitted as a single pipelined batch, i.e.
+///   they share one round-trip to the engine.
+/// - The total time that the engine takes to apply the parameter set is
+///   logged when the last response arrives.
+///
+/// This method returns control to the caller before the commands have been
+/// processed.
+// -----------------------------------------------------------------------------
++ (void) applyParameterSet:(NSArray*)parameterCommands toEngineWithRole:(enum GtpEngineRole)role
+{
+  GtpClient* client = [[ApplicationDelegate sharedDelegate].gtpEnginePool clientForRole:role];
+  GtpEngineState* engineState = client.engineState;
+
+  NSMutableArray* commands = [NSMutableArray array];
+  NSMutableArray* futures = [NSMutableArray array];
+  for (NSString* commandString in parameterCommands)
+  {
+    if ([engineState isParameterSetByCommand:commandString])
+      continue;
+    GtpCommand* command = [GtpCommand command:commandString];
+    command.waitUntilDone = false;
+    command.role = role;
+    command.future = [GtpFuture futureWithCommand:command];
+    [commands addObject:command];
+    [futures addObject:command.future];
+  }
+
+  NSUInteger numberOfSkippedParameters = parameterCommands.count - commands.count;
+  if (0 == commands.count)
+  {
+    DDLogInfo(@"Parameter set for engine role %d is already applied, %lu parameters skipped", role, (unsigned long)numberOfSkippedParameters);
+    return;
+  }
+
+  NSDate* startDate = [NSDate date];
+  [[GtpFuture whenAll:futures] then:^(GtpFuture* future)
+  {
+    NSUInteger numberOfFailedParameters = 0;
+    for (GtpFuture* parameterFuture in future.futures)
+    {
+      if (! parameterFuture.response.status)
+        numberOfFailedParameters++;
+    }
+    double applyTimeInMilliseconds = -[startDate timeIntervalSinceNow] * 1000.0;
+    if (numberOfFailedParameters > 0)
+      DDLogError(@"Parameter set for engine role %d applied in %.1f ms, %lu of %lu parameters failed", role, applyTimeInMilliseconds, (unsigned long)numberOfFailedParameters, (unsigned long)commands.count);
+    else
+      DDLogInfo(@"Parameter set for engine role %d applied in %.1f ms, %lu parameters applied, %lu skipped", role, applyTimeInMilliseconds, (unsigned long)commands.count, (unsigned long)numberOfSkippedParameters);
+  }];
+  [GtpCommand submitPipelined:commands];
+}
+
 @end
@@ -0,0 +1,378 @@
+// -----------------------------------------------------------------------------
+// Copyright 2026 Patrick Näf (herzbube@herzbube.ch)
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// -----------------------------------------------------------------------------
+
+
+// Project includes
+#include "LockFreePipeStreamBuffer.h"
+
+// System includes
+#include <algorithm>
+#include <cassert>
+#include <climits>
+#include <cstring>
+#include <thread>
+#if defined(__linux__)
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+// Global constants
+// Must be a power of two. The value is the same as the buffer size used by
+// PipeStreamBuffer, for the same reasons.
+static const size_t RINGBUFFERSIZE = 16384;
+// Number of times a thread checks for the other thread's progress before it
+// starts to yield its time slice.
+static const int SPINCOUNTBEFOREYIELD = 64;
+// Number of times a thread checks for the other thread's progress before it
+// blocks. Spinning for longer is a waste of battery because at this point the
+// other thread is busy computing (e.g. the GTP engine is thinking about its
+// next move).
+static const int SPINCOUNTBEFOREBLOCK = 256;
+
+
+// -----------------------------------------------------------------------------
+/// @brief Tells the CPU that the calling thread is busy-waiting.
+// -----------------------------------------------------------------------------
+static inline void cpuRelax(int spinCount)
+{
+  if (spinCount >= SPINCOUNTBEFOREYIELD)
+  {
+    std::this_thread::yield();
+    return;
+  }
+#if defined(__x86_64__) || defined(__i386__)
+  __builtin_ia32_pause();
+#elif defined(__aarch64__) || defined(__arm__)
+  __asm__ __volatile__("yield");
+#endif
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Initializes a WaitCondition object.
+// -----------------------------------------------------------------------------
+LockFreePipeStreamBuffer::WaitCondition::WaitCondition() :
+  epoch(0),
+  numberOfWaitingThreads(0)
+{
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Announces that the calling thread is about to block. Returns a
+/// ticket that must be passed to wait().
+// -----------------------------------------------------------------------------
+unsigned int LockFreePipeStreamBuffer::WaitCondition::prepareWait()
+{
+  this->numberOfWaitingThreads.fetch_add(1, std::memory_order_seq_cst);
+  return this->epoch.load(std::memory_order_seq_cst);
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Revokes the announcement made by prepareWait().
+// -----------------------------------------------------------------------------
+void LockFreePipeStreamBuffer::WaitCondition::cancelWait()
+{
+  this->numberOfWaitingThreads.fetch_sub(1, std::memory_order_seq_cst);
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Blocks the calling thread until notify() is invoked by another
+/// thread. Returns immediately if notify() was invoked after the ticket was
+/// obtained from prepareWait().
+// -----------------------------------------------------------------------------
+void LockFreePipeStreamBuffer::WaitCondition::wait(unsigned int ticket)
+{
+#if defined(__linux__)
+  static_assert(sizeof(std::atomic<unsigned int>) == sizeof(int), "futex requires a 32-bit word");
+  while (this->epoch.load(std::memory_order_seq_cst) == ticket)
+  {
+    syscall(SYS_futex, reinterpret_cast<int*>(&this->epoch), FUTEX_WAIT_PRIVATE, ticket, nullptr, nullptr, 0);
+  }
+#else
+  std::unique_lock<std::mutex> lock(this->mutex);
+  while (this->epoch.load(std::memory_order_seq_cst) == ticket)
+    this->conditionVariable.wait(lock);
+#endif
+  this->numberOfWaitingThreads.fetch_sub(1, std::memory_order_seq_cst);
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Wakes up the thread that is blocked in wait(), if there is one.
+/// Without a blocked thread this method does not make a system call.
+// -----------------------------------------------------------------------------
+void LockFreePipeStreamBuffer::WaitCondition::notify()
+{
+  this->epoch.fetch_add(1, std::memory_order_seq_cst);
+  if (this->numberOfWaitingThreads.load(std::memory_order_seq_cst) == 0)
+    return;
+#if defined(__linux__)
+  syscall(SYS_futex, reinterpret_cast<int*>(&this->epoch), FUTEX_WAKE_PRIVATE, INT_MAX, nullptr, nullptr, 0);
+#else
+  {
+    // Acquiring the mutex guarantees that the waiting thread is either
+    // before its epoch check, or already waiting on the condition variable.
+    std::lock_guard<std::mutex> lock(this->mutex);
+  }
+  this->conditionVariable.notify_all();
+#endif
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Initializes a LockFreePipeStreamBuffer object.
+// -----------------------------------------------------------------------------
+LockFreePipeStreamBuffer::LockFreePipeStreamBuffer() :
+  ringBufferSize(RINGBUFFERSIZE),
+  ringBufferMask(RINGBUFFERSIZE - 1),
+  ringBuffer(new char[RINGBUFFERSIZE]),
+  publishedWritePosition(0),
+  publishedReadPosition(0),
+  writeEndClosed(false),
+  readEndClosed(false),
+  writeWindowStartPosition(0),
+  readWindowStartPosition(0)
+{
+  static_assert((RINGBUFFERSIZE & (RINGBUFFERSIZE - 1)) == 0, "ring buffer size must be a power of two");
+
+  // This initialization is not strictly necessary since reading from
+  // the buffer cannot occur before it's written to
+  memset(this->ringBuffer, 0, this->ringBufferSize);
+
+  // The read window is initially empty, the write window initially spans the
+  // entire buffer
+  setg(
+       this->ringBuffer,
+       this->ringBuffer,
+       this->ringBuffer);
+  setp(
+       this->ringBuffer,
+       this->ringBuffer + this->ringBufferSize);
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Deallocates memory allocated by this LockFreePipeStreamBuffer object.
+// -----------------------------------------------------------------------------
+LockFreePipeStreamBuffer::~LockFreePipeStreamBuffer()
+{
+  sync();
+  delete[] this->ringBuffer;
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Publishes everything that the writing thread has written so far,
+/// then tells the reading thread that no more data will be written. Must be
+/// invoked by the writing thread.
+///
+/// After the reading thread has consumed all published data, it receives
+/// end-of-file instead of blocking.
+// -----------------------------------------------------------------------------
+void LockFreePipeStreamBuffer::closeWriteEnd()
+{
+  publishWritePosition();
+  this->writeEndClosed.store(true, std::memory_order_seq_cst);
+  this->readableDataCondition.notify();
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Tells the writing thread that nobody will read anymore. May be
+/// invoked by any thread.
+///
+/// If the writing thread is blocked because the buffer is full, it wakes up.
+/// From now on, overflow() fails instead of blocking, i.e. data that does not
+/// fit into the current write window is discarded and the writing thread sees
+/// a short write.
+// -----------------------------------------------------------------------------
+void LockFreePipeStreamBuffer::closeReadEnd()
+{
+  this->readEndClosed.store(true, std::memory_order_seq_cst);
+  this->writableSpaceCondition.notify();
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Is invoked when a reader wants to consume data but there is none
+/// available from the current read window. This method first tells the writer
+/// that the current read window has been consumed. If the writer has already
+/// published more data this method then moves the read window over that data
+/// and returns immediately. Otherwise this method blocks the caller until the
+/// writer publishes more data, or until the writer closes the write end, in
+/// which case this method returns end-of-file.
+// -----------------------------------------------------------------------------
+std::streambuf::int_type LockFreePipeStreamBuffer::underflow()
+{
+  // Everything up to gptr has been consumed, the space can be reused by the
+  // writer
+  size_t readPosition = this->readWindowStartPosition + (gptr() - eback());
+  this->publishedReadPosition.store(readPosition, std::memory_order_seq_cst);
+  this->writableSpaceCondition.notify();
+
+  size_t numberOfReadableCharacters = waitForReadableData(readPosition);
+  if (0 == numberOfReadableCharacters)
+    return traits_type::eof();
+
+  // The read window must not wrap around the end of the buffer. If the
+  // readable data wraps around, the remainder is picked up by the next
+  // underflow.
+  size_t readWindowStartIndex = readPosition & this->ringBufferMask;
+  size_t readWindowLength = std::min(numberOfReadableCharacters,
+                                     this->ringBufferSize - readWindowStartIndex);
+  char* readWindowStart = this->ringBuffer + readWindowStartIndex;
+  setg(
+       readWindowStart,
+       readWindowStart,
+       readWindowStart + readWindowLength);
+  this->readWindowStartPosition = readPosition;
+
+  return traits_type::to_int_type(*gptr());
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Is invoked when a writer wants to provide data but the current write
+/// window is full. This method publishes the content of the current write
+/// window to the reader, then moves the write window over the next free space.
+/// If there is no free space this method blocks the caller until the reader
+/// has consumed some data, or until the read end is closed, in which case this
+/// method returns end-of-file to indicate failure.
+// -----------------------------------------------------------------------------
+std::streambuf::int_type LockFreePipeStreamBuffer::overflow(std::streambuf::int_type value)
+{
+  publishWritePosition();
+
+  size_t writePosition = this->publishedWritePosition.load(std::memory_order_relaxed);
+  size_t numberOfWritableCharacters = waitForWritableSpace(writePosition);
+  if (0 == numberOfWritableCharacters)
+    return traits_type::eof();
+
+  // The write window must not wrap around the end of the buffer
+  size_t writeWindowStartIndex = writePosition & this->ringBufferMask;
+  size_t writeWindowLength = std::min(numberOfWritableCharacters,
+                                      this->ringBufferSize - writeWindowStartIndex);
+  char* writeWindowStart = this->ringBuffer + writeWindowStartIndex;
+  setp(
+       writeWindowStart,
+       writeWindowStart + writeWindowLength);
+  this->writeWindowStartPosition = writePosition;
+
+  if (traits_type::eq_int_type(value, traits_type::eof()))
+    return traits_type::not_eof(value);
+
+  // It's safe to invoke sputc(), it won't call overflow() again because
+  // the write window now has room for at least one character
+  return sputc(traits_type::to_char_type(value));
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Is invoked when a writer wants to make data written up until now
+/// available to the reader. This method does not block the caller.
+// -----------------------------------------------------------------------------
+int LockFreePipeStreamBuffer::sync()
+{
+  publishWritePosition();
+
+  // 0 = success, -1 = failure
+  return 0;
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Makes everything up to pptr visible to the reader, and wakes up the
+/// reader if it is blocked. Does nothing if there is no new content, which
+/// prevents unnecessary thread context switches.
+// -----------------------------------------------------------------------------
+void LockFreePipeStreamBuffer::publishWritePosition()
+{
+  size_t writePosition = this->writeWindowStartPosition + (pptr() - pbase());
+  if (writePosition == this->publishedWritePosition.load(std::memory_order_relaxed))
+    return;
+
+  this->publishedWritePosition.store(writePosition, std::memory_order_seq_cst);
+  this->readableDataCondition.notify();
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Private helper for underflow(). Returns the number of characters that
+/// can be read starting at @a readPosition. Blocks until that number is
+/// greater than zero. Returns zero if the write end was closed and all data
+/// has been consumed.
+// -----------------------------------------------------------------------------
+size_t LockFreePipeStreamBuffer::waitForReadableData(size_t readPosition)
+{
+  for (int spinCount = 0; ; ++spinCount)
+  {
+    size_t writePosition = this->publishedWritePosition.load(std::memory_order_acquire);
+    if (writePosition != readPosition)
+      return writePosition - readPosition;
+    if (this->writeEndClosed.load(std::memory_order_acquire))
+    {
+      // The writer publishes its final position before it closes the write
+      // end, so one more look is sufficient
+      writePosition = this->publishedWritePosition.load(std::memory_order_acquire);
+      return writePosition - readPosition;
+    }
+
+    if (spinCount < SPINCOUNTBEFOREBLOCK)
+    {
+      cpuRelax(spinCount);
+      continue;
+    }
+
+    unsigned int ticket = this->readableDataCondition.prepareWait();
+    writePosition = this->publishedWritePosition.load(std::memory_order_seq_cst);
+    if (writePosition != readPosition || this->writeEndClosed.load(std::memory_order_seq_cst))
+    {
+      this->readableDataCondition.cancelWait();
+      writePosition = this->publishedWritePosition.load(std::memory_order_seq_cst);
+      return writePosition - readPosition;
+    }
+    this->readableDataCondition.wait(ticket);
+  }
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Private helper for overflow(). Returns the number of characters that
+/// can be written starting at @a writePosition. Blocks until that number is
+/// greater than zero. Returns zero if the read end was closed.
+// -----------------------------------------------------------------------------
+size_t LockFreePipeStreamBuffer::waitForWritableSpace(size_t writePosition)
+{
+  for (int spinCount = 0; ; ++spinCount)
+  {
+    if (this->readEndClosed.load(std::memory_order_acquire))
+      return 0;
+    size_t readPosition = this->publishedReadPosition.load(std::memory_order_acquire);
+    size_t numberOfWritableCharacters = this->ringBufferSize - (writePosition - readPosition);
+    if (numberOfWritableCharacters > 0)
+      return numberOfWritableCharacters;
+
+    if (spinCount < SPINCOUNTBEFOREBLOCK)
+    {
+      cpuRelax(spinCount);
+      continue;
+    }
+
+    unsigned int ticket = this->writableSpaceCondition.prepareWait();
+    readPosition = this->publishedReadPosition.load(std::memory_order_seq_cst);
+    numberOfWritableCharacters = this->ringBufferSize - (writePosition - readPosition);
+    if (this->readEndClosed.load(std::memory_order_seq_cst))
+    {
+      this->writableSpaceCondition.cancelWait();
+      return 0;
+    }
+    if (numberOfWritableCharacters > 0)
+    {
+      this->writableSpaceCondition.cancelWait();
+      return numberOfWritableCharacters;
+    }
+    this->writableSpaceCondition.wait(ticket);
+  }
+}
@@ -0,0 +1,147 @@
+// -----------------------------------------------------------------------------
+// Copyright 2026 Patrick Näf (herzbube@herzbube.ch)
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// -----------------------------------------------------------------------------
+
+
+#pragma once
+
+// System includes
+#include <streambuf>
+#include <atomic>
+#include <mutex>
+#include <condition_variable>
+
+// -----------------------------------------------------------------------------
+/// @brief The LockFreePipeStreamBuffer class is a custom I/O stream buffer that
+/// acts as an in-memory pipe between exactly one writing thread and exactly one
+/// reading thread. LockFreePipeStreamBuffer is a drop-in replacement for
+/// PipeStreamBuffer.
+///
+/// @ingroup gtp
+///
+/// LockFreePipeStreamBuffer has the same observable behaviour as
+/// PipeStreamBuffer: Data that the writing thread puts into the pipe becomes
+/// visible to the reading thread when the writing thread syncs (e.g. by sending
+/// std::endl to the ostream) or when the internal buffer fills up. The reading
+/// thread blocks while there is nothing to read, the writing thread blocks
+/// while the internal buffer is full. Read the PipeStreamBuffer class
+/// documentation for a usage example.
+///
+/// The difference to PipeStreamBuffer lies in how the two threads synchronize.
+/// PipeStreamBuffer acquires a mutex on every sync, overflow and underflow, and
+/// wakes up the other thread via condition variable even if that thread is not
+/// waiting. LockFreePipeStreamBuffer instead treats its internal buffer as a
+/// single-producer/single-consumer ring buffer:
+/// - The writing thread owns the write position, the reading thread owns the
+///   read position. Each thread publishes its position to the other thread
+///   with a single atomic store. Neither thread ever acquires a lock on the
+///   fast path.
+/// - A thread that has to wait first spins for a short while, because in the
+///   GTP request/response pattern the other thread often delivers within
+///   microseconds. Only if spinning is not successful does the thread block.
+///   On Linux blocking is done with a futex, on other platforms with a
+///   condition variable. The other thread pays for a wake-up system call only
+///   if a thread is actually blocked.
+/// - The write position and read position are monotonically increasing
+///   counters. Because the buffer size is a power of two, the location in the
+///   buffer is obtained by masking the counter.
+///
+/// The writing thread can invoke closeWriteEnd() to signal that it will not
+/// write anymore. The reading thread then receives end-of-file after it has
+/// consumed all data that was written before. This is useful if the writing
+/// thread relays data from a source that can go away, e.g. a child process.
+///
+/// Conversely, the reading thread (or the owner of the pipe, when it shuts
+/// down the writing thread) can invoke closeReadEnd() to signal that nobody
+/// will read anymore. A writing thread that is blocked because the internal
+/// buffer is full then wakes up, and from then on all writes fail and the
+/// data is discarded. This is useful to stop a writing thread that would
+/// otherwise wait forever for a reader that is gone.
+///
+/// @attention The "single producer" rule means that at any given time only one
+/// thread may write to the pipe. Multiple threads may take turns writing
+/// (GtpClient::interrupt() does this) as long as there is a happens-before
+/// relationship between one thread's last write and the other thread's first
+/// write. The same applies to reading.
+// -----------------------------------------------------------------------------
+class LockFreePipeStreamBuffer : public std::streambuf
+{
+public:
+  LockFreePipeStreamBuffer();
+  virtual ~LockFreePipeStreamBuffer();
+
+  void closeWriteEnd();
+  void closeReadEnd();
+
+protected:
+  virtual std::streambuf::int_type underflow();
+  virtual std::streambuf::int_type overflow(std::streambuf::int_type value);
+  virtual int sync();
+
+private:
+  // ---------------------------------------------------------------------------
+  /// @brief The WaitCondition class lets a thread block until another thread
+  /// signals that it has published a new position. Signalling is cheap when
+  /// no thread is blocked.
+  ///
+  /// The waiting thread follows this protocol to avoid lost wake-ups:
+  /// - Invoke prepareWait() to obtain a ticket
+  /// - Check again the condition it wants to wait for
+  /// - If the condition is now fulfilled, invoke cancelWait(); otherwise invoke
+  ///   wait() with the ticket
+  // ---------------------------------------------------------------------------
+  class WaitCondition
+  {
+  public:
+    WaitCondition();
+
+    unsigned int prepareWait();
+    void cancelWait();
+    void wait(unsigned int ticket);
+    void notify();
+
+  private:
+    std::atomic<unsigned int> epoch;
+    std::atomic<int> numberOfWaitingThreads;
+    std::mutex mutex;
+    std::condition_variable conditionVariable;
+  };
+
+  void publishWritePosition();
+  size_t waitForReadableData(size_t readPosition);
+  size_t waitForWritableSpace(size_t writePosition);
+
+  size_t ringBufferSize;
+  size_t ringBufferMask;
+  char* ringBuffer;
+
+  // Positions published by the writing and the reading thread. Each position
+  // is written by only one thread and read by the other thread.
+  std::atomic<size_t> publishedWritePosition;
+  std::atomic<size_t> publishedReadPosition;
+
+  // Is set by the writing thread when it will not write anymore
+  std::atomic<bool> writeEndClosed;
+  // Is set when nobody will read anymore
+  std::atomic<bool> readEndClosed;
+
+  // Position that corresponds to pbase(). Owned by the writing thread.
+  size_t writeWindowStartPosition;
+  // Position that corresponds to eback(). Owned by the reading thread.
+  size_t readWindowStartPosition;
+
+  WaitCondition readableDataCondition;
+  WaitCondition writableSpaceCondition;
+};
@@ -0,0 +1,131 @@
+// -----------------------------------------------------------------------------
+// Copyright 2026 Patrick Näf (herzbube@herzbube.ch)
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// -----------------------------------------------------------------------------
+
+
+// Project includes
+#include "SocketStreamBuffer.h"
+
+// System includes
+#include <cerrno>
+#include <poll.h>
+#include <sys/socket.h>
+
+// Global constants
+static const size_t SOCKETSTREAMBUFFERSIZE = 16384;
+#if defined(MSG_NOSIGNAL)
+static const int SENDFLAGS = MSG_NOSIGNAL;
+#else
+// Platforms without MSG_NOSIGNAL (e.g. Darwin) use the socket option
+// SO_NOSIGPIPE instead, which the creator of the socket must set
+static const int SENDFLAGS = 0;
+#endif
+
+
+// -----------------------------------------------------------------------------
+/// @brief Initializes a SocketStreamBuffer object that writes to the socket
+/// @a socketFileDescriptor. The socket is expected to be in non-blocking
+/// mode.
+// -----------------------------------------------------------------------------
+SocketStreamBuffer::SocketStreamBuffer(int socketFileDescriptor) :
+  socketFileDescriptor(socketFileDescriptor),
+  bufferSize(SOCKETSTREAMBUFFERSIZE),
+  buffer(new char[SOCKETSTREAMBUFFERSIZE])
+{
+  setp(
+       this->buffer,
+       this->buffer + this->bufferSize);
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Deallocates memory allocated by this SocketStreamBuffer object.
+// -----------------------------------------------------------------------------
+SocketStreamBuffer::~SocketStreamBuffer()
+{
+  sync();
+  delete[] this->buffer;
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Is invoked when a writer wants to provide data but the internal
+/// buffer is full. Writes the buffer content to the socket, then stores
+/// @a value in the buffer.
+// -----------------------------------------------------------------------------
+std::streambuf::int_type SocketStreamBuffer::overflow(std::streambuf::int_type value)
+{
+  if (! writeBufferContent())
+    return traits_type::eof();
+
+  if (traits_type::eq_int_type(value, traits_type::eof()))
+    return traits_type::not_eof(value);
+
+  // It's safe to invoke sputc(), it won't call overflow() again because
+  // the buffer is now empty
+  return sputc(traits_type::to_char_type(value));
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Is invoked when a writer wants to make data written up until now
+/// available to the reader. Blocks until all data has been written to the
+/// socket.
+// -----------------------------------------------------------------------------
+int SocketStreamBuffer::sync()
+{
+  // 0 = success, -1 = failure
+  return writeBufferContent() ? 0 : -1;
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Private helper for overflow() and sync(). Writes everything between
+/// pbase and pptr to the socket, then resets the buffer. Returns true on
+/// success, false on failure.
+// -----------------------------------------------------------------------------
+bool SocketStreamBuffer::writeBufferContent()
+{
+  const char* data = pbase();
+  size_t numberOfCharactersToWrite = pptr() - pbase();
+  bool success = true;
+  while (numberOfCharactersToWrite > 0)
+  {
+    ssize_t numberOfCharactersWritten = send(this->socketFileDescriptor, data, numberOfCharactersToWrite, SENDFLAGS);
+    if (numberOfCharactersWritten >= 0)
+    {
+      data += numberOfCharactersWritten;
+      numberOfCharactersToWrite -= numberOfCharactersWritten;
+    }
+    else if (EINTR == errno)
+    {
+      continue;
+    }
+    else if (EAGAIN == errno || EWOULDBLOCK == errno)
+    {
+      struct pollfd pollFileDescriptor;
+      pollFileDescriptor.fd = this->socketFileDescriptor;
+      pollFileDescriptor.events = POLLOUT;
+      pollFileDescriptor.revents = 0;
+      poll(&pollFileDescriptor, 1, -1);
+    }
+    else
+    {
+      success = false;
+      break;
+    }
+  }
+
+  setp(
+       this->buffer,
+       this->buffer + this->bufferSize);
+  return success;
+}
@@ -0,0 +1,56 @@
+// -----------------------------------------------------------------------------
+// Copyright 2026 Patrick Näf (herzbube@herzbube.ch)
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// -----------------------------------------------------------------------------
+
+
+#pragma once
+
+// System includes
+#include <streambuf>
+
+// -----------------------------------------------------------------------------
+/// @brief The SocketStreamBuffer class is a custom output stream buffer that
+/// writes to a non-blocking socket.
+///
+/// @ingroup gtp
+///
+/// SocketStreamBuffer collects data in an internal buffer and writes it to the
+/// socket when the writing thread syncs (e.g. by sending std::endl to the
+/// ostream) or when the internal buffer fills up. If the socket cannot accept
+/// data at the moment, SocketStreamBuffer waits with poll() until it can.
+///
+/// SocketStreamBuffer suppresses SIGPIPE. If the peer has closed its end of
+/// the socket, the write fails and the ostream enters the bad state.
+///
+/// SocketStreamBuffer does not take ownership of the socket, i.e. it does not
+/// close the socket when it is destroyed.
+// -----------------------------------------------------------------------------
+class SocketStreamBuffer : public std::streambuf
+{
+public:
+  explicit SocketStreamBuffer(int socketFileDescriptor);
+  virtual ~SocketStreamBuffer();
+
+protected:
+  virtual std::streambuf::int_type overflow(std::streambuf::int_type value);
+  virtual int sync();
+
+private:
+  bool writeBufferContent();
+
+  int socketFileDescriptor;
+  size_t bufferSize;
+  char* buffer;
+};
@@ -18,6 +18,7 @@
 // Forward declarations
 @class GtpClient;
 @class GtpEngine;
+@class GtpEnginePool;
 @class NewGameModel;
 @class PlayerModel;
 @class GtpEngineProfileModel;
@@ -28,6 +29,7 @@
 @class SoundHandling;
 @class GoGame;
 @class ArchiveViewModel;
+@class GtpLatencyModel;
 @class GtpLogModel;
 @class GtpCommandModel;
 @class CrashReportingModel;
@@ -42,8 +44,9 @@
 /// @brief The ApplicationDelegate class implements the role of delegate of the
 /// UIApplication main object.
 ///
-/// As an additional responsibility, it creates instances of GtpEngine and
-/// GtpClient and sets them up to communicate with each other.
+/// As an additional responsibility, it creates a GtpEnginePool, which in turn
+/// creates instances of GtpEngine and GtpClient and sets them up to
+/// communicate with each other.
 ///
 /// @note Since this project does not use any .xib files, the party responsible
 /// for creating an instance of ApplicationDelegate is the project's main()
@@ -101,9 +104,12 @@
 /// @brief The bundle that contains the application's resources. This property
 /// exists to make the application more testable.
 @property(nonatomic, assign) NSBundle* resourceBundle;
-/// @brief The GTP client instance.
+/// @brief The pool of GTP engines.
+@property(nonatomic, retain) GtpEnginePool* gtpEnginePool;
+/// @brief The GTP client instance that communicates with the GTP engine that
+/// serves #GtpEngineRolePlay.
 @property(nonatomic, retain) GtpClient* gtpClient;
-/// @brief The GTP engine instance.
+/// @brief The GTP engine instance that serves #GtpEngineRolePlay.
 @property(nonatomic, retain) GtpEngine* gtpEngine;
 /// @brief Model object that stores attributes of a new game.
 @property(nonatomic, retain) NewGameModel* theNewGameModel;
@@ -131,6 +137,9 @@
 /// @brief Model object that stores information about the GTP log, viewable on
 /// the Diagnostics view.
 @property(nonatomic, retain) GtpLogModel* gtpLogModel;
+/// @brief Model object that collects latency statistics of GTP commands,
+/// viewable on the Diagnostics view.
+@property(nonatomic, retain) GtpLatencyModel* gtpLatencyModel;
 /// @brief Model object that stores canned GTP commands that can be managed and
 /// submitted on the Diagnostics view.
 @property(nonatomic, retain) GtpCommandModel* gtpCommandModel;
@@ -33,8 +33,8 @@
 #import "WindowRootViewController.h"
 #import "../gtp/GtpClient.h"
 #import "../gtp/GtpEngine.h"
+#import "../gtp/GtpEnginePool.h"
 #import "../gtp/GtpUtilities.h"
-#import "../gtp/PipeStreamBuffer.h"
 #import "../newgame/NewGameModel.h"
 #import "../player/GtpEngineProfileModel.h"
 #import "../player/GtpEngineProfile.h"
@@ -55,6 +55,7 @@
 #endif
 #import "../diagnostics/CrashReportingModel.h"
 #import "../diagnostics/GtpCommandModel.h"
+#import "../diagnostics/GtpLatencyModel.h"
 #import "../diagnostics/GtpLogModel.h"
 #import "../diagnostics/LoggingModel.h"
 #import "../command/CommandProcessor.h"
@@ -92,8 +93,10 @@
 /// @brief Shared instance of ApplicationDelegate.
 // -----------------------------------------------------------------------------
 static ApplicationDelegate* sharedDelegate = nil;
-static std::streambuf* inputPipeStreamBuffer = nullptr;
-static std::streambuf* outputPipeStreamBuffer = nullptr;
+// The number of GTP engines that the application runs. Each engine has its
+// own search tree and memory budget, which is too much for a mobile device to
+// handle for more than one engine.
+static const int numberOfGtpEngines = 1;
 
 // -----------------------------------------------------------------------------
 /// @brief Returns the shared application delegate object.
@@ -136,6 +139,7 @@ static std::streambuf* outputPipeStreamBuffer = nullptr;
   self.documentInteractionURL = nil;
   self.gtpClient = nil;
   self.gtpEngine = nil;
+  self.gtpEnginePool = nil;
   // Observes BoardViewModel, so must be deallocated first
   self.boardViewMetrics = nil;
   self.theNewGameModel = nil;
@@ -148,6 +152,7 @@ static std::streambuf* outputPipeStreamBuffer = nullptr;
   self.game = nil;
   self.archiveViewModel = nil;
   self.gtpLogModel = nil;
+  self.gtpLatencyModel = nil;
   self.gtpCommandModel = nil;
   self.crashReportingModel = nil;
   self.loggingModel = nil;
@@ -166,17 +171,6 @@ static std::streambuf* outputPipeStreamBuffer = nullptr;
   if (self == sharedDelegate)
     sharedDelegate = nil;
 
-  if (inputPipeStreamBuffer)
-  {
-    delete inputPipeStreamBuffer;
-    inputPipeStreamBuffer = nullptr;
-  }
-  if (outputPipeStreamBuffer)
-  {
-    delete outputPipeStreamBuffer;
-    outputPipeStreamBuffer = nullptr;
-  }
-
   [super dealloc];
 }
 
@@ -578,6 +572,7 @@ static std::streambuf* outputPipeStreamBuffer = nullptr;
   self.scoringModel = [[[ScoringModel alloc] init] autorelease];
   self.archiveViewModel = [[[ArchiveViewModel alloc] init] autorelease];
   self.gtpLogModel = [[[GtpLogModel alloc] init] autorelease];
+  self.gtpLatencyModel = [[[GtpLatencyModel alloc] init] autorelease];
   self.gtpCommandModel = [[[GtpCommandModel alloc] init] autorelease];
   self.crashReportingModel = [[[CrashReportingModel alloc] init] autorelease];
   self.loggingModel = [[[LoggingModel alloc] init] autorelease];
@@ -643,31 +638,19 @@ static std::streambuf* outputPipeStreamBuffer = nullptr;
 }
 
 // -----------------------------------------------------------------------------
-/// @brief Sets up the GTP engine and client (always Fuego).
+/// @brief Sets up the GTP engines and clients (always Fuego).
 ///
 /// In a regular desktop environment, engine and client would be launched in
 /// separate processes, which would then communicate via stdin/stdout. Since
 /// there is no way to launch separate processes under iOS, engine and client
 /// run in separate threads, and they communicate via C++ Standard Library
-/// I/O streams.
+/// I/O streams. GtpEnginePool takes care of the details.
 // -----------------------------------------------------------------------------
 - (void) setupFuego
 {
-  // Create objects on the heap, not the stack, so that they remain alive after
-  // control leaves this method. It would be much nicer to make these variables
-  // members of the ApplicationDelegate class, but they are C++ and
-  // ApplicationDelegate.h is also #import'ed by pure Objective-C
-  // implementations.
-  inputPipeStreamBuffer = new PipeStreamBuffer();
-  outputPipeStreamBuffer = new PipeStreamBuffer();
-
-  NSArray* streamBuffers = [NSArray arrayWithObjects:
-                            [NSValue valueWithPointer:inputPipeStreamBuffer],
-                            [NSValue valueWithPointer:outputPipeStreamBuffer],
-                            nil];
-
-  self.gtpClient = [GtpClient clientWithStreamBuffers:streamBuffers];
-  self.gtpEngine = [GtpEngine engineWithStreamBuffers:streamBuffers];
+  self.gtpEnginePool = [GtpEnginePool poolWithNumberOfEngines:numberOfGtpEngines];
+  self.gtpClient = [self.gtpEnginePool clientForRole:GtpEngineRolePlay];
+  self.gtpEngine = [self.gtpEnginePool engineForRole:GtpEngineRolePlay];
 }
 
 // -----------------------------------------------------------------------------
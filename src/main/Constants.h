@@ -522,6 +522,50 @@ extern NSString* sgfBackupFileName;
 extern NSString* inboxFolderName;
 //@}
 
+// -----------------------------------------------------------------------------
+/// @name GTP constants
+// -----------------------------------------------------------------------------
+//@{
+/// @brief Enumerates the priorities with which GtpClient schedules GtpCommand
+/// objects. GtpClient maintains one queue ("lane") per priority. The order of
+/// the enumeration values is significant, higher priorities come first.
+enum GtpCommandPriority
+{
+  GtpCommandPriorityInteractive,  ///< @brief The command was triggered by the user who is waiting for the result. Is
+                                  ///  allowed to preempt a preemptible command of lower priority.
+  GtpCommandPriorityNormal,       ///< @brief The command is processed before commands of lower priority, but does not
+                                  ///  preempt them (e.g. synchronizing the GTP engine, changing engine settings).
+  GtpCommandPriorityBackground,   ///< @brief The command performs long-running work that the user is not actively
+                                  ///  waiting for (e.g. computer player thinking).
+  GtpCommandPriorityBulk,         ///< @brief The command performs work that is executed only when nothing else is
+                                  ///  pending.
+  GtpCommandPriorityMax           ///< @brief Pseudo enum value, used to iterate over the other enum values
+};
+
+/// @brief Enumerates the roles that an engine in the GtpEnginePool can serve.
+/// GtpCommand objects are routed to an engine according to their role.
+enum GtpEngineRole
+{
+  GtpEngineRolePlay,      ///< @brief The engine generates moves for computer players.
+  GtpEngineRoleAnalysis,  ///< @brief The engine analyzes positions (e.g. player influence).
+  GtpEngineRoleScoring,   ///< @brief The engine helps with scoring (e.g. it finds dead stones).
+  GtpEngineRoleMax        ///< @brief Pseudo enum value, used to iterate over the other enum values
+};
+
+/// @brief Enumerates the phases into which the latency of a GtpCommand is
+/// broken down. The timestamps that delimit the phases are recorded by
+/// GtpClient.
+enum GtpLatencyPhase
+{
+  GtpLatencyPhaseQueueing,   ///< @brief From submission until GtpClient takes the command from its lane.
+  GtpLatencyPhaseSending,    ///< @brief From leaving the lane until the command is written to the GTP engine.
+  GtpLatencyPhaseEngine,     ///< @brief From writing the command until the first byte of the response is available.
+  GtpLatencyPhaseReceiving,  ///< @brief From the first byte of the response until the response is complete.
+  GtpLatencyPhaseTotal,      ///< @brief From submission until the response is complete.
+  GtpLatencyPhaseMax         ///< @brief Pseudo enum value, used to iterate over the other enum values
+};
+//@}
+
 // -----------------------------------------------------------------------------
 /// @name GTP notifications
 // -----------------------------------------------------------------------------
@@ -650,6 +694,8 @@ extern NSString* goScoreCalculationStarts;
 extern NSString* goScoreCalculationEnds;
 /// @brief Is sent to indicate that querying the GTP engine for an initial set
 /// of dead stones is about to start. Is sent after #goScoreCalculationStarts.
+/// Is also sent if the dead stones can be determined without querying the GTP
+/// engine, immediately followed by #askGtpEngineForDeadStonesEnds.
 extern NSString* askGtpEngineForDeadStonesStarts;
 /// @brief Is sent to indicate that querying the GTP engine for an initial set
 /// of dead stones has ended. Is sent before #goScoreCalculationEnds.
@@ -708,9 +754,11 @@ extern NSString* longRunningActionStarts;
 /// @brief Is sent when the last of a nested series of long-running actions
 /// ends. See LongRunningActionCounter for a detailed discussion of the concept.
 extern NSString* longRunningActionEnds;
-/// @brief Is sent (B-A) times while the current board position in
-/// GoBoardPosition changes from A to B. Observers can use this notification to
-/// power a progress meter.
+/// @brief Is sent at regular time intervals while the current board position
+/// in GoBoardPosition changes. Observers can use this notification to power a
+/// progress meter. An NSNumber object is associated with the notification
+/// whose float value is the fraction (0.0 - 1.0) of the change that has been
+/// completed so far.
 extern NSString* boardPositionChangeProgress;
 /// @brief Is sent to indicate that players and profiles are about to be reset
 /// to their factory defaults. Is sent before #goGameWillCreate.
@@ -920,6 +968,23 @@ enum ArchiveGameNameValidationResult
 //@{
 extern const int gtpLogSizeMinimum;
 extern const int gtpLogSizeMaximum;
+/// @brief The maximum GTP log size if the GTP log uses a spill file.
+extern const int gtpLogSizeMaximumWithSpillFile;
+/// @brief The number of bytes that the GTP log reserves in memory for command
+/// and response strings.
+extern const int gtpLogStringArenaSize;
+/// @brief GTP responses that are at least this number of bytes long are
+/// compressed before they are stored in the GTP log.
+extern const int gtpLogResponseCompressionThreshold;
+/// @brief Name of the file in the temporary folder that the GTP log uses as
+/// its spill file.
+extern NSString* gtpLogSpillFileName;
+/// @brief The maximum number of bytes that the GTP log spill file may occupy.
+/// The oldest log items are discarded to keep the spill file below this size.
+extern const int gtpLogSpillFileSizeMaximum;
+/// @brief Is appended to GTP commands and responses that the GTP log had to
+/// truncate because they were too long.
+extern NSString* gtpLogTruncationMarker;
 //@}
 
 // -----------------------------------------------------------------------------
@@ -957,6 +1022,8 @@ extern NSString* bugReportBoardAsSeenByGtpEngineFileName;
 /// @brief Name of the .zip archive file that is used to collect the application
 /// log files.
 extern NSString* bugReportLogsArchiveFileName;
+/// @brief Name of the JSON file that contains GTP latency statistics.
+extern NSString* bugReportGtpLatencyStatisticsFileName;
 /// @brief Email address of the bug report email recipient.
 extern NSString* bugReportEmailRecipient;
 /// @brief Subject for the bug report email.
@@ -1132,6 +1199,7 @@ extern NSString* sortAscendingKey;
 extern NSString* gtpLogViewKey;
 extern NSString* gtpLogSizeKey;
 extern NSString* gtpLogViewFrontSideIsVisibleKey;
+extern NSString* gtpLogSpillFileEnabledKey;
 // GTP canned commands settings
 extern NSString* gtpCannedCommandsKey;
 // Scoring settings
@@ -1221,6 +1289,7 @@ extern NSString* goBoardPositionNumberOfBoardPositionsKey;
 extern NSString* goBoardSizeKey;
 extern NSString* goBoardVertexDictKey;
 extern NSString* goBoardStarPointsKey;
+extern NSString* goBoardTerritoryStatisticsScoresKey;
 // GoBoardRegion keys
 extern NSString* goBoardRegionPointsKey;
 extern NSString* goBoardRegionScoringModeKey;
@@ -1237,7 +1306,6 @@ extern NSString* goPointVertexKey;
 extern NSString* goPointBoardKey;
 extern NSString* goPointIsStarPointKey;
 extern NSString* goPointStoneStateKey;
-extern NSString* goPointTerritoryStatisticsScoreKey;
 extern NSString* goPointRegionKey;
 // GoScore keys
 extern NSString* goScoreMarkModeKey;
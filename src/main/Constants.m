@@ -146,6 +146,12 @@ NSString* illegalArchiveGameNameCharacters = @"/\\|";
 // Diagnostics view settings default values
 const int gtpLogSizeMinimum = 5;
 const int gtpLogSizeMaximum = 1000;
+const int gtpLogSizeMaximumWithSpillFile = 20000;
+const int gtpLogStringArenaSize = 1024 * 1024;
+const int gtpLogResponseCompressionThreshold = 512;
+NSString* gtpLogSpillFileName = @"gtplog.spill";
+const int gtpLogSpillFileSizeMaximum = 64 * 1024 * 1024;
+NSString* gtpLogTruncationMarker = @" [truncated]";
 
 // Bug reports constants
 const int bugReportFormatVersion = 8;
@@ -158,6 +164,7 @@ NSString* bugReportCurrentGameFileName = @ "currentgame.sgf";
 NSString* bugReportScreenshotFileName = @ "screenshot.png";
 NSString* bugReportBoardAsSeenByGtpEngineFileName = @ "showboard.txt";
 NSString* bugReportLogsArchiveFileName = @ "logs.zip";
+NSString* bugReportGtpLatencyStatisticsFileName = @ "gtp-latency.json";
 NSString* bugReportEmailRecipient = @"herzbube@herzbube.ch";
 NSString* bugReportEmailSubject = @"Little Go Bug Report";
 
@@ -290,6 +297,7 @@ NSString* sortAscendingKey = @"SortAscending";
 NSString* gtpLogViewKey = @"GtpLogView";
 NSString* gtpLogSizeKey = @"GtpLogSize";
 NSString* gtpLogViewFrontSideIsVisibleKey = @"GtpLogViewFrontSideIsVisible";
+NSString* gtpLogSpillFileEnabledKey = @"GtpLogSpillFileEnabled";
 // GTP canned commands settings
 NSString* gtpCannedCommandsKey = @"GtpCannedCommands";
 // Scoring settings
@@ -375,6 +383,7 @@ NSString* goBoardPositionNumberOfBoardPositionsKey = @"NumberOfBoardPositions";
 NSString* goBoardSizeKey = @"Size";
 NSString* goBoardVertexDictKey = @"VertexDict";
 NSString* goBoardStarPointsKey = @"StarPoints";
+NSString* goBoardTerritoryStatisticsScoresKey = @"TerritoryStatisticsScores";
 // GoBoardRegion keys
 NSString* goBoardRegionPointsKey = @"Points";
 NSString* goBoardRegionScoringModeKey = @"ScoringMode";
@@ -391,7 +400,6 @@ NSString* goPointVertexKey = @"Vertex";
 NSString* goPointBoardKey = @"Board";
 NSString* goPointIsStarPointKey = @"IsStarPoint";
 NSString* goPointStoneStateKey = @"StoneState";
-NSString* goPointTerritoryStatisticsScoreKey = @"TerritoryStatisticsScore";
 NSString* goPointRegionKey = @"Region";
 // GoScore keys
 NSString* goScoreKomiKey = @"Komi";
@@ -26,6 +26,8 @@
 #import "layer/TerritoryLayerDelegate.h"
 #import "../model/BoardViewMetrics.h"
 #import "../model/BoardViewModel.h"
+#import "../../go/GoBoardPosition.h"
+#import "../../go/GoBoardPositionChange.h"
 #import "../../go/GoGame.h"
 #import "../../main/ApplicationDelegate.h"
 #import "../../shared/LongRunningActionCounter.h"
@@ -48,6 +50,11 @@
 /// changes.
 @property(nonatomic, assign) bool notificationRespondersAreSetup;
 @property(nonatomic, assign) bool currentBoardPositionChangedWasDelayed;
+/// @brief The GoPoint objects whose stone state changed during the board
+/// position changes that were coalesced while
+/// @e currentBoardPositionChangedWasDelayed is true. Is nil if it is not known
+/// which GoPoint objects changed.
+@property(nonatomic, retain) NSMutableSet* changedPointsOfDelayedBoardPositionChange;
 @property(nonatomic, assign) bool drawLayersWasDelayed;
 @property(nonatomic, retain) NSArray* layerDelegates;
 @property(nonatomic, assign) GridLayerDelegate* gridLayerDelegate;
@@ -87,6 +94,7 @@
   self.column = -1;
   self.notificationRespondersAreSetup = false;
   self.currentBoardPositionChangedWasDelayed = false;
+  self.changedPointsOfDelayedBoardPositionChange = nil;
   self.drawLayersWasDelayed = false;
   return self;
 }
@@ -99,6 +107,7 @@
   [self removeNotificationResponders];
   for (id<BoardViewLayerDelegate> layerDelegate in self.layerDelegates)
     [layerDelegate.layer removeFromSuperlayer];
+  self.changedPointsOfDelayedBoardPositionChange = nil;
   self.layerDelegates = nil;
   self.gridLayerDelegate = nil;
   self.crossHairLinesLayerDelegate = nil;
@@ -415,13 +424,33 @@
   if (self.currentBoardPositionChangedWasDelayed)
   {
     self.currentBoardPositionChangedWasDelayed = false;
-    [self notifyLayerDelegates:BVLDEventBoardPositionChanged eventInfo:nil];
+    NSSet* changedPoints = [[self.changedPointsOfDelayedBoardPositionChange retain] autorelease];
+    self.changedPointsOfDelayedBoardPositionChange = nil;
+    [self notifyLayerDelegates:BVLDEventBoardPositionChanged eventInfo:changedPoints];
   }
 
   for (id<BoardViewLayerDelegate> layerDelegate in self.layerDelegates)
     [layerDelegate drawLayer];
 }
 
+// -----------------------------------------------------------------------------
+/// @brief Adds the GoPoint objects whose stone state changed in @a change to
+/// the GoPoint objects of the delayed board position change. If @a change is
+/// nil, it is no longer known which GoPoint objects changed.
+///
+/// This is a private helper for
+/// observeValueForKeyPath:ofObject:change:context:().
+// -----------------------------------------------------------------------------
+- (void) accumulateChangedPointsOfBoardPositionChange:(GoBoardPositionChange*)change
+{
+  if (! change)
+    self.changedPointsOfDelayedBoardPositionChange = nil;
+  else if (! self.currentBoardPositionChangedWasDelayed)
+    self.changedPointsOfDelayedBoardPositionChange = [NSMutableSet setWithArray:change.changedPoints];
+  else
+    [self.changedPointsOfDelayedBoardPositionChange addObjectsFromArray:change.changedPoints];
+}
+
 // -----------------------------------------------------------------------------
 /// @brief Notifies all layer delegates that @a event has occurred. The event
 /// info object supplied to the delegates is @a eventInfo.
@@ -457,6 +486,8 @@
   GoBoardPosition* oldBoardPosition = oldGame.boardPosition;
   [oldBoardPosition removeObserver:self forKeyPath:@"currentBoardPosition"];
   [oldBoardPosition removeObserver:self forKeyPath:@"numberOfBoardPositions"];
+  // The points of the old game are about to go away
+  self.changedPointsOfDelayedBoardPositionChange = nil;
 }
 
 // -----------------------------------------------------------------------------
@@ -636,7 +667,9 @@
       // The board position changes many times when a game is loaded from the
       // archive. We don't want to notify our delegates each time because this
       // triggers expensive calculations, instead we coalesce multiple board
-      // position changes into a single notification
+      // position changes into a single notification. The points that changed
+      // are accumulated so that delegates can still update incrementally.
+      [self accumulateChangedPointsOfBoardPositionChange:[GoGame sharedGame].boardPosition.lastChange];
       self.currentBoardPositionChangedWasDelayed = true;
       [self delayedDrawLayers];
     }
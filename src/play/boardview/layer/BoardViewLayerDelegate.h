@@ -37,7 +37,9 @@ enum BoardViewLayerDelegateEvent
   /// canvas.
   BVLDEventInvalidateContent,
   /// @brief Is sent whenever the board position changes. In some scenarios,
-  /// multiple board position changes are coalesced into a single event.
+  /// multiple board position changes are coalesced into a single event. The
+  /// event info object is an NSSet with the GoPoint objects whose stone state
+  /// changed, or nil if it is not known which GoPoint objects changed.
   BVLDEventBoardPositionChanged,
   BVLDEventNumberOfBoardPositionsChanged,
   BVLDEventMarkLastMoveChanged,
@@ -256,7 +256,9 @@
   // list of points. On a 19x19 board this could save us quite a bit of time:
   // 381 points are iterated on 16 tiles (iPhone), i.e. over 6000 iterations.
   // on iPad where there are more tiles it is even worse.
-  NSEnumerator* enumerator = [game.board pointEnumerator];
+  GoBoard* board = game.board;
+  const float* territoryStatisticsScores = board.territoryStatisticsScores;
+  NSEnumerator* enumerator = [board pointEnumerator];
   GoPoint* point;
   while (point = [enumerator nextObject])
   {
@@ -264,7 +266,7 @@
                                                                  metrics:self.boardViewMetrics];
     if (! CGRectIntersectsRect(tileRect, stoneRect))
       continue;
-    float influenceScore = point.territoryStatisticsScore;
+    float influenceScore = territoryStatisticsScores[[board indexOfPoint:point]];
     enum GoColor influenceColor = [self influenceColor:influenceScore];
     if (GoColorNone == influenceColor)
       continue;
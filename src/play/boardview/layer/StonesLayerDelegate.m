@@ -177,6 +177,14 @@
       [self invalidateDirtyRectForCrossHairPoint];
       [self invalidateDirtySetupPoint];
       [self invalidateDirtyRectForSetupPoint];
+      if (event == BVLDEventBoardPositionChanged && eventInfo)
+      {
+        // We know which points changed, so we don't have to examine all points
+        // of the board
+        if ([self updateDrawingPointsWithChangedPoints:eventInfo])
+          self.dirty = true;
+        break;
+      }
       NSMutableDictionary* oldDrawingPoints = self.drawingPoints;
       NSMutableDictionary* newDrawingPoints = [self calculateDrawingPoints];
       // The dictionary must contain the intersection state so that the
@@ -462,4 +470,30 @@
   return drawingPoints;
 }
 
+// -----------------------------------------------------------------------------
+/// @brief Updates the intersection states in @e drawingPoints for those
+/// GoPoint objects in @a changedPoints whose intersections are located on this
+/// tile. Returns true if at least one intersection state was changed.
+///
+/// This is a private helper for notify:eventInfo:().
+// -----------------------------------------------------------------------------
+- (bool) updateDrawingPointsWithChangedPoints:(NSSet*)changedPoints
+{
+  bool drawingPointsChanged = false;
+  for (GoPoint* point in changedPoints)
+  {
+    NSString* vertexString = point.vertex.string;
+    NSNumber* oldStoneStateAsNumber = [self.drawingPoints objectForKey:vertexString];
+    // Points that are not in the dictionary are not located on this tile
+    if (! oldStoneStateAsNumber)
+      continue;
+    if ([oldStoneStateAsNumber intValue] == point.stoneState)
+      continue;
+    NSNumber* newStoneStateAsNumber = [[[NSNumber alloc] initWithInt:point.stoneState] autorelease];
+    [self.drawingPoints setObject:newStoneStateAsNumber forKey:vertexString];
+    drawingPointsChanged = true;
+  }
+  return drawingPointsChanged;
+}
+
 @end
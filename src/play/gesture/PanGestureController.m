@@ -23,6 +23,8 @@
 #import "../model/BoardViewModel.h"
 #import "../../go/GoBoardPosition.h"
 #import "../../go/GoGame.h"
+#import "../../go/GoLegalMoveMap.h"
+#import "../../go/GoPoint.h"
 #import "../../main/ApplicationDelegate.h"
 #import "../../main/MainUtility.h"
 #import "../../main/MagnifyingGlassOwner.h"
@@ -213,7 +215,14 @@
     // method
     bool isCrossHairInVisibleRect = CGRectContainsPoint(visibleRect, crossHairIntersection.coordinates);
     if (isCrossHairInVisibleRect)
-      isLegalMove = [[GoGame sharedGame] isLegalMove:crossHairIntersection.point isIllegalReason:&illegalReason];
+    {
+      // The gesture recognizer fires many times for the same board position.
+      // GoGame generates the legal move map only once per board position, so
+      // every further check is a lookup.
+      GoGame* game = [GoGame sharedGame];
+      GoLegalMoveMap* legalMoveMap = [game legalMoveMapForColor:game.nextMoveColor];
+      isLegalMove = [legalMoveMap isLegalMoveAtIndex:crossHairIntersection.point.index isIllegalReason:&illegalReason];
+    }
     else
       crossHairIntersection = BoardViewIntersectionNull;
   }
@@ -89,6 +89,7 @@
 - (id) initWithDictionary:(NSDictionary*)dictionary;
 - (NSDictionary*) asDictionary;
 - (void) applyProfile;
+- (void) applyProfileToEngineWithRole:(enum GtpEngineRole)role;
 - (bool) isFallbackProfile;
 - (void) resetPlayingStrengthPropertiesToDefaultValues;
 - (void) resetResignBehaviourPropertiesToDefaultValues;
@@ -173,49 +173,7 @@
 // -----------------------------------------------------------------------------
 - (void) applyProfile
 {
-  DDLogInfo(@"Applying GTP profile settings: %@", [self description]);
-
-  NSString* commandString;
-  GtpCommand* command;
-
-  long long fuegoMaxMemoryInBytes = self.fuegoMaxMemory * 1000000;
-  commandString = [NSString stringWithFormat:@"uct_max_memory %lld", fuegoMaxMemoryInBytes];
-  command = [GtpCommand command:commandString];
-  command.waitUntilDone = false;
-  [command submit];
-  commandString = [NSString stringWithFormat:@"uct_param_search number_threads %d", self.fuegoThreadCount];
-  command = [GtpCommand command:commandString];
-  command.waitUntilDone = false;
-  [command submit];
-  commandString = [NSString stringWithFormat:@"uct_param_player reuse_subtree %d", (self.fuegoReuseSubtree ? 1 : 0)];
-  command = [GtpCommand command:commandString];
-  command.waitUntilDone = false;
-  [command submit];
-  if (self.fuegoPondering)
-    [GtpUtilities startPondering];
-  else
-    [GtpUtilities stopPondering];
-  commandString = [NSString stringWithFormat:@"uct_param_player max_ponder_time %u", self.fuegoMaxPonderTime];
-  command = [GtpCommand command:commandString];
-  command.waitUntilDone = false;
-  [command submit];
-  commandString = [NSString stringWithFormat:@"go_param timelimit %u", self.fuegoMaxThinkingTime];
-  command = [GtpCommand command:commandString];
-  command.waitUntilDone = false;
-  [command submit];
-  commandString = [NSString stringWithFormat:@"uct_param_player max_games %llu", self.fuegoMaxGames];
-  command = [GtpCommand command:commandString];
-  command.waitUntilDone = false;
-  [command submit];
-  commandString = [NSString stringWithFormat:@"uct_param_player resign_min_games %llu", self.fuegoResignMinGames];
-  command = [GtpCommand command:commandString];
-  command.waitUntilDone = false;
-  [command submit];
-  int resignThreshold = [self resignThresholdForBoardSize:[GoGame sharedGame].board.size];
-  commandString = [NSString stringWithFormat:@"uct_param_player resign_threshold %f", resignThreshold / 100.0];
-  command = [GtpCommand command:commandString];
-  command.waitUntilDone = false;
-  [command submit];
+  [self applyProfileToEngineWithRole:GtpEngineRolePlay];
 
   self.hasUnappliedChanges = false;
   if (! self.isActiveProfile)
@@ -234,6 +192,71 @@
   }
 }
 
+// -----------------------------------------------------------------------------
+/// @brief Applies the settings in this profile to the GTP engine in the
+/// application's GtpEnginePool that serves @a role. Does not activate this
+/// profile and does not change the hasUnappliedChanges property.
+///
+/// This method is useful to give engines that serve other roles than
+/// #GtpEngineRolePlay their own settings. Like applyProfile(), this method
+/// returns control to the caller before all GTP commands have been processed.
+// -----------------------------------------------------------------------------
+- (void) applyProfileToEngineWithRole:(enum GtpEngineRole)role
+{
+  DDLogInfo(@"Applying GTP profile settings for engine role %d: %@", role, [self description]);
+
+  [self validateParameterSet];
+
+  // The pondering command is the last one so that the engine starts
+  // pondering only after the search has been configured
+  NSMutableArray* parameterCommands = [NSMutableArray array];
+  long long fuegoMaxMemoryInBytes = self.fuegoMaxMemory * 1000000;
+  [parameterCommands addObject:[NSString stringWithFormat:@"uct_max_memory %lld", fuegoMaxMemoryInBytes]];
+  [parameterCommands addObject:[NSString stringWithFormat:@"uct_param_search number_threads %d", self.fuegoThreadCount]];
+  [parameterCommands addObject:[NSString stringWithFormat:@"uct_param_player reuse_subtree %d", (self.fuegoReuseSubtree ? 1 : 0)]];
+  [parameterCommands addObject:[NSString stringWithFormat:@"uct_param_player max_ponder_time %u", self.fuegoMaxPonderTime]];
+  [parameterCommands addObject:[NSString stringWithFormat:@"go_param timelimit %u", self.fuegoMaxThinkingTime]];
+  [parameterCommands addObject:[NSString stringWithFormat:@"uct_param_player max_games %llu", self.fuegoMaxGames]];
+  [parameterCommands addObject:[NSString stringWithFormat:@"uct_param_player resign_min_games %llu", self.fuegoResignMinGames]];
+  int resignThreshold = [self resignThresholdForBoardSize:[GoGame sharedGame].board.size];
+  [parameterCommands addObject:[NSString stringWithFormat:@"uct_param_player resign_threshold %f", resignThreshold / 100.0]];
+  [parameterCommands addObject:[GtpUtilities ponderingCommand:self.fuegoPondering].command];
+
+  [GtpUtilities applyParameterSet:parameterCommands toEngineWithRole:role];
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Private helper for applyProfileToEngineWithRole:().
+///
+/// Validates all parameters of this profile in one go before any of them is
+/// sent to the GTP engine, so that the engine is never left with a partially
+/// applied profile. Raises an @e NSInvalidArgumentException that lists all
+/// invalid parameters if one or more parameters have an invalid value.
+// -----------------------------------------------------------------------------
+- (void) validateParameterSet
+{
+  NSMutableArray* errorMessages = [NSMutableArray array];
+  if (self.fuegoMaxMemory < fuegoMaxMemoryMinimum)
+    [errorMessages addObject:[NSString stringWithFormat:@"max memory %d", self.fuegoMaxMemory]];
+  if (self.fuegoThreadCount < fuegoThreadCountMinimum || self.fuegoThreadCount > fuegoThreadCountMaximum)
+    [errorMessages addObject:[NSString stringWithFormat:@"thread count %d", self.fuegoThreadCount]];
+  if (self.fuegoMaxPonderTime < fuegoMaxPonderTimeMinimum || self.fuegoMaxPonderTime > fuegoMaxPonderTimeMaximum)
+    [errorMessages addObject:[NSString stringWithFormat:@"max ponder time %u", self.fuegoMaxPonderTime]];
+  if (self.fuegoMaxThinkingTime < fuegoMaxThinkingTimeMinimum || self.fuegoMaxThinkingTime > fuegoMaxThinkingTimeMaximum)
+    [errorMessages addObject:[NSString stringWithFormat:@"max thinking time %u", self.fuegoMaxThinkingTime]];
+  if (self.fuegoMaxGames < fuegoMaxGamesMinimum || self.fuegoMaxGames > fuegoMaxGamesMaximum)
+    [errorMessages addObject:[NSString stringWithFormat:@"max games %llu", self.fuegoMaxGames]];
+  if (0 == errorMessages.count)
+    return;
+
+  NSString* errorMessage = [NSString stringWithFormat:@"Invalid GTP engine profile parameters: %@", [errorMessages componentsJoinedByString:@", "]];
+  DDLogError(@"%@: %@", self, errorMessage);
+  NSException* exception = [NSException exceptionWithName:NSInvalidArgumentException
+                                                   reason:errorMessage
+                                                 userInfo:nil];
+  @throw exception;
+}
+
 // -----------------------------------------------------------------------------
 /// @brief Returns true if this GtpEngineProfile object is the fallback profile.
 // -----------------------------------------------------------------------------
@@ -0,0 +1,468 @@
+// -----------------------------------------------------------------------------
+// Copyright 2026 Patrick Näf (herzbube@herzbube.ch)
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// -----------------------------------------------------------------------------
+
+
+// Test includes
+#import "GoBoardCoreTest.h"
+
+// Application includes
+#import <go/GoBoard.h>
+#import <go/GoBoardCore.h>
+#import <go/GoPoint.h>
+
+// C++ standard library
+#include <random>
+#include <stdexcept>
+
+
+/// @brief The number of stones that the benchmarks place and remove.
+static const int numberOfStonesInBenchmark = 20000;
+
+
+// -----------------------------------------------------------------------------
+/// @brief Returns the board index of the intersection at the 1-based
+/// coordinates @a x and @a y on a board of size @a boardSize.
+// -----------------------------------------------------------------------------
+static int boardIndex(int x, int y, int boardSize)
+{
+  return (y - 1) * boardSize + (x - 1);
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Returns the number of liberties of the stone group that the stone on
+/// @a point belongs to. Walks GoPoint objects in the same way as the
+/// implementation of GoBoardRegion::liberties() did before GoBoardCore
+/// existed.
+// -----------------------------------------------------------------------------
+static int libertiesByWalkingGoPoints(GoPoint* point)
+{
+  if (! [point hasStone])
+    return [point liberties];
+  enum GoColor color = point.stoneState;
+  NSMutableArray* group = [NSMutableArray arrayWithObject:point];
+  NSMutableArray* libertyPoints = [NSMutableArray arrayWithCapacity:0];
+  for (NSUInteger index = 0; index < group.count; ++index)
+  {
+    for (GoPoint* neighbour in [[group objectAtIndex:index] neighbours])
+    {
+      if (neighbour.stoneState == color)
+      {
+        if (! [group containsObject:neighbour])
+          [group addObject:neighbour];
+      }
+      else if (! [neighbour hasStone])
+      {
+        if (! [libertyPoints containsObject:neighbour])
+          [libertyPoints addObject:neighbour];
+      }
+    }
+  }
+  return (int)libertyPoints.count;
+}
+
+
+@implementation GoBoardCoreTest
+
+// -----------------------------------------------------------------------------
+/// @brief Checks the initial state of a GoBoardCore object for all supported
+/// board sizes.
+// -----------------------------------------------------------------------------
+- (void) testInitialState
+{
+  for (int boardSize = GoBoardCore::minimumBoardSize; boardSize <= GoBoardCore::maximumBoardSize; boardSize += 2)
+  {
+    GoBoardCore core(boardSize);
+    XCTAssertEqual(core.boardSize(), boardSize);
+    XCTAssertEqual(core.numberOfIntersections(), boardSize * boardSize);
+    XCTAssertEqual(core.stride(), boardSize + 2);
+    XCTAssertEqual(core.onBoardPositions().count(), boardSize * boardSize);
+    XCTAssertEqual(core.emptyPositions().count(), boardSize * boardSize);
+    XCTAssertFalse(core.stones(GoBoardCore::ColorBlack).any());
+    XCTAssertFalse(core.stones(GoBoardCore::ColorWhite).any());
+    for (int index = 0; index < core.numberOfIntersections(); ++index)
+    {
+      XCTAssertEqual(core.colorAt(index), GoBoardCore::ColorNone);
+      XCTAssertEqual(core.boardIndexOfPosition(core.positionOfBoardIndex(index)), index);
+    }
+    // The empty board is one big area of empty intersections
+    XCTAssertEqual(core.groupAt(0).count(), boardSize * boardSize);
+  }
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Exercises the GoBoardCore constructor with board sizes that are not
+/// supported.
+// -----------------------------------------------------------------------------
+- (void) testInvalidBoardSize
+{
+  int invalidBoardSizes[] = { GoBoardCore::minimumBoardSize - 1, GoBoardCore::maximumBoardSize + 1 };
+  for (int boardSize : invalidBoardSizes)
+  {
+    bool exceptionWasThrown = false;
+    try
+    {
+      GoBoardCore core(boardSize);
+    }
+    catch (const std::invalid_argument&)
+    {
+      exceptionWasThrown = true;
+    }
+    XCTAssertTrue(exceptionWasThrown, @"board size %d", boardSize);
+  }
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Exercises the neighbour table and numberOfEmptyNeighbours().
+// -----------------------------------------------------------------------------
+- (void) testNeighbours
+{
+  int boardSize = 9;
+  GoBoardCore core(boardSize);
+
+  int corner = boardIndex(1, 1, boardSize);
+  int edge = boardIndex(5, 9, boardSize);
+  int center = boardIndex(5, 5, boardSize);
+  XCTAssertEqual(core.numberOfNeighbours(corner), 2);
+  XCTAssertEqual(core.numberOfNeighbours(edge), 3);
+  XCTAssertEqual(core.numberOfNeighbours(center), 4);
+
+  // Left, right, above, below
+  const int16_t* neighbours = core.neighbours(center);
+  XCTAssertEqual(neighbours[0], boardIndex(4, 5, boardSize));
+  XCTAssertEqual(neighbours[1], boardIndex(6, 5, boardSize));
+  XCTAssertEqual(neighbours[2], boardIndex(5, 6, boardSize));
+  XCTAssertEqual(neighbours[3], boardIndex(5, 4, boardSize));
+
+  // Neighbours never wrap around to the other side of the board
+  int rightEdge = boardIndex(9, 5, boardSize);
+  neighbours = core.neighbours(rightEdge);
+  for (int index = 0; index < core.numberOfNeighbours(rightEdge); ++index)
+    XCTAssertNotEqual(neighbours[index], boardIndex(1, 6, boardSize));
+
+  XCTAssertEqual(core.numberOfEmptyNeighbours(corner), 2);
+  core.setColorAt(boardIndex(2, 1, boardSize), GoBoardCore::ColorBlack);
+  XCTAssertEqual(core.numberOfEmptyNeighbours(corner), 1);
+  core.setColorAt(boardIndex(1, 2, boardSize), GoBoardCore::ColorWhite);
+  XCTAssertEqual(core.numberOfEmptyNeighbours(corner), 0);
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Exercises colorAt(), setColorAt() and clear().
+// -----------------------------------------------------------------------------
+- (void) testColorAt
+{
+  GoBoardCore core(19);
+  int index = boardIndex(6, 15, 19);
+  int position = core.positionOfBoardIndex(index);
+
+  core.setColorAt(index, GoBoardCore::ColorBlack);
+  XCTAssertEqual(core.colorAt(index), GoBoardCore::ColorBlack);
+  XCTAssertTrue(core.stones(GoBoardCore::ColorBlack).test(position));
+  XCTAssertFalse(core.stones(GoBoardCore::ColorWhite).test(position));
+  XCTAssertFalse(core.emptyPositions().test(position));
+
+  core.setColorAt(index, GoBoardCore::ColorWhite);
+  XCTAssertEqual(core.colorAt(index), GoBoardCore::ColorWhite);
+  XCTAssertFalse(core.stones(GoBoardCore::ColorBlack).test(position));
+  XCTAssertTrue(core.stones(GoBoardCore::ColorWhite).test(position));
+
+  core.setColorAt(index, GoBoardCore::ColorNone);
+  XCTAssertEqual(core.colorAt(index), GoBoardCore::ColorNone);
+  XCTAssertTrue(core.emptyPositions().test(position));
+
+  core.setColorAt(index, GoBoardCore::ColorBlack);
+  core.clear();
+  XCTAssertEqual(core.colorAt(index), GoBoardCore::ColorNone);
+  XCTAssertEqual(core.emptyPositions().count(), 19 * 19);
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Exercises groupAt().
+// -----------------------------------------------------------------------------
+- (void) testGroupAt
+{
+  int boardSize = 9;
+  GoBoardCore core(boardSize);
+
+  // A black group that snakes across the right edge, and a white stone that
+  // touches it diagonally
+  core.setColorAt(boardIndex(9, 1, boardSize), GoBoardCore::ColorBlack);
+  core.setColorAt(boardIndex(9, 2, boardSize), GoBoardCore::ColorBlack);
+  core.setColorAt(boardIndex(8, 2, boardSize), GoBoardCore::ColorBlack);
+  core.setColorAt(boardIndex(8, 3, boardSize), GoBoardCore::ColorBlack);
+  core.setColorAt(boardIndex(9, 3, boardSize), GoBoardCore::ColorWhite);
+  // A black stone at the left edge one row above; the padded layout must not
+  // let the group wrap around
+  core.setColorAt(boardIndex(1, 3, boardSize), GoBoardCore::ColorBlack);
+
+  GoBoardCore::Bitboard group = core.groupAt(boardIndex(9, 1, boardSize));
+  XCTAssertEqual(group.count(), 4);
+  XCTAssertTrue(group.test(core.positionOfBoardIndex(boardIndex(8, 3, boardSize))));
+  XCTAssertFalse(group.test(core.positionOfBoardIndex(boardIndex(1, 3, boardSize))));
+  XCTAssertEqual(core.groupAt(boardIndex(1, 3, boardSize)).count(), 1);
+  XCTAssertEqual(core.groupAt(boardIndex(9, 3, boardSize)).count(), 1);
+
+  // Empty areas are groups, too
+  XCTAssertEqual(core.groupAt(boardIndex(5, 5, boardSize)).count(), boardSize * boardSize - 6);
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Exercises numberOfLiberties() and numberOfLibertiesOfGroupAt(). Uses
+/// the same scenario as GoBoardRegionTest::testLiberties().
+// -----------------------------------------------------------------------------
+- (void) testLiberties
+{
+  int boardSize = 19;
+  GoBoardCore core(boardSize);
+  int index1 = boardIndex(19, 19, boardSize);  // T19
+  int index2 = boardIndex(18, 19, boardSize);  // S19
+  int index3 = boardIndex(18, 18, boardSize);  // S18
+  int index4 = boardIndex(18, 17, boardSize);  // S17
+  int index5 = boardIndex(19, 17, boardSize);  // T17
+  int index6 = boardIndex(17, 19, boardSize);  // R19
+  int index7 = boardIndex(19, 18, boardSize);  // T18
+
+  XCTAssertEqual(core.numberOfLibertiesOfGroupAt(index1), 2);
+  core.setColorAt(index1, GoBoardCore::ColorBlack);
+  XCTAssertEqual(core.numberOfLibertiesOfGroupAt(index1), 2);
+  core.setColorAt(index2, GoBoardCore::ColorBlack);
+  XCTAssertEqual(core.numberOfLibertiesOfGroupAt(index1), 3);
+  core.setColorAt(index3, GoBoardCore::ColorBlack);
+  XCTAssertEqual(core.numberOfLibertiesOfGroupAt(index1), 4);
+  core.setColorAt(index4, GoBoardCore::ColorBlack);
+  XCTAssertEqual(core.numberOfLibertiesOfGroupAt(index1), 6);
+  core.setColorAt(index5, GoBoardCore::ColorBlack);
+  XCTAssertEqual(core.numberOfLibertiesOfGroupAt(index1), 6);
+  XCTAssertEqual(core.numberOfLiberties(core.groupAt(index5)), 6);
+
+  core.setColorAt(index6, GoBoardCore::ColorWhite);
+  XCTAssertEqual(core.numberOfLibertiesOfGroupAt(index6), 2);
+  XCTAssertEqual(core.numberOfLibertiesOfGroupAt(index1), 5);
+
+  core.setColorAt(index7, GoBoardCore::ColorWhite);
+  XCTAssertEqual(core.numberOfLibertiesOfGroupAt(index7), 0);
+  XCTAssertEqual(core.numberOfLibertiesOfGroupAt(index1), 4);
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Exercises isCapture() and isSuicide().
+// -----------------------------------------------------------------------------
+- (void) testCaptureAndSuicide
+{
+  int boardSize = 9;
+  GoBoardCore core(boardSize);
+
+  // White stone in the corner with one liberty left at A2
+  int whiteStone = boardIndex(1, 1, boardSize);
+  int blackStone = boardIndex(2, 1, boardSize);
+  int liberty = boardIndex(1, 2, boardSize);
+  core.setColorAt(whiteStone, GoBoardCore::ColorWhite);
+  core.setColorAt(blackStone, GoBoardCore::ColorBlack);
+  XCTAssertTrue(core.isCapture(liberty, GoBoardCore::ColorBlack));
+  XCTAssertFalse(core.isCapture(liberty, GoBoardCore::ColorWhite));
+  XCTAssertFalse(core.isSuicide(liberty, GoBoardCore::ColorBlack));
+  XCTAssertFalse(core.isSuicide(liberty, GoBoardCore::ColorWhite));
+
+  // Black eye at A1 after the white stone was captured: White playing into
+  // the eye is suicide, Black filling the eye is not
+  core.setColorAt(whiteStone, GoBoardCore::ColorNone);
+  core.setColorAt(liberty, GoBoardCore::ColorBlack);
+  XCTAssertTrue(core.isSuicide(whiteStone, GoBoardCore::ColorWhite));
+  XCTAssertFalse(core.isSuicide(whiteStone, GoBoardCore::ColorBlack));
+
+  // Black filling its own last liberty is suicide
+  GoBoardCore surrounded(boardSize);
+  surrounded.setColorAt(boardIndex(2, 1, boardSize), GoBoardCore::ColorBlack);
+  surrounded.setColorAt(boardIndex(3, 1, boardSize), GoBoardCore::ColorWhite);
+  surrounded.setColorAt(boardIndex(2, 2, boardSize), GoBoardCore::ColorWhite);
+  surrounded.setColorAt(boardIndex(1, 2, boardSize), GoBoardCore::ColorWhite);
+  XCTAssertTrue(surrounded.isSuicide(boardIndex(1, 1, boardSize), GoBoardCore::ColorBlack));
+  XCTAssertTrue(surrounded.isCapture(boardIndex(1, 1, boardSize), GoBoardCore::ColorWhite));
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Exercises analyzeMoves() and capturedStones(), and checks that
+/// analyzeMoves() agrees with isSuicide() and isCapture() on every empty
+/// intersection of randomly filled boards.
+// -----------------------------------------------------------------------------
+- (void) testAnalyzeMoves
+{
+  int boardSize = 9;
+  GoBoardCore core(boardSize);
+  GoBoardCore::Bitboard suicidePositions;
+  GoBoardCore::Bitboard capturePositions;
+  core.analyzeMoves(GoBoardCore::ColorBlack, suicidePositions, capturePositions);
+  XCTAssertFalse(suicidePositions.any());
+  XCTAssertFalse(capturePositions.any());
+
+  // Same position as in testCaptureAndSuicide
+  core.setColorAt(boardIndex(2, 1, boardSize), GoBoardCore::ColorBlack);
+  core.setColorAt(boardIndex(3, 1, boardSize), GoBoardCore::ColorWhite);
+  core.setColorAt(boardIndex(2, 2, boardSize), GoBoardCore::ColorWhite);
+  core.setColorAt(boardIndex(1, 2, boardSize), GoBoardCore::ColorWhite);
+  int corner = boardIndex(1, 1, boardSize);
+  core.analyzeMoves(GoBoardCore::ColorBlack, suicidePositions, capturePositions);
+  XCTAssertEqual(1, suicidePositions.count());
+  XCTAssertTrue(suicidePositions.test(core.positionOfBoardIndex(corner)));
+  XCTAssertFalse(capturePositions.any());
+  core.analyzeMoves(GoBoardCore::ColorWhite, suicidePositions, capturePositions);
+  XCTAssertFalse(suicidePositions.any());
+  XCTAssertEqual(1, capturePositions.count());
+  XCTAssertTrue(capturePositions.test(core.positionOfBoardIndex(corner)));
+  GoBoardCore::Bitboard capturedStones = core.capturedStones(corner, GoBoardCore::ColorWhite);
+  XCTAssertEqual(1, capturedStones.count());
+  XCTAssertTrue(capturedStones.test(core.positionOfBoardIndex(boardIndex(2, 1, boardSize))));
+  XCTAssertFalse(core.capturedStones(corner, GoBoardCore::ColorBlack).any());
+
+  std::mt19937 randomNumberGenerator(9);
+  for (int iteration = 0; iteration < 500; ++iteration)
+  {
+    int index = randomNumberGenerator() % core.numberOfIntersections();
+    core.setColorAt(index, static_cast<GoBoardCore::Color>(randomNumberGenerator() % 3));
+    for (GoBoardCore::Color color : { GoBoardCore::ColorBlack, GoBoardCore::ColorWhite })
+    {
+      core.analyzeMoves(color, suicidePositions, capturePositions);
+      for (int intersection = 0; intersection < core.numberOfIntersections(); ++intersection)
+      {
+        int position = core.positionOfBoardIndex(intersection);
+        if (GoBoardCore::ColorNone != core.colorAt(intersection))
+        {
+          XCTAssertFalse(suicidePositions.test(position));
+          XCTAssertFalse(capturePositions.test(position));
+          continue;
+        }
+        XCTAssertEqual(core.isSuicide(intersection, color), suicidePositions.test(position));
+        XCTAssertEqual(core.isCapture(intersection, color), capturePositions.test(position));
+      }
+    }
+  }
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Exercises isInAtari() and libertiesOfGroupAt().
+// -----------------------------------------------------------------------------
+- (void) testIsInAtari
+{
+  int boardSize = 9;
+  GoBoardCore core(boardSize);
+  int blackStone = boardIndex(5, 5, boardSize);
+  XCTAssertFalse(core.isInAtari(blackStone));
+  XCTAssertFalse(core.libertiesOfGroupAt(blackStone).any());
+
+  core.setColorAt(blackStone, GoBoardCore::ColorBlack);
+  core.setColorAt(boardIndex(4, 5, boardSize), GoBoardCore::ColorWhite);
+  core.setColorAt(boardIndex(6, 5, boardSize), GoBoardCore::ColorWhite);
+  XCTAssertFalse(core.isInAtari(blackStone));
+  core.setColorAt(boardIndex(5, 6, boardSize), GoBoardCore::ColorWhite);
+  XCTAssertTrue(core.isInAtari(blackStone));
+  GoBoardCore::Bitboard liberties = core.libertiesOfGroupAt(blackStone);
+  XCTAssertEqual(liberties.count(), 1);
+  XCTAssertTrue(liberties.test(core.positionOfBoardIndex(boardIndex(5, 4, boardSize))));
+
+  // Extending the stone gets it out of atari
+  core.setColorAt(boardIndex(5, 4, boardSize), GoBoardCore::ColorBlack);
+  XCTAssertFalse(core.isInAtari(blackStone));
+  XCTAssertEqual(core.numberOfLibertiesOfGroupAt(blackStone), 3);
+
+  // Removing a white stone gives back a liberty
+  core.setColorAt(boardIndex(5, 6, boardSize), GoBoardCore::ColorNone);
+  XCTAssertEqual(core.numberOfLibertiesOfGroupAt(blackStone), 4);
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Checks that the incrementally maintained stone groups and liberties
+/// match a recomputation after every change, while stones are placed,
+/// replaced and removed at random. This covers merging groups, and splitting
+/// groups when a connecting stone is removed.
+// -----------------------------------------------------------------------------
+- (void) testIncrementalGroups
+{
+  for (int boardSize = GoBoardCore::minimumBoardSize; boardSize <= GoBoardCore::maximumBoardSize; boardSize += 6)
+  {
+    GoBoardCore core(boardSize);
+    std::mt19937 randomNumberGenerator(boardSize);
+    for (int iteration = 0; iteration < 2000; ++iteration)
+    {
+      int index = randomNumberGenerator() % core.numberOfIntersections();
+      core.setColorAt(index, static_cast<GoBoardCore::Color>(randomNumberGenerator() % 3));
+      XCTAssertTrue(core.hasConsistentGroups(), @"board size %d, iteration %d", boardSize, iteration);
+    }
+  }
+
+  // Removing the connecting stone splits a group into 2 groups
+  GoBoardCore core(9);
+  int left = boardIndex(4, 5, 9);
+  int connector = boardIndex(5, 5, 9);
+  int right = boardIndex(6, 5, 9);
+  core.setColorAt(left, GoBoardCore::ColorBlack);
+  core.setColorAt(right, GoBoardCore::ColorBlack);
+  core.setColorAt(connector, GoBoardCore::ColorBlack);
+  XCTAssertEqual(core.groupAt(left).count(), 3);
+  XCTAssertEqual(core.numberOfLibertiesOfGroupAt(left), 8);
+  core.setColorAt(connector, GoBoardCore::ColorNone);
+  XCTAssertEqual(core.groupAt(left).count(), 1);
+  XCTAssertEqual(core.groupAt(right).count(), 1);
+  XCTAssertEqual(core.numberOfLibertiesOfGroupAt(left), 4);
+  XCTAssertEqual(core.numberOfLibertiesOfGroupAt(right), 4);
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Measures how long it takes to place and remove random stones and
+/// count the liberties of the affected stone groups by walking GoPoint
+/// objects. Serves as baseline for testPerformanceGoBoardCoreLiberties().
+// -----------------------------------------------------------------------------
+- (void) testPerformanceGoPointLiberties
+{
+  GoBoard* board = [GoBoard boardWithSize:GoBoardSize19];
+  [self measureBlock:^{
+    std::mt19937 randomNumberGenerator(42);
+    long long sumOfLiberties = 0;
+    for (int iteration = 0; iteration < numberOfStonesInBenchmark; ++iteration)
+    {
+      @autoreleasepool
+      {
+        GoPoint* point = [board pointAtIndex:randomNumberGenerator() % (19 * 19)];
+        point.stoneState = static_cast<enum GoColor>(randomNumberGenerator() % 3);
+        sumOfLiberties += libertiesByWalkingGoPoints(point);
+      }
+    }
+    XCTAssertGreaterThan(sumOfLiberties, 0);
+    for (int index = 0; index < 19 * 19; ++index)
+      [board pointAtIndex:index].stoneState = GoColorNone;
+  }];
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Measures how long it takes to place and remove random stones and
+/// count the liberties of the affected stone groups in GoBoardCore.
+// -----------------------------------------------------------------------------
+- (void) testPerformanceGoBoardCoreLiberties
+{
+  [self measureBlock:^{
+    GoBoardCore core(19);
+    std::mt19937 randomNumberGenerator(42);
+    long long sumOfLiberties = 0;
+    for (int iteration = 0; iteration < numberOfStonesInBenchmark; ++iteration)
+    {
+      int index = randomNumberGenerator() % core.numberOfIntersections();
+      core.setColorAt(index, static_cast<GoBoardCore::Color>(randomNumberGenerator() % 3));
+      sumOfLiberties += core.numberOfLibertiesOfGroupAt(index);
+    }
+    XCTAssertGreaterThan(sumOfLiberties, 0);
+  }];
+}
+
+@end
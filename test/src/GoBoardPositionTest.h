@@ -36,5 +36,6 @@
 - (void) testStateAfterDiscard;
 - (void) testBoardStateAfterPositionChange;
 - (void) testKVONotifications;
+- (void) testLastChange;
 
 @end
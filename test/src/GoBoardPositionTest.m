@@ -21,6 +21,7 @@
 // Application includes
 #import <go/GoBoard.h>
 #import <go/GoBoardPosition.h>
+#import <go/GoBoardPositionChange.h>
 #import <go/GoGame.h>
 #import <go/GoMoveModel.h>
 #import <go/GoPoint.h>
@@ -239,6 +240,61 @@
   XCTAssertEqual(expectedNumberOfRegions, m_game.board.regions.count);
 }
 
+// -----------------------------------------------------------------------------
+/// @brief Checks that the change record in GoBoardPosition's lastChange
+/// property summarizes how the stones on the board changed.
+// -----------------------------------------------------------------------------
+- (void) testLastChange
+{
+  GoBoardPosition* boardPosition = m_game.boardPosition;
+  XCTAssertNil(boardPosition.lastChange);
+
+  GoPoint* point1 = [m_game.board pointAtVertex:@"A2"];
+  GoPoint* point2 = [m_game.board pointAtVertex:@"A1"];
+  GoPoint* point3 = [m_game.board pointAtVertex:@"B1"];
+  [m_game play:point1];
+  GoBoardPositionChange* change = boardPosition.lastChange;
+  XCTAssertNotNil(change);
+  XCTAssertEqual(0, change.oldBoardPosition);
+  XCTAssertEqual(1, change.newBoardPosition);
+  XCTAssertEqualObjects([NSArray arrayWithObject:point1], change.placedStones);
+  XCTAssertEqual(0, change.removedStones.count);
+  [m_game play:point2];
+  [m_game play:point3];  // captures W on A1
+  change = boardPosition.lastChange;
+  XCTAssertEqual(2, change.oldBoardPosition);
+  XCTAssertEqual(3, change.newBoardPosition);
+  XCTAssertEqualObjects([NSArray arrayWithObject:point3], change.placedStones);
+  XCTAssertEqualObjects([NSArray arrayWithObject:point2], change.removedStones);
+  [m_game pass];
+  change = boardPosition.lastChange;
+  XCTAssertEqual(0, change.placedStones.count);
+  XCTAssertEqual(0, change.changedPoints.count);
+
+  // A multi-move jump results in a single record that describes only the net
+  // change. The stone on A1 was placed and captured in between, so it does not
+  // appear at all.
+  boardPosition.currentBoardPosition = 0;
+  change = boardPosition.lastChange;
+  XCTAssertEqual(4, change.oldBoardPosition);
+  XCTAssertEqual(0, change.newBoardPosition);
+  XCTAssertEqual(0, change.placedStones.count);
+  XCTAssertEqual(2, change.removedStones.count);
+  XCTAssertTrue([change.removedStones containsObject:point1]);
+  XCTAssertTrue([change.removedStones containsObject:point3]);
+  XCTAssertEqual(0, change.recoloredStones.count);
+
+  // Undoing the capturing move restores the captured stone
+  boardPosition.currentBoardPosition = 3;
+  boardPosition.currentBoardPosition = 2;
+  change = boardPosition.lastChange;
+  XCTAssertEqual(3, change.oldBoardPosition);
+  XCTAssertEqual(2, change.newBoardPosition);
+  XCTAssertEqualObjects([NSArray arrayWithObject:point2], change.placedStones);
+  XCTAssertEqualObjects([NSArray arrayWithObject:point3], change.removedStones);
+  XCTAssertEqual(2, change.changedPoints.count);
+}
+
 // -----------------------------------------------------------------------------
 /// @brief Checks that KVO notifications are sent, and that they are sent in
 /// the order that they are documented.
@@ -0,0 +1,108 @@
+// -----------------------------------------------------------------------------
+// Copyright 2026 Patrick Näf (herzbube@herzbube.ch)
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// -----------------------------------------------------------------------------
+
+
+// Test includes
+#import "GoBoardRegionGraphTest.h"
+
+// Application includes
+#import <go/GoGame.h>
+#import <go/GoBoard.h>
+#import <go/GoBoardRegion.h>
+#import <go/GoBoardRegionGraph.h>
+#import <go/GoPoint.h>
+
+
+@implementation GoBoardRegionGraphTest
+
+// -----------------------------------------------------------------------------
+/// @brief Checks the graph of the single GoBoardRegion object in existence
+/// after a new GoGame has been created.
+// -----------------------------------------------------------------------------
+- (void) testNewGame
+{
+  GoBoard* board = m_game.board;
+  GoBoardRegionGraph* regionGraph = [[[GoBoardRegionGraph alloc] initWithBoard:board] autorelease];
+  XCTAssertEqual(1, regionGraph.numberOfRegions);
+  GoBoardRegion* region = [board pointAtVertex:@"A1"].region;
+  XCTAssertEqual(0, [regionGraph regionIdOfRegion:region]);
+  XCTAssertEqual(region, [regionGraph regionWithId:0]);
+  XCTAssertEqual(GoColorNone, [regionGraph colorOfRegionWithId:0]);
+  XCTAssertEqual(0, [regionGraph numberOfAdjacentRegionsOfRegionWithId:0]);
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Checks that the graph contains the same adjacent regions as
+/// GoBoardRegion::adjacentRegions() for every region.
+// -----------------------------------------------------------------------------
+- (void) testAdjacentRegions
+{
+  [m_game play:[m_game.board pointAtVertex:@"B1"]];
+  [m_game play:[m_game.board pointAtVertex:@"C1"]];
+  [m_game play:[m_game.board pointAtVertex:@"A2"]];
+  [m_game play:[m_game.board pointAtVertex:@"C2"]];
+  [m_game play:[m_game.board pointAtVertex:@"B3"]];
+  [m_game play:[m_game.board pointAtVertex:@"Q16"]];
+  [m_game play:[m_game.board pointAtVertex:@"B2"]];
+
+  GoBoard* board = m_game.board;
+  GoBoardRegionGraph* regionGraph = [[[GoBoardRegionGraph alloc] initWithBoard:board] autorelease];
+  // A1, the black group B1/A2/B2/B3, the white stones C1/C2, the white stone
+  // Q16, and the rest of the board
+  XCTAssertEqual(5, regionGraph.numberOfRegions);
+  for (int regionId = 0; regionId < regionGraph.numberOfRegions; ++regionId)
+  {
+    GoBoardRegion* region = [regionGraph regionWithId:regionId];
+    XCTAssertEqual([region color], [regionGraph colorOfRegionWithId:regionId]);
+    NSArray* adjacentRegions = [region adjacentRegions];
+    int numberOfAdjacentRegions = [regionGraph numberOfAdjacentRegionsOfRegionWithId:regionId];
+    XCTAssertEqual(adjacentRegions.count, (NSUInteger)numberOfAdjacentRegions);
+    const int* adjacentRegionIds = [regionGraph adjacentRegionIdsOfRegionWithId:regionId];
+    for (int index = 0; index < numberOfAdjacentRegions; ++index)
+      XCTAssertTrue([adjacentRegions containsObject:[regionGraph regionWithId:adjacentRegionIds[index]]]);
+  }
+
+  int emptyRegionA1Id = [regionGraph regionIdOfRegion:[board pointAtVertex:@"A1"].region];
+  XCTAssertEqual(1, [regionGraph numberOfAdjacentRegionsOfRegionWithId:emptyRegionA1Id]);
+  int blackGroupId = [regionGraph regionIdOfRegion:[board pointAtVertex:@"B2"].region];
+  XCTAssertEqual(3, [regionGraph numberOfAdjacentRegionsOfRegionWithId:blackGroupId]);
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Exercises the regionIdOfRegion:() method and the range checks of
+/// the methods that take a region ID.
+// -----------------------------------------------------------------------------
+- (void) testRegionIdOfRegion
+{
+  [m_game play:[m_game.board pointAtVertex:@"D4"]];
+  GoBoard* board = m_game.board;
+  GoBoardRegionGraph* regionGraph = [[[GoBoardRegionGraph alloc] initWithBoard:board] autorelease];
+  XCTAssertEqual(2, regionGraph.numberOfRegions);
+  GoBoardRegion* stoneGroup = [board pointAtVertex:@"D4"].region;
+  int stoneGroupId = [regionGraph regionIdOfRegion:stoneGroup];
+  XCTAssertEqual(stoneGroup, [regionGraph regionWithId:stoneGroupId]);
+  XCTAssertEqual(GoColorBlack, [regionGraph colorOfRegionWithId:stoneGroupId]);
+  XCTAssertEqual(1, [regionGraph numberOfAdjacentRegionsOfRegionWithId:stoneGroupId]);
+
+  XCTAssertThrowsSpecificNamed([regionGraph regionIdOfRegion:[GoBoardRegion region]],
+                              NSException, NSInvalidArgumentException, @"region without points");
+  XCTAssertThrowsSpecificNamed([regionGraph regionWithId:-1],
+                              NSException, NSRangeException, @"negative region ID");
+  XCTAssertThrowsSpecificNamed([regionGraph numberOfAdjacentRegionsOfRegionWithId:2],
+                              NSException, NSRangeException, @"region ID too large");
+}
+
+@end
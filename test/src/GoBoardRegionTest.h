@@ -30,6 +30,7 @@
 - (void) testNewGame;
 - (void) testRegion;
 - (void) testRegionWithPoint;
+- (void) testRegionTakingOverPoints;
 - (void) testAddPoint;
 - (void) testRemovePoint;
 - (void) testJoinRegion;
@@ -105,6 +105,35 @@
                               NSException, NSInvalidArgumentException, @"point is nil");
 }
 
+// -----------------------------------------------------------------------------
+/// @brief Exercises the regionTakingOverPoints:() convenience constructor.
+// -----------------------------------------------------------------------------
+- (void) testRegionTakingOverPoints
+{
+  GoBoard* board = m_game.board;
+  GoBoardRegion* mainRegion = [board pointAtVertex:@"A1"].region;
+  NSArray* points = [NSArray arrayWithArray:mainRegion.points];
+  NSUInteger expectedNumberOfPoints = points.count;
+  NSUInteger expectedNumberOfRegions = 1;
+
+  // Keep the old region alive, none of the points references it anymore after
+  // the takeover
+  [[mainRegion retain] autorelease];
+  GoBoardRegion* region = [GoBoardRegion regionTakingOverPoints:points];
+  XCTAssertNotNil(region);
+  XCTAssertTrue(mainRegion != region);
+  XCTAssertEqual(expectedNumberOfPoints, region.points.count);
+  XCTAssertFalse([region isStoneGroup]);
+  for (GoPoint* point in points)
+    XCTAssertEqual(region, point.region);
+  XCTAssertEqual(expectedNumberOfRegions, board.regions.count);
+
+  XCTAssertThrowsSpecificNamed([GoBoardRegion regionTakingOverPoints:nil],
+                               NSException, NSInvalidArgumentException, @"points array is nil");
+  XCTAssertThrowsSpecificNamed([GoBoardRegion regionTakingOverPoints:[NSArray array]],
+                               NSException, NSInvalidArgumentException, @"points array is empty");
+}
+
 // -----------------------------------------------------------------------------
 /// @brief Exercises the addPoint:() method.
 // -----------------------------------------------------------------------------
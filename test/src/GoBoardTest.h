@@ -33,6 +33,8 @@
 - (void) testStringForSize;
 - (void) testPointEnumerator;
 - (void) testPointAtVertex;
+- (void) testPointAtIndex;
+- (void) testStoneStateAtIndex;
 - (void) testNeighbourOfInDirection;
 - (void) testPointAtCorner;
 - (void) testStarPoints;
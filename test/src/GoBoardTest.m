@@ -144,6 +144,55 @@
                               NSException, NSInvalidArgumentException, @"malformed string used for vertex");
 }
 
+// -----------------------------------------------------------------------------
+/// @brief Exercises the pointAtIndex:() method.
+// -----------------------------------------------------------------------------
+- (void) testPointAtIndex
+{
+  GoBoard* board = m_game.board;
+  XCTAssertEqual([board pointAtIndex:0], [board pointAtVertex:@"A1"]);
+  XCTAssertEqual([board pointAtIndex:8], [board pointAtVertex:@"J1"]);
+  XCTAssertEqual([board pointAtIndex:19], [board pointAtVertex:@"A2"]);
+  XCTAssertEqual([board pointAtIndex:360], [board pointAtVertex:@"T19"]);
+  for (int index = 0; index < 361; index += 37)
+    XCTAssertEqual([board indexOfPoint:[board pointAtIndex:index]], index);
+
+  XCTAssertThrowsSpecificNamed([board pointAtIndex:-1],
+                              NSException, NSRangeException, @"negative index");
+  XCTAssertThrowsSpecificNamed([board pointAtIndex:361],
+                              NSException, NSRangeException, @"index too large");
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Exercises the stoneStateAtIndex:() and setStoneState:atIndex:()
+/// methods, and checks that GoPoint objects are views of the stone states
+/// stored by GoBoard.
+// -----------------------------------------------------------------------------
+- (void) testStoneStateAtIndex
+{
+  GoBoard* board = m_game.board;
+  GoPoint* point = [board pointAtVertex:@"D4"];
+  int index = point.index;
+  XCTAssertEqual(index, [board indexOfPoint:point]);
+  XCTAssertEqual(GoColorNone, [board stoneStateAtIndex:index]);
+
+  point.stoneState = GoColorBlack;
+  XCTAssertEqual(GoColorBlack, [board stoneStateAtIndex:index]);
+  [board setStoneState:GoColorWhite atIndex:index];
+  XCTAssertEqual(GoColorWhite, point.stoneState);
+  XCTAssertEqual(3, [board libertiesAtIndex:[board pointAtVertex:@"D5"].index]);
+  XCTAssertEqual(4, [board libertiesAtIndex:index]);
+  XCTAssertFalse([board isInAtariAtIndex:index]);
+  [board setStoneState:GoColorNone atIndex:index];
+  XCTAssertFalse([point hasStone]);
+
+  // A vertex that is valid, but not on this board
+  GoBoard* smallBoard = [GoBoard boardWithSize:GoBoardSize9];
+  XCTAssertNotNil([smallBoard pointAtVertex:@"J9"]);
+  XCTAssertThrowsSpecificNamed([smallBoard pointAtVertex:@"K9"],
+                              NSException, NSRangeException, @"vertex not on board");
+}
+
 // -----------------------------------------------------------------------------
 /// @brief Exercises the neighbourOf:inDirection() method.
 // -----------------------------------------------------------------------------
@@ -0,0 +1,307 @@
+// -----------------------------------------------------------------------------
+// Copyright 2026 Patrick Näf (herzbube@herzbube.ch)
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// -----------------------------------------------------------------------------
+
+
+// Test includes
+#import "GoDeadStoneEstimatorTest.h"
+
+// Application includes
+#import <go/GoBoardCore.h>
+#import <go/GoDeadStoneEstimator.h>
+
+// C++ standard library
+#include <cctype>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+
+/// @brief The board size used by the functional tests.
+static const int boardSize = 7;
+
+/// @brief Positions used by the functional tests, one string per row, from
+/// the top row to the bottom row. "X" is a black stone, "O" is a white stone,
+/// "." is an empty intersection. Stones that are dead are written in lower
+/// case ("x" and "o").
+static const char* const positions[][boardSize] =
+{
+  // A black group with two eyes in the upper left corner, and a white group
+  // that borders the open board
+  {
+    ".X.X.O.",
+    "XXXXOO.",
+    ".......",
+    ".......",
+    ".......",
+    ".......",
+    "......."
+  },
+  // Two dead white stones inside the eye space of an unconditionally alive
+  // black group
+  {
+    ".X.XO..",
+    "XXXXO..",
+    "ooXXO.O",
+    "..XOO..",
+    "XXXO...",
+    ".X.O...",
+    "XXXO..."
+  },
+  // A dead white stone inside black's corner
+  {
+    "...X.O.",
+    ".o.XOO.",
+    "XXXXO..",
+    "OOOOO..",
+    ".......",
+    ".......",
+    "......."
+  },
+  // A dead black group with only one eye, enclosed by an unconditionally
+  // alive white group
+  {
+    ".O.O...",
+    "OOOO...",
+    "xxxO...",
+    "x.xO...",
+    "xxxO...",
+    "OOOO...",
+    ".O.O..."
+  }
+};
+
+
+// -----------------------------------------------------------------------------
+/// @brief Returns the board index of the intersection at the 1-based
+/// coordinates @a x and @a y on the board used by the functional tests.
+// -----------------------------------------------------------------------------
+static int boardIndex(int x, int y)
+{
+  return (y - 1) * boardSize + (x - 1);
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Places the stones of the position @a rows on @a core. Returns the
+/// positions of the stones that are dead.
+// -----------------------------------------------------------------------------
+static GoBoardCore::Bitboard setupPosition(GoBoardCore& core, const char* const* rows)
+{
+  GoBoardCore::Bitboard deadStones;
+  for (int y = 1; y <= boardSize; ++y)
+  {
+    for (int x = 1; x <= boardSize; ++x)
+    {
+      char character = rows[boardSize - y][x - 1];
+      if ('X' == toupper(character))
+        core.setColorAt(boardIndex(x, y), GoBoardCore::ColorBlack);
+      else if ('O' == toupper(character))
+        core.setColorAt(boardIndex(x, y), GoBoardCore::ColorWhite);
+      else
+        continue;
+      if (islower(character))
+        deadStones.set(core.positionOfBoardIndex(boardIndex(x, y)));
+    }
+  }
+  return deadStones;
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Returns the stone group in @a stoneGroups that contains the stone on
+/// the intersection at the 1-based coordinates @a x and @a y. Throws
+/// std::out_of_range if no stone group contains the intersection.
+// -----------------------------------------------------------------------------
+static const GoDeadStoneEstimator::StoneGroup& stoneGroupAt(const std::vector<GoDeadStoneEstimator::StoneGroup>& stoneGroups, const GoBoardCore& core, int x, int y)
+{
+  int position = core.positionOfBoardIndex(boardIndex(x, y));
+  for (const GoDeadStoneEstimator::StoneGroup& stoneGroup : stoneGroups)
+  {
+    if (stoneGroup.stones.test(position))
+      return stoneGroup;
+  }
+  throw std::out_of_range("No stone group contains the intersection");
+}
+
+
+@implementation GoDeadStoneEstimatorTest
+
+// -----------------------------------------------------------------------------
+/// @brief Checks that Benson's algorithm finds a stone group with two eyes to
+/// be unconditionally alive, and that a stone group that borders the open
+/// board is found to be alive only if territory statistics confirm the eye
+/// space heuristics.
+// -----------------------------------------------------------------------------
+- (void) testUnconditionallyAlive
+{
+  GoBoardCore core(boardSize);
+  setupPosition(core, positions[0]);
+  GoDeadStoneEstimator deadStoneEstimator(core);
+  std::vector<GoDeadStoneEstimator::StoneGroup> stoneGroups = deadStoneEstimator.estimateDeadStones();
+  XCTAssertEqual(static_cast<size_t>(2), stoneGroups.size());
+
+  const GoDeadStoneEstimator::StoneGroup& blackGroup = stoneGroupAt(stoneGroups, core, 2, 7);
+  XCTAssertEqual(GoBoardCore::ColorBlack, blackGroup.color);
+  XCTAssertEqual(6, blackGroup.stones.count());
+  XCTAssertEqual(GoDeadStoneEstimator::VerdictAlive, blackGroup.verdict);
+  XCTAssertTrue(blackGroup.isUnconditional);
+  const GoDeadStoneEstimator::StoneGroup& whiteGroup = stoneGroupAt(stoneGroups, core, 6, 7);
+  XCTAssertEqual(GoDeadStoneEstimator::VerdictAmbiguous, whiteGroup.verdict);
+  XCTAssertFalse(whiteGroup.isUnconditional);
+
+  // White owns the right side of the board
+  std::vector<float> territoryStatisticsScores(core.numberOfIntersections(), 0.0f);
+  for (int x = 5; x <= boardSize; ++x)
+  {
+    for (int y = 1; y <= boardSize; ++y)
+      territoryStatisticsScores[boardIndex(x, y)] = -0.9f;
+  }
+  deadStoneEstimator.setTerritoryStatisticsScores(territoryStatisticsScores.data());
+  stoneGroups = deadStoneEstimator.estimateDeadStones();
+  XCTAssertEqual(GoDeadStoneEstimator::VerdictAlive, stoneGroupAt(stoneGroups, core, 6, 7).verdict);
+  XCTAssertFalse(stoneGroupAt(stoneGroups, core, 6, 7).isUnconditional);
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Checks that Benson's algorithm finds stones inside the eye space of
+/// an unconditionally alive stone group to be unconditionally dead.
+// -----------------------------------------------------------------------------
+- (void) testUnconditionallyDead
+{
+  GoBoardCore core(boardSize);
+  setupPosition(core, positions[1]);
+  GoDeadStoneEstimator deadStoneEstimator(core);
+  std::vector<GoDeadStoneEstimator::StoneGroup> stoneGroups = deadStoneEstimator.estimateDeadStones();
+
+  const GoDeadStoneEstimator::StoneGroup& blackGroup = stoneGroupAt(stoneGroups, core, 1, 1);
+  XCTAssertEqual(16, blackGroup.stones.count());
+  XCTAssertEqual(GoDeadStoneEstimator::VerdictAlive, blackGroup.verdict);
+  XCTAssertTrue(blackGroup.isUnconditional);
+  const GoDeadStoneEstimator::StoneGroup& deadGroup = stoneGroupAt(stoneGroups, core, 1, 5);
+  XCTAssertEqual(GoBoardCore::ColorWhite, deadGroup.color);
+  XCTAssertEqual(2, deadGroup.stones.count());
+  XCTAssertEqual(GoDeadStoneEstimator::VerdictDead, deadGroup.verdict);
+  XCTAssertTrue(deadGroup.isUnconditional);
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Checks that the eye space heuristics cannot decide about a stone
+/// group with only one eye if no territory statistics are available.
+// -----------------------------------------------------------------------------
+- (void) testEyeSpace
+{
+  GoBoardCore core(boardSize);
+  setupPosition(core, positions[3]);
+  GoDeadStoneEstimator deadStoneEstimator(core);
+  std::vector<GoDeadStoneEstimator::StoneGroup> stoneGroups = deadStoneEstimator.estimateDeadStones();
+  XCTAssertEqual(static_cast<size_t>(2), stoneGroups.size());
+
+  const GoDeadStoneEstimator::StoneGroup& blackGroup = stoneGroupAt(stoneGroups, core, 1, 5);
+  XCTAssertEqual(8, blackGroup.stones.count());
+  XCTAssertEqual(GoDeadStoneEstimator::VerdictAmbiguous, blackGroup.verdict);
+  XCTAssertFalse(blackGroup.isUnconditional);
+  const GoDeadStoneEstimator::StoneGroup& whiteGroup = stoneGroupAt(stoneGroups, core, 4, 4);
+  XCTAssertEqual(GoDeadStoneEstimator::VerdictAlive, whiteGroup.verdict);
+  XCTAssertTrue(whiteGroup.isUnconditional);
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Checks that territory statistics confirm the eye space heuristics,
+/// and that territory statistics that are all zero are ignored.
+// -----------------------------------------------------------------------------
+- (void) testTerritoryStatistics
+{
+  GoBoardCore core(boardSize);
+  setupPosition(core, positions[2]);
+  GoDeadStoneEstimator deadStoneEstimator(core);
+  std::vector<GoDeadStoneEstimator::StoneGroup> stoneGroups = deadStoneEstimator.estimateDeadStones();
+  XCTAssertEqual(GoDeadStoneEstimator::VerdictAmbiguous, stoneGroupAt(stoneGroups, core, 2, 6).verdict);
+
+  std::vector<float> territoryStatisticsScores(core.numberOfIntersections(), 0.0f);
+  deadStoneEstimator.setTerritoryStatisticsScores(territoryStatisticsScores.data());
+  stoneGroups = deadStoneEstimator.estimateDeadStones();
+  XCTAssertEqual(GoDeadStoneEstimator::VerdictAmbiguous, stoneGroupAt(stoneGroups, core, 2, 6).verdict);
+
+  // Black owns the upper left corner
+  for (int x = 1; x <= 4; ++x)
+  {
+    for (int y = 5; y <= boardSize; ++y)
+      territoryStatisticsScores[boardIndex(x, y)] = 0.9f;
+  }
+  deadStoneEstimator.setTerritoryStatisticsScores(territoryStatisticsScores.data());
+  stoneGroups = deadStoneEstimator.estimateDeadStones();
+  XCTAssertEqual(GoDeadStoneEstimator::VerdictDead, stoneGroupAt(stoneGroups, core, 2, 6).verdict);
+  XCTAssertFalse(stoneGroupAt(stoneGroups, core, 2, 6).isUnconditional);
+  XCTAssertEqual(GoDeadStoneEstimator::VerdictAlive, stoneGroupAt(stoneGroups, core, 1, 5).verdict);
+
+  // Territory statistics cannot override the eye space heuristics
+  for (float& territoryStatisticsScore : territoryStatisticsScores)
+    territoryStatisticsScore = -territoryStatisticsScore;
+  deadStoneEstimator.setTerritoryStatisticsScores(territoryStatisticsScores.data());
+  stoneGroups = deadStoneEstimator.estimateDeadStones();
+  XCTAssertEqual(GoDeadStoneEstimator::VerdictAmbiguous, stoneGroupAt(stoneGroups, core, 2, 6).verdict);
+  XCTAssertEqual(GoDeadStoneEstimator::VerdictAmbiguous, stoneGroupAt(stoneGroups, core, 1, 5).verdict);
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Checks that the estimate agrees with the known status of the stones
+/// in all test positions whenever the estimate is not ambiguous.
+// -----------------------------------------------------------------------------
+- (void) testAgreementWithKnownStatus
+{
+  int numberOfEstimatedStones = 0;
+  int numberOfAgreements = 0;
+  for (const auto& rows : positions)
+  {
+    GoBoardCore core(boardSize);
+    GoBoardCore::Bitboard deadStones = setupPosition(core, rows);
+    GoDeadStoneEstimator deadStoneEstimator(core);
+    for (const GoDeadStoneEstimator::StoneGroup& stoneGroup : deadStoneEstimator.estimateDeadStones())
+    {
+      if (GoDeadStoneEstimator::VerdictAmbiguous == stoneGroup.verdict)
+        continue;
+      numberOfEstimatedStones += stoneGroup.stones.count();
+      bool isDead = (stoneGroup.stones & deadStones).any();
+      if (isDead == (GoDeadStoneEstimator::VerdictDead == stoneGroup.verdict))
+        numberOfAgreements += stoneGroup.stones.count();
+    }
+  }
+  XCTAssertEqual(39, numberOfEstimatedStones);
+  XCTAssertEqual(numberOfEstimatedStones, numberOfAgreements);
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Measures how long it takes to estimate the dead stones of a 19x19
+/// board that is covered with many small stone groups and areas.
+// -----------------------------------------------------------------------------
+- (void) testPerformanceEstimateDeadStones
+{
+  GoBoardCore core(GoBoardCore::maximumBoardSize);
+  std::mt19937 randomNumberGenerator(23);
+  for (int index = 0; index < core.numberOfIntersections(); ++index)
+  {
+    unsigned int value = randomNumberGenerator() % 10;
+    if (value < 4)
+      core.setColorAt(index, GoBoardCore::ColorBlack);
+    else if (value < 8)
+      core.setColorAt(index, GoBoardCore::ColorWhite);
+  }
+  GoDeadStoneEstimator deadStoneEstimator(core);
+  [self measureBlock:^{
+    for (int iteration = 0; iteration < 100; ++iteration)
+      deadStoneEstimator.estimateDeadStones();
+  }];
+}
+
+@end
@@ -0,0 +1,634 @@
+// -----------------------------------------------------------------------------
+// Copyright 2026 Patrick Näf (herzbube@herzbube.ch)
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// -----------------------------------------------------------------------------
+
+
+// Test includes
+#import "GoGamePerformanceTest.h"
+
+// Application includes
+#import <go/GoBoard.h>
+#import <go/GoBoardPosition.h>
+#import <go/GoBoardRegion.h>
+#import <go/GoGame.h>
+#import <go/GoLegalMoveMap.h>
+#import <go/GoMove.h>
+#import <go/GoMoveModel.h>
+#import <go/GoPlayer.h>
+#import <go/GoPoint.h>
+#import <go/GoScore.h>
+#import <main/ApplicationDelegate.h>
+#import <newgame/NewGameModel.h>
+#import <command/game/NewGameCommand.h>
+
+// C++ standard library
+#include <random>
+#include <vector>
+
+
+/// @brief The number of moves in the game that the benchmarks replay. This is
+/// the length of a typical professional game on a 19x19 board.
+static const int numberOfMovesInBenchmark = 250;
+/// @brief The number of moves in the game with ko fights, see
+/// playGameWithKoFights().
+static const int numberOfMovesInKoFightBenchmark = 347;
+/// @brief The number of moves in the long game that the score benchmarks
+/// replay. Scoring statistics used to cost time proportional to the number of
+/// moves, so a long game makes the difference visible.
+static const int numberOfMovesInLongGameBenchmark = 500;
+
+
+// -----------------------------------------------------------------------------
+/// @brief Plays @a numberOfMoves legal moves in @a game and returns the board
+/// indexes of the moves.
+///
+/// The moves are chosen with a seeded random number generator, so the game is
+/// the same every time. The game has the characteristics that matter for the
+/// benchmarks: Stone groups grow and merge, groups are captured, and the
+/// board fills up.
+// -----------------------------------------------------------------------------
+static std::vector<int> playGeneratedGame(GoGame* game, int numberOfMoves)
+{
+  std::vector<int> moves;
+  GoBoard* board = game.board;
+  int numberOfIntersections = board.size * board.size;
+  std::mt19937 randomNumberGenerator(19);
+  enum GoMoveIsIllegalReason illegalReason;
+  while (moves.size() < static_cast<size_t>(numberOfMoves))
+  {
+    GoPoint* point = [board pointAtIndex:randomNumberGenerator() % numberOfIntersections];
+    if (! [game isLegalMove:point isIllegalReason:&illegalReason])
+      continue;
+    [game play:point];
+    moves.push_back(point.index);
+  }
+  return moves;
+}
+
+
+// -----------------------------------------------------------------------------
+/// @brief Plays a game in @a game in which the players fight a ko on the lower
+/// edge of the board over and over again. Returns the number of moves played.
+/// Stops early if one of the moves is illegal.
+///
+/// After the ko shape has been set up, each round consists of White taking the
+/// ko, a ko threat by Black and its answer by White, Black taking back the ko,
+/// and a ko threat by White and its answer by Black. Black fills rows 6-11 and
+/// White fills rows 13-19 with threats, so the ko can be retaken without
+/// repeating a board position, and no stones other than the ko stones are
+/// ever captured.
+// -----------------------------------------------------------------------------
+static int playGameWithKoFights(GoGame* game)
+{
+  GoBoard* board = game.board;
+  NSString* columns = @"ABCDEFGHJKLMNOPQRST";
+  NSMutableArray* blackThreats = [NSMutableArray array];
+  NSMutableArray* whiteThreats = [NSMutableArray array];
+  for (int row = 6; row <= 19; ++row)
+  {
+    if (12 == row)
+      continue;
+    for (NSUInteger column = 0; column < columns.length; ++column)
+    {
+      NSString* vertex = [NSString stringWithFormat:@"%C%d", [columns characterAtIndex:column], row];
+      if (row < 12)
+        [blackThreats addObject:[board pointAtVertex:vertex]];
+      else
+        [whiteThreats addObject:[board pointAtVertex:vertex]];
+    }
+  }
+
+  NSMutableArray* moves = [NSMutableArray array];
+  for (NSString* vertex in @[@"A1", @"C2", @"B2", @"D1", @"C1"])
+    [moves addObject:[board pointAtVertex:vertex]];
+  GoPoint* whiteKoPoint = [board pointAtVertex:@"B1"];
+  GoPoint* blackKoPoint = [board pointAtVertex:@"C1"];
+  for (NSUInteger threat = 0; threat + 1 < blackThreats.count; threat += 2)
+  {
+    [moves addObject:whiteKoPoint];
+    [moves addObject:[blackThreats objectAtIndex:threat]];
+    [moves addObject:[whiteThreats objectAtIndex:threat]];
+    [moves addObject:blackKoPoint];
+    [moves addObject:[whiteThreats objectAtIndex:threat + 1]];
+    [moves addObject:[blackThreats objectAtIndex:threat + 1]];
+  }
+
+  int numberOfMoves = 0;
+  enum GoMoveIsIllegalReason illegalReason;
+  for (GoPoint* point in moves)
+  {
+    if (! [game isLegalMove:point isIllegalReason:&illegalReason])
+      break;
+    [game play:point];
+    ++numberOfMoves;
+  }
+  return numberOfMoves;
+}
+
+
+// -----------------------------------------------------------------------------
+/// @brief Compares the legal move maps of @a game for both colors with the
+/// result of GoGame::isLegalMove:byColor:isIllegalReason:() for every
+/// intersection in the current board position. Returns the number of
+/// intersections for which the legality or the reason differ.
+// -----------------------------------------------------------------------------
+static int numberOfLegalMoveMapMismatches(GoGame* game)
+{
+  int numberOfMismatches = 0;
+  GoBoard* board = game.board;
+  int numberOfIntersections = board.size * board.size;
+  for (enum GoColor color : {GoColorBlack, GoColorWhite})
+  {
+    GoLegalMoveMap* legalMoveMap = [game legalMoveMapForColor:color];
+    for (int index = 0; index < numberOfIntersections; ++index)
+    {
+      enum GoMoveIsIllegalReason expectedReason = GoMoveIsIllegalReasonUnknown;
+      enum GoMoveIsIllegalReason reason = GoMoveIsIllegalReasonUnknown;
+      bool expectedIsLegal = [game isLegalMove:[board pointAtIndex:index] byColor:color isIllegalReason:&expectedReason];
+      bool isLegal = [legalMoveMap isLegalMoveAtIndex:index isIllegalReason:&reason];
+      if (isLegal != expectedIsLegal || (! isLegal && reason != expectedReason))
+        ++numberOfMismatches;
+    }
+  }
+  return numberOfMismatches;
+}
+
+
+// -----------------------------------------------------------------------------
+/// @brief Returns the stone states of all intersections of @a board, in the
+/// order defined by GoBoard::indexOfPoint:().
+// -----------------------------------------------------------------------------
+static std::vector<enum GoColor> stoneStatesOfBoard(GoBoard* board)
+{
+  std::vector<enum GoColor> stoneStates;
+  int numberOfIntersections = board.size * board.size;
+  for (int index = 0; index < numberOfIntersections; ++index)
+    stoneStates.push_back([board stoneStateAtIndex:index]);
+  return stoneStates;
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Returns true if the GoBoardRegion objects of @a board are
+/// consistent: Every GoPoint is in exactly the GoBoardRegion it references,
+/// all GoPoint objects in a GoBoardRegion have the same stone state, and
+/// neighbouring stones of the same color are in the same GoBoardRegion.
+// -----------------------------------------------------------------------------
+static bool hasConsistentRegions(GoBoard* board)
+{
+  NSUInteger numberOfPointsInRegions = 0;
+  for (GoBoardRegion* region in board.regions)
+  {
+    enum GoColor stoneState = [region.points.firstObject stoneState];
+    for (GoPoint* point in region.points)
+    {
+      if (point.region != region || point.stoneState != stoneState)
+        return false;
+    }
+    numberOfPointsInRegions += region.points.count;
+  }
+  int numberOfIntersections = board.size * board.size;
+  if (numberOfPointsInRegions != static_cast<NSUInteger>(numberOfIntersections))
+    return false;
+
+  for (int index = 0; index < numberOfIntersections; ++index)
+  {
+    GoPoint* point = [board pointAtIndex:index];
+    if (! point.hasStone)
+      continue;
+    for (GoPoint* neighbour in point.neighbours)
+    {
+      if (neighbour.stoneState == point.stoneState && neighbour.region != point.region)
+        return false;
+    }
+  }
+  return true;
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Returns the stone states of all board positions of @a game. The
+/// stone states are obtained by stepping through the game one board position
+/// at a time, which never restores a checkpoint.
+// -----------------------------------------------------------------------------
+static std::vector<std::vector<enum GoColor>> stoneStatesOfAllBoardPositions(GoGame* game)
+{
+  std::vector<std::vector<enum GoColor>> stoneStates;
+  GoBoardPosition* boardPosition = game.boardPosition;
+  while (boardPosition.currentBoardPosition > 0)
+    boardPosition.currentBoardPosition = boardPosition.currentBoardPosition - 1;
+  for (int position = 0; position < boardPosition.numberOfBoardPositions; ++position)
+  {
+    boardPosition.currentBoardPosition = position;
+    stoneStates.push_back(stoneStatesOfBoard(game.board));
+  }
+  return stoneStates;
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Returns the statistics of the first @a numberOfMoves moves in
+/// @a moveModel. The statistics are obtained by walking the move list, the
+/// way GoScore used to do it before GoMoveModel kept running totals.
+// -----------------------------------------------------------------------------
+static struct GoMoveStatistics statisticsOfFirstMovesByWalking(GoMoveModel* moveModel, int numberOfMoves)
+{
+  struct GoMoveStatistics moveStatistics = {};
+  for (int index = 0; index < numberOfMoves; ++index)
+  {
+    GoMove* move = [moveModel moveAtIndex:index];
+    bool moveByBlack = move.player.black;
+    int numberOfCapturedStones = static_cast<int>(move.capturedStones.count);
+    if (GoMoveTypePlay == move.type)
+    {
+      if (moveByBlack)
+      {
+        moveStatistics.stonesPlayedByBlack++;
+        moveStatistics.capturedByBlack += numberOfCapturedStones;
+      }
+      else
+      {
+        moveStatistics.stonesPlayedByWhite++;
+        moveStatistics.capturedByWhite += numberOfCapturedStones;
+      }
+    }
+    else if (GoMoveTypePass == move.type)
+    {
+      if (moveByBlack)
+        moveStatistics.passesPlayedByBlack++;
+      else
+        moveStatistics.passesPlayedByWhite++;
+    }
+  }
+  return moveStatistics;
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Returns the number of board positions of @a game for which the
+/// statistics returned by GoMoveModel differ from the statistics obtained by
+/// walking the move list.
+// -----------------------------------------------------------------------------
+static int numberOfMoveStatisticsMismatches(GoGame* game)
+{
+  int numberOfMismatches = 0;
+  GoMoveModel* moveModel = game.moveModel;
+  for (int numberOfMoves = 0; numberOfMoves <= moveModel.numberOfMoves; ++numberOfMoves)
+  {
+    struct GoMoveStatistics expected = statisticsOfFirstMovesByWalking(moveModel, numberOfMoves);
+    struct GoMoveStatistics actual = [moveModel statisticsOfFirstMoves:numberOfMoves];
+    if (expected.stonesPlayedByBlack != actual.stonesPlayedByBlack
+        || expected.stonesPlayedByWhite != actual.stonesPlayedByWhite
+        || expected.passesPlayedByBlack != actual.passesPlayedByBlack
+        || expected.passesPlayedByWhite != actual.passesPlayedByWhite
+        || expected.capturedByBlack != actual.capturedByBlack
+        || expected.capturedByWhite != actual.capturedByWhite)
+    {
+      ++numberOfMismatches;
+    }
+  }
+  return numberOfMismatches;
+}
+
+
+@implementation GoGamePerformanceTest
+
+// -----------------------------------------------------------------------------
+/// @brief Checks that the generated game is the same every time, and that
+/// replaying it from the list of moves results in the same board.
+// -----------------------------------------------------------------------------
+- (void) testReplayIsDeterministic
+{
+  std::vector<int> moves = playGeneratedGame(m_game, numberOfMovesInBenchmark);
+  XCTAssertEqual(m_game.moveModel.numberOfMoves, numberOfMovesInBenchmark);
+  GoBoard* board = m_game.board;
+  int numberOfIntersections = board.size * board.size;
+  std::vector<enum GoColor> stoneStates;
+  for (int index = 0; index < numberOfIntersections; ++index)
+    stoneStates.push_back([board stoneStateAtIndex:index]);
+
+  [[[[NewGameCommand alloc] init] autorelease] submit];
+  m_game = m_delegate.game;
+  XCTAssertTrue(moves == playGeneratedGame(m_game, numberOfMovesInBenchmark));
+  for (int index = 0; index < numberOfIntersections; ++index)
+    XCTAssertEqual(stoneStates[index], [m_game.board stoneStateAtIndex:index]);
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Measures how long it takes to play all moves of the game, including
+/// the legality check that GoGame::play:() performs for each move.
+// -----------------------------------------------------------------------------
+- (void) testPerformancePlay
+{
+  std::vector<int> moves = playGeneratedGame(m_game, numberOfMovesInBenchmark);
+  [self measureMetrics:[[self class] defaultPerformanceMetrics] automaticallyStartMeasuring:NO forBlock:^{
+    [[[[NewGameCommand alloc] init] autorelease] submit];
+    GoGame* game = m_delegate.game;
+    GoBoard* board = game.board;
+    [self startMeasuring];
+    for (int index : moves)
+      [game play:[board pointAtIndex:index]];
+    [self stopMeasuring];
+    XCTAssertEqual(game.moveModel.numberOfMoves, numberOfMovesInBenchmark);
+  }];
+  m_game = m_delegate.game;
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Measures how long it takes to undo all moves of the game, then to
+/// redo them again, by navigating to the first and then to the last board
+/// position.
+// -----------------------------------------------------------------------------
+- (void) testPerformanceUndoAndRedo
+{
+  playGeneratedGame(m_game, numberOfMovesInBenchmark);
+  GoBoardPosition* boardPosition = m_game.boardPosition;
+  [self measureBlock:^{
+    boardPosition.currentBoardPosition = 0;
+    boardPosition.currentBoardPosition = numberOfMovesInBenchmark;
+  }];
+  XCTAssertTrue(boardPosition.isLastPosition);
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Measures how long it takes to check the legality of a move on every
+/// intersection, in the last board position of the game.
+// -----------------------------------------------------------------------------
+- (void) testPerformanceIsLegalMove
+{
+  playGeneratedGame(m_game, numberOfMovesInBenchmark);
+  GoBoard* board = m_game.board;
+  int numberOfIntersections = board.size * board.size;
+  [self measureBlock:^{
+    int numberOfLegalMoves = 0;
+    enum GoMoveIsIllegalReason illegalReason;
+    for (int iteration = 0; iteration < 20; ++iteration)
+    {
+      for (int index = 0; index < numberOfIntersections; ++index)
+      {
+        if ([m_game isLegalMove:[board pointAtIndex:index] isIllegalReason:&illegalReason])
+          ++numberOfLegalMoves;
+      }
+    }
+    XCTAssertGreaterThan(numberOfLegalMoves, 0);
+  }];
+}
+
+
+// -----------------------------------------------------------------------------
+/// @brief Measures how long it takes to check the legality of a move on every
+/// intersection, in the last board position of a long game with repeated ko
+/// fights. The game uses positional superko, so every check has to compare
+/// the hypothetical board position against all earlier board positions.
+// -----------------------------------------------------------------------------
+- (void) testPerformanceIsLegalMoveWithKoFights
+{
+  m_delegate.theNewGameModel.koRule = GoKoRuleSuperkoPositional;
+  [[[[NewGameCommand alloc] init] autorelease] submit];
+  m_game = m_delegate.game;
+  XCTAssertEqual(playGameWithKoFights(m_game), numberOfMovesInKoFightBenchmark);
+  GoBoard* board = m_game.board;
+  int numberOfIntersections = board.size * board.size;
+  [self measureBlock:^{
+    int numberOfLegalMoves = 0;
+    enum GoMoveIsIllegalReason illegalReason;
+    for (int iteration = 0; iteration < 20; ++iteration)
+    {
+      for (int index = 0; index < numberOfIntersections; ++index)
+      {
+        if ([m_game isLegalMove:[board pointAtIndex:index] isIllegalReason:&illegalReason])
+          ++numberOfLegalMoves;
+      }
+    }
+    XCTAssertGreaterThan(numberOfLegalMoves, 0);
+  }];
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Checks ko detection in a game with repeated ko fights after
+/// navigating back to earlier board positions.
+// -----------------------------------------------------------------------------
+- (void) testKoFightsAfterNavigation
+{
+  m_delegate.theNewGameModel.koRule = GoKoRuleSuperkoPositional;
+  [[[[NewGameCommand alloc] init] autorelease] submit];
+  m_game = m_delegate.game;
+  XCTAssertEqual(playGameWithKoFights(m_game), numberOfMovesInKoFightBenchmark);
+  GoBoardPosition* boardPosition = m_game.boardPosition;
+  GoPoint* whiteKoPoint = [m_game.board pointAtVertex:@"B1"];
+  GoPoint* blackKoPoint = [m_game.board pointAtVertex:@"C1"];
+  enum GoMoveIsIllegalReason illegalReason;
+
+  // White has just taken the ko in the first round
+  boardPosition.currentBoardPosition = 6;
+  XCTAssertFalse([m_game isLegalMove:blackKoPoint isIllegalReason:&illegalReason]);
+  XCTAssertEqual(illegalReason, GoMoveIsIllegalReasonSimpleKo);
+  // White has answered Black's ko threat
+  boardPosition.currentBoardPosition = 8;
+  XCTAssertTrue([m_game isLegalMove:blackKoPoint isIllegalReason:&illegalReason]);
+  // Black has just taken back the ko
+  boardPosition.currentBoardPosition = 9;
+  XCTAssertFalse([m_game isLegalMove:whiteKoPoint isIllegalReason:&illegalReason]);
+  XCTAssertEqual(illegalReason, GoMoveIsIllegalReasonSimpleKo);
+  // Black has answered White's last ko threat
+  boardPosition.currentBoardPosition = numberOfMovesInKoFightBenchmark;
+  XCTAssertTrue([m_game isLegalMove:whiteKoPoint isIllegalReason:&illegalReason]);
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Checks that the legal move map agrees with
+/// GoGame::isLegalMove:byColor:isIllegalReason:() in every board position of
+/// the generated game and of the game with ko fights, for all ko rules.
+// -----------------------------------------------------------------------------
+- (void) testLegalMoveMap
+{
+  GoBoardPosition* boardPosition = m_game.boardPosition;
+  playGeneratedGame(m_game, numberOfMovesInBenchmark);
+  for (int position = 0; position <= numberOfMovesInBenchmark; position += 10)
+  {
+    boardPosition.currentBoardPosition = position;
+    XCTAssertEqual(numberOfLegalMoveMapMismatches(m_game), 0, @"board position %d", position);
+  }
+
+  for (NSNumber* koRule in @[@(GoKoRuleSimple), @(GoKoRuleSuperkoPositional), @(GoKoRuleSuperkoSituational)])
+  {
+    m_delegate.theNewGameModel.koRule = (enum GoKoRule)koRule.intValue;
+    [[[[NewGameCommand alloc] init] autorelease] submit];
+    m_game = m_delegate.game;
+    XCTAssertEqual(playGameWithKoFights(m_game), numberOfMovesInKoFightBenchmark);
+    boardPosition = m_game.boardPosition;
+    // Navigate backwards so that the maps are generated in board positions
+    // that are not the last board position
+    for (int position = numberOfMovesInKoFightBenchmark; position >= 0; --position)
+    {
+      boardPosition.currentBoardPosition = position;
+      XCTAssertEqual(numberOfLegalMoveMapMismatches(m_game), 0, @"ko rule %@, board position %d", koRule, position);
+    }
+  }
+
+  // The map is cached until the board position changes
+  GoLegalMoveMap* legalMoveMap = [m_game legalMoveMapForColor:GoColorBlack];
+  XCTAssertEqual(legalMoveMap, [m_game legalMoveMapForColor:GoColorBlack]);
+  GoPoint* point = [m_game.board pointAtVertex:@"T1"];
+  enum GoMoveIsIllegalReason illegalReason;
+  XCTAssertTrue([legalMoveMap isLegalMoveAtIndex:point.index isIllegalReason:&illegalReason]);
+  [m_game play:point];
+  XCTAssertNotEqual(legalMoveMap, [m_game legalMoveMapForColor:GoColorBlack]);
+  XCTAssertFalse([[m_game legalMoveMapForColor:GoColorBlack] isLegalMoveAtIndex:point.index isIllegalReason:&illegalReason]);
+  XCTAssertEqual(illegalReason, GoMoveIsIllegalReasonIntersectionOccupied);
+  XCTAssertThrowsSpecificNamed([m_game legalMoveMapForColor:GoColorNone],
+                               NSException, NSInvalidArgumentException, @"invalid color");
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Measures how long it takes to generate the legal move map and check
+/// the legality of a move on every intersection, in the last board positions
+/// of the game with repeated ko fights. The result can be compared with
+/// testPerformanceIsLegalMoveWithKoFights().
+// -----------------------------------------------------------------------------
+- (void) testPerformanceLegalMoveMap
+{
+  m_delegate.theNewGameModel.koRule = GoKoRuleSuperkoPositional;
+  [[[[NewGameCommand alloc] init] autorelease] submit];
+  m_game = m_delegate.game;
+  XCTAssertEqual(playGameWithKoFights(m_game), numberOfMovesInKoFightBenchmark);
+  GoBoardPosition* boardPosition = m_game.boardPosition;
+  int numberOfIntersections = m_game.board.size * m_game.board.size;
+  [self measureBlock:^{
+    int numberOfLegalMoves = 0;
+    enum GoMoveIsIllegalReason illegalReason;
+    for (int iteration = 0; iteration < 20; ++iteration)
+    {
+      // Alternate between two board positions so that every iteration has to
+      // generate a new map
+      boardPosition.currentBoardPosition = numberOfMovesInKoFightBenchmark - (iteration % 2);
+      GoLegalMoveMap* legalMoveMap = [m_game legalMoveMapForColor:m_game.nextMoveColor];
+      for (int index = 0; index < numberOfIntersections; ++index)
+      {
+        if ([legalMoveMap isLegalMoveAtIndex:index isIllegalReason:&illegalReason])
+          ++numberOfLegalMoves;
+      }
+    }
+    XCTAssertGreaterThan(numberOfLegalMoves, 0);
+  }];
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Checks that jumping to random board positions, which restores
+/// checkpoints, results in the same board as stepping through the game one
+/// board position at a time. Also checks that checkpoints are discarded
+/// together with the moves they belong to.
+// -----------------------------------------------------------------------------
+- (void) testRandomAccessNavigation
+{
+  playGeneratedGame(m_game, numberOfMovesInBenchmark);
+  GoBoardPosition* boardPosition = m_game.boardPosition;
+  std::vector<std::vector<enum GoColor>> expectedStoneStates = stoneStatesOfAllBoardPositions(m_game);
+  std::mt19937 randomNumberGenerator(42);
+  for (int jump = 0; jump < 200; ++jump)
+  {
+    int position = randomNumberGenerator() % boardPosition.numberOfBoardPositions;
+    boardPosition.currentBoardPosition = position;
+    XCTAssertTrue(expectedStoneStates[position] == stoneStatesOfBoard(m_game.board), @"board position %d", position);
+    XCTAssertTrue(hasConsistentRegions(m_game.board), @"board position %d", position);
+  }
+
+  // Replace the second half of the game with different moves. Checkpoints
+  // taken for the discarded moves must not be restored.
+  int numberOfMovesToKeep = numberOfMovesInBenchmark / 2;
+  boardPosition.currentBoardPosition = numberOfMovesToKeep;
+  [m_game.moveModel discardMovesFromIndex:numberOfMovesToKeep];
+  [m_game pass];
+  playGeneratedGame(m_game, numberOfMovesInBenchmark - numberOfMovesToKeep - 1);
+  XCTAssertEqual(m_game.moveModel.numberOfMoves, numberOfMovesInBenchmark);
+  expectedStoneStates = stoneStatesOfAllBoardPositions(m_game);
+  for (int jump = 0; jump < 200; ++jump)
+  {
+    int position = randomNumberGenerator() % boardPosition.numberOfBoardPositions;
+    boardPosition.currentBoardPosition = position;
+    XCTAssertTrue(expectedStoneStates[position] == stoneStatesOfBoard(m_game.board), @"board position %d", position);
+    XCTAssertTrue(hasConsistentRegions(m_game.board), @"board position %d", position);
+  }
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Measures how long it takes to jump to random board positions in the
+/// game with repeated ko fights.
+// -----------------------------------------------------------------------------
+- (void) testPerformanceRandomAccessNavigation
+{
+  m_delegate.theNewGameModel.koRule = GoKoRuleSuperkoPositional;
+  [[[[NewGameCommand alloc] init] autorelease] submit];
+  m_game = m_delegate.game;
+  XCTAssertEqual(playGameWithKoFights(m_game), numberOfMovesInKoFightBenchmark);
+  // The checkpoints were taken while the game was played
+  GoBoardPosition* boardPosition = m_game.boardPosition;
+  [self measureBlock:^{
+    std::mt19937 randomNumberGenerator(42);
+    for (int jump = 0; jump < 100; ++jump)
+      boardPosition.currentBoardPosition = randomNumberGenerator() % (numberOfMovesInKoFightBenchmark + 1);
+  }];
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Checks that the move statistics kept by GoMoveModel, and the score
+/// calculated from them, are the same as the result of walking the move list
+/// of a long game. Also checks that the statistics follow when moves are
+/// discarded.
+// -----------------------------------------------------------------------------
+- (void) testMoveStatistics
+{
+  playGeneratedGame(m_game, numberOfMovesInLongGameBenchmark);
+  GoMoveModel* moveModel = m_game.moveModel;
+  XCTAssertEqual(0, numberOfMoveStatisticsMismatches(m_game));
+
+  GoBoardPosition* boardPosition = m_game.boardPosition;
+  GoScore* score = m_game.score;
+  for (int position = 0; position <= numberOfMovesInLongGameBenchmark; position += 50)
+  {
+    boardPosition.currentBoardPosition = position;
+    [score calculateWaitUntilDone:true];
+    struct GoMoveStatistics expectedBoardPosition = statisticsOfFirstMovesByWalking(moveModel, position);
+    struct GoMoveStatistics expectedGame = statisticsOfFirstMovesByWalking(moveModel, moveModel.numberOfMoves);
+    XCTAssertEqual(expectedBoardPosition.capturedByBlack, score.capturedByBlack, @"board position %d", position);
+    XCTAssertEqual(expectedBoardPosition.capturedByWhite, score.capturedByWhite, @"board position %d", position);
+    XCTAssertEqual(moveModel.numberOfMoves, score.numberOfMoves);
+    XCTAssertEqual(expectedGame.stonesPlayedByBlack, score.stonesPlayedByBlack);
+    XCTAssertEqual(expectedGame.stonesPlayedByWhite, score.stonesPlayedByWhite);
+  }
+  XCTAssertTrue(score.capturedByBlack + score.capturedByWhite > 0);
+
+  // Replace the last moves with a pass
+  int numberOfMovesToKeep = numberOfMovesInLongGameBenchmark - 100;
+  boardPosition.currentBoardPosition = numberOfMovesToKeep;
+  [moveModel discardMovesFromIndex:numberOfMovesToKeep];
+  [m_game pass];
+  XCTAssertEqual(numberOfMovesToKeep + 1, moveModel.numberOfMoves);
+  XCTAssertEqual(0, numberOfMoveStatisticsMismatches(m_game));
+  [score calculateWaitUntilDone:true];
+  XCTAssertEqual(1, score.passesPlayedByBlack + score.passesPlayedByWhite);
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Measures how long it takes to refresh the score at the end of a long
+/// game.
+// -----------------------------------------------------------------------------
+- (void) testPerformanceScoreRefresh
+{
+  playGeneratedGame(m_game, numberOfMovesInLongGameBenchmark);
+  GoScore* score = m_game.score;
+  [self measureBlock:^{
+    for (int refresh = 0; refresh < 1000; ++refresh)
+      [score calculateWaitUntilDone:true];
+  }];
+}
+
+@end
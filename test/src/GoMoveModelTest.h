@@ -36,5 +36,6 @@
 - (void) testNumberOfMoves;
 - (void) testFirstMove;
 - (void) testLastMove;
+- (void) testHasMoveBeforeIndex;
 
 @end
@@ -223,4 +223,50 @@
   XCTAssertNil(moveModel.firstMove);
 }
 
+// -----------------------------------------------------------------------------
+/// @brief Exercises the hasMoveBeforeIndex:withZobristHash:() and
+/// hasMoveBeforeIndex:withZobristHash:playedByColor:() methods.
+// -----------------------------------------------------------------------------
+- (void) testHasMoveBeforeIndex
+{
+  GoMoveModel* moveModel = m_game.moveModel;
+  GoMove* move1 = [GoMove move:GoMoveTypePass by:m_game.playerBlack after:nil];
+  GoMove* move2 = [GoMove move:GoMoveTypePass by:m_game.playerWhite after:move1];
+  GoMove* move3 = [GoMove move:GoMoveTypePass by:m_game.playerBlack after:move2];
+  move1.zobristHash = 11;
+  move2.zobristHash = 22;
+  move3.zobristHash = 11;
+  [moveModel appendMove:move1];
+  [moveModel appendMove:move2];
+  [moveModel appendMove:move3];
+
+  XCTAssertFalse([moveModel hasMoveBeforeIndex:0 withZobristHash:11]);
+  XCTAssertTrue([moveModel hasMoveBeforeIndex:1 withZobristHash:11]);
+  XCTAssertFalse([moveModel hasMoveBeforeIndex:1 withZobristHash:22]);
+  XCTAssertTrue([moveModel hasMoveBeforeIndex:2 withZobristHash:22]);
+  XCTAssertFalse([moveModel hasMoveBeforeIndex:3 withZobristHash:33]);
+  XCTAssertTrue([moveModel hasMoveBeforeIndex:3 withZobristHash:11 playedByColor:GoColorBlack]);
+  XCTAssertFalse([moveModel hasMoveBeforeIndex:3 withZobristHash:11 playedByColor:GoColorWhite]);
+  XCTAssertTrue([moveModel hasMoveBeforeIndex:3 withZobristHash:22 playedByColor:GoColorWhite]);
+  XCTAssertFalse([moveModel hasMoveBeforeIndex:3 withZobristHash:22 playedByColor:GoColorNone]);
+
+  // Discarding the last move must not remove the entry of the first move with
+  // the same hash
+  [moveModel discardLastMove];
+  XCTAssertTrue([moveModel hasMoveBeforeIndex:1 withZobristHash:11]);
+  [moveModel discardMovesFromIndex:1];
+  XCTAssertFalse([moveModel hasMoveBeforeIndex:3 withZobristHash:22]);
+  [moveModel discardLastMove];
+  XCTAssertFalse([moveModel hasMoveBeforeIndex:3 withZobristHash:11]);
+
+  // Hashes that change after a move was appended are picked up only after the
+  // index has been rebuilt
+  [moveModel appendMove:move1];
+  move1.zobristHash = 44;
+  XCTAssertFalse([moveModel hasMoveBeforeIndex:1 withZobristHash:44]);
+  [moveModel rebuildZobristHashIndex];
+  XCTAssertTrue([moveModel hasMoveBeforeIndex:1 withZobristHash:44]);
+  XCTAssertFalse([moveModel hasMoveBeforeIndex:1 withZobristHash:11]);
+}
+
 @end
@@ -32,6 +32,7 @@
 - (void) testCapturedStones;
 - (void) testDoIt;
 - (void) testUndo;
+- (void) testUndoRestoresRegions;
 - (void) testMoveNumber;
 - (void) testZobristHash;
 
@@ -20,6 +20,7 @@
 
 // Application includes
 #import <go/GoBoard.h>
+#import <go/GoBoardRegion.h>
 #import <go/GoGame.h>
 #import <go/GoMove.h>
 #import <go/GoPlayer.h>
@@ -375,6 +376,76 @@
   [move6 undo];
 }
 
+// -----------------------------------------------------------------------------
+/// @brief Checks that undo() restores the GoBoardRegion objects that existed
+/// before doIt() was invoked, both when doIt() joined stone groups and when it
+/// split an empty area.
+// -----------------------------------------------------------------------------
+- (void) testUndoRestoresRegions
+{
+  GoBoard* board = m_game.board;
+  GoPoint* pointA1 = [board pointAtVertex:@"A1"];
+  GoPoint* pointA2 = [board pointAtVertex:@"A2"];
+  GoPoint* pointB1 = [board pointAtVertex:@"B1"];
+  GoPoint* pointC1 = [board pointAtVertex:@"C1"];
+  GoPoint* pointC3 = [board pointAtVertex:@"C3"];
+  GoPoint* pointE3 = [board pointAtVertex:@"E3"];
+  GoPoint* pointD3 = [board pointAtVertex:@"D3"];
+  GoBoardRegion* mainRegion = pointA1.region;
+  int expectedMainRegionSize = 19 * 19;
+
+  // Join two stone groups
+  GoMove* move1 = [GoMove move:GoMoveTypePlay by:m_game.playerBlack after:nil];
+  move1.point = pointC3;
+  [move1 doIt];
+  GoMove* move2 = [GoMove move:GoMoveTypePlay by:m_game.playerBlack after:move1];
+  move2.point = pointE3;
+  [move2 doIt];
+  GoBoardRegion* regionC3 = pointC3.region;
+  GoBoardRegion* regionE3 = pointE3.region;
+  XCTAssertTrue(regionC3 != regionE3);
+  GoMove* move3 = [GoMove move:GoMoveTypePlay by:m_game.playerBlack after:move2];
+  move3.point = pointD3;
+  [move3 doIt];
+  XCTAssertEqual(pointC3.region, pointD3.region);
+  XCTAssertEqual(pointE3.region, pointD3.region);
+  XCTAssertEqual(3, [pointD3.region size]);
+  [move3 undo];
+  XCTAssertEqual(regionC3, pointC3.region);
+  XCTAssertEqual(regionE3, pointE3.region);
+  XCTAssertEqual(mainRegion, pointD3.region);
+  XCTAssertEqual(1, [regionC3 size]);
+  XCTAssertEqual(1, [regionE3 size]);
+  XCTAssertEqual(expectedMainRegionSize - 2, [mainRegion size]);
+
+  // Split off A1 from the main region
+  GoMove* move4 = [GoMove move:GoMoveTypePlay by:m_game.playerWhite after:move2];
+  move4.point = pointA2;
+  [move4 doIt];
+  GoMove* move5 = [GoMove move:GoMoveTypePlay by:m_game.playerWhite after:move4];
+  move5.point = pointB1;
+  [move5 doIt];
+  XCTAssertTrue(pointA1.region != mainRegion);
+  XCTAssertEqual(1, [pointA1.region size]);
+  XCTAssertEqual(mainRegion, pointC1.region);
+  XCTAssertEqual(expectedMainRegionSize - 5, [mainRegion size]);
+  [move5 undo];
+  XCTAssertEqual(mainRegion, pointA1.region);
+  XCTAssertEqual(mainRegion, pointB1.region);
+  XCTAssertEqual(expectedMainRegionSize - 3, [mainRegion size]);
+
+  // Redo and undo again: doIt() records a new journal each time
+  [move5 doIt];
+  XCTAssertTrue(pointA1.region != mainRegion);
+  [move5 undo];
+  [move4 undo];
+  [move2 undo];
+  [move1 undo];
+  NSUInteger expectedNumberOfRegions = 1;
+  XCTAssertEqual(expectedNumberOfRegions, board.regions.count);
+  XCTAssertEqual(expectedMainRegionSize, [mainRegion size]);
+}
+
 // -----------------------------------------------------------------------------
 /// @brief Exercises the @e moveNumber property
 // -----------------------------------------------------------------------------
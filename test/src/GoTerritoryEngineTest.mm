@@ -0,0 +1,200 @@
+// -----------------------------------------------------------------------------
+// Copyright 2026 Patrick Näf (herzbube@herzbube.ch)
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// -----------------------------------------------------------------------------
+
+
+// Test includes
+#import "GoTerritoryEngineTest.h"
+
+// Application includes
+#import <go/GoBoardCore.h>
+#import <go/GoTerritoryEngine.h>
+
+// C++ standard library
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+
+/// @brief The board size used by the functional tests.
+static const int boardSize = 7;
+
+
+// -----------------------------------------------------------------------------
+/// @brief Returns the board index of the intersection at the 1-based
+/// coordinates @a x and @a y on the board used by the functional tests.
+// -----------------------------------------------------------------------------
+static int boardIndex(int x, int y)
+{
+  return (y - 1) * boardSize + (x - 1);
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Sets up @a core with a black wall on column 3 and a white wall on
+/// column 5. This divides the board into three areas of empty intersections:
+/// Columns 1-2, column 4 and columns 6-7.
+// -----------------------------------------------------------------------------
+static void setupWalls(GoBoardCore& core)
+{
+  for (int y = 1; y <= boardSize; ++y)
+  {
+    core.setColorAt(boardIndex(3, y), GoBoardCore::ColorBlack);
+    core.setColorAt(boardIndex(5, y), GoBoardCore::ColorWhite);
+  }
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Returns the positions of the stone group that the stone on the
+/// intersection at the 1-based coordinates @a x and @a y belongs to.
+// -----------------------------------------------------------------------------
+static GoBoardCore::Bitboard groupAt(const GoBoardCore& core, int x, int y)
+{
+  return core.groupAt(boardIndex(x, y));
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Returns the area in @a emptyAreas that contains the intersection at
+/// the 1-based coordinates @a x and @a y. Throws std::out_of_range if no area
+/// contains the intersection.
+// -----------------------------------------------------------------------------
+static const GoTerritoryEngine::EmptyArea& areaAt(const std::vector<GoTerritoryEngine::EmptyArea>& emptyAreas, const GoBoardCore& core, int x, int y)
+{
+  int position = core.positionOfBoardIndex(boardIndex(x, y));
+  for (const GoTerritoryEngine::EmptyArea& emptyArea : emptyAreas)
+  {
+    if (emptyArea.positions.test(position))
+      return emptyArea;
+  }
+  throw std::out_of_range("No area contains the intersection");
+}
+
+
+@implementation GoTerritoryEngineTest
+
+// -----------------------------------------------------------------------------
+/// @brief Checks that an empty board consists of a single neutral area.
+// -----------------------------------------------------------------------------
+- (void) testEmptyBoard
+{
+  GoBoardCore core(boardSize);
+  GoTerritoryEngine territoryEngine(core);
+  std::vector<GoTerritoryEngine::EmptyArea> emptyAreas = territoryEngine.analyzeTerritory(GoTerritoryEngine::AreaScoring);
+  XCTAssertEqual(static_cast<size_t>(1), emptyAreas.size());
+  XCTAssertEqual(boardSize * boardSize, emptyAreas[0].positions.count());
+  XCTAssertEqual(GoBoardCore::ColorNone, emptyAreas[0].territoryColor);
+  XCTAssertFalse(emptyAreas[0].territoryInconsistencyFound);
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Checks that areas surrounded by alive stones of one color are
+/// territory, and that areas between alive stones of both colors are dame.
+// -----------------------------------------------------------------------------
+- (void) testTerritoryAndDame
+{
+  GoBoardCore core(boardSize);
+  setupWalls(core);
+  GoTerritoryEngine territoryEngine(core);
+  std::vector<GoTerritoryEngine::EmptyArea> emptyAreas = territoryEngine.analyzeTerritory(GoTerritoryEngine::TerritoryScoring);
+  XCTAssertEqual(static_cast<size_t>(3), emptyAreas.size());
+
+  const GoTerritoryEngine::EmptyArea& blackArea = areaAt(emptyAreas, core, 1, 1);
+  XCTAssertEqual(2 * boardSize, blackArea.positions.count());
+  XCTAssertEqual(GoBoardCore::ColorBlack, blackArea.territoryColor);
+  XCTAssertFalse(blackArea.territoryInconsistencyFound);
+  const GoTerritoryEngine::EmptyArea& dameArea = areaAt(emptyAreas, core, 4, 1);
+  XCTAssertEqual(boardSize, dameArea.positions.count());
+  XCTAssertEqual(GoBoardCore::ColorNone, dameArea.territoryColor);
+  XCTAssertFalse(dameArea.territoryInconsistencyFound);
+  const GoTerritoryEngine::EmptyArea& whiteArea = areaAt(emptyAreas, core, 7, 7);
+  XCTAssertEqual(GoBoardCore::ColorWhite, whiteArea.territoryColor);
+  XCTAssertFalse(whiteArea.territoryInconsistencyFound);
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Checks that areas next to dead stones belong to the opposing color,
+/// and that dead stones of both colors result in an inconsistency.
+// -----------------------------------------------------------------------------
+- (void) testDeadStones
+{
+  GoBoardCore core(boardSize);
+  setupWalls(core);
+  core.setColorAt(boardIndex(1, 1), GoBoardCore::ColorWhite);
+  GoTerritoryEngine territoryEngine(core);
+  territoryEngine.setDeadStones(groupAt(core, 1, 1));
+  std::vector<GoTerritoryEngine::EmptyArea> emptyAreas = territoryEngine.analyzeTerritory(GoTerritoryEngine::TerritoryScoring);
+  XCTAssertEqual(GoBoardCore::ColorBlack, areaAt(emptyAreas, core, 2, 2).territoryColor);
+  XCTAssertFalse(areaAt(emptyAreas, core, 2, 2).territoryInconsistencyFound);
+
+  // The black wall is now also dead. Dead stones of both colors contradict
+  // each other, but the dame area now belongs to White.
+  territoryEngine.setDeadStones(groupAt(core, 1, 1) | groupAt(core, 3, 1));
+  emptyAreas = territoryEngine.analyzeTerritory(GoTerritoryEngine::TerritoryScoring);
+  XCTAssertEqual(GoBoardCore::ColorNone, areaAt(emptyAreas, core, 2, 2).territoryColor);
+  XCTAssertTrue(areaAt(emptyAreas, core, 2, 2).territoryInconsistencyFound);
+  XCTAssertEqual(GoBoardCore::ColorWhite, areaAt(emptyAreas, core, 4, 1).territoryColor);
+  XCTAssertFalse(areaAt(emptyAreas, core, 4, 1).territoryInconsistencyFound);
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Checks that the scoring system decides whether areas surrounded by
+/// stones in seki are territory, and that seki stones next to alive stones of
+/// the other color result in an inconsistency.
+// -----------------------------------------------------------------------------
+- (void) testSekiStones
+{
+  GoBoardCore core(boardSize);
+  setupWalls(core);
+  GoTerritoryEngine territoryEngine(core);
+  territoryEngine.setSekiStones(groupAt(core, 3, 1));
+
+  std::vector<GoTerritoryEngine::EmptyArea> emptyAreas = territoryEngine.analyzeTerritory(GoTerritoryEngine::AreaScoring);
+  XCTAssertEqual(GoBoardCore::ColorBlack, areaAt(emptyAreas, core, 1, 1).territoryColor);
+  XCTAssertTrue(areaAt(emptyAreas, core, 4, 1).territoryInconsistencyFound);
+
+  emptyAreas = territoryEngine.analyzeTerritory(GoTerritoryEngine::TerritoryScoring);
+  XCTAssertEqual(GoBoardCore::ColorNone, areaAt(emptyAreas, core, 1, 1).territoryColor);
+  XCTAssertFalse(areaAt(emptyAreas, core, 1, 1).territoryInconsistencyFound);
+  XCTAssertTrue(areaAt(emptyAreas, core, 4, 1).territoryInconsistencyFound);
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Measures how long it takes to analyze the territory of a 19x19
+/// board that is covered with many small stone groups and areas, some of which
+/// are dead.
+// -----------------------------------------------------------------------------
+- (void) testPerformanceAnalyzeTerritory
+{
+  GoBoardCore core(GoBoardCore::maximumBoardSize);
+  GoBoardCore::Bitboard deadStones;
+  std::mt19937 randomNumberGenerator(23);
+  for (int index = 0; index < core.numberOfIntersections(); ++index)
+  {
+    unsigned int value = randomNumberGenerator() % 10;
+    if (value < 4)
+      core.setColorAt(index, GoBoardCore::ColorBlack);
+    else if (value < 8)
+      core.setColorAt(index, GoBoardCore::ColorWhite);
+    if (0 == value || 4 == value)
+      deadStones.set(core.positionOfBoardIndex(index));
+  }
+  GoTerritoryEngine territoryEngine(core);
+  territoryEngine.setDeadStones(deadStones);
+  [self measureBlock:^{
+    for (int iteration = 0; iteration < 1000; ++iteration)
+      territoryEngine.analyzeTerritory(GoTerritoryEngine::TerritoryScoring);
+  }];
+}
+
+@end
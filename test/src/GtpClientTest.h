@@ -0,0 +1,45 @@
+// -----------------------------------------------------------------------------
+// Copyright 2026 Patrick Näf (herzbube@herzbube.ch)
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// -----------------------------------------------------------------------------
+
+
+// Project includes
+#import "BaseTestCase.h"
+
+
+// -----------------------------------------------------------------------------
+/// @brief The GtpClientTest class contains unit tests that exercise the
+/// command scheduler and the pipelined command submission of GtpClient.
+///
+/// The tests do not use Fuego. Instead the GtpClient talks to a stand-in
+/// engine that can be interrupted while it "searches", and that can be told
+/// to respond out of order or without command ID.
+// -----------------------------------------------------------------------------
+@interface GtpClientTest : BaseTestCase
+{
+}
+
+- (void) testPipelinedBatchLargerThanCommandsInFlight;
+- (void) testPipelinedResponsesAreMatchedByCommandID;
+- (void) testPipelinedResponseWithoutCommandID;
+- (void) testPipelinedBatchWithQuit;
+- (void) testPipelinedBatchSkipsCancelledCommand;
+- (void) testPreemptionRollsBackAddedMove;
+- (void) testPreemptionWithoutRollbackAfterResignation;
+- (void) testPreemptedCommandIsCancelledIfPositionHasChanged;
+- (void) testOrderingBarrier;
+- (void) testLaneStatistics;
+
+@end
@@ -0,0 +1,543 @@
+// -----------------------------------------------------------------------------
+// Copyright 2026 Patrick Näf (herzbube@herzbube.ch)
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// -----------------------------------------------------------------------------
+
+
+// Test includes
+#import "GtpClientTest.h"
+
+// Application includes
+#import <gtp/GtpClient.h>
+#import <gtp/GtpCommand.h>
+#import <gtp/GtpEngine.h>
+#import <gtp/GtpEnginePool.h>
+#import <gtp/GtpFuture.h>
+#import <gtp/GtpResponse.h>
+
+// C++ standard library
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+
+// Number of milliseconds that the scheduler test engine searches when it
+// processes "genmove" and is not interrupted
+static const int searchTimeInMilliseconds = 500;
+
+// The commands (without command ID) that the scheduler test engine has
+// processed, in the order in which it processed them
+static std::vector<std::string> schedulerTestEngineLog;
+// The number of searches that the scheduler test engine has started
+static int schedulerTestEngineNumberOfSearches = 0;
+// Guards the state of the scheduler test engine that is shared with the tests
+static std::mutex schedulerTestEngineMutex;
+// Is notified whenever the scheduler test engine starts a search
+static std::condition_variable schedulerTestEngineSearchCondition;
+
+
+// -----------------------------------------------------------------------------
+/// @brief Main function of a stand-in GTP engine that is used to test
+/// GtpClient's scheduler and pipelining. Like Fuego, the engine reads commands
+/// in a separate thread while it processes a command, so that it notices
+/// "# interrupt".
+///
+/// The engine understands the following commands:
+/// - "genmove <color>": Searches for #searchTimeInMilliseconds milliseconds
+///   or until it is interrupted, whichever comes first. Like Fuego, the engine
+///   forgets an interrupt that arrived before the search started. Responds
+///   with "D4" for black and "resign" for white.
+/// - "echo <text>": Responds with @e text.
+/// - "delay <text>": Responds with @e text, but only after it has responded
+///   to the next command.
+/// - "no_id <text>": Responds with @e text, but without command ID.
+/// - "wrong_id <text>": Responds with @e text, but with a command ID that
+///   GtpClient has not used.
+/// - "quit": Responds, then stops reading commands.
+/// Responds to every other command with an empty success response.
+///
+/// Every command is appended to #schedulerTestEngineLog before it is
+/// processed.
+// -----------------------------------------------------------------------------
+static void schedulerTestEngineMain(std::istream& commandStream, std::ostream& responseStream)
+{
+  std::mutex queueMutex;
+  std::condition_variable queueCondition;
+  std::deque<std::string> queue;
+  bool readerHasFinished = false;
+  std::atomic<bool> interruptWasReceived(false);
+
+  std::thread readerThread([&]()
+  {
+    std::string line;
+    while (std::getline(commandStream, line))
+    {
+      if ("# interrupt" == line)
+      {
+        interruptWasReceived = true;
+        continue;
+      }
+      std::lock_guard<std::mutex> lock(queueMutex);
+      queue.push_back(line);
+      queueCondition.notify_one();
+      std::string commandID;
+      std::string commandName;
+      std::istringstream(line) >> commandID >> commandName;
+      if ("quit" == commandName)
+        break;
+    }
+    std::lock_guard<std::mutex> lock(queueMutex);
+    readerHasFinished = true;
+    queueCondition.notify_one();
+  });
+
+  std::string deferredResponse;
+  while (true)
+  {
+    std::string line;
+    {
+      std::unique_lock<std::mutex> lock(queueMutex);
+      queueCondition.wait(lock, [&]() { return ! queue.empty() || readerHasFinished; });
+      if (queue.empty())
+        break;
+      line = queue.front();
+      queue.pop_front();
+    }
+    if (line.empty() || '#' == line[0])
+      continue;
+
+    std::istringstream lineStream(line);
+    std::string commandID;
+    std::string commandName;
+    std::string argument;
+    lineStream >> commandID >> commandName >> argument;
+    {
+      std::lock_guard<std::mutex> lock(schedulerTestEngineMutex);
+      schedulerTestEngineLog.push_back(line.substr(commandID.size() + 1));
+    }
+
+    std::ostringstream response;
+    if ("genmove" == commandName)
+    {
+      interruptWasReceived = false;
+      {
+        std::lock_guard<std::mutex> lock(schedulerTestEngineMutex);
+        schedulerTestEngineNumberOfSearches++;
+        schedulerTestEngineSearchCondition.notify_all();
+      }
+      auto searchEndTime = std::chrono::steady_clock::now() + std::chrono::milliseconds(searchTimeInMilliseconds);
+      while (! interruptWasReceived && std::chrono::steady_clock::now() < searchEndTime)
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+      const char* vertex = ("b" == argument || "B" == argument) ? "D4" : "resign";
+      response << "=" << commandID << " " << vertex;
+    }
+    else if ("echo" == commandName)
+    {
+      response << "=" << commandID << " " << argument;
+    }
+    else if ("delay" == commandName)
+    {
+      deferredResponse = "=" + commandID + " " + argument;
+      continue;
+    }
+    else if ("no_id" == commandName)
+    {
+      response << "= " << argument;
+    }
+    else if ("wrong_id" == commandName)
+    {
+      response << "=4000000000 " << argument;
+    }
+    else
+    {
+      response << "=" << commandID;
+    }
+
+    responseStream << response.str() << "\n" << std::endl;
+    if (! deferredResponse.empty())
+    {
+      responseStream << deferredResponse << "\n" << std::endl;
+      deferredResponse.clear();
+    }
+    if ("quit" == commandName)
+      break;
+  }
+
+  readerThread.join();
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Returns a new GtpEnginePool object with a single scheduler test
+/// engine. Resets the state of the scheduler test engine that is shared with
+/// the tests.
+// -----------------------------------------------------------------------------
+static GtpEnginePool* schedulerTestEnginePool()
+{
+  {
+    std::lock_guard<std::mutex> lock(schedulerTestEngineMutex);
+    schedulerTestEngineLog.clear();
+    schedulerTestEngineNumberOfSearches = 0;
+  }
+  GtpEngineFactory engineFactory = ^(NSArray* streamBuffers)
+  {
+    return [GtpEngine engineWithStreamBuffers:streamBuffers mainFunction:schedulerTestEngineMain];
+  };
+  return [[[GtpEnginePool alloc] initWithNumberOfEngines:1
+                                           engineFactory:engineFactory] autorelease];
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Returns the commands that the scheduler test engine has processed
+/// so far, as an array of NSString objects.
+// -----------------------------------------------------------------------------
+static NSArray* schedulerTestEngineCommands()
+{
+  std::lock_guard<std::mutex> lock(schedulerTestEngineMutex);
+  NSMutableArray* commands = [NSMutableArray arrayWithCapacity:schedulerTestEngineLog.size()];
+  for (const std::string& command : schedulerTestEngineLog)
+    [commands addObject:[NSString stringWithUTF8String:command.c_str()]];
+  return commands;
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Blocks until the scheduler test engine has started its search
+/// number @a searchNumber (counting from 1). Returns false if the search does
+/// not start within a few seconds.
+// -----------------------------------------------------------------------------
+static bool waitForSearchToStart(int searchNumber)
+{
+  std::unique_lock<std::mutex> lock(schedulerTestEngineMutex);
+  return schedulerTestEngineSearchCondition.wait_for(lock,
+                                                     std::chrono::seconds(10),
+                                                     [&]() { return schedulerTestEngineNumberOfSearches >= searchNumber; });
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Returns an array with one new GtpCommand object per command string
+/// in @a commandStrings.
+// -----------------------------------------------------------------------------
+static NSArray* commandsWithStrings(NSArray* commandStrings)
+{
+  NSMutableArray* commands = [NSMutableArray arrayWithCapacity:commandStrings.count];
+  for (NSString* commandString in commandStrings)
+    [commands addObject:[GtpCommand command:commandString]];
+  return commands;
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Submits a preemptible "genmove" with color @a color and rollback
+/// command "undo" to @a client. Returns the future of the command.
+// -----------------------------------------------------------------------------
+static GtpFuture* submitPreemptibleGenmove(GtpClient* client, NSString* color)
+{
+  GtpCommand* command = [GtpCommand command:[@"genmove " stringByAppendingString:color]];
+  command.waitUntilDone = false;
+  command.priority = GtpCommandPriorityBackground;
+  command.preemptible = true;
+  command.preemptionRollbackCommand = @"undo";
+  command.future = [GtpFuture futureWithCommand:command];
+  [client submit:command];
+  return command.future;
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Submits @a commandString with priority #GtpCommandPriorityInteractive
+/// to @a client and waits for the response. Returns the command.
+// -----------------------------------------------------------------------------
+static GtpCommand* submitInteractiveCommand(GtpClient* client, NSString* commandString)
+{
+  GtpCommand* command = [GtpCommand command:commandString];
+  command.priority = GtpCommandPriorityInteractive;
+  [client submit:command];
+  return command;
+}
+
+
+@implementation GtpClientTest
+
+// -----------------------------------------------------------------------------
+/// @brief Checks that a pipelined batch with more commands than GtpClient
+/// passes to the GtpEngine in one go is processed completely and in order.
+// -----------------------------------------------------------------------------
+- (void) testPipelinedBatchLargerThanCommandsInFlight
+{
+  GtpEnginePool* pool = schedulerTestEnginePool();
+  const int numberOfCommands = 40;
+  NSMutableArray* commandStrings = [NSMutableArray arrayWithCapacity:numberOfCommands];
+  for (int commandIndex = 0; commandIndex < numberOfCommands; ++commandIndex)
+    [commandStrings addObject:[NSString stringWithFormat:@"echo %d", commandIndex]];
+  NSArray* commands = commandsWithStrings(commandStrings);
+
+  [[pool clientAtIndex:0] submitPipelined:commands];
+
+  XCTAssertEqualObjects(schedulerTestEngineCommands(), commandStrings);
+  for (int commandIndex = 0; commandIndex < numberOfCommands; ++commandIndex)
+  {
+    GtpCommand* command = [commands objectAtIndex:commandIndex];
+    XCTAssertTrue(command.response.status);
+    XCTAssertEqualObjects(command.response.parsedResponse, ([NSString stringWithFormat:@"%d", commandIndex]));
+  }
+  [pool shutdown];
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Checks that responses to pipelined commands are matched to their
+/// commands by command ID, even if the GtpEngine responds out of order.
+// -----------------------------------------------------------------------------
+- (void) testPipelinedResponsesAreMatchedByCommandID
+{
+  GtpEnginePool* pool = schedulerTestEnginePool();
+  NSArray* commands = commandsWithStrings(@[@"delay 1", @"echo 2", @"delay 3", @"echo 4"]);
+
+  [[pool clientAtIndex:0] submitPipelined:commands];
+
+  for (NSUInteger commandIndex = 0; commandIndex < commands.count; ++commandIndex)
+  {
+    GtpCommand* command = [commands objectAtIndex:commandIndex];
+    XCTAssertTrue(command.response.status);
+    XCTAssertEqualObjects(command.response.parsedResponse, ([NSString stringWithFormat:@"%lu", (unsigned long)commandIndex + 1]));
+  }
+  [pool shutdown];
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Checks that a response whose command ID is missing or unknown is
+/// matched to the oldest pipelined command that is still waiting for a
+/// response.
+// -----------------------------------------------------------------------------
+- (void) testPipelinedResponseWithoutCommandID
+{
+  GtpEnginePool* pool = schedulerTestEnginePool();
+  NSArray* commands = commandsWithStrings(@[@"echo 1", @"no_id 2", @"echo 3", @"wrong_id 4", @"echo 5"]);
+
+  [[pool clientAtIndex:0] submitPipelined:commands];
+
+  for (NSUInteger commandIndex = 0; commandIndex < commands.count; ++commandIndex)
+  {
+    GtpCommand* command = [commands objectAtIndex:commandIndex];
+    XCTAssertTrue(command.response.status);
+    XCTAssertEqualObjects(command.response.parsedResponse, ([NSString stringWithFormat:@"%lu", (unsigned long)commandIndex + 1]));
+  }
+  [pool shutdown];
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Checks that pipelined commands after "quit" are not sent to the
+/// GtpEngine, and that the GtpClient exits after "quit".
+// -----------------------------------------------------------------------------
+- (void) testPipelinedBatchWithQuit
+{
+  GtpEnginePool* pool = schedulerTestEnginePool();
+  GtpClient* client = [pool clientAtIndex:0];
+  NSArray* commands = commandsWithStrings(@[@"echo 1", @"quit", @"echo 3"]);
+
+  [client submitPipelined:commands];
+
+  NSArray* expectedCommands = @[@"echo 1", @"quit"];
+  XCTAssertEqualObjects(schedulerTestEngineCommands(), expectedCommands);
+  XCTAssertTrue([[commands objectAtIndex:0] response].status);
+  XCTAssertTrue([[commands objectAtIndex:1] response].status);
+  XCTAssertNil([[commands objectAtIndex:2] response]);
+  XCTAssertTrue(client.shouldExit);
+  [[pool engineAtIndex:0] waitUntilFinished];
+  [pool shutdown];
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Checks that a pipelined command whose future was cancelled before
+/// the command was processed is not sent to the GtpEngine.
+// -----------------------------------------------------------------------------
+- (void) testPipelinedBatchSkipsCancelledCommand
+{
+  GtpEnginePool* pool = schedulerTestEnginePool();
+  NSArray* commands = commandsWithStrings(@[@"echo 1", @"echo 2", @"echo 3"]);
+  GtpCommand* cancelledCommand = [commands objectAtIndex:1];
+  GtpFuture* future = [GtpFuture futureWithCommand:cancelledCommand];
+  cancelledCommand.future = future;
+  [future cancel];
+
+  [[pool clientAtIndex:0] submitPipelined:commands];
+
+  NSArray* expectedCommands = @[@"echo 1", @"echo 3"];
+  XCTAssertEqualObjects(schedulerTestEngineCommands(), expectedCommands);
+  XCTAssertEqualObjects([[commands objectAtIndex:0] response].parsedResponse, @"1");
+  XCTAssertNil(cancelledCommand.response);
+  XCTAssertNil(cancelledCommand.future);
+  XCTAssertEqual(future.state, GtpFutureStateCancelled);
+  XCTAssertEqualObjects([[commands objectAtIndex:2] response].parsedResponse, @"3");
+  [pool shutdown];
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Checks that an interactive command preempts a preemptible background
+/// command, that the move which the interrupted command has added is rolled
+/// back, and that the interrupted command is then resumed.
+// -----------------------------------------------------------------------------
+- (void) testPreemptionRollsBackAddedMove
+{
+  GtpEnginePool* pool = schedulerTestEnginePool();
+  GtpClient* client = [pool clientAtIndex:0];
+  [client submit:[GtpCommand command:@"boardsize 9"]];
+
+  GtpFuture* future = submitPreemptibleGenmove(client, @"b");
+  XCTAssertTrue(waitForSearchToStart(1));
+  GtpCommand* interactiveCommand = submitInteractiveCommand(client, @"name");
+  XCTAssertTrue(interactiveCommand.response.status);
+  XCTAssertEqual([future waitWithTimeout:10.0], GtpFutureStateFulfilled);
+
+  NSArray* expectedCommands = @[@"boardsize 9", @"genmove b", @"undo", @"name", @"genmove b"];
+  XCTAssertEqualObjects(schedulerTestEngineCommands(), expectedCommands);
+  XCTAssertEqualObjects(future.response.parsedResponse, @"D4");
+  XCTAssertEqualObjects(client.engineState.moves, @[@"B D4"]);
+  struct GtpCommandLaneStatistics statistics = [client statisticsForLane:GtpCommandPriorityBackground];
+  XCTAssertEqual(statistics.numberOfPreemptions, 1);
+  XCTAssertEqual(statistics.numberOfProcessedBatches, 1);
+  [pool shutdown];
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Checks that no rollback command is sent if the interrupted command
+/// has not added a move, i.e. if "genmove" has answered with "resign".
+// -----------------------------------------------------------------------------
+- (void) testPreemptionWithoutRollbackAfterResignation
+{
+  GtpEnginePool* pool = schedulerTestEnginePool();
+  GtpClient* client = [pool clientAtIndex:0];
+  [client submit:[GtpCommand command:@"boardsize 9"]];
+
+  GtpFuture* future = submitPreemptibleGenmove(client, @"w");
+  XCTAssertTrue(waitForSearchToStart(1));
+  submitInteractiveCommand(client, @"name");
+  XCTAssertEqual([future waitWithTimeout:10.0], GtpFutureStateFulfilled);
+
+  NSArray* expectedCommands = @[@"boardsize 9", @"genmove w", @"name", @"genmove w"];
+  XCTAssertEqualObjects(schedulerTestEngineCommands(), expectedCommands);
+  XCTAssertEqualObjects(future.response.parsedResponse, @"resign");
+  XCTAssertEqual(client.engineState.moves.count, static_cast<NSUInteger>(0));
+  XCTAssertEqual([client statisticsForLane:GtpCommandPriorityBackground].numberOfPreemptions, 1);
+  [pool shutdown];
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Checks that an interrupted command is not resumed, and that its
+/// future is cancelled, if the position has changed since the command was
+/// interrupted.
+// -----------------------------------------------------------------------------
+- (void) testPreemptedCommandIsCancelledIfPositionHasChanged
+{
+  GtpEnginePool* pool = schedulerTestEnginePool();
+  GtpClient* client = [pool clientAtIndex:0];
+  [client submit:[GtpCommand command:@"boardsize 9"]];
+
+  GtpFuture* future = submitPreemptibleGenmove(client, @"b");
+  XCTAssertTrue(waitForSearchToStart(1));
+  submitInteractiveCommand(client, @"play w E5");
+  XCTAssertEqual([future waitWithTimeout:10.0], GtpFutureStateCancelled);
+
+  // Make sure that the secondary thread has finished with the cancelled
+  // command
+  [client submit:[GtpCommand command:@"name"]];
+  NSArray* expectedCommands = @[@"boardsize 9", @"genmove b", @"undo", @"play w E5", @"name"];
+  XCTAssertEqualObjects(schedulerTestEngineCommands(), expectedCommands);
+  XCTAssertNil(future.response);
+  XCTAssertEqualObjects(client.engineState.moves, @[@"W E5"]);
+  [pool shutdown];
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Checks that a batch does not overtake an earlier batch that changes
+/// the position, and that a batch that changes the position does not
+/// overtake an earlier batch.
+// -----------------------------------------------------------------------------
+- (void) testOrderingBarrier
+{
+  GtpEnginePool* pool = schedulerTestEnginePool();
+  GtpClient* client = [pool clientAtIndex:0];
+
+  // Keep the engine busy with a command that cannot be preempted, so that
+  // the following commands have to wait in their lanes
+  GtpCommand* genmoveCommand = [GtpCommand command:@"genmove b"];
+  genmoveCommand.waitUntilDone = false;
+  genmoveCommand.priority = GtpCommandPriorityBackground;
+  [client submit:genmoveCommand];
+  XCTAssertTrue(waitForSearchToStart(1));
+
+  GtpCommand* backgroundQuery = [GtpCommand command:@"showboard"];
+  backgroundQuery.waitUntilDone = false;
+  backgroundQuery.priority = GtpCommandPriorityBackground;
+  [client submit:backgroundQuery];
+  GtpCommand* playCommand = [GtpCommand command:@"play b C3"];
+  playCommand.waitUntilDone = false;
+  [client submit:playCommand];
+  GtpCommand* interactiveQuery = submitInteractiveCommand(client, @"name");
+  XCTAssertTrue(interactiveQuery.response.status);
+
+  NSArray* expectedCommands = @[@"genmove b", @"showboard", @"play b C3", @"name"];
+  XCTAssertEqualObjects(schedulerTestEngineCommands(), expectedCommands);
+  [pool shutdown];
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Checks the queue depth and wait time counters of the lane
+/// statistics.
+// -----------------------------------------------------------------------------
+- (void) testLaneStatistics
+{
+  GtpEnginePool* pool = schedulerTestEnginePool();
+  GtpClient* client = [pool clientAtIndex:0];
+
+  // Keep the engine busy with a command that cannot be preempted, so that
+  // the following commands have to wait in their lane
+  GtpCommand* backgroundCommand = [GtpCommand command:@"genmove b"];
+  backgroundCommand.waitUntilDone = false;
+  backgroundCommand.priority = GtpCommandPriorityBackground;
+  [client submit:backgroundCommand];
+  XCTAssertTrue(waitForSearchToStart(1));
+
+  for (int commandIndex = 0; commandIndex < 3; ++commandIndex)
+  {
+    GtpCommand* command = [GtpCommand command:@"name"];
+    command.waitUntilDone = false;
+    [client submit:command];
+  }
+  struct GtpCommandLaneStatistics statistics = [client statisticsForLane:GtpCommandPriorityNormal];
+  XCTAssertEqual(statistics.queueDepth, 3);
+  XCTAssertEqual(statistics.maximumQueueDepth, 3);
+  XCTAssertEqual(statistics.numberOfProcessedBatches, 0);
+
+  // Batches in the same lane are processed in FIFO order, so when this
+  // command is done all other commands are done as well
+  [client submit:[GtpCommand command:@"name"]];
+  statistics = [client statisticsForLane:GtpCommandPriorityNormal];
+  XCTAssertEqual(statistics.queueDepth, 0);
+  XCTAssertGreaterThanOrEqual(statistics.maximumQueueDepth, 3);
+  XCTAssertEqual(statistics.numberOfProcessedBatches, 4);
+  XCTAssertEqual(statistics.numberOfPreemptions, 0);
+  XCTAssertGreaterThan(statistics.maximumWaitTime, 0.0);
+  XCTAssertGreaterThanOrEqual(statistics.totalWaitTime, statistics.maximumWaitTime);
+
+  statistics = [client statisticsForLane:GtpCommandPriorityBackground];
+  XCTAssertEqual(statistics.queueDepth, 0);
+  XCTAssertEqual(statistics.numberOfProcessedBatches, 1);
+  XCTAssertEqual(statistics.numberOfPreemptions, 0);
+  [pool shutdown];
+}
+
+@end
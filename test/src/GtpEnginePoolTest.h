@@ -0,0 +1,40 @@
+// -----------------------------------------------------------------------------
+// Copyright 2026 Patrick Näf (herzbube@herzbube.ch)
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// -----------------------------------------------------------------------------
+
+
+// Project includes
+#import "BaseTestCase.h"
+
+
+// -----------------------------------------------------------------------------
+/// @brief The GtpEnginePoolTest class contains unit tests that exercise the
+/// GtpEnginePool class.
+///
+/// The tests do not use Fuego. Instead every engine in the pool runs a
+/// stand-in engine that does a fixed amount of CPU-bound work per command.
+// -----------------------------------------------------------------------------
+@interface GtpEnginePoolTest : BaseTestCase
+{
+}
+
+- (void) testInitialState;
+- (void) testAssignEngineToRole;
+- (void) testInvalidArguments;
+- (void) testRoundTripThroughEveryEngine;
+- (void) testPerformanceThroughputSingleEngine;
+- (void) testPerformanceThroughputAllCores;
+
+@end
@@ -0,0 +1,238 @@
+// -----------------------------------------------------------------------------
+// Copyright 2026 Patrick Näf (herzbube@herzbube.ch)
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// -----------------------------------------------------------------------------
+
+
+// Test includes
+#import "GtpEnginePoolTest.h"
+
+// Application includes
+#import <gtp/GtpClient.h>
+#import <gtp/GtpCommand.h>
+#import <gtp/GtpEngine.h>
+#import <gtp/GtpEnginePool.h>
+#import <gtp/GtpFuture.h>
+#import <gtp/GtpResponse.h>
+
+// C++ standard library
+#include <cstdint>
+#include <cstdlib>
+#include <sstream>
+#include <string>
+
+
+// Number of "playout" iterations that the stand-in engine performs per
+// position. Is chosen so that a single position takes a few milliseconds.
+static const int playoutsPerPosition = 2000000;
+// Number of positions that the throughput benchmarks analyze
+static const int numberOfPositions = 64;
+
+
+// -----------------------------------------------------------------------------
+/// @brief Main function of a stand-in GTP engine. Understands the commands
+/// "quit" and "playout <n> <seed>". The latter performs @e n iterations of a
+/// pseudo random number generator and responds with the final value.
+/// Responds to every other command with an empty success response.
+// -----------------------------------------------------------------------------
+static void standInEngineMain(std::istream& commandStream, std::ostream& responseStream)
+{
+  std::string line;
+  while (std::getline(commandStream, line))
+  {
+    if (line.empty() || '#' == line[0])
+      continue;
+
+    std::istringstream lineStream(line);
+    std::string commandID;
+    std::string commandName;
+    lineStream >> commandID >> commandName;
+
+    if ("playout" == commandName)
+    {
+      long numberOfPlayouts = 0;
+      uint64_t state = 0;
+      lineStream >> numberOfPlayouts >> state;
+      state |= 1;
+      for (long playout = 0; playout < numberOfPlayouts; ++playout)
+      {
+        state ^= state << 13;
+        state ^= state >> 7;
+        state ^= state << 17;
+      }
+      responseStream << "=" << commandID << " " << state << "\n" << std::endl;
+    }
+    else
+    {
+      responseStream << "=" << commandID << "\n" << std::endl;
+      if ("quit" == commandName)
+        break;
+    }
+  }
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Returns a new GtpEnginePool object with @a numberOfEngines stand-in
+/// engines.
+// -----------------------------------------------------------------------------
+static GtpEnginePool* standInEnginePool(int numberOfEngines)
+{
+  GtpEngineFactory engineFactory = ^(NSArray* streamBuffers)
+  {
+    return [GtpEngine engineWithStreamBuffers:streamBuffers mainFunction:standInEngineMain];
+  };
+  return [[[GtpEnginePool alloc] initWithNumberOfEngines:numberOfEngines
+                                           engineFactory:engineFactory] autorelease];
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Distributes @a numberOfPositions positions round-robin across all
+/// engines in @a pool and waits until all engines have responded. Returns the
+/// number of positions for which the engine responded successfully.
+// -----------------------------------------------------------------------------
+static int analyzePositions(GtpEnginePool* pool, int numberOfPositions)
+{
+  NSMutableArray* futures = [NSMutableArray arrayWithCapacity:numberOfPositions];
+  for (int positionIndex = 0; positionIndex < numberOfPositions; ++positionIndex)
+  {
+    NSString* commandString = [NSString stringWithFormat:@"playout %d %d", playoutsPerPosition, positionIndex];
+    GtpCommand* command = [GtpCommand command:commandString];
+    command.waitUntilDone = false;
+    command.future = [GtpFuture futureWithCommand:command];
+    [futures addObject:command.future];
+    [[pool clientAtIndex:positionIndex % pool.numberOfEngines] submit:command];
+  }
+
+  [[GtpFuture whenAll:futures] waitWithTimeout:60.0];
+
+  int numberOfSuccessfulPositions = 0;
+  for (GtpFuture* future in futures)
+  {
+    if (GtpFutureStateFulfilled == future.state && future.response.status)
+      numberOfSuccessfulPositions++;
+  }
+  return numberOfSuccessfulPositions;
+}
+
+
+@implementation GtpEnginePoolTest
+
+// -----------------------------------------------------------------------------
+/// @brief Checks the initial state of a GtpEnginePool object after it has been
+/// created.
+// -----------------------------------------------------------------------------
+- (void) testInitialState
+{
+  GtpEnginePool* pool = standInEnginePool(2);
+  XCTAssertEqual(pool.numberOfEngines, 2);
+  XCTAssertNotNil([pool clientAtIndex:0]);
+  XCTAssertNotNil([pool clientAtIndex:1]);
+  XCTAssertNotEqual([pool clientAtIndex:0], [pool clientAtIndex:1]);
+  XCTAssertNotEqual([pool engineAtIndex:0], [pool engineAtIndex:1]);
+  XCTAssertEqual([pool engineIndexForRole:GtpEngineRolePlay], 0);
+  XCTAssertEqual([pool engineIndexForRole:GtpEngineRoleAnalysis], 1);
+  XCTAssertEqual([pool engineIndexForRole:GtpEngineRoleScoring], 0);
+  XCTAssertEqual([pool clientForRole:GtpEngineRoleAnalysis], [pool clientAtIndex:1]);
+  XCTAssertEqual([pool engineForRole:GtpEngineRoleAnalysis], [pool engineAtIndex:1]);
+  [pool shutdown];
+
+  GtpEnginePool* singleEnginePool = standInEnginePool(1);
+  for (int role = 0; role < GtpEngineRoleMax; ++role)
+    XCTAssertEqual([singleEnginePool engineIndexForRole:(enum GtpEngineRole)role], 0);
+  [singleEnginePool shutdown];
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Exercises the assignEngineAtIndex:toRole:() method.
+// -----------------------------------------------------------------------------
+- (void) testAssignEngineToRole
+{
+  GtpEnginePool* pool = standInEnginePool(3);
+  [pool assignEngineAtIndex:2 toRole:GtpEngineRolePlay];
+  XCTAssertEqual([pool engineIndexForRole:GtpEngineRolePlay], 2);
+  XCTAssertEqual([pool clientForRole:GtpEngineRolePlay], [pool clientAtIndex:2]);
+  // Other roles are not affected
+  XCTAssertEqual([pool engineIndexForRole:GtpEngineRoleAnalysis], 1);
+  XCTAssertEqual([pool engineIndexForRole:GtpEngineRoleScoring], 2);
+  [pool shutdown];
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Checks that GtpEnginePool rejects invalid arguments.
+// -----------------------------------------------------------------------------
+- (void) testInvalidArguments
+{
+  GtpEngineFactory engineFactory = ^(NSArray* streamBuffers)
+  {
+    return [GtpEngine engineWithStreamBuffers:streamBuffers mainFunction:standInEngineMain];
+  };
+  XCTAssertThrowsSpecificNamed([[GtpEnginePool alloc] initWithNumberOfEngines:0 engineFactory:engineFactory],
+                               NSException, NSInvalidArgumentException, @"no engines");
+
+  GtpEnginePool* pool = standInEnginePool(2);
+  XCTAssertThrowsSpecificNamed([pool engineIndexForRole:GtpEngineRoleMax],
+                               NSException, NSInvalidArgumentException, @"invalid role");
+  XCTAssertThrowsSpecificNamed([pool assignEngineAtIndex:2 toRole:GtpEngineRolePlay],
+                               NSException, NSInvalidArgumentException, @"engine index too high");
+  XCTAssertThrowsSpecificNamed([pool assignEngineAtIndex:-1 toRole:GtpEngineRolePlay],
+                               NSException, NSInvalidArgumentException, @"negative engine index");
+  [pool shutdown];
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Checks that every engine in the pool processes commands and that
+/// every response is delivered to the command that caused it.
+// -----------------------------------------------------------------------------
+- (void) testRoundTripThroughEveryEngine
+{
+  GtpEnginePool* pool = standInEnginePool(3);
+  for (int engineIndex = 0; engineIndex < pool.numberOfEngines; ++engineIndex)
+  {
+    GtpCommand* command = [GtpCommand command:@"playout 0 42"];
+    [[pool clientAtIndex:engineIndex] submit:command];
+    XCTAssertTrue(command.response.status);
+    XCTAssertEqualObjects(command.response.parsedResponse, @"43");
+  }
+  XCTAssertEqual(analyzePositions(pool, 9), 9);
+  [pool shutdown];
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Measures the throughput of a pool with a single engine. Serves as
+/// baseline for testPerformanceThroughputAllCores().
+// -----------------------------------------------------------------------------
+- (void) testPerformanceThroughputSingleEngine
+{
+  GtpEnginePool* pool = standInEnginePool(1);
+  [self measureBlock:^{
+    XCTAssertEqual(analyzePositions(pool, numberOfPositions), numberOfPositions);
+  }];
+  [pool shutdown];
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Measures the throughput of a pool with one engine per processor
+/// core.
+// -----------------------------------------------------------------------------
+- (void) testPerformanceThroughputAllCores
+{
+  int numberOfEngines = (int)[NSProcessInfo processInfo].activeProcessorCount;
+  GtpEnginePool* pool = standInEnginePool(numberOfEngines);
+  [self measureBlock:^{
+    XCTAssertEqual(analyzePositions(pool, numberOfPositions), numberOfPositions);
+  }];
+  [pool shutdown];
+}
+
+@end
@@ -0,0 +1,182 @@
+// -----------------------------------------------------------------------------
+// Copyright 2026 Patrick Näf (herzbube@herzbube.ch)
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// -----------------------------------------------------------------------------
+
+
+// Test includes
+#import "GtpEngineProcessTest.h"
+
+// Application includes
+#import <gtp/GtpClient.h>
+#import <gtp/GtpCommand.h>
+#import <gtp/GtpResponse.h>
+#include <gtp/GtpEngineProcess.h>
+
+// C++ standard library
+#include <chrono>
+#include <istream>
+#include <ostream>
+#include <string>
+#include <system_error>
+#include <thread>
+
+
+// Shell script that acts as a stand-in GTP engine. Understands the commands
+// "echo" and "quit", and responds to every other command with a failure
+// response. Expects that every command has a command ID.
+static const char* standInEngineScript =
+  "while read id name arguments; do "
+  "  case \"$name\" in "
+  "    quit) printf '=%s\\n\\n' \"$id\"; exit 0;; "
+  "    echo) printf '=%s %s\\n\\n' \"$id\" \"$arguments\";; "
+  "    *) printf '?%s unknown command\\n\\n' \"$id\";; "
+  "  esac; "
+  "done";
+
+
+// -----------------------------------------------------------------------------
+/// @brief Reads a response from @a responseStream and returns it without the
+/// terminating empty line. Returns an empty string on end-of-file.
+// -----------------------------------------------------------------------------
+static std::string readResponse(std::istream& responseStream)
+{
+  std::string fullResponse;
+  std::string singleLineResponse;
+  while (std::getline(responseStream, singleLineResponse) && ! singleLineResponse.empty())
+  {
+    if (! fullResponse.empty())
+      fullResponse += "\n";
+    fullResponse += singleLineResponse;
+  }
+  return fullResponse;
+}
+
+
+@implementation GtpEngineProcessTest
+
+// -----------------------------------------------------------------------------
+/// @brief Sends a few commands to the stand-in engine and checks the
+/// responses.
+// -----------------------------------------------------------------------------
+- (void) testRoundTrip
+{
+  GtpEngineProcess engineProcess("/bin/sh", {"-c", standInEngineScript});
+  XCTAssertTrue(engineProcess.processID() > 0);
+  std::ostream commandStream(engineProcess.commandStreamBuffer());
+  std::istream responseStream(engineProcess.responseStreamBuffer());
+
+  commandStream << "1 echo hello world" << std::endl;
+  XCTAssertTrue(readResponse(responseStream) == "=1 hello world");
+  commandStream << "2 foo" << std::endl;
+  XCTAssertTrue(readResponse(responseStream) == "?2 unknown command");
+  commandStream << "3 quit" << std::endl;
+  XCTAssertTrue(readResponse(responseStream) == "=3");
+  XCTAssertEqual(engineProcess.waitForExit(), 0);
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Sends many commands without waiting for responses, then checks that
+/// all responses arrive in order.
+// -----------------------------------------------------------------------------
+- (void) testPipelinedRoundTrips
+{
+  const int numberOfCommands = 500;
+  GtpEngineProcess engineProcess("/bin/sh", {"-c", standInEngineScript});
+  std::ostream commandStream(engineProcess.commandStreamBuffer());
+  std::istream responseStream(engineProcess.responseStreamBuffer());
+
+  std::string payload(200, 'x');
+  for (int commandID = 1; commandID <= numberOfCommands; ++commandID)
+    commandStream << commandID << " echo " << payload << '\n';
+  commandStream.flush();
+
+  for (int commandID = 1; commandID <= numberOfCommands; ++commandID)
+  {
+    std::string expectedResponse = "=" + std::to_string(commandID) + " " + payload;
+    XCTAssertTrue(readResponse(responseStream) == expectedResponse);
+  }
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Plugs GtpEngineProcess into GtpClient and checks that commands
+/// submitted to GtpClient reach the child process.
+// -----------------------------------------------------------------------------
+- (void) testGtpClient
+{
+  GtpEngineProcess engineProcess("/bin/sh", {"-c", standInEngineScript});
+  NSArray* streamBuffers = [NSArray arrayWithObjects:
+                            [NSValue valueWithPointer:engineProcess.commandStreamBuffer()],
+                            [NSValue valueWithPointer:engineProcess.responseStreamBuffer()],
+                            nil];
+  GtpClient* client = [GtpClient clientWithStreamBuffers:streamBuffers];
+
+  GtpCommand* echoCommand = [GtpCommand command:@"echo hello"];
+  [client submit:echoCommand];
+  XCTAssertTrue(echoCommand.response.status);
+  XCTAssertEqualObjects(echoCommand.response.parsedResponse, @"hello");
+
+  GtpCommand* unknownCommand = [GtpCommand command:@"foo"];
+  [client submit:unknownCommand];
+  XCTAssertFalse(unknownCommand.response.status);
+
+  [client submit:[GtpCommand command:@"quit"]];
+  XCTAssertEqual(engineProcess.waitForExit(), 0);
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Checks that the reading side receives end-of-file when the child
+/// process exits, and that the exit status is reported.
+// -----------------------------------------------------------------------------
+- (void) testEndOfFileWhenProcessExits
+{
+  GtpEngineProcess engineProcess("/bin/sh", {"-c", "exit 3"});
+  std::istream responseStream(engineProcess.responseStreamBuffer());
+  std::string line;
+  XCTAssertFalse(std::getline(responseStream, line));
+  XCTAssertTrue(responseStream.eof());
+  XCTAssertEqual(engineProcess.waitForExit(), 3);
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Checks that the destructor returns if the child process produces
+/// more output than the response pipe can hold and nobody reads it.
+// -----------------------------------------------------------------------------
+- (void) testDestructorWithUnreadResponses
+{
+  GtpEngineProcess* engineProcess = new GtpEngineProcess("/bin/sh", {"-c", "head -c 1000000 /dev/zero; exec sleep 10"});
+  // Give the reader thread time to fill the response pipe and block
+  std::this_thread::sleep_for(std::chrono::milliseconds(200));
+  delete engineProcess;
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Checks that the constructor throws if the executable cannot be
+/// started.
+// -----------------------------------------------------------------------------
+- (void) testSpawnFailure
+{
+  bool exceptionWasThrown = false;
+  try
+  {
+    GtpEngineProcess engineProcess("/nonexistent/gtp-engine", {});
+  }
+  catch (const std::system_error&)
+  {
+    exceptionWasThrown = true;
+  }
+  XCTAssertTrue(exceptionWasThrown);
+}
+
+@end
@@ -0,0 +1,623 @@
+// -----------------------------------------------------------------------------
+// Copyright 2026 Patrick Näf (herzbube@herzbube.ch)
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// -----------------------------------------------------------------------------
+
+
+// Test includes
+#import "GtpEngineStateTest.h"
+
+// Application includes
+#import <gtp/GtpClient.h>
+#import <gtp/GtpCommand.h>
+#import <gtp/GtpEngine.h>
+#import <gtp/GtpEnginePool.h>
+#import <gtp/GtpEngineState.h>
+#import <gtp/GtpResponse.h>
+
+// C++ standard library
+#include <cstdint>
+#include <sstream>
+#include <string>
+
+
+// Number of moves of the game that the benchmarks navigate in
+static const int numberOfMovesInGame = 300;
+// Number of pseudo random number iterations that the stand-in engine performs
+// per played move. Simulates the cost of playing a move in a real engine.
+static const long playoutsPerMove = 20000;
+
+
+// -----------------------------------------------------------------------------
+/// @brief Main function of a stand-in GTP engine that keeps track of the
+/// number of moves on its board. Understands "clear_board", "play",
+/// "gogui-play_sequence", "genmove" (always responds "D4"), "undo" (fails if
+/// there are no moves) and "quit". Responds to every other command with an
+/// empty success response.
+// -----------------------------------------------------------------------------
+static void standInEngineMain(std::istream& commandStream, std::ostream& responseStream)
+{
+  long numberOfMoves = 0;
+  uint64_t state = 1;
+  std::string line;
+  while (std::getline(commandStream, line))
+  {
+    if (line.empty() || '#' == line[0])
+      continue;
+
+    std::istringstream lineStream(line);
+    std::string commandID;
+    std::string commandName;
+    lineStream >> commandID >> commandName;
+
+    long numberOfPlayedMoves = 0;
+    std::string response;
+    bool success = true;
+    if ("clear_board" == commandName)
+    {
+      numberOfMoves = 0;
+    }
+    else if ("play" == commandName)
+    {
+      numberOfPlayedMoves = 1;
+    }
+    else if ("gogui-play_sequence" == commandName)
+    {
+      std::string token;
+      while (lineStream >> token)
+        numberOfPlayedMoves++;
+      numberOfPlayedMoves /= 2;
+    }
+    else if ("genmove" == commandName)
+    {
+      numberOfPlayedMoves = 1;
+      response = "D4";
+    }
+    else if ("undo" == commandName)
+    {
+      if (0 == numberOfMoves)
+        success = false;
+      else
+        numberOfMoves--;
+    }
+
+    for (long playout = 0; playout < numberOfPlayedMoves * playoutsPerMove; ++playout)
+    {
+      state ^= state << 13;
+      state ^= state >> 7;
+      state ^= state << 17;
+    }
+    numberOfMoves += numberOfPlayedMoves;
+
+    responseStream << (success ? "=" : "?") << commandID << " " << response << "\n" << std::endl;
+    if ("quit" == commandName)
+      break;
+  }
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Returns a new GtpEnginePool object with a single stand-in engine.
+// -----------------------------------------------------------------------------
+static GtpEnginePool* standInEnginePool()
+{
+  GtpEngineFactory engineFactory = ^(NSArray* streamBuffers)
+  {
+    return [GtpEngine engineWithStreamBuffers:streamBuffers mainFunction:standInEngineMain];
+  };
+  return [[[GtpEnginePool alloc] initWithNumberOfEngines:1
+                                           engineFactory:engineFactory] autorelease];
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Updates @a state with a successful response @a response to the
+/// command @a command.
+// -----------------------------------------------------------------------------
+static void update(GtpEngineState* state, NSString* command, NSString* response)
+{
+  GtpCommand* gtpCommand = [GtpCommand command:command];
+  [state updateWithResponse:[GtpResponse response:[@"= " stringByAppendingString:response] toCommand:gtpCommand]];
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Returns a known GtpEngineState object for a 19x19 board with komi
+/// 6.5 and the first @a numberOfMoves moves of a game in which black and white
+/// alternate on a fixed sequence of vertices.
+// -----------------------------------------------------------------------------
+static GtpEngineState* gameState(int numberOfMoves)
+{
+  GtpEngineState* state = [[[GtpEngineState alloc] init] autorelease];
+  state.known = true;
+  state.boardSize = 19;
+  state.komi = [GtpEngineState komiStringWithKomi:6.5];
+  for (int moveIndex = 0; moveIndex < numberOfMoves; ++moveIndex)
+  {
+    NSString* vertex = [NSString stringWithFormat:@"%c%d", "ABCDEFGHJKLMNOPQRST"[moveIndex % 19], moveIndex / 19 + 1];
+    [state.moves addObject:[GtpEngineState moveWithColor:(moveIndex % 2 ? @"W" : @"B") vertex:vertex]];
+  }
+  return state;
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Brings the engine behind @a client into the position @a targetState
+/// the way SyncGTPEngineCommand does. If @a incremental is false the position
+/// is always rebuilt from scratch. Returns true on success.
+// -----------------------------------------------------------------------------
+static bool syncEngine(GtpClient* client, GtpEngineState* targetState, bool incremental)
+{
+  NSMutableArray* commands = [NSMutableArray array];
+  NSUInteger numberOfUndos = 0;
+  NSUInteger indexOfFirstMoveToPlay = 0;
+  if (! incremental || ! [targetState planSyncFromState:client.engineState numberOfUndos:&numberOfUndos indexOfFirstMoveToPlay:&indexOfFirstMoveToPlay])
+  {
+    [commands addObject:[GtpCommand command:@"clear_board"]];
+    [commands addObject:[GtpCommand command:[@"komi " stringByAppendingString:targetState.komi]]];
+    numberOfUndos = 0;
+    indexOfFirstMoveToPlay = 0;
+  }
+  for (NSUInteger undoIndex = 0; undoIndex < numberOfUndos; ++undoIndex)
+    [commands addObject:[GtpCommand command:@"undo"]];
+  if (indexOfFirstMoveToPlay < targetState.moves.count)
+  {
+    NSArray* moves = [targetState.moves subarrayWithRange:NSMakeRange(indexOfFirstMoveToPlay, targetState.moves.count - indexOfFirstMoveToPlay)];
+    [commands addObject:[GtpCommand command:[@"gogui-play_sequence " stringByAppendingString:[moves componentsJoinedByString:@" "]]]];
+  }
+  if (0 == commands.count)
+    return true;
+
+  [client submitPipelined:commands];
+  for (GtpCommand* command in commands)
+  {
+    if (! command.response.status)
+      return false;
+  }
+  return true;
+}
+
+
+@implementation GtpEngineStateTest
+
+// -----------------------------------------------------------------------------
+/// @brief Checks the initial state of a GtpEngineState object after it has
+/// been created.
+// -----------------------------------------------------------------------------
+- (void) testInitialState
+{
+  GtpEngineState* state = [[[GtpEngineState alloc] init] autorelease];
+  XCTAssertFalse(state.isKnown);
+  XCTAssertEqual(state.boardSize, 0);
+  XCTAssertNil(state.komi);
+  XCTAssertNil(state.handicap);
+  XCTAssertNil(state.setupStones);
+  XCTAssertNil(state.setupPlayer);
+  XCTAssertEqual(state.moves.count, 0);
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Exercises the updateWithResponse:() method with successful
+/// responses.
+// -----------------------------------------------------------------------------
+- (void) testUpdateWithResponse
+{
+  GtpEngineState* state = [[[GtpEngineState alloc] init] autorelease];
+
+  // Commands that do not change the position are ignored
+  update(state, @"showboard", @"");
+  XCTAssertFalse(state.isKnown);
+
+  update(state, @"boardsize 9", @"");
+  XCTAssertTrue(state.isKnown);
+  XCTAssertEqual(state.boardSize, 9);
+  update(state, @"komi 7", @"");
+  XCTAssertEqualObjects(state.komi, @"7.0");
+  update(state, @"set_free_handicap d4  f6", @"");
+  XCTAssertEqualObjects(state.handicap, @"D4 F6");
+  update(state, @"gogui-setup B A1 W B2", @"");
+  XCTAssertEqualObjects(state.setupStones, @"B A1 W B2");
+  update(state, @"gogui-setup_player w", @"");
+  XCTAssertEqualObjects(state.setupPlayer, @"W");
+
+  update(state, @"play b c3", @"");
+  update(state, @"gogui-play_sequence W d5 B pass", @"");
+  update(state, @"genmove w", @"E5");
+  update(state, @"genmove b", @"resign");
+  NSArray* expectedMoves = @[@"B C3", @"W D5", @"B PASS", @"W E5"];
+  XCTAssertEqualObjects(state.moves, expectedMoves);
+
+  update(state, @"undo", @"");
+  XCTAssertEqual(state.moves.count, 3);
+  update(state, @"gg-undo 2", @"");
+  XCTAssertEqual(state.moves.count, 1);
+  XCTAssertTrue(state.isKnown);
+
+  // "clear_board" keeps board size and komi
+  update(state, @"clear_board", @"");
+  XCTAssertTrue(state.isKnown);
+  XCTAssertEqual(state.boardSize, 9);
+  XCTAssertEqualObjects(state.komi, @"7.0");
+  XCTAssertNil(state.handicap);
+  XCTAssertNil(state.setupStones);
+  XCTAssertNil(state.setupPlayer);
+  XCTAssertEqual(state.moves.count, 0);
+
+  update(state, @"fixed_handicap 2", @"D4 Q16");
+  XCTAssertEqualObjects(state.handicap, @"D4 Q16");
+
+  update(state, @"loadsgf /tmp/game.sgf", @"");
+  XCTAssertFalse(state.isKnown);
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Checks that a failed command that changes the position makes the
+/// state unknown, and that a failed command that does not change the
+/// position has no effect.
+// -----------------------------------------------------------------------------
+- (void) testUpdateWithFailedResponse
+{
+  GtpEngineState* state = [[[GtpEngineState alloc] init] autorelease];
+  update(state, @"clear_board", @"");
+  XCTAssertTrue(state.isKnown);
+
+  GtpCommand* command = [GtpCommand command:@"showboard"];
+  [state updateWithResponse:[GtpResponse response:@"? failed" toCommand:command]];
+  XCTAssertTrue(state.isKnown);
+
+  command = [GtpCommand command:@"play B D4"];
+  [state updateWithResponse:[GtpResponse response:@"? illegal move" toCommand:command]];
+  XCTAssertFalse(state.isKnown);
+
+  // Undo without moves cannot be tracked
+  update(state, @"clear_board", @"");
+  update(state, @"undo", @"");
+  XCTAssertFalse(state.isKnown);
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Checks that a copy does not share mutable state with the original.
+// -----------------------------------------------------------------------------
+- (void) testCopy
+{
+  GtpEngineState* state = gameState(3);
+  GtpEngineState* copy = [[state copy] autorelease];
+  XCTAssertTrue(copy.isKnown);
+  XCTAssertEqual(copy.boardSize, 19);
+  XCTAssertEqualObjects(copy.komi, state.komi);
+  XCTAssertEqualObjects(copy.moves, state.moves);
+  XCTAssertNotEqual(copy.moves, state.moves);
+  update(state, @"play B T19", @"");
+  XCTAssertEqual(copy.moves.count, 3);
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Exercises the tracking of engine parameters, and the
+/// isParameterSetByCommand:() method.
+// -----------------------------------------------------------------------------
+- (void) testParameterTracking
+{
+  NSString* value = nil;
+  XCTAssertEqualObjects([GtpEngineState parameterNameOfCommand:@"uct_max_memory 1000" value:&value], @"uct_max_memory");
+  XCTAssertEqualObjects(value, @"1000");
+  XCTAssertEqualObjects([GtpEngineState parameterNameOfCommand:@"UCT_PARAM_PLAYER  max_games 500" value:&value], @"uct_param_player max_games");
+  XCTAssertEqualObjects(value, @"500");
+  XCTAssertNil([GtpEngineState parameterNameOfCommand:@"uct_param_player max_games" value:&value]);
+  XCTAssertNil([GtpEngineState parameterNameOfCommand:@"play B D4" value:&value]);
+
+  GtpEngineState* state = [[[GtpEngineState alloc] init] autorelease];
+  XCTAssertFalse([state isParameterSetByCommand:@"uct_param_player max_games 500"]);
+  update(state, @"uct_param_player max_games 500", @"");
+  update(state, @"go_param timelimit 10", @"");
+  XCTAssertTrue([state isParameterSetByCommand:@"uct_param_player max_games 500"]);
+  XCTAssertFalse([state isParameterSetByCommand:@"uct_param_player max_games 600"]);
+  XCTAssertTrue([state isParameterSetByCommand:@"go_param timelimit 10"]);
+  XCTAssertFalse([state isParameterSetByCommand:@"play B D4"]);
+
+  // Parameters are independent of the position
+  update(state, @"clear_board", @"");
+  XCTAssertTrue([state isParameterSetByCommand:@"uct_param_player max_games 500"]);
+  GtpEngineState* copy = [[state copy] autorelease];
+  XCTAssertTrue([copy isParameterSetByCommand:@"go_param timelimit 10"]);
+
+  // A failed command makes the parameter value unknown
+  GtpCommand* command = [GtpCommand command:@"uct_param_player max_games 500"];
+  [state updateWithResponse:[GtpResponse response:@"? invalid value" toCommand:command]];
+  XCTAssertFalse([state isParameterSetByCommand:@"uct_param_player max_games 500"]);
+  XCTAssertTrue([copy isParameterSetByCommand:@"uct_param_player max_games 500"]);
+
+  [state forgetParameters];
+  XCTAssertFalse([state isParameterSetByCommand:@"go_param timelimit 10"]);
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Exercises the planSyncFromState:numberOfUndos:indexOfFirstMoveToPlay:()
+/// method in cases where incremental synchronization is possible.
+// -----------------------------------------------------------------------------
+- (void) testPlanSync
+{
+  NSUInteger numberOfUndos = 0;
+  NSUInteger indexOfFirstMoveToPlay = 0;
+
+  // Same position
+  XCTAssertTrue([gameState(10) planSyncFromState:gameState(10) numberOfUndos:&numberOfUndos indexOfFirstMoveToPlay:&indexOfFirstMoveToPlay]);
+  XCTAssertEqual(numberOfUndos, 0);
+  XCTAssertEqual(indexOfFirstMoveToPlay, 10);
+
+  // Navigate back
+  XCTAssertTrue([gameState(7) planSyncFromState:gameState(10) numberOfUndos:&numberOfUndos indexOfFirstMoveToPlay:&indexOfFirstMoveToPlay]);
+  XCTAssertEqual(numberOfUndos, 3);
+  XCTAssertEqual(indexOfFirstMoveToPlay, 7);
+
+  // Navigate forward
+  XCTAssertTrue([gameState(10) planSyncFromState:gameState(7) numberOfUndos:&numberOfUndos indexOfFirstMoveToPlay:&indexOfFirstMoveToPlay]);
+  XCTAssertEqual(numberOfUndos, 0);
+  XCTAssertEqual(indexOfFirstMoveToPlay, 7);
+
+  // Branch: the last two moves differ
+  GtpEngineState* branchState = gameState(8);
+  [branchState.moves replaceObjectAtIndex:6 withObject:@"B T19"];
+  XCTAssertTrue([branchState planSyncFromState:gameState(10) numberOfUndos:&numberOfUndos indexOfFirstMoveToPlay:&indexOfFirstMoveToPlay]);
+  XCTAssertEqual(numberOfUndos, 4);
+  XCTAssertEqual(indexOfFirstMoveToPlay, 6);
+
+  // An unknown board size matches any board size
+  GtpEngineState* currentState = gameState(5);
+  currentState.boardSize = 0;
+  XCTAssertTrue([gameState(5) planSyncFromState:currentState numberOfUndos:&numberOfUndos indexOfFirstMoveToPlay:&indexOfFirstMoveToPlay]);
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Exercises the planSyncFromState:numberOfUndos:indexOfFirstMoveToPlay:()
+/// method in cases where the position must be rebuilt from scratch.
+// -----------------------------------------------------------------------------
+- (void) testPlanSyncRequiresRebuild
+{
+  NSUInteger numberOfUndos = 0;
+  NSUInteger indexOfFirstMoveToPlay = 0;
+
+  GtpEngineState* currentState = gameState(10);
+  currentState.known = false;
+  XCTAssertFalse([gameState(10) planSyncFromState:currentState numberOfUndos:&numberOfUndos indexOfFirstMoveToPlay:&indexOfFirstMoveToPlay]);
+
+  currentState = gameState(10);
+  currentState.boardSize = 9;
+  XCTAssertFalse([gameState(10) planSyncFromState:currentState numberOfUndos:&numberOfUndos indexOfFirstMoveToPlay:&indexOfFirstMoveToPlay]);
+
+  currentState = gameState(10);
+  currentState.komi = nil;
+  XCTAssertFalse([gameState(10) planSyncFromState:currentState numberOfUndos:&numberOfUndos indexOfFirstMoveToPlay:&indexOfFirstMoveToPlay]);
+
+  GtpEngineState* targetState = gameState(10);
+  targetState.handicap = @"D4 Q16";
+  XCTAssertFalse([targetState planSyncFromState:gameState(10) numberOfUndos:&numberOfUndos indexOfFirstMoveToPlay:&indexOfFirstMoveToPlay]);
+
+  targetState = gameState(10);
+  targetState.setupStones = @"B A1";
+  XCTAssertFalse([targetState planSyncFromState:gameState(10) numberOfUndos:&numberOfUndos indexOfFirstMoveToPlay:&indexOfFirstMoveToPlay]);
+
+  targetState = gameState(10);
+  targetState.setupPlayer = @"W";
+  XCTAssertFalse([targetState planSyncFromState:gameState(10) numberOfUndos:&numberOfUndos indexOfFirstMoveToPlay:&indexOfFirstMoveToPlay]);
+
+  // Taking back 8 moves is more work than replaying 2 moves
+  XCTAssertFalse([gameState(2) planSyncFromState:gameState(10) numberOfUndos:&numberOfUndos indexOfFirstMoveToPlay:&indexOfFirstMoveToPlay]);
+  XCTAssertFalse([gameState(0) planSyncFromState:gameState(1) numberOfUndos:&numberOfUndos indexOfFirstMoveToPlay:&indexOfFirstMoveToPlay]);
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Exercises the position fingerprint and the generation counter.
+// -----------------------------------------------------------------------------
+- (void) testPositionFingerprint
+{
+  GtpEngineState* state = [[[GtpEngineState alloc] init] autorelease];
+  XCTAssertFalse(state.hasPositionFingerprint);
+  XCTAssertEqual(state.generation, 0);
+
+  // An unknown position never matches
+  [state assignPositionFingerprint:42];
+  XCTAssertTrue(state.hasPositionFingerprint);
+  XCTAssertFalse([state matchesPositionFingerprint:42]);
+
+  update(state, @"clear_board", @"");
+  XCTAssertEqual(state.generation, 1);
+  XCTAssertFalse(state.hasPositionFingerprint);
+  [state assignPositionFingerprint:42];
+  XCTAssertTrue([state matchesPositionFingerprint:42]);
+  XCTAssertFalse([state matchesPositionFingerprint:43]);
+
+  // Commands that do not change the position keep the fingerprint
+  update(state, @"showboard", @"");
+  update(state, @"uct_param_player ignore_clock 1", @"");
+  XCTAssertEqual(state.generation, 1);
+  XCTAssertTrue([state matchesPositionFingerprint:42]);
+
+  // Every change of the position forgets the fingerprint
+  update(state, @"play B D4", @"");
+  XCTAssertEqual(state.generation, 2);
+  XCTAssertFalse([state matchesPositionFingerprint:42]);
+  [state assignPositionFingerprint:42];
+  [state invalidate];
+  XCTAssertEqual(state.generation, 3);
+  XCTAssertFalse([state matchesPositionFingerprint:42]);
+
+  // A command whose effect is not known forgets the fingerprint and makes
+  // the position unknown
+  update(state, @"clear_board", @"");
+  [state assignPositionFingerprint:42];
+  update(state, @"custom_command 1 2", @"");
+  XCTAssertFalse(state.isKnown);
+  XCTAssertFalse([state matchesPositionFingerprint:42]);
+
+  // The fingerprint is copied
+  update(state, @"clear_board", @"");
+  [state assignPositionFingerprint:7];
+  GtpEngineState* copy = [[state copy] autorelease];
+  XCTAssertEqual(copy.generation, state.generation);
+  XCTAssertTrue([copy matchesPositionFingerprint:7]);
+
+  // Same position
+  XCTAssertTrue([gameState(5) isSamePositionAsState:gameState(5)]);
+  XCTAssertFalse([gameState(5) isSamePositionAsState:gameState(4)]);
+  XCTAssertFalse([state isSamePositionAsState:gameState(0)]);
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Exercises the commandMayChangePosition:() class method.
+// -----------------------------------------------------------------------------
+- (void) testCommandMayChangePosition
+{
+  XCTAssertFalse([GtpEngineState commandMayChangePosition:@"showboard"]);
+  XCTAssertFalse([GtpEngineState commandMayChangePosition:@"  FINAL_STATUS_LIST dead"]);
+  XCTAssertFalse([GtpEngineState commandMayChangePosition:@"uct_stat_territory"]);
+  XCTAssertFalse([GtpEngineState commandMayChangePosition:@"uct_param_player max_games 500"]);
+  XCTAssertFalse([GtpEngineState commandMayChangePosition:@"go_param_rules"]);
+  XCTAssertFalse([GtpEngineState commandMayChangePosition:@""]);
+
+  XCTAssertTrue([GtpEngineState commandMayChangePosition:@"play B D4"]);
+  XCTAssertTrue([GtpEngineState commandMayChangePosition:@"genmove w"]);
+  XCTAssertTrue([GtpEngineState commandMayChangePosition:@"loadsgf /tmp/game.sgf"]);
+  XCTAssertTrue([GtpEngineState commandMayChangePosition:@"custom_command"]);
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Checks that GtpClient tracks the state of its engine.
+// -----------------------------------------------------------------------------
+- (void) testTrackingThroughGtpClient
+{
+  GtpEnginePool* pool = standInEnginePool();
+  GtpClient* client = [pool clientAtIndex:0];
+  XCTAssertFalse(client.engineState.isKnown);
+
+  XCTAssertTrue(syncEngine(client, gameState(20), true));
+  GtpEngineState* engineState = client.engineState;
+  XCTAssertTrue(engineState.isKnown);
+  XCTAssertEqualObjects(engineState.moves, gameState(20).moves);
+
+  GtpCommand* command = [GtpCommand command:@"genmove b"];
+  [client submit:command];
+  XCTAssertEqual(client.engineState.moves.count, 21);
+  XCTAssertEqualObjects(client.engineState.moves.lastObject, @"B D4");
+
+  // The snapshot does not change
+  XCTAssertEqual(engineState.moves.count, 20);
+
+  XCTAssertTrue(syncEngine(client, gameState(15), true));
+  XCTAssertEqualObjects(client.engineState.moves, gameState(15).moves);
+
+  [pool shutdown];
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Checks that GtpClient can answer whether its engine still holds a
+/// position with a given fingerprint.
+// -----------------------------------------------------------------------------
+- (void) testPositionFingerprintThroughGtpClient
+{
+  GtpEnginePool* pool = standInEnginePool();
+  GtpClient* client = [pool clientAtIndex:0];
+  XCTAssertTrue(syncEngine(client, gameState(20), true));
+  GtpEngineState* engineState = client.engineState;
+  XCTAssertFalse([client engineHasPositionWithFingerprint:4711]);
+  XCTAssertTrue([client assignPositionFingerprint:4711 toEngineStateWithGeneration:engineState.generation]);
+  XCTAssertTrue([client engineHasPositionWithFingerprint:4711]);
+
+  // Commands that do not change the position keep the fingerprint
+  [client submit:[GtpCommand command:@"showboard"]];
+  XCTAssertTrue([client engineHasPositionWithFingerprint:4711]);
+
+  // A move played by the engine forgets the fingerprint
+  [client submit:[GtpCommand command:@"genmove w"]];
+  XCTAssertFalse([client engineHasPositionWithFingerprint:4711]);
+
+  // The fingerprint is not assigned if the position has changed since the
+  // snapshot was taken
+  XCTAssertFalse([client assignPositionFingerprint:4711 toEngineStateWithGeneration:engineState.generation]);
+  XCTAssertFalse([client engineHasPositionWithFingerprint:4711]);
+
+  // A position that was built up only partially is made unknown
+  engineState = client.engineState;
+  XCTAssertTrue([client assignPositionFingerprint:4711 toEngineStateWithGeneration:engineState.generation]);
+  [client invalidateEngineState];
+  XCTAssertFalse(client.engineState.isKnown);
+  XCTAssertFalse([client engineHasPositionWithFingerprint:4711]);
+
+  [pool shutdown];
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Checks how the number of moves that have to be taken back and
+/// played depends on the distance that is navigated in a long game.
+// -----------------------------------------------------------------------------
+- (void) testSyncCostAgainstDistance
+{
+  GtpEngineState* currentState = gameState(numberOfMovesInGame);
+  const int distances[] = { 1, 10, 100, numberOfMovesInGame / 2 };
+  for (int distance : distances)
+  {
+    NSUInteger numberOfUndos = 0;
+    NSUInteger indexOfFirstMoveToPlay = 0;
+
+    // Navigating back costs one undo per move, no move is replayed
+    GtpEngineState* backState = gameState(numberOfMovesInGame - distance);
+    XCTAssertTrue([backState planSyncFromState:currentState numberOfUndos:&numberOfUndos indexOfFirstMoveToPlay:&indexOfFirstMoveToPlay]);
+    XCTAssertEqual(numberOfUndos, distance);
+    XCTAssertEqual(backState.moves.count - indexOfFirstMoveToPlay, 0);
+
+    // Navigating forward again plays only the moves that were taken back
+    XCTAssertTrue([currentState planSyncFromState:backState numberOfUndos:&numberOfUndos indexOfFirstMoveToPlay:&indexOfFirstMoveToPlay]);
+    XCTAssertEqual(numberOfUndos, 0);
+    XCTAssertEqual(currentState.moves.count - indexOfFirstMoveToPlay, distance);
+  }
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Measures how long it takes to navigate one move back and forth in a
+/// long game when the engine is synchronized incrementally.
+// -----------------------------------------------------------------------------
+- (void) testPerformanceIncrementalSync
+{
+  GtpEnginePool* pool = standInEnginePool();
+  GtpClient* client = [pool clientAtIndex:0];
+  GtpEngineState* lastState = gameState(numberOfMovesInGame);
+  GtpEngineState* previousState = gameState(numberOfMovesInGame - 1);
+  XCTAssertTrue(syncEngine(client, lastState, true));
+  [self measureBlock:^{
+    for (int iteration = 0; iteration < 10; ++iteration)
+    {
+      XCTAssertTrue(syncEngine(client, previousState, true));
+      XCTAssertTrue(syncEngine(client, lastState, true));
+    }
+  }];
+  [pool shutdown];
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Measures how long it takes to navigate one move back and forth in a
+/// long game when the engine is rebuilt from scratch. Serves as baseline for
+/// testPerformanceIncrementalSync().
+// -----------------------------------------------------------------------------
+- (void) testPerformanceFullReplay
+{
+  GtpEnginePool* pool = standInEnginePool();
+  GtpClient* client = [pool clientAtIndex:0];
+  GtpEngineState* lastState = gameState(numberOfMovesInGame);
+  GtpEngineState* previousState = gameState(numberOfMovesInGame - 1);
+  [self measureBlock:^{
+    for (int iteration = 0; iteration < 10; ++iteration)
+    {
+      XCTAssertTrue(syncEngine(client, previousState, false));
+      XCTAssertTrue(syncEngine(client, lastState, false));
+    }
+  }];
+  [pool shutdown];
+}
+
+@end
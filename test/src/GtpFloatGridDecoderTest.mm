@@ -0,0 +1,135 @@
+// -----------------------------------------------------------------------------
+// Copyright 2026 Patrick Näf (herzbube@herzbube.ch)
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// -----------------------------------------------------------------------------
+
+
+// Test includes
+#import "GtpFloatGridDecoderTest.h"
+
+// Application includes
+#import <gtp/GtpFloatGridDecoder.h>
+
+// C++ standard library
+#include <string>
+#include <vector>
+
+
+// -----------------------------------------------------------------------------
+/// @brief Decodes @a response into @a values, which is resized to hold a grid
+/// of size @a gridSize. Returns the result of GtpFloatGridDecoder::decode().
+// -----------------------------------------------------------------------------
+static bool decode(const std::string& response, int gridSize, std::vector<float>& values)
+{
+  values.assign(gridSize * gridSize, 0.0f);
+  return GtpFloatGridDecoder::decode(response.data(), response.size(), gridSize, values.data());
+}
+
+
+@implementation GtpFloatGridDecoderTest
+
+// -----------------------------------------------------------------------------
+/// @brief Exercises decoding of a well-formed response in the layout that
+/// Fuego uses for "uct_stat_territory".
+// -----------------------------------------------------------------------------
+- (void) testDecode
+{
+  std::vector<float> values;
+  XCTAssertTrue(decode("= \n0.5 -0.25 1\n0 0.125 -1\n-0.5 0.75 0.001\n", 3, values));
+  float expectedValues[] = { -0.5f, 0.75f, 0.001f, 0.0f, 0.125f, -1.0f, 0.5f, -0.25f, 1.0f };
+  for (int index = 0; index < 9; ++index)
+    XCTAssertEqual(values[index], expectedValues[index]);
+
+  // No trailing newline, no empty first line, extra blanks
+  XCTAssertTrue(decode("=  1  2\t\n 3 4 ", 2, values));
+  XCTAssertEqual(values[0], 3.0f);
+  XCTAssertEqual(values[1], 4.0f);
+  XCTAssertEqual(values[2], 1.0f);
+  XCTAssertEqual(values[3], 2.0f);
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Exercises that the top line of the response ends up at the end of
+/// the decoded array.
+// -----------------------------------------------------------------------------
+- (void) testOrientation
+{
+  std::vector<float> values;
+  XCTAssertTrue(decode("= \n1 0\n0 0\n", 2, values));
+  // The value in the top-left corner is at index (gridSize - 1) * gridSize
+  XCTAssertEqual(values[0], 0.0f);
+  XCTAssertEqual(values[1], 0.0f);
+  XCTAssertEqual(values[2], 1.0f);
+  XCTAssertEqual(values[3], 0.0f);
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Exercises decoding of the number formats that a GTP engine may
+/// print.
+// -----------------------------------------------------------------------------
+- (void) testNumberFormats
+{
+  std::vector<float> values;
+  XCTAssertTrue(decode("= +1.5 -.5 7.\n1e2 -2.5E-1 0.0000\n3 3 3\n", 3, values));
+  XCTAssertEqual(values[0], 3.0f);
+  XCTAssertEqual(values[3], 100.0f);
+  XCTAssertEqual(values[4], -0.25f);
+  XCTAssertEqual(values[5], 0.0f);
+  XCTAssertEqual(values[6], 1.5f);
+  XCTAssertEqual(values[7], -0.5f);
+  XCTAssertEqual(values[8], 7.0f);
+
+  XCTAssertFalse(decode("= 1 x\n1 1\n", 2, values));
+  XCTAssertFalse(decode("= 1 1.2.3\n1 1\n", 2, values));
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Exercises that a response with too many or too few lines is
+/// rejected.
+// -----------------------------------------------------------------------------
+- (void) testWrongNumberOfLines
+{
+  std::vector<float> values;
+  XCTAssertFalse(decode("= \n1 1\n", 2, values));
+  XCTAssertFalse(decode("= \n1 1\n1 1\n1 1\n", 2, values));
+  XCTAssertFalse(decode("=", 2, values));
+  XCTAssertTrue(decode("= \n1 1\n1 1\n\n", 2, values));
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Exercises that a response with a line that has too many or too few
+/// numbers is rejected.
+// -----------------------------------------------------------------------------
+- (void) testWrongNumberOfNumbers
+{
+  std::vector<float> values;
+  XCTAssertFalse(decode("= \n1 1 1\n1 1\n", 2, values));
+  XCTAssertFalse(decode("= \n1 1\n1 1 1\n", 2, values));
+  XCTAssertFalse(decode("= \n1\n1 1\n", 2, values));
+  XCTAssertFalse(decode("= \n1 1\n1\n", 2, values));
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Exercises that a failure response and invalid arguments are
+/// rejected.
+// -----------------------------------------------------------------------------
+- (void) testFailureResponse
+{
+  std::vector<float> values;
+  XCTAssertFalse(decode("? unknown command", 2, values));
+  XCTAssertFalse(decode("", 2, values));
+  XCTAssertFalse(decode("= 1", 0, values));
+}
+
+@end
@@ -0,0 +1,146 @@
+// -----------------------------------------------------------------------------
+// Copyright 2026 Patrick Näf (herzbube@herzbube.ch)
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// -----------------------------------------------------------------------------
+
+
+// Test includes
+#import "GtpFutureTest.h"
+
+// Application includes
+#import <gtp/GtpCommand.h>
+#import <gtp/GtpFuture.h>
+#import <gtp/GtpResponse.h>
+
+
+@implementation GtpFutureTest
+
+// -----------------------------------------------------------------------------
+/// @brief Checks the initial state of a GtpFuture object after it has been
+/// created.
+// -----------------------------------------------------------------------------
+- (void) testInitialState
+{
+  GtpCommand* command = [GtpCommand command:@"name"];
+  GtpFuture* future = [GtpFuture futureWithCommand:command];
+  XCTAssertEqual(future.state, GtpFutureStatePending);
+  XCTAssertFalse(future.isCancelled);
+  XCTAssertEqual(future.command, command);
+  XCTAssertNil(future.response);
+  XCTAssertNil(future.futures);
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Exercises the fulfillWithResponse:() method.
+// -----------------------------------------------------------------------------
+- (void) testFulfill
+{
+  GtpCommand* command = [GtpCommand command:@"name"];
+  GtpFuture* future = [GtpFuture futureWithCommand:command];
+  GtpResponse* response = [GtpResponse response:@"= Fuego" toCommand:command];
+
+  XCTestExpectation* expectation = [self expectationWithDescription:@"continuation"];
+  [future then:^(GtpFuture* completedFuture)
+   {
+     XCTAssertEqual(completedFuture, future);
+     XCTAssertEqual(completedFuture.state, GtpFutureStateFulfilled);
+     XCTAssertEqual(completedFuture.response, response);
+     [expectation fulfill];
+   }
+       onQueue:dispatch_get_global_queue(DISPATCH_QUEUE_PRIORITY_DEFAULT, 0)];
+
+  [future fulfillWithResponse:response];
+  [self waitForExpectationsWithTimeout:5.0 handler:nil];
+  XCTAssertEqual([future waitWithTimeout:0.0], GtpFutureStateFulfilled);
+
+  // A future completes only once
+  [future cancel];
+  XCTAssertEqual(future.state, GtpFutureStateFulfilled);
+  XCTAssertFalse(future.isCancelled);
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Exercises the cancel() method.
+// -----------------------------------------------------------------------------
+- (void) testCancel
+{
+  GtpCommand* command = [GtpCommand command:@"name"];
+  GtpFuture* future = [GtpFuture futureWithCommand:command];
+  [future cancel];
+  XCTAssertEqual(future.state, GtpFutureStateCancelled);
+  XCTAssertTrue(future.isCancelled);
+
+  // A response that arrives after cancellation is ignored
+  [future fulfillWithResponse:[GtpResponse response:@"= Fuego" toCommand:command]];
+  XCTAssertEqual(future.state, GtpFutureStateCancelled);
+  XCTAssertNil(future.response);
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Exercises the timeoutAfter:() and waitWithTimeout:() methods.
+// -----------------------------------------------------------------------------
+- (void) testTimeout
+{
+  GtpFuture* future = [GtpFuture futureWithCommand:[GtpCommand command:@"name"]];
+  XCTAssertEqual([future waitWithTimeout:0.05], GtpFutureStatePending);
+
+  [future timeoutAfter:0.05];
+  XCTAssertEqual([future waitWithTimeout:5.0], GtpFutureStateTimedOut);
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Checks that a continuation that is registered after the future has
+/// completed is invoked nonetheless.
+// -----------------------------------------------------------------------------
+- (void) testContinuationAfterCompletion
+{
+  GtpFuture* future = [GtpFuture futureWithCommand:[GtpCommand command:@"name"]];
+  [future cancel];
+
+  XCTestExpectation* expectation = [self expectationWithDescription:@"continuation"];
+  [future then:^(GtpFuture* completedFuture)
+   {
+     XCTAssertEqual(completedFuture.state, GtpFutureStateCancelled);
+     [expectation fulfill];
+   }];
+  [self waitForExpectationsWithTimeout:5.0 handler:nil];
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Exercises the whenAll:() method.
+// -----------------------------------------------------------------------------
+- (void) testWhenAll
+{
+  GtpCommand* command1 = [GtpCommand command:@"name"];
+  GtpCommand* command2 = [GtpCommand command:@"version"];
+  GtpFuture* future1 = [GtpFuture futureWithCommand:command1];
+  GtpFuture* future2 = [GtpFuture futureWithCommand:command2];
+  NSArray* futures = @[future1, future2];
+
+  GtpFuture* combinedFuture = [GtpFuture whenAll:futures];
+  XCTAssertNil(combinedFuture.command);
+  XCTAssertEqualObjects(combinedFuture.futures, futures);
+  XCTAssertEqual(combinedFuture.state, GtpFutureStatePending);
+
+  [future1 fulfillWithResponse:[GtpResponse response:@"= Fuego" toCommand:command1]];
+  XCTAssertEqual([combinedFuture waitWithTimeout:0.05], GtpFutureStatePending);
+  [future2 cancel];
+  XCTAssertEqual([combinedFuture waitWithTimeout:5.0], GtpFutureStateFulfilled);
+  XCTAssertNil(combinedFuture.response);
+
+  GtpFuture* emptyCombinedFuture = [GtpFuture whenAll:@[]];
+  XCTAssertEqual(emptyCombinedFuture.state, GtpFutureStateFulfilled);
+}
+
+@end
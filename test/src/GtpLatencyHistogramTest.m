@@ -0,0 +1,135 @@
+// -----------------------------------------------------------------------------
+// Copyright 2026 Patrick Näf (herzbube@herzbube.ch)
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// -----------------------------------------------------------------------------
+
+
+// Test includes
+#import "GtpLatencyHistogramTest.h"
+
+// Application includes
+#import <diagnostics/GtpLatencyHistogram.h>
+
+
+@implementation GtpLatencyHistogramTest
+
+// -----------------------------------------------------------------------------
+/// @brief Checks the initial state of a GtpLatencyHistogram object after it
+/// has been created.
+// -----------------------------------------------------------------------------
+- (void) testInitialState
+{
+  GtpLatencyHistogram* histogram = [[[GtpLatencyHistogram alloc] init] autorelease];
+  XCTAssertEqual(histogram.count, 0);
+  XCTAssertEqual(histogram.minimumLatency, 0.0);
+  XCTAssertEqual(histogram.maximumLatency, 0.0);
+  XCTAssertEqual(histogram.meanLatency, 0.0);
+  XCTAssertEqual([histogram latencyAtPercentile:50.0], 0.0);
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Exercises the recordLatency:() method.
+// -----------------------------------------------------------------------------
+- (void) testRecordLatency
+{
+  GtpLatencyHistogram* histogram = [[[GtpLatencyHistogram alloc] init] autorelease];
+  [histogram recordLatency:0.001];
+  [histogram recordLatency:0.003];
+  [histogram recordLatency:-1.0];
+  XCTAssertEqual(histogram.count, 3);
+  XCTAssertEqual(histogram.minimumLatency, 0.0);
+  XCTAssertEqualWithAccuracy(histogram.maximumLatency, 0.003, 0.000001);
+  XCTAssertEqualWithAccuracy(histogram.meanLatency, 0.004 / 3, 0.000001);
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Exercises the latencyAtPercentile:() method.
+// -----------------------------------------------------------------------------
+- (void) testPercentiles
+{
+  GtpLatencyHistogram* histogram = [[[GtpLatencyHistogram alloc] init] autorelease];
+  // Values below 64 microseconds are stored exactly
+  for (int microseconds = 1; microseconds <= 50; ++microseconds)
+    [histogram recordLatency:microseconds / 1000000.0];
+  XCTAssertEqualWithAccuracy([histogram latencyAtPercentile:0.0], 0.000001, 0.0000001);
+  XCTAssertEqualWithAccuracy([histogram latencyAtPercentile:50.0], 0.000025, 0.0000001);
+  XCTAssertEqualWithAccuracy([histogram latencyAtPercentile:90.0], 0.000045, 0.0000001);
+  XCTAssertEqualWithAccuracy([histogram latencyAtPercentile:100.0], 0.000050, 0.0000001);
+
+  // An outlier shows up only in the highest percentiles
+  for (int index = 0; index < 49; ++index)
+    [histogram recordLatency:0.000010];
+  [histogram recordLatency:5.0];
+  XCTAssertTrue([histogram latencyAtPercentile:99.0] < 0.001);
+  XCTAssertEqualWithAccuracy([histogram latencyAtPercentile:100.0], 5.0, 5.0 * 0.04);
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Checks that the relative error of the reported values stays within
+/// the limit over the whole range of values.
+// -----------------------------------------------------------------------------
+- (void) testRelativeError
+{
+  double latencies[] = { 0.0001, 0.00077, 0.0123, 0.5, 3.7, 42.0, 600.0, 7200.0 };
+  int numberOfLatencies = sizeof(latencies) / sizeof(latencies[0]);
+  for (int index = 0; index < numberOfLatencies; ++index)
+  {
+    double latency = latencies[index];
+    GtpLatencyHistogram* histogram = [[[GtpLatencyHistogram alloc] init] autorelease];
+    [histogram recordLatency:latency];
+    [histogram recordLatency:latency * 10.0];
+    double reportedLatency = [histogram latencyAtPercentile:50.0];
+    XCTAssertTrue(reportedLatency <= latency * 1.035 && reportedLatency >= latency * 0.965,
+                  @"latency %f was reported as %f", latency, reportedLatency);
+  }
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Exercises the copyWithZone:() and reset() methods.
+// -----------------------------------------------------------------------------
+- (void) testCopyAndReset
+{
+  GtpLatencyHistogram* histogram = [[[GtpLatencyHistogram alloc] init] autorelease];
+  [histogram recordLatency:0.002];
+  [histogram recordLatency:0.004];
+
+  GtpLatencyHistogram* copy = [[histogram copy] autorelease];
+  [histogram reset];
+  XCTAssertEqual(histogram.count, 0);
+  XCTAssertEqual(histogram.maximumLatency, 0.0);
+  XCTAssertEqual(copy.count, 2);
+  XCTAssertEqualWithAccuracy(copy.minimumLatency, 0.002, 0.000001);
+  XCTAssertEqualWithAccuracy(copy.maximumLatency, 0.004, 0.000001);
+  XCTAssertEqualWithAccuracy([copy latencyAtPercentile:100.0], 0.004, 0.000001);
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Exercises the dictionaryRepresentation() method.
+// -----------------------------------------------------------------------------
+- (void) testDictionaryRepresentation
+{
+  GtpLatencyHistogram* histogram = [[[GtpLatencyHistogram alloc] init] autorelease];
+  [histogram recordLatency:0.000010];
+  [histogram recordLatency:0.000010];
+  [histogram recordLatency:0.100];
+
+  NSDictionary* dictionary = [histogram dictionaryRepresentation];
+  XCTAssertTrue([NSJSONSerialization isValidJSONObject:dictionary]);
+  XCTAssertEqualObjects([dictionary objectForKey:@"count"], [NSNumber numberWithUnsignedLong:3]);
+  NSArray* buckets = [dictionary objectForKey:@"bucketsMicroseconds"];
+  XCTAssertEqual(buckets.count, 2);
+  XCTAssertEqualObjects([buckets objectAtIndex:0], (@[@10, @2]));
+}
+
+@end
@@ -0,0 +1,319 @@
+// -----------------------------------------------------------------------------
+// Copyright 2026 Patrick Näf (herzbube@herzbube.ch)
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// -----------------------------------------------------------------------------
+
+
+// Test includes
+#import "GtpLogRingBufferTest.h"
+
+// Application includes
+#import <diagnostics/GtpLogRingBuffer.h>
+
+// C++ standard library
+#include <string>
+
+
+// -----------------------------------------------------------------------------
+/// @brief Adds an entry with the command "command<n>" and the response
+/// "= response<n>", padded with distinct characters to @a responseLength, to
+/// @a ringBuffer. Returns the sequence number of the entry.
+// -----------------------------------------------------------------------------
+static uint64_t addEntry(GtpLogRingBuffer& ringBuffer, int n, size_t responseLength)
+{
+  std::string command = "command" + std::to_string(n);
+  std::string response = "= response" + std::to_string(n);
+  while (response.length() < responseLength)
+    response += static_cast<char>('a' + (response.length() * 7 + n) % 26);
+  uint64_t sequenceNumber = ringBuffer.addCommand(command.data(), command.length(), n);
+  ringBuffer.addResponse(sequenceNumber, true, response.data(), response.length());
+  return sequenceNumber;
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Returns true if @a entry contains the data that addEntry() adds for
+/// @a n.
+// -----------------------------------------------------------------------------
+static bool entryMatches(const GtpLogRingBuffer::Entry& entry, int n, size_t responseLength)
+{
+  std::string expectedResponse = "= response" + std::to_string(n);
+  while (expectedResponse.length() < responseLength)
+    expectedResponse += static_cast<char>('a' + (expectedResponse.length() * 7 + n) % 26);
+  return (entry.command == "command" + std::to_string(n) &&
+          entry.timeStamp == n &&
+          entry.hasResponse &&
+          entry.rawResponse == expectedResponse);
+}
+
+
+@implementation GtpLogRingBufferTest
+
+// -----------------------------------------------------------------------------
+/// @brief Checks that commands and responses are stored and can be read back.
+// -----------------------------------------------------------------------------
+- (void) testAddCommandAndResponse
+{
+  GtpLogRingBuffer ringBuffer(10, 4096, 1024);
+  XCTAssertEqual(ringBuffer.size(), 0);
+
+  uint64_t sequenceNumber1 = ringBuffer.addCommand("boardsize 19", 12, 1.0);
+  uint64_t sequenceNumber2 = ringBuffer.addCommand("foo", 3, 2.0);
+  XCTAssertEqual(sequenceNumber2, sequenceNumber1 + 1);
+  XCTAssertEqual(ringBuffer.size(), 2);
+
+  GtpLogRingBuffer::Entry entry;
+  XCTAssertTrue(ringBuffer.entryAtIndex(0, entry));
+  XCTAssertEqual(entry.sequenceNumber, sequenceNumber1);
+  XCTAssertTrue(entry.command == "boardsize 19");
+  XCTAssertEqual(entry.timeStamp, 1.0);
+  XCTAssertFalse(entry.hasResponse);
+
+  XCTAssertTrue(ringBuffer.addResponse(sequenceNumber1, true, "= ", 2));
+  XCTAssertTrue(ringBuffer.addResponse(sequenceNumber2, false, "? unknown command", 17));
+  XCTAssertFalse(ringBuffer.addResponse(sequenceNumber2 + 1, true, "= ", 2));
+
+  XCTAssertTrue(ringBuffer.entryAtIndex(0, entry));
+  XCTAssertTrue(entry.hasResponse);
+  XCTAssertTrue(entry.responseStatus);
+  XCTAssertTrue(entry.rawResponse == "= ");
+  XCTAssertTrue(ringBuffer.entryAtIndex(1, entry));
+  XCTAssertTrue(entry.command == "foo");
+  XCTAssertFalse(entry.responseStatus);
+  XCTAssertTrue(entry.rawResponse == "? unknown command");
+  XCTAssertFalse(ringBuffer.entryAtIndex(2, entry));
+
+  size_t index;
+  XCTAssertTrue(ringBuffer.indexOfSequenceNumber(sequenceNumber2, index));
+  XCTAssertEqual(index, 1);
+  XCTAssertFalse(ringBuffer.indexOfSequenceNumber(sequenceNumber2 + 1, index));
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Checks that the oldest entries are discarded when the log is full,
+/// or when the capacity is reduced.
+// -----------------------------------------------------------------------------
+- (void) testCapacity
+{
+  GtpLogRingBuffer ringBuffer(3, 4096, 1024);
+  uint64_t firstSequenceNumber = addEntry(ringBuffer, 0, 20);
+  for (int n = 1; n < 5; ++n)
+    addEntry(ringBuffer, n, 20);
+  XCTAssertEqual(ringBuffer.size(), 3);
+  XCTAssertEqual(ringBuffer.capacity(), 3);
+
+  GtpLogRingBuffer::Entry entry;
+  XCTAssertTrue(ringBuffer.entryAtIndex(0, entry));
+  XCTAssertTrue(entryMatches(entry, 2, 20));
+  size_t index;
+  XCTAssertFalse(ringBuffer.indexOfSequenceNumber(firstSequenceNumber, index));
+
+  ringBuffer.setCapacity(2);
+  XCTAssertEqual(ringBuffer.size(), 2);
+  XCTAssertTrue(ringBuffer.entryAtIndex(0, entry));
+  XCTAssertTrue(entryMatches(entry, 3, 20));
+
+  ringBuffer.setCapacity(4);
+  addEntry(ringBuffer, 5, 20);
+  XCTAssertEqual(ringBuffer.size(), 3);
+  for (int n = 3; n <= 5; ++n)
+  {
+    XCTAssertTrue(ringBuffer.entryAtIndex(n - 3, entry));
+    XCTAssertTrue(entryMatches(entry, n, 20));
+  }
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Checks that a response that is longer than the compression threshold
+/// is restored exactly. The response is too long to fit into the arena
+/// without compression.
+// -----------------------------------------------------------------------------
+- (void) testCompression
+{
+  GtpLogRingBuffer ringBuffer(10, 4096, 64);
+  std::string response = "= ";
+  for (int row = 0; row < 200; ++row)
+    response += ". . . X O . . . . . . . . . . . O X .\n";
+  uint64_t sequenceNumber = ringBuffer.addCommand("showboard", 9, 0.0);
+  XCTAssertTrue(ringBuffer.addResponse(sequenceNumber, true, response.data(), response.length()));
+
+  GtpLogRingBuffer::Entry entry;
+  XCTAssertTrue(ringBuffer.entryAtIndex(0, entry));
+  XCTAssertTrue(entry.rawResponse == response);
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Checks that a response that does not fit into a quarter of the
+/// arena is truncated, and that the entry is marked as truncated.
+// -----------------------------------------------------------------------------
+- (void) testTruncation
+{
+  GtpLogRingBuffer ringBuffer(10, 1024, 100000);
+  addEntry(ringBuffer, 0, 1000);
+  addEntry(ringBuffer, 1, 100);
+
+  GtpLogRingBuffer::Entry entry;
+  XCTAssertTrue(ringBuffer.entryAtIndex(0, entry));
+  XCTAssertEqual(entry.rawResponse.length(), 256);
+  XCTAssertTrue(entryMatches(entry, 0, 256));
+  XCTAssertFalse(entry.commandTruncated);
+  XCTAssertTrue(entry.responseTruncated);
+  XCTAssertTrue(ringBuffer.entryAtIndex(1, entry));
+  XCTAssertFalse(entry.responseTruncated);
+
+  std::string command(1000, 'x');
+  ringBuffer.addCommand(command.data(), command.length(), 2);
+  XCTAssertTrue(ringBuffer.entryAtIndex(2, entry));
+  XCTAssertEqual(entry.command.length(), 256);
+  XCTAssertTrue(entry.commandTruncated);
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Checks that without spill file the oldest entries are discarded when
+/// the arena wraps around, and that the remaining entries are intact.
+// -----------------------------------------------------------------------------
+- (void) testArenaWrapAround
+{
+  GtpLogRingBuffer ringBuffer(1000, 1024, 100000);
+  uint64_t lastSequenceNumber = 0;
+  for (int n = 0; n < 100; ++n)
+    lastSequenceNumber = addEntry(ringBuffer, n, 100);
+
+  size_t size = ringBuffer.size();
+  XCTAssertTrue(size > 0);
+  XCTAssertTrue(size < 100);
+  XCTAssertEqual(ringBuffer.numberOfResidentEntries(), size);
+  GtpLogRingBuffer::Entry entry;
+  for (size_t index = 0; index < size; ++index)
+  {
+    XCTAssertTrue(ringBuffer.entryAtIndex(index, entry));
+    XCTAssertTrue(entryMatches(entry, static_cast<int>(100 - size + index), 100));
+  }
+  XCTAssertEqual(entry.sequenceNumber, lastSequenceNumber);
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Checks that with spill file no entries are lost when the arena wraps
+/// around, and that closing the spill file discards the entries that are no
+/// longer resident.
+// -----------------------------------------------------------------------------
+- (void) testSpillFile
+{
+  NSString* spillFilePath = [NSTemporaryDirectory() stringByAppendingPathComponent:@"GtpLogRingBufferTest.spill"];
+  GtpLogRingBuffer ringBuffer(1000, 1024, 100000);
+  XCTAssertTrue(ringBuffer.openSpillFile([spillFilePath fileSystemRepresentation], 1024 * 1024));
+  XCTAssertTrue(ringBuffer.hasSpillFile());
+  for (int n = 0; n < 100; ++n)
+    addEntry(ringBuffer, n, 100);
+
+  XCTAssertEqual(ringBuffer.size(), 100);
+  size_t numberOfResidentEntries = ringBuffer.numberOfResidentEntries();
+  XCTAssertTrue(numberOfResidentEntries < 100);
+  GtpLogRingBuffer::Entry entry;
+  for (int n = 0; n < 100; ++n)
+  {
+    XCTAssertTrue(ringBuffer.entryAtIndex(n, entry));
+    XCTAssertTrue(entryMatches(entry, n, 100));
+  }
+
+  ringBuffer.closeSpillFile();
+  XCTAssertFalse(ringBuffer.hasSpillFile());
+  XCTAssertFalse([[NSFileManager defaultManager] fileExistsAtPath:spillFilePath]);
+  XCTAssertEqual(ringBuffer.size(), numberOfResidentEntries);
+  XCTAssertTrue(ringBuffer.entryAtIndex(0, entry));
+  XCTAssertTrue(entryMatches(entry, static_cast<int>(100 - numberOfResidentEntries), 100));
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Checks that the spill file does not grow beyond its maximum size,
+/// that the oldest entries are discarded to make room, and that the remaining
+/// entries are intact after the spill file was compacted.
+// -----------------------------------------------------------------------------
+- (void) testSpillFileSizeLimit
+{
+  NSString* spillFilePath = [NSTemporaryDirectory() stringByAppendingPathComponent:@"GtpLogRingBufferTest.spill"];
+  const int64_t maximumSpillFileSize = 8192;
+  GtpLogRingBuffer ringBuffer(1000, 1024, 100000);
+  XCTAssertTrue(ringBuffer.openSpillFile([spillFilePath fileSystemRepresentation], maximumSpillFileSize));
+  for (int n = 0; n < 1000; ++n)
+  {
+    addEntry(ringBuffer, n, 100);
+    NSDictionary* attributes = [[NSFileManager defaultManager] attributesOfItemAtPath:spillFilePath error:nil];
+    XCTAssertTrue([attributes fileSize] <= maximumSpillFileSize);
+  }
+
+  size_t size = ringBuffer.size();
+  XCTAssertTrue(size > ringBuffer.numberOfResidentEntries());
+  XCTAssertTrue(size < 1000);
+  GtpLogRingBuffer::Entry entry;
+  for (size_t index = 0; index < size; ++index)
+  {
+    XCTAssertTrue(ringBuffer.entryAtIndex(index, entry));
+    XCTAssertTrue(entryMatches(entry, static_cast<int>(1000 - size + index), 100));
+  }
+  ringBuffer.closeSpillFile();
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Checks that with spill file an entry whose command is overwritten in
+/// the arena while the entry is waiting for its response is not discarded,
+/// and neither are older entries.
+// -----------------------------------------------------------------------------
+- (void) testSpillFileKeepsEntriesWithoutResponse
+{
+  NSString* spillFilePath = [NSTemporaryDirectory() stringByAppendingPathComponent:@"GtpLogRingBufferTest.spill"];
+  GtpLogRingBuffer ringBuffer(1000, 1024, 100000);
+  XCTAssertTrue(ringBuffer.openSpillFile([spillFilePath fileSystemRepresentation], 1024 * 1024));
+  addEntry(ringBuffer, 0, 100);
+  uint64_t pendingSequenceNumber = ringBuffer.addCommand("command1", 8, 1);
+  for (int n = 2; n < 100; ++n)
+    addEntry(ringBuffer, n, 100);
+  XCTAssertEqual(ringBuffer.size(), 100);
+
+  GtpLogRingBuffer::Entry entry;
+  XCTAssertTrue(ringBuffer.entryAtIndex(1, entry));
+  XCTAssertTrue(entry.command == "command1");
+  XCTAssertFalse(entry.hasResponse);
+
+  std::string response = "= response1";
+  XCTAssertTrue(ringBuffer.addResponse(pendingSequenceNumber, true, response.data(), response.length()));
+  for (int n = 0; n < 100; ++n)
+  {
+    XCTAssertTrue(ringBuffer.entryAtIndex(n, entry));
+    XCTAssertTrue(entryMatches(entry, n, 100) || (1 == n && entryMatches(entry, n, 0)));
+  }
+  ringBuffer.closeSpillFile();
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Checks that clear() discards all entries but does not reuse
+/// sequence numbers.
+// -----------------------------------------------------------------------------
+- (void) testClear
+{
+  GtpLogRingBuffer ringBuffer(10, 4096, 1024);
+  uint64_t sequenceNumber1 = addEntry(ringBuffer, 0, 20);
+  addEntry(ringBuffer, 1, 20);
+  ringBuffer.clear();
+  XCTAssertEqual(ringBuffer.size(), 0);
+  GtpLogRingBuffer::Entry entry;
+  XCTAssertFalse(ringBuffer.entryAtIndex(0, entry));
+
+  uint64_t sequenceNumber2 = addEntry(ringBuffer, 2, 20);
+  XCTAssertTrue(sequenceNumber2 > sequenceNumber1 + 1);
+  XCTAssertEqual(ringBuffer.size(), 1);
+  XCTAssertTrue(ringBuffer.entryAtIndex(0, entry));
+  XCTAssertTrue(entryMatches(entry, 2, 20));
+}
+
+@end
@@ -0,0 +1,340 @@
+// -----------------------------------------------------------------------------
+// Copyright 2026 Patrick Näf (herzbube@herzbube.ch)
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// -----------------------------------------------------------------------------
+
+
+// Test includes
+#import "GtpResponseFramerTest.h"
+
+// Application includes
+#import <gtp/GtpResponse.h>
+#import <gtp/GtpResponseFramer.h>
+#import <gtp/LockFreePipeStreamBuffer.h>
+
+// C++ standard library
+#include <cctype>
+#include <istream>
+#include <ostream>
+#include <sstream>
+#include <string>
+#include <thread>
+
+
+// Number of times that the recorded responses are repeated in the stream
+// that the benchmarks read
+static const int numberOfRepetitions = 500;
+
+
+// -----------------------------------------------------------------------------
+/// @brief Returns the response that @a framer has read last, as std::string.
+// -----------------------------------------------------------------------------
+static std::string currentResponse(const GtpResponseFramer& framer)
+{
+  return std::string(framer.responseData(), framer.responseLength());
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Returns a stream of pipelined responses that resemble the large
+/// responses that Fuego generates: "showboard" for a 19x19 board,
+/// "list_moves" for a long game, and "uct_stat_territory".
+// -----------------------------------------------------------------------------
+static std::string recordedResponses()
+{
+  std::ostringstream showboardResponse;
+  showboardResponse << "=1 \n   A B C D E F G H J K L M N O P Q R S T\n";
+  for (int row = 19; row >= 1; --row)
+  {
+    showboardResponse << (row < 10 ? " " : "") << row;
+    for (int column = 0; column < 19; ++column)
+      showboardResponse << ' ' << "X.O+"[(row * 7 + column * 3) % 4];
+    showboardResponse << ' ' << row << '\n';
+  }
+  showboardResponse << "   A B C D E F G H J K L M N O P Q R S T\n\n";
+
+  std::ostringstream listMovesResponse;
+  listMovesResponse << "=2 ";
+  for (int moveIndex = 0; moveIndex < 250; ++moveIndex)
+  {
+    if (moveIndex > 0)
+      listMovesResponse << '\n';
+    listMovesResponse << (moveIndex % 2 ? "W " : "B ") << "ABCDEFGHJKLMNOPQRST"[moveIndex % 19] << (moveIndex % 19 + 1);
+  }
+  listMovesResponse << "\n\n";
+
+  std::ostringstream territoryResponse;
+  territoryResponse << "=3 ";
+  for (int row = 0; row < 19; ++row)
+  {
+    if (row > 0)
+      territoryResponse << '\n';
+    for (int column = 0; column < 19; ++column)
+      territoryResponse << (column > 0 ? " " : "") << ((row * 19 + column) % 200 - 100) / 100.0;
+  }
+  territoryResponse << "\n\n";
+
+  std::string responses;
+  for (int repetition = 0; repetition < numberOfRepetitions; ++repetition)
+    responses += showboardResponse.str() + listMovesResponse.str() + territoryResponse.str();
+  return responses;
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Reads all responses from @a responses the way GtpClient did before
+/// GtpResponseFramer existed: line by line with std::getline(), assembling
+/// the response in a std::string, then converting it to an NSString. Returns
+/// the total length of all NSString objects.
+// -----------------------------------------------------------------------------
+static NSUInteger readResponsesWithGetline(const std::string& responses)
+{
+  NSUInteger totalLength = 0;
+  std::istringstream responseStream(responses);
+  while (true)
+  {
+    @autoreleasepool
+    {
+      std::string fullResponse;
+      std::string singleLineResponse;
+      while (std::getline(responseStream, singleLineResponse) && ! singleLineResponse.empty())
+      {
+        if (! fullResponse.empty())
+          fullResponse += "\n";
+        fullResponse += singleLineResponse;
+      }
+      if (fullResponse.empty())
+        break;
+      std::string::size_type indexAfterLastDigit = 1;
+      while (indexAfterLastDigit < fullResponse.size() && isdigit(static_cast<unsigned char>(fullResponse[indexAfterLastDigit])))
+        indexAfterLastDigit++;
+      fullResponse.erase(1, indexAfterLastDigit - 1);
+      NSString* response = [NSString stringWithCString:fullResponse.c_str()
+                                              encoding:[NSString defaultCStringEncoding]];
+      totalLength += response.length;
+    }
+  }
+  return totalLength;
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Reads all responses from @a responses with GtpResponseFramer, then
+/// converts each response to an NSString. Returns the total length of all
+/// NSString objects.
+// -----------------------------------------------------------------------------
+static NSUInteger readResponsesWithGtpResponseFramer(const std::string& responses)
+{
+  NSUInteger totalLength = 0;
+  std::stringbuf responseStreamBuffer(responses);
+  GtpResponseFramer framer(&responseStreamBuffer);
+  while (framer.readNextResponse())
+  {
+    @autoreleasepool
+    {
+      NSString* response = [[NSString alloc] initWithBytes:framer.responseData()
+                                                    length:framer.responseLength()
+                                                  encoding:[NSString defaultCStringEncoding]];
+      totalLength += response.length;
+      [response release];
+    }
+  }
+  return totalLength;
+}
+
+
+@implementation GtpResponseFramerTest
+
+// -----------------------------------------------------------------------------
+/// @brief Checks that GtpResponseFramer splits a stream of pipelined responses
+/// at the empty lines.
+// -----------------------------------------------------------------------------
+- (void) testFraming
+{
+  std::stringbuf streamBuffer("= foo\nbar\n\n? error\n\n=\n\n\n= last\n\n");
+  GtpResponseFramer framer(&streamBuffer);
+  XCTAssertTrue(framer.readNextResponse());
+  XCTAssertTrue(currentResponse(framer) == "= foo\nbar");
+  XCTAssertTrue(framer.readNextResponse());
+  XCTAssertTrue(currentResponse(framer) == "? error");
+  // A response without content is extended with a space character
+  XCTAssertTrue(framer.readNextResponse());
+  XCTAssertTrue(currentResponse(framer) == "= ");
+  // A stray empty line yields an empty response
+  XCTAssertTrue(framer.readNextResponse());
+  XCTAssertTrue(currentResponse(framer) == "");
+  XCTAssertTrue(framer.readNextResponse());
+  XCTAssertTrue(currentResponse(framer) == "= last");
+  XCTAssertFalse(framer.readNextResponse());
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Checks that GtpResponseFramer removes the command ID from responses.
+// -----------------------------------------------------------------------------
+- (void) testCommandID
+{
+  std::stringbuf streamBuffer("=17 foo\n\n?4 error\n\n=123\n\n= no ID\n\n");
+  GtpResponseFramer framer(&streamBuffer);
+  XCTAssertTrue(framer.readNextResponse());
+  XCTAssertEqual(framer.commandID(), 17);
+  XCTAssertTrue(currentResponse(framer) == "= foo");
+  XCTAssertTrue(framer.readNextResponse());
+  XCTAssertEqual(framer.commandID(), 4);
+  XCTAssertTrue(currentResponse(framer) == "? error");
+  XCTAssertTrue(framer.readNextResponse());
+  XCTAssertEqual(framer.commandID(), 123);
+  XCTAssertTrue(currentResponse(framer) == "= ");
+  XCTAssertTrue(framer.readNextResponse());
+  XCTAssertEqual(framer.commandID(), 0);
+  XCTAssertTrue(currentResponse(framer) == "= no ID");
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Checks the line offsets that GtpResponseFramer determines, also for
+/// a response whose command ID was removed.
+// -----------------------------------------------------------------------------
+- (void) testLineOffsets
+{
+  std::stringbuf streamBuffer("=42 a\nbc\n\ndef\n\n");
+  GtpResponseFramer framer(&streamBuffer);
+  XCTAssertTrue(framer.readNextResponse());
+  XCTAssertTrue(currentResponse(framer) == "= a\nbc");
+  XCTAssertEqual(framer.lineOffsets().size(), 2);
+  XCTAssertEqual(framer.lineOffsets()[0], 0);
+  XCTAssertEqual(framer.lineOffsets()[1], 4);
+  XCTAssertTrue(framer.readNextResponse());
+  XCTAssertEqual(framer.lineOffsets().size(), 1);
+  XCTAssertEqual(framer.lineOffsets()[0], 0);
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Checks that GtpResponseFramer returns an incomplete response at
+/// end-of-file, and then reports end-of-file.
+// -----------------------------------------------------------------------------
+- (void) testEndOfFile
+{
+  std::stringbuf emptyStreamBuffer("");
+  GtpResponseFramer emptyFramer(&emptyStreamBuffer);
+  XCTAssertFalse(emptyFramer.readNextResponse());
+
+  std::stringbuf streamBuffer("= complete\n\n= incomplete\nline");
+  GtpResponseFramer framer(&streamBuffer);
+  XCTAssertTrue(framer.readNextResponse());
+  XCTAssertTrue(framer.readNextResponse());
+  XCTAssertTrue(currentResponse(framer) == "= incomplete\nline");
+  XCTAssertEqual(framer.lineOffsets().size(), 2);
+  XCTAssertFalse(framer.readNextResponse());
+  XCTAssertFalse(framer.readNextResponse());
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Checks that GtpResponseFramer frames responses that are larger than
+/// its initial buffer, and that arrive in pieces from another thread.
+// -----------------------------------------------------------------------------
+- (void) testLargeResponseThroughPipe
+{
+  const int numberOfResponses = 5;
+  const int numberOfLines = 2000;
+  const std::string linePrefix(100, 'x');
+  LockFreePipeStreamBuffer pipeStreamBuffer;
+
+  std::thread writerThread([&]()
+  {
+    std::ostream responseStream(&pipeStreamBuffer);
+    for (int responseIndex = 0; responseIndex < numberOfResponses; ++responseIndex)
+    {
+      responseStream << "=" << (responseIndex + 1) << " ";
+      for (int lineIndex = 0; lineIndex < numberOfLines; ++lineIndex)
+        responseStream << linePrefix << lineIndex << "\n";
+      responseStream << std::endl;
+    }
+    pipeStreamBuffer.closeWriteEnd();
+  });
+
+  GtpResponseFramer framer(&pipeStreamBuffer);
+  for (int responseIndex = 0; responseIndex < numberOfResponses; ++responseIndex)
+  {
+    XCTAssertTrue(framer.readNextResponse());
+    XCTAssertEqual(framer.commandID(), responseIndex + 1);
+    XCTAssertEqual(framer.lineOffsets().size(), numberOfLines);
+    std::string response = currentResponse(framer);
+    std::string lastLine = response.substr(framer.lineOffsets().back());
+    XCTAssertTrue(lastLine == linePrefix + std::to_string(numberOfLines - 1));
+  }
+  XCTAssertFalse(framer.readNextResponse());
+
+  writerThread.join();
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Exercises the line accessors of GtpResponse, both with line offsets
+/// provided by the creator and with line offsets determined on demand.
+// -----------------------------------------------------------------------------
+- (void) testGtpResponseLines
+{
+  std::stringbuf streamBuffer("=1 a b\n\nc\n\n");
+  GtpResponseFramer framer(&streamBuffer);
+  XCTAssertTrue(framer.readNextResponse());
+  NSString* rawResponse = [[[NSString alloc] initWithBytes:framer.responseData()
+                                                    length:framer.responseLength()
+                                                  encoding:[NSString defaultCStringEncoding]] autorelease];
+  NSMutableData* lineOffsets = [NSMutableData data];
+  for (size_t lineOffset : framer.lineOffsets())
+  {
+    NSUInteger lineOffsetAsNSUInteger = lineOffset;
+    [lineOffsets appendBytes:&lineOffsetAsNSUInteger length:sizeof(lineOffsetAsNSUInteger)];
+  }
+
+  NSArray* responses = @[[GtpResponse response:rawResponse lineOffsets:lineOffsets toCommand:nil],
+                         [GtpResponse response:rawResponse toCommand:nil]];
+  for (GtpResponse* response in responses)
+  {
+    XCTAssertEqualObjects(response.rawResponse, @"= a b\nc");
+    XCTAssertEqual([response numberOfLines], 2);
+    XCTAssertEqualObjects([response lineAtIndex:0], @"a b");
+    XCTAssertEqualObjects([response lineAtIndex:1], @"c");
+    XCTAssertThrowsSpecificNamed([response lineAtIndex:2],
+                                 NSException, NSRangeException, @"line index out of range");
+  }
+
+  GtpResponse* emptyResponse = [GtpResponse response:@"= " toCommand:nil];
+  XCTAssertEqual([emptyResponse numberOfLines], 1);
+  XCTAssertEqualObjects([emptyResponse lineAtIndex:0], @"");
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Measures how long it takes to read the recorded responses with
+/// std::getline(). Serves as baseline for
+/// testPerformanceGtpResponseFramer().
+// -----------------------------------------------------------------------------
+- (void) testPerformanceGetline
+{
+  std::string responses = recordedResponses();
+  NSUInteger expectedTotalLength = readResponsesWithGtpResponseFramer(responses);
+  [self measureBlock:^{
+    XCTAssertEqual(readResponsesWithGetline(responses), expectedTotalLength);
+  }];
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Measures how long it takes to read the recorded responses with
+/// GtpResponseFramer.
+// -----------------------------------------------------------------------------
+- (void) testPerformanceGtpResponseFramer
+{
+  std::string responses = recordedResponses();
+  NSUInteger expectedTotalLength = readResponsesWithGetline(responses);
+  [self measureBlock:^{
+    XCTAssertEqual(readResponsesWithGtpResponseFramer(responses), expectedTotalLength);
+  }];
+}
+
+@end
@@ -0,0 +1,374 @@
+// -----------------------------------------------------------------------------
+// Copyright 2026 Patrick Näf (herzbube@herzbube.ch)
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// -----------------------------------------------------------------------------
+
+
+// Test includes
+#import "GtpResponseParserTest.h"
+
+// Application includes
+#import <gtp/GtpResponse.h>
+#import <gtp/GtpResponseParser.h>
+
+// C++ standard library
+#include <cstring>
+#include <string>
+#include <vector>
+
+
+// Number of moves in the move list that the benchmarks parse
+static const int numberOfMovesInBenchmark = 300;
+// Number of times that the benchmarks parse the move list per measurement
+static const int numberOfIterationsInBenchmark = 200;
+
+
+// -----------------------------------------------------------------------------
+/// @brief Returns the board index of @a vertex on a board of size
+/// @a boardSize. Convenience wrapper around
+/// GtpResponseParser::boardIndexOfVertex().
+// -----------------------------------------------------------------------------
+static int boardIndex(const std::string& vertex, int boardSize)
+{
+  return GtpResponseParser::boardIndexOfVertex(vertex.data(), vertex.size(), boardSize);
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Returns a response to "list_moves" with numberOfMovesInBenchmark
+/// moves on a 19x19 board.
+// -----------------------------------------------------------------------------
+static NSString* moveListResponse()
+{
+  static const char* letters = "ABCDEFGHJKLMNOPQRST";
+  NSMutableString* response = [NSMutableString stringWithString:@"= "];
+  for (int moveIndex = 0; moveIndex < numberOfMovesInBenchmark; ++moveIndex)
+  {
+    if (moveIndex > 0)
+      [response appendString:@", "];
+    [response appendFormat:@"%@ %c%d", (0 == moveIndex % 2) ? @"B" : @"W", letters[(moveIndex * 7) % 19], (moveIndex % 19) + 1];
+  }
+  return response;
+}
+
+
+@implementation GtpResponseParserTest
+
+// -----------------------------------------------------------------------------
+/// @brief Exercises the boardIndexOfVertex() function.
+// -----------------------------------------------------------------------------
+- (void) testBoardIndexOfVertex
+{
+  XCTAssertEqual(boardIndex("A1", 19), 0);
+  XCTAssertEqual(boardIndex("B1", 19), 1);
+  XCTAssertEqual(boardIndex("A2", 19), 19);
+  XCTAssertEqual(boardIndex("H1", 19), 7);
+  XCTAssertEqual(boardIndex("J1", 19), 8);
+  XCTAssertEqual(boardIndex("T19", 19), 360);
+  XCTAssertEqual(boardIndex("t19", 19), 360);
+  XCTAssertEqual(boardIndex("G7", 7), 48);
+
+  XCTAssertEqual(boardIndex("pass", 19), GtpResponseParser::passBoardIndex);
+  XCTAssertEqual(boardIndex("PASS", 19), GtpResponseParser::passBoardIndex);
+  XCTAssertEqual(boardIndex("resign", 19), GtpResponseParser::resignBoardIndex);
+
+  XCTAssertEqual(boardIndex("I4", 19), GtpResponseParser::invalidBoardIndex);
+  XCTAssertEqual(boardIndex("U1", 19), GtpResponseParser::invalidBoardIndex);
+  XCTAssertEqual(boardIndex("A0", 19), GtpResponseParser::invalidBoardIndex);
+  XCTAssertEqual(boardIndex("A20", 19), GtpResponseParser::invalidBoardIndex);
+  XCTAssertEqual(boardIndex("H1", 7), GtpResponseParser::invalidBoardIndex);
+  XCTAssertEqual(boardIndex("A8", 7), GtpResponseParser::invalidBoardIndex);
+  XCTAssertEqual(boardIndex("", 19), GtpResponseParser::invalidBoardIndex);
+  XCTAssertEqual(boardIndex("A", 19), GtpResponseParser::invalidBoardIndex);
+  XCTAssertEqual(boardIndex("1A", 19), GtpResponseParser::invalidBoardIndex);
+  XCTAssertEqual(boardIndex("foobar", 19), GtpResponseParser::invalidBoardIndex);
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Exercises tokenization, in particular the recording of separators.
+// -----------------------------------------------------------------------------
+- (void) testTokens
+{
+  std::string response = "= a b,c\n\nd ,  e \n";
+  GtpResponseParser parser(response.data(), response.size());
+  const std::vector<GtpResponseParser::Token>& tokens = parser.tokens();
+  XCTAssertEqual(tokens.size(), 5);
+  const char* expectedTokens[] = { "a", "b", "c", "d", "e" };
+  GtpResponseParser::Separator expectedSeparators[] =
+  {
+    GtpResponseParser::SeparatorBlank,
+    GtpResponseParser::SeparatorComma,
+    GtpResponseParser::SeparatorNewline,
+    GtpResponseParser::SeparatorComma,
+    GtpResponseParser::SeparatorEnd
+  };
+  for (size_t index = 0; index < tokens.size() && index < 5; ++index)
+  {
+    XCTAssertTrue(tokens[index].equalsIgnoringCase(expectedTokens[index]));
+    XCTAssertEqual(tokens[index].separator, expectedSeparators[index]);
+  }
+
+  std::string emptyResponse = "= ";
+  GtpResponseParser emptyParser(emptyResponse.data(), emptyResponse.size());
+  XCTAssertTrue(emptyParser.status());
+  XCTAssertTrue(emptyParser.tokens().empty());
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Exercises the parseVertexList() method.
+// -----------------------------------------------------------------------------
+- (void) testParseVertexList
+{
+  std::vector<int> boardIndexes;
+
+  // The response to "final_status_list dead" may list vertices on several
+  // lines
+  std::string response = "= A1 t19\nJ1  b2\n\n";
+  GtpResponseParser parser(response.data(), response.size());
+  XCTAssertTrue(parser.parseVertexList(19, boardIndexes));
+  std::vector<int> expectedBoardIndexes = { 0, 360, 8, 20 };
+  XCTAssertTrue(boardIndexes == expectedBoardIndexes);
+
+  std::string emptyResponse = "= ";
+  GtpResponseParser emptyParser(emptyResponse.data(), emptyResponse.size());
+  XCTAssertTrue(emptyParser.parseVertexList(19, boardIndexes));
+  XCTAssertTrue(boardIndexes.empty());
+
+  // Vertex outside of the board, pass is not a vertex
+  std::string invalidResponse1 = "= A1 K10";
+  GtpResponseParser invalidParser1(invalidResponse1.data(), invalidResponse1.size());
+  XCTAssertFalse(invalidParser1.parseVertexList(9, boardIndexes));
+  std::string invalidResponse2 = "= A1 pass";
+  GtpResponseParser invalidParser2(invalidResponse2.data(), invalidResponse2.size());
+  XCTAssertFalse(invalidParser2.parseVertexList(9, boardIndexes));
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Exercises the parseMoveList() method.
+// -----------------------------------------------------------------------------
+- (void) testParseMoveList
+{
+  std::vector<GtpResponseParser::Move> moves;
+
+  std::string response = "= B D4, W pass, black q16\nwhite RESIGN";
+  GtpResponseParser parser(response.data(), response.size());
+  XCTAssertTrue(parser.parseMoveList(19, moves));
+  XCTAssertEqual(moves.size(), 4);
+  XCTAssertEqual(moves[0].color, GtpResponseParser::MoveColorBlack);
+  XCTAssertEqual(moves[0].boardIndex, 3 * 19 + 3);
+  XCTAssertEqual(moves[1].color, GtpResponseParser::MoveColorWhite);
+  XCTAssertEqual(moves[1].boardIndex, GtpResponseParser::passBoardIndex);
+  XCTAssertEqual(moves[2].color, GtpResponseParser::MoveColorBlack);
+  XCTAssertEqual(moves[2].boardIndex, 15 * 19 + 15);
+  XCTAssertEqual(moves[3].color, GtpResponseParser::MoveColorWhite);
+  XCTAssertEqual(moves[3].boardIndex, GtpResponseParser::resignBoardIndex);
+
+  std::string emptyResponse = "= ";
+  GtpResponseParser emptyParser(emptyResponse.data(), emptyResponse.size());
+  XCTAssertTrue(emptyParser.parseMoveList(19, moves));
+  XCTAssertTrue(moves.empty());
+
+  const char* invalidResponses[] =
+  {
+    "= B D4 W E5",    // missing separator between moves
+    "= B, D4",        // separator within a move
+    "= B D4, W",      // incomplete move
+    "= X D4",         // invalid color
+    "= B Z4",         // invalid vertex
+  };
+  for (const char* invalidResponse : invalidResponses)
+  {
+    GtpResponseParser invalidParser(invalidResponse, strlen(invalidResponse));
+    XCTAssertFalse(invalidParser.parseMoveList(19, moves), @"%s", invalidResponse);
+  }
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Checks that parseMoveList() reports why parsing failed, and which
+/// move could not be parsed.
+// -----------------------------------------------------------------------------
+- (void) testParseMoveListFailure
+{
+  std::vector<GtpResponseParser::Move> moves;
+  GtpResponseParser::MoveListFailure failure;
+
+  std::string response = "= B D4, W E5";
+  GtpResponseParser parser(response.data(), response.size());
+  XCTAssertTrue(parser.parseMoveList(19, moves, failure));
+  XCTAssertEqual(failure.error, GtpResponseParser::MoveListErrorNone);
+
+  std::string invalidColorResponse = "= B D4, X E5";
+  GtpResponseParser invalidColorParser(invalidColorResponse.data(), invalidColorResponse.size());
+  XCTAssertFalse(invalidColorParser.parseMoveList(19, moves, failure));
+  XCTAssertEqual(failure.error, GtpResponseParser::MoveListErrorInvalidColor);
+  XCTAssertEqual(std::string(failure.colorToken.begin, failure.colorToken.length), "X");
+  XCTAssertEqual(std::string(failure.vertexToken.begin, failure.vertexToken.length), "E5");
+
+  std::string invalidVertexResponse = "= W Z4";
+  GtpResponseParser invalidVertexParser(invalidVertexResponse.data(), invalidVertexResponse.size());
+  XCTAssertFalse(invalidVertexParser.parseMoveList(19, moves, failure));
+  XCTAssertEqual(failure.error, GtpResponseParser::MoveListErrorInvalidVertex);
+  XCTAssertEqual(std::string(failure.colorToken.begin, failure.colorToken.length), "W");
+  XCTAssertEqual(std::string(failure.vertexToken.begin, failure.vertexToken.length), "Z4");
+
+  std::string incompleteResponse = "= B D4, W";
+  GtpResponseParser incompleteParser(incompleteResponse.data(), incompleteResponse.size());
+  XCTAssertFalse(incompleteParser.parseMoveList(19, moves, failure));
+  XCTAssertEqual(failure.error, GtpResponseParser::MoveListErrorFormat);
+  XCTAssertEqual(std::string(failure.colorToken.begin, failure.colorToken.length), "W");
+  XCTAssertEqual(failure.vertexToken.length, 0);
+
+  std::string failureResponse = "? B D4";
+  GtpResponseParser failureParser(failureResponse.data(), failureResponse.size());
+  XCTAssertFalse(failureParser.parseMoveList(19, moves, failure));
+  XCTAssertEqual(failure.error, GtpResponseParser::MoveListErrorStatus);
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Exercises the parseKeyValuePairs() method.
+// -----------------------------------------------------------------------------
+- (void) testParseKeyValuePairs
+{
+  std::vector<GtpResponseParser::KeyValuePair> keyValuePairs;
+
+  std::string response = "= \nmax_games 500\nresign_threshold  0.05, 0.1 \n\nponder\n";
+  GtpResponseParser parser(response.data(), response.size());
+  XCTAssertTrue(parser.parseKeyValuePairs(keyValuePairs));
+  XCTAssertEqual(keyValuePairs.size(), 3);
+  XCTAssertTrue(keyValuePairs[0].key.equalsIgnoringCase("max_games"));
+  XCTAssertEqual(std::string(keyValuePairs[0].value.begin, keyValuePairs[0].value.length), "500");
+  XCTAssertTrue(keyValuePairs[1].key.equalsIgnoringCase("resign_threshold"));
+  XCTAssertEqual(std::string(keyValuePairs[1].value.begin, keyValuePairs[1].value.length), "0.05, 0.1");
+  XCTAssertTrue(keyValuePairs[2].key.equalsIgnoringCase("ponder"));
+  XCTAssertEqual(keyValuePairs[2].value.length, 0);
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Exercises the parseFloatGrid() method.
+// -----------------------------------------------------------------------------
+- (void) testParseFloatGrid
+{
+  std::string response = "= \n1 0.5\n-1 0\n";
+  GtpResponseParser parser(response.data(), response.size());
+  float values[4];
+  XCTAssertTrue(parser.parseFloatGrid(2, values));
+  XCTAssertEqual(values[0], -1.0f);
+  XCTAssertEqual(values[1], 0.0f);
+  XCTAssertEqual(values[2], 1.0f);
+  XCTAssertEqual(values[3], 0.5f);
+  XCTAssertFalse(parser.parseFloatGrid(3, values));
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Checks that none of the typed views accepts a response that does
+/// not indicate success.
+// -----------------------------------------------------------------------------
+- (void) testFailureResponse
+{
+  std::string response = "? A1";
+  GtpResponseParser parser(response.data(), response.size());
+  XCTAssertFalse(parser.status());
+  std::vector<int> boardIndexes;
+  XCTAssertFalse(parser.parseVertexList(19, boardIndexes));
+  std::vector<GtpResponseParser::Move> moves;
+  XCTAssertFalse(parser.parseMoveList(19, moves));
+  std::vector<GtpResponseParser::KeyValuePair> keyValuePairs;
+  XCTAssertFalse(parser.parseKeyValuePairs(keyValuePairs));
+
+  GtpResponseParser emptyParser("", 0);
+  XCTAssertFalse(emptyParser.status());
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Exercises the typed accessors of GtpResponse.
+// -----------------------------------------------------------------------------
+- (void) testGtpResponseTypedAccessors
+{
+  GtpResponse* vertexListResponse = [GtpResponse response:@"= A1 B2" toCommand:nil];
+  NSData* boardIndexes = [vertexListResponse boardIndexesWithBoardSize:9];
+  XCTAssertEqual(boardIndexes.length, 2 * sizeof(int));
+  XCTAssertEqual(((const int*)boardIndexes.bytes)[0], 0);
+  XCTAssertEqual(((const int*)boardIndexes.bytes)[1], 10);
+  XCTAssertNil([vertexListResponse boardIndexesWithBoardSize:1]);
+
+  GtpResponse* moveListResponse = [GtpResponse response:@"= B A1, W pass" toCommand:nil];
+  NSData* moves = [moveListResponse movesWithBoardSize:9];
+  XCTAssertEqual(moves.length, 2 * sizeof(struct GtpResponseMove));
+  const struct GtpResponseMove* move = (const struct GtpResponseMove*)moves.bytes;
+  XCTAssertEqual(move[0].color, GoColorBlack);
+  XCTAssertEqual(move[0].boardIndex, 0);
+  XCTAssertEqual(move[1].color, GoColorWhite);
+  XCTAssertEqual(move[1].boardIndex, GtpResponseBoardIndexPass);
+
+  GtpResponse* keyValueResponse = [GtpResponse response:@"= a 1\nb 2 3" toCommand:nil];
+  NSDictionary* expectedKeyValuePairs = @{@"a": @"1", @"b": @"2 3"};
+  XCTAssertEqualObjects([keyValueResponse keyValuePairs], expectedKeyValuePairs);
+
+  GtpResponse* floatGridResponse = [GtpResponse response:@"= 1\n" toCommand:nil];
+  NSData* floatGrid = [floatGridResponse floatGridWithSize:1];
+  XCTAssertEqual(floatGrid.length, sizeof(float));
+  XCTAssertEqual(((const float*)floatGrid.bytes)[0], 1.0f);
+
+  GtpResponse* failureResponse = [GtpResponse response:@"? failed" toCommand:nil];
+  XCTAssertNil([failureResponse boardIndexesWithBoardSize:9]);
+  XCTAssertNil([failureResponse movesWithBoardSize:9]);
+  XCTAssertNil([failureResponse keyValuePairs]);
+  XCTAssertNil([failureResponse floatGridWithSize:9]);
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Measures how long it takes to split a move list the way the
+/// application did before GtpResponseParser existed. Serves as baseline for
+/// testPerformanceGtpResponseParser().
+// -----------------------------------------------------------------------------
+- (void) testPerformanceStringSplitting
+{
+  GtpResponse* response = [GtpResponse response:moveListResponse() toCommand:nil];
+  [self measureBlock:^{
+    for (int iteration = 0; iteration < numberOfIterationsInBenchmark; ++iteration)
+    {
+      @autoreleasepool
+      {
+        NSUInteger numberOfMoves = 0;
+        for (NSString* moveString in [response.parsedResponse componentsSeparatedByString:@", "])
+        {
+          NSArray* moveStringComponents = [moveString componentsSeparatedByString:@" "];
+          if (2 == moveStringComponents.count && [[moveStringComponents objectAtIndex:1] length] > 0)
+            ++numberOfMoves;
+        }
+        XCTAssertEqual(numberOfMoves, numberOfMovesInBenchmark);
+      }
+    }
+  }];
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Measures how long it takes to parse a move list into board indexes
+/// with GtpResponseParser.
+// -----------------------------------------------------------------------------
+- (void) testPerformanceGtpResponseParser
+{
+  GtpResponse* response = [GtpResponse response:moveListResponse() toCommand:nil];
+  [self measureBlock:^{
+    for (int iteration = 0; iteration < numberOfIterationsInBenchmark; ++iteration)
+    {
+      @autoreleasepool
+      {
+        NSData* moves = [response movesWithBoardSize:19];
+        XCTAssertEqual(moves.length / sizeof(struct GtpResponseMove), numberOfMovesInBenchmark);
+      }
+    }
+  }];
+}
+
+@end
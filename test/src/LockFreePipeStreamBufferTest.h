@@ -0,0 +1,44 @@
+// -----------------------------------------------------------------------------
+// Copyright 2026 Patrick Näf (herzbube@herzbube.ch)
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// -----------------------------------------------------------------------------
+
+
+// Project includes
+#import "BaseTestCase.h"
+
+
+// -----------------------------------------------------------------------------
+/// @brief The LockFreePipeStreamBufferTest class contains unit tests that
+/// exercise the LockFreePipeStreamBuffer class.
+///
+/// The performance tests in this class are a microbenchmark that compares
+/// LockFreePipeStreamBuffer with PipeStreamBuffer. Both stream buffers are
+/// exercised with the same GTP-like request/response traffic between two
+/// threads.
+// -----------------------------------------------------------------------------
+@interface LockFreePipeStreamBufferTest : BaseTestCase
+{
+}
+
+- (void) testRoundTrip;
+- (void) testWrapAround;
+- (void) testMessageLargerThanBuffer;
+- (void) testCloseReadEndUnblocksWriter;
+- (void) testPerformanceRoundTripLatencyPipeStreamBuffer;
+- (void) testPerformanceRoundTripLatencyLockFreePipeStreamBuffer;
+- (void) testPerformanceThroughputPipeStreamBuffer;
+- (void) testPerformanceThroughputLockFreePipeStreamBuffer;
+
+@end
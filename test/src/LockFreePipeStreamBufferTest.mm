@@ -0,0 +1,216 @@
+// -----------------------------------------------------------------------------
+// Copyright 2026 Patrick Näf (herzbube@herzbube.ch)
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// -----------------------------------------------------------------------------
+
+
+// Test includes
+#import "LockFreePipeStreamBufferTest.h"
+
+// Application includes
+#import <gtp/LockFreePipeStreamBuffer.h>
+#import <gtp/PipeStreamBuffer.h>
+
+// C++ standard library
+#include <istream>
+#include <ostream>
+#include <string>
+#include <thread>
+
+
+// -----------------------------------------------------------------------------
+/// @brief Sends @a numberOfCommands commands through a pair of stream buffers
+/// of type @a StreamBufferType to an echo thread, and reads back the
+/// responses. Every response must echo its command. Every command is padded
+/// with @a paddingLength characters.
+///
+/// Returns the number of commands for which the response was correct.
+// -----------------------------------------------------------------------------
+template<typename StreamBufferType>
+static int echoRoundTrips(int numberOfCommands, size_t paddingLength)
+{
+  StreamBufferType commandStreamBuffer;
+  StreamBufferType responseStreamBuffer;
+  std::ostream commandStream(&commandStreamBuffer);
+  std::istream commandStreamReadEndPoint(&commandStreamBuffer);
+  std::ostream responseStreamWriteEndPoint(&responseStreamBuffer);
+  std::istream responseStream(&responseStreamBuffer);
+
+  std::thread echoThread([&]()
+  {
+    std::string command;
+    while (std::getline(commandStreamReadEndPoint, command))
+    {
+      if (command == "quit")
+        break;
+      responseStreamWriteEndPoint << "= " << command << "\n" << std::endl;
+    }
+  });
+
+  std::string padding(paddingLength, 'x');
+  int numberOfCorrectResponses = 0;
+  for (int commandIndex = 0; commandIndex < numberOfCommands; ++commandIndex)
+  {
+    std::string command = "command " + std::to_string(commandIndex) + padding;
+    commandStream << command << std::endl;
+
+    std::string responseLine;
+    std::string emptyLine;
+    std::getline(responseStream, responseLine);
+    std::getline(responseStream, emptyLine);
+    if (responseLine == "= " + command && emptyLine.empty())
+      ++numberOfCorrectResponses;
+  }
+
+  commandStream << "quit" << std::endl;
+  echoThread.join();
+
+  return numberOfCorrectResponses;
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Streams @a numberOfBytes bytes through a stream buffer of type
+/// @a StreamBufferType from one thread to another. Returns the number of bytes
+/// that were received.
+// -----------------------------------------------------------------------------
+template<typename StreamBufferType>
+static size_t streamBytes(size_t numberOfBytes)
+{
+  StreamBufferType streamBuffer;
+  std::ostream writeEndPoint(&streamBuffer);
+  std::istream readEndPoint(&streamBuffer);
+
+  size_t numberOfBytesReceived = 0;
+  std::thread readerThread([&]()
+  {
+    std::string line;
+    while (std::getline(readEndPoint, line))
+    {
+      if (line == "quit")
+        break;
+      numberOfBytesReceived += line.size() + 1;
+    }
+  });
+
+  // Lines of a typical "showboard" response size
+  std::string line(80, 'x');
+  for (size_t numberOfBytesSent = 0; numberOfBytesSent < numberOfBytes; numberOfBytesSent += line.size() + 1)
+    writeEndPoint << line << "\n";
+  writeEndPoint << "quit" << std::endl;
+  readerThread.join();
+
+  return numberOfBytesReceived;
+}
+
+
+@implementation LockFreePipeStreamBufferTest
+
+// -----------------------------------------------------------------------------
+/// @brief Exercises a simple request/response exchange.
+// -----------------------------------------------------------------------------
+- (void) testRoundTrip
+{
+  XCTAssertEqual(echoRoundTrips<LockFreePipeStreamBuffer>(1, 0), 1);
+  XCTAssertEqual(echoRoundTrips<LockFreePipeStreamBuffer>(100, 0), 100);
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Exercises an exchange where the read and write positions wrap around
+/// the end of the internal buffer many times, at varying offsets.
+// -----------------------------------------------------------------------------
+- (void) testWrapAround
+{
+  XCTAssertEqual(echoRoundTrips<LockFreePipeStreamBuffer>(1000, 97), 1000);
+  XCTAssertEqual(echoRoundTrips<LockFreePipeStreamBuffer>(1000, 1021), 1000);
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Exercises an exchange where each message is larger than the internal
+/// buffer, i.e. where writer and reader have to block for each other.
+// -----------------------------------------------------------------------------
+- (void) testMessageLargerThanBuffer
+{
+  XCTAssertEqual(echoRoundTrips<LockFreePipeStreamBuffer>(10, 100000), 10);
+
+  size_t numberOfBytes = 10 * 1024 * 1024;
+  XCTAssertTrue(streamBytes<LockFreePipeStreamBuffer>(numberOfBytes) >= numberOfBytes);
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Checks that closing the read end wakes up a writer that is blocked
+/// because nobody reads, and that the writer sees a short write.
+// -----------------------------------------------------------------------------
+- (void) testCloseReadEndUnblocksWriter
+{
+  LockFreePipeStreamBuffer streamBuffer;
+  std::string data(100000, 'x');
+
+  std::streamsize numberOfCharactersWritten = 0;
+  std::thread writerThread([&]()
+  {
+    numberOfCharactersWritten = streamBuffer.sputn(data.data(), data.size());
+  });
+
+  streamBuffer.closeReadEnd();
+  writerThread.join();
+  XCTAssertTrue(numberOfCharactersWritten < static_cast<std::streamsize>(data.size()));
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Measures round-trip latency of small GTP-like messages through
+/// PipeStreamBuffer. Serves as baseline for
+/// testPerformanceRoundTripLatencyLockFreePipeStreamBuffer().
+// -----------------------------------------------------------------------------
+- (void) testPerformanceRoundTripLatencyPipeStreamBuffer
+{
+  [self measureBlock:^{
+    XCTAssertEqual(echoRoundTrips<PipeStreamBuffer>(10000, 0), 10000);
+  }];
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Measures round-trip latency of small GTP-like messages through
+/// LockFreePipeStreamBuffer.
+// -----------------------------------------------------------------------------
+- (void) testPerformanceRoundTripLatencyLockFreePipeStreamBuffer
+{
+  [self measureBlock:^{
+    XCTAssertEqual(echoRoundTrips<LockFreePipeStreamBuffer>(10000, 0), 10000);
+  }];
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Measures one-way throughput through PipeStreamBuffer. Serves as
+/// baseline for testPerformanceThroughputLockFreePipeStreamBuffer().
+// -----------------------------------------------------------------------------
+- (void) testPerformanceThroughputPipeStreamBuffer
+{
+  size_t numberOfBytes = 50 * 1024 * 1024;
+  [self measureBlock:^{
+    XCTAssertTrue(streamBytes<PipeStreamBuffer>(numberOfBytes) >= numberOfBytes);
+  }];
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Measures one-way throughput through LockFreePipeStreamBuffer.
+// -----------------------------------------------------------------------------
+- (void) testPerformanceThroughputLockFreePipeStreamBuffer
+{
+  size_t numberOfBytes = 50 * 1024 * 1024;
+  [self measureBlock:^{
+    XCTAssertTrue(streamBytes<LockFreePipeStreamBuffer>(numberOfBytes) >= numberOfBytes);
+  }];
+}
+
+@end